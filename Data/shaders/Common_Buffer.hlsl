@@ -79,14 +79,106 @@ cbuffer BufferUber : register(b1)
 	float2 g_resolution;
 };
 
+#if INSTANCED
+// High frequency - Updates per batch of instances (INSTANCE_BATCH_SIZE is defined by the engine)
+struct Instance
+{
+	matrix transform;
+	matrix wvp_previous;
+};
+
+cbuffer BufferInstances : register(b2)
+{
+	uint g_instances_material_index;
+	uint3 g_instances_padding;
+	Instance g_instances[INSTANCE_BATCH_SIZE];
+};
+
+matrix get_object_transform(uint instance_id)		{ return g_instances[instance_id].transform; }
+matrix get_object_wvp_previous(uint instance_id)	{ return g_instances[instance_id].wvp_previous; }
+uint get_object_material_index()					{ return g_instances_material_index; }
+#else
 // High frequency - Updates per object
 cbuffer BufferObject : register(b2)
 {
 	matrix g_object_transform;
 	matrix g_object_wvp_current;
 	matrix g_object_wvp_previous;
+	uint g_object_material_index;
+	uint3 g_object_padding;
 };
 
+matrix get_object_transform(uint instance_id)		{ return g_object_transform; }
+matrix get_object_wvp_previous(uint instance_id)	{ return g_object_wvp_previous; }
+uint get_object_material_index()					{ return g_object_material_index; }
+#endif
+
+#if MATERIAL_TABLE_SIZE
+// Low frequency - The properties of every material drawn in a frame (MATERIAL_TABLE_SIZE is defined by the engine)
+struct Material
+{
+	float4 albedo;
+	float2 tiling_uv;
+	float2 offset_uv;
+	float roughness_mul;
+	float metallic_mul;
+	float normal_mul;
+	float height_mul;
+	uint4 texture_indices; // two 16-bit bindless texture slots per component
+};
+
+cbuffer BufferMaterials : register(b4)
+{
+	Material g_materials[MATERIAL_TABLE_SIZE];
+};
+#endif
+
+#if CLUSTERED
+// Low frequency - The unshadowed point and spot lights of a frame, binned into view space clusters (LIGHT_GRID_* are defined by the engine)
+struct LightGridLight
+{
+	float4 position_range;
+	float4 color_intensity;
+	float4 direction_angle; // an angle of zero means a point light
+};
+
+cbuffer BufferLightGridLights : register(b5)
+{
+	float g_light_grid_light_count;
+	float g_light_grid_slice_scale;
+	float g_light_grid_slice_bias;
+	float g_light_grid_padding;
+	LightGridLight g_light_grid_lights[LIGHT_GRID_LIGHTS];
+};
+
+cbuffer BufferLightGridClusters : register(b6)
+{
+	uint4 g_light_grid_clusters[LIGHT_GRID_X * LIGHT_GRID_Y * LIGHT_GRID_Z / 4]; // offset into the indices (low 16 bits) and light count (high 16 bits)
+};
+
+cbuffer BufferLightGridIndices : register(b7)
+{
+	uint4 g_light_grid_indices[LIGHT_GRID_INDICES / 16]; // four 8-bit light indices per component
+};
+
+// Returns the offset and light count of the cluster a pixel falls in
+uint2 get_light_grid_cluster(float2 uv, float view_z)
+{
+	uint x		= min(uint(uv.x * LIGHT_GRID_X), LIGHT_GRID_X - 1);
+	uint y		= min(uint(uv.y * LIGHT_GRID_Y), LIGHT_GRID_Y - 1);
+	uint z		= uint(clamp(floor(log(view_z) * g_light_grid_slice_scale + g_light_grid_slice_bias), 0.0f, LIGHT_GRID_Z - 1));
+	uint index	= (z * LIGHT_GRID_Y + y) * LIGHT_GRID_X + x;
+	uint packed	= g_light_grid_clusters[index / 4][index % 4];
+	return uint2(packed & 0xFFFF, packed >> 16);
+}
+
+LightGridLight get_light_grid_light(uint index)
+{
+	uint light_index = (g_light_grid_indices[index / 16][(index / 4) % 4] >> ((index % 4) * 8)) & 0xFF;
+	return g_light_grid_lights[light_index];
+}
+#endif
+
 // Updates as many times as there are lights
 cbuffer LightBuffer : register(b3)
 {
@@ -96,4 +188,5 @@ cbuffer LightBuffer : register(b3)
 	float4 color;
 	float4 position;
 	float4 direction;
+	float4 light_atlas_rects[6]; // uv offset (xy) and scale (zw) of the shadow atlas tiles
 };
@@ -23,19 +23,27 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Common.hlsl"
 //====================
 
-Pixel_PosUv mainVS(Vertex_PosUv input)
+Pixel_PosUv mainVS(Vertex_PosUv input, uint instance_id : SV_InstanceID)
 {
 	Pixel_PosUv output;
 
 	input.position.w 	= 1.0f;	
-    output.position 	= mul(input.position, g_object_transform);
+    output.position 	= mul(input.position, get_object_transform(instance_id));
     output.uv 			= input.uv;
 
 	return output;
 }
 
+#if PASS_CACHE
+// Restores the cached depth of a light's static shadow casters (drawn as a quad over the slice or atlas tile, the cache matches its size)
+float mainPS(Pixel_PosUv input) : SV_DEPTH
+{
+    return tex.SampleLevel(sampler_point_clamp, input.uv, 0).r;
+}
+#else
 float4 mainPS(Pixel_PosUv input) : SV_TARGET
 {
     float2 uv = float2(input.uv.x * materialTiling.x + materialOffset.x, input.uv.y * materialTiling.y + materialOffset.y);
     return degamma(tex.Sample(sampler_anisotropic_wrap, uv)) * materialAlbedoColor;
 }
+#endif
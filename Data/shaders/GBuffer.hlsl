@@ -32,8 +32,29 @@ struct PixelInputType
     float3 tangent 				: TANGENT;
 	float4 position_ss_current	: SCREEN_POS;
 	float4 position_ss_previous : SCREEN_POS_PREVIOUS;
+	nointerpolation uint material_index : MATERIAL_INDEX;
 };
 
+#if BINDLESS
+// All the material textures, indexed with the slots the material table holds (a second descriptor set, owned by the engine)
+[[vk::binding(0, 1)]] Texture2D g_material_textures[];
+
+Texture2D get_material_texture(Material material, uint slot)
+{
+	uint packed = material.texture_indices[slot / 2];
+	return g_material_textures[NonUniformResourceIndex((slot % 2) == 0 ? (packed & 0xFFFF) : (packed >> 16))];
+}
+
+#define tex_material_albedo		get_material_texture(material, 0)
+#define tex_material_roughness	get_material_texture(material, 1)
+#define tex_material_metallic	get_material_texture(material, 2)
+#define tex_material_normal		get_material_texture(material, 3)
+#define tex_material_height		get_material_texture(material, 4)
+#define tex_material_occlusion	get_material_texture(material, 5)
+#define tex_material_emission	get_material_texture(material, 6)
+#define tex_material_mask		get_material_texture(material, 7)
+#endif
+
 struct PixelOutputType
 {
 	float4 albedo	: SV_Target0;
@@ -42,18 +63,20 @@ struct PixelOutputType
 	float2 velocity	: SV_Target3;
 };
 
-PixelInputType mainVS(Vertex_PosUvNorTan input)
+PixelInputType mainVS(Vertex_PosUvNorTan input, uint instance_id : SV_InstanceID)
 {
     PixelInputType output;
     
+    matrix transform            = get_object_transform(instance_id);
     input.position.w 			= 1.0f;		
-	output.position_ss_previous = mul(input.position, g_object_wvp_previous);
-    output.position 			= mul(input.position, g_object_transform);
+	output.position_ss_previous = mul(input.position, get_object_wvp_previous(instance_id));
+    output.position 			= mul(input.position, transform);
     output.position   		    = mul(output.position, g_viewProjection);
     output.position_ss_current 	= output.position;
-	output.normal 				= normalize(mul(input.normal, (float3x3)g_object_transform)).xyz;	
-	output.tangent 				= normalize(mul(input.tangent, (float3x3)g_object_transform)).xyz;
+	output.normal 				= normalize(mul(input.normal, (float3x3)transform)).xyz;	
+	output.tangent 				= normalize(mul(input.tangent, (float3x3)transform)).xyz;
     output.uv 					= input.uv;
+	output.material_index		= get_object_material_index();
 	
 	return output;
 }
@@ -62,12 +85,13 @@ PixelOutputType mainPS(PixelInputType input)
 {
 	PixelOutputType g_buffer;
 
-	float2 texCoords 		= float2(input.uv.x * materialTiling.x + materialOffset.x, input.uv.y * materialTiling.y + materialOffset.y);
-	float4 albedo			= materialAlbedoColor;
-	float roughness 		= materialRoughness;
-	float metallic 			= materialMetallic;
+	Material material		= g_materials[input.material_index];
+	float2 texCoords 		= float2(input.uv.x * material.tiling_uv.x + material.offset_uv.x, input.uv.y * material.tiling_uv.y + material.offset_uv.y);
+	float4 albedo			= material.albedo;
+	float roughness 		= material.roughness_mul;
+	float metallic 			= material.metallic_mul;
 	float3 normal			= input.normal.xyz;
-	float normal_intensity	= clamp(materialNormalStrength, 0.012f, materialNormalStrength);
+	float normal_intensity	= clamp(material.normal_mul, 0.012f, material.normal_mul);
 	float emission			= 0.0f;
 	float occlusion			= 1.0f;	
 	
@@ -85,7 +109,7 @@ PixelOutputType mainPS(PixelInputType input)
 
 	#if HEIGHT_MAP
 		// Parallax Mapping
-		float height_scale 		= materialHeight * 0.04f;
+		float height_scale 		= material.height_mul * 0.04f;
 		float3 camera_to_pixel 	= normalize(g_camera_position - input.position.xyz);
 		texCoords 				= ParallaxMapping(tex_material_height, sampler_anisotropic_wrap, texCoords, camera_to_pixel, TBN, height_scale);
 	#endif
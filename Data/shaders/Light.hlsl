@@ -21,8 +21,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES =====================      
 #include "BRDF.hlsl"              
+#if !CLUSTERED
 #include "ShadowMapping.hlsl"
 #include "VolumetricLighting.hlsl"
+#endif
 //================================
 
 struct PixelOutputType
@@ -32,6 +34,26 @@ struct PixelOutputType
 	float3 volumetric	: SV_Target2;
 };
 
+// Reflectance equation, l points towards the light
+void reflectance(Surface surface, Material material, float3 l, float3 radiance, out float3 diffuse, out float3 specular, out float3 F)
+{
+    float3 v        = -surface.camera_to_pixel;
+    float3 h 		= normalize(v + l);
+    float v_dot_h 	= saturate(dot(v, h));
+    float n_dot_v   = saturate(dot(surface.normal, v));
+    float n_dot_l   = saturate(dot(surface.normal, l));
+    float n_dot_h   = saturate(dot(surface.normal, h));
+    radiance        *= n_dot_l;
+
+    // BRDF components
+    F                   = 0.0f;
+    float3 cDiffuse 	= BRDF_Diffuse(material, n_dot_v, n_dot_l, v_dot_h);	
+    float3 cSpecular 	= BRDF_Specular(material, n_dot_v, n_dot_l, n_dot_h, v_dot_h, F);
+
+    diffuse     = cDiffuse * radiance * energy_conservation(F, material.metallic);
+    specular    = cSpecular * radiance;
+}
+
 PixelOutputType mainPS(Pixel_PosUv input)
 {
 	PixelOutputType light_out;
@@ -67,6 +89,44 @@ PixelOutputType mainPS(Pixel_PosUv input)
         material.is_sky         = sample_material.a == 0.0f;
     }
     
+    #if CLUSTERED
+    // All the point and spot lights of the pixel's cluster (they don't cast shadows)
+    [branch]
+    if (!material.is_sky)
+    {
+        float view_z    = mul(float4(surface.position, 1.0f), g_view).z;
+        uint2 cluster   = get_light_grid_cluster(input.uv, view_z);
+        for (uint i = 0; i < cluster.y; i++)
+        {
+            LightGridLight grid_light   = get_light_grid_light(cluster.x + i);
+            float3 to_pixel             = surface.position - grid_light.position_range.xyz;
+            float distance_to_pixel     = length(to_pixel);
+            float3 direction            = to_pixel / distance_to_pixel;
+
+            // Same attenuation as the point and spot light passes
+            float attenuation = saturate(1.0f - distance_to_pixel / grid_light.position_range.w);
+            [branch]
+            if (grid_light.direction_angle.w != 0.0f)
+            {
+                float cutoffAngle   = 1.0f - grid_light.direction_angle.w;
+                float theta         = dot(grid_light.direction_angle.xyz, direction);
+                float epsilon       = cutoffAngle - cutoffAngle * 0.9f;
+                attenuation         *= saturate((theta - cutoffAngle) / epsilon);
+            }
+            attenuation *= attenuation;
+
+            float intensity = grid_light.color_intensity.w * attenuation * material.occlusion;
+            [branch]
+            if (intensity > 0.0f)
+            {
+                float3 diffuse, specular, F;
+                reflectance(surface, material, -direction, grid_light.color_intensity.rgb * intensity, diffuse, specular, F);
+                light_out.diffuse.rgb   += diffuse;
+                light_out.specular.rgb  += specular;
+            }
+        }
+    }
+    #else
     // Fill light struct
     Light light;
     light.color 	                = color.xyz;
@@ -137,20 +197,8 @@ PixelOutputType mainPS(Pixel_PosUv input)
     [branch]
     if (light.intensity > 0.0f && !material.is_sky)
     {
-        // Compute some stuff
-        float3 l		= -light.direction;
-        float3 v        = -surface.camera_to_pixel;
-        float3 h 		= normalize(v + l);
-        float v_dot_h 	= saturate(dot(v, h));
-        float n_dot_v   = saturate(dot(surface.normal, v));
-        float n_dot_l   = saturate(dot(surface.normal, l));
-        float n_dot_h   = saturate(dot(surface.normal, h));
-        float3 radiance	= light.color * light.intensity * n_dot_l;
-    
-        // BRDF components
-        float3 F 			= 0.0f;
-        float3 cDiffuse 	= BRDF_Diffuse(material, n_dot_v, n_dot_l, v_dot_h);	
-        float3 cSpecular 	= BRDF_Specular(material, n_dot_v, n_dot_l, n_dot_h, v_dot_h, F);
+        float3 diffuse, specular, F;
+        reflectance(surface, material, -light.direction, light.color * light.intensity, diffuse, specular, F);
 
         // SSR
         float3 light_reflection = 0.0f;
@@ -161,9 +209,10 @@ PixelOutputType mainPS(Pixel_PosUv input)
             light_reflection = saturate(tex_frame.Sample(sampler_bilinear_clamp, sample_ssr.xy).rgb * F);
         }
     
-        light_out.diffuse.rgb   = cDiffuse * radiance * energy_conservation(F, material.metallic);
-        light_out.specular.rgb	= cSpecular * radiance + light_reflection;
+        light_out.diffuse.rgb   = diffuse;
+        light_out.specular.rgb	= specular + light_reflection;
     }
+    #endif
 
 	return light_out;
 }
@@ -45,17 +45,33 @@ static const float g_pcf_filter_size = (sqrt((float)g_shadow_samples) - 1.0f) /
 /*------------------------------------------------------------------------------
     DEPTH SAMPLING
 ------------------------------------------------------------------------------*/
+#if POINT || SPOT
+// Maps a tile's uv to the shadow atlas
+float2 atlas_uv(float2 uv, uint tile)
+{
+    float4 rect = light_atlas_rects[tile];
+    return rect.xy + uv * rect.zw;
+}
+
+// Keeps the filter taps within their tile, half a texel in, so that the neighbouring tiles don't bleed in
+float2 atlas_clamp(float3 uv)
+{
+    float2 atlas_size;
+    light_atlas_depth.GetDimensions(atlas_size.x, atlas_size.y);
+    float2 texel_half   = 0.5f / atlas_size;
+    float4 rect         = light_atlas_rects[(uint)uv.z];
+    return clamp(uv.xy, rect.xy + texel_half, rect.xy + rect.zw - texel_half);
+}
+#endif
+
 float compare_depth(float3 uv, float compare)
 {
     #if DIRECTIONAL
     // float3 -> uv, slice
     return light_directional_depth.SampleCmpLevelZero(sampler_compare_depth, uv, compare).r;
-    #elif POINT
-    // float3 -> direction
-    return light_point_depth.SampleCmpLevelZero(sampler_compare_depth, uv, compare).r;
-    #elif SPOT
-    // float3 -> uv, 0
-    return light_spot_depth.SampleCmpLevelZero(sampler_compare_depth, uv.xy, compare).r;
+    #elif POINT || SPOT
+    // float3 -> atlas uv, tile
+    return light_atlas_depth.SampleCmpLevelZero(sampler_compare_depth, atlas_clamp(uv), compare).r;
     #endif
 
     return 0.0f;
@@ -66,12 +82,9 @@ float sample_depth(float3 uv)
     #if DIRECTIONAL
     // float3 -> uv, slice
     return light_directional_depth.SampleLevel(sampler_point_clamp, uv, 0).r;
-    #elif POINT
-    // float3 -> direction
-    return light_point_depth.SampleLevel(sampler_point_clamp, uv, 0).r;
-    #elif SPOT
-    // float3 -> uv, 0
-    return light_spot_depth.SampleLevel(sampler_point_clamp, uv.xy, 0).r;
+    #elif POINT || SPOT
+    // float3 -> atlas uv, tile
+    return light_atlas_depth.SampleLevel(sampler_point_clamp, atlas_clamp(uv), 0).r;
     #endif
 
     return 0.0f;
@@ -82,12 +95,9 @@ float4 sample_color(float3 uv)
     #if DIRECTIONAL
     // float3 -> uv, slice
     return light_directional_color.SampleLevel(sampler_point_clamp, uv, 0);
-    #elif POINT
-    // float3 -> direction
-    return light_point_color.SampleLevel(sampler_point_clamp, uv, 0);
-    #elif SPOT
-    // float3 -> uv, 0
-    return light_spot_color.SampleLevel(sampler_point_clamp, uv.xy, 0);
+    #elif POINT || SPOT
+    // float3 -> atlas uv, tile
+    return light_atlas_color.SampleLevel(sampler_point_clamp, atlas_clamp(uv), 0);
     #endif
 
     return 0.0f;
@@ -371,14 +381,15 @@ float4 Shadow_Map(Surface surface, Light light, bool transparent_pixel)
         if (light.distance_to_pixel < light.range)
         {
 			uint projection_index   = direction_to_cube_face_index(light.direction);
-            float pos_z             = project_depth(position_world, light_view_projection[projection_index]);   
-            float compare_depth     = bias_sloped_scaled(pos_z, light.bias);
-            shadow.a                = SampleShadowMap(light.direction, compare_depth);
+            float3 pos_clip         = project(position_world, light_view_projection[projection_index]);
+            float3 uv               = float3(atlas_uv(pos_clip.xy, projection_index), projection_index);
+            float compare_depth     = bias_sloped_scaled(pos_clip.z, light.bias);
+            shadow.a                = SampleShadowMap(uv, compare_depth);
             
             [branch]
             if (light.cast_transparent_shadows && shadow.a > 0.0f && !transparent_pixel)
             {
-                shadow *= sample_color(light.direction);
+                shadow *= sample_color(uv);
             }
         }
     }
@@ -388,13 +399,14 @@ float4 Shadow_Map(Surface surface, Light light, bool transparent_pixel)
         if (light.distance_to_pixel < light.range)
         {
             float3 pos_clip     = project(position_world, light_view_projection[0]);
+            float3 uv           = float3(atlas_uv(pos_clip.xy, 0), 0.0f);
             float compare_depth = bias_sloped_scaled(pos_clip.z, light.bias);
-            shadow.a            = SampleShadowMap(float3(pos_clip.xy, 0.0f), compare_depth);
+            shadow.a            = SampleShadowMap(uv, compare_depth);
             
             [branch]
             if (light.cast_transparent_shadows && shadow.a > 0.0f  && !transparent_pixel)
             {
-                shadow *= sample_color(float3(pos_clip.xy, 0.0f));
+                shadow *= sample_color(uv);
             }
         }
     }
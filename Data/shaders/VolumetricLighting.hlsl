@@ -38,16 +38,19 @@ float vl_raymarch(Light light, float3 ray_pos, float3 ray_step, float ray_dot_li
     
 	for (uint i = 0; i < g_vl_steps; i++)
 	{
+        // The ray can cross cube faces
+        #if POINT
+        array_index = direction_to_cube_face_index(normalize(ray_pos - light.position));
+        #endif
+
 		// Compute position in clip space
         float3 pos = project(ray_pos, light_view_projection[array_index]);
         
 		// Check to see if the light can "see" the pixel
         #ifdef DIRECTIONAL
 		float depth_delta = compare_depth(float3(pos.xy, array_index), pos.z);
-        #elif POINT
-        float depth_delta = compare_depth(normalize(ray_pos - light.position), pos.z);
-        #elif SPOT
-        float depth_delta = compare_depth(float3(pos.xy, array_index), pos.z);
+        #elif POINT || SPOT
+        float depth_delta = compare_depth(float3(atlas_uv(pos.xy, array_index), array_index), pos.z);
         #endif
        
 		if (depth_delta > 0.0f)
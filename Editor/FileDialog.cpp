@@ -24,6 +24,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "ImGui/Source/imgui_internal.h"
 #include "ImGui/Source/imgui_stdlib.h"
 #include "Rendering/Model.h"
+#include "Resource/ResourceCache.h"
+#include "Resource/AssetIndex.h"
 //======================================
 
 //= NAMESPACES ===============
@@ -464,8 +466,12 @@ bool FileDialog::DialogUpdateFromDirectory(const std::string& path)
 	m_items.clear();
 	m_items.shrink_to_fit();
 
+	// Directories which the asset index covers are listed from memory, anything else (e.g. outside the project) hits the disk
+	const AssetIndex* asset_index	= m_context->GetSubsystem<ResourceCache>()->GetAssetIndex();
+	const bool indexed				= asset_index && asset_index->IsIndexed(path);
+
 	// Get directories
-	auto child_directories = FileSystem::GetDirectoriesInDirectory(path);
+	auto child_directories = indexed ? asset_index->GetDirectoriesInDirectory(path) : FileSystem::GetDirectoriesInDirectory(path);
 	for (const auto& child_dir : child_directories)
 	{
 		m_items.emplace_back(child_dir, IconProvider::Get().Thumbnail_Load(child_dir, Thumbnail_Folder, static_cast<int>(m_item_size.x)));
@@ -475,7 +481,7 @@ bool FileDialog::DialogUpdateFromDirectory(const std::string& path)
 	vector<string> child_files;
 	if (m_filter == FileDialog_Filter_All)
 	{
-		child_files = FileSystem::GetFilesInDirectory(path);
+		child_files = indexed ? asset_index->GetFilesInDirectory(path) : FileSystem::GetFilesInDirectory(path);
 		for (const auto& child_file : child_files)
 		{
             if (!FileSystem::IsEngineTextureFile(child_file) && !FileSystem::IsEngineModelFile(child_file))
@@ -486,7 +492,7 @@ bool FileDialog::DialogUpdateFromDirectory(const std::string& path)
 	}
 	else if (m_filter == FileDialog_Filter_Scene)
 	{
-		child_files = FileSystem::GetSupportedSceneFilesInDirectory(path);
+		child_files = indexed ? asset_index->GetFilesInDirectory(path, File_Engine_World) : FileSystem::GetSupportedSceneFilesInDirectory(path);
 		for (const auto& child_file : child_files)
 		{
             m_items.emplace_back(child_file, IconProvider::Get().Thumbnail_Load(child_file, Thumbnail_File_Scene, static_cast<int>(m_item_size.x)));
@@ -494,7 +500,7 @@ bool FileDialog::DialogUpdateFromDirectory(const std::string& path)
 	}
 	else if (m_filter == FileDialog_Filter_Model)
 	{
-		child_files = FileSystem::GetSupportedModelFilesInDirectory(path);
+		child_files = indexed ? asset_index->GetFilesInDirectory(path, File_Model) : FileSystem::GetSupportedModelFilesInDirectory(path);
 		for (const auto& child_file : child_files)
 		{
             m_items.emplace_back(child_file, IconProvider::Get().Thumbnail_Load(child_file, Thumbnail_File_Model, static_cast<int>(m_item_size.x)));
@@ -26,6 +26,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../ImGui/Source/imgui_stdlib.h"
 #include "Core/Engine.h"
 #include "Rendering/Model.h"
+#include "Rendering/TerrainQuadtree.h"
 #include "World/Entity.h"
 #include "World/Components/Transform.h"
 #include "World/Components/Renderable.h"
@@ -357,6 +358,25 @@ void Widget_Properties::ShowLight(Light* light) const
             ImGui::Text("Volumeric");
             ImGui::SameLine(ComponentProperty::g_column); ImGui::Checkbox("##light_volumetric", &volumetric);
             ImGuiEx::Tooltip("The shadow map is used to determine which parts of the \"air\" should be lit");
+
+            // Shadow cache redraws
+            string redraws;
+            for (uint32_t i = 0; i < light->GetShadowArraySize(); i++)
+            {
+                redraws += (i == 0 ? "" : ", ") + to_string(light->GetShadowCacheRedrawCount(i));
+            }
+            ImGui::Text("Cache Redraws");
+            ImGui::SameLine(ComponentProperty::g_column); ImGui::TextUnformatted(redraws.c_str());
+            ImGuiEx::Tooltip("Times the static shadow casters of each slice were re-rendered, they are cached when shadow caching is enabled");
+
+            // Shadow atlas tile
+            if (light->GetLightType() != LightType_Directional)
+            {
+                const uint32_t tile_size = light->GetShadowAtlasTileSize();
+                ImGui::Text("Atlas Tile");
+                ImGui::SameLine(ComponentProperty::g_column); ImGui::TextUnformatted(tile_size != 0 ? (to_string(tile_size) + "x" + to_string(tile_size)).c_str() : "None (out of space)");
+                ImGuiEx::Tooltip("Size of the light's tiles in the shadow atlas, they are sized by how much of the screen the light covers");
+            }
         }
 
 		// Bias
@@ -945,6 +965,11 @@ void Widget_Properties::ShowTerrain(Terrain* terrain) const
                 ImGui::SameLine();
                 ImGui::Text(terrain->GetProgressDescription().c_str());
             }
+
+            if (const shared_ptr<TerrainQuadtree>& quadtree = terrain->GetQuadtree())
+            {
+                ImGui::Text("Patches: %d, chunks: %d (%d generating), %.1f MB", static_cast<uint32_t>(quadtree->GetPatches().size()), quadtree->GetChunkCount(), quadtree->GetChunkJobCount(), quadtree->GetMemoryUsage() / 1048576.0f);
+            }
         }
         ImGui::EndGroup();
 
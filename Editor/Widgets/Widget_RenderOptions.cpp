@@ -66,6 +66,7 @@ void Widget_RenderOptions::Tick()
         bool do_chromatic_aberration    = m_renderer->GetOption(Render_ChromaticAberration);
         bool do_dithering               = m_renderer->GetOption(Render_Dithering);  
         int resolution_shadow           = m_renderer->GetOptionValue<int>(Option_Value_ShadowResolution);
+        bool do_shadow_caching          = m_renderer->GetOption(Render_ShadowCaching);
 
         // Display
         {
@@ -167,6 +168,10 @@ void Widget_RenderOptions::Tick()
 
             // Shadow resolution
             ImGui::InputInt("Shadow Resolution", &resolution_shadow, 1);
+
+            // Shadow caching
+            ImGui::Checkbox("Shadow Caching", &do_shadow_caching);
+            ImGuiEx::Tooltip("Re-renders the shadows of objects which don't move only when they, or the shadow map bounds, change");
         }
 
         // Map back to engine
@@ -181,6 +186,7 @@ void Widget_RenderOptions::Tick()
         m_renderer->SetOption(Render_Sharpening_LumaSharpen,        do_sharperning);
         m_renderer->SetOption(Render_ChromaticAberration,           do_chromatic_aberration);
         m_renderer->SetOption(Render_Dithering,                     do_dithering);
+        m_renderer->SetOption(Render_ShadowCaching,                 do_shadow_caching);
         m_renderer->SetOptionValue(Option_Value_ShadowResolution,   static_cast<float>(resolution_shadow));
     }
 
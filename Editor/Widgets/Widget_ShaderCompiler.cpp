@@ -108,7 +108,7 @@ void Widget_ShaderEditor::Tick()
             
             if (ImGui::Button("Compile"))
             {
-                // Save all files
+                // Save all files, the renderer picks up the modifications and recompiles the shaders that use them in the background
                 for (auto& shader : m_shader_files)
                 {
                     ofstream out(shader.first);
@@ -116,9 +116,6 @@ void Widget_ShaderEditor::Tick()
                     out.flush();
                     out.close();
                 }
-
-                // Compile
-                m_shader->Compile(m_shader->GetShaderStage(), m_shader->GetFilePath());
             }
 
             ImGui::EndChild();
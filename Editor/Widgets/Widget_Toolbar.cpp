@@ -70,6 +70,7 @@ Widget_Toolbar::Widget_Toolbar(Context* context) : Widget(context)
     m_widgets[Icon_Component_Options]   = make_unique<Widget_RenderOptions>(context);
 
     m_context->m_engine->EngineMode_Disable(Engine_Game);
+    m_context->m_engine->EngineMode_Enable(Engine_Fixed); // simulate in fixed steps so play mode behaves the same at any frame rate
 }
 
 void Widget_Toolbar::Tick()
@@ -30,6 +30,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Core/Context.h"
 #include "../Profiling/Profiler.h"
 #include "../World/Components/Transform.h"
+#include "AudioClip.h"
 //========================================
 
 //= NAMESPACES ======
@@ -102,6 +103,18 @@ namespace Spartan
             return false;
         }
 
+        // Without one (e.g. a headless machine), everything still runs, it just isn't heard
+        if (driver_count == 0)
+        {
+            LOG_INFO("No audio device found, using FMOD's no sound output");
+            m_result_fmod = m_system_fmod->setOutput(FMOD_OUTPUTTYPE_NOSOUND);
+            if (m_result_fmod != FMOD_OK)
+            {
+                LogErrorFmod(m_result_fmod);
+                return false;
+            }
+        }
+
         // Initialize FMOD
         m_result_fmod = m_system_fmod->init(m_max_channels, FMOD_INIT_NORMAL, nullptr);
         if (m_result_fmod != FMOD_OK)
@@ -148,26 +161,16 @@ namespace Spartan
 
         SCOPED_TIME_BLOCK(m_profiler);
 
-		// Update FMOD
-		m_result_fmod = m_system_fmod->update();
-		if (m_result_fmod != FMOD_OK)
-		{
-			LogErrorFmod(m_result_fmod);
-			return;
-		}
-
 		if (m_listener)
 		{
-			auto position = m_listener->GetPosition();
-			auto velocity = Math::Vector3::Zero;
 			auto forward = m_listener->GetForward();
 			auto up = m_listener->GetUp();
 
-			// Set 3D attributes
+			// Set 3D attributes, the position and velocity are from the last simulation step (see SetListenerTransform())
 			m_result_fmod = m_system_fmod->set3DListenerAttributes(
 				0, 
-				reinterpret_cast<FMOD_VECTOR*>(&position), 
-				reinterpret_cast<FMOD_VECTOR*>(&velocity), 
+				reinterpret_cast<FMOD_VECTOR*>(&m_listener_position), 
+				reinterpret_cast<FMOD_VECTOR*>(&m_listener_velocity), 
 				reinterpret_cast<FMOD_VECTOR*>(&forward), 
 				reinterpret_cast<FMOD_VECTOR*>(&up)
 			);
@@ -177,11 +180,57 @@ namespace Spartan
 				return;
 			}
 		}
+
+		UpdateEmitters(delta_time);
+
+		// Update FMOD
+		m_result_fmod = m_system_fmod->update();
+		if (m_result_fmod != FMOD_OK)
+		{
+			LogErrorFmod(m_result_fmod);
+			return;
+		}
+	}
+
+	void Audio::UpdateEmitters(float delta_time)
+	{
+		// Decide which emitters are heard, then only touch FMOD for the ones that changed
+		m_emitters.Update(m_listener_position, m_max_voices, delta_time);
+
+		for (const uint32_t id : m_emitters.GetBecameVirtual())
+		{
+			m_emitters.Get(id).clip->Virtualize();
+		}
+
+		for (const uint32_t id : m_emitters.GetBecameReal())
+		{
+			const AudioEmitter& emitter = m_emitters.Get(id);
+			emitter.clip->Devirtualize(emitter.position, emitter.velocity, emitter.virtual_time);
+		}
+
+		for (const uint32_t id : m_emitters.GetMoved())
+		{
+			const AudioEmitter& emitter = m_emitters.Get(id);
+			emitter.clip->Set3DAttributes(emitter.position, emitter.velocity);
+		}
+
+		if (m_profiler)
+		{
+			m_profiler->m_audio_emitters			= m_emitters.GetEmitterCount();
+			m_profiler->m_audio_emitters_real		= m_emitters.GetRealCount();
+			m_profiler->m_audio_emitters_culled		= m_emitters.GetCulledCount();
+			m_profiler->m_audio_attributes_pushed	= static_cast<uint32_t>(m_emitters.GetBecameReal().size() + m_emitters.GetMoved().size());
+		}
 	}
 
-    void Audio::SetListenerTransform(Transform* transform)
+    void Audio::SetListenerTransform(Transform* transform, const float delta_time)
 	{
-		m_listener = transform;
+		// Derive the velocity (for the doppler effect) over the simulation step, the same way the emitters do.
+		// A listener which was just set has nothing to derive it from.
+		const Math::Vector3 position	= transform->GetPosition();
+		m_listener_velocity				= (transform == m_listener && delta_time > 0.0f) ? (position - m_listener_position) / delta_time : Math::Vector3::Zero;
+		m_listener_position				= position;
+		m_listener						= transform;
 	}
 
 	void Audio::LogErrorFmod(int error) const
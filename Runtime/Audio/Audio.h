@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ==================
 #include "../Core/ISubsystem.h"
+#include "AudioEmitters.h"
 //=============================
 
 //= FORWARD DECLARATIONS =
@@ -49,16 +50,23 @@ namespace Spartan
         //===================================
 
 		auto GetSystemFMOD() const { return m_system_fmod; }
-		void SetListenerTransform(Transform* transform);
+		void SetListenerTransform(Transform* transform, float delta_time); // called every simulation step, delta_time is the step
+		AudioEmitters& GetEmitters() { return m_emitters; }
 
 	private:
 		void LogErrorFmod(int error) const;
 
+		void UpdateEmitters(float delta_time);
+
 		uint32_t m_result_fmod		= 0;
-		uint32_t m_max_channels		= 32;
+		uint32_t m_max_channels		= 1024;	// FMOD channels, virtual emitters keep theirs (paused)
+		uint32_t m_max_voices		= 32;	// emitters which are actually heard
 		float m_distance_entity		= 1.0f;
 		bool m_initialized			= false;
 		Transform* m_listener		= nullptr;
+		Math::Vector3 m_listener_position;
+		Math::Vector3 m_listener_velocity;
+		AudioEmitters m_emitters;
 		Profiler* m_profiler		= nullptr;
 		FMOD::System* m_system_fmod = nullptr;
 	};
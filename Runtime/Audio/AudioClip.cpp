@@ -40,7 +40,8 @@ namespace Spartan
 	{
 		// AudioClip
 		m_transform		= nullptr;
-		m_systemFMOD	= static_cast<System*>(context->GetSubsystem<Audio>()->GetSystemFMOD());
+		m_audio			= context->GetSubsystem<Audio>();
+		m_systemFMOD	= static_cast<System*>(m_audio->GetSystemFMOD());
 		m_result		= FMOD_OK;
 		m_soundFMOD		= nullptr;
 		m_channelFMOD	= nullptr;
@@ -49,10 +50,15 @@ namespace Spartan
 		m_maxDistance	= 10000.0f;
 		m_modeRolloff	= FMOD_3D_LINEARROLLOFF;
 		m_modeLoop		= FMOD_LOOP_OFF;
+		m_priority		= 128;
+		m_emitter_id	= 0;
+		m_has_emitter	= false;
 	}
 
 	AudioClip::~AudioClip()
 	{
+		RemoveEmitter();
+
 		if (!m_soundFMOD)
 			return;
 
@@ -119,14 +125,22 @@ namespace Spartan
 				return true;
 		}
 
-		// Start playing the sound
-		m_result = m_systemFMOD->playSound(m_soundFMOD, nullptr, false, &m_channelFMOD);
+		// Start playing the sound, 3D sounds start paused until the audio emitters give them a voice
+		const bool is_3d = m_transform != nullptr;
+		m_result = m_systemFMOD->playSound(m_soundFMOD, nullptr, is_3d, &m_channelFMOD);
 		if (m_result != FMOD_OK)
 		{
 			LogErrorFmod(m_result);
 			return false;
 		}
 
+		if (is_3d && !m_has_emitter)
+		{
+			m_emitter_id	= m_audio->GetEmitters().Add(this, m_maxDistance, m_priority);
+			m_has_emitter	= true;
+			m_audio->GetEmitters().SetPosition(m_emitter_id, m_transform->GetPosition(), 0.0f);
+		}
+
 		return true;
 	}
 
@@ -161,6 +175,8 @@ namespace Spartan
 
 	bool AudioClip::Stop()
 	{
+		RemoveEmitter();
+
 		if (!IsChannelValid())
 			return true;
 
@@ -238,6 +254,12 @@ namespace Spartan
 
 	bool AudioClip::SetPriority(const int priority)
 	{
+		m_priority = priority;
+		if (m_has_emitter)
+		{
+			m_audio->GetEmitters().SetPriority(m_emitter_id, priority);
+		}
+
 		if (!IsChannelValid())
 			return false;
 
@@ -322,26 +344,83 @@ namespace Spartan
 		return true;
 	}
 
-	bool AudioClip::Update()
+	bool AudioClip::Update(const float delta_time)
 	{
-		if (!IsChannelValid() || !m_transform)
+		if (!m_has_emitter || !m_transform)
 			return true;
 
-		const auto pos = m_transform->GetPosition();
+		// The sound has finished playing
+		if (!IsChannelValid())
+		{
+			RemoveEmitter();
+			m_channelFMOD = nullptr;
+			return true;
+		}
+
+		m_audio->GetEmitters().SetPosition(m_emitter_id, m_transform->GetPosition(), delta_time);
+
+		return true;
+	}
+
+	void AudioClip::Virtualize()
+	{
+		if (!IsChannelValid())
+			return;
+
+		m_result = m_channelFMOD->setPaused(true);
+		if (m_result != FMOD_OK)
+		{
+			LogErrorFmod(m_result);
+		}
+	}
+
+	void AudioClip::Devirtualize(const Vector3& position, const Vector3& velocity, const float virtual_time)
+	{
+		if (!IsChannelValid())
+			return;
+
+		// Resume where the sound would have been, had it kept playing
+		uint32_t position_ms	= 0;
+		uint32_t length_ms		= 0;
+		m_channelFMOD->getPosition(&position_ms, FMOD_TIMEUNIT_MS);
+		m_soundFMOD->getLength(&length_ms, FMOD_TIMEUNIT_MS);
+		position_ms += static_cast<uint32_t>(virtual_time * 1000.0f);
+		if (length_ms != 0 && position_ms >= length_ms)
+		{
+			// It would have ended by now
+			if (m_modeLoop == FMOD_LOOP_OFF)
+			{
+				Stop();
+				return;
+			}
 
-		FMOD_VECTOR f_mod_pos = { pos.x, pos.y, pos.z };
-		FMOD_VECTOR f_mod_vel = { 0, 0, 0 };
+			position_ms %= length_ms;
+		}
+
+		m_channelFMOD->setPosition(position_ms, FMOD_TIMEUNIT_MS);
+		Set3DAttributes(position, velocity);
+
+		m_result = m_channelFMOD->setPaused(false);
+		if (m_result != FMOD_OK)
+		{
+			LogErrorFmod(m_result);
+		}
+	}
+
+	void AudioClip::Set3DAttributes(const Vector3& position, const Vector3& velocity)
+	{
+		if (!IsChannelValid())
+			return;
+
+		FMOD_VECTOR f_mod_pos = { position.x, position.y, position.z };
+		FMOD_VECTOR f_mod_vel = { velocity.x, velocity.y, velocity.z };
 
 		// Set 3D attributes
 		m_result = m_channelFMOD->set3DAttributes(&f_mod_pos, &f_mod_vel);
 		if (m_result != FMOD_OK)
 		{
-			m_channelFMOD = nullptr;
 			LogErrorFmod(m_result);
-			return false;
 		}
-
-		return true;
 	}
 
 	bool AudioClip::IsPlaying()
@@ -413,6 +492,15 @@ namespace Spartan
 		LOG_ERROR("%s", FMOD_ErrorString(static_cast<FMOD_RESULT>(error)));
 	}
 
+	void AudioClip::RemoveEmitter()
+	{
+		if (!m_has_emitter)
+			return;
+
+		m_audio->GetEmitters().Remove(m_emitter_id);
+		m_has_emitter = false;
+	}
+
 	bool AudioClip::IsChannelValid() const
 	{
 		if (!m_channelFMOD)
@@ -38,6 +38,7 @@ namespace FMOD
 namespace Spartan
 {
 	class Transform;
+	class Audio;
 
 	enum PlayMode
 	{
@@ -91,8 +92,13 @@ namespace Spartan
 		// Makes the audio use the 3D attributes of the transform
 		void SetTransform(Transform* transform) { m_transform = transform; }
 
-		// Should be called per frame to update the 3D attributes of the sound
-		bool Update();
+		// Should be called per tick, it hands the position of the sound to the audio emitters, which push it to FMOD when needed
+		bool Update(float delta_time);
+
+		// Called by the audio emitters when the sound loses or gets back its voice
+		void Virtualize();
+		void Devirtualize(const Math::Vector3& position, const Math::Vector3& velocity, float virtual_time);
+		void Set3DAttributes(const Math::Vector3& position, const Math::Vector3& velocity);
 
 		bool IsPlaying();
 
@@ -104,8 +110,10 @@ namespace Spartan
 		int GetSoundMode() const;
 		void LogErrorFmod(int error) const;
 		bool IsChannelValid() const;
+		void RemoveEmitter();
 
 		Transform* m_transform;
+		Audio* m_audio;
 		FMOD::System* m_systemFMOD;
 		FMOD::Sound* m_soundFMOD;
 		FMOD::Channel* m_channelFMOD;	
@@ -114,6 +122,9 @@ namespace Spartan
 		float m_minDistance;
 		float m_maxDistance;
 		int m_modeRolloff;
+		int m_priority;
 		int m_result;
+		uint32_t m_emitter_id;
+		bool m_has_emitter;
 	};
 }
@@ -0,0 +1,178 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ==================
+#include "AudioEmitters.h"
+#include <algorithm>
+//=============================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+namespace Spartan
+{
+    uint32_t AudioEmitters::Add(AudioClip* clip, const float max_distance, const int priority)
+    {
+        uint32_t id = static_cast<uint32_t>(m_emitters.size());
+        if (!m_free.empty())
+        {
+            id = m_free.back();
+            m_free.pop_back();
+        }
+        else
+        {
+            m_emitters.emplace_back();
+        }
+
+        AudioEmitter& emitter   = m_emitters[id];
+        emitter                 = AudioEmitter();
+        emitter.clip            = clip;
+        emitter.max_distance    = max_distance;
+        emitter.priority        = priority;
+        emitter.active          = true;
+        m_emitter_count++;
+
+        return id;
+    }
+
+    void AudioEmitters::Remove(const uint32_t id)
+    {
+        if (id >= m_emitters.size() || !m_emitters[id].active)
+            return;
+
+        m_emitters[id].active   = false;
+        m_emitters[id].clip     = nullptr;
+        m_free.emplace_back(id);
+        m_emitter_count--;
+    }
+
+    void AudioEmitters::SetPosition(const uint32_t id, const Vector3& position, const float delta_time)
+    {
+        AudioEmitter& emitter = m_emitters[id];
+
+        // The first position has nothing to derive a velocity from
+        if (!emitter.placed)
+        {
+            emitter.position    = position;
+            emitter.velocity    = Vector3::Zero;
+            emitter.placed      = true;
+            emitter.moved       = true;
+            return;
+        }
+
+        const Vector3 velocity = delta_time > 0.0f ? (position - emitter.position) / delta_time : Vector3::Zero;
+
+        // Still, and was still before
+        if (position == emitter.position && velocity == emitter.velocity)
+            return;
+
+        emitter.position    = position;
+        emitter.velocity    = velocity;
+        emitter.moved       = true;
+    }
+
+    void AudioEmitters::SetPriority(const uint32_t id, const int priority)
+    {
+        m_emitters[id].priority = priority;
+    }
+
+    void AudioEmitters::Update(const Vector3& listener_position, const uint32_t voice_count, const float delta_time)
+    {
+        m_became_real.clear();
+        m_became_virtual.clear();
+        m_moved.clear();
+        m_candidates.clear();
+        m_distances_squared.resize(m_emitters.size());
+        m_real_next.assign(m_emitters.size(), 0);
+        m_culled_count = 0;
+
+        // Cull whatever is out of range (or has no position yet)
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_emitters.size()); i++)
+        {
+            const AudioEmitter& emitter = m_emitters[i];
+            if (!emitter.active)
+                continue;
+
+            m_distances_squared[i] = Vector3::DistanceSquared(listener_position, emitter.position);
+            if (!emitter.placed || m_distances_squared[i] > emitter.max_distance * emitter.max_distance)
+            {
+                m_culled_count++;
+                continue;
+            }
+
+            m_candidates.emplace_back(i);
+        }
+
+        // Keep the most important emitters, closest first among equals
+        if (m_candidates.size() > voice_count)
+        {
+            nth_element(m_candidates.begin(), m_candidates.begin() + voice_count, m_candidates.end(), [this](const uint32_t a, const uint32_t b)
+            {
+                if (m_emitters[a].priority != m_emitters[b].priority)
+                    return m_emitters[a].priority < m_emitters[b].priority;
+
+                return m_distances_squared[a] < m_distances_squared[b];
+            });
+            m_candidates.resize(voice_count);
+        }
+
+        for (const uint32_t i : m_candidates)
+        {
+            m_real_next[i] = 1;
+        }
+        m_real_count = static_cast<uint32_t>(m_candidates.size());
+
+        // List the transitions, emitters which become real get their attributes pushed when they resume
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_emitters.size()); i++)
+        {
+            AudioEmitter& emitter = m_emitters[i];
+            if (!emitter.active)
+                continue;
+
+            const bool real = m_real_next[i] != 0;
+            if (real && !emitter.real)
+            {
+                m_became_real.emplace_back(i);
+                emitter.moved = false;
+            }
+            else if (!real && emitter.real)
+            {
+                m_became_virtual.emplace_back(i);
+                emitter.virtual_time = 0.0f;
+            }
+            else if (real && emitter.moved)
+            {
+                m_moved.emplace_back(i);
+                emitter.moved = false;
+            }
+
+            if (!real)
+            {
+                emitter.virtual_time += delta_time;
+            }
+
+            emitter.real = real;
+        }
+    }
+}
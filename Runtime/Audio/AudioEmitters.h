@@ -0,0 +1,90 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+//= INCLUDES ==============
+#include <vector>
+#include "../Core/EngineDefs.h"
+#include "../Math/Vector3.h"
+//=========================
+
+namespace Spartan
+{
+    class AudioClip;
+
+    struct AudioEmitter
+    {
+        AudioClip* clip         = nullptr;
+        Math::Vector3 position  = Math::Vector3::Zero;
+        Math::Vector3 velocity  = Math::Vector3::Zero; // derived from how far the position moved during the simulation step
+        float max_distance      = 0.0f;     // inaudible beyond this
+        float virtual_time      = 0.0f;     // seconds spent without a voice, so that playback can resume where it would have been
+        int priority            = 128;      // from 0 (most important) to 255 (least important)
+        bool moved              = true;     // position or velocity changed since they were last pushed to FMOD
+        bool real               = false;    // has a voice, otherwise it's virtual (paused, and FMOD is not touched)
+        bool placed             = false;    // has been given a position at least once
+        bool active             = false;    // false if the slot is free
+    };
+
+    // Keeps track of every playing 3D sound and decides which of them get an actual voice, before FMOD is touched.
+    // Emitters beyond their max distance are culled and the rest compete for a limited number of real voices, by priority
+    // and then by distance. Positions are dirty-tracked, so only real emitters which moved have their attributes pushed.
+    class SPARTAN_CLASS AudioEmitters
+    {
+    public:
+        AudioEmitters() = default;
+        ~AudioEmitters() = default;
+
+        uint32_t Add(AudioClip* clip, float max_distance, int priority);
+        void Remove(uint32_t id);
+        // Called from the simulation (World's ticks), delta_time is the step the position was reached in. Under Engine_Fixed that's
+        // the fixed step, since positions only change when the simulation steps, however many (or few) frames that takes.
+        void SetPosition(uint32_t id, const Math::Vector3& position, float delta_time);
+        void SetPriority(uint32_t id, int priority);
+
+        // Picks the real voices, afterwards the emitters which changed state or moved are listed by the getters below.
+        // Called once per frame, delta_time is the frame time (virtual emitters keep track of where playback would be).
+        void Update(const Math::Vector3& listener_position, uint32_t voice_count, float delta_time);
+
+        AudioEmitter& Get(uint32_t id)                                  { return m_emitters[id]; }
+        const std::vector<uint32_t>& GetBecameReal()            const   { return m_became_real; }
+        const std::vector<uint32_t>& GetBecameVirtual()         const   { return m_became_virtual; }
+        const std::vector<uint32_t>& GetMoved()                 const   { return m_moved; } // real emitters, which need their attributes pushed
+        uint32_t GetEmitterCount()                              const   { return m_emitter_count; }
+        uint32_t GetRealCount()                                 const   { return m_real_count; }
+        uint32_t GetCulledCount()                               const   { return m_culled_count; }
+
+    private:
+        std::vector<AudioEmitter> m_emitters;
+        std::vector<uint32_t> m_free;
+        std::vector<uint32_t> m_candidates;
+        std::vector<float> m_distances_squared;
+        std::vector<uint8_t> m_real_next;
+        std::vector<uint32_t> m_became_real;
+        std::vector<uint32_t> m_became_virtual;
+        std::vector<uint32_t> m_moved;
+        uint32_t m_emitter_count    = 0;
+        uint32_t m_real_count       = 0;
+        uint32_t m_culled_count     = 0;
+    };
+}
@@ -34,6 +34,7 @@ namespace Spartan
     enum Tick_Group
     {
         Tick_Variable,
+        Tick_Fixed,     // simulation, can tick multiple times per frame
         Tick_Smoothed
     };
 
@@ -50,6 +50,7 @@ namespace Spartan
         // Flags
         m_flags |= Engine_Physics;
         m_flags |= Engine_Game;
+        m_flags |= Engine_Fixed;
 
         // Create context
 		m_context = make_shared<Context>();
@@ -60,10 +61,10 @@ namespace Spartan
         m_context->RegisterSubsystem<Timer>(Tick_Variable);         // must be first so it ticks first
 		m_context->RegisterSubsystem<ResourceCache>(Tick_Variable);		
 		m_context->RegisterSubsystem<Audio>(Tick_Variable);
-        m_context->RegisterSubsystem<Physics>(Tick_Variable);       // integrates internally
-        m_context->RegisterSubsystem<Input>(Tick_Smoothed);
-		m_context->RegisterSubsystem<Scripting>(Tick_Smoothed);
-		m_context->RegisterSubsystem<World>(Tick_Smoothed);
+        m_context->RegisterSubsystem<Input>(Tick_Variable);         // must tick before the simulation
+        m_context->RegisterSubsystem<Physics>(Tick_Fixed);          // integrates internally when not in fixed mode
+		m_context->RegisterSubsystem<Scripting>(Tick_Fixed);
+		m_context->RegisterSubsystem<World>(Tick_Fixed);
         m_context->RegisterSubsystem<Renderer>(Tick_Smoothed);
         m_context->RegisterSubsystem<Profiler>(Tick_Variable);
         m_context->RegisterSubsystem<Settings>(Tick_Variable);
@@ -82,6 +83,25 @@ namespace Spartan
 	void Engine::Tick() const
     {
         m_context->Tick(Tick_Variable, static_cast<float>(m_timer->GetDeltaTimeSec()));
+
+        // Per frame work which can't wait for a fixed step (e.g. world loading and game start/stop)
+        FIRE_EVENT(Event_Frame_Start);
+
+        // Simulation
+        if (EngineMode_IsSet(Engine_Fixed))
+        {
+            // Run as many fixed steps as the accumulated time allows, the renderer will interpolate the remainder
+            for (uint32_t i = 0; i < m_timer->GetFixedStepCount(); i++)
+            {
+                FIRE_EVENT(Event_Frame_Fixed_Step);
+                m_context->Tick(Tick_Fixed, m_timer->GetFixedDeltaTimeSec());
+            }
+        }
+        else
+        {
+            m_context->Tick(Tick_Fixed, static_cast<float>(m_timer->GetDeltaTimeSmoothedSec()));
+        }
+
         m_context->Tick(Tick_Smoothed, static_cast<float>(m_timer->GetDeltaTimeSmoothedSec()));
 	}
 
@@ -50,6 +50,7 @@ namespace Spartan
 	{
 		Engine_Physics	= 1UL << 0, // Should the physics tick?	
 		Engine_Game		= 1UL << 1,	// Is the engine running in game or editor mode?
+		Engine_Fixed	= 1UL << 2, // Should the simulation advance in fixed steps (with the renderer interpolating between them)?
 	};
 
 	class SPARTAN_CLASS Engine
@@ -28,6 +28,7 @@ constexpr auto engine_version = "v0.31 WIP";
 //#define API_GRAPHICS_D3D11
 //#define API_GRAPHICS_D3D12
 //#define API_GRAPHICS_VULKAN
+//#define API_GRAPHICS_NULL
 #define API_INPUT_WINDOWS
 
 // Class
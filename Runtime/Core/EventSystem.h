@@ -42,7 +42,9 @@ Note: Currently, this is a blocking event system
 
 enum Event_Type
 {
+    Event_Frame_Start,              // A frame starts, fired once before the simulation regardless of how many fixed steps run
 	Event_Frame_End,		        // A frame ends
+    Event_Frame_Fixed_Step,         // A fixed simulation step is about to run
     Event_Window_Data,              // The window has a message for proccesing
 	Event_World_Save,		        // The world must be saved to file
 	Event_World_Saved,		        // The world finished saving to file
@@ -53,6 +55,7 @@ enum Event_Type
 	Event_World_Resolve_Complete,	// The world has finished resolving
 	Event_World_Stop,		        // The world should stop ticking
 	Event_World_Start,		        // The world should start ticking
+	Event_World_Scripts_Ticked,	// The world ticked the scripts of its entities, it ticks their other components next
     Event_Frame_Resolution_Changed
 };
 
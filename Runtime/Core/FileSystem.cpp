@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <regex>
 #include <fstream>
 #include <sstream> 
+#include <unordered_map>
 #include "../Logging/Log.h"
 #include <Windows.h>
 #include <shellapi.h>
@@ -293,6 +294,14 @@ namespace Spartan
         return false;
     }
 
+    uint64_t FileSystem::GetLastWriteTime(const string& path)
+    {
+        // Files can be in the middle of being saved, so failures are expected and not worth a warning
+        error_code error;
+        const auto time = filesystem::last_write_time(path, error);
+        return error ? 0 : static_cast<uint64_t>(time.time_since_epoch().count());
+    }
+
 	bool FileSystem::CopyFileFromTo(const string& source, const string& destination)
 	{
 		if (source == destination)
@@ -315,6 +324,20 @@ namespace Spartan
 		}
 	}
 
+    bool FileSystem::Rename(const string& source, const string& destination)
+    {
+        try
+        {
+            filesystem::rename(source, destination);
+            return true;
+        }
+        catch (filesystem::filesystem_error& e)
+        {
+            LOG_WARNING("%s", e.what());
+            return false;
+        }
+    }
+
     string FileSystem::GetFileNameFromFilePath(const string& path)
 	{
         return filesystem::path(path).filename().generic_string();
@@ -439,138 +462,135 @@ namespace Spartan
 		return file_paths;
 	}
 
-	bool FileSystem::IsSupportedAudioFile(const string& path)
-	{
-        const string extension = GetExtensionFromFilePath(path);
+    File_Type FileSystem::GetFileType(const string& path)
+    {
+        // Every known extension, lowercase
+        static const unordered_map<string, File_Type> file_types = []()
+        {
+            unordered_map<string, File_Type> types;
+            for (const auto& format : supported_formats_image)  types[format] = File_Image;
+            for (const auto& format : supported_formats_audio)  types[format] = File_Audio;
+            for (const auto& format : supported_formats_model)  types[format] = File_Model;
+            for (const auto& format : supported_formats_shader) types[format] = File_Shader;
+            for (const auto& format : supported_formats_script) types[format] = File_Script;
+            for (const auto& format : supported_formats_font)   types[format] = File_Font;
+            types[EXTENSION_WORLD]      = File_Engine_World;
+            types[EXTENSION_MATERIAL]   = File_Engine_Material;
+            types[EXTENSION_MODEL]      = File_Engine_Model;
+            types[EXTENSION_PREFAB]     = File_Engine_Prefab;
+            types[EXTENSION_SHADER]     = File_Engine_Shader;
+            types[EXTENSION_FONT]       = File_Engine_Font;
+            types[EXTENSION_TEXTURE]    = File_Engine_Texture;
+            types[EXTENSION_MESH]       = File_Engine_Mesh;
+            types[EXTENSION_AUDIO]      = File_Engine_Audio;
+            return types;
+        }();
+
+        // The extension starts at the last dot of the file name, unless that's its first character (like std::filesystem)
+        const size_t name_start = path.find_last_of("/\\") + 1;
+        const size_t dot        = path.find_last_of('.');
+        if (dot == string::npos || dot <= name_start || path.size() - dot > 15)
+            return File_Unknown;
+
+        // Short enough for the small string buffer, so no allocation
+        string extension = path.substr(dot);
+        for (char& c : extension)
+        {
+            c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+        }
 
-		for (const auto& format : supported_formats_audio)
-		{
-			if (extension == format || extension == ConvertToUppercase(format))
-				return true;
-		}
+        const auto it = file_types.find(extension);
+        return it != file_types.end() ? it->second : File_Unknown;
+    }
 
-		return false;
+	bool FileSystem::IsSupportedAudioFile(const string& path)
+	{
+        return GetFileType(path) == File_Audio;
 	}
 
 	bool FileSystem::IsSupportedImageFile(const string& path)
 	{
-        const string extension = GetExtensionFromFilePath(path);
-
-		for (const auto& format : supported_formats_image)
-		{
-			if (extension == format || extension == ConvertToUppercase(format))
-				return true;
-		}
-		
-		if (GetExtensionFromFilePath(path) == EXTENSION_TEXTURE)
-			return true;
-
-		return false;
+        const File_Type type = GetFileType(path);
+        return type == File_Image || type == File_Engine_Texture;
 	}
 
 	bool FileSystem::IsSupportedModelFile(const string& path)
 	{
-        const string extension = GetExtensionFromFilePath(path);
-
-		for (const auto& format : supported_formats_model)
-		{
-			if (extension == format || extension == ConvertToUppercase(format))
-				return true;
-		}
-
-		return false;
+        return GetFileType(path) == File_Model;
 	}
 
 	bool FileSystem::IsSupportedShaderFile(const string& path)
 	{
-        const string extension = GetExtensionFromFilePath(path);
-
-		for (const auto& format : supported_formats_shader)
-		{
-			if (extension == format || extension == ConvertToUppercase(format))
-				return true;
-		}
-
-		return false;
+        return GetFileType(path) == File_Shader;
 	}
 
 	bool FileSystem::IsSupportedFontFile(const string& path)
 	{
-        const string extension = GetExtensionFromFilePath(path);
-
-		for (const auto& format : supported_formats_font)
-		{
-			if (extension == format || extension == ConvertToUppercase(format))
-				return true;
-		}
-
-		return false;
+        return GetFileType(path) == File_Font;
 	}
 
 	bool FileSystem::IsEngineScriptFile(const string& path)
 	{
-        const string extension = GetExtensionFromFilePath(path);
-
-		for (const auto& format : supported_formats_script)
-		{
-			if (extension == format || extension == ConvertToUppercase(format))
-				return true;
-		}
-
-		return false;
+        return GetFileType(path) == File_Script;
 	}
 
 	bool FileSystem::IsEnginePrefabFile(const string& path)
 	{
-		return GetExtensionFromFilePath(path) == EXTENSION_PREFAB;
+		return GetFileType(path) == File_Engine_Prefab;
 	}
 
 	bool FileSystem::IsEngineModelFile(const string& path)
 	{
-		return GetExtensionFromFilePath(path) == EXTENSION_MODEL;
+		return GetFileType(path) == File_Engine_Model;
 	}
 
 	bool FileSystem::IsEngineMaterialFile(const string& path)
 	{
-		return GetExtensionFromFilePath(path) == EXTENSION_MATERIAL;
+		return GetFileType(path) == File_Engine_Material;
 	}
 
 	bool FileSystem::IsEngineMeshFile(const string& path)
 	{
-		return GetExtensionFromFilePath(path) == EXTENSION_MESH;
+		return GetFileType(path) == File_Engine_Mesh;
 	}
 
 	bool FileSystem::IsEngineSceneFile(const string& path)
 	{
-		return GetExtensionFromFilePath(path) == EXTENSION_WORLD;
+		return GetFileType(path) == File_Engine_World;
 	}
 
 	bool FileSystem::IsEngineTextureFile(const string& path)
 	{
-		return GetExtensionFromFilePath(path) == EXTENSION_TEXTURE;
+		return GetFileType(path) == File_Engine_Texture;
 	}
 
     bool FileSystem::IsEngineAudioFile(const std::string& path)
     {
-        return GetExtensionFromFilePath(path) == EXTENSION_AUDIO;
+        return GetFileType(path) == File_Engine_Audio;
     }
 
     bool FileSystem::IsEngineShaderFile(const string& path)
 	{
-		return GetExtensionFromFilePath(path) == EXTENSION_SHADER;
+		return GetFileType(path) == File_Engine_Shader;
 	}
 
     bool FileSystem::IsEngineFile(const string& path)
     {
-        return  IsEngineScriptFile(path)   ||
-                IsEnginePrefabFile(path)   ||
-                IsEngineModelFile(path)    ||
-                IsEngineMaterialFile(path) ||
-                IsEngineMeshFile(path)     ||
-                IsEngineSceneFile(path)    ||
-                IsEngineTextureFile(path)  ||
-                IsEngineAudioFile(path)    ||
-                IsEngineShaderFile(path);
+        switch (GetFileType(path))
+        {
+            case File_Script:
+            case File_Engine_Prefab:
+            case File_Engine_Model:
+            case File_Engine_Material:
+            case File_Engine_Mesh:
+            case File_Engine_World:
+            case File_Engine_Texture:
+            case File_Engine_Audio:
+            case File_Engine_Shader:
+                return true;
+            default:
+                return false;
+        }
     }
 
     vector<string> FileSystem::GetSupportedFilesInDirectory(const string& path)
@@ -29,6 +29,28 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 namespace Spartan
 {
+    // What a file is, judging by its extension
+    enum File_Type : uint8_t
+    {
+        File_Unknown,
+        File_Image,
+        File_Audio,
+        File_Model,
+        File_Shader,
+        File_Script,
+        File_Font,
+        File_Engine_World,
+        File_Engine_Material,
+        File_Engine_Model,
+        File_Engine_Prefab,
+        File_Engine_Shader,
+        File_Engine_Font,
+        File_Engine_Texture,
+        File_Engine_Mesh,
+        File_Engine_Audio,
+        File_Type_Count
+    };
+
 	class SPARTAN_CLASS FileSystem
 	{
 	public:
@@ -51,7 +73,9 @@ namespace Spartan
 		static bool Exists(const std::string& path);
         static bool IsDirectory(const std::string& path);
         static bool IsFile(const std::string& path);
+        static uint64_t GetLastWriteTime(const std::string& path); // opaque, only meaningful when compared with another call
 		static bool CopyFileFromTo(const std::string& source, const std::string& destination);
+        static bool Rename(const std::string& source, const std::string& destination); // replaces the destination, if it exists
 		static std::string GetFileNameFromFilePath(const std::string& path);
 		static std::string GetFileNameNoExtensionFromFilePath(const std::string& path);
 		static std::string GetDirectoryFromFilePath(const std::string& path);
@@ -66,6 +90,7 @@ namespace Spartan
 		static std::vector<std::string> GetFilesInDirectory(const std::string& path);
 
         // Supported files
+        static File_Type GetFileType(const std::string& path); // a single hashed lookup, extensions are case insensitive
 		static bool IsSupportedAudioFile(const std::string& path);
 		static bool IsSupportedImageFile(const std::string& path);
 		static bool IsSupportedModelFile(const std::string& path);
@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Context.h"
 #include "Settings.h"
 #include "../Logging/Log.h"
+#include "../Math/MathHelper.h"
 #include "../RHI/RHI_Device.h"
 #include "../Rendering/Renderer.h"
 //================================
@@ -48,29 +49,25 @@ namespace Spartan
         m_time_frame_start  = chrono::high_resolution_clock::now();
 
         // Compute durations
-        const chrono::duration<double, milli> time_elapsed      = m_time_start - m_time_frame_start;
         chrono::duration<double, milli> time_delta              = m_time_frame_start - m_time_frame_end;
 		const chrono::duration<double, milli> time_remaining    = chrono::duration<double, milli>(1000.0 / m_fps_target) - time_delta;
 
         // Fps limiting
-		if (time_remaining.count() > 0)
+        if (m_frame_time_override_ms > 0.0)
+        {
+            time_delta = chrono::duration<double, milli>(m_frame_time_override_ms);
+        }
+		else if (time_remaining.count() > 0)
 		{
-            // Compute sleep duration and account for the sleep overhead.
-            // The sleep overhead is the time the kernel takes to wake up the thread after the thread has finished sleeping.
-            chrono::duration<double, milli> sleep_duration_requested = chrono::duration<double, milli>(time_remaining.count() - m_sleep_overhead);
-
-            // Put the thread to sleep
-            this_thread::sleep_until(m_time_frame_start + sleep_duration_requested);
-
-            // Compute sleep overhead (to use in next tick)
-            chrono::duration<double, milli> sleep_time_real = chrono::high_resolution_clock::now() - m_time_frame_start;
-            m_sleep_overhead = sleep_time_real.count() - sleep_duration_requested.count();
+            WaitUntil(m_time_frame_start + chrono::duration_cast<chrono::high_resolution_clock::duration>(time_remaining));
 
-            // Account for sleep duration
-            time_delta += sleep_time_real;
+            // The frame starts once pacing is done, this way the wait is only accounted for once
+            m_time_frame_start  = chrono::high_resolution_clock::now();
+            time_delta          = m_time_frame_start - m_time_frame_end;
 		}
 
         // Save times
+        const chrono::duration<double, milli> time_elapsed = m_time_frame_start - m_time_start;
         m_time_ms           = static_cast<double>(time_elapsed.count());
 		m_delta_time_ms     = static_cast<double>(time_delta.count());
 
@@ -80,8 +77,60 @@ namespace Spartan
         double delta_max                    = 1000.0 / m_fps_min;
         const double delta_clamped          = m_delta_time_ms > delta_max ? delta_max : m_delta_time_ms; // If frame time is too high/slow, clamp it   
         m_delta_time_smoothed_ms            = m_delta_time_smoothed_ms * (1.0 - delta_feedback) + delta_clamped * delta_feedback;
+
+        // Fixed timestep - accumulate time and consume it in fixed steps
+        StepFixed(delta_clamped);
 	}
 
+    void Timer::StepFixed(const double delta_time_ms)
+    {
+        m_fixed_accumulator_ms  += delta_time_ms;
+        m_fixed_step_count      = 0;
+        while (m_fixed_accumulator_ms >= m_fixed_delta_time_ms && m_fixed_step_count < m_fixed_step_count_max)
+        {
+            m_fixed_accumulator_ms -= m_fixed_delta_time_ms;
+            m_fixed_step_count++;
+        }
+
+        // If the simulation can't keep up, drop the excess time instead of trying to catch up with it
+        if (m_fixed_accumulator_ms >= m_fixed_delta_time_ms)
+        {
+            m_fixed_accumulator_ms = Math::Helper::Min(m_fixed_accumulator_ms, m_fixed_delta_time_ms - 0.001);
+        }
+
+        m_fixed_alpha = static_cast<float>(m_fixed_accumulator_ms / m_fixed_delta_time_ms);
+    }
+
+    void Timer::WaitUntil(const chrono::high_resolution_clock::time_point& time_point) const
+    {
+        const chrono::duration<double, milli> spin_threshold = chrono::duration<double, milli>(m_spin_threshold_ms);
+
+        // Sleep for the bulk of the wait (if there is enough of it)
+        if (time_point - chrono::high_resolution_clock::now() > spin_threshold)
+        {
+            this_thread::sleep_until(time_point - chrono::duration_cast<chrono::high_resolution_clock::duration>(spin_threshold));
+        }
+
+        // Spin for the remainder, this is what makes the pacing precise
+        while (chrono::high_resolution_clock::now() < time_point)
+        {
+            this_thread::yield();
+        }
+    }
+
+    void Timer::SetFixedDeltaTimeMs(double delta_time_ms)
+    {
+        if (delta_time_ms <= 0.0)
+        {
+            LOG_WARNING("%.2f ms is an invalid fixed delta time", delta_time_ms);
+            return;
+        }
+
+        m_fixed_delta_time_ms   = delta_time_ms;
+        m_fixed_accumulator_ms  = 0.0;
+        LOG_INFO("Set to %.2f ms", m_fixed_delta_time_ms);
+    }
+
     void Timer::SetTargetFps(double fps_in)
     {
         if (fps_in < 0.0f) // negative -> match monitor's refresh rate
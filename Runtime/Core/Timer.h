@@ -54,6 +54,9 @@ namespace Spartan
         auto GetFpsPolicy() const   { return m_fps_policy; }
         //==================================================
 
+        // When positive, Tick() doesn't pace or measure the frame and advances by exactly this much instead (replays, captures and tests)
+        void SetFrameTimeOverrideMs(const double frame_time_ms) { m_frame_time_override_ms = frame_time_ms; }
+
         auto GetTimeMs()                const { return m_time_ms; }
         auto GetTimeSec()               const { return static_cast<float>(m_time_ms / 1000.0); }
 		auto GetDeltaTimeMs()           const { return m_delta_time_ms; }
@@ -61,7 +64,18 @@ namespace Spartan
         auto GetDeltaTimeSmoothedMs()   const { return m_delta_time_smoothed_ms; }
         auto GetDeltaTimeSmoothedSec()  const { return static_cast<float>(m_delta_time_smoothed_ms / 1000.0); }
 
+        //= FIXED TIMESTEP ====================================================================================
+        void SetFixedDeltaTimeMs(double delta_time_ms);
+        void StepFixed(double delta_time_ms);                               // Consumes frame time in fixed steps, Tick() feeds it the clamped frame time
+        auto GetFixedDeltaTimeMs()  const { return m_fixed_delta_time_ms; }
+        auto GetFixedDeltaTimeSec() const { return static_cast<float>(m_fixed_delta_time_ms / 1000.0); }
+        auto GetFixedStepCount()    const { return m_fixed_step_count; }    // Simulation steps to run this frame
+        auto GetFixedAlpha()        const { return m_fixed_alpha; }         // Interpolation factor between the last two simulation states
+        //=====================================================================================================
+
 	private:
+        void WaitUntil(const std::chrono::high_resolution_clock::time_point& time_point) const;
+
         // Frame time
         std::chrono::high_resolution_clock::time_point m_time_start;
         std::chrono::high_resolution_clock::time_point m_time_frame_start;
@@ -69,7 +83,17 @@ namespace Spartan
         double m_time_ms                = 0.0f;
 		double m_delta_time_ms          = 0.0f;
         double m_delta_time_smoothed_ms = 0.0f;
-        double m_sleep_overhead         = 0.0f;
+        double m_frame_time_override_ms = 0.0;
+
+        // Pacing - the thread sleeps until this much time is left and then spins, as the kernel's wake up latency is imprecise
+        double m_spin_threshold_ms      = 2.0;
+
+        // Fixed timestep
+        double m_fixed_delta_time_ms    = 1000.0 / 60.0;
+        double m_fixed_accumulator_ms   = 0.0;
+        float m_fixed_alpha             = 1.0f;
+        uint32_t m_fixed_step_count     = 0;
+        uint32_t m_fixed_step_count_max = 8; // prevents a spiral of death when the simulation can't keep up
 
         // FPS
         double m_fps_min                = 25.0;
@@ -185,6 +185,21 @@ namespace Spartan::Math
 			return start.Inverse() * end;
 		}
 
+		// Normalized linear interpolation along the shortest path
+		static inline Quaternion Lerp(const Quaternion& a, const Quaternion& b, float t)
+		{
+            const float dot     = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+            const float sign    = dot < 0.0f ? -1.0f : 1.0f;
+            const float t_inv   = 1.0f - t;
+
+			return Quaternion(
+                a.x * t_inv + b.x * t * sign,
+                a.y * t_inv + b.y * t * sign,
+                a.z * t_inv + b.z * t * sign,
+                a.w * t_inv + b.w * t * sign
+            ).Normalized();
+		}
+
 		auto Conjugate() const	    { return Quaternion(-x, -y, -z, w); }
 		float LengthSquared() const	{ return (x * x) + (y * y) + (z * z) + (w * w); }
 
@@ -22,18 +22,24 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ===================================================================
 #include "Physics.h"
 #include "PhysicsDebugDraw.h"
+#include "PhysicsTaskScheduler.h"
+#include "PhysicsQuery.h"
 #include "BulletPhysicsHelper.h"
 #include "../Core/Engine.h"
 #include "../Core/Context.h"
 #include "../Core/Settings.h"
+#include "../Core/Timer.h"
 #include "../Profiling/Profiler.h"
 #include "../Rendering/Renderer.h"
+#include "../Threading/Threading.h"
+#include "../World/Components/RigidBody.h"
 #pragma warning(push, 0) // Hide warnings belonging to Bullet
 #include <btBulletDynamicsCommon.h>
 #include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
 #include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
-#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.h>
-#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
 #include <BulletSoftBody/btSoftBody.h>
 #include <BulletSoftBody/btSoftRigidDynamicsWorld.h>
 #include <BulletSoftBody/btSoftBodyRigidBodyCollisionConfiguration.h>
@@ -47,59 +53,187 @@ using namespace Spartan::Math;
 
 namespace Spartan
 {
-    static const bool m_soft_body_support = true;
+    // Adapts a callable to Bullet's parallel for, so that it runs on the task scheduler
+    template <typename Function>
+    class ParallelForBody : public btIParallelForBody
+    {
+    public:
+        ParallelForBody(const Function& function) : m_function(function) {}
+        void forLoop(int begin, int end) const override { m_function(begin, end); }
 
-	Physics::Physics(Context* context) : ISubsystem(context)
-	{
-        m_broadphase        = new btDbvtBroadphase();
-        m_constraint_solver = new btSequentialImpulseConstraintSolver();
-
-        if (m_soft_body_support)
-        {
-            // Create
-            m_collision_configuration  = new btSoftBodyRigidBodyCollisionConfiguration();
-            m_collision_dispatcher     = new btCollisionDispatcher(m_collision_configuration);
-            m_world                    = new btSoftRigidDynamicsWorld(m_collision_dispatcher, m_broadphase, m_constraint_solver, m_collision_configuration);
-
-            // Setup         
-            m_world_info = new btSoftBodyWorldInfo();
-            m_world_info->m_sparsesdf.Initialize();
-            m_world->getDispatchInfo().m_enableSPU  = true;
-            m_world_info->m_dispatcher              = m_collision_dispatcher;
-            m_world_info->m_broadphase              = m_broadphase;
-            m_world_info->air_density               = (btScalar)1.2;
-            m_world_info->water_density             = 0;
-            m_world_info->water_offset              = 0;
-            m_world_info->water_normal              = btVector3(0, 0, 0);
-            m_world_info->m_gravity                 = ToBtVector3(m_gravity);
+    private:
+        const Function& m_function;
+    };
 
+    // Only rigid bodies know about their entity
+    static Entity* GetEntity(const btCollisionObject* collision_object)
+    {
+        if (const btRigidBody* body = btRigidBody::upcast(collision_object))
+        {
+            if (const RigidBody* rigid_body = static_cast<RigidBody*>(body->getUserPointer()))
+                return rigid_body->GetEntity();
         }
-        else
+
+        return nullptr;
+    }
+
+    // Collects the unique objects that penetrate the query object
+    class OverlapCallback : public btCollisionWorld::ContactResultCallback
+    {
+    public:
+        OverlapCallback(const btCollisionObject* query_object) { m_query_object = query_object; }
+
+        btScalar addSingleResult(btManifoldPoint& point, const btCollisionObjectWrapper* wrapper_a, int, int, const btCollisionObjectWrapper* wrapper_b, int, int) override
         {
-            // Create
-            m_collision_configuration   = new btDefaultCollisionConfiguration();
-            m_collision_dispatcher      = new btCollisionDispatcher(m_collision_configuration);
-            m_world                     = new btDiscreteDynamicsWorld(m_collision_dispatcher, m_broadphase, m_constraint_solver, m_collision_configuration);
+            if (point.getDistance() > 0.0f || count >= PhysicsQueryBatch::overlap_capacity)
+                return 0;
+
+            const btCollisionObject* object_a   = wrapper_a->getCollisionObject();
+            const btCollisionObject* object     = object_a != m_query_object ? object_a : wrapper_b->getCollisionObject();
+
+            // An object can report multiple contact points
+            for (uint32_t i = 0; i < count; i++)
+            {
+                if (objects[i] == object)
+                    return 0;
+            }
+
+            objects[count++] = object;
+            return 0;
         }
 
-        // Setup
-        m_world->setGravity(ToBtVector3(m_gravity));
-        m_world->getDispatchInfo().m_useContinuous  = true;
-        m_world->getSolverInfo().m_splitImpulse     = false;
-        m_world->getSolverInfo().m_numIterations    = m_max_solve_iterations;
+        const btCollisionObject* objects[PhysicsQueryBatch::overlap_capacity] = {};
+        uint32_t count = 0;
+
+    private:
+        const btCollisionObject* m_query_object = nullptr;
+    };
+
+	Physics::Physics(Context* context) : ISubsystem(context)
+	{
+        // Run Bullet's parallel loops on the engine's thread pool (must be set before creating any of the "Mt" classes)
+        m_task_scheduler = new PhysicsTaskScheduler(context->GetSubsystem<Threading>());
+        btSetTaskScheduler(m_task_scheduler);
+
+        // Shared by both kinds of world (the soft body configuration is a superset of the default one)
+        m_broadphase                = new btDbvtBroadphase();
+        m_collision_configuration   = new btSoftBodyRigidBodyCollisionConfiguration();
+
+        // Soft bodies are created against this
+        m_world_info = new btSoftBodyWorldInfo();
+        m_world_info->m_sparsesdf.Initialize();
+        m_world_info->m_broadphase      = m_broadphase;
+        m_world_info->air_density       = (btScalar)1.2;
+        m_world_info->water_density     = 0;
+        m_world_info->water_offset      = 0;
+        m_world_info->water_normal      = btVector3(0, 0, 0);
+        m_world_info->m_gravity         = ToBtVector3(m_gravity);
+
+        // Until a soft body is added, the world is fully multi-threaded
+        CreateWorld(false);
 	}
 
 	Physics::~Physics()
 	{
         safe_delete(m_world);
         safe_delete(m_constraint_solver);
+        safe_delete(m_constraint_solver_pool);
         safe_delete(m_collision_dispatcher);
         safe_delete(m_collision_configuration);
         safe_delete(m_broadphase);
         safe_delete(m_world_info);
         safe_delete(m_debug_draw);
+
+        // Bullet keeps a global reference to the scheduler, so hand it back its own before deleting ours
+        btSetTaskScheduler(btGetSequentialTaskScheduler());
+        safe_delete(m_task_scheduler);
 	}
 
+    void Physics::CreateWorld(const bool soft_body_support)
+    {
+        // Take everything out of the current world, so that it can be put into the new one
+        vector<pair<btCollisionObject*, pair<int, int>>> objects;
+        vector<pair<btTypedConstraint*, bool>> constraints;
+        if (m_world)
+        {
+            for (int i = m_world->getNumConstraints() - 1; i >= 0; i--)
+            {
+                btTypedConstraint* constraint = m_world->getConstraint(i);
+                const bool disable_collisions = !constraint->getRigidBodyA().checkCollideWithOverride(&constraint->getRigidBodyB());
+                m_world->removeConstraint(constraint);
+                constraints.emplace_back(constraint, disable_collisions);
+            }
+
+            btCollisionObjectArray& world_objects = m_world->getCollisionObjectArray();
+            while (world_objects.size() != 0)
+            {
+                btCollisionObject* object   = world_objects[world_objects.size() - 1];
+                const int group             = object->getBroadphaseHandle()->m_collisionFilterGroup;
+                const int mask              = object->getBroadphaseHandle()->m_collisionFilterMask;
+                m_world->removeCollisionObject(object); // virtual, rigid and soft bodies are taken out of their own lists too
+                objects.emplace_back(object, make_pair(group, mask));
+            }
+        }
+
+        safe_delete(m_world);
+        safe_delete(m_constraint_solver);
+        safe_delete(m_constraint_solver_pool);
+        safe_delete(m_collision_dispatcher);
+
+        if (soft_body_support)
+        {
+            // Create - the soft body world can't dispatch islands in parallel and soft bodies collect their contacts
+            // without locking (so collision detection is serial), but large islands are still solved in parallel (via batching).
+            m_collision_dispatcher  = new btCollisionDispatcher(m_collision_configuration);
+            m_constraint_solver     = new btSequentialImpulseConstraintSolverMt();
+            m_world                 = new btSoftRigidDynamicsWorld(m_collision_dispatcher, m_broadphase, m_constraint_solver, m_collision_configuration);
+            m_world->getDispatchInfo().m_enableSPU = true;
+        }
+        else
+        {
+            // Create - collision detection runs in parallel and islands are solved in parallel by a pool of solvers
+            m_collision_dispatcher      = new btCollisionDispatcherMt(m_collision_configuration);
+            m_constraint_solver_pool    = new btConstraintSolverPoolMt(m_task_scheduler->getMaxNumThreads());
+            m_constraint_solver         = new btSequentialImpulseConstraintSolverMt();
+            m_world                     = new btDiscreteDynamicsWorldMt(m_collision_dispatcher, m_broadphase, m_constraint_solver_pool, m_constraint_solver, m_collision_configuration);
+        }
+        m_soft_body_support         = soft_body_support;
+        m_world_info->m_dispatcher  = m_collision_dispatcher;
+
+        // Setup
+        m_world->setGravity(ToBtVector3(m_gravity));
+        m_world->getDispatchInfo().m_useContinuous  = true;
+        m_world->getSolverInfo().m_splitImpulse     = false;
+        m_world->getSolverInfo().m_numIterations    = m_max_solve_iterations;
+        m_world->setDebugDrawer(m_debug_draw);
+
+        // Put everything back, in the order it was originally added
+        for (auto it = objects.rbegin(); it != objects.rend(); ++it)
+        {
+            btCollisionObject* object   = it->first;
+            const int group             = it->second.first;
+            const int mask              = it->second.second;
+
+            if (btRigidBody* body = btRigidBody::upcast(object))
+            {
+                m_world->addRigidBody(body, group, mask);
+            }
+            else if (btSoftBody* body = btSoftBody::upcast(object))
+            {
+                static_cast<btSoftRigidDynamicsWorld*>(m_world)->addSoftBody(body, group, mask);
+            }
+            else
+            {
+                m_world->addCollisionObject(object, group, mask);
+            }
+        }
+
+        for (auto it = constraints.rbegin(); it != constraints.rend(); ++it)
+        {
+            m_world->addConstraint(it->first, it->second);
+        }
+    }
+
 	bool Physics::Initialize()
 	{
         // Get dependencies
@@ -114,11 +248,7 @@ namespace Spartan
 		// Enabled debug drawing
         {
             m_debug_draw = new PhysicsDebugDraw(m_renderer);
-
-            if (m_world)
-            {
-                m_world->setDebugDrawer(m_debug_draw);
-            }
+            m_world->setDebugDrawer(m_debug_draw);
         }
 
 		return true;
@@ -141,6 +271,19 @@ namespace Spartan
 
         SCOPED_TIME_BLOCK(m_profiler);
 
+        // The engine is feeding fixed steps, so step exactly once with the given delta (a max sub-step count of zero does that)
+        if (m_context->m_engine->EngineMode_IsSet(Engine_Fixed))
+        {
+            m_simulating = true;
+            m_world->stepSimulation(delta_time_sec, 0);
+            m_simulating = false;
+            SyncTransforms();
+            return;
+        }
+
+        // The rest of the simulation group gets the smoothed frame time, Bullet sub-steps the raw one (as it always did)
+        delta_time_sec = m_context->GetSubsystem<Timer>()->GetDeltaTimeSec();
+
 		// This equation must be met: timeStep < maxSubSteps * fixedTimeStep
 		auto internal_time_step	= 1.0f / m_internal_fps;
 		auto max_substeps		= static_cast<int>(delta_time_sec * m_internal_fps) + 1;
@@ -158,8 +301,21 @@ namespace Spartan
 		m_simulating = true;
         m_world->stepSimulation(delta_time_sec, max_substeps, internal_time_step);
 		m_simulating = false;
+        SyncTransforms();
 	}
 
+    void Physics::SyncTransforms()
+    {
+        // Bullet only reports the bodies which are awake, so sleeping bodies cost nothing here
+        for (RigidBody* body : m_transform_sync_queue)
+        {
+            body->SyncTransform();
+        }
+
+        m_profiler->m_physics_bodies_synced += static_cast<uint32_t>(m_transform_sync_queue.size());
+        m_transform_sync_queue.clear();
+    }
+
     void Physics::AddBody(btRigidBody* body) const
     {
         if (!m_world)
@@ -195,24 +351,150 @@ namespace Spartan
         safe_delete(constraint);
     }
 
-    void Physics::AddBody(btSoftBody* body) const
+    void Physics::AddBody(btSoftBody* body)
     {
         if (!m_world)
             return;
 
-        if (btSoftRigidDynamicsWorld* world = static_cast<btSoftRigidDynamicsWorld*>(m_world))
+        // Swapping worlds moves every body, which can't happen mid-step
+        if (m_simulating)
+        {
+            LOG_ERROR("Can't add a soft body while simulating");
+            return;
+        }
+
+        if (!m_soft_body_support)
+        {
+            CreateWorld(true);
+        }
+
+        static_cast<btSoftRigidDynamicsWorld*>(m_world)->addSoftBody(body);
+    }
+
+    void Physics::RemoveBody(btSoftBody*& body)
+    {
+        if (!m_world || !m_soft_body_support)
+            return;
+
+        btSoftRigidDynamicsWorld* world = static_cast<btSoftRigidDynamicsWorld*>(m_world);
+        world->removeSoftBody(body);
+        safe_delete(body);
+
+        // Go back to the multi-threaded world once the last soft body is gone
+        if (world->getSoftBodyArray().size() == 0 && !m_simulating)
         {
-            world->addSoftBody(body);
+            CreateWorld(false);
         }
     }
 
-    void Physics::RemoveBody(btSoftBody*& body) const
+    bool Physics::Query(PhysicsQueryBatch& batch) const
     {
-        if (btSoftRigidDynamicsWorld* world = static_cast<btSoftRigidDynamicsWorld*>(m_world))
+        if (!m_world)
+            return false;
+
+        // The broadphase and the bodies are being modified
+        if (m_simulating)
+        {
+            LOG_WARNING("Can't query while simulating");
+            return false;
+        }
+
+        SCOPED_TIME_BLOCK(m_profiler);
+
+        batch.ResetResults();
+
+        // Rays and sweeps only read the world
+        auto query_cast = [this, &batch](int begin, int end)
+        {
+            for (int i = begin; i < end; i++)
+            {
+                if (batch.m_types[i] == PhysicsQuery_Overlap_Sphere || batch.m_types[i] == PhysicsQuery_Overlap_Box)
+                    continue;
+
+                const btVector3 from    = ToBtVector3(batch.m_from[i]);
+                const btVector3 to      = ToBtVector3(batch.m_to[i]);
+                const btVector3 extents = ToBtVector3(batch.m_extents[i]);
+
+                if (batch.m_types[i] == PhysicsQuery_Ray)
+                {
+                    btCollisionWorld::ClosestRayResultCallback callback(from, to);
+                    m_world->rayTest(from, to, callback);
+
+                    if (callback.hasHit())
+                    {
+                        batch.m_hit[i]          = 1;
+                        batch.m_hit_fraction[i] = callback.m_closestHitFraction;
+                        batch.m_hit_position[i] = ToVector3(callback.m_hitPointWorld);
+                        batch.m_hit_normal[i]   = ToVector3(callback.m_hitNormalWorld);
+                        batch.m_hit_entity[i]   = GetEntity(callback.m_collisionObject);
+                    }
+                }
+                else if (batch.m_types[i] == PhysicsQuery_Sweep_Sphere || batch.m_types[i] == PhysicsQuery_Sweep_Box)
+                {
+                    btSphereShape shape_sphere(extents.x());
+                    btBoxShape shape_box(extents);
+                    const btConvexShape* shape = batch.m_types[i] == PhysicsQuery_Sweep_Sphere ? static_cast<btConvexShape*>(&shape_sphere) : static_cast<btConvexShape*>(&shape_box);
+
+                    btCollisionWorld::ClosestConvexResultCallback callback(from, to);
+                    m_world->convexSweepTest(shape, btTransform(btQuaternion::getIdentity(), from), btTransform(btQuaternion::getIdentity(), to), callback);
+
+                    if (callback.hasHit())
+                    {
+                        batch.m_hit[i]          = 1;
+                        batch.m_hit_fraction[i] = callback.m_closestHitFraction;
+                        batch.m_hit_position[i] = ToVector3(callback.m_hitPointWorld);
+                        batch.m_hit_normal[i]   = ToVector3(callback.m_hitNormalWorld);
+                        batch.m_hit_entity[i]   = GetEntity(callback.m_hitCollisionObject);
+                    }
+                }
+            }
+        };
+
+        // Each query writes only to its own result slots, so chunks can run in parallel (Bullet is built
+        // with BT_THREADSAFE, which gives each thread its own broadphase traversal stack for ray tests)
+        const int grain_size = 16;
+        btParallelFor(0, static_cast<int>(batch.GetQueryCount()), grain_size, ParallelForBody<decltype(query_cast)>(query_cast));
+
+        // Overlaps go through the dispatcher, which creates and releases contact manifolds without
+        // locking, so they always run in the calling thread (after the parallel queries are done)
+        for (uint32_t i = 0; i < batch.GetQueryCount(); i++)
         {
-            world->removeSoftBody(body);
-            safe_delete(body);
+            if (batch.m_types[i] != PhysicsQuery_Overlap_Sphere && batch.m_types[i] != PhysicsQuery_Overlap_Box)
+                continue;
+
+            const btVector3 extents = ToBtVector3(batch.m_extents[i]);
+
+            btSphereShape shape_sphere(extents.x());
+            btBoxShape shape_box(extents);
+
+            btCollisionObject object;
+            object.setCollisionShape(batch.m_types[i] == PhysicsQuery_Overlap_Sphere ? static_cast<btCollisionShape*>(&shape_sphere) : static_cast<btCollisionShape*>(&shape_box));
+            object.setWorldTransform(btTransform(btQuaternion::getIdentity(), ToBtVector3(batch.m_from[i])));
+
+            OverlapCallback callback(&object);
+            m_world->contactTest(&object, callback);
+
+            batch.m_hit[i]              = callback.count != 0 ? 1 : 0;
+            batch.m_hit_position[i]     = batch.m_from[i];
+            batch.m_overlap_count[i]    = callback.count;
+            for (uint32_t j = 0; j < callback.count; j++)
+            {
+                batch.m_overlaps[i * PhysicsQueryBatch::overlap_capacity + j] = GetEntity(callback.objects[j]);
+            }
+            batch.m_hit_entity[i] = batch.m_overlaps[i * PhysicsQueryBatch::overlap_capacity];
         }
+
+        return true;
+    }
+
+    uint32_t Physics::GetThreadCount() const
+    {
+        return static_cast<uint32_t>(m_task_scheduler->getNumThreads());
+    }
+
+    void Physics::SetThreadCount(const uint32_t thread_count) const
+    {
+        m_task_scheduler->setNumThreads(static_cast<int>(thread_count));
     }
 
     Vector3 Physics::GetGravity() const
@@ -22,6 +22,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 //= INCLUDES ==================
+#include <vector>
 #include "../Core/ISubsystem.h"
 #include "../Math/Vector3.h"
 //=============================
@@ -30,6 +31,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 class btBroadphaseInterface;
 class btCollisionDispatcher;
 class btSequentialImpulseConstraintSolver;
+class btConstraintSolverPoolMt;
 class btDefaultCollisionConfiguration;
 class btCollisionObject;
 class btDiscreteDynamicsWorld;
@@ -43,6 +45,9 @@ namespace Spartan
 {
 	class Renderer;
 	class PhysicsDebugDraw;
+	class PhysicsTaskScheduler;
+	class PhysicsQueryBatch;
+	class RigidBody;
 	class Profiler;
 	namespace Math { class Vector3; }	
 
@@ -61,32 +66,49 @@ namespace Spartan
         void AddBody(btRigidBody* body) const;
         void RemoveBody(btRigidBody*& body) const;
 
-        // Soft body
-        void AddBody(btSoftBody* body) const;
-        void RemoveBody(btSoftBody*& body) const;
+        // Soft body (the world switches to one that supports them while there are any)
+        void AddBody(btSoftBody* body);
+        void RemoveBody(btSoftBody*& body);
 
         // Constraint
         void AddConstraint(btTypedConstraint* constraint, bool collision_with_linked_body = true) const;
         void RemoveConstraint(btTypedConstraint*& constraint) const;
 
+        // Bodies which Bullet moved during the step, their transforms are written back in one pass after it
+        void QueueTransformSync(RigidBody* body) { m_transform_sync_queue.emplace_back(body); }
+
+        // Answers all the queries of a batch, in parallel
+        bool Query(PhysicsQueryBatch& batch) const;
+
+        // Threads (the calling thread included) that the simulation can spread over
+        uint32_t GetThreadCount() const;
+        void SetThreadCount(uint32_t thread_count) const;
+
         // Properties
 		Math::Vector3 GetGravity()  const;
         auto& GetSoftWorldInfo()    const { return *m_world_info; }
         auto GetPhysicsDebugDraw()  const { return m_debug_draw; }
 		bool IsSimulating()         const { return m_simulating; }
+        bool SupportsSoftBodies()   const { return m_soft_body_support; }
 
 	private:
+        void CreateWorld(bool soft_body_support);
+        void SyncTransforms();
+
         btBroadphaseInterface* m_broadphase                         = nullptr;
         btCollisionDispatcher* m_collision_dispatcher               = nullptr;
         btSequentialImpulseConstraintSolver* m_constraint_solver    = nullptr;
+        btConstraintSolverPoolMt* m_constraint_solver_pool          = nullptr;
         btDefaultCollisionConfiguration* m_collision_configuration  = nullptr;
         btDiscreteDynamicsWorld* m_world                            = nullptr;
         btSoftBodyWorldInfo* m_world_info                           = nullptr;
         PhysicsDebugDraw* m_debug_draw                              = nullptr;
+        PhysicsTaskScheduler* m_task_scheduler                      = nullptr;
 
         // Misc
         Renderer* m_renderer = nullptr;
         Profiler* m_profiler = nullptr;
+        std::vector<RigidBody*> m_transform_sync_queue;
 
 		//= PROPERTIES =================================================
         int m_max_sub_steps         = 1;
@@ -94,6 +116,7 @@ namespace Spartan
         float m_internal_fps        = 60.0f;
         Math::Vector3 m_gravity     = Math::Vector3(0.0f, -9.81f, 0.0f);
         bool m_simulating           = false;
+        bool m_soft_body_support    = false;
 		//==============================================================
 	};
 }
@@ -0,0 +1,137 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==================
+#include <vector>
+#include "../Core/EngineDefs.h"
+#include "../Math/Vector3.h"
+//=============================
+
+namespace Spartan
+{
+	class Entity;
+
+    enum PhysicsQuery_Type : uint8_t
+    {
+        PhysicsQuery_Ray,
+        PhysicsQuery_Sweep_Sphere,
+        PhysicsQuery_Sweep_Box,
+        PhysicsQuery_Overlap_Sphere,
+        PhysicsQuery_Overlap_Box
+    };
+
+    // A batch of spatial queries which is answered by Physics::Query() in one go.
+    // Queries and results live in flat arrays, indexed by the value that the Add*() functions return.
+	class SPARTAN_CLASS PhysicsQueryBatch
+	{
+	public:
+        static const uint32_t overlap_capacity = 16; // max entities reported per overlap query
+
+        PhysicsQueryBatch() = default;
+        ~PhysicsQueryBatch() = default;
+
+        //= QUERIES ============================================================================================================================================================================
+        uint32_t AddRay(const Math::Vector3& from, const Math::Vector3& to)                                         { return Add(PhysicsQuery_Ray, from, to, Math::Vector3::Zero); }
+        uint32_t AddSweepSphere(const Math::Vector3& from, const Math::Vector3& to, float radius)                   { return Add(PhysicsQuery_Sweep_Sphere, from, to, Math::Vector3(radius, radius, radius)); }
+        uint32_t AddSweepBox(const Math::Vector3& from, const Math::Vector3& to, const Math::Vector3& half_extents) { return Add(PhysicsQuery_Sweep_Box, from, to, half_extents); }
+        uint32_t AddOverlapSphere(const Math::Vector3& center, float radius)                                       { return Add(PhysicsQuery_Overlap_Sphere, center, center, Math::Vector3(radius, radius, radius)); }
+        uint32_t AddOverlapBox(const Math::Vector3& center, const Math::Vector3& half_extents)                     { return Add(PhysicsQuery_Overlap_Box, center, center, half_extents); }
+        uint32_t GetQueryCount() const                                                                              { return static_cast<uint32_t>(m_types.size()); }
+        void Clear()
+        {
+            m_types.clear();
+            m_from.clear();
+            m_to.clear();
+            m_extents.clear();
+
+            // Results of the previous queries must not be returned for the next ones
+            m_hit.clear();
+            m_hit_fraction.clear();
+            m_hit_position.clear();
+            m_hit_normal.clear();
+            m_hit_entity.clear();
+            m_overlap_count.clear();
+            m_overlaps.clear();
+        }
+        //======================================================================================================================================================================================
+
+        //= RESULTS (valid after Physics::Query(), an invalid index returns a miss) ===================================================================================================================
+        bool IsHit(const uint32_t index)                                        const { return IsValid(index) ? m_hit[index] != 0 : false; }
+        float GetHitFraction(const uint32_t index)                              const { return IsValid(index) ? m_hit_fraction[index] : 1.0f; } // along from -> to
+        const Math::Vector3& GetHitPosition(const uint32_t index)               const { return IsValid(index) ? m_hit_position[index] : Math::Vector3::Zero; }
+        const Math::Vector3& GetHitNormal(const uint32_t index)                 const { return IsValid(index) ? m_hit_normal[index] : Math::Vector3::Zero; }
+        Entity* GetHitEntity(const uint32_t index)                              const { return IsValid(index) ? m_hit_entity[index] : nullptr; } // closest hit or first overlap
+        uint32_t GetOverlapCount(const uint32_t index)                          const { return IsValid(index) ? m_overlap_count[index] : 0; }
+        Entity* GetOverlap(const uint32_t index, const uint32_t overlap_index)  const { return overlap_index < GetOverlapCount(index) ? m_overlaps[index * overlap_capacity + overlap_index] : nullptr; }
+
+        // Direct access to the flat arrays
+        const auto& GetHitFractions()   const { return m_hit_fraction; }
+        const auto& GetHitPositions()   const { return m_hit_position; }
+        const auto& GetHitNormals()     const { return m_hit_normal; }
+        const auto& GetHitEntities()    const { return m_hit_entity; }
+        //============================================================================================================================================================================================
+
+	private:
+        friend class Physics;
+
+        // Scripts pass indices straight through, so results are only read for queries which were answered
+        bool IsValid(const uint32_t index) const { return index < m_hit.size(); }
+
+        uint32_t Add(const PhysicsQuery_Type type, const Math::Vector3& from, const Math::Vector3& to, const Math::Vector3& extents)
+        {
+            m_types.emplace_back(type);
+            m_from.emplace_back(from);
+            m_to.emplace_back(to);
+            m_extents.emplace_back(extents);
+            return static_cast<uint32_t>(m_types.size() - 1);
+        }
+
+        // Sizes and resets the results so that each query can write its own slots without synchronization
+        void ResetResults()
+        {
+            const size_t count = m_types.size();
+            m_hit.assign(count, 0);
+            m_hit_fraction.assign(count, 1.0f);
+            m_hit_position.assign(count, Math::Vector3::Zero);
+            m_hit_normal.assign(count, Math::Vector3::Zero);
+            m_hit_entity.assign(count, nullptr);
+            m_overlap_count.assign(count, 0);
+            m_overlaps.assign(count * overlap_capacity, nullptr);
+        }
+
+        // Queries
+        std::vector<PhysicsQuery_Type> m_types;
+        std::vector<Math::Vector3> m_from;
+        std::vector<Math::Vector3> m_to;
+        std::vector<Math::Vector3> m_extents; // radius for spheres, half extents for boxes
+
+        // Results
+        std::vector<uint8_t> m_hit;
+        std::vector<float> m_hit_fraction;
+        std::vector<Math::Vector3> m_hit_position;
+        std::vector<Math::Vector3> m_hit_normal;
+        std::vector<Entity*> m_hit_entity;
+        std::vector<uint32_t> m_overlap_count;
+        std::vector<Entity*> m_overlaps;
+	};
+}
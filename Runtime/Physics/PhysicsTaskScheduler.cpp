@@ -0,0 +1,114 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ========================
+#include "PhysicsTaskScheduler.h"
+#include "../Threading/Threading.h"
+#include "../Math/MathHelper.h"
+//===================================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Spartan::Math;
+//=============================
+
+namespace Spartan
+{
+    // Set while a thread executes a chunk, nested loops then run in place instead of waiting on the (busy) pool
+    static thread_local bool is_executing_chunk = false;
+
+	PhysicsTaskScheduler::PhysicsTaskScheduler(Threading* threading) : btITaskScheduler("Spartan")
+	{
+		m_threading     = threading;
+        m_thread_count  = getMaxNumThreads();
+	}
+
+    int PhysicsTaskScheduler::getMaxNumThreads() const
+    {
+        // Worker threads plus the calling thread, which always executes a chunk of the work
+        const int thread_count = m_threading ? static_cast<int>(m_threading->GetThreadCount()) + 1 : 1;
+        return Helper::Min(thread_count, static_cast<int>(BT_MAX_THREAD_COUNT));
+    }
+
+    void PhysicsTaskScheduler::setNumThreads(int thread_count)
+    {
+        m_thread_count = Helper::Clamp(thread_count, 1, getMaxNumThreads());
+    }
+
+    int PhysicsTaskScheduler::GetChunkCount(int begin, int end, int grain_size) const
+    {
+        const int range = end - begin;
+        return Helper::Min(m_thread_count, (range + grain_size - 1) / Helper::Max(grain_size, 1));
+    }
+
+    void PhysicsTaskScheduler::parallelFor(int begin, int end, int grain_size, const btIParallelForBody& body)
+    {
+        if (end <= begin)
+            return;
+
+        // Run in place if there is not enough work to split or if this is a nested loop
+        const int chunk_count = GetChunkCount(begin, end, grain_size);
+        if (chunk_count <= 1 || is_executing_chunk)
+        {
+            body.forLoop(begin, end);
+            return;
+        }
+
+        // The calling thread works on chunks too, so a busy pool can't stall the step
+        m_threading->AddTaskLoop([&body, begin](const uint32_t chunk_start, const uint32_t chunk_end)
+        {
+            is_executing_chunk = true;
+            body.forLoop(begin + static_cast<int>(chunk_start), begin + static_cast<int>(chunk_end));
+            is_executing_chunk = false;
+        }, end - begin, chunk_count);
+    }
+
+    btScalar PhysicsTaskScheduler::parallelSum(int begin, int end, int grain_size, const btIParallelSumBody& body)
+    {
+        if (end <= begin)
+            return btScalar(0);
+
+        // Run in place if there is not enough work to split or if this is a nested loop
+        const int chunk_count = GetChunkCount(begin, end, grain_size);
+        if (chunk_count <= 1 || is_executing_chunk)
+            return body.sumLoop(begin, end);
+
+        // One partial sum per chunk, summed in order so that the result is deterministic
+        const int range         = end - begin;
+        const int chunk_size    = (range + chunk_count - 1) / chunk_count; // how Threading::AddTaskLoop() splits the range
+        vector<btScalar> sums(chunk_count, btScalar(0));
+
+        m_threading->AddTaskLoop([&body, &sums, begin, chunk_size](const uint32_t chunk_start, const uint32_t chunk_end)
+        {
+            is_executing_chunk = true;
+            sums[chunk_start / chunk_size] = body.sumLoop(begin + static_cast<int>(chunk_start), begin + static_cast<int>(chunk_end));
+            is_executing_chunk = false;
+        }, range, chunk_count);
+
+        btScalar sum = btScalar(0);
+        for (const btScalar partial_sum : sums)
+        {
+            sum += partial_sum;
+        }
+
+        return sum;
+    }
+}
@@ -265,8 +265,21 @@ namespace Spartan
             "Meshes rendered:\t\t\t\t%d\n"
             "Textures:\t\t\t\t\t\t%d\n"
             "Materials:\t\t\t\t\t\t%d\n"
+            "Transient render targets:\t\t%.1f/%.1f/%.1f MB (peak/pool/up front)\n"
+            "Clustered lights:\t\t\t\t%d (%d cluster assignments)\n"
+            "Shadow atlas:\t\t\t\t\t%d lights, %d without shadows, %.0f%% occupied\n"
+            // Physics
+            "Physics bodies synced:\t\t\t%d\n"
+            "Physics bodies pushed:\t\t\t%d\n"
+            // Audio
+            "Audio emitters:\t\t\t\t\t%d (%d real, %d culled, %d pushed)\n"
+            // Scripting
+            "Script updates:\t\t\t\t\t%d (%d in parallel, %d commands, %.2f ms)\n"
+            "Script bytecode cache:\t\t\t%d hits, %d misses\n"
             // RHI
             "RHI Draw calls:\t\t\t\t\t%d\n"
+            "RHI Instanced draw calls:\t\t%d\n"
+            "RHI Draw calls saved:\t\t\t%d\n"
             "RHI Index buffer bindings:\t\t%d\n"
             "RHI Vertex buffer bindings:\t\t%d\n"
             "RHI Constant buffer bindings:\t%d\n"
@@ -277,9 +290,16 @@ namespace Spartan
             "RHI Compute Shader bindings:\t%d\n"
             "RHI Render Target bindings:\t\t%d\n"
             "RHI Pipeline bindings:\t\t\t%d\n"
-            "RHI Descriptor Set bindings:\t\t%d";
-
-		static char buffer[1024]; // real usage is around 800
+            "RHI Descriptor Set bindings:\t\t%d\n"
+            "RHI Pipeline cache hits:\t\t%d\n"
+            "RHI Pipeline cache misses:\t\t%d\n"
+            "RHI Pipeline creation:\t\t\t%.2f ms\n"
+            "RHI Pipelines prewarming:\t\t%d\n"
+            "RHI Shader cache hits:\t\t\t%d\n"
+            "RHI Shader cache misses:\t\t%d\n"
+            "RHI Shader cache time saved:\t%.2f ms";
+
+		static char buffer[1600]; // real usage is around 1520
 		sprintf_s
 		(
 			buffer, text,
@@ -298,9 +318,25 @@ namespace Spartan
 			m_renderer_meshes_rendered,
 			texture_count,
 			material_count,
+			m_renderer_transient_peak_mb, m_renderer_transient_pool_mb, m_renderer_transient_declared_mb,
+			m_renderer_light_grid_lights, m_renderer_light_grid_assignments,
+			m_renderer_shadow_atlas_lights, m_renderer_shadow_atlas_fallbacks, m_renderer_shadow_atlas_occupancy,
+
+			// Physics
+			m_physics_bodies_synced,
+			m_physics_bodies_pushed,
+
+			// Audio
+			m_audio_emitters, m_audio_emitters_real, m_audio_emitters_culled, m_audio_attributes_pushed,
+
+			// Scripting
+			m_scripting_updates, m_scripting_updates_parallel, m_scripting_commands, m_scripting_update_ms,
+			m_scripting_cache_hits, m_scripting_cache_misses,
 
 			// RHI
 			m_rhi_draw_calls,
+            m_rhi_draw_calls_instanced,
+            m_rhi_instances - m_rhi_draw_calls_instanced,
 			m_rhi_bindings_buffer_index,
 			m_rhi_bindings_buffer_vertex,
 			m_rhi_bindings_buffer_constant,
@@ -311,7 +347,14 @@ namespace Spartan
             m_rhi_bindings_shader_compute,
 			m_rhi_bindings_render_target,
             m_rhi_bindings_pipeline,
-            m_rhi_bindings_descriptor_set
+            m_rhi_bindings_descriptor_set,
+            m_rhi_pipeline_cache_hits,
+            m_rhi_pipeline_cache_misses,
+            m_rhi_pipeline_creation_ms,
+            m_rhi_pipeline_cache_prewarming,
+            m_rhi_shader_cache_hits,
+            m_rhi_shader_cache_misses,
+            m_rhi_shader_cache_saved_ms
 		);
 
 		m_metrics = string(buffer);
@@ -76,6 +76,8 @@ namespace Spartan
 		
 		// Metrics - RHI
 		uint32_t m_rhi_draw_calls				= 0;
+        uint32_t m_rhi_draw_calls_instanced     = 0;
+        uint32_t m_rhi_instances                = 0; // drawn by instanced draw calls
 		uint32_t m_rhi_bindings_buffer_index	= 0;
 		uint32_t m_rhi_bindings_buffer_vertex	= 0;
 		uint32_t m_rhi_bindings_buffer_constant = 0;
@@ -87,9 +89,42 @@ namespace Spartan
 		uint32_t m_rhi_bindings_render_target	= 0;
         uint32_t m_rhi_bindings_descriptor_set  = 0;
         uint32_t m_rhi_bindings_pipeline        = 0;
+        uint32_t m_rhi_pipeline_cache_hits          = 0;
+        uint32_t m_rhi_pipeline_cache_misses        = 0;
+        uint32_t m_rhi_pipeline_cache_prewarming    = 0; // pipelines from previous runs which are waiting to be created
+        float m_rhi_pipeline_creation_ms            = 0.0f;
+        uint32_t m_rhi_shader_cache_hits            = 0; // accumulated since startup
+        uint32_t m_rhi_shader_cache_misses          = 0; // accumulated since startup
+        float m_rhi_shader_cache_saved_ms           = 0.0f; // compilation time avoided by cache hits, minus the time it took to load them
 
 		// Metrics - Renderer
 		uint32_t m_renderer_meshes_rendered = 0;
+        float m_renderer_transient_peak_mb      = 0.0f; // the most memory the transient render targets of a frame have alive at once
+        float m_renderer_transient_pool_mb      = 0.0f; // allocated by the render graph pool
+        float m_renderer_transient_declared_mb  = 0.0f; // if every transient render target was allocated up front
+        uint32_t m_renderer_light_grid_lights       = 0; // unshadowed point and spot lights shaded by the clustered pass
+        uint32_t m_renderer_light_grid_assignments  = 0; // light to cluster assignments
+        uint32_t m_renderer_shadow_atlas_lights     = 0; // point and spot lights which asked for shadow atlas tiles
+        uint32_t m_renderer_shadow_atlas_fallbacks  = 0; // of those, the ones which didn't fit and are shaded without shadows
+        float m_renderer_shadow_atlas_occupancy     = 0.0f; // percentage of the atlas in use
+
+		// Metrics - Physics
+		uint32_t m_physics_bodies_synced = 0; // Bullet -> Engine
+		uint32_t m_physics_bodies_pushed = 0; // Engine -> Bullet
+
+        // Metrics - Audio
+        uint32_t m_audio_emitters           = 0; // playing 3D sounds
+        uint32_t m_audio_emitters_real      = 0; // of which, have a voice
+        uint32_t m_audio_emitters_culled    = 0; // of which, are out of range
+        uint32_t m_audio_attributes_pushed  = 0; // 3D attribute updates sent to FMOD by the last tick
+
+        // Metrics - Scripting
+        uint32_t m_scripting_updates        = 0; // script instances updated by the last world tick
+        uint32_t m_scripting_updates_parallel = 0; // of which, updated on the job system
+        uint32_t m_scripting_commands       = 0; // deferred writes to other entities, applied after the updates
+        float m_scripting_update_ms         = 0.0f;
+        uint32_t m_scripting_cache_hits     = 0; // scripts loaded from bytecode, accumulated since startup
+        uint32_t m_scripting_cache_misses   = 0; // scripts compiled from source, accumulated since startup
 
 		// Metrics - Time
 		float m_time_frame_ms	= 0.0f;
@@ -100,7 +135,11 @@ namespace Spartan
         void ClearRhiMetrics()
         {
             m_rhi_draw_calls                = 0;
+            m_rhi_draw_calls_instanced      = 0;
+            m_rhi_instances                 = 0;
             m_renderer_meshes_rendered      = 0;
+            m_physics_bodies_synced         = 0;
+            m_physics_bodies_pushed         = 0;
             m_rhi_bindings_buffer_index     = 0;
             m_rhi_bindings_buffer_vertex    = 0;
             m_rhi_bindings_buffer_constant  = 0;
@@ -112,6 +151,9 @@ namespace Spartan
             m_rhi_bindings_render_target    = 0;
             m_rhi_bindings_descriptor_set   = 0;
             m_rhi_bindings_pipeline         = 0;
+            m_rhi_pipeline_cache_hits       = 0;
+            m_rhi_pipeline_cache_misses     = 0;
+            m_rhi_pipeline_creation_ms      = 0.0f;
         }
 
 		TimeBlock* GetNewTimeBlock();
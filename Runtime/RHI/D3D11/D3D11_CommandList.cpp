@@ -54,7 +54,7 @@ using namespace Spartan::Math;
 
 namespace Spartan
 {
-	RHI_CommandList::RHI_CommandList(uint32_t index, RHI_SwapChain* swap_chain, Context* context)
+	RHI_CommandList::RHI_CommandList(uint32_t index, RHI_SwapChain* swap_chain, Context* context, const bool is_secondary /*= false*/)
 	{
         m_swap_chain        = swap_chain;
         m_renderer          = context->GetSubsystem<Renderer>();
@@ -64,6 +64,7 @@ namespace Spartan
         m_descriptor_cache  = m_renderer->GetDescriptorCache();
         m_passes_active.reserve(100);
         m_passes_active.resize(100);
+        m_is_secondary      = is_secondary;
 	}
 
 	RHI_CommandList::~RHI_CommandList() = default;
@@ -317,6 +318,19 @@ namespace Spartan
         return true;
 	}
 
+    bool RHI_CommandList::BeginSecondary(RHI_CommandList* primary)
+    {
+        // Everything is recorded straight into the immediate context, see RHI_Context::parallel_recording
+        LOG_ERROR("Not supported");
+        return false;
+    }
+
+    bool RHI_CommandList::ExecuteSecondary(RHI_CommandList* const* cmd_lists, const uint32_t count)
+    {
+        LOG_ERROR("Not supported");
+        return false;
+    }
+
 	bool RHI_CommandList::End()
 	{
         // End marker and profiler (if enabled)
@@ -387,6 +401,22 @@ namespace Spartan
         m_profiler->m_rhi_draw_calls++;
 	}
 
+    void RHI_CommandList::DrawIndexedInstanced(const uint32_t index_count, const uint32_t instance_count, const uint32_t index_offset, const uint32_t vertex_offset)
+    {
+        m_rhi_device->GetContextRhi()->device_context->DrawIndexedInstanced
+        (
+            static_cast<UINT>(index_count),
+            static_cast<UINT>(instance_count),
+            static_cast<UINT>(index_offset),
+            static_cast<INT>(vertex_offset),
+            0
+        );
+
+        m_profiler->m_rhi_draw_calls++;
+        m_profiler->m_rhi_draw_calls_instanced++;
+        m_profiler->m_rhi_instances += instance_count;
+    }
+
     void RHI_CommandList::Dispatch(uint32_t x, uint32_t y, uint32_t z /*= 1*/) const
     {
         ID3D11DeviceContext* device_context = m_rhi_device->GetContextRhi()->device_context;
@@ -524,6 +554,12 @@ namespace Spartan
         m_profiler->m_rhi_bindings_buffer_constant += scope & RHI_Shader_Compute  ? 1 : 0;
     }
 
+    void RHI_CommandList::SetConstantBufferDynamic(const uint32_t slot, const uint8_t scope, RHI_ConstantBuffer* constant_buffer, const uint32_t offset_index_dynamic) const
+    {
+        // No dynamic offsets, the buffer holds a single element which is updated before the draw
+        SetConstantBuffer(slot, scope, constant_buffer);
+    }
+
     void RHI_CommandList::SetSampler(const uint32_t slot, RHI_Sampler* sampler) const
     {
         const UINT start_slot               = slot;
@@ -806,5 +842,10 @@ namespace Spartan
     {
         return true;
     }
+
+    void RHI_CommandList::AddCounters()
+    {
+        // Draws and bindings go straight to the profiler, there are no secondaries to collect them from
+    }
 }
 #endif
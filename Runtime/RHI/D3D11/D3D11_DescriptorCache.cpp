@@ -41,6 +41,17 @@ namespace Spartan
     {
         return true;
     }
+
+    bool RHI_DescriptorCache::CreateBindless()
+    {
+        // Shader model 5.0 has no unbounded texture arrays
+        return false;
+    }
+
+    void RHI_DescriptorCache::UpdateBindless(uint32_t index, RHI_Texture* texture)
+    {
+
+    }
 }
 
 #endif
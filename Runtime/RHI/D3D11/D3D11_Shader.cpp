@@ -45,19 +45,18 @@ namespace Spartan
 		safe_release(*reinterpret_cast<ID3D11VertexShader**>(&m_resource));
 	}
 
-	void* RHI_Shader::_Compile(const string& shader)
+    string RHI_Shader::GetCompilerVersion()
+    {
+        // The version of the d3dcompiler_xx.dll that the engine links against
+        return "d3dcompiler_" + to_string(D3D_COMPILER_VERSION);
+    }
+
+	bool RHI_Shader::_Compile(const string& shader, vector<std::byte>& bytecode)
 	{
 		if (!m_rhi_device)
 		{
 			LOG_ERROR_INVALID_INTERNALS();
-			return nullptr;
-		}
-
-		auto d3d11_device = m_rhi_device->GetContextRhi()->device;
-		if (!d3d11_device)
-		{
-			LOG_ERROR_INVALID_INTERNALS();
-			return nullptr;
+			return false;
 		}
 
 		// Compile flags
@@ -121,7 +120,7 @@ namespace Spartan
         else
         {
             LOG_ERROR("\"%s\" is not file or a source", shader.c_str());
-            return nullptr;
+            return false;
         }
 
 		// Log any compilation possible warnings and/or errors
@@ -159,40 +158,67 @@ namespace Spartan
 			}
 		}
 
-		// Create shader
+		if (!shader_blob)
+			return false;
+
+		const std::byte* data = static_cast<const std::byte*>(shader_blob->GetBufferPointer());
+		bytecode.assign(data, data + shader_blob->GetBufferSize());
+		safe_release(shader_blob);
+
+		return true;
+	}
+
+	void* RHI_Shader::_CreateResource(const vector<std::byte>& bytecode)
+	{
+		auto d3d11_device = m_rhi_device->GetContextRhi()->device;
+		if (!d3d11_device || bytecode.empty())
+		{
+			LOG_ERROR_INVALID_INTERNALS();
+			return nullptr;
+		}
+
 		void* shader_view = nullptr;
-		if (shader_blob)
+		HRESULT result;
+		if (m_shader_type == RHI_Shader_Vertex)
 		{
-			if (m_shader_type == RHI_Shader_Vertex)
+			result = d3d11_device->CreateVertexShader(bytecode.data(), bytecode.size(), nullptr, reinterpret_cast<ID3D11VertexShader**>(&shader_view));
+			if (FAILED(result))
 			{
-				if (FAILED(d3d11_device->CreateVertexShader(shader_blob->GetBufferPointer(), shader_blob->GetBufferSize(), nullptr, reinterpret_cast<ID3D11VertexShader**>(&shader_view))))
-				{
-                    LOG_ERROR("Failed to create vertex shader, %s", d3d11_common::dxgi_error_to_string(result));
-				}
+				LOG_ERROR("Failed to create vertex shader, %s", d3d11_common::dxgi_error_to_string(result));
+				return nullptr;
+			}
 
-				// Create input layout
-                if (!m_input_layout->Create(m_vertex_type, shader_blob))
-                {
-                    LOG_ERROR("Failed to create input layout for %s", FileSystem::GetFileNameFromFilePath(m_file_path).c_str());
-                }
+			// Create input layout (it wants the bytecode as a blob, cached bytecode doesn't come as one)
+			ID3DBlob* shader_blob = nullptr;
+			if (SUCCEEDED(D3DCreateBlob(bytecode.size(), &shader_blob)))
+			{
+				memcpy(shader_blob->GetBufferPointer(), bytecode.data(), bytecode.size());
 			}
-			else if (m_shader_type == RHI_Shader_Pixel)
+
+			if (!m_input_layout->Create(m_vertex_type, shader_blob))
 			{
-				if (FAILED(d3d11_device->CreatePixelShader(shader_blob->GetBufferPointer(), shader_blob->GetBufferSize(), nullptr, reinterpret_cast<ID3D11PixelShader**>(&shader_view))))
-				{
-					LOG_ERROR("Failed to create pixel shader, %s", d3d11_common::dxgi_error_to_string(result));
-				}
+				LOG_ERROR("Failed to create input layout for %s", FileSystem::GetFileNameFromFilePath(m_file_path).c_str());
+			}
+
+			safe_release(shader_blob);
+		}
+		else if (m_shader_type == RHI_Shader_Pixel)
+		{
+			result = d3d11_device->CreatePixelShader(bytecode.data(), bytecode.size(), nullptr, reinterpret_cast<ID3D11PixelShader**>(&shader_view));
+			if (FAILED(result))
+			{
+				LOG_ERROR("Failed to create pixel shader, %s", d3d11_common::dxgi_error_to_string(result));
+			}
+		}
+		else if (m_shader_type == RHI_Shader_Compute)
+		{
+			result = d3d11_device->CreateComputeShader(bytecode.data(), bytecode.size(), nullptr, reinterpret_cast<ID3D11ComputeShader**>(&shader_view));
+			if (FAILED(result))
+			{
+				LOG_ERROR("Failed to create compute shader, %s", d3d11_common::dxgi_error_to_string(result));
 			}
-            else if (m_shader_type == RHI_Shader_Compute)
-            {
-                if (FAILED(d3d11_device->CreateComputeShader(shader_blob->GetBufferPointer(), shader_blob->GetBufferSize(), nullptr, reinterpret_cast<ID3D11ComputeShader**>(&shader_view))))
-                {
-                    LOG_ERROR("Failed to create compute shader, %s", d3d11_common::dxgi_error_to_string(result));
-                }
-            }
 		}
 
-		safe_release(shader_blob);
 		return shader_view;
 	}
 }
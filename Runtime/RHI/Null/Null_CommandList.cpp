@@ -0,0 +1,716 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION ===============
+#include "../RHI_Implementation.h"
+#ifdef API_GRAPHICS_NULL
+//================================
+
+//= INCLUDES ========================
+#include "../RHI_CommandList.h"
+#include "../RHI_Pipeline.h"
+#include "../RHI_Device.h"
+#include "../RHI_SwapChain.h"
+#include "../RHI_Sampler.h"
+#include "../RHI_Texture.h"
+#include "../RHI_VertexBuffer.h"
+#include "../RHI_IndexBuffer.h"
+#include "../RHI_PipelineState.h"
+#include "../RHI_ConstantBuffer.h"
+#include "../RHI_DescriptorCache.h"
+#include "../RHI_PipelineCache.h"
+#include "../../Profiling/Profiler.h"
+#include "../../Logging/Log.h"
+#include "../../Rendering/Renderer.h"
+//===================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+#define CMD_BUFFER static_cast<null_common::command_buffer*>(m_cmd_buffer)
+
+namespace Spartan
+{
+    RHI_CommandList::RHI_CommandList(uint32_t index, RHI_SwapChain* swap_chain, Context* context, const bool is_secondary /*= false*/)
+	{
+        m_swap_chain        = swap_chain;
+        m_renderer          = context->GetSubsystem<Renderer>();
+        m_profiler          = context->GetSubsystem<Profiler>();
+		m_rhi_device	    = m_renderer->GetRhiDevice().get();
+        m_pipeline_cache    = m_renderer->GetPipelineCache();
+        m_descriptor_cache  = m_renderer->GetDescriptorCache();
+        m_passes_active.reserve(100);
+        m_passes_active.resize(100);
+        m_timestamps.reserve(2);
+        m_timestamps.resize(2);
+        m_is_secondary      = is_secondary;
+
+        // Secondaries are recorded concurrently, so they can't share the renderer's descriptor cache
+        if (m_is_secondary)
+        {
+            m_descriptor_cache_secondary    = make_shared<RHI_DescriptorCache>(m_rhi_device, false);
+            m_descriptor_cache              = m_descriptor_cache_secondary.get();
+        }
+
+        // Command buffer
+        m_cmd_buffer = static_cast<void*>(new null_common::command_buffer());
+	}
+
+	RHI_CommandList::~RHI_CommandList()
+	{
+        delete CMD_BUFFER;
+        m_cmd_buffer = nullptr;
+	}
+
+    bool RHI_CommandList::Begin(RHI_PipelineState& pipeline_state)
+	{
+        // Sync CPU to GPU
+        if (m_cmd_state == RHI_Cmd_List_Idle_Sync_Cpu_To_Gpu)
+        {
+            Flush();
+            m_descriptor_cache->GrowIfNeeded();
+            m_cmd_state = RHI_Cmd_List_Idle;
+        }
+
+        if (m_cmd_state != RHI_Cmd_List_Idle)
+        {
+            LOG_ERROR("Previous command list is still being used");
+            return false;
+        }
+
+		// Begin command buffer (the previous recording is kept until now, so that it can be inspected)
+        CMD_BUFFER->reset();
+        CMD_BUFFER->record(null_common::command_begin, &pipeline_state);
+
+        // At this point, it's safe to allow for command recording
+        m_cmd_state = RHI_Cmd_List_Recording;
+
+        // Get pipeline
+        {
+            m_pipeline_active = false;
+
+            // Update the descriptor cache with the pipeline state and potentially create a new pipeline (if not already there)
+            m_descriptor_cache->SetPipelineState(pipeline_state);
+
+            // Get a pipeline which matches the pipeline state
+            m_pipeline = m_pipeline_cache->GetPipeline(this, pipeline_state, m_descriptor_cache->GetResource_DescriptorSetLayout());
+            if (!m_pipeline)
+            {
+                LOG_ERROR("Failed to acquire appropriate pipeline");
+                End();
+                return false;
+            }
+
+            // Acquire next image (in case the render target is a swapchain)
+            if (!m_pipeline->GetPipelineState()->AcquireNextImage())
+            {
+                LOG_ERROR("Failed to acquire next image");
+                End();
+                return false;
+            }
+
+            // Keep a local pointer for convenience
+            m_pipeline_state = &pipeline_state;
+        }
+
+        // Start marker and profiler (if used)
+        MarkAndProfileStart(m_pipeline_state);
+
+        // Shader resources
+        {
+            // If the pipeline changed, we are using new descriptors, so the resources have to be set again
+            m_set_id_buffer_vertex  = 0;
+            m_set_id_buffer_pixel   = 0;
+
+            // Like Vulkan, there is no persistent state so global resources have to be set
+            m_renderer->SetGlobalSamplersAndConstantBuffers(this);
+        }
+
+        return true;
+	}
+
+    bool RHI_CommandList::BeginSecondary(RHI_CommandList* primary)
+    {
+        if (!m_is_secondary || !primary || primary->m_is_secondary)
+        {
+            LOG_ERROR_INVALID_PARAMETER();
+            return false;
+        }
+
+        if (primary->m_cmd_state != RHI_Cmd_List_Recording)
+        {
+            LOG_ERROR("The primary command list has to be recording");
+            return false;
+        }
+
+        // The primary's Begin() waited for its previous submission, which is the last one to have executed this list.
+        // A list which ended but was never executed (its pass was abandoned) was never submitted, so it can be recorded again as well.
+        if (m_cmd_state == RHI_Cmd_List_Idle_Sync_Cpu_To_Gpu || m_cmd_state == RHI_Cmd_List_Ended)
+        {
+            m_descriptor_cache->GrowIfNeeded();
+            m_cmd_state = RHI_Cmd_List_Idle;
+        }
+
+        if (m_cmd_state != RHI_Cmd_List_Idle)
+        {
+            LOG_ERROR("Previous command list is still being used");
+            return false;
+        }
+
+        // Begin command buffer
+        CMD_BUFFER->reset();
+        CMD_BUFFER->record(null_common::command_begin, primary->m_pipeline_state);
+
+        m_cmd_state = RHI_Cmd_List_Recording;
+
+        // Continue the primary's pass, with the same pipeline. The descriptor set layout is this list's own, but it's created
+        // from the same shaders, so it's identical to the one the pipeline was created with.
+        m_pipeline_state        = primary->m_pipeline_state;
+        m_pipeline              = primary->m_pipeline;
+        m_pipeline_active       = false;
+        m_render_pass_active    = false;
+        m_counters              = Counters();
+        m_descriptor_cache->SetPipelineState(*m_pipeline_state);
+
+        // Nothing is inherited from the primary, so the global resources have to be set again
+        m_set_id_buffer_vertex  = 0;
+        m_set_id_buffer_pixel   = 0;
+        m_renderer->SetGlobalSamplersAndConstantBuffers(this);
+
+        return true;
+    }
+
+    bool RHI_CommandList::ExecuteSecondary(RHI_CommandList* const* cmd_lists, const uint32_t count)
+    {
+        if (m_cmd_state != RHI_Cmd_List_Recording)
+        {
+            LOG_WARNING("Can't record command");
+            return false;
+        }
+
+        // A render pass either records its draws inline or executes secondaries, not both
+        if (m_is_secondary || m_render_pass_active)
+        {
+            LOG_ERROR("Secondary command lists can only be executed by a primary which hasn't started drawing");
+            return false;
+        }
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (!cmd_lists[i] || !cmd_lists[i]->m_is_secondary || cmd_lists[i]->m_cmd_state != RHI_Cmd_List_Ended)
+            {
+                LOG_ERROR_INVALID_PARAMETER();
+                return false;
+            }
+        }
+
+        BeginRenderPass(true);
+        m_render_pass_active = true;
+
+        // Append in the given order, without the secondaries' begin and end
+        for (uint32_t i = 0; i < count; i++)
+        {
+            RHI_CommandList* cmd_list                       = cmd_lists[i];
+            const vector<null_common::command>& commands    = static_cast<null_common::command_buffer*>(cmd_list->m_cmd_buffer)->commands;
+
+            CMD_BUFFER->record(null_common::command_execute_secondary, cmd_list->m_cmd_buffer, static_cast<uint32_t>(commands.size() - 2));
+            CMD_BUFFER->commands.insert(CMD_BUFFER->commands.end(), commands.begin() + 1, commands.end() - 1);
+
+            m_counters.draw_calls               += cmd_list->m_counters.draw_calls;
+            m_counters.draw_calls_instanced     += cmd_list->m_counters.draw_calls_instanced;
+            m_counters.instances                += cmd_list->m_counters.instances;
+            m_counters.bindings_buffer_vertex   += cmd_list->m_counters.bindings_buffer_vertex;
+            m_counters.bindings_buffer_index    += cmd_list->m_counters.bindings_buffer_index;
+            m_counters.bindings_descriptor_set  += cmd_list->m_counters.bindings_descriptor_set;
+            m_counters.bindings_pipeline        += cmd_list->m_counters.bindings_pipeline;
+
+            // Can be recorded again once the primary's submission is done
+            cmd_list->m_cmd_state = RHI_Cmd_List_Idle_Sync_Cpu_To_Gpu;
+        }
+
+        // The state the secondaries left behind is undefined
+        m_pipeline_active       = false;
+        m_set_id_buffer_vertex  = 0;
+        m_set_id_buffer_pixel   = 0;
+
+        return true;
+    }
+
+    bool RHI_CommandList::End()
+    {
+        if (m_cmd_state != RHI_Cmd_List_Recording)
+        {
+            LOG_ERROR("You have to call Begin() before you can call End()");
+            return false;
+        }
+
+        // End render pass
+        if (m_render_pass_active)
+        {
+            CMD_BUFFER->record(null_common::command_end_render_pass);
+            m_render_pass_active = false;
+        }
+
+        // End marker and profiler
+        MarkAndProfileEnd(m_pipeline_state);
+
+        // End command buffer
+        CMD_BUFFER->record(null_common::command_end);
+
+        // Secondaries hand their counters to the primary which executes them
+        if (!m_is_secondary)
+        {
+            AddCounters();
+        }
+
+        // Update state
+        m_cmd_state = RHI_Cmd_List_Ended;
+
+        return true;
+    }
+
+    void RHI_CommandList::Clear(RHI_PipelineState& pipeline_state)
+    {
+        if (Begin(pipeline_state))
+        {
+            OnDraw();
+            End();
+            Submit();
+            pipeline_state.ResetClearValues();
+        }
+    }
+
+	void RHI_CommandList::Draw(const uint32_t vertex_count)
+	{
+        if (m_cmd_state != RHI_Cmd_List_Recording)
+        {
+            LOG_WARNING("Can't record command");
+            return;
+        }
+
+        // Ensure correct state before attempting to draw
+        if (!OnDraw())
+            return;
+
+        CMD_BUFFER->record(null_common::command_draw, nullptr, vertex_count);
+
+        m_counters.draw_calls++;
+	}
+
+	void RHI_CommandList::DrawIndexed(const uint32_t index_count, const uint32_t index_offset, const uint32_t vertex_offset)
+	{
+        if (m_cmd_state != RHI_Cmd_List_Recording)
+        {
+            LOG_WARNING("Can't record command");
+            return;
+        }
+
+        // Ensure correct state before attempting to draw
+        if (!OnDraw())
+            return;
+
+        CMD_BUFFER->record(null_common::command_draw_indexed, nullptr, index_count, index_offset, vertex_offset);
+
+        m_counters.draw_calls++;
+	}
+
+    void RHI_CommandList::DrawIndexedInstanced(const uint32_t index_count, const uint32_t instance_count, const uint32_t index_offset, const uint32_t vertex_offset)
+    {
+        if (m_cmd_state != RHI_Cmd_List_Recording)
+        {
+            LOG_WARNING("Can't record command");
+            return;
+        }
+
+        // Ensure correct state before attempting to draw
+        if (!OnDraw())
+            return;
+
+        CMD_BUFFER->record(null_common::command_draw_indexed_instanced, nullptr, index_count, instance_count, index_offset, vertex_offset);
+
+        m_counters.draw_calls++;
+        m_counters.draw_calls_instanced++;
+        m_counters.instances += instance_count;
+    }
+
+    void RHI_CommandList::Dispatch(uint32_t x, uint32_t y, uint32_t z /*= 1*/) const
+    {
+        if (m_cmd_state != RHI_Cmd_List_Recording)
+        {
+            LOG_WARNING("Can't record command");
+            return;
+        }
+
+        CMD_BUFFER->record(null_common::command_dispatch, nullptr, x, y, z);
+    }
+
+	void RHI_CommandList::SetViewport(const RHI_Viewport& viewport) const
+	{
+        if (m_cmd_state != RHI_Cmd_List_Recording)
+        {
+            LOG_WARNING("Can't record command");
+            return;
+        }
+
+        CMD_BUFFER->record(null_common::command_set_viewport, nullptr, static_cast<uint32_t>(viewport.x), static_cast<uint32_t>(viewport.y), static_cast<uint32_t>(viewport.width), static_cast<uint32_t>(viewport.height));
+	}
+
+	void RHI_CommandList::SetScissorRectangle(const Math::Rectangle& scissor_rectangle) const
+	{
+        if (m_cmd_state != RHI_Cmd_List_Recording)
+        {
+            LOG_WARNING("Can't record command");
+            return;
+        }
+
+        CMD_BUFFER->record(null_common::command_set_scissor, nullptr, static_cast<uint32_t>(scissor_rectangle.left), static_cast<uint32_t>(scissor_rectangle.top), static_cast<uint32_t>(scissor_rectangle.Width()), static_cast<uint32_t>(scissor_rectangle.Height()));
+	}
+
+	void RHI_CommandList::SetBufferVertex(const RHI_VertexBuffer* buffer)
+	{
+        if (m_cmd_state != RHI_Cmd_List_Recording)
+        {
+            LOG_WARNING("Can't record command");
+            return;
+        }
+
+        if (m_set_id_buffer_vertex == buffer->GetId())
+            return;
+
+        CMD_BUFFER->record(null_common::command_bind_vertex_buffer, buffer->GetResource(), buffer->GetStride(), buffer->GetVertexCount());
+
+        m_counters.bindings_buffer_vertex++;
+        m_set_id_buffer_vertex = buffer->GetId();
+	}
+
+	void RHI_CommandList::SetBufferIndex(const RHI_IndexBuffer* buffer)
+	{
+        if (m_cmd_state != RHI_Cmd_List_Recording)
+        {
+            LOG_WARNING("Can't record command");
+            return;
+        }
+
+        if (m_set_id_buffer_pixel == buffer->GetId())
+            return;
+
+        CMD_BUFFER->record(null_common::command_bind_index_buffer, buffer->GetResource(), buffer->Is16Bit() ? 16 : 32, buffer->GetIndexCount());
+
+        m_counters.bindings_buffer_index++;
+        m_set_id_buffer_pixel = buffer->GetId();
+	}
+
+    void RHI_CommandList::SetConstantBuffer(const uint32_t slot, const uint8_t scope, RHI_ConstantBuffer* constant_buffer) const
+    {
+        if (m_cmd_state != RHI_Cmd_List_Recording)
+        {
+            LOG_WARNING("Can't record command");
+            return;
+        }
+
+        // Set (will only happen if it's not already set)
+        m_descriptor_cache->SetConstantBuffer(slot, constant_buffer);
+    }
+
+    void RHI_CommandList::SetConstantBufferDynamic(const uint32_t slot, const uint8_t scope, RHI_ConstantBuffer* constant_buffer, const uint32_t offset_index_dynamic) const
+    {
+        if (m_cmd_state != RHI_Cmd_List_Recording)
+        {
+            LOG_WARNING("Can't record command");
+            return;
+        }
+
+        // Set (will only happen if it's not already set)
+        m_descriptor_cache->SetConstantBuffer(slot, constant_buffer, offset_index_dynamic);
+    }
+
+    void RHI_CommandList::SetSampler(const uint32_t slot, RHI_Sampler* sampler) const
+    {
+        if (m_cmd_state != RHI_Cmd_List_Recording)
+        {
+            LOG_WARNING("Can't record command");
+            return;
+        }
+
+        // Set (will only happen if it's not already set)
+        m_descriptor_cache->SetSampler(slot, sampler);
+    }
+
+    void RHI_CommandList::SetTexture(const uint32_t slot, RHI_Texture* texture, const uint8_t scope /*= RHI_Shader_Pixel*/)
+    {
+        if (m_cmd_state != RHI_Cmd_List_Recording)
+        {
+            LOG_WARNING("Can't record command");
+            return;
+        }
+
+        // Null textures are allowed, and get replaced with a black texture here
+        if (!texture || !texture->Get_View_Texture())
+        {
+            texture = m_renderer->GetBlackTexture();
+        }
+
+        // If the image has an invalid layout (can happen for a few frames during staging), replace with black
+        if (texture->GetLayout() == RHI_Image_Undefined || texture->GetLayout() == RHI_Image_Preinitialized)
+        {
+            texture = m_renderer->GetBlackTexture();
+        }
+
+        // Secondaries continue the primary's render pass, where layouts can't change, so textures which can't be sampled yet are replaced with black
+        if (m_is_secondary)
+        {
+            const bool needs_transition =
+                (texture->IsColorFormat() && texture->GetLayout() != RHI_Image_Shader_Read_Only_Optimal) ||
+                (texture->IsDepthFormat() && texture->GetLayout() != RHI_Image_Depth_Stencil_Read_Only_Optimal);
+
+            if (needs_transition)
+            {
+                texture = m_renderer->GetBlackTexture();
+            }
+        }
+
+        // Transition to appropriate layout (if needed)
+        {
+            if (texture->IsColorFormat() && texture->GetLayout() != RHI_Image_Shader_Read_Only_Optimal)
+            {
+                texture->SetLayout(RHI_Image_Shader_Read_Only_Optimal, this);
+            }
+
+            if (texture->IsDepthFormat() && texture->GetLayout() != RHI_Image_Depth_Stencil_Read_Only_Optimal)
+            {
+                texture->SetLayout(RHI_Image_Depth_Stencil_Read_Only_Optimal, this);
+            }
+        }
+
+        // Set (will only happen if it's not already set)
+        m_descriptor_cache->SetTexture(slot, texture);
+    }
+
+	bool RHI_CommandList::Submit()
+	{
+        if (m_cmd_state != RHI_Cmd_List_Ended)
+        {
+            LOG_ERROR("RHI_CommandList::End() must be called before calling RHI_CommandList::Submit()");
+            return false;
+        }
+
+        if (!m_rhi_device->Queue_Submit(RHI_Queue_Graphics, m_cmd_buffer))
+            return false;
+
+        // If the render pass has been bound then it cleared to whatever values was requested (or not)
+        // So at this point we reset the values as we don't want to clear again.
+        if (m_render_pass_active)
+        {
+            m_pipeline_state->ResetClearValues();
+        }
+
+        // Keep the same state transitions as the other APIs, so that the same code paths are exercised
+        m_cmd_state = RHI_Cmd_List_Idle_Sync_Cpu_To_Gpu;
+
+        return true;
+	}
+
+    bool RHI_CommandList::Flush()
+    {
+        // Submitted work is complete by definition
+        return true;
+    }
+
+    uint32_t RHI_CommandList::Gpu_GetMemory(RHI_Device* rhi_device)
+    {
+        return 0;
+    }
+
+    uint32_t RHI_CommandList::Gpu_GetMemoryUsed(RHI_Device* rhi_device)
+    {
+        return 0;
+    }
+
+    bool RHI_CommandList::Timestamp_Start(void* query_disjoint /*= nullptr*/, void* query_start /*= nullptr*/) const
+    {
+        if (m_cmd_state != RHI_Cmd_List_Recording)
+        {
+            LOG_WARNING("Can't record command");
+            return false;
+        }
+
+        CMD_BUFFER->record(null_common::command_timestamp, nullptr, m_pass_index);
+
+        return true;
+    }
+
+    bool RHI_CommandList::Timestamp_End(void* query_disjoint /*= nullptr*/, void* query_end /*= nullptr*/) const
+    {
+        if (m_cmd_state != RHI_Cmd_List_Recording)
+        {
+            LOG_WARNING("Can't record command");
+            return false;
+        }
+
+        CMD_BUFFER->record(null_common::command_timestamp, nullptr, m_pass_index + 1);
+
+        return true;
+    }
+
+    float RHI_CommandList::Timestamp_GetDuration(void* query_disjoint /*= nullptr*/, void* query_start /*= nullptr*/, void* query_end /*= nullptr*/)
+    {
+        // Nothing executes, so no time passes on the "GPU"
+        return 0.0f;
+    }
+
+    bool RHI_CommandList::Gpu_QueryCreate(RHI_Device* rhi_device, void** query /*= nullptr*/, RHI_Query_Type type /*= RHI_Query_Timestamp*/)
+    {
+        // Not needed
+        return true;
+    }
+
+    void RHI_CommandList::Gpu_QueryRelease(void*& query_object)
+    {
+        // Not needed
+    }
+
+    void RHI_CommandList::MarkAndProfileStart(const RHI_PipelineState* pipeline_state)
+    {
+        if (!pipeline_state || !pipeline_state->pass_name)
+            return;
+
+        // Allowed profiler ?
+        if (m_rhi_device->GetContextRhi()->profiler)
+        {
+            if (m_profiler && pipeline_state->profile)
+            {
+                m_profiler->TimeBlockStart(pipeline_state->pass_name, TimeBlock_Cpu, this);
+                m_profiler->TimeBlockStart(pipeline_state->pass_name, TimeBlock_Gpu, this);
+            }
+        }
+
+        // Allowed to markers ?
+        if (m_rhi_device->GetContextRhi()->markers && pipeline_state->mark)
+        {
+            CMD_BUFFER->record(null_common::command_marker_begin, pipeline_state->pass_name);
+        }
+
+        if (m_pass_index < m_passes_active.size())
+        {
+            m_passes_active[m_pass_index++] = true;
+        }
+    }
+
+    void RHI_CommandList::MarkAndProfileEnd(const RHI_PipelineState* pipeline_state)
+    {
+        if (!pipeline_state || m_pass_index == 0 || !m_passes_active[m_pass_index - 1])
+            return;
+
+        m_passes_active[--m_pass_index] = false;
+
+        // Allowed markers ?
+        if (m_rhi_device->GetContextRhi()->markers && pipeline_state->mark)
+        {
+            CMD_BUFFER->record(null_common::command_marker_end);
+        }
+
+        // Allowed profiler ?
+        if (m_rhi_device->GetContextRhi()->profiler && pipeline_state->profile)
+        {
+            if (m_profiler)
+            {
+                m_profiler->TimeBlockEnd(); // cpu
+                m_profiler->TimeBlockEnd(); // gpu
+            }
+        }
+    }
+
+    void RHI_CommandList::BeginRenderPass(const bool contents_secondary /*= false*/)
+    {
+        RHI_PipelineState* state = m_pipeline->GetPipelineState();
+        CMD_BUFFER->record(null_common::command_begin_render_pass, state->GetFrameBuffer(), state->GetWidth(), state->GetHeight(), contents_secondary ? 1 : 0);
+    }
+
+    bool RHI_CommandList::BindDescriptorSet()
+    {
+        // Descriptor set != null, result = true    -> the descriptor set must be bound
+        // Descriptor set == null, result = true    -> the descriptor set is already bound
+        // Descriptor set == null, result = false   -> a new descriptor was needed but we are out of memory (allocates next frame)
+
+        void* descriptor_set = nullptr;
+        bool result = m_descriptor_cache->GetResource_DescriptorSet(descriptor_set);
+
+        if (result && descriptor_set != nullptr)
+        {
+            const vector<uint32_t>& dynamic_offsets = m_descriptor_cache->GetDynamicOffsets();
+            CMD_BUFFER->record(null_common::command_bind_descriptor_set, descriptor_set, static_cast<uint32_t>(dynamic_offsets.size()), !dynamic_offsets.empty() ? dynamic_offsets[0] : 0);
+
+            m_counters.bindings_descriptor_set++;
+
+            // Upon setting a new descriptor, resources have to be set again.
+            m_set_id_buffer_vertex  = 0;
+            m_set_id_buffer_pixel   = 0;
+        }
+
+        return result;
+    }
+
+    bool RHI_CommandList::OnDraw()
+    {
+        // Begin render pass (secondaries continue the primary's)
+        if (!m_render_pass_active && !m_is_secondary)
+        {
+            BeginRenderPass();
+            m_render_pass_active = true;
+        }
+
+        // Set pipeline
+        if (!m_pipeline_active)
+        {
+            // Bind pipeline
+            if (void* pipeline = m_pipeline->GetPipeline())
+            {
+                CMD_BUFFER->record(null_common::command_bind_pipeline, pipeline);
+                m_counters.bindings_pipeline++;
+                m_pipeline_active = true;
+            }
+            else
+            {
+                LOG_ERROR("Invalid pipeline");
+                return false;
+            }
+        }
+
+        // Bind descriptor set
+        return BindDescriptorSet();
+    }
+
+    void RHI_CommandList::AddCounters()
+    {
+        m_profiler->m_rhi_draw_calls                += m_counters.draw_calls;
+        m_profiler->m_rhi_draw_calls_instanced      += m_counters.draw_calls_instanced;
+        m_profiler->m_rhi_instances                 += m_counters.instances;
+        m_profiler->m_rhi_bindings_buffer_vertex    += m_counters.bindings_buffer_vertex;
+        m_profiler->m_rhi_bindings_buffer_index     += m_counters.bindings_buffer_index;
+        m_profiler->m_rhi_bindings_descriptor_set   += m_counters.bindings_descriptor_set;
+        m_profiler->m_rhi_bindings_pipeline         += m_counters.bindings_pipeline;
+
+        m_counters = Counters();
+    }
+}
+#endif
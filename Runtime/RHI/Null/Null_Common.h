@@ -0,0 +1,142 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= IMPLEMENTATION =====
+#ifdef API_GRAPHICS_NULL
+//======================
+
+//= INCLUDES =================
+#include "../RHI_Device.h"
+#include <vector>
+#include <cstring>
+#include <cstddef>
+#include "../../Logging/Log.h"
+//============================
+
+namespace Spartan::null_common
+{
+    // Host memory stands in for device memory, so that mapping, writing and reading back buffers behaves like it would on a GPU
+    namespace memory
+    {
+        inline void* allocate(const uint64_t size)
+        {
+            if (size == 0)
+                return nullptr;
+
+            auto ptr = new std::byte[size];
+            std::memset(ptr, 0, size);
+            return static_cast<void*>(ptr);
+        }
+
+        inline void free(void*& ptr)
+        {
+            if (!ptr)
+                return;
+
+            delete[] static_cast<std::byte*>(ptr);
+            ptr = nullptr;
+        }
+    }
+
+    // Opaque, unique, non-null handles for objects that have no memory of their own (views, pipelines, descriptor sets etc)
+    namespace handle
+    {
+        inline void* create()
+        {
+            return memory::allocate(1);
+        }
+
+        inline void destroy(void*& handle)
+        {
+            memory::free(handle);
+        }
+
+        inline void destroy(std::vector<void*>& handles)
+        {
+            for (void*& handle : handles)
+            {
+                destroy(handle);
+            }
+            handles.clear();
+        }
+    }
+
+    enum command_type
+    {
+        command_begin,
+        command_end,
+        command_begin_render_pass,
+        command_end_render_pass,
+        command_bind_pipeline,
+        command_bind_descriptor_set,
+        command_bind_vertex_buffer,
+        command_bind_index_buffer,
+        command_set_viewport,
+        command_set_scissor,
+        command_draw,
+        command_draw_indexed,
+        command_draw_indexed_instanced,
+        command_dispatch,
+        command_timestamp,
+        command_marker_begin,
+        command_marker_end,
+        command_execute_secondary // followed by the secondary's commands, the resource is the secondary's command buffer and the first argument its command count
+    };
+
+    // A recorded command, the arguments are interpreted based on the command type (e.g. vertex count, index count, index offset etc)
+    struct command
+    {
+        command_type type;
+        const void* resource;
+        uint32_t args[4];
+    };
+
+    // What RHI_CommandList::GetResource_CommandBuffer() points to, can be inspected after Submit() and up until the next Begin()
+    struct command_buffer
+    {
+        void record(const command_type type, const void* resource = nullptr, const uint32_t arg0 = 0, const uint32_t arg1 = 0, const uint32_t arg2 = 0, const uint32_t arg3 = 0)
+        {
+            commands.push_back({ type, resource, { arg0, arg1, arg2, arg3 } });
+        }
+
+        void reset()
+        {
+            commands.clear(); // keeps the capacity, so that steady state recording doesn't allocate
+        }
+
+        uint32_t count(const command_type type) const
+        {
+            uint32_t count = 0;
+            for (const command& cmd : commands)
+            {
+                count += cmd.type == type ? 1 : 0;
+            }
+            return count;
+        }
+
+        std::vector<command> commands;
+        uint32_t submissions = 0;
+    };
+}
+
+#endif
@@ -0,0 +1,73 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION ===============
+#include "../RHI_Implementation.h"
+#ifdef API_GRAPHICS_NULL
+//================================
+
+//= INCLUDES ======================
+#include "../RHI_DescriptorCache.h"
+//=================================
+
+namespace Spartan
+{
+    RHI_DescriptorCache::~RHI_DescriptorCache()
+    {
+        null_common::handle::destroy(m_descriptor_pool);
+    }
+
+    void RHI_DescriptorCache::SetDescriptorSetCapacity(uint32_t descriptor_set_capacity)
+    {
+        if (!m_rhi_device || !m_rhi_device->GetContextRhi())
+        {
+            LOG_ERROR_INVALID_INTERNALS();
+            return;
+        }
+
+        // Destroy layouts (and descriptor sets)
+        m_descriptor_set_layouts.clear();
+        m_descriptor_layout_current = nullptr;
+
+        // Destroy pool
+        null_common::handle::destroy(m_descriptor_pool);
+
+        // Re-allocate everything with the new size
+        CreateDescriptorPool(descriptor_set_capacity);
+    }
+
+    bool RHI_DescriptorCache::CreateDescriptorPool(uint32_t descriptor_set_capacity)
+    {
+        m_descriptor_pool = null_common::handle::create();
+        return true;
+    }
+
+    bool RHI_DescriptorCache::CreateBindless()
+    {
+        return false;
+    }
+
+    void RHI_DescriptorCache::UpdateBindless(uint32_t index, RHI_Texture* texture)
+    {
+
+    }
+}
+#endif
@@ -0,0 +1,92 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION ===============
+#include "../RHI_Implementation.h"
+#ifdef API_GRAPHICS_NULL
+//================================
+
+//= INCLUDES ==================
+#include "../RHI_Device.h"
+#include "../../Logging/Log.h"
+//=============================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	RHI_Device::RHI_Device(Context* context)
+	{
+        m_context       = context;
+		m_rhi_context   = make_shared<RHI_Context>();
+
+        // A single device, backed by host memory
+        RegisterPhysicalDevice(PhysicalDevice
+        (
+            0,                          // api version
+            0,                          // driver version
+            0,                          // vendor id
+            RHI_PhysicalDevice_Cpu,     // type
+            "Null",                     // name
+            0,                          // memory
+            nullptr                     // data
+        ));
+        SetPrimaryPhysicalDevice(0);
+
+        // Secondary command lists are plain vectors of commands, which the primary copies when it executes them
+        m_rhi_context->parallel_recording = true;
+
+        // Display modes are deliberately not registered, so that the timer doesn't cap the frame rate to a monitor's refresh rate
+        LOG_INFO("Null (commands are recorded, not executed)");
+
+		m_initialized = true;
+	}
+
+	RHI_Device::~RHI_Device() = default;
+
+    bool RHI_Device::Queue_Present(void* swapchain_view, uint32_t* image_index) const
+    {
+        return swapchain_view != nullptr;
+    }
+
+    bool RHI_Device::Queue_Submit(const RHI_Queue_Type type, void* cmd_buffer, void* wait_semaphore /*= nullptr*/, void* wait_fence /*= nullptr*/, const uint32_t wait_flags /*= 0*/) const
+    {
+        if (!cmd_buffer)
+        {
+            LOG_ERROR_INVALID_PARAMETER();
+            return false;
+        }
+
+        // Work completes at the time of submission, so there is nothing to wait for later
+        lock_guard<mutex> lock(m_queue_mutex);
+        static_cast<null_common::command_buffer*>(cmd_buffer)->submissions++;
+
+        return true;
+    }
+
+    bool RHI_Device::Queue_Wait(const RHI_Queue_Type type) const
+    {
+        return true;
+    }
+}
+#endif
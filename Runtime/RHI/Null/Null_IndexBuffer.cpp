@@ -0,0 +1,97 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION ===============
+#include "../RHI_Implementation.h"
+#ifdef API_GRAPHICS_NULL
+//================================
+
+//= INCLUDES ====================
+#include "../RHI_Device.h"
+#include "../RHI_IndexBuffer.h"
+#include "../../Logging/Log.h"
+//===============================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	RHI_IndexBuffer::~RHI_IndexBuffer()
+	{
+        null_common::handle::destroy(m_buffer);
+        null_common::memory::free(m_buffer_memory);
+	}
+
+	bool RHI_IndexBuffer::_Create(const void* indices)
+	{
+		if (!m_rhi_device || !m_rhi_device->GetContextRhi())
+		{
+			LOG_ERROR_INVALID_INTERNALS();
+			return false;
+		}
+
+		// Clear previous buffer
+        null_common::handle::destroy(m_buffer);
+        null_common::memory::free(m_buffer_memory);
+
+        // Host memory is always visible, so unlike other APIs, initialised buffers can be mapped too
+        m_buffer        = null_common::handle::create();
+        m_buffer_memory = null_common::memory::allocate(m_size_gpu);
+        m_mappable      = true;
+
+        if (indices && m_buffer_memory)
+        {
+            memcpy(m_buffer_memory, indices, static_cast<size_t>(m_size_gpu));
+        }
+
+		return true;
+	}
+
+	void* RHI_IndexBuffer::Map() const
+	{
+        if (!m_buffer_memory)
+        {
+            LOG_ERROR_INVALID_INTERNALS();
+            return nullptr;
+        }
+
+        return m_buffer_memory;
+	}
+
+	bool RHI_IndexBuffer::Unmap() const
+	{
+        if (!m_buffer_memory)
+        {
+            LOG_ERROR_INVALID_INTERNALS();
+            return false;
+        }
+
+        return true;
+	}
+
+    bool RHI_IndexBuffer::Flush() const
+    {
+        return true;
+    }
+}
+#endif
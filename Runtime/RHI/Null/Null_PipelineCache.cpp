@@ -0,0 +1,56 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION ===============
+#include "../RHI_Implementation.h"
+#ifdef API_GRAPHICS_NULL
+//================================
+
+//= INCLUDES ==================
+#include "../RHI_PipelineCache.h"
+//=============================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    // The blob is kept as is and written back on save, so that persistence can be exercised without a GPU
+    bool RHI_PipelineCache::CreateDriverCache(const vector<std::byte>& data)
+    {
+        DestroyDriverCache();
+        m_driver_cache = static_cast<void*>(new vector<std::byte>(data));
+        return true;
+    }
+
+    void RHI_PipelineCache::GetDriverCacheData(vector<std::byte>& data) const
+    {
+        data = m_driver_cache ? *static_cast<vector<std::byte>*>(m_driver_cache) : vector<std::byte>();
+    }
+
+    void RHI_PipelineCache::DestroyDriverCache()
+    {
+        delete static_cast<vector<std::byte>*>(m_driver_cache);
+        m_driver_cache = nullptr;
+    }
+}
+#endif
@@ -0,0 +1,81 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION ===============
+#include "../RHI_Implementation.h"
+#ifdef API_GRAPHICS_NULL
+//================================
+
+//= INCLUDES =======================
+#include "../RHI_Device.h"
+#include "../RHI_Shader.h"
+#include "../RHI_InputLayout.h"
+#include "../../Logging/Log.h"
+#include "../../Core/FileSystem.h"
+//==================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	RHI_Shader::~RHI_Shader()
+	{
+        null_common::handle::destroy(m_resource);
+	}
+
+    string RHI_Shader::GetCompilerVersion()
+    {
+        return "null";
+    }
+
+	bool RHI_Shader::_Compile(const string& shader, vector<std::byte>& bytecode)
+	{
+        // There is no compiler (or bytecode) behind this API, so compilation only validates that there is something to compile.
+        // Reflection doesn't happen either, so shaders expose no descriptors and pipelines end up with empty descriptor sets.
+        // The bytecode stays empty, which also keeps these shaders out of the shader cache.
+        if (shader.empty() || (FileSystem::IsSupportedShaderFile(shader) && !FileSystem::Exists(shader)))
+        {
+            LOG_ERROR("Invalid shader \"%s\"", shader.c_str());
+            return false;
+        }
+
+        bytecode.clear();
+        return true;
+	}
+
+    void* RHI_Shader::_CreateResource(const vector<std::byte>& bytecode)
+    {
+        // Create input layout
+        if (m_shader_type == RHI_Shader_Vertex && m_vertex_type != RHI_Vertex_Type_Unknown)
+        {
+            if (!m_input_layout->Create(m_vertex_type, nullptr))
+            {
+                LOG_ERROR("Failed to create input layout for %s", FileSystem::GetFileNameFromFilePath(m_file_path).c_str());
+                return nullptr;
+            }
+        }
+
+        return null_common::handle::create();
+    }
+}
+#endif
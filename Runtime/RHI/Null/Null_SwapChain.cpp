@@ -0,0 +1,151 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION ===============
+#include "../RHI_Implementation.h"
+#ifdef API_GRAPHICS_NULL
+//================================
+
+//= INCLUDES ========================
+#include "../RHI_SwapChain.h"
+#include "../RHI_Device.h"
+#include "../RHI_CommandList.h"
+#include "../../Logging/Log.h"
+//===================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	RHI_SwapChain::RHI_SwapChain(
+		void* window_handle,
+        const shared_ptr<RHI_Device>& rhi_device,
+		const uint32_t width,
+		const uint32_t height,
+		const RHI_Format format	    /*= Format_R8G8B8A8_UNORM*/,
+		const uint32_t buffer_count	/*= 1 */,
+        const uint32_t flags	    /*= Present_Immediate */
+	)
+	{
+        // Validate device
+        if (!rhi_device || !rhi_device->GetContextRhi())
+        {
+            LOG_ERROR("Invalid device.");
+            return;
+        }
+
+        // Validate resolution
+        if (!rhi_device->ValidateResolution(width, height))
+        {
+            LOG_WARNING("%dx%d is an invalid resolution", width, height);
+            return;
+        }
+
+        // The window handle is not required, there is nothing to present to
+		m_format		= format;
+        m_rhi_device    = rhi_device.get();
+		m_buffer_count	= buffer_count;
+		m_windowed		= true;
+		m_width			= width;
+		m_height		= height;
+		m_flags			= flags;
+        m_window_handle = window_handle;
+
+        // Create the swap chain and its images
+        m_swap_chain_view               = null_common::handle::create();
+        m_resource_render_target_view   = null_common::handle::create();
+        for (uint32_t i = 0; i < m_buffer_count; i++)
+        {
+            m_resource_texture.emplace_back(null_common::handle::create());
+            m_resource_shader_view.emplace_back(null_common::handle::create());
+        }
+
+        // Create command lists
+        for (uint32_t i = 0; i < m_buffer_count; i++)
+        {
+            m_cmd_lists.emplace_back(make_shared<RHI_CommandList>(i, this, rhi_device->GetContext()));
+        }
+
+		m_initialized = true;
+	}
+
+	RHI_SwapChain::~RHI_SwapChain()
+	{
+        m_cmd_lists.clear();
+
+        null_common::handle::destroy(m_resource_shader_view);
+        null_common::handle::destroy(m_resource_texture);
+        null_common::handle::destroy(m_resource_render_target_view);
+        null_common::handle::destroy(m_swap_chain_view);
+	}
+
+	bool RHI_SwapChain::Resize(const uint32_t width, const uint32_t height)
+	{
+        // Validate resolution
+        m_present = m_rhi_device->ValidateResolution(width, height);
+        if (!m_present)
+        {
+            // Return true as when minimizing, a resolution
+            // of 0,0 can be passed in, and this is fine.
+            return true;
+        }
+
+		// Only resize if needed
+		if (m_width == width && m_height == height)
+			return true;
+
+		// Images are just handles, so only the dimensions have to change
+		m_width		= width;
+		m_height	= height;
+
+		return true;
+	}
+
+    bool RHI_SwapChain::AcquireNextImage()
+    {
+        return true;
+    }
+
+	bool RHI_SwapChain::Present()
+    {
+        if (!m_present)
+            return true;
+
+        if (!m_rhi_device->Queue_Present(m_swap_chain_view, &m_image_index))
+        {
+            LOG_ERROR("Failed to present");
+            return false;
+        }
+
+        // Move on to the next image (and command list)
+        m_image_index = (m_image_index + 1) % m_buffer_count;
+
+		return true;
+	}
+
+    void RHI_SwapChain::SetLayout(RHI_Image_Layout layout, RHI_CommandList* command_list /*= nullptr*/)
+    {
+        m_layout = layout;
+    }
+}
+#endif
@@ -0,0 +1,185 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION ===============
+#include "../RHI_Implementation.h"
+#ifdef API_GRAPHICS_NULL
+//================================
+
+//= INCLUDES =====================
+#include "../RHI_Device.h"
+#include "../RHI_Texture2D.h"
+#include "../RHI_TextureCube.h"
+#include "../RHI_CommandList.h"
+//================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    namespace _Null_Texture
+    {
+        inline void destroy(void*& texture, void*& memory, void* (&view_texture)[2], void*& view_unordered_access, vector<void*>& view_attachments_color, vector<void*>& view_attachments_depth_stencil, vector<void*>& view_attachments_depth_stencil_read_only)
+        {
+            null_common::handle::destroy(view_texture[0]);
+            null_common::handle::destroy(view_texture[1]);
+            null_common::handle::destroy(view_unordered_access);
+            null_common::handle::destroy(view_attachments_color);
+            null_common::handle::destroy(view_attachments_depth_stencil);
+            null_common::handle::destroy(view_attachments_depth_stencil_read_only);
+            null_common::handle::destroy(texture);
+            null_common::memory::free(memory);
+        }
+
+        inline uint64_t upload(void*& memory, const vector<vector<std::byte>>& data)
+        {
+            uint64_t size = 0;
+            for (const auto& mip : data)
+            {
+                size += static_cast<uint64_t>(mip.size());
+            }
+
+            // "Upload" the mip levels (and array slices) into host memory
+            memory = null_common::memory::allocate(size);
+            uint64_t offset = 0;
+            for (const auto& mip : data)
+            {
+                if (!mip.empty())
+                {
+                    memcpy(static_cast<std::byte*>(memory) + offset, mip.data(), mip.size());
+                    offset += static_cast<uint64_t>(mip.size());
+                }
+            }
+
+            return size;
+        }
+    }
+
+    RHI_Texture2D::~RHI_Texture2D()
+    {
+        m_data.clear();
+        _Null_Texture::destroy(m_texture, m_resource_memory, m_view_texture, m_view_unordered_access, m_view_attachment_color, m_view_attachment_depth_stencil, m_view_attachment_depth_stencil_read_only);
+    }
+
+    void RHI_Texture::SetLayout(const RHI_Image_Layout layout, RHI_CommandList* command_list /*= nullptr*/)
+    {
+        m_layout = layout;
+    }
+
+	bool RHI_Texture2D::CreateResourceGpu()
+	{
+		if (!m_rhi_device || !m_rhi_device->GetContextRhi())
+		{
+			LOG_ERROR_INVALID_INTERNALS();
+			return false;
+		}
+
+        // Image
+        m_texture   = null_common::handle::create();
+        m_size_gpu  = _Null_Texture::upload(m_resource_memory, m_data);
+
+        // Views
+        {
+            // Sampled
+            if (IsSampled())
+            {
+                m_view_texture[0] = (IsColorFormat() || IsDepthFormat()) ? null_common::handle::create() : nullptr;
+                m_view_texture[1] = IsStencilFormat() ? null_common::handle::create() : nullptr;
+            }
+
+            // Unordered access
+            if (IsRenderTargetCompute())
+            {
+                m_view_unordered_access = null_common::handle::create();
+            }
+
+            // Color and depth-stencil (one per array slice)
+            for (uint32_t i = 0; i < m_array_size; i++)
+            {
+                if (IsRenderTargetColor())
+                {
+                    m_view_attachment_color.emplace_back(null_common::handle::create());
+                }
+
+                if (IsRenderTargetDepthStencil())
+                {
+                    m_view_attachment_depth_stencil.emplace_back(null_common::handle::create());
+                    m_view_attachment_depth_stencil_read_only.emplace_back(null_common::handle::create());
+                }
+            }
+        }
+
+        // Deduce layout
+        {
+            RHI_Image_Layout target_layout = RHI_Image_General;
+
+            if (IsSampled() && IsColorFormat())
+                target_layout = RHI_Image_Shader_Read_Only_Optimal;
+
+            if (IsRenderTargetColor())
+                target_layout = RHI_Image_Color_Attachment_Optimal;
+
+            if (IsRenderTargetDepthStencil())
+                target_layout = RHI_Image_Depth_Stencil_Attachment_Optimal;
+
+            SetLayout(target_layout);
+        }
+
+		return true;
+	}
+
+	// TEXTURE CUBE
+
+	RHI_TextureCube::~RHI_TextureCube()
+	{
+        m_data.clear();
+        _Null_Texture::destroy(m_texture, m_resource_memory, m_view_texture, m_view_unordered_access, m_view_attachment_color, m_view_attachment_depth_stencil, m_view_attachment_depth_stencil_read_only);
+	}
+
+	bool RHI_TextureCube::CreateResourceGpu()
+	{
+		if (!m_rhi_device || !m_rhi_device->GetContextRhi())
+		{
+			LOG_ERROR_INVALID_INTERNALS();
+			return false;
+		}
+
+        m_texture           = null_common::handle::create();
+        m_size_gpu          = _Null_Texture::upload(m_resource_memory, m_data);
+        m_view_texture[0]   = IsSampled() ? null_common::handle::create() : nullptr;
+
+        for (uint32_t i = 0; i < m_array_size; i++)
+        {
+            if (IsRenderTargetDepthStencil())
+            {
+                m_view_attachment_depth_stencil.emplace_back(null_common::handle::create());
+                m_view_attachment_depth_stencil_read_only.emplace_back(null_common::handle::create());
+            }
+        }
+
+        SetLayout(IsRenderTargetDepthStencil() ? RHI_Image_Depth_Stencil_Attachment_Optimal : RHI_Image_Shader_Read_Only_Optimal);
+
+		return true;
+	}
+}
+#endif
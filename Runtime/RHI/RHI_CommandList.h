@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ======================
 #include <vector>
+#include <memory>
 #include "RHI_Definition.h"
 #include "../Core/Spartan_Object.h"
 //=================================
@@ -43,19 +44,28 @@ namespace Spartan
 	class SPARTAN_CLASS RHI_CommandList : public Spartan_Object
 	{
 	public:
-		RHI_CommandList(uint32_t index, RHI_SwapChain* swap_chain, Context* context);
+		RHI_CommandList(uint32_t index, RHI_SwapChain* swap_chain, Context* context, bool is_secondary = false);
 		~RHI_CommandList();
 
         // Passes
         bool Begin(RHI_PipelineState& pipeline_state);
         bool End();
 
+        // Secondary command lists record a part of the primary's current pass, so that a pass can be recorded by several threads.
+        // BeginSecondary() has to be called on the thread which owns the primary, after that the list can be recorded (and ended) on any thread.
+        // Every secondary owns its descriptor cache, so recording threads never share descriptor state (or command memory).
+        bool BeginSecondary(RHI_CommandList* primary);
+        // Executes the (ended) secondaries in the given order, the primary must not have recorded any draws of its own in the current pass
+        bool ExecuteSecondary(RHI_CommandList* const* cmd_lists, uint32_t count);
+        bool IsSecondary() const { return m_is_secondary; }
+
         // Clear
         void Clear(RHI_PipelineState& pipeline_state);
 
 		// Draw/Dispatch
 		void Draw(uint32_t vertex_count);
 		void DrawIndexed(uint32_t index_count, uint32_t index_offset = 0, uint32_t vertex_offset = 0);
+        void DrawIndexedInstanced(uint32_t index_count, uint32_t instance_count, uint32_t index_offset = 0, uint32_t vertex_offset = 0);
         void Dispatch(uint32_t x, uint32_t y, uint32_t z = 1) const;
 
 		// Viewport
@@ -75,6 +85,9 @@ namespace Spartan
 		// Constant buffer
         void SetConstantBuffer(const uint32_t slot, const uint8_t scope, RHI_ConstantBuffer* constant_buffer) const;
         inline void SetConstantBuffer(const uint32_t slot, const uint8_t scope, const std::shared_ptr<RHI_ConstantBuffer>& constant_buffer) const { SetConstantBuffer(slot, scope, constant_buffer.get()); }
+        // Binds a dynamic buffer at the given element, without changing the buffer's own dynamic offset (which other threads may be reading)
+        void SetConstantBufferDynamic(const uint32_t slot, const uint8_t scope, RHI_ConstantBuffer* constant_buffer, const uint32_t offset_index_dynamic) const;
+        inline void SetConstantBufferDynamic(const uint32_t slot, const uint8_t scope, const std::shared_ptr<RHI_ConstantBuffer>& constant_buffer, const uint32_t offset_index_dynamic) const { SetConstantBufferDynamic(slot, scope, constant_buffer.get(), offset_index_dynamic); }
 
 		// Sampler
         void SetSampler(const uint32_t slot, RHI_Sampler* sampler) const;
@@ -104,9 +117,10 @@ namespace Spartan
 	private:
         void MarkAndProfileStart(const RHI_PipelineState* pipeline_state);
         void MarkAndProfileEnd(const RHI_PipelineState* pipeline_state);
-        void BeginRenderPass();
+        void BeginRenderPass(bool contents_secondary = false);
         bool BindDescriptorSet();
         bool OnDraw();
+        void AddCounters();
 
         uint32_t m_pass_index                   = 0;
         RHI_Cmd_List_State m_cmd_state          = RHI_Cmd_List_Idle;
@@ -123,11 +137,27 @@ namespace Spartan
         void* m_query_pool                      = nullptr;
         bool m_render_pass_active               = false;
         bool m_pipeline_active                  = false;
+        bool m_is_secondary                     = false;
+        void* m_cmd_pool                        = nullptr; // secondaries allocate from their own pool, pools can't be shared between threads
+        std::shared_ptr<RHI_DescriptorCache> m_descriptor_cache_secondary;
         std::vector<uint64_t> m_timestamps;
         std::vector<bool> m_passes_active;
 
         // Variables to minimise state changes
         uint32_t m_set_id_buffer_vertex = 0;
         uint32_t m_set_id_buffer_pixel  = 0;
+
+        // Draws and bindings are counted per command list and added to the profiler when the list ends (or, for secondaries, when the primary executes them)
+        struct Counters
+        {
+            uint32_t draw_calls                 = 0;
+            uint32_t draw_calls_instanced       = 0;
+            uint32_t instances                  = 0;
+            uint32_t bindings_buffer_vertex     = 0;
+            uint32_t bindings_buffer_index      = 0;
+            uint32_t bindings_descriptor_set    = 0;
+            uint32_t bindings_pipeline          = 0;
+        };
+        Counters m_counters;
 	};
 }
@@ -52,6 +52,9 @@ namespace Spartan
 		bool Unmap() const;
         bool Flush(const uint32_t offset_index = 0);
 
+        // Persistently mapped buffers stay mapped for their lifetime, Map() is then just pointer arithmetic and Unmap() does nothing
+        bool IsPersistentlyMapped() const { return m_mapped != nullptr; }
+
 		void* GetResource()         const { return m_buffer; }
         uint32_t GetStride()        const { return m_stride; }
         uint32_t GetElementCount()  const { return m_element_count; }
@@ -79,6 +82,7 @@ namespace Spartan
 		// API
 		void* m_buffer			= nullptr;
 		void* m_buffer_memory	= nullptr;
+        void* m_mapped          = nullptr;
 
         // Dependencies
         std::shared_ptr<RHI_Device> m_rhi_device;
@@ -53,6 +53,7 @@ namespace Spartan
 	class RHI_Texture2D;
 	class RHI_TextureCube;
 	class RHI_Shader;
+    class RHI_ShaderCache;
 	struct RHI_Vertex_Undefined;
 	struct RHI_Vertex_PosTex;
 	struct RHI_Vertex_PosCol;
@@ -183,6 +184,7 @@ namespace Spartan
 		RHI_Format_R32G32B32_Float,
 		// RGBA
 		RHI_Format_R8G8B8A8_Unorm,
+		RHI_Format_R8G8B8A8_Uint,
         RHI_Format_R10G10B10A2_Unorm,
 		RHI_Format_R16G16B16A16_Float,
 		RHI_Format_R32G32B32A32_Float,   
@@ -286,6 +288,7 @@ namespace Spartan
             case RHI_Format_R32G32_Float:		    return "RHI_Format_R32G32_Float";
             case RHI_Format_R32G32B32_Float:	    return "RHI_Format_R32G32B32_Float";
             case RHI_Format_R8G8B8A8_Unorm:		    return "RHI_Format_R8G8B8A8_Unorm";
+            case RHI_Format_R8G8B8A8_Uint:		    return "RHI_Format_R8G8B8A8_Uint";
             case RHI_Format_R16G16B16A16_Float:	    return "RHI_Format_R16G16B16A16_Float";
             case RHI_Format_R32G32B32A32_Float:	    return "RHI_Format_R32G32B32A32_Float";
             case RHI_Format_D32_Float:	            return "RHI_Format_D32_Float";
@@ -296,6 +299,33 @@ namespace Spartan
         return "Unknown format";
     }
 
+    inline uint32_t rhi_format_to_bytes(const RHI_Format format)
+    {
+        switch (format)
+        {
+            case RHI_Format_R8_Unorm:               return 1;
+            case RHI_Format_R16_Uint:			    return 2;
+            case RHI_Format_R16_Float:			    return 2;
+            case RHI_Format_R32_Uint:			    return 4;
+            case RHI_Format_R32_Float:			    return 4;
+            case RHI_Format_R8G8_Unorm:			    return 2;
+            case RHI_Format_R16G16_Float:		    return 4;
+            case RHI_Format_R32G32_Float:		    return 8;
+            case RHI_Format_R11G11B10_Float:	    return 4;
+            case RHI_Format_R32G32B32_Float:	    return 12;
+            case RHI_Format_R8G8B8A8_Unorm:		    return 4;
+            case RHI_Format_R8G8B8A8_Uint:		    return 4;
+            case RHI_Format_R10G10B10A2_Unorm:	    return 4;
+            case RHI_Format_R16G16B16A16_Float:	    return 8;
+            case RHI_Format_R32G32B32A32_Float:	    return 16;
+            case RHI_Format_D32_Float:	            return 4;
+            case RHI_Format_D32_Float_S8X24_Uint:	return 8;
+            case RHI_Format_Undefined:              return 0;
+        }
+
+        return 0;
+    }
+
     static const Math::Vector4 state_dont_clear_color   = Math::Vector4::Infinity;
     static const float state_dont_clear_depth           = std::numeric_limits<float>::infinity();
     static const uint8_t state_dont_clear_stencil       = 255;
@@ -37,19 +37,27 @@ using namespace std;
 
 namespace Spartan
 {
-    RHI_DescriptorCache::RHI_DescriptorCache(const RHI_Device* rhi_device)
+    static const uint64_t bindless_release_frames = 3; // frames a bindless slot stays untouched after its texture is gone, frames in flight may still read it
+
+    RHI_DescriptorCache::RHI_DescriptorCache(const RHI_Device* rhi_device, const bool owns_bindless /*= true*/)
     {
-        m_rhi_device = rhi_device;
+        m_rhi_device    = rhi_device;
+        m_owns_bindless = owns_bindless;
 
         // Set the descriptor set capacity to an initial value
         SetDescriptorSetCapacity(m_descriptor_set_capacity);
+
+        // Create the global texture array, falls back to per draw texture binding if this fails
+        RHI_Context* rhi_context = m_rhi_device->GetContextRhi();
+        if (m_owns_bindless && rhi_context->bindless_textures && !CreateBindless())
+        {
+            LOG_WARNING("Failed to create the bindless texture array, materials will bind their textures per draw");
+            rhi_context->bindless_textures = false;
+        }
     }
 
     void RHI_DescriptorCache::SetPipelineState(RHI_PipelineState& pipeline_state)
     {
-        // Name this resource, very useful for Vulkan debugging
-        m_name = (pipeline_state.shader_vertex ? pipeline_state.shader_vertex->GetName() : "null") + "-" + (pipeline_state.shader_pixel ? pipeline_state.shader_pixel->GetName() : "null");
-
        // Compute shader hash (which defines the descriptor set layout)
        size_t hash = 0;
        Utility::Hash::hash_combine(hash, pipeline_state.shader_vertex->GetId());
@@ -61,6 +69,9 @@ namespace Spartan
        // If there is no descriptor set layout for this particular hash, create one
        if (m_descriptor_set_layouts.find(hash) == m_descriptor_set_layouts.end())
        {
+           // Name this resource, very useful for Vulkan debugging
+           m_name = (pipeline_state.shader_vertex ? pipeline_state.shader_vertex->GetName() : "null") + "-" + (pipeline_state.shader_pixel ? pipeline_state.shader_pixel->GetName() : "null");
+
            // Generate descriptors from the reflected shaders
            vector<RHI_Descriptor> descriptors = GenerateDescriptors(pipeline_state);
 
@@ -84,6 +95,17 @@ namespace Spartan
         m_descriptor_layout_current->SetConstantBuffer(slot, constant_buffer);
     }
 
+    void RHI_DescriptorCache::SetConstantBuffer(const uint32_t slot, RHI_ConstantBuffer* constant_buffer, const uint32_t offset_index_dynamic)
+    {
+        if (!m_descriptor_layout_current)
+        {
+            LOG_ERROR("Invalid descriptor set layout");
+            return;
+        }
+
+        m_descriptor_layout_current->SetConstantBuffer(slot, constant_buffer, offset_index_dynamic);
+    }
+
     void RHI_DescriptorCache::SetSampler(const uint32_t slot, RHI_Sampler* sampler)
     {
         if (!m_descriptor_layout_current)
@@ -158,6 +180,108 @@ namespace Spartan
         }
     }
 
+    void RHI_DescriptorCache::SetBindlessDefault(const shared_ptr<RHI_Texture>& texture)
+    {
+        m_bindless_default = texture;
+
+        if (texture && texture->Get_View_Texture() && m_rhi_device->GetContextRhi()->bindless_textures)
+        {
+            UpdateBindless(0, texture.get());
+        }
+    }
+
+    uint32_t RHI_DescriptorCache::GetBindlessIndex(const shared_ptr<RHI_Texture>& texture)
+    {
+        if (!texture || !m_rhi_device->GetContextRhi()->bindless_textures)
+            return 0;
+
+        // Textures which are still loading use the default texture
+        void* view = texture->Get_View_Texture();
+        if (!view)
+            return 0;
+
+        auto it = m_bindless_slots.find(texture->GetId());
+        if (it != m_bindless_slots.end())
+        {
+            if (it->second.view == view)
+                return it->second.index;
+
+            // The texture re-created its view, frames in flight may still read the old slot, so move to a new one
+            RetireBindless(it->second.index);
+            m_bindless_slots.erase(it);
+        }
+
+        // Reuse a slot which was freed, or hand out a new one
+        uint32_t index = 0;
+        if (!m_bindless_free.empty())
+        {
+            index = m_bindless_free.back();
+            m_bindless_free.pop_back();
+        }
+        else if (m_bindless_count < RHI_Context::descriptor_max_bindless_textures)
+        {
+            index = m_bindless_count++;
+        }
+        else
+        {
+            if (!m_bindless_full_logged)
+            {
+                LOG_WARNING("Bindless texture capacity of %d has been exceeded, \"%s\" and any further textures will use the default texture", RHI_Context::descriptor_max_bindless_textures, texture->GetResourceName().c_str());
+                m_bindless_full_logged = true;
+            }
+
+            return 0;
+        }
+
+        UpdateBindless(index, texture.get());
+
+        BindlessSlot& slot  = m_bindless_slots[texture->GetId()];
+        slot.index          = index;
+        slot.view           = view;
+        slot.texture        = texture;
+
+        return index;
+    }
+
+    void RHI_DescriptorCache::TickBindless(const uint64_t frame_num)
+    {
+        m_bindless_frame_num = frame_num;
+
+        // Retire the slots of textures which were destroyed
+        for (auto it = m_bindless_slots.begin(); it != m_bindless_slots.end();)
+        {
+            if (it->second.texture.expired())
+            {
+                RetireBindless(it->second.index);
+                it = m_bindless_slots.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        // Free the retired slots which no frame in flight can be reading anymore
+        for (auto it = m_bindless_retired.begin(); it != m_bindless_retired.end();)
+        {
+            if (frame_num >= it->second)
+            {
+                m_bindless_free.emplace_back(it->first);
+                m_bindless_full_logged = false;
+                it = m_bindless_retired.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    void RHI_DescriptorCache::RetireBindless(const uint32_t index)
+    {
+        m_bindless_retired.emplace_back(index, m_bindless_frame_num + bindless_release_frames);
+    }
+
     uint32_t RHI_DescriptorCache::GetDescriptorSetCount() const
     {
         uint32_t descriptor_set_count = 0;
@@ -34,13 +34,15 @@ namespace Spartan
     class SPARTAN_CLASS RHI_DescriptorCache : public Spartan_Object
     {
     public:
-        RHI_DescriptorCache(const RHI_Device* rhi_device);
+        // Only the renderer's cache owns the bindless texture array, the caches of secondary command lists bind the same one
+        RHI_DescriptorCache(const RHI_Device* rhi_device, bool owns_bindless = true);
         ~RHI_DescriptorCache();
 
         void SetPipelineState(RHI_PipelineState& pipeline_state);
 
         // Descriptor resource updating
         void SetConstantBuffer(const uint32_t slot, RHI_ConstantBuffer* constant_buffer);
+        void SetConstantBuffer(const uint32_t slot, RHI_ConstantBuffer* constant_buffer, const uint32_t offset_index_dynamic);
         void SetSampler(const uint32_t slot, RHI_Sampler* sampler);
         void SetTexture(const uint32_t slot, RHI_Texture* texture);
 
@@ -54,10 +56,20 @@ namespace Spartan
         bool HasEnoughCapacity() const;
         void GrowIfNeeded();
 
+        // Bindless textures - Slot 0 holds the default texture, which is what a texture points to when the array is full
+        void SetBindlessDefault(const std::shared_ptr<RHI_Texture>& texture);
+        // Returns the slot of the texture in the global texture array (writing it there if needed)
+        uint32_t GetBindlessIndex(const std::shared_ptr<RHI_Texture>& texture);
+        // Frees the slots of destroyed textures, once the frames which could be reading them are done
+        void TickBindless(const uint64_t frame_num);
+
     private:
         uint32_t GetDescriptorSetCount() const;
         void SetDescriptorSetCapacity(uint32_t descriptor_capacity);
         bool CreateDescriptorPool(uint32_t descriptor_set_capacity);
+        bool CreateBindless();
+        void UpdateBindless(uint32_t index, RHI_Texture* texture);
+        void RetireBindless(const uint32_t index);
         std::vector<RHI_Descriptor> GenerateDescriptors(RHI_PipelineState& pipeline_state);
 
         // Descriptor set layouts 
@@ -68,6 +80,23 @@ namespace Spartan
         uint32_t m_descriptor_set_capacity = 16;
         void* m_descriptor_pool = nullptr;
 
+        // Bindless textures
+        struct BindlessSlot
+        {
+            uint32_t index = 0;                 // slot in the texture array
+            void* view     = nullptr;           // the view which was written there
+            std::weak_ptr<RHI_Texture> texture; // expires when the texture is destroyed
+        };
+        std::unordered_map<uint32_t, BindlessSlot> m_bindless_slots;            // texture id -> slot
+        std::vector<uint32_t> m_bindless_free;                                  // slots which can be written again
+        std::vector<std::pair<uint32_t, uint64_t>> m_bindless_retired;          // slot -> frame after which it can be written again
+        std::shared_ptr<RHI_Texture> m_bindless_default;
+        uint32_t m_bindless_count       = 1; // slots handed out so far, slot 0 is the default texture
+        uint64_t m_bindless_frame_num   = 0;
+        bool m_bindless_full_logged     = false;
+        void* m_bindless_pool           = nullptr;
+        bool m_owns_bindless            = true;
+
         // Dependencies
         const RHI_Device* m_rhi_device;
     };
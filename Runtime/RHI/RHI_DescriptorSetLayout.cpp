@@ -44,6 +44,13 @@ namespace Spartan
 
     void RHI_DescriptorSetLayout::SetConstantBuffer(const uint32_t slot, RHI_ConstantBuffer* constant_buffer)
     {
+        SetConstantBuffer(slot, constant_buffer, constant_buffer->GetOffsetIndexDynamic());
+    }
+
+    void RHI_DescriptorSetLayout::SetConstantBuffer(const uint32_t slot, RHI_ConstantBuffer* constant_buffer, const uint32_t offset_index_dynamic)
+    {
+        const uint32_t offset_dynamic = offset_index_dynamic * constant_buffer->GetStride();
+
         for (RHI_Descriptor& descriptor : m_descriptors)
         {
             const bool is_dynamic   = constant_buffer->IsDynamic();
@@ -57,7 +64,7 @@ namespace Spartan
                 m_needs_to_bind = descriptor.resource   != constant_buffer->GetResource()   ? true : m_needs_to_bind;                                                                                       // affects vkUpdateDescriptorSets
                 m_needs_to_bind = descriptor.offset     != constant_buffer->GetOffset()     ? true : m_needs_to_bind;                                                                                       // affects vkUpdateDescriptorSets
                 m_needs_to_bind = descriptor.range      != constant_buffer->GetStride()     ? true : m_needs_to_bind;                                                                                       // affects vkUpdateDescriptorSets
-                m_needs_to_bind = !m_constant_buffer_dynamic_offsets.empty() ? (m_constant_buffer_dynamic_offsets[0] != constant_buffer->GetOffsetDynamic() ? true : m_needs_to_bind) : m_needs_to_bind;    // affects vkCmdBindDescriptorSets 
+                m_needs_to_bind = !m_constant_buffer_dynamic_offsets.empty() ? (m_constant_buffer_dynamic_offsets[0] != offset_dynamic ? true : m_needs_to_bind) : m_needs_to_bind;    // affects vkCmdBindDescriptorSets 
 
                 // Update
                 descriptor.resource = constant_buffer->GetResource();
@@ -70,11 +77,11 @@ namespace Spartan
                 {
                     if (m_constant_buffer_dynamic_offsets.empty())
                     {
-                        m_constant_buffer_dynamic_offsets.emplace_back(constant_buffer->GetOffsetDynamic());
+                        m_constant_buffer_dynamic_offsets.emplace_back(offset_dynamic);
                     }
                     else
                     {
-                        m_constant_buffer_dynamic_offsets[0] = constant_buffer->GetOffsetDynamic();
+                        m_constant_buffer_dynamic_offsets[0] = offset_dynamic;
                     }
                 }
 
@@ -38,6 +38,7 @@ namespace Spartan
         ~RHI_DescriptorSetLayout();
 
         void SetConstantBuffer(const uint32_t slot, RHI_ConstantBuffer* constant_buffer);
+        void SetConstantBuffer(const uint32_t slot, RHI_ConstantBuffer* constant_buffer, const uint32_t offset_index_dynamic);
         void SetSampler(const uint32_t slot, RHI_Sampler* sampler);
         void SetTexture(const uint32_t slot, RHI_Texture* texture);
 
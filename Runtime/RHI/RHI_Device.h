@@ -181,6 +181,10 @@ namespace Spartan
         Context* GetContext()               const { return m_context; }
         uint32_t GetEnabledGraphicsStages() const { return m_enabled_graphics_shader_stages; }
 
+        // Shader cache (optional, shaders compile from source without one)
+        void SetShaderCache(const std::shared_ptr<RHI_ShaderCache>& shader_cache)  { m_shader_cache = shader_cache; }
+        RHI_ShaderCache* GetShaderCache()   const { return m_shader_cache.get(); }
+
 	private:	
 		std::vector<PhysicalDevice> m_physical_devices;
         std::vector<DisplayMode> m_display_modes;
@@ -190,5 +194,6 @@ namespace Spartan
         bool m_initialized                          = false;
         mutable std::mutex m_queue_mutex;
         std::shared_ptr<RHI_Context> m_rhi_context;
+        std::shared_ptr<RHI_ShaderCache> m_shader_cache;
 	};
 }
@@ -73,6 +73,7 @@ static const DXGI_FORMAT d3d11_format[] =
 	DXGI_FORMAT_R32G32B32_FLOAT,
     // RGBA
 	DXGI_FORMAT_R8G8B8A8_UNORM,
+	DXGI_FORMAT_R8G8B8A8_UINT,
     DXGI_FORMAT_R10G10B10A2_UNORM,
 	DXGI_FORMAT_R16G16B16A16_FLOAT,
 	DXGI_FORMAT_R32G32B32A32_FLOAT,
@@ -192,6 +193,7 @@ static const VkFormat vulkan_format[] =
 	VK_FORMAT_R32G32B32_SFLOAT,
     // RGBA
 	VK_FORMAT_R8G8B8A8_UNORM,
+	VK_FORMAT_R8G8B8A8_UINT,
     VK_FORMAT_A2R10G10B10_UNORM_PACK32,
 	VK_FORMAT_R16G16B16A16_SFLOAT,
 	VK_FORMAT_R32G32B32A32_SFLOAT,
@@ -305,6 +307,8 @@ static const VkImageLayout vulkan_image_layout[] =
     #include <stdint.h>
 #elif defined (API_GRAPHICS_VULKAN)
     #include <vector>
+#elif defined (API_GRAPHICS_NULL)
+    #include <stdint.h>
 #endif
 
 // RHI CONTEXT - All
@@ -326,6 +330,11 @@ namespace Spartan
             VkPhysicalDeviceFeatures device_features        = {};
             VkFormat surface_format                         = VK_FORMAT_UNDEFINED;
             VkColorSpaceKHR surface_color_space             = VK_COLOR_SPACE_MAX_ENUM_KHR;
+            VkPipelineCache pipeline_cache                  = nullptr;
+
+            // Bindless textures, owned by the descriptor cache (pipeline layouts include them as the second set)
+            VkDescriptorSetLayout bindless_descriptor_set_layout    = nullptr;
+            VkDescriptorSet bindless_descriptor_set                 = nullptr;
 
             // Extensions
             #ifdef DEBUG
@@ -345,11 +354,11 @@ namespace Spartan
                 Identify specific sections within a VkQueue or VkCommandBuffer using labels to aid organization and offline analysis in external tools.
 
                 */
-                std::vector<const char*> extensions_device      = { VK_KHR_SWAPCHAIN_EXTENSION_NAME, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME };
+                std::vector<const char*> extensions_device      = { VK_KHR_SWAPCHAIN_EXTENSION_NAME, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME };
                 std::vector<const char*> validation_layers      = { "VK_LAYER_KHRONOS_validation" };
                 std::vector<const char*> extensions_instance    = { VK_KHR_SURFACE_EXTENSION_NAME, VK_KHR_WIN32_SURFACE_EXTENSION_NAME, VK_EXT_DEBUG_REPORT_EXTENSION_NAME, VK_EXT_DEBUG_UTILS_EXTENSION_NAME };
             #else
-                std::vector<const char*> extensions_device      = { VK_KHR_SWAPCHAIN_EXTENSION_NAME, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME };
+                std::vector<const char*> extensions_device      = { VK_KHR_SWAPCHAIN_EXTENSION_NAME, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME };
                 std::vector<const char*> validation_layers      = { };
                 std::vector<const char*> extensions_instance    = { VK_KHR_SURFACE_EXTENSION_NAME, VK_KHR_WIN32_SURFACE_EXTENSION_NAME };
             #endif
@@ -377,6 +386,11 @@ namespace Spartan
         static const uint32_t descriptor_max_constant_buffers_dynamic   = 10;
         static const uint32_t descriptor_max_samplers                   = 10;
         static const uint32_t descriptor_max_textures                   = 10;
+        static const uint32_t descriptor_max_bindless_textures          = 4096; // material textures, indexed by shaders instead of bound
+
+        // Features
+        bool bindless_textures  = false; // a global (partially bound) texture array, requires descriptor indexing
+        bool parallel_recording = false; // passes can be split into secondary command lists which are recorded by several threads
 
         // Device limits
         uint32_t max_texture_dimension_2d   = 16384;
@@ -397,6 +411,8 @@ namespace Spartan
     #include "D3D11/D3D11_Common.h"
 #elif defined (API_GRAPHICS_VULKAN)
     #include "Vulkan/Vulkan_Common.h"
+#elif defined (API_GRAPHICS_NULL)
+    #include "Null/Null_Common.h"
 #endif
 
 #endif // RUNTIME
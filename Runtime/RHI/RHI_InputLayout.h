@@ -117,6 +117,19 @@ namespace Spartan
 				};
 			}
 
+			if (vertex_type == RHI_Vertex_Type_PositionTextureNormalTangentBone)
+			{
+				m_vertex_attributes =
+				{
+					{ "POSITION",		0, binding, RHI_Format_R32G32B32_Float,	offsetof(RHI_Vertex_PosTexNorTanBone, pos) },
+					{ "TEXCOORD",		1, binding, RHI_Format_R32G32_Float,	offsetof(RHI_Vertex_PosTexNorTanBone, tex) },
+					{ "NORMAL",			2, binding, RHI_Format_R32G32B32_Float,	offsetof(RHI_Vertex_PosTexNorTanBone, nor) },
+					{ "TANGENT",		3, binding, RHI_Format_R32G32B32_Float,	offsetof(RHI_Vertex_PosTexNorTanBone, tan) },
+					{ "BLENDINDICES",	4, binding, RHI_Format_R8G8B8A8_Uint,	offsetof(RHI_Vertex_PosTexNorTanBone, bone_index) },
+					{ "BLENDWEIGHT",	5, binding, RHI_Format_R8G8B8A8_Unorm,	offsetof(RHI_Vertex_PosTexNorTanBone, bone_weight) }
+				};
+			}
+
 			if (vertex_shader_blob && !m_vertex_attributes.empty())
 			{
 				return _CreateResource(vertex_shader_blob);
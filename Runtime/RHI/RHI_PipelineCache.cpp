@@ -19,13 +19,25 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
-//= INCLUDES ===================
+//= INCLUDES ===========================
 #include "RHI_PipelineCache.h"
+#include "RHI_Device.h"
+#include "RHI_Shader.h"
 #include "RHI_Texture.h"
 #include "RHI_Pipeline.h"
 #include "RHI_SwapChain.h"
+#include "RHI_BlendState.h"
+#include "RHI_RasterizerState.h"
+#include "RHI_DepthStencilState.h"
 #include "RHI_DescriptorCache.h"
-//==============================
+#include "../Math/MathHelper.h"
+#include "../Core/Context.h"
+#include "../Core/Stopwatch.h"
+#include "../Core/FileSystem.h"
+#include "../IO/FileStream.h"
+#include "../Profiling/Profiler.h"
+#include <unordered_set>
+//======================================
 
 //= NAMESPACES =====
 using namespace std;
@@ -33,6 +45,72 @@ using namespace std;
 
 namespace Spartan
 {
+    // Bump when RHI_PipelineStateDesc changes
+    static const uint32_t pipeline_cache_version = 2;
+    // Time that Prewarm() can spend creating pipelines, per call
+    static const double prewarm_budget_ms = 2.0;
+    // Descriptions which stay unresolved for this many runs are not saved again (e.g. their shader variation is gone)
+    static const uint32_t desc_age_max = 4;
+
+    static bool desc_references(const RHI_PipelineStateDesc& desc, const string& name)
+    {
+        if (desc.shader_vertex == name || desc.shader_pixel == name || desc.rasterizer_state == name || desc.blend_state == name ||
+            desc.depth_stencil_state == name || desc.render_target_swapchain == name || desc.render_target_depth_texture == name)
+            return true;
+
+        for (const string& texture : desc.render_target_color_textures)
+        {
+            if (texture == name)
+                return true;
+        }
+
+        return false;
+    }
+
+    // Identifies a description, used to not save the same one twice
+    static string desc_key(const RHI_PipelineStateDesc& desc)
+    {
+        string key = desc.shader_vertex + "|" + desc.shader_pixel + "|" + desc.rasterizer_state + "|" + desc.blend_state + "|" + desc.depth_stencil_state + "|" +
+            desc.render_target_swapchain + "|" + desc.render_target_depth_texture + "|";
+
+        for (const string& texture : desc.render_target_color_textures)
+        {
+            key += texture + "|";
+        }
+
+        for (const float value : { desc.viewport.x, desc.viewport.y, desc.viewport.width, desc.viewport.height, desc.viewport.depth_min, desc.viewport.depth_max,
+                                   desc.scissor.left, desc.scissor.top, desc.scissor.right, desc.scissor.bottom })
+        {
+            key += to_string(value) + "|";
+        }
+
+        for (const uint32_t value : { desc.render_target_color_texture_array_index, desc.render_target_depth_stencil_texture_array_index,
+                                      static_cast<uint32_t>(desc.render_target_depth_texture_read_only), desc.primitive_topology, desc.vertex_buffer_stride,
+                                      static_cast<uint32_t>(desc.dynamic_scissor), desc.width, desc.height })
+        {
+            key += to_string(value) + "|";
+        }
+
+        return key;
+    }
+
+    RHI_PipelineCache::RHI_PipelineCache(const RHI_Device* rhi_device)
+    {
+        m_rhi_device = rhi_device;
+
+        if (Context* context = rhi_device->GetContext())
+        {
+            m_profiler = context->GetSubsystem<Profiler>();
+        }
+    }
+
+    RHI_PipelineCache::~RHI_PipelineCache()
+    {
+        m_cache.clear();
+        m_cache_count = 0;
+        DestroyDriverCache();
+    }
+
     RHI_Pipeline* RHI_PipelineCache::GetPipeline(RHI_CommandList* cmd_list, RHI_PipelineState& pipeline_state, void* descriptor_set_layout)
     {
         // Validate it
@@ -42,7 +120,7 @@ namespace Spartan
             return nullptr;
         }
 
-        // Render target layout transitions
+        // Render target layout transitions (the render graph already did them for the transient render targets, this covers the rest)
         {
             // Color
             for (auto i = 0; i < state_max_render_target_count; i++)
@@ -68,15 +146,486 @@ namespace Spartan
 
         // Compute a hash for it
         pipeline_state.ComputeHash();
-        size_t hash = pipeline_state.GetHash();
+        const uint64_t hash = pipeline_state.GetHash();
+
+        if (RHI_Pipeline* pipeline = Find(pipeline_state.GetKey(), hash))
+        {
+            if (m_profiler)
+            {
+                m_profiler->m_rhi_pipeline_cache_hits++;
+            }
+
+            return pipeline;
+        }
 
         // If no pipeline exists for this state, create one
-        if (m_cache.find(hash) == m_cache.end())
+        Stopwatch timer;
+        shared_ptr<RHI_Pipeline> pipeline = make_shared<RHI_Pipeline>(m_rhi_device, pipeline_state, descriptor_set_layout);
+
+        if (m_profiler)
+        {
+            m_profiler->m_rhi_pipeline_cache_misses++;
+            m_profiler->m_rhi_pipeline_creation_ms += timer.GetElapsedTimeMs();
+        }
+
+        // Cache it
+        Insert(pipeline);
+        return pipeline.get();
+    }
+
+    void RHI_PipelineCache::RegisterObject(const Spartan_Object* object, const string& name)
+    {
+        if (!object || name.empty())
+        {
+            LOG_ERROR_INVALID_PARAMETER();
+            return;
+        }
+
+        // Objects get re-created (e.g. render targets on resolution changes), forget the previous one
+        auto it = m_objects.find(name);
+        if (it != m_objects.end())
+        {
+            m_object_names.erase(it->second);
+        }
+
+        // An object goes by a single name (e.g. pool textures take the name of the latest render target they were assigned to)
+        auto it_name = m_object_names.find(object);
+        if (it_name != m_object_names.end() && it_name->second != name)
+        {
+            m_objects.erase(it_name->second);
+        }
+
+        m_objects[name]         = object;
+        m_object_names[object]  = name;
+
+        // Give descriptions which were waiting on this object another attempt
+        for (auto it = m_descs_unregistered.begin(); it != m_descs_unregistered.end();)
+        {
+            if (desc_references(*it, name))
+            {
+                m_descs_pending.emplace_back(*it);
+                it = m_descs_unregistered.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    void RHI_PipelineCache::Evict(const Spartan_Object* object)
+    {
+        if (!object)
+            return;
+
+        // Forget the name, unless it has been given to a newer object already
+        auto it = m_object_names.find(object);
+        if (it != m_object_names.end())
+        {
+            auto it_object = m_objects.find(it->second);
+            if (it_object != m_objects.end() && it_object->second == object)
+            {
+                m_objects.erase(it_object);
+            }
+            m_object_names.erase(it);
+        }
+
+        const auto references = [object](const RHI_PipelineState& state)
+        {
+            for (const Spartan_Object* state_object : { static_cast<const Spartan_Object*>(state.shader_vertex), static_cast<const Spartan_Object*>(state.shader_pixel),
+                                                        static_cast<const Spartan_Object*>(state.rasterizer_state), static_cast<const Spartan_Object*>(state.blend_state),
+                                                        static_cast<const Spartan_Object*>(state.depth_stencil_state), static_cast<const Spartan_Object*>(state.render_target_swapchain),
+                                                        static_cast<const Spartan_Object*>(state.render_target_depth_texture) })
+            {
+                if (state_object == object)
+                    return true;
+            }
+
+            for (const RHI_Texture* texture : state.render_target_color_textures)
+            {
+                if (static_cast<const Spartan_Object*>(texture) == object)
+                    return true;
+            }
+
+            return false;
+        };
+
+        // Re-insert the pipelines which survive, removing slots in place would break the probe sequences
+        vector<Slot> slots;
+        slots.swap(m_cache);
+        m_cache.resize(slots.size());
+        m_cache_count = 0;
+        for (Slot& slot : slots)
+        {
+            if (slot.pipeline && !references(*slot.pipeline->GetPipelineState()))
+            {
+                Insert(slot.pipeline);
+            }
+        }
+    }
+
+    bool RHI_PipelineCache::Save(const string& file_path)
+    {
+        vector<RHI_PipelineStateDesc> descs;
+        unordered_set<string> keys;
+        descs.reserve(m_cache_count + m_descs_pending.size() + m_descs_unregistered.size());
+
+        for (const Slot& slot : m_cache)
+        {
+            if (!slot.pipeline)
+                continue;
+
+            // Pipelines which point to unregistered objects (e.g. shadow maps), can't be saved
+            RHI_PipelineStateDesc desc;
+            if (ToDesc(*slot.pipeline->GetPipelineState(), desc) && keys.emplace(desc_key(desc)).second)
+            {
+                descs.emplace_back(desc);
+            }
+        }
+
+        // Loaded descriptions which weren't created in this run (e.g. a material which wasn't loaded) are kept for the next one
+        for (const vector<RHI_PipelineStateDesc>* descs_loaded : { &m_descs_pending, &m_descs_unregistered })
+        {
+            for (const RHI_PipelineStateDesc& desc : *descs_loaded)
+            {
+                if (desc.age + 1 < desc_age_max && keys.emplace(desc_key(desc)).second)
+                {
+                    descs.emplace_back(desc);
+                    descs.back().age++;
+                }
+            }
+        }
+
+        auto file = make_unique<FileStream>(file_path, FileStream_Write);
+        if (!file->IsOpen())
+        {
+            LOG_ERROR("Failed to open \"%s\" for writing", file_path.c_str());
+            return false;
+        }
+
+        file->Write(pipeline_cache_version);
+        file->Write(static_cast<uint32_t>(descs.size()));
+        for (const RHI_PipelineStateDesc& desc : descs)
         {
-            // Cache a new pipeline
-            m_cache.emplace(make_pair(hash, move(make_shared<RHI_Pipeline>(m_rhi_device, pipeline_state, descriptor_set_layout))));
+            file->Write(desc.shader_vertex);
+            file->Write(desc.shader_pixel);
+            file->Write(desc.rasterizer_state);
+            file->Write(desc.blend_state);
+            file->Write(desc.depth_stencil_state);
+            file->Write(desc.render_target_swapchain);
+            file->Write(desc.render_target_depth_texture);
+            for (uint32_t i = 0; i < state_max_render_target_count; i++)
+            {
+                file->Write(desc.render_target_color_textures[i]);
+            }
+            file->Write(desc.render_target_color_texture_array_index);
+            file->Write(desc.render_target_depth_stencil_texture_array_index);
+            file->Write(desc.render_target_depth_texture_read_only);
+            file->Write(desc.primitive_topology);
+            file->Write(desc.vertex_buffer_stride);
+            file->Write(desc.dynamic_scissor);
+            file->Write(Math::Vector4(desc.viewport.x, desc.viewport.y, desc.viewport.width, desc.viewport.height));
+            file->Write(Math::Vector2(desc.viewport.depth_min, desc.viewport.depth_max));
+            file->Write(Math::Vector4(desc.scissor.left, desc.scissor.top, desc.scissor.right, desc.scissor.bottom));
+            file->Write(desc.width);
+            file->Write(desc.height);
+            file->Write(desc.age);
+        }
+
+        // Driver cache
+        vector<std::byte> driver_cache;
+        GetDriverCacheData(driver_cache);
+        file->Write(driver_cache);
+
+        LOG_INFO("Saved %d pipeline states and %d bytes of driver cache", static_cast<uint32_t>(descs.size()), static_cast<uint32_t>(driver_cache.size()));
+        return true;
+    }
+
+    bool RHI_PipelineCache::Load(const string& file_path)
+    {
+        vector<std::byte> driver_cache;
+
+        if (FileSystem::Exists(file_path))
+        {
+            auto file = make_unique<FileStream>(file_path, FileStream_Read);
+            if (!file->IsOpen())
+                return false;
+
+            // Discard caches written by a different version
+            uint32_t version = 0;
+            file->Read(&version);
+            if (version == pipeline_cache_version)
+            {
+                const uint32_t desc_count = file->ReadAs<uint32_t>();
+                m_descs_pending.resize(desc_count);
+                for (RHI_PipelineStateDesc& desc : m_descs_pending)
+                {
+                    Math::Vector4 viewport;
+                    Math::Vector2 depth;
+                    Math::Vector4 scissor;
+
+                    file->Read(&desc.shader_vertex);
+                    file->Read(&desc.shader_pixel);
+                    file->Read(&desc.rasterizer_state);
+                    file->Read(&desc.blend_state);
+                    file->Read(&desc.depth_stencil_state);
+                    file->Read(&desc.render_target_swapchain);
+                    file->Read(&desc.render_target_depth_texture);
+                    for (uint32_t i = 0; i < state_max_render_target_count; i++)
+                    {
+                        file->Read(&desc.render_target_color_textures[i]);
+                    }
+                    file->Read(&desc.render_target_color_texture_array_index);
+                    file->Read(&desc.render_target_depth_stencil_texture_array_index);
+                    file->Read(&desc.render_target_depth_texture_read_only);
+                    file->Read(&desc.primitive_topology);
+                    file->Read(&desc.vertex_buffer_stride);
+                    file->Read(&desc.dynamic_scissor);
+                    file->Read(&viewport);
+                    file->Read(&depth);
+                    file->Read(&scissor);
+                    file->Read(&desc.width);
+                    file->Read(&desc.height);
+                    file->Read(&desc.age);
+
+                    desc.viewport   = RHI_Viewport(viewport.x, viewport.y, viewport.z, viewport.w, depth.x, depth.y);
+                    desc.scissor    = Math::Rectangle(scissor.x, scissor.y, scissor.z, scissor.w);
+                }
+
+                file->Read(&driver_cache);
+            }
+            else
+            {
+                LOG_WARNING("\"%s\" was written by a different version, ignoring it", file_path.c_str());
+            }
+        }
+
+        // The driver cache has to exist before any pipeline gets created, even if it starts empty
+        if (!CreateDriverCache(driver_cache))
+            return false;
+
+        if (!m_descs_pending.empty())
+        {
+            LOG_INFO("Loaded %d pipeline states", static_cast<uint32_t>(m_descs_pending.size()));
+        }
+
+        return true;
+    }
+
+    void RHI_PipelineCache::Prewarm(RHI_DescriptorCache* descriptor_cache)
+    {
+        if (m_profiler)
+        {
+            m_profiler->m_rhi_pipeline_cache_prewarming = static_cast<uint32_t>(m_descs_pending.size());
+        }
+
+        if (m_descs_pending.empty() || !descriptor_cache)
+            return;
+
+        // Pipelines are created here, on the render thread, as pipeline creation (and the descriptor cache) is not thread safe.
+        // The time budget spreads the work across frames.
+        Stopwatch timer;
+        for (auto it = m_descs_pending.begin(); it != m_descs_pending.end() && timer.GetElapsedTimeMs() < prewarm_budget_ms;)
+        {
+            RHI_PipelineState pipeline_state;
+            const Desc_State state = FromDesc(*it, pipeline_state);
+
+            // Try again next frame
+            if (state == Desc_Compiling)
+            {
+                ++it;
+                continue;
+            }
+
+            // Set aside until one of its objects is registered (see RegisterObject())
+            if (state == Desc_Unregistered)
+            {
+                m_descs_unregistered.emplace_back(*it);
+                it = m_descs_pending.erase(it);
+                continue;
+            }
+
+            const bool is_ready = state == Desc_Ready;
+            it = m_descs_pending.erase(it);
+            if (!is_ready)
+                continue;
+
+            pipeline_state.ComputeHash();
+            if (Find(pipeline_state.GetKey(), pipeline_state.GetHash()))
+                continue;
+
+            descriptor_cache->SetPipelineState(pipeline_state);
+            Insert(make_shared<RHI_Pipeline>(m_rhi_device, pipeline_state, descriptor_cache->GetResource_DescriptorSetLayout()));
+        }
+    }
+
+    RHI_Pipeline* RHI_PipelineCache::Find(const RHI_PipelineKey& key, const uint64_t hash) const
+    {
+        if (m_cache.empty())
+            return nullptr;
+
+        // Linear probing, a matching hash is not enough, the keys have to match too
+        const uint64_t mask = m_cache.size() - 1;
+        for (uint64_t i = hash & mask; m_cache[i].pipeline; i = (i + 1) & mask)
+        {
+            const Slot& slot = m_cache[i];
+            if (slot.hash == hash && slot.pipeline->GetPipelineState()->GetKey() == key)
+                return slot.pipeline.get();
         }
 
-        return m_cache[hash].get();
+        return nullptr;
+    }
+
+    void RHI_PipelineCache::Insert(const shared_ptr<RHI_Pipeline>& pipeline)
+    {
+        // Keep the load factor under 50%, so that probe sequences stay short
+        if ((m_cache_count + 1) * 2 > m_cache.size())
+        {
+            vector<Slot> slots(Math::Helper::Max<size_t>(m_cache.size() * 2, 256));
+            swap(slots, m_cache);
+            m_cache_count = 0;
+
+            for (Slot& slot : slots)
+            {
+                if (slot.pipeline)
+                {
+                    Insert(slot.pipeline);
+                }
+            }
+        }
+
+        const RHI_PipelineState* state  = pipeline->GetPipelineState();
+        const uint64_t mask             = m_cache.size() - 1;
+        uint64_t i                      = state->GetHash() & mask;
+        while (m_cache[i].pipeline)
+        {
+            // Replace an existing pipeline with an identical key
+            if (m_cache[i].hash == state->GetHash() && m_cache[i].pipeline->GetPipelineState()->GetKey() == state->GetKey())
+            {
+                m_cache[i].pipeline = pipeline;
+                return;
+            }
+
+            i = (i + 1) & mask;
+        }
+
+        m_cache[i].hash     = state->GetHash();
+        m_cache[i].pipeline = pipeline;
+        m_cache_count++;
+    }
+
+    bool RHI_PipelineCache::ToDesc(RHI_PipelineState& pipeline_state, RHI_PipelineStateDesc& desc)
+    {
+        // Returns false if the object is not registered, an empty name stands for no object
+        const auto get_name = [this](const Spartan_Object* object, string& name)
+        {
+            if (!object)
+                return true;
+
+            auto it = m_object_names.find(object);
+            if (it == m_object_names.end())
+                return false;
+
+            name = it->second;
+            return true;
+        };
+
+        bool is_registered = true;
+        is_registered = is_registered && get_name(pipeline_state.shader_vertex,                 desc.shader_vertex);
+        is_registered = is_registered && get_name(pipeline_state.shader_pixel,                  desc.shader_pixel);
+        is_registered = is_registered && get_name(pipeline_state.rasterizer_state,              desc.rasterizer_state);
+        is_registered = is_registered && get_name(pipeline_state.blend_state,                   desc.blend_state);
+        is_registered = is_registered && get_name(pipeline_state.depth_stencil_state,           desc.depth_stencil_state);
+        is_registered = is_registered && get_name(pipeline_state.render_target_swapchain,       desc.render_target_swapchain);
+        is_registered = is_registered && get_name(pipeline_state.render_target_depth_texture,   desc.render_target_depth_texture);
+        for (uint32_t i = 0; i < state_max_render_target_count; i++)
+        {
+            is_registered = is_registered && get_name(pipeline_state.render_target_color_textures[i], desc.render_target_color_textures[i]);
+        }
+
+        if (!is_registered)
+            return false;
+
+        desc.render_target_color_texture_array_index            = pipeline_state.render_target_color_texture_array_index;
+        desc.render_target_depth_stencil_texture_array_index    = pipeline_state.render_target_depth_stencil_texture_array_index;
+        desc.render_target_depth_texture_read_only              = pipeline_state.render_target_depth_texture_read_only;
+        desc.primitive_topology                                 = static_cast<uint32_t>(pipeline_state.primitive_topology);
+        desc.vertex_buffer_stride                               = pipeline_state.vertex_buffer_stride;
+        desc.dynamic_scissor                                    = pipeline_state.dynamic_scissor;
+        desc.viewport                                           = pipeline_state.viewport;
+        desc.scissor                                            = pipeline_state.scissor;
+        desc.width                                              = pipeline_state.GetWidth();
+        desc.height                                             = pipeline_state.GetHeight();
+
+        return true;
+    }
+
+    RHI_PipelineCache::Desc_State RHI_PipelineCache::FromDesc(const RHI_PipelineStateDesc& desc, RHI_PipelineState& pipeline_state)
+    {
+        // Flags any named object which is not registered
+        bool is_registered = true;
+        const auto resolve = [this, &is_registered](const string& name, auto*& object)
+        {
+            if (name.empty())
+                return;
+
+            object = GetObject<typename remove_reference<decltype(*object)>::type>(name);
+            is_registered = is_registered && object != nullptr;
+        };
+
+        resolve(desc.shader_vertex,                 pipeline_state.shader_vertex);
+        resolve(desc.shader_pixel,                  pipeline_state.shader_pixel);
+        resolve(desc.rasterizer_state,              pipeline_state.rasterizer_state);
+        resolve(desc.blend_state,                   pipeline_state.blend_state);
+        resolve(desc.depth_stencil_state,           pipeline_state.depth_stencil_state);
+        resolve(desc.render_target_swapchain,       pipeline_state.render_target_swapchain);
+        resolve(desc.render_target_depth_texture,   pipeline_state.render_target_depth_texture);
+        for (uint32_t i = 0; i < state_max_render_target_count; i++)
+        {
+            resolve(desc.render_target_color_textures[i], pipeline_state.render_target_color_textures[i]);
+        }
+
+        // Shader variations are registered once materials request them, so the description might resolve later
+        if (!is_registered)
+            return Desc_Unregistered;
+
+        pipeline_state.render_target_color_texture_array_index         = desc.render_target_color_texture_array_index;
+        pipeline_state.render_target_depth_stencil_texture_array_index  = desc.render_target_depth_stencil_texture_array_index;
+        pipeline_state.render_target_depth_texture_read_only            = desc.render_target_depth_texture_read_only;
+        pipeline_state.primitive_topology                               = static_cast<RHI_PrimitiveTopology_Mode>(desc.primitive_topology);
+        pipeline_state.vertex_buffer_stride                             = desc.vertex_buffer_stride;
+        pipeline_state.dynamic_scissor                                  = desc.dynamic_scissor;
+        pipeline_state.viewport                                         = desc.viewport;
+        pipeline_state.scissor                                          = desc.scissor;
+
+        // A different resolution means different render targets, the pipeline would never be used
+        if (pipeline_state.GetWidth() != desc.width || pipeline_state.GetHeight() != desc.height)
+            return Desc_Invalid;
+
+        // Wait for the shaders to compile, drop the description if they failed
+        bool is_compiled = true;
+        for (const RHI_Shader* shader : { pipeline_state.shader_vertex, pipeline_state.shader_pixel })
+        {
+            if (!shader)
+                continue;
+
+            if (shader->GetCompilationState() == Shader_Compilation_Failed)
+                return Desc_Invalid;
+
+            is_compiled = is_compiled && shader->IsCompiled();
+        }
+
+        if (!is_compiled)
+            return Desc_Compiling;
+
+        // Let IsValid() log anything that the description got wrong
+        return pipeline_state.IsValid() ? Desc_Ready : Desc_Invalid;
+    }
+
+    template<typename T>
+    T* RHI_PipelineCache::GetObject(const string& name)
+    {
+        auto it = m_objects.find(name);
+        return it != m_objects.end() ? const_cast<T*>(static_cast<const T*>(it->second)) : nullptr;
     }
 }
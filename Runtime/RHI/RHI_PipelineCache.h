@@ -23,24 +23,106 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ======================
 #include <memory>
+#include <vector>
+#include <string>
 #include <unordered_map>
 #include "RHI_Definition.h"
+#include "RHI_Viewport.h"
+#include "RHI_PipelineState.h"
+#include "../Math/Rectangle.h"
 #include "../Core/Spartan_Object.h"
 //=================================
 
 namespace Spartan
 {
+    class Profiler;
+
+    // A pipeline state which can outlive the run that created it, objects are referenced by their registered names
+    struct RHI_PipelineStateDesc
+    {
+        std::string shader_vertex;
+        std::string shader_pixel;
+        std::string rasterizer_state;
+        std::string blend_state;
+        std::string depth_stencil_state;
+        std::string render_target_swapchain;
+        std::string render_target_depth_texture;
+        std::string render_target_color_textures[state_max_render_target_count];
+        uint32_t render_target_color_texture_array_index            = 0;
+        uint32_t render_target_depth_stencil_texture_array_index    = 0;
+        bool render_target_depth_texture_read_only                  = false;
+        uint32_t primitive_topology                                 = 0;
+        uint32_t vertex_buffer_stride                               = 0;
+        bool dynamic_scissor                                        = false;
+        RHI_Viewport viewport                                       = RHI_Viewport::Undefined;
+        Math::Rectangle scissor                                     = Math::Rectangle::Zero;
+        uint32_t width                                              = 0;
+        uint32_t height                                             = 0;
+        uint32_t age                                                = 0; // runs in a row that the description couldn't be resolved
+    };
+
+    // Pipelines are only created and looked up by the render thread, so the cache does no locking
 	class RHI_PipelineCache : public Spartan_Object
 	{
 	public:
-        RHI_PipelineCache(const RHI_Device* rhi_device) { m_rhi_device = rhi_device; }
+        RHI_PipelineCache(const RHI_Device* rhi_device);
+        ~RHI_PipelineCache();
+
         RHI_Pipeline* GetPipeline(RHI_CommandList* cmd_list, RHI_PipelineState& pipeline_state, void* descriptor_set_layout);
 
+        // Objects which pipeline states point to have to be registered under a stable name for their pipelines to be saved
+        void RegisterObject(const Spartan_Object* object, const std::string& name);
+        // Destroys the pipelines which point to an object and forgets its name, for objects which are about to be destroyed.
+        // It's up to the caller to make sure that no frame in flight still uses those pipelines.
+        void Evict(const Spartan_Object* object);
+
+        // Saves the descriptions of all created pipelines (and of loaded ones which weren't created yet), along with the driver's cache (if the backend has one)
+        bool Save(const std::string& file_path);
+        // Loads descriptions which are then recreated by Prewarm()
+        bool Load(const std::string& file_path);
+        // Creates pipelines for loaded descriptions whose objects are registered and whose shaders have compiled, for up to prewarm_budget_ms per call.
+        // Descriptions which reference unregistered objects are set aside after one attempt, until one of their objects gets registered.
+        void Prewarm(RHI_DescriptorCache* descriptor_cache);
+        bool IsPrewarming() const { return !m_descs_pending.empty(); }
+
 	private:
-        // <hash of pipeline state, pipeline state object>
-        std::unordered_map<std::size_t, std::shared_ptr<RHI_Pipeline>> m_cache;
+        enum Desc_State
+        {
+            Desc_Ready,         // can be created
+            Desc_Compiling,     // shaders are still compiling
+            Desc_Unregistered,  // an object is not registered (yet)
+            Desc_Invalid        // can never be created
+        };
+
+        bool ToDesc(RHI_PipelineState& pipeline_state, RHI_PipelineStateDesc& desc);
+        Desc_State FromDesc(const RHI_PipelineStateDesc& desc, RHI_PipelineState& pipeline_state);
+        template<typename T> T* GetObject(const std::string& name);
+
+        // Driver cache (backend specific)
+        bool CreateDriverCache(const std::vector<std::byte>& data);
+        void GetDriverCacheData(std::vector<std::byte>& data) const;
+        void DestroyDriverCache();
+
+        // Open addressing table (power of two sized), slots without a pipeline are empty
+        struct Slot
+        {
+            uint64_t hash = 0;
+            std::shared_ptr<RHI_Pipeline> pipeline;
+        };
+        RHI_Pipeline* Find(const RHI_PipelineKey& key, uint64_t hash) const;
+        void Insert(const std::shared_ptr<RHI_Pipeline>& pipeline);
+        std::vector<Slot> m_cache;
+        uint32_t m_cache_count = 0;
+
+        // Persistence
+        std::unordered_map<std::string, const Spartan_Object*> m_objects;
+        std::unordered_map<const Spartan_Object*, std::string> m_object_names;
+        std::vector<RHI_PipelineStateDesc> m_descs_pending;
+        std::vector<RHI_PipelineStateDesc> m_descs_unregistered;
+        void* m_driver_cache = nullptr;
 
         // Dependencies
-        const RHI_Device* m_rhi_device;
+        const RHI_Device* m_rhi_device  = nullptr;
+        Profiler* m_profiler            = nullptr;
 	};
 }
@@ -65,7 +65,8 @@ namespace Spartan
                 is_valid = false;
             }
 
-            if (!rasterizer_state || !blend_state || !depth_stencil_state || primitive_topology == RHI_PrimitiveTopology_Unknown || (!render_target_swapchain && !render_target_color_textures[0]))
+            // Depth only passes (e.g. the depth pre-pass and the shadow caches) have no color render target
+            if (!rasterizer_state || !blend_state || !depth_stencil_state || primitive_topology == RHI_PrimitiveTopology_Unknown || (!render_target_swapchain && !render_target_color_textures[0] && !render_target_depth_texture))
             {
                 is_valid = false;
             }
@@ -101,6 +102,9 @@ namespace Spartan
         if (render_target_color_textures[0])
             return render_target_color_textures[0]->GetWidth();
 
+        if (render_target_depth_texture)
+            return render_target_depth_texture->GetWidth();
+
         return 0;
 	}
 
@@ -112,6 +116,9 @@ namespace Spartan
         if (render_target_color_textures[0])
             return render_target_color_textures[0]->GetHeight();
 
+        if (render_target_depth_texture)
+            return render_target_depth_texture->GetHeight();
+
         return 0;
     }
 
@@ -127,40 +134,35 @@ namespace Spartan
 
 	void RHI_PipelineState::ComputeHash()
     {
-        m_hash = 0;
-
-        Utility::Hash::hash_combine(m_hash, scissor.left);
-        Utility::Hash::hash_combine(m_hash, scissor.top);
-        Utility::Hash::hash_combine(m_hash, scissor.right);
-        Utility::Hash::hash_combine(m_hash, scissor.bottom);
-        Utility::Hash::hash_combine(m_hash, viewport.x);
-        Utility::Hash::hash_combine(m_hash, viewport.y);
-        Utility::Hash::hash_combine(m_hash, viewport.width);
-        Utility::Hash::hash_combine(m_hash, viewport.height);
-        Utility::Hash::hash_combine(m_hash, primitive_topology);
-        Utility::Hash::hash_combine(m_hash, vertex_buffer_stride);
-        Utility::Hash::hash_combine(m_hash, rasterizer_state->GetId());
-        Utility::Hash::hash_combine(m_hash, blend_state->GetId());
-        Utility::Hash::hash_combine(m_hash, depth_stencil_state->GetId());
-        Utility::Hash::hash_combine(m_hash, shader_vertex->GetId());
-        Utility::Hash::hash_combine(m_hash, dynamic_scissor);
-
-        if (shader_pixel)
-        {
-            Utility::Hash::hash_combine(m_hash, shader_pixel->GetId());
-        }
-
-        for (auto i = 0; i < state_max_render_target_count; i++)
-        {
-            if (render_target_color_textures[i])
-            {
-                Utility::Hash::hash_combine(m_hash, render_target_color_textures[i]->GetId());
-            }
-        }
-
-        if (render_target_depth_texture)
+        RHI_PipelineKey key;
+        key.shader_vertex               = shader_vertex                 ? shader_vertex->GetId()                : 0;
+        key.shader_pixel                = shader_pixel                  ? shader_pixel->GetId()                 : 0;
+        key.rasterizer_state            = rasterizer_state              ? rasterizer_state->GetId()             : 0;
+        key.blend_state                 = blend_state                   ? blend_state->GetId()                  : 0;
+        key.depth_stencil_state         = depth_stencil_state           ? depth_stencil_state->GetId()          : 0;
+        key.render_target_swapchain     = render_target_swapchain       ? render_target_swapchain->GetId()      : 0;
+        key.render_target_depth_texture = render_target_depth_texture   ? render_target_depth_texture->GetId()  : 0;
+        for (uint32_t i = 0; i < state_max_render_target_count; i++)
         {
-            Utility::Hash::hash_combine(m_hash, render_target_depth_texture->GetId());
+            key.render_target_color_textures[i] = render_target_color_textures[i] ? render_target_color_textures[i]->GetId() : 0;
         }
+        key.primitive_topology      = static_cast<uint32_t>(primitive_topology);
+        key.vertex_buffer_stride    = vertex_buffer_stride;
+        key.dynamic_scissor         = dynamic_scissor ? 1 : 0;
+        key.viewport[0]             = viewport.x;
+        key.viewport[1]             = viewport.y;
+        key.viewport[2]             = viewport.width;
+        key.viewport[3]             = viewport.height;
+        key.scissor[0]              = scissor.left;
+        key.scissor[1]              = scissor.top;
+        key.scissor[2]              = scissor.right;
+        key.scissor[3]              = scissor.bottom;
+
+        // Most passes re-use the same state every frame, only re-hash if something changed
+        if (m_hash != 0 && key == m_key)
+            return;
+
+        m_key   = key;
+        m_hash  = Utility::Hash::hash_64(&m_key, sizeof(RHI_PipelineKey));
     }
 }
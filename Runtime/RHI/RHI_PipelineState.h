@@ -22,6 +22,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 //= INCLUDES ======================
+#include <cstring>
 #include "RHI_Definition.h"
 #include "RHI_Viewport.h"
 #include "../Core/Spartan_Object.h"
@@ -30,6 +31,28 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 namespace Spartan
 {
+    // Everything which, if changed, requires a different pipeline. It's plain data (no padding, zero initialized)
+    // so that it can be hashed and compared as a single block of memory.
+    struct RHI_PipelineKey
+    {
+        uint32_t shader_vertex                                                  = 0;
+        uint32_t shader_pixel                                                   = 0;
+        uint32_t rasterizer_state                                               = 0;
+        uint32_t blend_state                                                    = 0;
+        uint32_t depth_stencil_state                                            = 0;
+        uint32_t render_target_swapchain                                        = 0;
+        uint32_t render_target_depth_texture                                    = 0;
+        uint32_t render_target_color_textures[state_max_render_target_count]    = { 0 };
+        uint32_t primitive_topology                                             = 0;
+        uint32_t vertex_buffer_stride                                           = 0;
+        uint32_t dynamic_scissor                                                = 0;
+        float viewport[4]                                                       = { 0.0f };
+        float scissor[4]                                                        = { 0.0f };
+
+        bool operator==(const RHI_PipelineKey& rhs) const { return memcmp(this, &rhs, sizeof(RHI_PipelineKey)) == 0; }
+        bool operator!=(const RHI_PipelineKey& rhs) const { return !(*this == rhs); }
+    };
+
     class SPARTAN_CLASS RHI_PipelineState : public Spartan_Object
     {
     public:
@@ -45,8 +68,9 @@ namespace Spartan
         uint32_t GetHeight() const;
         void ResetClearValues();
         auto GetHash()                                  const { return m_hash; }
+        const auto& GetKey()                            const { return m_key; }
         void* GetRenderPass()                           const { return m_render_pass; }
-        bool operator==(const RHI_PipelineState& rhs)   const { return m_hash == rhs.GetHash(); }
+        bool operator==(const RHI_PipelineState& rhs)   const { return m_hash == rhs.GetHash() && m_key == rhs.GetKey(); }
 
         //= State (things that if changed, will cause a new pipeline to be generated) ==============================
         RHI_Shader* shader_vertex                                                   = nullptr; 
@@ -87,7 +111,8 @@ namespace Spartan
     private:
         void DestroyFrameResources();
   
-        std::size_t m_hash          = 0;
+        uint64_t m_hash             = 0;
+        RHI_PipelineKey m_key;
         void* m_render_pass         = nullptr;
         void* m_frame_buffers[state_max_render_target_count];
 
@@ -39,7 +39,7 @@ namespace Spartan
         const bool comparison_enabled                       /* = false */
     )
     {
-        if (!rhi_device || !rhi_device->GetContextRhi()->device)
+        if (!rhi_device || !rhi_device->IsInitialized())
         {
             LOG_ERROR_INVALID_PARAMETER();
             return;
@@ -21,8 +21,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ======================
 #include "RHI_Shader.h"
+#include "RHI_Device.h"
 #include "RHI_InputLayout.h"
+#include "RHI_ShaderCache.h"
 #include "../Core/Context.h"
+#include "../Core/Stopwatch.h"
 #include "../Threading/Threading.h"
 #include "../Core/FileSystem.h"
 #pragma warning(push, 0) // Hide warnings belonging SPIRV-Cross 
@@ -63,9 +66,44 @@ namespace Spartan
 			m_file_path.clear();
 		}
 
-		// Compile
+        // Remember when the source and its includes were written, so that later edits can be detected
+        m_source_files.clear();
+        if (is_file)
+        {
+            m_source_files.emplace_back(shader, FileSystem::GetLastWriteTime(shader));
+            for (const string& file_path : FileSystem::GetIncludedFiles(shader))
+            {
+                m_source_files.emplace_back(file_path, FileSystem::GetLastWriteTime(file_path));
+            }
+        }
+
+		// Compile, unless a previous run already did
         m_compilation_state = Shader_Compilation_Compiling;
-        m_resource          = _Compile(shader);
+        {
+            RHI_ShaderCache* shader_cache   = m_rhi_device->GetShaderCache();
+            const uint64_t key              = shader_cache ? shader_cache->ComputeKey(this, shader) : 0;
+
+            vector<std::byte> bytecode;
+            if (shader_cache && shader_cache->Load(key, bytecode, m_descriptors))
+            {
+                m_resource = _CreateResource(bytecode);
+            }
+            else
+            {
+                Stopwatch timer;
+                m_descriptors.clear();
+                if (_Compile(shader, bytecode))
+                {
+                    const float compilation_ms  = timer.GetElapsedTimeMs();
+                    m_resource                  = _CreateResource(bytecode);
+
+                    if (m_resource && shader_cache)
+                    {
+                        shader_cache->Save(key, bytecode, m_descriptors, compilation_ms);
+                    }
+                }
+            }
+        }
         m_compilation_state = m_resource ? Shader_Compilation_Succeeded : Shader_Compilation_Failed;
 
 		// Log compilation result
@@ -118,6 +156,31 @@ namespace Spartan
 		});
 	}
 
+    void RHI_Shader::CompileAsync(Context* context, const RHI_Shader_Type type, const string& shader, const RHI_Vertex_Type vertex_type)
+    {
+        if (vertex_type == RHI_Vertex_Type_Position)                            CompileAsync<RHI_Vertex_Pos>(context, type, shader);
+        else if (vertex_type == RHI_Vertex_Type_PositionColor)                  CompileAsync<RHI_Vertex_PosCol>(context, type, shader);
+        else if (vertex_type == RHI_Vertex_Type_PositionTexture)                CompileAsync<RHI_Vertex_PosTex>(context, type, shader);
+        else if (vertex_type == RHI_Vertex_Type_PositionTextureNormalTangent)   CompileAsync<RHI_Vertex_PosTexNorTan>(context, type, shader);
+        else if (vertex_type == RHI_Vertex_Type_PositionTextureNormalTangentBone) CompileAsync<RHI_Vertex_PosTexNorTanBone>(context, type, shader);
+        else if (vertex_type == RHI_Vertex_Type_Position2dTextureColor8)        CompileAsync<RHI_Vertex_Pos2dTexCol8>(context, type, shader);
+        else                                                                    CompileAsync<RHI_Vertex_Undefined>(context, type, shader);
+    }
+
+    bool RHI_Shader::IsSourceModified() const
+    {
+        for (const auto& source_file : m_source_files)
+        {
+            const uint64_t write_time = FileSystem::GetLastWriteTime(source_file.first);
+
+            // Zero means the file is in the middle of being saved, it will be picked up later
+            if (write_time != 0 && write_time != source_file.second)
+                return true;
+        }
+
+        return false;
+    }
+
     const char* RHI_Shader::GetEntryPoint() const
     {
         static const char* entry_point_empty = nullptr;
@@ -149,6 +212,10 @@ namespace Spartan
         static const char* target_profile_vs = "vs_6_0";
         static const char* target_profile_ps = "ps_6_0";
         static const char* target_profile_cs = "cs_6_0";
+        #elif defined(API_GRAPHICS_NULL)
+        static const char* target_profile_vs = "vs_6_0";
+        static const char* target_profile_ps = "ps_6_0";
+        static const char* target_profile_cs = "cs_6_0";
         #endif
 
         if (m_shader_type == RHI_Shader_Vertex)     return target_profile_vs;
@@ -166,6 +233,8 @@ namespace Spartan
         static const char* shader_model = "6_0";
         #elif defined(API_GRAPHICS_VULKAN)
         static const char* shader_model = "6_0";
+        #elif defined(API_GRAPHICS_NULL)
+        static const char* shader_model = "6_0";
         #endif
 
         return shader_model;
@@ -193,6 +262,10 @@ namespace Spartan
 		// Get textures
 		for (const auto& resource : resources.separate_images)
 		{
+            // The bindless texture array lives in its own set, which the descriptor cache owns
+            if (compiler.get_decoration(resource.id, spv::DecorationDescriptorSet) != 0)
+                continue;
+
             m_descriptors.emplace_back
             (
                 RHI_Descriptor_Type::RHI_Descriptor_Texture,                    // Type
@@ -220,5 +293,6 @@ namespace Spartan
     template void RHI_Shader::CompileAsync<RHI_Vertex_PosCol>(Context*, const RHI_Shader_Type, const std::string&);
     template void RHI_Shader::CompileAsync<RHI_Vertex_Pos2dTexCol8>(Context*, const RHI_Shader_Type, const std::string&);
     template void RHI_Shader::CompileAsync<RHI_Vertex_PosTexNorTan>(Context*, const RHI_Shader_Type, const std::string&);
+    template void RHI_Shader::CompileAsync<RHI_Vertex_PosTexNorTanBone>(Context*, const RHI_Shader_Type, const std::string&);
     //===============================================================================================================
 }
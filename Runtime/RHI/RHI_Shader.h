@@ -58,6 +58,11 @@ namespace Spartan
         {
             CompileAsync<RHI_Vertex_Undefined>(context, type, shader);
         }
+        // Asynchronous compilation with a vertex type known at runtime (e.g. to recompile a shader into a new one)
+        void CompileAsync(Context* context, const RHI_Shader_Type type, const std::string& shader, const RHI_Vertex_Type vertex_type);
+
+        // Hot reload
+        bool IsSourceModified() const; // true if the file or any of its includes were written since compilation started
 
 		// Properties
         void* GetResource()             const										{ return m_resource; }
@@ -72,22 +77,26 @@ namespace Spartan
         auto& GetDefines()              const                                       { return m_defines; }
         const auto& GetFilePath()       const                                       { return m_file_path; }
         auto GetShaderStage()           const                                       { return m_shader_type; }
+        auto GetVertexType()            const                                       { return m_vertex_type; }
         const char* GetEntryPoint()     const;
         const char* GetTargetProfile()  const;
         const char* GetShaderModel()    const;
+        static std::string GetCompilerVersion(); // the underlying API's compiler and its version, bytecode from a different one is not reused
 
 	protected:
 		std::shared_ptr<RHI_Device> m_rhi_device;
 
 	private:
-        // All compile functions resolve to this, and this is the underlying API implements
-		void* _Compile(const std::string& shader);
+        // All compile functions resolve to these, and these are what the underlying API implements
+		bool _Compile(const std::string& shader, std::vector<std::byte>& bytecode); // compiles (and reflects, if needed) to bytecode
+		void* _CreateResource(const std::vector<std::byte>& bytecode);              // creates the shader (and input layout) from compiled or cached bytecode
 		void _Reflect(const RHI_Shader_Type shader_type, const uint32_t* ptr, uint32_t size);
 
 		std::string m_name;
 		std::string m_file_path;
 		std::unordered_map<std::string, std::string> m_defines;
 		std::vector<RHI_Descriptor> m_descriptors;
+		std::vector<std::pair<std::string, uint64_t>> m_source_files; // file paths and their last write time
 		std::shared_ptr<RHI_InputLayout> m_input_layout;
 		Shader_Compilation_State m_compilation_state    = Shader_Compilation_Unknown;
         RHI_Shader_Type m_shader_type                       = RHI_Shader_Unknown;
@@ -0,0 +1,294 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ======================
+#include "RHI_ShaderCache.h"
+#include "RHI_Device.h"
+#include "RHI_Shader.h"
+#include "../Math/MathHelper.h"
+#include "../Core/Context.h"
+#include "../Core/Stopwatch.h"
+#include "../Core/FileSystem.h"
+#include "../IO/FileStream.h"
+#include "../Profiling/Profiler.h"
+#include "../Utilities/Hash.h"
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <thread>
+//=================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    // Bump when the file layout changes, or when the compiler's arguments change in a way that the key can't see
+    static const uint32_t shader_cache_version = 2;
+
+    #if defined(API_GRAPHICS_D3D11)
+    static const char* shader_cache_api = "d3d11";
+    #elif defined(API_GRAPHICS_D3D12)
+    static const char* shader_cache_api = "d3d12";
+    #elif defined(API_GRAPHICS_VULKAN)
+    static const char* shader_cache_api = "vulkan";
+    #else
+    static const char* shader_cache_api = "null";
+    #endif
+
+    static uint64_t hash_string(const string& value, const uint64_t seed)
+    {
+        return Utility::Hash::hash_64(value.data(), value.size(), seed);
+    }
+
+    // Hashes a source and, in the order they appear, the files it includes. Includes are resolved
+    // against the directory of the shader being compiled, the same way the compiler's include handler does.
+    static uint64_t hash_source(const string& source, const string& directory, unordered_set<string>& visited, uint64_t hash)
+    {
+        static const string directive_exp = "#include \"";
+
+        hash = hash_string(source, hash);
+
+        if (directory.empty() || source.find(directive_exp) == string::npos)
+            return hash;
+
+        istringstream stream(source);
+        string line;
+        while (getline(stream, line))
+        {
+            const size_t directive_start = line.find(directive_exp);
+            if (directive_start == string::npos)
+                continue;
+
+            const size_t name_start = directive_start + directive_exp.size();
+            const size_t name_end   = line.find('"', name_start);
+            if (name_end == string::npos)
+                continue;
+
+            string file_name = line.substr(name_start, name_end - name_start);
+            if (file_name.rfind("./", 0) == 0)
+            {
+                file_name = file_name.substr(2);
+            }
+
+            // Include guards (#pragma once) make repeated includes a no-op, so only the first one counts
+            const string file_path = directory + file_name;
+            if (!visited.emplace(file_path).second)
+                continue;
+
+            ifstream in(file_path);
+            stringstream buffer;
+            buffer << in.rdbuf();
+
+            hash = hash_string(file_path, hash);
+            hash = hash_source(buffer.str(), directory, visited, hash);
+        }
+
+        return hash;
+    }
+
+    RHI_ShaderCache::RHI_ShaderCache(const RHI_Device* rhi_device, const string& directory)
+    {
+        m_directory         = directory;
+        m_compiler_version  = RHI_Shader::GetCompilerVersion();
+
+        if (Context* context = rhi_device->GetContext())
+        {
+            m_profiler = context->GetSubsystem<Profiler>();
+        }
+
+        if (!FileSystem::Exists(m_directory))
+        {
+            FileSystem::CreateDirectory_(m_directory);
+        }
+
+        // Index the files which are already there, so that misses don't have to touch the disk
+        for (const string& file_path : FileSystem::GetFilesInDirectory(m_directory))
+        {
+            // Left behind by a run which exited while saving
+            if (FileSystem::GetExtensionFromFilePath(file_path) == ".tmp")
+            {
+                FileSystem::Delete(file_path);
+                continue;
+            }
+
+            if (FileSystem::GetExtensionFromFilePath(file_path) != ".bin")
+                continue;
+
+            const string name = FileSystem::GetFileNameNoExtensionFromFilePath(file_path);
+            if (name.size() == 16 && name.find_first_not_of("0123456789abcdef") == string::npos)
+            {
+                m_index.emplace(stoull(name, nullptr, 16));
+            }
+        }
+    }
+
+    uint64_t RHI_ShaderCache::ComputeKey(const RHI_Shader* shader, const string& source) const
+    {
+        uint64_t hash = Utility::Hash::hash_64(&shader_cache_version, sizeof(shader_cache_version));
+        hash = hash_string(shader_cache_api, hash);
+        hash = hash_string(m_compiler_version, hash);
+
+        #ifdef DEBUG
+        hash = hash_string("debug", hash);
+        #endif
+
+        // Source, read from disk if this is a file
+        if (FileSystem::IsFile(source))
+        {
+            ifstream in(source);
+            stringstream buffer;
+            buffer << in.rdbuf();
+
+            unordered_set<string> visited;
+            hash = hash_source(buffer.str(), FileSystem::GetDirectoryFromFilePath(source), visited, hash);
+        }
+        else
+        {
+            hash = hash_string(source, hash);
+        }
+
+        // Defines, sorted so that the key doesn't depend on the order they were added in
+        const map<string, string> defines(shader->GetDefines().begin(), shader->GetDefines().end());
+        for (const auto& define : defines)
+        {
+            hash = hash_string(define.first, hash);
+            hash = hash_string(define.second, hash);
+        }
+
+        // Entry point and target profile (which also determine the stage)
+        const char* entry_point     = shader->GetEntryPoint();
+        const char* target_profile  = shader->GetTargetProfile();
+        hash = hash_string(entry_point ? entry_point : "", hash);
+        hash = hash_string(target_profile ? target_profile : "", hash);
+
+        return hash;
+    }
+
+    bool RHI_ShaderCache::Load(const uint64_t key, vector<std::byte>& bytecode, vector<RHI_Descriptor>& descriptors)
+    {
+        Stopwatch timer;
+
+        bool is_indexed = false;
+        {
+            lock_guard<mutex> lock(m_mutex);
+            is_indexed = m_index.find(key) != m_index.end();
+        }
+
+        bool loaded = false;
+        float compilation_ms = 0.0f;
+        if (is_indexed)
+        {
+            auto file = make_unique<FileStream>(GetFilePath(key), FileStream_Read);
+            if (file->IsOpen() && file->ReadAs<uint32_t>() == shader_cache_version)
+            {
+                file->Read(&compilation_ms);
+
+                descriptors.resize(file->ReadAs<uint32_t>());
+                for (RHI_Descriptor& descriptor : descriptors)
+                {
+                    descriptor.type = static_cast<RHI_Descriptor_Type>(file->ReadAs<uint32_t>());
+                    file->Read(&descriptor.slot);
+                    file->Read(&descriptor.stage);
+                }
+
+                file->Read(&bytecode);
+                loaded = !bytecode.empty();
+            }
+        }
+
+        if (!loaded)
+        {
+            descriptors.clear();
+            bytecode.clear();
+        }
+
+        UpdateStatistics(loaded, loaded ? Math::Helper::Max(compilation_ms - timer.GetElapsedTimeMs(), 0.0f) : 0.0f);
+
+        return loaded;
+    }
+
+    bool RHI_ShaderCache::Save(const uint64_t key, const vector<std::byte>& bytecode, const vector<RHI_Descriptor>& descriptors, const float compilation_ms)
+    {
+        // Nothing to cache for APIs without bytecode
+        if (bytecode.empty())
+            return false;
+
+        // Written under a name of its own, the same shader could be compiling on another thread
+        const string file_path      = GetFilePath(key);
+        const string file_path_temp = file_path + "." + to_string(hash<thread::id>()(this_thread::get_id())) + ".tmp";
+        {
+            auto file = make_unique<FileStream>(file_path_temp, FileStream_Write);
+            if (!file->IsOpen())
+            {
+                LOG_ERROR("Failed to open \"%s\" for writing", file_path_temp.c_str());
+                return false;
+            }
+
+            file->Write(shader_cache_version);
+            file->Write(compilation_ms);
+            file->Write(static_cast<uint32_t>(descriptors.size()));
+            for (const RHI_Descriptor& descriptor : descriptors)
+            {
+                file->Write(static_cast<uint32_t>(descriptor.type));
+                file->Write(descriptor.slot);
+                file->Write(descriptor.stage);
+            }
+            file->Write(bytecode);
+        }
+
+        // Readers only ever see a complete file
+        if (!FileSystem::Rename(file_path_temp, file_path))
+        {
+            FileSystem::Delete(file_path_temp);
+            return false;
+        }
+
+        lock_guard<mutex> lock(m_mutex);
+        m_index.emplace(key);
+
+        return true;
+    }
+
+    void RHI_ShaderCache::UpdateStatistics(const bool is_hit, const float time_saved_ms)
+    {
+        lock_guard<mutex> lock(m_mutex);
+
+        m_hits          += is_hit ? 1 : 0;
+        m_misses        += is_hit ? 0 : 1;
+        m_time_saved_ms += time_saved_ms;
+
+        if (m_profiler)
+        {
+            m_profiler->m_rhi_shader_cache_hits     = m_hits;
+            m_profiler->m_rhi_shader_cache_misses   = m_misses;
+            m_profiler->m_rhi_shader_cache_saved_ms = m_time_saved_ms;
+        }
+    }
+
+    string RHI_ShaderCache::GetFilePath(const uint64_t key) const
+    {
+        char file_name[32];
+        snprintf(file_name, sizeof(file_name), "%016llx.bin", static_cast<unsigned long long>(key));
+        return m_directory + file_name;
+    }
+}
@@ -0,0 +1,71 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ======================
+#include <mutex>
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include "RHI_Definition.h"
+#include "../Core/Spartan_Object.h"
+//=================================
+
+namespace Spartan
+{
+    class Profiler;
+
+    // Compiled shaders on disk, addressed by a hash of everything that affects their bytecode.
+    // Shaders compile on worker threads, so files are written under a temporary name and then renamed into place,
+    // the lock only guards the statistics and the index of the files which exist.
+    class SPARTAN_CLASS RHI_ShaderCache : public Spartan_Object
+    {
+    public:
+        RHI_ShaderCache(const RHI_Device* rhi_device, const std::string& directory);
+        ~RHI_ShaderCache() = default;
+
+        // Hashes the source (with includes resolved), the defines, the entry point and the target profile
+        uint64_t ComputeKey(const RHI_Shader* shader, const std::string& source) const;
+
+        // Returns the bytecode and the reflected descriptors of a previous compilation
+        bool Load(const uint64_t key, std::vector<std::byte>& bytecode, std::vector<RHI_Descriptor>& descriptors);
+        // Stores the result of a compilation, along with how long it took (so that hits can report the time saved)
+        bool Save(const uint64_t key, const std::vector<std::byte>& bytecode, const std::vector<RHI_Descriptor>& descriptors, const float compilation_ms);
+
+        uint32_t GetHitCount()      const { return m_hits; }
+        uint32_t GetMissCount()     const { return m_misses; }
+        float GetTimeSavedMs()      const { return m_time_saved_ms; }
+
+    private:
+        std::string GetFilePath(const uint64_t key) const;
+        void UpdateStatistics(const bool is_hit, const float time_saved_ms);
+
+        std::string m_directory;
+        std::string m_compiler_version;
+        std::unordered_set<uint64_t> m_index;
+        uint32_t m_hits         = 0;
+        uint32_t m_misses       = 0;
+        float m_time_saved_ms   = 0.0f;
+        std::mutex m_mutex;
+        Profiler* m_profiler    = nullptr;
+    };
+}
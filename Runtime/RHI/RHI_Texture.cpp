@@ -286,6 +286,7 @@ namespace Spartan
 			case RHI_Format_R32G32_Float:		    return 2;
 			case RHI_Format_R32G32B32_Float:	    return 3;
 			case RHI_Format_R8G8B8A8_Unorm:		    return 4;
+			case RHI_Format_R8G8B8A8_Uint:		    return 4;
 			case RHI_Format_R16G16B16A16_Float:	    return 4;
 			case RHI_Format_R32G32B32A32_Float:	    return 4;
             case RHI_Format_D32_Float:			    return 1;
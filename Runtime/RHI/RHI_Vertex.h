@@ -127,11 +127,41 @@ namespace Spartan
 		float tan[3] = { 0 };
 	};
 
+	struct RHI_Vertex_PosTexNorTanBone
+	{
+		RHI_Vertex_PosTexNorTanBone() = default;
+		RHI_Vertex_PosTexNorTanBone(const RHI_Vertex_PosTexNorTan& vertex)
+		{
+			pos[0] = vertex.pos[0];
+			pos[1] = vertex.pos[1];
+			pos[2] = vertex.pos[2];
+
+			tex[0] = vertex.tex[0];
+			tex[1] = vertex.tex[1];
+
+			nor[0] = vertex.nor[0];
+			nor[1] = vertex.nor[1];
+			nor[2] = vertex.nor[2];
+
+			tan[0] = vertex.tan[0];
+			tan[1] = vertex.tan[1];
+			tan[2] = vertex.tan[2];
+		}
+
+		float pos[3]			= { 0 };
+		float tex[2]			= { 0 };
+		float nor[3]			= { 0 };
+		float tan[3]			= { 0 };
+		uint8_t bone_index[4]	= { 0 };
+		uint8_t bone_weight[4]	= { 0 }; // unorm, the weights of a skinned vertex add up to 255
+	};
+
 	static_assert(std::is_trivially_copyable<RHI_Vertex_Pos>::value,			"RHI_Vertex_Pos is not trivially copyable");
 	static_assert(std::is_trivially_copyable<RHI_Vertex_PosTex>::value,			"RHI_Vertex_PosTex is not trivially copyable");
 	static_assert(std::is_trivially_copyable<RHI_Vertex_PosCol>::value,			"RHI_Vertex_PosCol is not trivially copyable");
 	static_assert(std::is_trivially_copyable<RHI_Vertex_Pos2dTexCol8>::value,	"RHI_Vertex_Pos2dTexCol8 is not trivially copyable");
 	static_assert(std::is_trivially_copyable<RHI_Vertex_PosTexNorTan>::value,	"RHI_Vertex_PosTexNorTan is not trivially copyable");
+	static_assert(std::is_trivially_copyable<RHI_Vertex_PosTexNorTanBone>::value,	"RHI_Vertex_PosTexNorTanBone is not trivially copyable");
 
 	enum RHI_Vertex_Type
 	{
@@ -140,6 +170,7 @@ namespace Spartan
 		RHI_Vertex_Type_PositionColor,
 		RHI_Vertex_Type_PositionTexture,
 		RHI_Vertex_Type_PositionTextureNormalTangent,
+		RHI_Vertex_Type_PositionTextureNormalTangentBone,
 		RHI_Vertex_Type_Position2dTextureColor8
 	};
 
@@ -151,4 +182,5 @@ namespace Spartan
 	template<> inline RHI_Vertex_Type RHI_Vertex_Type_To_Enum<RHI_Vertex_PosCol>()			{ return RHI_Vertex_Type_PositionColor; }
 	template<> inline RHI_Vertex_Type RHI_Vertex_Type_To_Enum<RHI_Vertex_Pos2dTexCol8>()	{ return RHI_Vertex_Type_Position2dTextureColor8; }
 	template<> inline RHI_Vertex_Type RHI_Vertex_Type_To_Enum<RHI_Vertex_PosTexNorTan>()	{ return RHI_Vertex_Type_PositionTextureNormalTangent; }
+	template<> inline RHI_Vertex_Type RHI_Vertex_Type_To_Enum<RHI_Vertex_PosTexNorTanBone>(){ return RHI_Vertex_Type_PositionTextureNormalTangentBone; }
 }
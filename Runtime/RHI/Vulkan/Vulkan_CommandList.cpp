@@ -51,7 +51,7 @@ using namespace Spartan::Math;
 
 namespace Spartan
 {
-    RHI_CommandList::RHI_CommandList(uint32_t index, RHI_SwapChain* swap_chain, Context* context)
+    RHI_CommandList::RHI_CommandList(uint32_t index, RHI_SwapChain* swap_chain, Context* context, const bool is_secondary /*= false*/)
 	{
         m_swap_chain        = swap_chain;
         m_renderer          = context->GetSubsystem<Renderer>();
@@ -63,9 +63,21 @@ namespace Spartan
         m_passes_active.resize(100);
         m_timestamps.reserve(2);
         m_timestamps.resize(2);
+        m_is_secondary      = is_secondary;
 
         RHI_Context* rhi_context = m_rhi_device->GetContextRhi();
 
+        // Secondaries are recorded concurrently, so they need their own descriptor cache and command pool, and they are never submitted (no queries or fence)
+        if (m_is_secondary)
+        {
+            m_descriptor_cache_secondary    = make_shared<RHI_DescriptorCache>(m_rhi_device, false);
+            m_descriptor_cache              = m_descriptor_cache_secondary.get();
+
+            vulkan_common::command_pool::create(m_rhi_device, m_cmd_pool, RHI_Queue_Graphics);
+            vulkan_common::command_buffer::create(rhi_context, m_cmd_pool, m_cmd_buffer, VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+            return;
+        }
+
         // Query pool
         if (rhi_context->profiler)
         {
@@ -92,6 +104,13 @@ namespace Spartan
 		// Wait in case the buffer is still in use by the graphics queue
         m_rhi_device->Queue_Wait(RHI_Queue_Graphics);
 
+        if (m_is_secondary)
+        {
+            vulkan_common::command_buffer::free(rhi_context, m_cmd_pool, m_cmd_buffer);
+            vulkan_common::command_pool::destroy(rhi_context, m_cmd_pool);
+            return;
+        }
+
 		// Fence
         vulkan_common::fence::destroy(rhi_context, m_cmd_list_consumed_fence);
 
@@ -178,6 +197,126 @@ namespace Spartan
         return true;
 	}
 
+    bool RHI_CommandList::BeginSecondary(RHI_CommandList* primary)
+    {
+        if (!m_is_secondary || !primary || primary->m_is_secondary)
+        {
+            LOG_ERROR_INVALID_PARAMETER();
+            return false;
+        }
+
+        if (primary->m_cmd_state != RHI_Cmd_List_Recording)
+        {
+            LOG_ERROR("The primary command list has to be recording");
+            return false;
+        }
+
+        // The primary's Begin() waited for its previous submission, which is the last one to have executed this list.
+        // A list which ended but was never executed (its pass was abandoned) was never submitted, so it can be recorded again as well.
+        if (m_cmd_state == RHI_Cmd_List_Idle_Sync_Cpu_To_Gpu || m_cmd_state == RHI_Cmd_List_Ended)
+        {
+            m_descriptor_cache->GrowIfNeeded();
+            m_cmd_state = RHI_Cmd_List_Idle;
+        }
+
+        if (m_cmd_state != RHI_Cmd_List_Idle)
+        {
+            LOG_ERROR("Previous command list is still being used");
+            return false;
+        }
+
+        // Continue the primary's render pass
+        RHI_PipelineState* state                        = primary->m_pipeline->GetPipelineState();
+        VkCommandBufferInheritanceInfo inheritance_info = {};
+        inheritance_info.sType                          = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritance_info.renderPass                     = static_cast<VkRenderPass>(state->GetRenderPass());
+        inheritance_info.subpass                        = 0;
+        inheritance_info.framebuffer                    = static_cast<VkFramebuffer>(state->GetFrameBuffer());
+
+        // Begin command buffer
+        VkCommandBufferBeginInfo begin_info = {};
+        begin_info.sType                    = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        begin_info.flags                    = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+        begin_info.pInheritanceInfo         = &inheritance_info;
+        if (!vulkan_common::error::check(vkBeginCommandBuffer(CMD_BUFFER, &begin_info)))
+            return false;
+
+        m_cmd_state = RHI_Cmd_List_Recording;
+
+        // Continue with the primary's pipeline. The descriptor set layout is this list's own, but it's created
+        // from the same shaders, so it's compatible with the pipeline layout.
+        m_pipeline_state        = primary->m_pipeline_state;
+        m_pipeline              = primary->m_pipeline;
+        m_pipeline_active       = false;
+        m_render_pass_active    = false;
+        m_counters              = Counters();
+        m_descriptor_cache->SetPipelineState(*m_pipeline_state);
+
+        // Nothing is inherited from the primary, so the global resources have to be set again
+        m_set_id_buffer_vertex  = 0;
+        m_set_id_buffer_pixel   = 0;
+        m_renderer->SetGlobalSamplersAndConstantBuffers(this);
+
+        return true;
+    }
+
+    bool RHI_CommandList::ExecuteSecondary(RHI_CommandList* const* cmd_lists, const uint32_t count)
+    {
+        if (m_cmd_state != RHI_Cmd_List_Recording)
+        {
+            LOG_WARNING("Can't record command");
+            return false;
+        }
+
+        // A render pass either records its draws inline or executes secondaries, not both
+        if (m_is_secondary || m_render_pass_active)
+        {
+            LOG_ERROR("Secondary command lists can only be executed by a primary which hasn't started drawing");
+            return false;
+        }
+
+        vector<VkCommandBuffer> cmd_buffers(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (!cmd_lists[i] || !cmd_lists[i]->m_is_secondary || cmd_lists[i]->m_cmd_state != RHI_Cmd_List_Ended)
+            {
+                LOG_ERROR_INVALID_PARAMETER();
+                return false;
+            }
+
+            cmd_buffers[i] = static_cast<VkCommandBuffer>(cmd_lists[i]->m_cmd_buffer);
+        }
+
+        BeginRenderPass(true);
+        m_render_pass_active = true;
+
+        // Executed in the given order
+        vkCmdExecuteCommands(CMD_BUFFER, count, cmd_buffers.data());
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            RHI_CommandList* cmd_list = cmd_lists[i];
+
+            m_counters.draw_calls               += cmd_list->m_counters.draw_calls;
+            m_counters.draw_calls_instanced     += cmd_list->m_counters.draw_calls_instanced;
+            m_counters.instances                += cmd_list->m_counters.instances;
+            m_counters.bindings_buffer_vertex   += cmd_list->m_counters.bindings_buffer_vertex;
+            m_counters.bindings_buffer_index    += cmd_list->m_counters.bindings_buffer_index;
+            m_counters.bindings_descriptor_set  += cmd_list->m_counters.bindings_descriptor_set;
+            m_counters.bindings_pipeline        += cmd_list->m_counters.bindings_pipeline;
+
+            // Can be recorded again once the primary's submission is done
+            cmd_list->m_cmd_state = RHI_Cmd_List_Idle_Sync_Cpu_To_Gpu;
+        }
+
+        // The state the secondaries left behind is undefined
+        m_pipeline_active       = false;
+        m_set_id_buffer_vertex  = 0;
+        m_set_id_buffer_pixel   = 0;
+
+        return true;
+    }
+
     bool RHI_CommandList::End()
     {
         if (m_cmd_state != RHI_Cmd_List_Recording)
@@ -200,6 +339,12 @@ namespace Spartan
         if (!vulkan_common::error::check(vkEndCommandBuffer(CMD_BUFFER)))
             return false;
 
+        // Secondaries hand their counters to the primary which executes them
+        if (!m_is_secondary)
+        {
+            AddCounters();
+        }
+
         // Update state
         m_cmd_state = RHI_Cmd_List_Ended;
        
@@ -237,9 +382,35 @@ namespace Spartan
             0               // firstInstance
         );
 
-        m_profiler->m_rhi_draw_calls++;
+        m_counters.draw_calls++;
 	}
 
+    void RHI_CommandList::DrawIndexedInstanced(const uint32_t index_count, const uint32_t instance_count, const uint32_t index_offset, const uint32_t vertex_offset)
+    {
+        if (m_cmd_state != RHI_Cmd_List_Recording)
+        {
+            LOG_WARNING("Can't record command");
+            return;
+        }
+
+        // Ensure correct state before attempting to draw
+        if (!OnDraw())
+            return;
+
+        vkCmdDrawIndexed(
+            CMD_BUFFER,     // commandBuffer
+            index_count,    // indexCount
+            instance_count, // instanceCount
+            index_offset,   // firstIndex
+            vertex_offset,  // vertexOffset
+            0               // firstInstance
+        );
+
+        m_counters.draw_calls++;
+        m_counters.draw_calls_instanced++;
+        m_counters.instances += instance_count;
+    }
+
 	void RHI_CommandList::DrawIndexed(const uint32_t index_count, const uint32_t index_offset, const uint32_t vertex_offset)
 	{
         if (m_cmd_state != RHI_Cmd_List_Recording)
@@ -261,7 +432,7 @@ namespace Spartan
             0               // firstInstance
         );
 
-        m_profiler->m_rhi_draw_calls++;
+        m_counters.draw_calls++;
 	}
 
     void RHI_CommandList::Dispatch(uint32_t x, uint32_t y, uint32_t z /*= 1*/) const
@@ -337,7 +508,7 @@ namespace Spartan
             offsets         // pOffsets
         );
 
-        m_profiler->m_rhi_bindings_buffer_vertex++;
+        m_counters.bindings_buffer_vertex++;
         m_set_id_buffer_vertex = buffer->GetId();
 	}
 
@@ -359,7 +530,7 @@ namespace Spartan
 			buffer->Is16Bit() ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32 // indexType
 		);
 
-        m_profiler->m_rhi_bindings_buffer_index++;
+        m_counters.bindings_buffer_index++;
         m_set_id_buffer_pixel = buffer->GetId();
 	}
 
@@ -375,6 +546,18 @@ namespace Spartan
         m_descriptor_cache->SetConstantBuffer(slot, constant_buffer);
     }
 
+    void RHI_CommandList::SetConstantBufferDynamic(const uint32_t slot, const uint8_t scope, RHI_ConstantBuffer* constant_buffer, const uint32_t offset_index_dynamic) const
+    {
+        if (m_cmd_state != RHI_Cmd_List_Recording)
+        {
+            LOG_WARNING("Can't record command");
+            return;
+        }
+
+        // Set (will only happen if it's not already set)
+        m_descriptor_cache->SetConstantBuffer(slot, constant_buffer, offset_index_dynamic);
+    }
+
     void RHI_CommandList::SetSampler(const uint32_t slot, RHI_Sampler* sampler) const
     {
         if (m_cmd_state != RHI_Cmd_List_Recording)
@@ -407,6 +590,19 @@ namespace Spartan
             texture = m_renderer->GetBlackTexture();
         }
 
+        // Secondaries continue the primary's render pass, where layouts can't change, so textures which can't be sampled yet are replaced with black
+        if (m_is_secondary)
+        {
+            const bool needs_transition =
+                (texture->IsColorFormat() && texture->GetLayout() != RHI_Image_Shader_Read_Only_Optimal) ||
+                (texture->IsDepthFormat() && texture->GetLayout() != RHI_Image_Depth_Stencil_Read_Only_Optimal);
+
+            if (needs_transition)
+            {
+                texture = m_renderer->GetBlackTexture();
+            }
+        }
+
         // Transition to appropriate layout (if needed)
         {
             if (texture->IsColorFormat() && texture->GetLayout() != RHI_Image_Shader_Read_Only_Optimal)
@@ -620,7 +816,7 @@ namespace Spartan
         }
     }
 
-    void RHI_CommandList::BeginRenderPass()
+    void RHI_CommandList::BeginRenderPass(const bool contents_secondary /*= false*/)
     {
         // Clear values
         array<VkClearValue, state_max_render_target_count + 1> clear_values; // +1 for depth-stencil
@@ -657,7 +853,7 @@ namespace Spartan
         render_pass_info.renderArea.extent.height   = m_pipeline->GetPipelineState()->GetHeight();
         render_pass_info.clearValueCount            = clear_value_count;
         render_pass_info.pClearValues               = clear_values.data();
-        vkCmdBeginRenderPass(CMD_BUFFER, &render_pass_info, VK_SUBPASS_CONTENTS_INLINE);
+        vkCmdBeginRenderPass(CMD_BUFFER, &render_pass_info, contents_secondary ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE);
     }
 
     bool RHI_CommandList::BindDescriptorSet()
@@ -689,7 +885,7 @@ namespace Spartan
                 dynamic_offsets                                                 // pDynamicOffsets
             );
 
-            m_profiler->m_rhi_bindings_descriptor_set++;
+            m_counters.bindings_descriptor_set++;
 
             // Upon setting a new descriptor, resources have to be set again.
             // Note: I could optimize this further and see if the descriptor happens to contain them.
@@ -702,10 +898,9 @@ namespace Spartan
 
     bool RHI_CommandList::OnDraw()
     {
-        // Begin render pass
-        if (!m_render_pass_active)
+        // Begin render pass (secondaries continue the primary's)
+        if (!m_render_pass_active && !m_is_secondary)
         {
-            
             BeginRenderPass();
             m_render_pass_active = true;
         }
@@ -717,8 +912,15 @@ namespace Spartan
             if (VkPipeline vk_pipeline = static_cast<VkPipeline>(m_pipeline->GetPipeline()))
             {
                 vkCmdBindPipeline(CMD_BUFFER, VK_PIPELINE_BIND_POINT_GRAPHICS, vk_pipeline);
-                m_profiler->m_rhi_bindings_pipeline++;
+                m_counters.bindings_pipeline++;
                 m_pipeline_active = true;
+
+                // Bind the bindless textures, they never change so once per pipeline is enough
+                if (VkDescriptorSet bindless_set = m_rhi_device->GetContextRhi()->bindless_descriptor_set)
+                {
+                    vkCmdBindDescriptorSets(CMD_BUFFER, VK_PIPELINE_BIND_POINT_GRAPHICS, static_cast<VkPipelineLayout>(m_pipeline->GetPipelineLayout()), 1, 1, &bindless_set, 0, nullptr);
+                    m_counters.bindings_descriptor_set++;
+                }
             }
             else
             {
@@ -730,5 +932,18 @@ namespace Spartan
         // Bind descriptor set
         return BindDescriptorSet();
     }
+
+    void RHI_CommandList::AddCounters()
+    {
+        m_profiler->m_rhi_draw_calls                += m_counters.draw_calls;
+        m_profiler->m_rhi_draw_calls_instanced      += m_counters.draw_calls_instanced;
+        m_profiler->m_rhi_instances                 += m_counters.instances;
+        m_profiler->m_rhi_bindings_buffer_vertex    += m_counters.bindings_buffer_vertex;
+        m_profiler->m_rhi_bindings_buffer_index     += m_counters.bindings_buffer_index;
+        m_profiler->m_rhi_bindings_descriptor_set   += m_counters.bindings_descriptor_set;
+        m_profiler->m_rhi_bindings_pipeline         += m_counters.bindings_pipeline;
+
+        m_counters = Counters();
+    }
 }
 #endif
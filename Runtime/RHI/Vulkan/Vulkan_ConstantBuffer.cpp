@@ -42,6 +42,12 @@ namespace Spartan
         // Wait in case the buffer is still in use
         m_rhi_device->Queue_WaitAll();
 
+        if (m_mapped)
+        {
+            vkUnmapMemory(m_rhi_device->GetContextRhi()->device, static_cast<VkDeviceMemory>(m_buffer_memory));
+            m_mapped = nullptr;
+        }
+
 		vulkan_common::buffer::destroy(m_rhi_device->GetContextRhi(), m_buffer);
 		vulkan_common::memory::free(m_rhi_device->GetContextRhi(), m_buffer_memory);
 	}
@@ -61,6 +67,11 @@ namespace Spartan
         }
 
 		// Clear previous buffer
+        if (m_mapped)
+        {
+            vkUnmapMemory(m_rhi_device->GetContextRhi()->device, static_cast<VkDeviceMemory>(m_buffer_memory));
+            m_mapped = nullptr;
+        }
 		vulkan_common::buffer::destroy(m_rhi_device->GetContextRhi(), m_buffer);
 		vulkan_common::memory::free(m_rhi_device->GetContextRhi(), m_buffer_memory);
 
@@ -80,6 +91,10 @@ namespace Spartan
         vulkan_common::debug::set_buffer_name(m_rhi_device->GetContextRhi()->device, static_cast<VkBuffer>(m_buffer), "constant_buffer");
         vulkan_common::debug::set_device_memory_name(m_rhi_device->GetContextRhi()->device, static_cast<VkDeviceMemory>(m_buffer_memory), "constant_buffer");
 
+        // The memory is host coherent, so keep it mapped instead of mapping it for every update
+        if (!vulkan_common::error::check(vkMapMemory(m_rhi_device->GetContextRhi()->device, static_cast<VkDeviceMemory>(m_buffer_memory), 0, VK_WHOLE_SIZE, 0, &m_mapped)))
+            return false;
+
 		return true;
 	}
 
@@ -91,6 +106,9 @@ namespace Spartan
             return nullptr;
         }
 
+        if (m_mapped)
+            return static_cast<void*>(static_cast<std::byte*>(m_mapped) + static_cast<uint64_t>(offset_index) * m_stride);
+
         void* ptr = nullptr;
         vulkan_common::error::check
         (
@@ -116,6 +134,9 @@ namespace Spartan
             return false;
         }
 
+        if (m_mapped)
+            return true;
+
         vkUnmapMemory(m_rhi_device->GetContextRhi()->device, static_cast<VkDeviceMemory>(m_buffer_memory));
 
         return true;
@@ -27,6 +27,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ======================
 #include "../RHI_DescriptorCache.h"
 #include "../RHI_Shader.h"
+#include "../RHI_Texture.h"
 //=================================
 
 //= NAMESPACES =====
@@ -42,6 +43,24 @@ namespace Spartan
             vkDestroyDescriptorPool(m_rhi_device->GetContextRhi()->device, static_cast<VkDescriptorPool>(m_descriptor_pool), nullptr);
             m_descriptor_pool = nullptr;
         }
+
+        // Bindless textures (the set is freed with its pool), only the cache which created them destroys them
+        RHI_Context* rhi_context = m_rhi_device->GetContextRhi();
+        if (!m_owns_bindless)
+            return;
+
+        if (m_bindless_pool)
+        {
+            vkDestroyDescriptorPool(rhi_context->device, static_cast<VkDescriptorPool>(m_bindless_pool), nullptr);
+            m_bindless_pool                     = nullptr;
+            rhi_context->bindless_descriptor_set = nullptr;
+        }
+
+        if (rhi_context->bindless_descriptor_set_layout)
+        {
+            vkDestroyDescriptorSetLayout(rhi_context->device, rhi_context->bindless_descriptor_set_layout, nullptr);
+            rhi_context->bindless_descriptor_set_layout = nullptr;
+        }
     }
 
     void RHI_DescriptorCache::SetDescriptorSetCapacity(uint32_t descriptor_set_capacity)
@@ -98,5 +117,80 @@ namespace Spartan
 
         return true;
     }
+
+    bool RHI_DescriptorCache::CreateBindless()
+    {
+        RHI_Context* rhi_context = m_rhi_device->GetContextRhi();
+
+        // Layout - A single, partially bound, texture array which can be written while bound
+        VkDescriptorSetLayoutBinding binding    = {};
+        binding.binding                         = 0;
+        binding.descriptorType                  = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+        binding.descriptorCount                 = RHI_Context::descriptor_max_bindless_textures;
+        binding.stageFlags                      = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+        VkDescriptorBindingFlagsEXT binding_flags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT;
+        VkDescriptorSetLayoutBindingFlagsCreateInfoEXT binding_flags_info   = {};
+        binding_flags_info.sType                                            = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+        binding_flags_info.bindingCount                                     = 1;
+        binding_flags_info.pBindingFlags                                    = &binding_flags;
+
+        VkDescriptorSetLayoutCreateInfo layout_info = {};
+        layout_info.sType                           = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layout_info.pNext                           = &binding_flags_info;
+        layout_info.flags                           = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+        layout_info.bindingCount                    = 1;
+        layout_info.pBindings                       = &binding;
+
+        if (!vulkan_common::error::check(vkCreateDescriptorSetLayout(rhi_context->device, &layout_info, nullptr, &rhi_context->bindless_descriptor_set_layout)))
+            return false;
+
+        // Pool
+        VkDescriptorPoolSize pool_size  = {};
+        pool_size.type                  = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+        pool_size.descriptorCount       = RHI_Context::descriptor_max_bindless_textures;
+
+        VkDescriptorPoolCreateInfo pool_info    = {};
+        pool_info.sType                         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        pool_info.flags                         = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+        pool_info.poolSizeCount                 = 1;
+        pool_info.pPoolSizes                    = &pool_size;
+        pool_info.maxSets                       = 1;
+
+        if (!vulkan_common::error::check(vkCreateDescriptorPool(rhi_context->device, &pool_info, nullptr, reinterpret_cast<VkDescriptorPool*>(&m_bindless_pool))))
+            return false;
+
+        // Set
+        VkDescriptorSetAllocateInfo allocate_info   = {};
+        allocate_info.sType                         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocate_info.descriptorPool                = static_cast<VkDescriptorPool>(m_bindless_pool);
+        allocate_info.descriptorSetCount            = 1;
+        allocate_info.pSetLayouts                   = &rhi_context->bindless_descriptor_set_layout;
+
+        if (!vulkan_common::error::check(vkAllocateDescriptorSets(rhi_context->device, &allocate_info, &rhi_context->bindless_descriptor_set)))
+            return false;
+
+        vulkan_common::debug::set_descriptor_set_name(rhi_context->device, rhi_context->bindless_descriptor_set, "bindless_textures");
+
+        return true;
+    }
+
+    void RHI_DescriptorCache::UpdateBindless(uint32_t index, RHI_Texture* texture)
+    {
+        VkDescriptorImageInfo image_info    = {};
+        image_info.imageView                = static_cast<VkImageView>(texture->Get_View_Texture());
+        image_info.imageLayout              = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+        VkWriteDescriptorSet write  = {};
+        write.sType                 = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet                = m_rhi_device->GetContextRhi()->bindless_descriptor_set;
+        write.dstBinding            = 0;
+        write.dstArrayElement       = index;
+        write.descriptorCount       = 1;
+        write.descriptorType        = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+        write.pImageInfo            = &image_info;
+
+        vkUpdateDescriptorSets(m_rhi_device->GetContextRhi()->device, 1, &write, 0, nullptr);
+    }
 }
 #endif
@@ -219,6 +219,41 @@ namespace Spartan
             // Get the supported extensions out of the requested extensions
             vector<const char*> extensions_supported = vulkan_common::extension::get_supported_device(m_rhi_context->extensions_device, m_rhi_context->device_physical);
 
+            // Descriptor indexing (bindless textures), requires Vulkan 1.1 for the feature query
+            VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptor_indexing_enabled = {};
+            descriptor_indexing_enabled.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+            if (app_info.apiVersion >= VK_API_VERSION_1_1 && vulkan_common::extension::is_present_device(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME, m_rhi_context->device_physical))
+            {
+                VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptor_indexing_supported = {};
+                descriptor_indexing_supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+
+                VkPhysicalDeviceFeatures2 device_features_2 = {};
+                device_features_2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+                device_features_2.pNext = &descriptor_indexing_supported;
+                vkGetPhysicalDeviceFeatures2(m_rhi_context->device_physical, &device_features_2);
+
+                m_rhi_context->bindless_textures =
+                    descriptor_indexing_supported.runtimeDescriptorArray &&
+                    descriptor_indexing_supported.descriptorBindingPartiallyBound &&
+                    descriptor_indexing_supported.descriptorBindingSampledImageUpdateAfterBind &&
+                    descriptor_indexing_supported.descriptorBindingUpdateUnusedWhilePending &&
+                    descriptor_indexing_supported.shaderSampledImageArrayNonUniformIndexing;
+
+                if (m_rhi_context->bindless_textures)
+                {
+                    descriptor_indexing_enabled.runtimeDescriptorArray                          = VK_TRUE;
+                    descriptor_indexing_enabled.descriptorBindingPartiallyBound                 = VK_TRUE;
+                    descriptor_indexing_enabled.descriptorBindingSampledImageUpdateAfterBind    = VK_TRUE;
+                    descriptor_indexing_enabled.descriptorBindingUpdateUnusedWhilePending       = VK_TRUE;
+                    descriptor_indexing_enabled.shaderSampledImageArrayNonUniformIndexing       = VK_TRUE;
+                }
+            }
+
+            if (!m_rhi_context->bindless_textures)
+            {
+                LOG_WARNING("Descriptor indexing is not supported, materials will bind their textures per draw");
+            }
+
             // Device create info
 			VkDeviceCreateInfo create_info = {};
 			{
@@ -228,6 +263,7 @@ namespace Spartan
 				create_info.pEnabledFeatures		= &device_features_enabled;
 				create_info.enabledExtensionCount	= static_cast<uint32_t>(extensions_supported.size());
 				create_info.ppEnabledExtensionNames = extensions_supported.data();
+				create_info.pNext                   = m_rhi_context->bindless_textures ? &descriptor_indexing_enabled : nullptr;
 
 				if (m_rhi_context->debug)
 				{
@@ -248,6 +284,9 @@ namespace Spartan
             vkGetDeviceQueue(m_rhi_context->device, m_rhi_context->queue_graphics_index, 0, reinterpret_cast<VkQueue*>(&m_rhi_context->queue_graphics));
             vkGetDeviceQueue(m_rhi_context->device, m_rhi_context->queue_compute_index,  0, reinterpret_cast<VkQueue*>(&m_rhi_context->queue_compute));
             vkGetDeviceQueue(m_rhi_context->device, m_rhi_context->queue_transfer_index, 0, reinterpret_cast<VkQueue*>(&m_rhi_context->queue_transfer));
+
+            // Secondary command buffers are core, every recording thread allocates them from its own pool
+            m_rhi_context->parallel_recording = true;
 		}
 
 		// Detect and log version
@@ -278,10 +278,17 @@ namespace Spartan
         // Pipeline layout
 		VkPipelineLayoutCreateInfo pipeline_layout_info	= {};
         { 
+            // The pass resources go in the first set, the bindless textures (if supported) in the second
+            VkDescriptorSetLayout layouts[2] =
+            {
+                static_cast<VkDescriptorSetLayout>(descriptor_set_layout),
+                m_rhi_device->GetContextRhi()->bindless_descriptor_set_layout
+            };
+
 		    pipeline_layout_info.sType						= VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
 		    pipeline_layout_info.pushConstantRangeCount		= 0;
-		    pipeline_layout_info.setLayoutCount				= 1;		
-		    pipeline_layout_info.pSetLayouts				= reinterpret_cast<VkDescriptorSetLayout*>(&descriptor_set_layout);
+		    pipeline_layout_info.setLayoutCount				= layouts[1] ? 2 : 1;
+		    pipeline_layout_info.pSetLayouts				= layouts;
 
             if (!vulkan_common::error::check(vkCreatePipelineLayout(m_rhi_device->GetContextRhi()->device, &pipeline_layout_info, nullptr, reinterpret_cast<VkPipelineLayout*>(&m_pipeline_layout))))
 			    return;
@@ -305,7 +312,7 @@ namespace Spartan
 		    pipeline_info.renderPass					= static_cast<VkRenderPass>(m_state.GetRenderPass());
 
             auto pipeline = reinterpret_cast<VkPipeline*>(&m_pipeline);
-            vulkan_common::error::check(vkCreateGraphicsPipelines(m_rhi_device->GetContextRhi()->device, nullptr, 1, &pipeline_info, nullptr, pipeline));
+            vulkan_common::error::check(vkCreateGraphicsPipelines(m_rhi_device->GetContextRhi()->device, m_rhi_device->GetContextRhi()->pipeline_cache, 1, &pipeline_info, nullptr, pipeline));
 
             // Set pipeline name
             string name = (m_state.shader_vertex ? m_state.shader_vertex->GetName() : "null") + "-" + (m_state.shader_pixel ? m_state.shader_pixel->GetName() : "null");
@@ -0,0 +1,102 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION ===============
+#include "../RHI_Implementation.h"
+#ifdef API_GRAPHICS_VULKAN
+//================================
+
+//= INCLUDES ==================
+#include "../RHI_PipelineCache.h"
+#include "../RHI_Device.h"
+//=============================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    bool RHI_PipelineCache::CreateDriverCache(const vector<std::byte>& data)
+    {
+        DestroyDriverCache();
+
+        RHI_Context* rhi_context = m_rhi_device->GetContextRhi();
+
+        // The driver rejects foreign data anyway but the header is cheap to check, a new GPU or driver means starting over
+        bool is_compatible = data.size() >= 16 + VK_UUID_SIZE;
+        if (is_compatible)
+        {
+            uint32_t header[4];
+            memcpy(header, data.data(), sizeof(header));
+
+            is_compatible =
+                header[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE                   &&
+                header[2] == rhi_context->device_properties.vendorID                &&
+                header[3] == rhi_context->device_properties.deviceID                &&
+                memcmp(data.data() + 16, rhi_context->device_properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+        }
+
+        VkPipelineCacheCreateInfo create_info   = {};
+        create_info.sType                       = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        create_info.initialDataSize             = is_compatible ? data.size() : 0;
+        create_info.pInitialData                = is_compatible ? data.data() : nullptr;
+
+        if (!vulkan_common::error::check(vkCreatePipelineCache(rhi_context->device, &create_info, nullptr, reinterpret_cast<VkPipelineCache*>(&m_driver_cache))))
+            return false;
+
+        // Pipelines are created against the device's cache
+        rhi_context->pipeline_cache = static_cast<VkPipelineCache>(m_driver_cache);
+
+        return true;
+    }
+
+    void RHI_PipelineCache::GetDriverCacheData(vector<std::byte>& data) const
+    {
+        data.clear();
+
+        if (!m_driver_cache)
+            return;
+
+        VkDevice device = m_rhi_device->GetContextRhi()->device;
+        size_t size     = 0;
+        if (!vulkan_common::error::check(vkGetPipelineCacheData(device, static_cast<VkPipelineCache>(m_driver_cache), &size, nullptr)))
+            return;
+
+        data.resize(size);
+        if (!vulkan_common::error::check(vkGetPipelineCacheData(device, static_cast<VkPipelineCache>(m_driver_cache), &size, data.data())))
+        {
+            data.clear();
+        }
+    }
+
+    void RHI_PipelineCache::DestroyDriverCache()
+    {
+        if (!m_driver_cache)
+            return;
+
+        RHI_Context* rhi_context = m_rhi_device->GetContextRhi();
+        vkDestroyPipelineCache(rhi_context->device, static_cast<VkPipelineCache>(m_driver_cache), nullptr);
+        rhi_context->pipeline_cache = nullptr;
+        m_driver_cache              = nullptr;
+    }
+}
+#endif
@@ -343,7 +343,36 @@ namespace Spartan
 		};
 	}
 	
-	void* RHI_Shader::_Compile(const string& shader)
+    string RHI_Shader::GetCompilerVersion()
+    {
+        // Whichever dxcompiler.dll gets loaded, including the commit it was built from (if it reports one)
+        string version = "dxc";
+
+        CComPtr<IDxcVersionInfo> version_info = nullptr;
+        if (SUCCEEDED(DxShaderCompiler::Instance::Get().compiler->QueryInterface(&version_info)))
+        {
+            UINT32 major = 0;
+            UINT32 minor = 0;
+            version_info->GetVersion(&major, &minor);
+            version += "_" + to_string(major) + "." + to_string(minor);
+        }
+
+        CComPtr<IDxcVersionInfo2> version_info_commit = nullptr;
+        if (SUCCEEDED(DxShaderCompiler::Instance::Get().compiler->QueryInterface(&version_info_commit)))
+        {
+            UINT32 commit_count = 0;
+            char* commit_hash   = nullptr;
+            if (SUCCEEDED(version_info_commit->GetCommitInfo(&commit_count, &commit_hash)) && commit_hash)
+            {
+                version += "_" + to_string(commit_count) + "_" + commit_hash;
+                CoTaskMemFree(commit_hash);
+            }
+        }
+
+        return version;
+    }
+
+	bool RHI_Shader::_Compile(const string& shader, vector<std::byte>& bytecode)
 	{
 		// Deduce some things
         const auto is_file	    = FileSystem::IsSupportedShaderFile(shader);
@@ -423,7 +452,7 @@ namespace Spartan
 			if (FAILED(result))
 			{
 				LOG_ERROR("Failed to create source buffer.");
-				return nullptr;
+				return false;
 			}
 		}
 
@@ -443,59 +472,65 @@ namespace Spartan
 					&compilation_result))
 			){
 				LOG_ERROR("Failed to compile %s", file_name.c_str());
-				return nullptr;
+				return false;
 			}
 
 			if (!DxShaderCompiler::ValidateOperationResult(compilation_result))
 			{
 				LOG_ERROR("Failed to compile %s", shader.c_str());
-				return nullptr;
+				return false;
 			}
 		}
 		
-		// Create shader module
-		CComPtr<IDxcBlob> shader_compiled	= nullptr;
-		VkShaderModule shader_module		= nullptr;
-        if (SUCCEEDED(compilation_result->GetResult(&shader_compiled)))
+		// Get the bytecode
+		CComPtr<IDxcBlob> shader_compiled = nullptr;
+        if (FAILED(compilation_result->GetResult(&shader_compiled)) || !shader_compiled)
+		{
+            LOG_ERROR("Failed to get shader buffer.");
+            return false;
+		}
+
+        const std::byte* data = static_cast<const std::byte*>(shader_compiled->GetBufferPointer());
+        bytecode.assign(data, data + shader_compiled->GetBufferSize());
+
+        // Reflect shader resources (so that descriptor sets can be created later), cached shaders store the result
+        _Reflect
+        (
+            m_shader_type,
+            reinterpret_cast<const uint32_t*>(bytecode.data()),
+            static_cast<uint32_t>(bytecode.size() / 4)
+        );
+
+		return true;
+	}
+
+    void* RHI_Shader::_CreateResource(const vector<std::byte>& bytecode)
+    {
+        // Create shader module
+        VkShaderModuleCreateInfo create_info = {};
+        create_info.sType       = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        create_info.codeSize    = static_cast<size_t>(bytecode.size());
+        create_info.pCode       = reinterpret_cast<const uint32_t*>(bytecode.data());
+
+        VkShaderModule shader_module = nullptr;
+        if (vkCreateShaderModule(m_rhi_device->GetContextRhi()->device, &create_info, nullptr, &shader_module) != VK_SUCCESS)
         {
-			VkShaderModuleCreateInfo create_info = {};
-			create_info.sType		= VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-			create_info.codeSize	= static_cast<size_t>(shader_compiled->GetBufferSize());
-			create_info.pCode		= reinterpret_cast<const uint32_t*>(shader_compiled->GetBufferPointer());
-	
-			if (vkCreateShaderModule(m_rhi_device->GetContextRhi()->device, &create_info, nullptr, &shader_module) == VK_SUCCESS)
-			{
-				// Reflect shader resources (so that descriptor sets can be created later)
-				_Reflect
-				(
-                    m_shader_type,
-					reinterpret_cast<uint32_t*>(shader_compiled->GetBufferPointer()),
-					static_cast<uint32_t>(shader_compiled->GetBufferSize() / 4)
-				);
+            LOG_ERROR("Failed to create shader module.");
+            return nullptr;
+        }
 
-                // Create input layout
-                if (m_vertex_type != RHI_Vertex_Type_Unknown)
-                {
-                    if (!m_input_layout->Create(m_vertex_type, nullptr))
-                    {
-                        LOG_ERROR("Failed to create input layout for %s", FileSystem::GetFileNameFromFilePath(shader).c_str());
-                        return nullptr;
-                    }
-                }
-			}
-            else
+        // Create input layout
+        if (m_vertex_type != RHI_Vertex_Type_Unknown)
+        {
+            if (!m_input_layout->Create(m_vertex_type, nullptr))
             {
-                LOG_ERROR("Failed to create shader module.");
+                LOG_ERROR("Failed to create input layout for %s", FileSystem::GetFileNameFromFilePath(m_file_path).c_str());
+                vkDestroyShaderModule(m_rhi_device->GetContextRhi()->device, shader_module, nullptr);
                 return nullptr;
             }
-		}	
-        else
-		{
-            LOG_ERROR("Failed to get shader buffer.");
-            return nullptr;
-		}
+        }
 
-		return static_cast<void*>(shader_module);
-	}		
+        return static_cast<void*>(shader_module);
+    }
 }
 #endif
@@ -75,6 +75,12 @@ namespace Spartan
 		void SetName(const std::string& name)   { m_name = name; }
 		void SetDuration(double duration)       { m_duration = duration; }
 		void SetTicksPerSec(double ticksPerSec) { m_ticksPerSec = ticksPerSec; }
+		void AddChannel(AnimationNode&& channel){ m_channels.emplace_back(std::move(channel)); }
+
+		const auto& GetName()           const { return m_name; }
+		double GetDuration()            const { return m_duration; }
+		double GetTicksPerSec()         const { return m_ticksPerSec; }
+		const auto& GetChannels()       const { return m_channels; }
 
 	private:
 		std::string m_name;
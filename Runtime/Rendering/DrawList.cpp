@@ -0,0 +1,240 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =========================
+#include "DrawList.h"
+#include "Model.h"
+#include "TerrainQuadtree.h"
+#include "../Math/MathHelper.h"
+#include "../Threading/Threading.h"
+#include "../World/Entity.h"
+#include "../World/Components/Renderable.h"
+#include "../World/Components/Terrain.h"
+#include <numeric>
+#include <algorithm>
+//====================================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Spartan::Math;
+//=============================
+
+namespace Spartan
+{
+    void DrawList::Build(Threading* threading, const vector<Entity*>& entities, const cull_function& cull)
+    {
+        const uint32_t entity_count = static_cast<uint32_t>(entities.size());
+
+        // One chunk per available thread (plus the calling thread), as long as the chunks are big enough to be worth it
+        const uint32_t chunk_count_max  = threading ? threading->GetThreadsAvailable() + 1 : 1;
+        const uint32_t chunk_count      = Helper::Clamp((entity_count + chunk_size_min - 1) / chunk_size_min, 1u, chunk_count_max);
+
+        Partition(entity_count, chunk_count, m_ranges);
+        m_chunk_count = static_cast<uint32_t>(m_ranges.size());
+
+        // Chunk vectors are kept around (and so is their capacity), they act as per-thread allocators
+        if (m_chunks.size() < m_chunk_count)
+        {
+            m_chunks.resize(m_chunk_count);
+        }
+
+        if (m_chunk_count > 1)
+        {
+            // One chunk per loop iteration, the calling thread takes part and returns once every chunk is built
+            threading->AddTaskLoop([this, &entities, &cull](uint32_t start, uint32_t end)
+            {
+                for (uint32_t i = start; i < end; i++)
+                {
+                    BuildChunk(i, entities, cull);
+                }
+            }, m_chunk_count, m_chunk_count);
+        }
+        else if (m_chunk_count == 1)
+        {
+            BuildChunk(0, entities, cull);
+        }
+
+        // Merge in chunk order, this keeps the draw order deterministic
+        m_draw_calls.clear();
+        for (uint32_t i = 0; i < m_chunk_count; i++)
+        {
+            m_draw_calls.insert(m_draw_calls.end(), m_chunks[i].begin(), m_chunks[i].end());
+        }
+
+        // Every draw call is a batch of its own, until Batch() is called
+        m_batches.resize(m_draw_calls.size());
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_batches.size()); i++)
+        {
+            m_batches[i].first          = i;
+            m_batches[i].count          = 1;
+            m_batches[i].instance_index = 0;
+        }
+    }
+
+    // Draw calls with the same key can be drawn with a single instanced draw call
+    static auto batch_key(const DrawCall& draw_call)
+    {
+        return make_tuple
+        (
+            reinterpret_cast<uintptr_t>(draw_call.vertex_buffer),
+            reinterpret_cast<uintptr_t>(draw_call.index_buffer),
+            reinterpret_cast<uintptr_t>(draw_call.material),
+            draw_call.index_offset,
+            draw_call.index_count,
+            draw_call.vertex_offset
+        );
+    }
+
+    void DrawList::Batch(const uint32_t batch_size_max)
+    {
+        const uint32_t draw_call_count = static_cast<uint32_t>(m_draw_calls.size());
+        if (draw_call_count == 0 || batch_size_max <= 1)
+            return;
+
+        // Sort indices by key, the sort is stable so identical draws keep their relative order
+        m_order.resize(draw_call_count);
+        iota(m_order.begin(), m_order.end(), 0);
+        stable_sort(m_order.begin(), m_order.end(), [this](const uint32_t a, const uint32_t b)
+        {
+            return batch_key(m_draw_calls[a]) < batch_key(m_draw_calls[b]);
+        });
+
+        // Gather the draw calls in key order and cut them into batches
+        m_draw_calls_batched.clear();
+        m_batches.clear();
+        for (uint32_t i = 0; i < draw_call_count; i++)
+        {
+            const DrawCall& draw_call = m_draw_calls[m_order[i]];
+
+            const bool is_same_key  = !m_batches.empty() && batch_key(draw_call) == batch_key(m_draw_calls_batched[m_batches.back().first]);
+            const bool is_full      = !m_batches.empty() && m_batches.back().count == batch_size_max;
+            if (!is_same_key || is_full)
+            {
+                DrawBatch batch;
+                batch.first = i;
+                m_batches.emplace_back(batch);
+            }
+
+            m_draw_calls_batched.emplace_back(draw_call);
+            m_batches.back().count++;
+        }
+
+        // Order the batches by where their first draw call used to be
+        sort(m_batches.begin(), m_batches.end(), [this](const DrawBatch& a, const DrawBatch& b)
+        {
+            return m_order[a.first] < m_order[b.first];
+        });
+
+        m_draw_calls.swap(m_draw_calls_batched);
+    }
+
+    void DrawList::Clear()
+    {
+        for (vector<DrawCall>& chunk : m_chunks)
+        {
+            chunk.clear();
+        }
+
+        m_draw_calls.clear();
+        m_batches.clear();
+        m_ranges.clear();
+        m_chunk_count = 0;
+    }
+
+    void DrawList::Partition(const uint32_t count, const uint32_t chunk_count, vector<pair<uint32_t, uint32_t>>& ranges)
+    {
+        ranges.clear();
+
+        if (count == 0 || chunk_count == 0)
+            return;
+
+        // The first (count % chunks) chunks get one extra element
+        const uint32_t chunks       = Helper::Min(count, chunk_count);
+        const uint32_t chunk_size   = count / chunks;
+        const uint32_t remainder    = count % chunks;
+
+        uint32_t start = 0;
+        for (uint32_t i = 0; i < chunks; i++)
+        {
+            const uint32_t end = start + chunk_size + (i < remainder ? 1 : 0);
+            ranges.emplace_back(start, end);
+            start = end;
+        }
+    }
+
+    void DrawList::BuildChunk(const uint32_t chunk_index, const vector<Entity*>& entities, const cull_function& cull)
+    {
+        vector<DrawCall>& draw_calls = m_chunks[chunk_index];
+        draw_calls.clear();
+
+        for (uint32_t i = m_ranges[chunk_index].first; i < m_ranges[chunk_index].second; i++)
+        {
+            Entity* entity = entities[i];
+
+            DrawCall draw_call;
+            draw_call.entity        = entity;
+            draw_call.transform     = entity->GetTransform();
+            draw_call.renderable    = entity->GetRenderable();
+            draw_call.entity_index  = i;
+
+            Renderable* renderable = draw_call.renderable;
+            if (!renderable)
+                continue;
+
+            // A terrain draws every patch it selected (sharing the terrain's material and transform), its own geometry is a low LOD mesh for colliders and picking
+            if (const Terrain* terrain = entity->GetComponent<Terrain>())
+            {
+                for (const TerrainPatch& patch : terrain->GetPatches())
+                {
+                    draw_call.vertex_buffer = patch.vertex_buffer;
+                    draw_call.index_buffer  = patch.index_buffer;
+                    draw_call.index_offset  = patch.index_offset;
+                    draw_call.index_count   = patch.index_count;
+                    draw_call.vertex_offset = 0;
+                    draw_call.aabb          = &patch.aabb;
+
+                    if (cull(draw_call))
+                    {
+                        draw_calls.emplace_back(draw_call);
+                    }
+                }
+            }
+            // Geometry
+            else if (const Model* model = renderable->GeometryModel())
+            {
+                draw_call.vertex_buffer = model->GetVertexBuffer();
+                draw_call.index_buffer  = model->GetIndexBuffer();
+                draw_call.index_offset  = renderable->GeometryIndexOffset();
+                draw_call.index_count   = renderable->GeometryIndexCount();
+                draw_call.vertex_offset = renderable->GeometryVertexOffset();
+                draw_call.aabb          = &renderable->GetAabb();
+
+                if (!draw_call.vertex_buffer || !draw_call.index_buffer)
+                    continue;
+
+                if (cull(draw_call))
+                {
+                    draw_calls.emplace_back(draw_call);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,116 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ======================
+#include <vector>
+#include <functional>
+#include "../Math/Matrix.h"
+#include "../RHI/RHI_Definition.h"
+#include "../Core/EngineDefs.h"
+//==================================
+
+namespace Spartan
+{
+    // Forward declarations
+    class Entity;
+    class Transform;
+    class Renderable;
+    class Material;
+    class Threading;
+    namespace Math { class BoundingBox; }
+
+    struct DrawCall
+    {
+        Entity* entity                          = nullptr;
+        Transform* transform                    = nullptr;
+        Renderable* renderable                  = nullptr;
+        Material* material                      = nullptr;
+        const RHI_VertexBuffer* vertex_buffer   = nullptr;
+        const RHI_IndexBuffer* index_buffer     = nullptr;
+        uint32_t index_offset                   = 0;
+        uint32_t index_count                    = 0;
+        uint32_t vertex_offset                  = 0;
+        const Math::BoundingBox* aabb           = nullptr;  // world space bounds of the geometry
+        Math::Matrix world;                                 // interpolated world matrix
+        Math::Matrix wvp;                                   // world matrix multiplied by the pass's view projection
+        uint32_t entity_index                   = 0;        // index of the entity in the source list
+        uint32_t object_index                   = 0;        // offset of the draw's data in the object buffer, assigned when the list is streamed
+        uint32_t material_index                 = 0;        // slot of the material in the material table, assigned before batching
+    };
+
+    // A run of draw calls which share geometry and material, so they can be drawn as instances of one another
+    struct DrawBatch
+    {
+        uint32_t first          = 0; // index of the first draw call
+        uint32_t count          = 0; // number of draw calls, i.e. instances
+        uint32_t instance_index = 0; // offset of the batch's data in the instance buffer, assigned when the list is streamed
+    };
+
+    // Builds the draws of a pass by splitting the entities into contiguous chunks which are culled in parallel.
+    // Terrains contribute one draw call per patch their quadtree selected, the geometry and bounds are filled in before culling.
+    // Every chunk fills its own (persistent) draw call vector and the chunks are merged in order, so the
+    // resulting draw order is identical to a sequential build, regardless of the thread count.
+    // Passes which record many draws split them the same way, see Renderer::RecordChunked().
+    class SPARTAN_CLASS DrawList
+    {
+    public:
+        // Fills in the remaining draw call data and returns false if the entity should not be drawn.
+        // It is invoked concurrently for different entities, so it must only write to the entity it's given.
+        typedef std::function<bool(DrawCall& draw_call)> cull_function;
+
+        DrawList() = default;
+        ~DrawList() = default;
+
+        // Builds the draw calls (one batch per draw call), executes in the calling thread if threading is null
+        void Build(Threading* threading, const std::vector<Entity*>& entities, const cull_function& cull);
+        // Reorders the draw calls so that identical ones are adjacent and groups them into batches of up to batch_size_max.
+        // Batches are ordered by their first draw call in the built order, so a front to back sort mostly survives.
+        void Batch(uint32_t batch_size_max);
+        void Clear();
+
+        const auto& GetDrawCalls()  const { return m_draw_calls; }
+        auto& GetDrawCalls()              { return m_draw_calls; }
+        const auto& GetBatches()    const { return m_batches; }
+        auto& GetBatches()                { return m_batches; }
+        bool IsEmpty()              const { return m_draw_calls.empty(); }
+        bool HasInstances()         const { return m_batches.size() < m_draw_calls.size(); }
+        uint32_t GetChunkCount()    const { return m_chunk_count; }
+
+        // Splits [0, count) into at most chunk_count contiguous ranges of (almost) equal size
+        static void Partition(uint32_t count, uint32_t chunk_count, std::vector<std::pair<uint32_t, uint32_t>>& ranges);
+
+        // Below this many entities per chunk, the cost of waking up a thread outweighs the culling
+        static const uint32_t chunk_size_min = 64;
+
+    private:
+        void BuildChunk(uint32_t chunk_index, const std::vector<Entity*>& entities, const cull_function& cull);
+
+        std::vector<std::pair<uint32_t, uint32_t>> m_ranges;
+        std::vector<std::vector<DrawCall>> m_chunks;
+        std::vector<DrawCall> m_draw_calls;
+        std::vector<DrawCall> m_draw_calls_batched;
+        std::vector<DrawBatch> m_batches;
+        std::vector<uint32_t> m_order;
+        uint32_t m_chunk_count = 0;
+    };
+}
@@ -28,6 +28,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../../RHI/RHI_IndexBuffer.h"
 #include "../../Resource/ResourceCache.h"
 #include "../../Resource/Import/FontImporter.h"
+#include "../../Utilities/Hash.h"
 //=============================================
 
 //= NAMESPACES ================
@@ -41,6 +42,35 @@ using namespace Spartan::Math;
 
 namespace Spartan
 {
+	static const uint32_t glyph_fallback		= '?';
+	static const uint64_t text_layout_lifetime	= 60; // frames a layout is kept for after it was last drawn
+
+	// Returns the code point which starts at index and moves index past it, malformed sequences decode to U+FFFD
+	static uint32_t decode_utf8(const string& text, size_t& index)
+	{
+		const auto byte_at		= [&text](const size_t i) { return static_cast<uint8_t>(text[i]); };
+		const uint8_t lead		= byte_at(index++);
+		const uint32_t invalid	= 0xFFFD;
+
+		uint32_t code_point		= 0;
+		uint32_t continuation	= 0;
+		if (lead < 0x80)				return lead;
+		else if ((lead & 0xE0) == 0xC0)	{ code_point = lead & 0x1F; continuation = 1; }
+		else if ((lead & 0xF0) == 0xE0)	{ code_point = lead & 0x0F; continuation = 2; }
+		else if ((lead & 0xF8) == 0xF0)	{ code_point = lead & 0x07; continuation = 3; }
+		else							return invalid;
+
+		for (uint32_t i = 0; i < continuation; i++)
+		{
+			if (index >= text.size() || (byte_at(index) & 0xC0) != 0x80)
+				return invalid;
+
+			code_point = (code_point << 6) | (byte_at(index++) & 0x3F);
+		}
+
+		return code_point;
+	}
+
 	Font::Font(Context* context, const string& file_path, const int font_size, const Vector4& color) : IResource(context, Resource_Font)
 	{
 		m_rhi_device		= m_context->GetSubsystem<Renderer>()->GetRhiDevice();
@@ -74,81 +104,159 @@ namespace Spartan
 		}
 
 		// Find max character height (todo, actually get spacing from FreeType)
-		for (const auto& char_info : m_glyphs)
+		for (const Glyph& glyph : m_glyphs)
 		{
-			m_char_max_width	= Helper::Max<int>(char_info.second.width, m_char_max_width);
-			m_char_max_height	= Helper::Max<int>(char_info.second.height, m_char_max_height);
+			m_char_max_width	= Helper::Max<int>(glyph.width, m_char_max_width);
+			m_char_max_height	= Helper::Max<int>(glyph.height, m_char_max_height);
 		}
 		
 		LOG_INFO("Loading \"%s\" took %d ms", FileSystem::GetFileNameFromFilePath(file_path).c_str(), static_cast<int>(timer.GetElapsedTimeMs()));
 		return true;
 	}
 
-	void Font::SetText(const string& text, const Vector2& position)
+	void Font::AddText(const string& text, const Vector2& position)
 	{
-        const bool same_text      = text == m_current_text;
-        const bool has_buffers    = (m_vertex_buffer && m_index_buffer);
-
-		if (same_text || !has_buffers)
+		if (text.empty())
 			return;
 
-        Vector2 pen = position;
-		m_current_text = text;
-		m_vertices.clear();
-	
-		// Draw each letter onto a quad.
-		for (auto text_char : m_current_text)
+		const auto& layout = GetLayout(text);
+		m_queue.push_back({ &layout.first, &layout.second, position });
+	}
+
+	bool Font::UpdateVertexBuffer()
+	{
+		const bool has_buffers = (m_vertex_buffer && m_index_buffer);
+		if (!has_buffers)
+			return false;
+
+		// Identical batches (same strings at the same positions) are already in the vertex buffer
+		uint64_t batch_hash = 0;
+		for (const TextQueued& queued : m_queue)
 		{
-			auto glyph = m_glyphs[text_char];
+			batch_hash = Utility::Hash::hash_64(queued.text->data(), queued.text->size(), batch_hash);
+			batch_hash = Utility::Hash::hash_64(&queued.position, sizeof(queued.position), batch_hash);
+		}
 
-			if (text_char == ASCII_TAB)
+		bool result = true;
+		if (batch_hash != m_batch_hash || m_queue.empty())
+		{
+			BuildVertices();
+			result			= UpdateBuffers();
+			m_batch_hash	= batch_hash;
+		}
+
+		return result;
+	}
+
+	void Font::ClearText()
+	{
+		m_queue.clear();
+
+		// Evict the layouts of text which is no longer drawn
+		m_frame++;
+		if (m_frame % text_layout_lifetime == 0)
+		{
+			for (auto it = m_layouts.begin(); it != m_layouts.end();)
 			{
-				const auto space_offset		        = m_glyphs[ASCII_SPACE].horizontal_advance;
+				it = (m_frame - it->second.frame > text_layout_lifetime) ? m_layouts.erase(it) : next(it);
+			}
+		}
+	}
+
+	void Font::SetGlyph(const uint32_t char_code, const Glyph& glyph)
+	{
+		if (char_code >= m_glyphs.size())
+		{
+			m_glyphs.resize(char_code + 1);
+		}
+
+		m_glyphs[char_code] = glyph;
+	}
+
+	const pair<const string, Font::TextLayout>& Font::GetLayout(const string& text)
+	{
+		const auto result	= m_layouts.try_emplace(text);
+		TextLayout& layout	= result.first->second;
+		layout.frame		= m_frame;
+
+		// Only new strings are laid out
+		if (result.second)
+		{
+			Layout(text, layout.vertices);
+		}
+
+		return *result.first;
+	}
+
+	void Font::Layout(const string& text, vector<RHI_Vertex_PosTex>& vertices) const
+	{
+		Vector2 pen = Vector2::Zero;
+
+		for (size_t i = 0; i < text.size();)
+		{
+			const uint32_t code_point	= decode_utf8(text, i);
+			const Glyph& glyph			= GetGlyph(code_point);
+
+			if (code_point == ASCII_TAB)
+			{
+				const auto space_offset		        = GetGlyph(ASCII_SPACE).horizontal_advance;
 				const auto space_count		        = 8; // spaces in a typical terminal
 				const auto tab_spacing		        = space_offset * space_count;
-				const auto column_header	        = int(pen.x - position.x); // -position.x because it has to be zero based so we can do the mod below
+				const auto column_header	        = int(pen.x);
 				const auto offset_to_next_tab_stop  = tab_spacing - (column_header % (tab_spacing != 0 ? tab_spacing : 1));
 				pen.x                               += offset_to_next_tab_stop;
 				continue;
 			}
 
-			if (text_char == ASCII_NEW_LINE)
+			if (code_point == ASCII_NEW_LINE)
 			{
 				pen.y -= m_char_max_height;
-				pen.x = position.x;
+				pen.x = 0.0f;
 				continue;
 			}
 
-			if (text_char == ASCII_SPACE)
+			if (code_point == ASCII_SPACE)
 			{
 				pen.x += glyph.horizontal_advance;
 				continue;
 			}
 
-            // Any other char
+            // Any other char, a quad (the index buffer turns it into two triangles)
             {
-			    // First triangle in quad.		
-			    m_vertices.emplace_back(pen.x + glyph.offset_x,                 pen.y + glyph.offset_y,                  0.0f, glyph.uv_x_left,  glyph.uv_y_top);       // top left
-			    m_vertices.emplace_back(pen.x + glyph.offset_x  + glyph.width,  pen.y + glyph.offset_y - glyph.height,   0.0f, glyph.uv_x_right, glyph.uv_y_bottom);    // bottom right
-			    m_vertices.emplace_back(pen.x + glyph.offset_x,                 pen.y + glyph.offset_y - glyph.height,   0.0f, glyph.uv_x_left,  glyph.uv_y_bottom);    // bottom left
-			    // Second triangle in quad.
-			    m_vertices.emplace_back(pen.x + glyph.offset_x,                 pen.y + glyph.offset_y,                  0.0f, glyph.uv_x_left,  glyph.uv_y_top);       // top left
-			    m_vertices.emplace_back(pen.x + glyph.offset_x	+ glyph.width,	pen.y + glyph.offset_y,                  0.0f, glyph.uv_x_right, glyph.uv_y_top);       // top right
-			    m_vertices.emplace_back(pen.x + glyph.offset_x	+ glyph.width,	pen.y + glyph.offset_y - glyph.height,   0.0f, glyph.uv_x_right, glyph.uv_y_bottom);    // bottom right
+			    vertices.emplace_back(pen.x + glyph.offset_x,                 pen.y + glyph.offset_y,                  0.0f, glyph.uv_x_left,  glyph.uv_y_top);       // top left
+			    vertices.emplace_back(pen.x + glyph.offset_x  + glyph.width,  pen.y + glyph.offset_y - glyph.height,   0.0f, glyph.uv_x_right, glyph.uv_y_bottom);    // bottom right
+			    vertices.emplace_back(pen.x + glyph.offset_x,                 pen.y + glyph.offset_y - glyph.height,   0.0f, glyph.uv_x_left,  glyph.uv_y_bottom);    // bottom left
+			    vertices.emplace_back(pen.x + glyph.offset_x	+ glyph.width,	pen.y + glyph.offset_y,                  0.0f, glyph.uv_x_right, glyph.uv_y_top);       // top right
 
 			    // Advance
 			    pen.x += glyph.horizontal_advance;
             }
 		}
-		m_vertices.shrink_to_fit();		
-		
-		m_indices.clear();
-		for (uint32_t i = 0; i < m_vertices.size(); i++)
+	}
+
+	const Glyph& Font::GetGlyph(const uint32_t code_point) const
+	{
+		static const Glyph glyph_empty;
+
+		// Code points the font doesn't have are drawn as a question mark
+		if (code_point < m_glyphs.size() && m_glyphs[code_point].horizontal_advance != 0)
+			return m_glyphs[code_point];
+
+		return glyph_fallback < m_glyphs.size() ? m_glyphs[glyph_fallback] : glyph_empty;
+	}
+
+	void Font::BuildVertices()
+	{
+		m_vertices.clear();
+		for (const TextQueued& queued : m_queue)
 		{
-			m_indices.emplace_back(i);
+			for (RHI_Vertex_PosTex vertex : queued.layout->vertices)
+			{
+				vertex.pos[0] += queued.position.x;
+				vertex.pos[1] += queued.position.y;
+				m_vertices.emplace_back(vertex);
+			}
 		}
-
-		UpdateBuffers(m_vertices, m_indices);
 	}
 
 	void Font::SetSize(const uint32_t size)
@@ -156,7 +264,7 @@ namespace Spartan
 		m_font_size = Helper::Clamp<uint32_t>(size, 8, 50);
 	}
 
-	bool Font::UpdateBuffers(vector<RHI_Vertex_PosTex>& vertices, vector<uint32_t>& indices) const
+	bool Font::UpdateBuffers()
 	{
 		if (!m_context || !m_vertex_buffer || !m_index_buffer)
 		{
@@ -164,32 +272,43 @@ namespace Spartan
 			return false;
 		}
 
-		// Grow buffers (if needed)
-		if (vertices.size() > m_vertex_buffer->GetVertexCount())
+		const uint32_t quad_count	= static_cast<uint32_t>(m_vertices.size() / 4);
+		m_index_count				= quad_count * 6;
+		if (quad_count == 0)
+			return true;
+
+		// Grow buffers (if needed), the indices are the same for every batch so they are only written when growing
+		if (m_vertices.size() > m_vertex_buffer->GetVertexCount())
 		{
 			// Vertex buffer
-			if (!m_vertex_buffer->CreateDynamic<RHI_Vertex_PosTex>(static_cast<uint32_t>(vertices.size())))
+			if (!m_vertex_buffer->CreateDynamic<RHI_Vertex_PosTex>(static_cast<uint32_t>(m_vertices.size())))
 			{
 				LOG_ERROR("Failed to update vertex buffer.");
 				return false;
 			}
 
-			// Index buffer
-			if (!m_index_buffer->CreateDynamic<uint32_t>(static_cast<uint32_t>(indices.size())))
+			// Index buffer, two triangles per quad (top left, bottom right, bottom left and top left, top right, bottom right)
+			m_indices.clear();
+			for (uint32_t i = 0; i < quad_count; i++)
+			{
+				const uint32_t vertex = i * 4;
+				m_indices.insert(m_indices.end(), { vertex, vertex + 1, vertex + 2, vertex, vertex + 3, vertex + 1 });
+			}
+
+			if (!m_index_buffer->CreateDynamic<uint32_t>(static_cast<uint32_t>(m_indices.size())))
 			{
 				LOG_ERROR("Failed to update index buffer.");
 				return false;
 			}
+
+			const auto index_buffer = static_cast<uint32_t*>(m_index_buffer->Map());
+			copy(m_indices.begin(), m_indices.end(), index_buffer);
+			if (!m_index_buffer->Unmap())
+				return false;
 		}
 
 		const auto vertex_buffer = static_cast<RHI_Vertex_PosTex*>(m_vertex_buffer->Map());
-		copy(vertices.begin(), vertices.end(), vertex_buffer);
-		const auto vertex = m_vertex_buffer->Unmap();
-
-		const auto index_buffer = static_cast<uint32_t*>(m_index_buffer->Map());
-		copy(indices.begin(), indices.end(), index_buffer);
-		const auto index = m_index_buffer->Unmap();
-
-		return vertex && index;
+		copy(m_vertices.begin(), m_vertices.end(), vertex_buffer);
+		return m_vertex_buffer->Unmap();
 	}
 }
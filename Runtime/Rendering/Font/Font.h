@@ -23,21 +23,19 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ========================
 #include <memory>
+#include <vector>
 #include <unordered_map>
 #include "Glyph.h"
 #include "../../RHI/RHI_Definition.h"
 #include "../../Core/EngineDefs.h"
 #include "../../Resource/IResource.h"
+#include "../../Math/Vector2.h"
 #include "../../Math/Vector4.h"
+#include "../../RHI/RHI_Vertex.h"
 //===================================
 
 namespace Spartan
 {
-	namespace Math
-	{
-		class Vector2;
-	}
-
 	enum Font_Hinting_Type
 	{
 		Font_Hinting_None,
@@ -64,7 +62,12 @@ namespace Spartan
 		bool LoadFromFile(const std::string& file_path) override;
 		//======================================================
 
-		void SetText(const std::string& text, const Math::Vector2& position);
+		// Queues UTF-8 text to be drawn this frame, at a position in pixels relative to the center of the screen
+		void AddText(const std::string& text, const Math::Vector2& position);
+		// Builds the vertices of all the queued text (from cached layouts) and uploads them
+		bool UpdateVertexBuffer();
+		// Empties the queue, once at the end of every frame (whether the frame got to draw the text or not)
+		void ClearText();
 		void SetSize(uint32_t size);
 
 		const Math::Vector4& GetColor()                                 const { return m_color; }
@@ -87,14 +90,33 @@ namespace Spartan
 
 		const auto& GetIndexBuffer()                                    const { return m_index_buffer; }
 		const auto& GetVertexBuffer()                                   const { return m_vertex_buffer; }
-        uint32_t GetIndexCount()                                        const { return static_cast<uint32_t>(m_indices.size()); }
+        uint32_t GetIndexCount()                                        const { return m_index_count; }
         uint32_t GetSize()                                              const { return m_font_size; }
-		void SetGlyph(const uint32_t char_code, const Glyph& glyph)			  { m_glyphs[char_code] = glyph; }
+		void SetGlyph(uint32_t char_code, const Glyph& glyph);
         Font_Hinting_Type GetHinting()                                  const { return m_hinting; }
 		auto GetForceAutohint()                                         const { return m_force_autohint; }
 			
-	private:	
-		bool UpdateBuffers(std::vector<RHI_Vertex_PosTex>& vertices, std::vector<uint32_t>& indices) const;
+	private:
+		// The quads of a string, relative to where it starts
+		struct TextLayout
+		{
+			std::vector<RHI_Vertex_PosTex> vertices;
+			uint64_t frame = 0; // last frame it was drawn, unused layouts are evicted
+		};
+
+		// Points into m_layouts, whose keys and values don't move until they are evicted
+		struct TextQueued
+		{
+			const std::string* text		= nullptr;
+			const TextLayout* layout	= nullptr;
+			Math::Vector2 position;
+		};
+
+		const std::pair<const std::string, TextLayout>& GetLayout(const std::string& text);
+		void Layout(const std::string& text, std::vector<RHI_Vertex_PosTex>& vertices) const;
+		const Glyph& GetGlyph(uint32_t code_point) const;
+		void BuildVertices();
+		bool UpdateBuffers();
 
 		uint32_t m_font_size	        = 14;
         uint32_t m_outline_size         = 2;
@@ -103,12 +125,16 @@ namespace Spartan
         Font_Outline_Type m_outline     = Font_Outline_Positive;
 		Math::Vector4 m_color           = Math::Vector4(1.0f, 1.0f, 1.0f, 1.0f);
         Math::Vector4 m_color_outline   = Math::Vector4(0.0f, 0.0f, 0.0f, 1.0f);
-		std::string m_current_text;
 		uint32_t m_char_max_width;
 		uint32_t m_char_max_height;
+		uint32_t m_index_count		= 0;
+		uint64_t m_frame			= 0;
+		uint64_t m_batch_hash		= 0; // of the last uploaded batch, identical batches aren't uploaded again
 		std::shared_ptr<RHI_Texture> m_atlas;
         std::shared_ptr<RHI_Texture> m_atlas_outline;
-		std::unordered_map<uint32_t, Glyph> m_glyphs;
+		std::vector<Glyph> m_glyphs; // indexed by code point
+		std::unordered_map<std::string, TextLayout> m_layouts;
+		std::vector<TextQueued> m_queue;
 		std::shared_ptr<RHI_VertexBuffer> m_vertex_buffer;
 		std::shared_ptr<RHI_IndexBuffer> m_index_buffer;
 		std::vector<RHI_Vertex_PosTex> m_vertices;
@@ -0,0 +1,266 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES =======================
+#include "LightGrid.h"
+#include "../Math/MathHelper.h"
+#include "../Threading/Threading.h"
+#include "../Logging/Log.h"
+//==================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+namespace Spartan
+{
+    void LightGrid::Build(const vector<BufferLightGridLight>& lights, const Matrix& view, const Matrix& projection, const float near_plane, const float far_plane)
+    {
+        UpdateClusterBounds(projection, near_plane, far_plane);
+
+        // Depth slice = log(z) * scale + bias, which the shaders evaluate too
+        const float log_far_near    = log(far_plane / near_plane);
+        m_lights.slice_scale        = static_cast<float>(light_grid_z) / log_far_near;
+        m_lights.slice_bias         = -static_cast<float>(light_grid_z) * log(near_plane) / log_far_near;
+
+        auto slice = [this](const float z)
+        {
+            return static_cast<uint32_t>(Helper::Clamp(static_cast<int32_t>(floor(log(z) * m_lights.slice_scale + m_lights.slice_bias)), 0, static_cast<int32_t>(light_grid_z) - 1));
+        };
+
+        auto tile = [](const float uv, const uint32_t tile_count)
+        {
+            return static_cast<uint32_t>(Helper::Clamp(static_cast<int32_t>(floor(uv * tile_count)), 0, static_cast<int32_t>(tile_count) - 1));
+        };
+
+        // Bound the visible lights in cluster space, using the screen rectangle their view space box projects to
+        m_light_bounds.clear();
+        m_lights.light_count = 0.0f;
+        for (uint32_t light_index = 0; light_index < static_cast<uint32_t>(lights.size()); light_index++)
+        {
+            const BufferLightGridLight& light = lights[light_index];
+
+            LightBounds bounds;
+            bounds.center = Vector3(light.position_range.x, light.position_range.y, light.position_range.z) * view;
+            bounds.radius = light.position_range.w;
+            bounds.source = light_index;
+
+            const float z_min = bounds.center.z - bounds.radius;
+            const float z_max = bounds.center.z + bounds.radius;
+            if (z_max <= near_plane || z_min >= far_plane)
+                continue;
+
+            bounds.z_min = slice(Helper::Max(z_min, near_plane));
+            bounds.z_max = slice(Helper::Min(z_max, far_plane));
+
+            // Lights which cross the near plane can cover any part of the screen
+            bounds.x_max = light_grid_x - 1;
+            bounds.y_max = light_grid_y - 1;
+            if (z_min > near_plane)
+            {
+                const float x_min = Helper::Min((bounds.center.x - bounds.radius) / z_min, (bounds.center.x - bounds.radius) / z_max) * projection.m00;
+                const float x_max = Helper::Max((bounds.center.x + bounds.radius) / z_min, (bounds.center.x + bounds.radius) / z_max) * projection.m00;
+                const float y_min = Helper::Min((bounds.center.y - bounds.radius) / z_min, (bounds.center.y - bounds.radius) / z_max) * projection.m11;
+                const float y_max = Helper::Max((bounds.center.y + bounds.radius) / z_min, (bounds.center.y + bounds.radius) / z_max) * projection.m11;
+                if (x_max < -1.0f || x_min > 1.0f || y_max < -1.0f || y_min > 1.0f)
+                    continue;
+
+                // Tiles go from the top of the screen to the bottom, like texture coordinates
+                bounds.x_min = tile(x_min * 0.5f + 0.5f, light_grid_x);
+                bounds.x_max = tile(x_max * 0.5f + 0.5f, light_grid_x);
+                bounds.y_min = tile(0.5f - y_max * 0.5f, light_grid_y);
+                bounds.y_max = tile(0.5f - y_min * 0.5f, light_grid_y);
+            }
+
+            // The shaders can only index so many lights, the rest are binned but left out of the clusters
+            const uint32_t index = static_cast<uint32_t>(m_light_bounds.size());
+            if (index < light_grid_lights)
+            {
+                m_lights.lights[index] = light;
+                m_lights.light_count++;
+            }
+
+            m_light_bounds.emplace_back(bounds);
+        }
+
+        // Bin
+        m_slices.resize(light_grid_z);
+        if (m_threading)
+        {
+            m_threading->AddTaskLoop([this](uint32_t start, uint32_t end) { for (uint32_t z = start; z < end; z++) { BinSlice(z); } }, light_grid_z);
+        }
+        else
+        {
+            for (uint32_t z = 0; z < light_grid_z; z++) { BinSlice(z); }
+        }
+
+        // A light is either in every cluster it touches or in none, lights which don't fit
+        // in the buffers (by count or by the indices they need) are left for the caller to shade
+        const uint32_t light_count = static_cast<uint32_t>(m_light_bounds.size());
+        m_light_assignments.assign(light_count, 0);
+        m_assignment_count = 0;
+        for (const Slice& slice : m_slices)
+        {
+            for (const uint32_t light : slice.lights)
+            {
+                m_light_assignments[light]++;
+            }
+            m_assignment_count += static_cast<uint32_t>(slice.lights.size());
+        }
+
+        m_light_clustered.assign(light_count, false);
+        m_overflow.clear();
+        m_clustered_count       = 0;
+        uint32_t indices_left   = light_grid_indices;
+        for (uint32_t light = 0; light < light_count; light++)
+        {
+            if (light < light_grid_lights && m_light_assignments[light] <= indices_left)
+            {
+                m_light_clustered[light] = true;
+                indices_left -= m_light_assignments[light];
+                m_clustered_count++;
+            }
+            else
+            {
+                m_overflow.emplace_back(m_light_bounds[light].source);
+            }
+        }
+
+        if (!m_overflow.empty() && !m_overflow_logged)
+        {
+            LOG_WARNING("%d lights don't fit in the light grid, they are shaded by their own passes", static_cast<int>(m_overflow.size()));
+        }
+        m_overflow_logged = !m_overflow.empty();
+
+        // Gather the slices into the cluster and index buffers, in cluster order
+        uint8_t* indices    = reinterpret_cast<uint8_t*>(m_indices.indices);
+        m_index_count       = 0;
+        for (uint32_t z = 0; z < light_grid_z; z++)
+        {
+            const Slice& slice = m_slices[z];
+
+            for (uint32_t tile_index = 0; tile_index < light_grid_x * light_grid_y; tile_index++)
+            {
+                const uint32_t offset = m_index_count;
+                for (uint32_t i = slice.offsets[tile_index]; i < slice.offsets[tile_index + 1]; i++)
+                {
+                    const uint32_t light = slice.lights[i];
+                    if (m_light_clustered[light])
+                    {
+                        indices[m_index_count++] = static_cast<uint8_t>(light);
+                    }
+                }
+
+                m_clusters.clusters[z * light_grid_x * light_grid_y + tile_index] = offset | ((m_index_count - offset) << 16);
+            }
+        }
+    }
+
+    void LightGrid::UpdateClusterBounds(const Matrix& projection, const float near_plane, const float far_plane)
+    {
+        if (!m_cluster_bounds.empty() && m_projection == projection && m_near_plane == near_plane && m_far_plane == far_plane)
+            return;
+
+        m_projection    = projection;
+        m_near_plane    = near_plane;
+        m_far_plane     = far_plane;
+
+        // A cluster spans its tile's frustum between two depth slices, its box encloses both ends
+        m_cluster_bounds.resize(light_grid_clusters);
+        for (uint32_t z = 0; z < light_grid_z; z++)
+        {
+            const float depth_near  = near_plane * pow(far_plane / near_plane, static_cast<float>(z) / light_grid_z);
+            const float depth_far   = near_plane * pow(far_plane / near_plane, static_cast<float>(z + 1) / light_grid_z);
+
+            for (uint32_t y = 0; y < light_grid_y; y++)
+            {
+                const float ndc_top     = 1.0f - 2.0f * y / light_grid_y;
+                const float ndc_bottom  = 1.0f - 2.0f * (y + 1) / light_grid_y;
+
+                for (uint32_t x = 0; x < light_grid_x; x++)
+                {
+                    const float ndc_left    = -1.0f + 2.0f * x / light_grid_x;
+                    const float ndc_right   = -1.0f + 2.0f * (x + 1) / light_grid_x;
+
+                    ClusterBounds& bounds = m_cluster_bounds[z * light_grid_x * light_grid_y + y * light_grid_x + x];
+                    bounds.min.x = Helper::Min(ndc_left * depth_near, ndc_left * depth_far) / projection.m00;
+                    bounds.max.x = Helper::Max(ndc_right * depth_near, ndc_right * depth_far) / projection.m00;
+                    bounds.min.y = Helper::Min(ndc_bottom * depth_near, ndc_bottom * depth_far) / projection.m11;
+                    bounds.max.y = Helper::Max(ndc_top * depth_near, ndc_top * depth_far) / projection.m11;
+                    bounds.min.z = depth_near;
+                    bounds.max.z = depth_far;
+                }
+            }
+        }
+    }
+
+    void LightGrid::BinSlice(const uint32_t z)
+    {
+        const uint32_t tile_count = light_grid_x * light_grid_y;
+
+        Slice& slice = m_slices[z];
+        slice.assignments.clear();
+        slice.offsets.assign(tile_count + 1, 0);
+
+        // Test every light against the tiles it can touch
+        for (uint32_t light = 0; light < static_cast<uint32_t>(m_light_bounds.size()); light++)
+        {
+            const LightBounds& bounds = m_light_bounds[light];
+            if (z < bounds.z_min || z > bounds.z_max)
+                continue;
+
+            const float radius_squared = bounds.radius * bounds.radius;
+            for (uint32_t y = bounds.y_min; y <= bounds.y_max; y++)
+            {
+                for (uint32_t x = bounds.x_min; x <= bounds.x_max; x++)
+                {
+                    const uint32_t tile_index       = y * light_grid_x + x;
+                    const ClusterBounds& cluster    = m_cluster_bounds[z * tile_count + tile_index];
+
+                    // Sphere against box
+                    const Vector3 closest   = Vector3(Helper::Clamp(bounds.center.x, cluster.min.x, cluster.max.x), Helper::Clamp(bounds.center.y, cluster.min.y, cluster.max.y), Helper::Clamp(bounds.center.z, cluster.min.z, cluster.max.z));
+                    const Vector3 delta     = closest - bounds.center;
+                    if (delta.x * delta.x + delta.y * delta.y + delta.z * delta.z <= radius_squared)
+                    {
+                        slice.assignments.emplace_back(tile_index, light);
+                        slice.offsets[tile_index + 1]++;
+                    }
+                }
+            }
+        }
+
+        // Group by tile (counting sort, lights stay in order within a tile)
+        for (uint32_t i = 0; i < tile_count; i++)
+        {
+            slice.offsets[i + 1] += slice.offsets[i];
+        }
+
+        slice.lights.resize(slice.assignments.size());
+        vector<uint32_t>& cursors = slice.cursors;
+        cursors.assign(slice.offsets.begin(), slice.offsets.end() - 1);
+        for (const auto& assignment : slice.assignments)
+        {
+            slice.lights[cursors[assignment.first]++] = assignment.second;
+        }
+    }
+}
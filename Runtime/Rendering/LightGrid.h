@@ -0,0 +1,111 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+//= INCLUDES =======================
+#include <vector>
+#include "Renderer_ConstantBuffers.h"
+#include "../Core/EngineDefs.h"
+//==================================
+
+namespace Spartan
+{
+    // Forward declarations
+    class Threading;
+
+    // Bins lights into the clusters of the camera's view frustum (screen tiles times exponential depth slices).
+    // Every cluster gets the lights whose bounding sphere touches it, so a single pass can shade hundreds of them.
+    class SPARTAN_CLASS LightGrid
+    {
+    public:
+        LightGrid(Threading* threading) { m_threading = threading; }
+        ~LightGrid() = default;
+
+        // The lights are in world space, each depth slice is binned as a separate task
+        void Build(const std::vector<BufferLightGridLight>& lights, const Math::Matrix& view, const Math::Matrix& projection, float near_plane, float far_plane);
+
+        // What the shaders read
+        const auto& GetLights()         const { return m_lights; }
+        const auto& GetClusters()       const { return m_clusters; }
+        const auto& GetIndices()        const { return m_indices; }
+        uint32_t GetLightCount()        const { return static_cast<uint32_t>(m_lights.light_count); }
+        uint32_t GetIndexCount()        const { return m_index_count; }
+        // Lights the clusters reference, the buffers can hold fewer than the lights which are in view
+        uint32_t GetClusteredCount()    const { return m_clustered_count; }
+        // Light to cluster assignments, more than the index count when lights didn't fit in the buffers
+        uint32_t GetAssignmentCount()   const { return m_assignment_count; }
+        // Lights in view which didn't fit in the buffers (indices into the lights Build() was given), they have to be shaded some other way
+        const auto& GetOverflow()       const { return m_overflow; }
+
+    private:
+        struct LightBounds
+        {
+            Math::Vector3 center; // view space
+            float radius    = 0.0f;
+            uint32_t source = 0; // index into the lights Build() was given
+            uint32_t x_min  = 0;
+            uint32_t x_max  = 0;
+            uint32_t y_min  = 0;
+            uint32_t y_max  = 0;
+            uint32_t z_min  = 0;
+            uint32_t z_max  = 0;
+        };
+
+        struct ClusterBounds
+        {
+            Math::Vector3 min; // view space
+            Math::Vector3 max;
+        };
+
+        struct Slice
+        {
+            std::vector<std::pair<uint32_t, uint32_t>> assignments; // tile, light
+            std::vector<uint32_t> offsets;                          // per tile, into the lights
+            std::vector<uint32_t> lights;                           // grouped by tile
+            std::vector<uint32_t> cursors;                          // per tile, while grouping
+        };
+
+        void UpdateClusterBounds(const Math::Matrix& projection, float near_plane, float far_plane);
+        void BinSlice(uint32_t z);
+
+        std::vector<LightBounds> m_light_bounds;
+        std::vector<ClusterBounds> m_cluster_bounds;
+        std::vector<Slice> m_slices;
+        std::vector<uint32_t> m_light_assignments; // per light
+        std::vector<bool> m_light_clustered;        // per light
+        std::vector<uint32_t> m_overflow;
+        bool m_overflow_logged      = false;
+        Math::Matrix m_projection;
+        float m_near_plane          = 0.0f;
+        float m_far_plane           = 0.0f;
+        uint32_t m_index_count      = 0;
+        uint32_t m_clustered_count  = 0;
+        uint32_t m_assignment_count = 0;
+
+        BufferLightGridLights m_lights       = {};
+        BufferLightGridClusters m_clusters   = {};
+        BufferLightGridIndices m_indices     = {};
+
+        Threading* m_threading = nullptr;
+    };
+}
@@ -47,8 +47,8 @@ namespace Spartan
 		SetMultiplier(Texture_Normal, 0.0f);
 		SetMultiplier(Texture_Height, 0.0f);
 
-        // Acquire shader
-        m_shader = GetOrCreateShader(m_texture_flags);
+        // Acquire shader (compiled in the background if this combination of textures is new)
+        ShaderVariation::Request(m_texture_flags);
 	}
 
 	bool Material::LoadFromFile(const string& file_path)
@@ -86,8 +86,8 @@ namespace Spartan
 			SetTextureSlot(tex_type, texture);
 		}
 
-        // Acquire shader
-        m_shader = GetOrCreateShader(m_texture_flags);
+        // Acquire shader (compiled in the background if this combination of textures is new)
+        ShaderVariation::Request(m_texture_flags);
 
         m_size_cpu = sizeof(*this);
 
@@ -142,8 +142,8 @@ namespace Spartan
             m_texture_flags &= ~type;
 		}
 
-        // Acquire shader
-        m_shader = GetOrCreateShader(m_texture_flags);
+        // Acquire shader (compiled in the background if this combination of textures is new)
+        ShaderVariation::Request(m_texture_flags);
 	}
 
 	void Material::SetTextureSlot(const Texture_Type type, const std::shared_ptr<RHI_Texture2D>& texture)
@@ -198,26 +198,10 @@ namespace Spartan
         return HasTexture(type) ? m_textures.at(type) : texture_empty;
     }
 
-    shared_ptr<ShaderVariation> Material::GetOrCreateShader(const uint8_t shader_flags)
-	{
-		if (!m_context)
-		{
-			LOG_ERROR("Context is null, can't execute function");
-			static shared_ptr<ShaderVariation> empty;
-			return empty;
-		}
-
-		// If an appropriate shader already exists, return it instead
-		if (const auto& existing_shader = ShaderVariation::GetMatchingShader(shader_flags))
-			return existing_shader;
-
-		// Create and compile shader
-		auto shader = make_shared<ShaderVariation>(m_rhi_device, m_context);
-		const auto dir_shaders = m_context->GetSubsystem<ResourceCache>()->GetDataDirectory(Asset_Shaders) + "/";
-		shader->Compile(dir_shaders + "GBuffer.hlsl", shader_flags);
-
-		return shader;
-	}
+    ShaderVariation* Material::GetShader() const
+    {
+        return ShaderVariation::GetCompiledShader(m_texture_flags);
+    }
 
     void Material::SetColorAlbedo(const Math::Vector4& color)
     {
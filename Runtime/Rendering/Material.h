@@ -59,9 +59,8 @@ namespace Spartan
 		//==================================================================================================================
 
 		//= SHADER =================================================================================
-		std::shared_ptr<ShaderVariation> GetOrCreateShader(const uint8_t shader_flags);
-		const std::shared_ptr<ShaderVariation>& GetShader() const { return m_shader; }
-		bool HasShader()		                            const { return GetShader() != nullptr; }
+		ShaderVariation* GetShader() const; // compiled, falls back to a similar variation while the exact one compiles
+		bool HasShader()		    const { return GetShader() != nullptr; }
 		//==========================================================================================
 
 		//= PROPERTIES ==========================================================================================
@@ -91,7 +90,6 @@ namespace Spartan
         uint8_t m_texture_flags         = 0;
 		std::unordered_map<Texture_Type, std::shared_ptr<RHI_Texture>> m_textures;
 		std::unordered_map<Texture_Type, float> m_multipliers;
-		std::shared_ptr<ShaderVariation> m_shader;	
 		std::shared_ptr<RHI_Device> m_rhi_device;
 	};
 }
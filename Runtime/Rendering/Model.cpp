@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Model.h"
 #include "Mesh.h"
 #include "Renderer.h"
+#include "SkeletalAnimation.h"
 #include "../IO/FileStream.h"
 #include "../Core/Stopwatch.h"
 #include "../Resource/ResourceCache.h"
@@ -48,6 +49,7 @@ namespace Spartan
 		m_resource_manager	= m_context->GetSubsystem<ResourceCache>();
 		m_rhi_device		= m_context->GetSubsystem<Renderer>()->GetRhiDevice();
 		m_mesh				= make_unique<Mesh>();
+		m_skeleton			= make_shared<Skeleton>();
 	}
 
 	Model::~Model()
@@ -61,6 +63,9 @@ namespace Spartan
         m_vertex_buffer.reset();
         m_index_buffer.reset();
         m_mesh->Geometry_Clear();
+        m_skeleton->Clear();
+        m_animation_clips.clear();
+        m_vertices_skinned.clear();
         m_aabb.Undefine();
         m_normalized_scale = 1.0f;
         m_is_animated = false;
@@ -113,6 +118,7 @@ namespace Spartan
         {
             // Cpu
             m_size_cpu = !m_mesh ? 0 : m_mesh->Geometry_MemoryUsage();
+            m_size_cpu += m_vertices_skinned.size() * sizeof(RHI_Vertex_PosTexNorTanBone);
 
             // Gpu
             if (m_vertex_buffer && m_index_buffer)
@@ -217,6 +223,44 @@ namespace Spartan
 		}
 	}
 
+	void Model::AddAnimation(const Animation& animation)
+	{
+		if (m_skeleton->GetBoneCount() == 0)
+		{
+			LOG_WARNING("\"%s\" has no skeleton, only skeletal animations are supported", GetResourceName().c_str());
+			return;
+		}
+
+		auto clip = make_shared<AnimationClip>();
+		if (clip->Build(animation, *m_skeleton))
+		{
+			m_animation_clips.emplace_back(clip);
+			m_is_animated = true;
+		}
+	}
+
+	void Model::AppendSkinnedVertices(const uint32_t vertex_offset, const vector<RHI_Vertex_PosTexNorTanBone>& vertices)
+	{
+		const auto& mesh_vertices = m_mesh->Vertices_Get();
+		if (vertices.empty() || vertex_offset + vertices.size() > mesh_vertices.size())
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return;
+		}
+
+		// Vertices of meshes which aren't skinned carry no weights
+		if (m_vertices_skinned.size() < vertex_offset + vertices.size())
+		{
+			m_vertices_skinned.reserve(vertex_offset + vertices.size());
+			for (size_t i = m_vertices_skinned.size(); i < vertex_offset + vertices.size(); i++)
+			{
+				m_vertices_skinned.emplace_back(mesh_vertices[i]);
+			}
+		}
+
+		copy(vertices.begin(), vertices.end(), m_vertices_skinned.begin() + vertex_offset);
+	}
+
 	bool Model::GeometryCreateBuffers()
 	{
 		auto success = true;
@@ -255,6 +299,15 @@ namespace Spartan
 			success = false;
 		}
 
+		// Skinned vertices line up with the mesh vertices. They stay on the CPU until there is a skinning pass to read them.
+		if (!m_vertices_skinned.empty())
+		{
+			for (size_t i = m_vertices_skinned.size(); i < vertices.size(); i++)
+			{
+				m_vertices_skinned.emplace_back(vertices[i]);
+			}
+		}
+
 		return success;
 	}
 
@@ -26,6 +26,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <vector>
 #include "Material.h"
 #include "../RHI/RHI_Definition.h"
+#include "../RHI/RHI_Vertex.h"
 #include "../Resource/IResource.h"
 #include "../Math/BoundingBox.h"
 //================================
@@ -35,6 +36,9 @@ namespace Spartan
 	class ResourceCache;
 	class Entity;
 	class Mesh;
+	class Animation;
+	class AnimationClip;
+	class Skeleton;
 	namespace Math{ class BoundingBox; }
 
 	class SPARTAN_CLASS Model : public IResource, public std::enable_shared_from_this<Model>
@@ -69,6 +73,13 @@ namespace Spartan
         const auto& GetAabb() const { return m_aabb; }
         const auto& GetMesh() const { return m_mesh; }
 
+		// Animation
+		Skeleton* GetSkeleton()                     const { return m_skeleton.get(); }
+		void AddAnimation(const Animation& animation);
+		const auto& GetAnimationClips()             const { return m_animation_clips; }
+		void AppendSkinnedVertices(uint32_t vertex_offset, const std::vector<RHI_Vertex_PosTexNorTanBone>& vertices);
+		const auto& GetVerticesSkinned()            const { return m_vertices_skinned; }
+
 		// Add resources to the model
         void SetRootEntity(const std::shared_ptr<Entity>& entity) { m_root_entity = entity; }
 		void AddMaterial(std::shared_ptr<Material>& material, const std::shared_ptr<Entity>& entity) const;
@@ -91,6 +102,11 @@ namespace Spartan
 		std::shared_ptr<RHI_VertexBuffer> m_vertex_buffer;
 		std::shared_ptr<RHI_IndexBuffer> m_index_buffer;
 		std::shared_ptr<Mesh> m_mesh;
+
+		// Animation
+		std::shared_ptr<Skeleton> m_skeleton;
+		std::vector<std::shared_ptr<AnimationClip>> m_animation_clips;
+		std::vector<RHI_Vertex_PosTexNorTanBone> m_vertices_skinned; // same order as the mesh vertices, empty if nothing is skinned
 		Math::BoundingBox m_aabb;
 		float m_normalized_scale	= 1.0f;
 		bool m_is_animated			= false;
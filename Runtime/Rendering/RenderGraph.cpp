@@ -0,0 +1,246 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==================
+#include "RenderGraph.h"
+#include "../RHI/RHI_Texture2D.h"
+#include <algorithm>
+//=============================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    void RenderGraph::DeclareTexture(const uint32_t id, const RenderGraphTextureDesc& desc)
+    {
+        if (Texture* texture = GetDeclared(id))
+        {
+            texture->desc = desc;
+            return;
+        }
+
+        m_ids.emplace_back(id);
+        m_textures.emplace_back();
+        m_textures.back().desc = desc;
+    }
+
+    void RenderGraph::AddPass(const char* name, const vector<uint32_t>& reads, const vector<uint32_t>& writes, pass_function&& execute)
+    {
+        m_passes.emplace_back();
+        Pass& pass      = m_passes.back();
+        pass.name       = name;
+        pass.reads      = reads;
+        pass.writes     = writes;
+        pass.execute    = move(execute);
+    }
+
+    void RenderGraph::Compile()
+    {
+        // Lifetimes, from the first pass which touches a texture to the last one
+        for (Texture& texture : m_textures)
+        {
+            texture.first_pass  = -1;
+            texture.last_pass   = -1;
+            texture.pool_index  = -1;
+        }
+
+        for (int32_t pass_index = 0; pass_index < static_cast<int32_t>(m_passes.size()); pass_index++)
+        {
+            for (const vector<uint32_t>* ids : { &m_passes[pass_index].reads, &m_passes[pass_index].writes })
+            {
+                for (const uint32_t id : *ids)
+                {
+                    if (Texture* texture = GetDeclared(id))
+                    {
+                        texture->first_pass = texture->first_pass == -1 ? pass_index : texture->first_pass;
+                        texture->last_pass  = pass_index;
+                    }
+                }
+            }
+        }
+
+        // Release pool textures which haven't been used for a while (e.g. the effect that needed them was disabled)
+        for (PoolEntry& entry : m_pool)
+        {
+            if (entry.frames_unused >= pool_release_frames)
+            {
+                Release(entry);
+            }
+        }
+        m_pool.erase(remove_if(m_pool.begin(), m_pool.end(), [](const PoolEntry& entry) { return entry.frames_unused >= pool_release_frames; }), m_pool.end());
+        for (PoolEntry& entry : m_pool)
+        {
+            entry.busy_until = -1;
+        }
+
+        // Assign textures in order of first use, a pool texture is free once the last pass of its previous occupant is done
+        vector<Texture*> used;
+        for (Texture& texture : m_textures)
+        {
+            if (texture.first_pass != -1)
+            {
+                used.emplace_back(&texture);
+            }
+        }
+        stable_sort(used.begin(), used.end(), [](const Texture* a, const Texture* b) { return a->first_pass < b->first_pass; });
+
+        for (Texture* texture : used)
+        {
+            for (uint32_t i = 0; i < static_cast<uint32_t>(m_pool.size()); i++)
+            {
+                if (m_pool[i].desc == texture->desc && m_pool[i].busy_until < texture->first_pass)
+                {
+                    texture->pool_index = static_cast<int32_t>(i);
+                    break;
+                }
+            }
+
+            if (texture->pool_index == -1)
+            {
+                const RenderGraphTextureDesc& desc = texture->desc;
+
+                m_pool.emplace_back();
+                m_pool.back().texture   = make_shared<RHI_Texture2D>(m_context, desc.width, desc.height, desc.format, 1, desc.flags);
+                m_pool.back().desc      = desc;
+                texture->pool_index     = static_cast<int32_t>(m_pool.size() - 1);
+            }
+
+            m_pool[texture->pool_index].busy_until = texture->last_pass;
+        }
+
+        // Age the pool
+        m_memory_pool = 0;
+        for (PoolEntry& entry : m_pool)
+        {
+            entry.frames_unused = entry.busy_until == -1 ? entry.frames_unused + 1 : 0;
+            m_memory_pool += entry.desc.GetSize();
+        }
+
+        // Peak, the most memory the live textures of a single pass occupy (aliased textures count once)
+        m_memory_peak = 0;
+        vector<bool> counted(m_pool.size());
+        for (int32_t pass_index = 0; pass_index < static_cast<int32_t>(m_passes.size()); pass_index++)
+        {
+            fill(counted.begin(), counted.end(), false);
+            uint64_t memory = 0;
+            for (const Texture* texture : used)
+            {
+                if (pass_index >= texture->first_pass && pass_index <= texture->last_pass && !counted[texture->pool_index])
+                {
+                    counted[texture->pool_index] = true;
+                    memory += texture->desc.GetSize();
+                }
+            }
+            m_memory_peak = max(m_memory_peak, memory);
+        }
+
+        // What allocating everything up front would cost
+        m_memory_declared = 0;
+        for (const Texture& texture : m_textures)
+        {
+            m_memory_declared += texture.desc.GetSize();
+        }
+    }
+
+    void RenderGraph::Execute(RHI_CommandList* cmd_list)
+    {
+        for (Pass& pass : m_passes)
+        {
+            Transition(pass.reads, false, cmd_list);
+            Transition(pass.writes, true, cmd_list);
+            pass.execute();
+        }
+
+        m_passes.clear();
+    }
+
+    void RenderGraph::Clear()
+    {
+        m_ids.clear();
+        m_textures.clear();
+        m_passes.clear();
+        for (PoolEntry& entry : m_pool)
+        {
+            Release(entry);
+        }
+        m_pool.clear();
+        m_memory_pool       = 0;
+        m_memory_peak       = 0;
+        m_memory_declared   = 0;
+    }
+
+    const shared_ptr<RHI_Texture>& RenderGraph::GetTexture(const uint32_t id) const
+    {
+        static const shared_ptr<RHI_Texture> null_texture;
+
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_ids.size()); i++)
+        {
+            if (m_ids[i] == id)
+                return m_textures[i].pool_index != -1 ? m_pool[m_textures[i].pool_index].texture : null_texture;
+        }
+
+        return null_texture;
+    }
+
+    RenderGraph::Texture* RenderGraph::GetDeclared(const uint32_t id)
+    {
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_ids.size()); i++)
+        {
+            if (m_ids[i] == id)
+                return &m_textures[i];
+        }
+
+        return nullptr;
+    }
+
+    void RenderGraph::Transition(const vector<uint32_t>& ids, const bool is_write, RHI_CommandList* cmd_list)
+    {
+        // Color textures are sampled in and rendered to from the shader read layout (render passes transition their
+        // attachments from it and back), depth textures are written as attachments and read as read only attachments
+        for (const uint32_t id : ids)
+        {
+            RHI_Texture* texture = GetTexture(id).get();
+            if (!texture)
+                continue;
+
+            if (texture->IsDepthFormat())
+            {
+                texture->SetLayout(is_write ? RHI_Image_Depth_Stencil_Attachment_Optimal : RHI_Image_Depth_Stencil_Read_Only_Optimal, cmd_list);
+            }
+            else
+            {
+                texture->SetLayout(RHI_Image_Shader_Read_Only_Optimal, cmd_list);
+            }
+        }
+    }
+
+    void RenderGraph::Release(PoolEntry& entry)
+    {
+        if (entry.texture && m_on_release)
+        {
+            m_on_release(entry.texture.get());
+        }
+
+        entry.texture = nullptr;
+    }
+}
@@ -0,0 +1,130 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ===================
+#include <vector>
+#include <memory>
+#include <functional>
+#include "../Core/EngineDefs.h"
+#include "../RHI/RHI_Definition.h"
+//==============================
+
+namespace Spartan
+{
+    // Forward declarations
+    class Context;
+
+    // Textures with identical descriptions can share memory
+    struct RenderGraphTextureDesc
+    {
+        uint32_t width      = 0;
+        uint32_t height     = 0;
+        RHI_Format format   = RHI_Format_Undefined;
+        uint16_t flags      = 0; // additional RHI_Texture_Flags (the render target flags are deduced from the format)
+
+        bool operator==(const RenderGraphTextureDesc& rhs) const
+        {
+            return width == rhs.width && height == rhs.height && format == rhs.format && flags == rhs.flags;
+        }
+
+        uint64_t GetSize() const { return static_cast<uint64_t>(width) * height * rhi_format_to_bytes(format); }
+    };
+
+    // Records the passes of a frame along with the transient textures they read and write.
+    // A transient texture lives from the first pass which uses it to the last one, so textures which no pass uses
+    // are never allocated and textures whose lifetimes don't overlap share a texture from the pool.
+    // Textures which have to survive the frame (history, the final frame, etc.) are not declared and are ignored.
+    class SPARTAN_CLASS RenderGraph
+    {
+    public:
+        typedef std::function<void()> pass_function;
+        typedef std::function<void(RHI_Texture*)> release_function;
+
+        RenderGraph(Context* context) { m_context = context; }
+        ~RenderGraph() = default;
+
+        // Declares a transient texture, declarations persist until Clear()
+        void DeclareTexture(uint32_t id, const RenderGraphTextureDesc& desc);
+        // Records a pass, reads and writes are texture ids (undeclared ids are ignored)
+        void AddPass(const char* name, const std::vector<uint32_t>& reads, const std::vector<uint32_t>& writes, pass_function&& execute);
+        // Derives the texture lifetimes and assigns each used texture one from the pool
+        void Compile();
+        // Runs the passes in the order they were added and forgets them, transitioning the textures each pass declared first
+        void Execute(RHI_CommandList* cmd_list);
+        // Drops the declarations and the pool (e.g. when the resolution changes)
+        void Clear();
+        // Called with every pool texture right before the pool releases it, so that nothing keeps pointing to it
+        void OnRelease(release_function&& on_release) { m_on_release = std::move(on_release); }
+
+        // The texture assigned to an id by the last Compile(), null if no pass uses it
+        const std::shared_ptr<RHI_Texture>& GetTexture(uint32_t id) const;
+        const auto& GetDeclaredIds()    const { return m_ids; }
+
+        // Memory (in bytes)
+        uint64_t GetMemoryPool()        const { return m_memory_pool; }         // allocated by the pool
+        uint64_t GetMemoryPeak()        const { return m_memory_peak; }         // the most the passes of the last frame had alive at once
+        uint64_t GetMemoryDeclared()    const { return m_memory_declared; }     // if every declared texture had its own allocation, for the lifetime of the renderer
+
+        // Pool textures no frame has used for this many frames are released
+        static const uint32_t pool_release_frames = 60;
+
+    private:
+        struct Texture
+        {
+            RenderGraphTextureDesc desc;
+            int32_t first_pass  = -1;
+            int32_t last_pass   = -1;
+            int32_t pool_index  = -1;
+        };
+
+        struct Pass
+        {
+            const char* name = nullptr;
+            std::vector<uint32_t> reads;
+            std::vector<uint32_t> writes;
+            pass_function execute;
+        };
+
+        struct PoolEntry
+        {
+            std::shared_ptr<RHI_Texture> texture;
+            RenderGraphTextureDesc desc;
+            int32_t busy_until      = -1; // last pass of the texture occupying it this frame
+            uint32_t frames_unused  = 0;
+        };
+
+        Texture* GetDeclared(uint32_t id);
+        void Transition(const std::vector<uint32_t>& ids, bool is_write, RHI_CommandList* cmd_list);
+        void Release(PoolEntry& entry);
+
+        std::vector<uint32_t> m_ids;
+        std::vector<Texture> m_textures; // parallel to m_ids
+        std::vector<Pass> m_passes;
+        std::vector<PoolEntry> m_pool;
+        release_function m_on_release;
+        uint64_t m_memory_pool      = 0;
+        uint64_t m_memory_peak      = 0;
+        uint64_t m_memory_declared  = 0;
+        Context* m_context          = nullptr;
+    };
+}
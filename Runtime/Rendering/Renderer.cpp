@@ -22,14 +22,19 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ==============================
 #include "Renderer.h"
 #include "Model.h"
+#include "Material.h"
 #include "Font/Font.h"
 #include "Gizmos/Grid.h"
+#include "RenderGraph.h"
+#include "LightGrid.h"
+#include "ShadowAtlas.h"
 #include "Gizmos/Transform_Gizmo.h"
 #include "../Utilities/Sampling.h"
 #include "../Profiling/Profiler.h"
 #include "../Resource/ResourceCache.h"
 #include "../Core/Engine.h"
 #include "../Core/Timer.h"
+#include "../Threading/Threading.h"
 #include "../World/Entity.h"
 #include "../World/Components/Transform.h"
 #include "../World/Components/Renderable.h"
@@ -37,6 +42,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../World/Components/Light.h"
 #include "../RHI/RHI_Device.h"
 #include "../RHI/RHI_PipelineCache.h"
+#include "../RHI/RHI_ShaderCache.h"
 #include "../RHI/RHI_ConstantBuffer.h"
 #include "../RHI/RHI_CommandList.h"
 #include "../RHI/RHI_Texture2D.h"
@@ -53,11 +59,19 @@ using namespace Spartan::Math;
 
 namespace Spartan
 {
+    // Pipeline state descriptions and the driver's pipeline cache, written on shutdown
+    static const char* pipeline_cache_file_path = "pipelines.cache";
+    static const char* shader_cache_directory   = "shader_cache/";
+    static const uint32_t object_buffer_frame_count = 2; // frames the object buffer ring keeps apart, matches the swap chain's buffer count
+    static const uint32_t shadow_atlas_resolution   = 4096; // the point and spot light shadow maps are tiles of a single atlas
+    static const uint32_t record_chunk_size_min     = 32; // below this many draws per chunk, beginning and executing a secondary command list costs more than recording it in parallel saves
+
     Renderer::Renderer(Context* context) : ISubsystem(context)
     {
         // Options
         m_options |= Render_ReverseZ;
         //m_options |= Render_DepthPrepass;
+        m_options |= Render_ShadowCaching;
         m_options |= Render_Debug_Transform;
         //m_options |= Render_Debug_SelectionOutline;
         m_options |= Render_Debug_Grid;
@@ -96,6 +110,13 @@ namespace Spartan
 		// Unsubscribe from events
 		UNSUBSCRIBE_FROM_EVENT(Event_World_Resolve_Complete, EVENT_HANDLER_VARIANT(RenderablesAcquire));
 
+        // Persist pipelines so that the next run can create them ahead of time
+        if (m_pipeline_cache)
+        {
+            RegisterPipelineShaderVariations();
+            m_pipeline_cache->Save(pipeline_cache_file_path);
+        }
+
 		m_entities.clear();
 		m_camera = nullptr;
 
@@ -108,6 +129,7 @@ namespace Spartan
         // Get required systems		
         m_resource_cache    = m_context->GetSubsystem<ResourceCache>();
         m_profiler          = m_context->GetSubsystem<Profiler>();
+        m_threading         = m_context->GetSubsystem<Threading>();
 
         // Create device
         m_rhi_device = make_shared<RHI_Device>(m_context);
@@ -117,8 +139,12 @@ namespace Spartan
             return false;
         }
 
-        // Create pipeline cache
+        // Create shader cache, shaders which haven't changed since a previous run skip compilation
+        m_rhi_device->SetShaderCache(make_shared<RHI_ShaderCache>(m_rhi_device.get(), shader_cache_directory));
+
+        // Create pipeline cache, pipelines from previous runs are created a few per frame once their shaders compile
         m_pipeline_cache = make_shared<RHI_PipelineCache>(m_rhi_device.get());
+        m_pipeline_cache->Load(pipeline_cache_file_path);
 
         // Create descriptor cache
         m_descriptor_cache = make_shared<RHI_DescriptorCache>(m_rhi_device.get());
@@ -152,6 +178,16 @@ namespace Spartan
 		// Line buffer
 		m_vertex_buffer_lines = make_shared<RHI_VertexBuffer>(m_rhi_device);
 
+        // Render graph, pipelines which render to a pool texture go away along with it
+        m_render_graph = make_unique<RenderGraph>(m_context);
+        m_render_graph->OnRelease([this](RHI_Texture* texture) { m_pipeline_cache->Evict(texture); });
+
+        // Light grid
+        m_light_grid = make_unique<LightGrid>(m_threading);
+
+        // Shadow atlas
+        m_shadow_atlas = make_unique<ShadowAtlas>(shadow_atlas_resolution, m_resolution_shadow_min);
+
         CreateConstantBuffers();
 		CreateShaders();
 		CreateDepthStencilStates();
@@ -161,6 +197,10 @@ namespace Spartan
 		CreateFonts();	
 		CreateSamplers();
 		CreateTextures();
+        RegisterPipelineObjects();
+
+        // Bindless slot 0 is the texture that missing textures (and textures past the array's capacity) point to
+        m_descriptor_cache->SetBindlessDefault(m_tex_white);
 
 		if (!m_initialized)
 		{
@@ -180,7 +220,17 @@ namespace Spartan
     void Renderer::Tick(float delta_time)
 	{
 		if (!m_rhi_device || !m_rhi_device->IsInitialized())
+		{
+			if (m_font) m_font->ClearText();
 			return;
+		}
+
+        // Compile requested shader variations and hot reload modified shaders
+        UpdateShaders(delta_time);
+
+        // Create pipelines from previous runs, within a per frame budget
+        RegisterPipelineShaderVariations();
+        m_pipeline_cache->Prewarm(m_descriptor_cache.get());
 
         RHI_CommandList* cmd_list = m_swap_chain->GetCmdList();
 
@@ -188,6 +238,7 @@ namespace Spartan
 		if (!m_camera)
 		{
             //cmd_list->ClearRenderTarget(m_render_targets[RenderTarget_Composition_Ldr]->GetResource_RenderTarget(), Vector4(0.0f, 0.0f, 0.0f, 1.0f));
+            m_font->ClearText();
 			return;
 		}
 
@@ -195,12 +246,37 @@ namespace Spartan
 		if (m_entities.empty())
 		{
             //cmd_list->ClearRenderTarget(m_render_targets[RenderTarget_Composition_Ldr]->GetResource_RenderTarget(), m_camera->GetClearColor());
+            m_font->ClearText();
 			return;
 		}
 
 		m_frame_num++;
 		m_is_odd_frame = (m_frame_num % 2) == 1;
 
+        // Move on to the next region of the object and instance buffers
+        m_buffer_object_ring.BeginFrame();
+        m_buffer_instances_ring.BeginFrame();
+
+        // Release object and instance buffers which were replaced, once the frames which could be reading them are done
+        for (auto it = m_buffers_retired.begin(); it != m_buffers_retired.end();)
+        {
+            it = m_frame_num >= it->second ? m_buffers_retired.erase(it) : it + 1;
+        }
+
+        // Free the bindless slots of destroyed textures
+        m_descriptor_cache->TickBindless(m_frame_num);
+
+        // Fixed timestep - interpolate between the last two simulation states, the camera goes
+        // first as directional light cascades and everything that is culled depend on its view
+        if (m_context->m_engine->EngineMode_IsSet(Engine_Fixed))
+        {
+            const float alpha = m_context->GetSubsystem<Timer>()->GetFixedAlpha();
+            m_camera->Interpolate(alpha);
+            for (Entity* entity : m_entities[Renderer_Object_Light])       { if (Light* light = entity->GetComponent<Light>()) light->Interpolate(alpha); }
+            for (Entity* entity : m_entities[Renderer_Object_Opaque])      { entity->GetTransform()->Interpolate(alpha); }
+            for (Entity* entity : m_entities[Renderer_Object_Transparent]) { entity->GetTransform()->Interpolate(alpha); }
+        }
+
 		// Get camera matrices
 		{
 			m_near_plane	                            = m_camera->GetNearPlane();
@@ -238,6 +314,9 @@ namespace Spartan
 		m_is_rendering = true;
 		Pass_Main(cmd_list);
 		m_is_rendering = false;
+
+        // Strings are drawn for a single frame, even if the frame ended before they could be
+        m_font->ClearText();
 	}
 
 	void Renderer::SetResolution(uint32_t width, uint32_t height)
@@ -264,6 +343,7 @@ namespace Spartan
 
 		// Re-create render textures
 		CreateRenderTextures();
+        RegisterPipelineObjects();
 
         FIRE_EVENT(Event_Frame_Resolution_Changed);
 
@@ -287,7 +367,7 @@ namespace Spartan
 
 	void Renderer::DrawRectangle(const Math::Rectangle& rectangle, const Math::Vector4& color /*= DebugColor*/, bool depth /*= true*/)
 	{
-        const float cam_z = m_camera->GetTransform()->GetPosition().z + m_camera->GetNearPlane() + 5.0f;
+        const float cam_z = m_camera->GetTransform()->GetPositionInterpolated().z + m_camera->GetNearPlane() + 5.0f;
 
         DrawLine(Vector3(rectangle.left,    rectangle.top,      cam_z), Vector3(rectangle.right,    rectangle.top,      cam_z), color, color, depth);
         DrawLine(Vector3(rectangle.right,   rectangle.top,      cam_z), Vector3(rectangle.right,    rectangle.bottom,   cam_z), color, color, depth);
@@ -295,6 +375,14 @@ namespace Spartan
         DrawLine(Vector3(rectangle.left,    rectangle.bottom,   cam_z), Vector3(rectangle.left,     rectangle.top,      cam_z), color, color, depth);
 	}
 
+	void Renderer::DrawString(const string& text, const Vector2& position)
+	{
+        if (m_font)
+        {
+            m_font->AddText(text, position);
+        }
+	}
+
 	void Renderer::DrawBox(const BoundingBox& box, const Vector4& color, const bool depth /*= true*/)
 	{
 		const auto& min = box.GetMin();
@@ -339,8 +427,8 @@ namespace Spartan
         // Struct is updated automatically here as per frame data are (by definition) known ahead of time
         m_buffer_frame_cpu.camera_near                  = m_camera->GetNearPlane();
         m_buffer_frame_cpu.camera_far                   = m_camera->GetFarPlane();
-        m_buffer_frame_cpu.camera_position              = m_camera->GetTransform()->GetPosition();
-        m_buffer_frame_cpu.camera_direction             = m_camera->GetTransform()->GetForward();
+        m_buffer_frame_cpu.camera_position              = m_camera->GetTransform()->GetPositionInterpolated();
+        m_buffer_frame_cpu.camera_direction             = m_camera->GetTransform()->GetForwardInterpolated();
         m_buffer_frame_cpu.bloom_intensity              = m_option_values[Option_Value_Bloom_Intensity];
         m_buffer_frame_cpu.sharpen_strength             = m_option_values[Option_Value_Sharpen_Strength];
         m_buffer_frame_cpu.sharpen_clamp                = m_option_values[Option_Value_Sharpen_Clamp];
@@ -385,52 +473,312 @@ namespace Spartan
 		return m_buffer_uber_gpu->Unmap();
 	}
 
-    bool Renderer::UpdateObjectBuffer(RHI_CommandList* cmd_list, const uint32_t entity_index /*= 0*/)
+    bool Renderer::UpdateObjectBuffer(RHI_CommandList* cmd_list)
     {
-        // Only update if needed
-        const bool same_content   = m_buffer_object_cpu == m_buffer_object_cpu_previous;
-        const bool same_offset    = m_buffer_object_gpu->GetOffsetIndexDynamic() == entity_index;
-        if (same_content && same_offset)
+        // Write a single object to the ring, for draws which are not part of a draw list
+        uint32_t index = 0;
+        if (!AllocateObjects(1, index))
+            return false;
+
+        BufferObject* buffer = GetObjectBufferElement(index);
+        if (!buffer)
+        {
+            LOG_ERROR("Failed to map buffer");
+            return false;
+        }
+
+        *buffer = m_buffer_object_cpu;
+
+        return BindObjectBuffer(cmd_list, index);
+    }
+
+    bool Renderer::CreateObjectBuffer(const uint32_t elements_per_frame)
+    {
+        m_buffer_object_ring.Reset(elements_per_frame, object_buffer_frame_count);
+
+        // Backends which can't keep the buffer mapped (no dynamic offsets either) only need a single element on the gpu.
+        // The ring lives on the cpu instead and is uploaded a draw at a time.
+        if (!m_buffer_object_gpu->IsPersistentlyMapped())
+        {
+            m_buffer_object_cpu_ring.resize(m_buffer_object_ring.GetElementCount());
+            return true;
+        }
+
+        // Growing can happen while the frame is being recorded, so this is a new buffer. Commands recorded so far keep
+        // pointing to the current one, which is released once the frames in flight are done with it (see Tick()).
+        auto buffer = make_shared<RHI_ConstantBuffer>(m_rhi_device, true);
+        if (!buffer->Create<BufferObject>(m_buffer_object_ring.GetElementCount()))
+        {
+            LOG_ERROR("Failed to allocate object buffer with %d elements", m_buffer_object_ring.GetElementCount());
+            return false;
+        }
+
+        m_buffers_retired.emplace_back(m_buffer_object_gpu, m_frame_num + object_buffer_frame_count);
+        m_buffer_object_gpu         = buffer;
+        m_buffer_object_rebind      = true;
+
+        return true;
+    }
+
+    bool Renderer::CreateInstanceBuffer(const uint32_t elements_per_frame)
+    {
+        m_buffer_instances_ring.Reset(elements_per_frame, object_buffer_frame_count);
+
+        // Backends which can't keep the buffer mapped (no dynamic offsets either) only need a single element on the gpu.
+        // The ring lives on the cpu instead and is uploaded a batch at a time.
+        if (!m_buffer_instances_gpu->IsPersistentlyMapped())
+        {
+            m_buffer_instances_cpu_ring.resize(m_buffer_instances_ring.GetElementCount());
+            return true;
+        }
+
+        // A new buffer, for the same reason as the object buffer's
+        auto buffer = make_shared<RHI_ConstantBuffer>(m_rhi_device, true);
+        if (!buffer->Create<BufferInstances>(m_buffer_instances_ring.GetElementCount()))
+        {
+            LOG_ERROR("Failed to allocate instance buffer with %d elements", m_buffer_instances_ring.GetElementCount());
+            return false;
+        }
+
+        m_buffers_retired.emplace_back(m_buffer_instances_gpu, m_frame_num + object_buffer_frame_count);
+        m_buffer_instances_gpu = buffer;
+
+        return true;
+    }
+
+    bool Renderer::AllocateObjects(const uint32_t count, uint32_t& index)
+    {
+        if (count == 0 || m_buffer_object_ring.Allocate(count, index))
             return true;
 
-        const uint32_t entity_count = entity_index + 1;
+        // Grow so that the frame fits. The new buffer starts over, which is fine as every allocation is bound (or uploaded)
+        // before the next one is made, so indices handed out earlier in the frame are never looked up in the new buffer.
+        const uint32_t elements_per_frame = Math::Helper::NextPowerOfTwo(m_buffer_object_ring.GetUsed() + count);
+        return CreateObjectBuffer(elements_per_frame) && m_buffer_object_ring.Allocate(count, index);
+    }
+
+    bool Renderer::AllocateInstances(const uint32_t count, uint32_t& index)
+    {
+        if (count == 0 || m_buffer_instances_ring.Allocate(count, index))
+            return true;
+
+        // Grow so that the frame fits, see AllocateObjects()
+        const uint32_t elements_per_frame = Math::Helper::NextPowerOfTwo(m_buffer_instances_ring.GetUsed() + count);
+        return CreateInstanceBuffer(elements_per_frame) && m_buffer_instances_ring.Allocate(count, index);
+    }
+
+    BufferObject* Renderer::GetObjectBufferElement(const uint32_t index)
+    {
+        return m_buffer_object_gpu->IsPersistentlyMapped() ? static_cast<BufferObject*>(m_buffer_object_gpu->Map(index)) : &m_buffer_object_cpu_ring[index];
+    }
+
+    BufferInstances* Renderer::GetInstanceBufferElement(const uint32_t index)
+    {
+        return m_buffer_instances_gpu->IsPersistentlyMapped() ? static_cast<BufferInstances*>(m_buffer_instances_gpu->Map(index)) : &m_buffer_instances_cpu_ring[index];
+    }
+
+    bool Renderer::StreamDrawList(DrawList& draw_list, const object_fill_function& fill)
+    {
+        vector<DrawCall>& draw_calls    = draw_list.GetDrawCalls();
+        vector<DrawBatch>& batches      = draw_list.GetBatches();
 
-        // Re-allocate buffer with double size (if needed)
-        if (entity_count >= m_buffer_object_gpu->GetElementCount())
+        // Single draws go to the object buffer, batches of draws to the instance buffer
+        uint32_t object_count   = 0;
+        uint32_t instance_count = 0;
+        for (const DrawBatch& batch : batches)
         {
-            const uint32_t new_size = Math::Helper::NextPowerOfTwo(entity_count);
-            if (!m_buffer_object_gpu->Create<BufferObject>(new_size))
+            object_count    += batch.count == 1 ? 1 : 0;
+            instance_count  += batch.count == 1 ? 0 : 1;
+        }
+
+        // Allocate everything in one go
+        uint32_t object_index   = 0;
+        uint32_t instance_index = 0;
+        if (!AllocateObjects(object_count, object_index) || !AllocateInstances(instance_count, instance_index))
+            return false;
+
+        // Write straight into the mapped memory (or the cpu side ring), the fill function should only write to the buffer it's given
+        for (DrawBatch& batch : batches)
+        {
+            if (batch.count == 1)
             {
-                LOG_ERROR("Failed to re-allocate buffer with %d offsets", new_size);
-                return false;
+                DrawCall& draw_call     = draw_calls[batch.first];
+                draw_call.object_index  = object_index++;
+
+                BufferObject* buffer = GetObjectBufferElement(draw_call.object_index);
+                if (!buffer)
+                {
+                    LOG_ERROR("Failed to map buffer");
+                    return false;
+                }
+
+                buffer->material_index = draw_call.material_index;
+                fill(draw_call, *buffer);
+            }
+            else
+            {
+                batch.instance_index = instance_index++;
+
+                BufferInstances* buffer = GetInstanceBufferElement(batch.instance_index);
+                if (!buffer)
+                {
+                    LOG_ERROR("Failed to map buffer");
+                    return false;
+                }
+
+                buffer->material_index = draw_calls[batch.first].material_index;
+                for (uint32_t i = 0; i < batch.count; i++)
+                {
+                    BufferObject object;
+                    fill(draw_calls[batch.first + i], object);
+
+                    buffer->instances[i].transform      = object.object;
+                    buffer->instances[i].wvp_previous   = object.wvp_previous;
+                }
             }
         }
 
-        // Set new buffer offset
-        m_buffer_object_gpu->SetOffsetIndexDynamic(entity_index);
+        return true;
+    }
 
-        // Dynamic buffers with offsets have to be rebound whenever the offset changes
-        if (cmd_list)
+    bool Renderer::BindObjectBuffer(RHI_CommandList* cmd_list, const uint32_t object_index)
+    {
+        // The data is already on the gpu, just point to it
+        if (m_buffer_object_gpu->IsPersistentlyMapped())
         {
-            cmd_list->SetConstantBuffer(2, RHI_Shader_Vertex, m_buffer_object_gpu);
+            // Secondaries are recorded concurrently, so they pass the offset along instead of moving the buffer's own
+            if (cmd_list && cmd_list->IsSecondary())
+            {
+                cmd_list->SetConstantBufferDynamic(2, RHI_Shader_Vertex, m_buffer_object_gpu, object_index);
+                return true;
+            }
+
+            if (m_buffer_object_gpu->GetOffsetIndexDynamic() == object_index && !m_buffer_object_rebind)
+                return true;
+
+            m_buffer_object_gpu->SetOffsetIndexDynamic(object_index);
+
+            // Dynamic buffers with offsets have to be rebound whenever the offset (or the buffer) changes
+            if (cmd_list)
+            {
+                cmd_list->SetConstantBuffer(2, RHI_Shader_Vertex, m_buffer_object_gpu);
+                m_buffer_object_rebind = false;
+            }
+
+            return true;
         }
 
-        // Map  
-        BufferObject* buffer = static_cast<BufferObject*>(m_buffer_object_gpu->Map(entity_index));
+        // No dynamic offsets, upload the object
+        BufferObject* buffer = static_cast<BufferObject*>(m_buffer_object_gpu->Map());
         if (!buffer)
         {
             LOG_ERROR("Failed to map buffer");
             return false;
         }
 
-        // Update
-        *buffer = m_buffer_object_cpu;
-        m_buffer_object_cpu_previous = m_buffer_object_cpu;
+        *buffer = m_buffer_object_cpu_ring[object_index];
 
-        // Unmap
         return m_buffer_object_gpu->Unmap();
     }
 
+    bool Renderer::BindInstanceBuffer(RHI_CommandList* cmd_list, const uint32_t instance_index)
+    {
+        if (m_buffer_instances_gpu->IsPersistentlyMapped())
+        {
+            // The data is already on the gpu, just point to it (secondaries are recorded concurrently, so they pass the offset along instead of moving the buffer's own)
+            if (cmd_list->IsSecondary())
+            {
+                cmd_list->SetConstantBufferDynamic(2, RHI_Shader_Vertex, m_buffer_instances_gpu, instance_index);
+                return true;
+            }
+
+            m_buffer_instances_gpu->SetOffsetIndexDynamic(instance_index);
+        }
+        else
+        {
+            // No dynamic offsets, upload the batch
+            BufferInstances* buffer = static_cast<BufferInstances*>(m_buffer_instances_gpu->Map());
+            if (!buffer)
+            {
+                LOG_ERROR("Failed to map buffer");
+                return false;
+            }
+
+            *buffer = m_buffer_instances_cpu_ring[instance_index];
+
+            if (!m_buffer_instances_gpu->Unmap())
+                return false;
+        }
+
+        // Instanced shaders read their instances from the object buffer slot, so always (re)bind
+        cmd_list->SetConstantBuffer(2, RHI_Shader_Vertex, m_buffer_instances_gpu);
+
+        return true;
+    }
+
+    void Renderer::RecordChunked(RHI_CommandList* cmd_list, const uint32_t count, const record_function& record, uint32_t chunk_count /*= 0*/)
+    {
+        if (!cmd_list || count == 0)
+            return;
+
+        // One chunk per available thread (plus the calling thread), as long as the chunks are big enough to be worth it
+        if (chunk_count == 0)
+        {
+            const uint32_t chunk_count_max = m_threading->GetThreadsAvailable() + 1;
+            chunk_count = Math::Helper::Clamp((count + record_chunk_size_min - 1) / record_chunk_size_min, 1u, chunk_count_max);
+        }
+
+        // Backends without secondary command lists record everything on the calling thread
+        if (chunk_count == 1 || !m_rhi_device->GetContextRhi()->parallel_recording)
+        {
+            record(cmd_list, 0, count);
+            return;
+        }
+
+        DrawList::Partition(count, chunk_count, m_record_ranges);
+        chunk_count = static_cast<uint32_t>(m_record_ranges.size());
+
+        // Secondaries are kept around, along with their descriptor caches and command memory
+        while (m_cmd_lists_secondary.size() < chunk_count)
+        {
+            const uint32_t index = static_cast<uint32_t>(m_cmd_lists_secondary.size());
+            m_cmd_lists_secondary.emplace_back(make_shared<RHI_CommandList>(index, m_swap_chain.get(), m_context, true));
+        }
+
+        // Begin on this thread (it owns the primary), a list per chunk
+        m_record_cmd_lists.clear();
+        for (uint32_t i = 0; i < chunk_count; i++)
+        {
+            RHI_CommandList* cmd_list_secondary = m_cmd_lists_secondary[i].get();
+            if (!cmd_list_secondary->BeginSecondary(cmd_list))
+            {
+                for (RHI_CommandList* cmd_list_begun : m_record_cmd_lists)
+                {
+                    cmd_list_begun->End();
+                }
+
+                record(cmd_list, 0, count);
+                return;
+            }
+
+            m_record_cmd_lists.emplace_back(cmd_list_secondary);
+        }
+
+        // One chunk per loop iteration, the calling thread takes part and returns once every chunk is recorded
+        m_threading->AddTaskLoop([this, &record](uint32_t start, uint32_t end)
+        {
+            for (uint32_t i = start; i < end; i++)
+            {
+                RHI_CommandList* cmd_list_secondary = m_record_cmd_lists[i];
+                record(cmd_list_secondary, m_record_ranges[i].first, m_record_ranges[i].second);
+                cmd_list_secondary->End();
+            }
+        }, chunk_count, chunk_count);
+
+        // Execute in chunk order, this keeps the draw order deterministic
+        cmd_list->ExecuteSecondary(m_record_cmd_lists.data(), chunk_count);
+    }
+
     bool Renderer::UpdateLightBuffer(const Light* light)
     {
         if (!light)
@@ -451,11 +799,16 @@ namespace Spartan
         const bool volumetric         = static_cast<float>(m_options & Render_VolumetricLighting);
         const bool contact_shadows    = static_cast<float>(m_options & Render_ScreenSpaceShadows);
 
-        for (uint32_t i = 0; i < light->GetShadowArraySize(); i++) { m_buffer_light_cpu.view_projection[i] = light->GetViewMatrix(i) * light->GetProjectionMatrix(i); }
+        const float atlas_texel = 1.0f / static_cast<float>(shadow_atlas_resolution);
+        for (uint32_t i = 0; i < light->GetShadowArraySize(); i++)
+        {
+            m_buffer_light_cpu.view_projection[i]   = light->GetViewMatrix(i) * light->GetProjectionMatrix(i);
+            m_buffer_light_cpu.atlas_rects[i]       = light->GetShadowAtlasTile(i) * atlas_texel;
+        }
         m_buffer_light_cpu.intensity_range_angle_bias               = Vector4(light->GetIntensity(), light->GetRange(), light->GetAngle(), GetOption(Render_ReverseZ) ? light->GetBias() : -light->GetBias());
-        m_buffer_light_cpu.normalBias_shadow_volumetric_contact     = Vector4(light->GetNormalBias(), light->GetShadowsEnabled(), contact_shadows && light->GetShadowsScreenSpaceEnabled(), volumetric && light->GetVolumetricEnabled());
+        m_buffer_light_cpu.normalBias_shadow_volumetric_contact     = Vector4(light->GetNormalBias(), light->HasShadowMap(), contact_shadows && light->GetShadowsScreenSpaceEnabled(), volumetric && light->GetVolumetricEnabled());
         m_buffer_light_cpu.color                                    = light->GetColor(); m_buffer_light_cpu.color.w = light->GetShadowsTransparentEnabled() ? 1.0f : 0.0f;
-        m_buffer_light_cpu.position                                 = light->GetTransform()->GetPosition();
+        m_buffer_light_cpu.position                                 = light->GetTransform()->GetPositionInterpolated();
         m_buffer_light_cpu.direction                                = light->GetDirection();
 
         // Update
@@ -466,6 +819,189 @@ namespace Spartan
         return m_buffer_light_gpu->Unmap();
     }
 
+    void Renderer::UpdateShadowAtlas()
+    {
+        if (!m_camera)
+            return;
+
+        const auto& entities        = m_entities[Renderer_Object_Light];
+        const Vector3 camera_pos    = m_camera->GetTransform()->GetPositionInterpolated();
+        const float tan_half_fov    = Helper::Tan(m_camera->GetFovVerticalRad() * 0.5f);
+
+        // Request tiles for the point and spot lights which cast shadows, sized and prioritised by how much of the screen they cover
+        m_shadow_atlas_requests.clear();
+        for (uint32_t i = 0; i < static_cast<uint32_t>(entities.size()); i++)
+        {
+            Light* light = entities[i]->GetComponent<Light>();
+            if (!light || light->GetLightType() == LightType_Directional)
+                continue;
+
+            if (!light->GetShadowsEnabled())
+            {
+                light->SetShadowAtlasTiles(ShadowAtlasRequest());
+                continue;
+            }
+
+            // The projected radius of the light's range, relative to half the screen height (1 once the camera is within range)
+            const float distance = Vector3::Distance(camera_pos, light->GetTransform()->GetPositionInterpolated());
+            const float coverage = distance > light->GetRange() ? light->GetRange() / (distance * tan_half_fov) : 1.0f;
+
+            ShadowAtlasRequest request;
+            request.id          = i;
+            request.tile_count  = light->GetLightType() == LightType_Point ? 6 : 1;
+            request.size        = m_shadow_atlas->ComputeTileSize(coverage, light->GetShadowAtlasTileSize());
+            request.priority    = coverage;
+            m_shadow_atlas_requests.emplace_back(request);
+        }
+
+        // Pack, the requests which don't fit get no tiles and their lights are shaded without shadows
+        const uint32_t packed = m_shadow_atlas->Pack(m_shadow_atlas_requests);
+        for (const ShadowAtlasRequest& request : m_shadow_atlas_requests)
+        {
+            entities[request.id]->GetComponent<Light>()->SetShadowAtlasTiles(request);
+        }
+
+        // The atlas is allocated once a light needs it
+        if (packed != 0 && !m_shadow_atlas_depth)
+        {
+            m_shadow_atlas_depth = make_shared<RHI_Texture2D>(m_context, shadow_atlas_resolution, shadow_atlas_resolution, RHI_Format_D32_Float);
+            m_shadow_atlas_color = make_shared<RHI_Texture2D>(m_context, shadow_atlas_resolution, shadow_atlas_resolution, RHI_Format_R8G8B8A8_Unorm);
+        }
+
+        m_profiler->m_renderer_shadow_atlas_lights      = static_cast<uint32_t>(m_shadow_atlas_requests.size());
+        m_profiler->m_renderer_shadow_atlas_fallbacks   = static_cast<uint32_t>(m_shadow_atlas_requests.size()) - packed;
+        m_profiler->m_renderer_shadow_atlas_occupancy   = m_shadow_atlas->GetOccupancy() * 100.0f;
+    }
+
+    bool Renderer::UpdateLightGridBuffers()
+    {
+        if (!m_camera)
+            return false;
+
+        // Lights with shadow maps need them bound, so they keep their own passes (lights which didn't get an atlas tile are binned as unshadowed)
+        m_light_grid_lights.clear();
+        m_light_grid_sources.clear();
+        for (Entity* entity : m_entities[Renderer_Object_Light])
+        {
+            const Light* light = entity->GetComponent<Light>();
+            if (!light || light->GetLightType() == LightType_Directional || light->HasShadowMap())
+                continue;
+
+            const bool is_spot      = light->GetLightType() == LightType_Spot;
+            const Vector3 position  = light->GetTransform()->GetPositionInterpolated();
+            const Vector3 direction = light->GetDirection();
+
+            m_light_grid_lights.emplace_back();
+            BufferLightGridLight& buffer    = m_light_grid_lights.back();
+            buffer.position_range           = Vector4(position.x, position.y, position.z, light->GetRange());
+            buffer.color_intensity          = Vector4(light->GetColor().x, light->GetColor().y, light->GetColor().z, light->GetIntensity());
+            buffer.direction_angle          = Vector4(direction.x, direction.y, direction.z, is_spot ? light->GetAngle() : 0.0f);
+            m_light_grid_sources.emplace_back(light);
+        }
+
+        m_light_grid->Build(m_light_grid_lights, m_camera->GetViewMatrix(), m_camera->GetProjectionMatrix(), m_camera->GetNearPlane(), m_camera->GetFarPlane());
+        m_light_grid_overflow.clear();
+        for (const uint32_t index : m_light_grid->GetOverflow())
+        {
+            m_light_grid_overflow.emplace(m_light_grid_sources[index]);
+        }
+        m_profiler->m_renderer_light_grid_lights        = m_light_grid->GetClusteredCount();
+        m_profiler->m_renderer_light_grid_assignments   = m_light_grid->GetAssignmentCount();
+
+        if (m_light_grid->GetLightCount() == 0)
+            return true;
+
+        // Only the parts which are in use are copied
+        const size_t size_lights    = offsetof(BufferLightGridLights, lights) + m_light_grid->GetLightCount() * sizeof(BufferLightGridLight);
+        const size_t size_indices   = (m_light_grid->GetIndexCount() + 3) / 4 * sizeof(uint32_t);
+        auto update = [](RHI_ConstantBuffer* buffer_gpu, const void* buffer_cpu, const size_t size)
+        {
+            void* buffer = buffer_gpu->Map();
+            if (!buffer)
+            {
+                LOG_ERROR("Failed to map buffer");
+                return false;
+            }
+
+            memcpy(buffer, buffer_cpu, size);
+            return buffer_gpu->Unmap();
+        };
+
+        return
+            update(m_buffer_light_grid_lights_gpu.get(),    &m_light_grid->GetLights(),     size_lights)                        &&
+            update(m_buffer_light_grid_clusters_gpu.get(),  &m_light_grid->GetClusters(),   sizeof(BufferLightGridClusters))    &&
+            update(m_buffer_light_grid_indices_gpu.get(),   &m_light_grid->GetIndices(),    size_indices);
+    }
+
+    bool Renderer::UpdateMaterialBuffer(DrawList& draw_list)
+    {
+        // Pack two bindless texture slots per element, in Material texture order
+        const bool bindless = m_rhi_device->GetContextRhi()->bindless_textures;
+        auto pack = [this, bindless](Material* material, const Texture_Type type_low, const Texture_Type type_high)
+        {
+            const uint32_t low  = bindless ? m_descriptor_cache->GetBindlessIndex(material->GetTexture_PtrShared(type_low))  : 0;
+            const uint32_t high = bindless ? m_descriptor_cache->GetBindlessIndex(material->GetTexture_PtrShared(type_high)) : 0;
+            return (low & 0xFFFF) | (high << 16);
+        };
+
+        // Assign every material a slot (the table is append only within a frame, so earlier passes keep their slots)
+        for (DrawCall& draw_call : draw_list.GetDrawCalls())
+        {
+            Material* material = draw_call.material;
+
+            auto it = m_material_indices.find(material->GetId());
+            if (it != m_material_indices.end())
+            {
+                draw_call.material_index = it->second;
+                continue;
+            }
+
+            const uint32_t index = static_cast<uint32_t>(m_material_indices.size());
+            if (index >= material_table_size)
+            {
+                LOG_WARNING("Material table capacity of %d has been exceeded, skipping draw", material_table_size);
+                draw_call.material_index = material_table_size;
+                continue;
+            }
+
+            BufferMaterial& buffer      = m_buffer_materials_cpu.materials[index];
+            buffer.albedo               = material->GetColorAlbedo();
+            buffer.tiling_uv            = material->GetTiling();
+            buffer.offset_uv            = material->GetOffset();
+            buffer.roughness_mul        = material->GetMultiplier(Texture_Roughness);
+            buffer.metallic_mul         = material->GetMultiplier(Texture_Metallic);
+            buffer.normal_mul           = material->GetMultiplier(Texture_Normal);
+            buffer.height_mul           = material->GetMultiplier(Texture_Height);
+            buffer.texture_indices[0]   = pack(material, Texture_Albedo,    Texture_Roughness);
+            buffer.texture_indices[1]   = pack(material, Texture_Metallic,  Texture_Normal);
+            buffer.texture_indices[2]   = pack(material, Texture_Height,    Texture_Occlusion);
+            buffer.texture_indices[3]   = pack(material, Texture_Emission,  Texture_Mask);
+
+            m_material_indices[material->GetId()] = index;
+            draw_call.material_index = index;
+        }
+
+        // Only update if needed
+        const size_t size = m_material_indices.size() * sizeof(BufferMaterial);
+        if (memcmp(&m_buffer_materials_cpu, &m_buffer_materials_cpu_previous, size) == 0)
+            return true;
+
+        // Map
+        BufferMaterials* buffer = static_cast<BufferMaterials*>(m_buffer_materials_gpu->Map());
+        if (!buffer)
+        {
+            LOG_ERROR("Failed to map buffer");
+            return false;
+        }
+
+        // Update
+        memcpy(buffer, &m_buffer_materials_cpu, size);
+        memcpy(&m_buffer_materials_cpu_previous, &m_buffer_materials_cpu, size);
+
+        // Unmap
+        return m_buffer_materials_gpu->Unmap();
+    }
+
 	void Renderer::RenderablesAcquire(const Variant& entities_variant)
 	{
         SCOPED_TIME_BLOCK(m_profiler);
@@ -473,6 +1009,7 @@ namespace Spartan
 		// Clear previous state
 		m_entities.clear();
 		m_camera = nullptr;
+        m_shadow_caster_motion.clear();
 
 		vector<shared_ptr<Entity>> entities = entities_variant.Get<vector<shared_ptr<Entity>>>();
 		for (const auto& entity : entities)
@@ -528,7 +1065,7 @@ namespace Spartan
 			if (!material)
 				return 0.0f;
 
-			const auto num_depth    = (renderable->GetAabb().GetCenter() - m_camera->GetTransform()->GetPosition()).LengthSquared();
+			const auto num_depth    = (renderable->GetAabb().GetCenter() - m_camera->GetTransform()->GetPositionInterpolated()).LengthSquared();
 			const auto num_material = static_cast<float>(material->GetId());
 
 			return stof(to_string(num_depth) + "-" + to_string(num_material));
@@ -568,6 +1105,15 @@ namespace Spartan
         {
             return;
         }
+
+        // Shadow caching handling
+        if (option == Render_ShadowCaching)
+        {
+            for (const auto& light_entity : m_entities[Renderer_Object_Light])
+            {
+                light_entity->GetComponent<Light>()->CreateShadowCache();
+            }
+        }
 	}
 
     void Renderer::SetOptionValue(Renderer_Option_Value option, float value)
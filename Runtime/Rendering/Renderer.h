@@ -23,11 +23,14 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ========================
 #include <unordered_map>
+#include <unordered_set>
 #include "../Core/ISubsystem.h"
 #include "../RHI/RHI_Definition.h"
 #include "../RHI/RHI_Viewport.h"
 #include "../Math/Rectangle.h"
 #include "Renderer_ConstantBuffers.h"
+#include "DrawList.h"
+#include "RingAllocator.h"
 #include "../RHI/RHI_Vertex.h"
 //===================================
 
@@ -43,6 +46,11 @@ namespace Spartan
 	class Grid;
 	class Transform_Gizmo;
 	class Profiler;
+	class Threading;
+	class RenderGraph;
+	class LightGrid;
+	class ShadowAtlas;
+	struct ShadowAtlasRequest;
 	namespace Math
 	{
 		class BoundingBox;
@@ -72,7 +80,8 @@ namespace Spartan
 		Render_ChromaticAberration	        = 1 << 18,
 		Render_Dithering			        = 1 << 19,
         Render_ReverseZ                     = 1 << 20,
-        Render_DepthPrepass                 = 1 << 21
+        Render_DepthPrepass                 = 1 << 21,
+        Render_ShadowCaching                = 1 << 22
 	};
 
     enum Renderer_Option_Value
@@ -167,7 +176,11 @@ namespace Spartan
 		Shader_BlurBox_P,
 		Shader_BlurGaussian_P,
 		Shader_BlurGaussianBilateral_P,
-        Shader_Entity_Outline_P
+        Shader_Entity_Outline_P,
+        Shader_Gbuffer_Instanced_V,
+        Shader_Depth_Instanced_V,
+        Shader_LightClustered_P,
+        Shader_Depth_Cache_P
 	};
 
     enum Renderer_RenderTarget_Type
@@ -197,7 +210,9 @@ namespace Spartan
         // SSR
         RenderTarget_Ssr,
         // Frame
-        RenderTarget_TaaHistory
+        RenderTarget_TaaHistory,
+        // Bloom (the first texture of the chain, the rest follow)
+        RenderTarget_Bloom
     };
 
 	class SPARTAN_CLASS Renderer : public ISubsystem
@@ -215,6 +230,7 @@ namespace Spartan
 		void DrawLine(const Math::Vector3& from, const Math::Vector3& to, const Math::Vector4& color_from = DebugColor, const Math::Vector4& color_to = DebugColor, bool depth = true);
         void DrawRectangle(const Math::Rectangle& rectangle, const Math::Vector4& color = DebugColor, bool depth = true);
 		void DrawBox(const Math::BoundingBox& box, const Math::Vector4& color = DebugColor, bool depth = true);
+		void DrawString(const std::string& text, const Math::Vector2& position); // in pixels, relative to the center of the screen
 
 		// Viewport
 		const auto& GetViewport() const			        { return m_viewport; }
@@ -255,6 +271,7 @@ namespace Spartan
 
         // Misc
         const auto& GetRhiDevice()	                const { return m_rhi_device; }
+        Font* GetFont()                             const { return m_font.get(); }
         const auto& GetSwapChain()                  const { return m_swap_chain; }
         RHI_PipelineCache* GetPipelineCache()       const { return m_pipeline_cache.get(); }
         RHI_DescriptorCache* GetDescriptorCache()   const { return m_descriptor_cache.get(); }
@@ -271,6 +288,14 @@ namespace Spartan
         void SetGlobalSamplersAndConstantBuffers(RHI_CommandList* cmd_list) const;
         RHI_Texture* GetBlackTexture() const { return m_tex_black.get(); }
 
+        // Recording
+        typedef std::function<void(RHI_CommandList* cmd_list, uint32_t start, uint32_t end)> record_function;
+        // Records [0, count) into the pass the command list is recording. When the backend supports it, the range is split into contiguous chunks
+        // which are recorded in parallel into secondary command lists, those are then executed in chunk order, so the draws end up in the same
+        // order as if a single thread recorded them. The record function is invoked concurrently, it should only record into the list it's given.
+        // A chunk count of 0 picks one per available thread, as long as the chunks are big enough to be worth it.
+        void RecordChunked(RHI_CommandList* cmd_list, uint32_t count, const record_function& record, uint32_t chunk_count = 0);
+
 	private:
         // Resource creation
         void CreateConstantBuffers();
@@ -320,13 +345,41 @@ namespace Spartan
         // Constant buffers
         bool UpdateFrameBuffer();
         bool UpdateUberBuffer();
-        bool UpdateObjectBuffer(RHI_CommandList* cmd_list, const uint32_t entity_index = 0);
+        bool UpdateObjectBuffer(RHI_CommandList* cmd_list);
         bool UpdateLightBuffer(const Light* light);
+        bool UpdateMaterialBuffer(DrawList& draw_list); // assigns the draws their material's slot in the material table
+        bool UpdateLightGridBuffers(); // bins the unshadowed point and spot lights into the light grid
+
+        // Object and instance buffers (rings with one region per frame in flight)
+        typedef std::function<void(const DrawCall& draw_call, BufferObject& buffer)> object_fill_function;
+        bool CreateObjectBuffer(const uint32_t elements_per_frame);
+        bool CreateInstanceBuffer(const uint32_t elements_per_frame);
+        bool AllocateObjects(const uint32_t count, uint32_t& index);
+        bool AllocateInstances(const uint32_t count, uint32_t& index);
+        BufferObject* GetObjectBufferElement(const uint32_t index);
+        BufferInstances* GetInstanceBufferElement(const uint32_t index);
+        bool StreamDrawList(DrawList& draw_list, const object_fill_function& fill);
+        bool BindObjectBuffer(RHI_CommandList* cmd_list, const uint32_t object_index);
+        bool BindInstanceBuffer(RHI_CommandList* cmd_list, const uint32_t instance_index);
+
+        // Shadow caching
+        void UpdateShadowCasterMotion(); // classifies the opaque entities into static and dynamic shadow casters
+        uint64_t ComputeShadowCacheSignature(const DrawList& draw_list, const Math::Matrix& view_projection) const;
+
+        // Shadow atlas
+        void UpdateShadowAtlas(); // assigns the point and spot lights their shadow atlas tiles
 
         // Misc
         void RenderablesAcquire(const Variant& renderables);
         void RenderablesSort(std::vector<Entity*>* renderables);
         void ClearEntities() { m_entities.clear(); }
+        void RegisterPipelineObjects();
+        void RegisterPipelineShaderVariations();
+        void UpdateShaders(const float delta_time); // compiles requested shader variations and hot reloads modified shaders
+        bool AcquireTransientRenderTargets(); // points the render targets to the textures the render graph assigned them, returns true if any were registered with the pipeline cache
+
+        // Render graph (owns the transient render targets)
+        std::unique_ptr<RenderGraph> m_render_graph;
 
         // Render textures
         std::unordered_map<Renderer_RenderTarget_Type, std::shared_ptr<RHI_Texture>> m_render_targets;
@@ -342,6 +395,9 @@ namespace Spartan
 
 		// Shaders
 		std::unordered_map<Renderer_Shader_Type, std::shared_ptr<RHI_Shader>> m_shaders;
+        std::unordered_map<Renderer_Shader_Type, std::shared_ptr<RHI_Shader>> m_shaders_reloading; // recompiling in the background, replace the current ones once they succeed
+        std::vector<std::pair<std::shared_ptr<RHI_Shader>, uint64_t>> m_shaders_retired; // replaced, but pipelines from previous frames may still use them, and the frame they can be released on
+        float m_shader_reload_timer = 0.0f;
 
 		// Depth-stencil states
         std::shared_ptr<RHI_DepthStencilState> m_depth_stencil_disabled;
@@ -416,26 +472,74 @@ namespace Spartan
         std::shared_ptr<RHI_ConstantBuffer> m_buffer_uber_gpu;
 
         BufferObject m_buffer_object_cpu;
-        BufferObject m_buffer_object_cpu_previous;
+        std::vector<BufferObject> m_buffer_object_cpu_ring; // only used when the gpu buffer can't stay mapped
+        RingAllocator m_buffer_object_ring;
         std::shared_ptr<RHI_ConstantBuffer> m_buffer_object_gpu;
 
+        std::vector<BufferInstances> m_buffer_instances_cpu_ring; // only used when the gpu buffer can't stay mapped
+        RingAllocator m_buffer_instances_ring;
+        std::shared_ptr<RHI_ConstantBuffer> m_buffer_instances_gpu;
+
+        std::vector<std::pair<std::shared_ptr<RHI_ConstantBuffer>, uint64_t>> m_buffers_retired; // replaced object and instance buffers, and the frame they can be released on
+        bool m_buffer_object_rebind = false; // the object buffer was replaced and has to be bound again
+
         BufferLight m_buffer_light_cpu;
         BufferLight m_buffer_light_cpu_previous;
         std::shared_ptr<RHI_ConstantBuffer> m_buffer_light_gpu;
+
+        BufferMaterials m_buffer_materials_cpu          = {};
+        BufferMaterials m_buffer_materials_cpu_previous = {};
+        std::shared_ptr<RHI_ConstantBuffer> m_buffer_materials_gpu;
+        std::unordered_map<uint32_t, uint32_t> m_material_indices; // material id -> slot in the material table, rebuilt every frame
+
+        std::unique_ptr<LightGrid> m_light_grid;
+        std::vector<BufferLightGridLight> m_light_grid_lights;
+        std::vector<const Light*> m_light_grid_sources;             // parallel to m_light_grid_lights
+        std::unordered_set<const Light*> m_light_grid_overflow;     // lights the grid couldn't take, they keep their own passes
+        std::shared_ptr<RHI_ConstantBuffer> m_buffer_light_grid_lights_gpu;
+        std::shared_ptr<RHI_ConstantBuffer> m_buffer_light_grid_clusters_gpu;
+        std::shared_ptr<RHI_ConstantBuffer> m_buffer_light_grid_indices_gpu;
+
+        std::unique_ptr<ShadowAtlas> m_shadow_atlas;
+        std::vector<ShadowAtlasRequest> m_shadow_atlas_requests;
+        std::shared_ptr<RHI_Texture> m_shadow_atlas_depth; // the point and spot light shadow maps
+        std::shared_ptr<RHI_Texture> m_shadow_atlas_color; // their transparent shadows
         //======================================================
 
         // Entities & Components
         std::unordered_map<Renderer_Object_Type, std::vector<Entity*>> m_entities;
         std::shared_ptr<Camera> m_camera;
 
+        // Shadow caster motion, casters which haven't moved for a while are kept in the lights' shadow caches
+        struct ShadowCasterMotion
+        {
+            Math::Matrix world;
+            uint64_t frame_moved = 0;
+        };
+        std::unordered_map<uint32_t, ShadowCasterMotion> m_shadow_caster_motion; // entity id -> last world matrix
+        std::vector<uint8_t> m_shadow_caster_static; // per opaque entity, rebuilt every frame
+
+        // Draw lists (culled in parallel, recorded in order)
+        DrawList m_draw_list_light;
+        DrawList m_draw_list_light_static;
+        DrawList m_draw_list_depth;
+        DrawList m_draw_list_gbuffer;
+
         // RHI Core
         std::shared_ptr<RHI_Device> m_rhi_device;
         std::shared_ptr<RHI_SwapChain> m_swap_chain;
         std::shared_ptr<RHI_PipelineCache> m_pipeline_cache;
         std::shared_ptr<RHI_DescriptorCache> m_descriptor_cache;
+        uint32_t m_pipeline_variation_version = 0;
+
+        // Chunked recording, one secondary command list (with its own descriptor cache) per chunk
+        std::vector<std::shared_ptr<RHI_CommandList>> m_cmd_lists_secondary;
+        std::vector<RHI_CommandList*> m_record_cmd_lists;
+        std::vector<std::pair<uint32_t, uint32_t>> m_record_ranges;
 
         // Dependencies
         Profiler* m_profiler            = nullptr;
         ResourceCache* m_resource_cache = nullptr;
+        Threading* m_threading          = nullptr;
     };
 }
@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ===============
 #include "..\Math\Vector2.h"
 #include "..\Math\Vector3.h"
+#include "..\Math\Vector4.h"
 #include "..\Math\Matrix.h"
 //==========================
 
@@ -113,16 +114,93 @@ namespace Spartan
         Math::Matrix object;
         Math::Matrix wvp_current;
         Math::Matrix wvp_previous;
+
+        uint32_t material_index;
+        uint32_t padding[3];
     
         bool operator==(const BufferObject& rhs) const
         {
             return
                 object          == rhs.object       &&
                 wvp_current     == rhs.wvp_current  &&
-                wvp_previous    == rhs.wvp_previous;
+                wvp_previous    == rhs.wvp_previous &&
+                material_index  == rhs.material_index;
         }
     };
     
+    // High frequency - Updates per batch of instances, instanced draws index it with the instance id
+    static const uint32_t instance_batch_size = 64; // 8 KB, within the smallest uniform buffer range Vulkan guarantees (16 KB)
+
+    struct BufferInstance
+    {
+        Math::Matrix transform;
+        Math::Matrix wvp_previous;
+    };
+
+    struct BufferInstances
+    {
+        uint32_t material_index; // instances share their material
+        uint32_t padding[3];
+        BufferInstance instances[instance_batch_size];
+    };
+
+    // Low frequency - The properties of every material drawn in a frame, draws index it instead of rebinding per material
+    static const uint32_t material_table_size = 256; // 16 KB, within the smallest uniform buffer range Vulkan guarantees
+
+    struct BufferMaterial
+    {
+        Math::Vector4 albedo;
+
+        Math::Vector2 tiling_uv;
+        Math::Vector2 offset_uv;
+
+        float roughness_mul;
+        float metallic_mul;
+        float normal_mul;
+        float height_mul;
+
+        uint32_t texture_indices[4]; // slots in the bindless texture array, two 16-bit indices per element (in Material texture order)
+    };
+
+    struct BufferMaterials
+    {
+        BufferMaterial materials[material_table_size];
+    };
+
+    // Low frequency - The unshadowed point and spot lights of a frame, binned into view space clusters so that a single pass can shade them
+    static const uint32_t light_grid_x          = 16;    // screen tiles
+    static const uint32_t light_grid_y          = 8;     // screen tiles
+    static const uint32_t light_grid_z          = 24;    // depth slices, exponentially distributed between the near and far plane
+    static const uint32_t light_grid_clusters   = light_grid_x * light_grid_y * light_grid_z;
+    static const uint32_t light_grid_lights     = 256;   // 12 KB
+    static const uint32_t light_grid_indices    = 16384; // 8-bit light indices, 16 KB
+
+    struct BufferLightGridLight
+    {
+        Math::Vector4 position_range;
+        Math::Vector4 color_intensity;
+        Math::Vector4 direction_angle; // an angle of zero means a point light
+    };
+
+    struct BufferLightGridLights
+    {
+        float light_count;
+        float slice_scale;  // depth slice = log(view z) * scale + bias
+        float slice_bias;
+        float padding;
+        BufferLightGridLight lights[light_grid_lights];
+    };
+
+    struct BufferLightGridClusters
+    {
+        uint32_t clusters[light_grid_clusters]; // offset into the index list (low 16 bits) and light count (high 16 bits), 12 KB
+    };
+
+    struct BufferLightGridIndices
+    {
+        uint32_t indices[light_grid_indices / 4]; // four 8-bit light indices per element
+    };
+    
     // Light buffer
     struct BufferLight
     {
@@ -132,6 +210,7 @@ namespace Spartan
         Math::Vector4 color;
         Math::Vector4 position;
         Math::Vector4 direction;
+        Math::Vector4 atlas_rects[6]; // uv offset (xy) and scale (zw) of each slice's shadow atlas tile
     
         bool operator==(const BufferLight& rhs)
         {
@@ -141,7 +220,8 @@ namespace Spartan
                 normalBias_shadow_volumetric_contact    == rhs.normalBias_shadow_volumetric_contact &&
                 color                                   == rhs.color                                &&
                 position                                == rhs.position                             &&
-                direction                               == rhs.direction;
+                direction                               == rhs.direction                            &&
+                atlas_rects                             == rhs.atlas_rects;
         }
     };
 }
@@ -25,12 +25,17 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Font/Font.h"
 #include "../Profiling/Profiler.h"
 #include "ShaderVariation.h"
+#include "RenderGraph.h"
+#include "LightGrid.h"
+#include "ShadowAtlas.h"
 #include "Gizmos/Grid.h"
 #include "Gizmos/Transform_Gizmo.h"
+#include "../Utilities/Hash.h"
 #include "../RHI/RHI_CommandList.h"
 #include "../RHI/RHI_Implementation.h"
 #include "../RHI/RHI_VertexBuffer.h"
 #include "../RHI/RHI_PipelineState.h"
+#include "../RHI/RHI_PipelineCache.h"
 #include "../RHI/RHI_Texture.h"
 #include "../World/Entity.h"
 #include "../World/Components/Light.h"
@@ -46,6 +51,8 @@ using namespace Spartan::Math;
 
 namespace Spartan
 {
+    static const uint64_t shadow_caster_static_frames = 60; // a shadow caster which hasn't moved for this many frames is cached with the static ones
+
     void Renderer::SetGlobalSamplersAndConstantBuffers(RHI_CommandList* cmd_list) const
     {
         // Constant buffers
@@ -53,6 +60,7 @@ namespace Spartan
         cmd_list->SetConstantBuffer(1, RHI_Shader_Vertex | RHI_Shader_Pixel | RHI_Shader_Compute, m_buffer_uber_gpu);
         cmd_list->SetConstantBuffer(2, RHI_Shader_Vertex, m_buffer_object_gpu);
         cmd_list->SetConstantBuffer(3, RHI_Shader_Pixel, m_buffer_light_gpu);
+        cmd_list->SetConstantBuffer(4, RHI_Shader_Pixel, m_buffer_materials_gpu);
         
         // Samplers
         cmd_list->SetSampler(0, m_sampler_compare_depth);
@@ -74,12 +82,38 @@ namespace Spartan
         // Updates onces, used almost everywhere
         UpdateFrameBuffer();
 
+        // Sizes the point and spot light shadow maps, the lights which don't fit are binned with the unshadowed ones
+        UpdateShadowAtlas();
+
+        // Bins the lights which the clustered light pass shades
+        UpdateLightGridBuffers();
+
+        // The material table is rebuilt by the G-Buffer passes
+        m_material_indices.clear();
+
         // Runs only once
         Pass_BrdfSpecularLut(cmd_list);
 
         const bool draw_transparent_objects = !m_entities[Renderer_Object_Transparent].empty();
 
+        // Transient render targets, only the effects which are enabled use (and therefore allocate) theirs
+        const vector<uint32_t> targets_light    = { RenderTarget_Light_Diffuse, RenderTarget_Light_Specular, RenderTarget_Light_Volumetric };
+        const vector<uint32_t> targets_ssao     = GetOption(Render_ScreenSpaceAmbientOcclusion) ? vector<uint32_t>{ RenderTarget_Ssao_Noisy, RenderTarget_Ssao } : vector<uint32_t>();
+        const vector<uint32_t> targets_ssr      = GetOption(Render_ScreenSpaceReflections) ? vector<uint32_t>{ RenderTarget_Ssr } : vector<uint32_t>();
+        vector<uint32_t> targets_composition    = targets_light;
+        targets_composition.insert(targets_composition.end(), targets_ssao.begin(), targets_ssao.end());
+        targets_composition.insert(targets_composition.end(), targets_ssr.begin(), targets_ssr.end());
+        vector<uint32_t> targets_bloom;
+        if (GetOption(Render_Bloom))
+        {
+            for (uint32_t i = 0; i < static_cast<uint32_t>(m_render_tex_bloom.size()); i++)
+            {
+                targets_bloom.emplace_back(RenderTarget_Bloom + i);
+            }
+        }
+
         // Depth
+        m_render_graph->AddPass("Depth", {}, {}, [this, cmd_list, draw_transparent_objects]()
         {
             Pass_LightDepth(cmd_list, Renderer_Object_Opaque);
             if (draw_transparent_objects)
@@ -91,41 +125,64 @@ namespace Spartan
             {
                 Pass_DepthPrePass(cmd_list);
             }
-        }
+        });
 
         // G-Buffer to Composition
         {
             // Lighting
-            Pass_GBuffer(cmd_list, Renderer_Object_Opaque);
-            Pass_Ssao(cmd_list, false);
-            Pass_Ssr(cmd_list, false);
-            Pass_Light(cmd_list, false);
-            Pass_Composition(cmd_list, m_render_targets[RenderTarget_Composition_Hdr], false);
+            m_render_graph->AddPass("GBuffer", {}, {}, [this, cmd_list]()           { Pass_GBuffer(cmd_list, Renderer_Object_Opaque); });
+            m_render_graph->AddPass("Ssao", {}, targets_ssao, [this, cmd_list]()    { Pass_Ssao(cmd_list, false); });
+            m_render_graph->AddPass("Ssr", {}, targets_ssr, [this, cmd_list]()      { Pass_Ssr(cmd_list, false); });
+            m_render_graph->AddPass("Light", {}, targets_light, [this, cmd_list]()  { Pass_Light(cmd_list, false); });
+            m_render_graph->AddPass("Composition", targets_composition, {}, [this, cmd_list]() { Pass_Composition(cmd_list, m_render_targets[RenderTarget_Composition_Hdr], false); });
 
             // Lighting for transparent objects
             if (draw_transparent_objects)
             {
-                Pass_GBuffer(cmd_list, Renderer_Object_Transparent);
-                Pass_Ssao(cmd_list, true);
-                Pass_Ssr(cmd_list, true);
-                Pass_Light(cmd_list, true);
-                Pass_Composition(cmd_list, m_render_targets[RenderTarget_Composition_Hdr_2], true);
-
-                // Alpha blend the transparent composition on top of opaque one
-                Pass_AlphaBlend(cmd_list, m_render_targets[RenderTarget_Composition_Hdr_2].get(), m_render_targets[RenderTarget_Composition_Hdr].get(), true);
+                m_render_graph->AddPass("GBuffer_Transparent", {}, {}, [this, cmd_list]()          { Pass_GBuffer(cmd_list, Renderer_Object_Transparent); });
+                m_render_graph->AddPass("Ssao_Transparent", {}, targets_ssao, [this, cmd_list]()    { Pass_Ssao(cmd_list, true); });
+                m_render_graph->AddPass("Ssr_Transparent", {}, targets_ssr, [this, cmd_list]()      { Pass_Ssr(cmd_list, true); });
+                m_render_graph->AddPass("Light_Transparent", {}, targets_light, [this, cmd_list]()  { Pass_Light(cmd_list, true); });
+                m_render_graph->AddPass("Composition_Transparent", targets_composition, {}, [this, cmd_list]()
+                {
+                    Pass_Composition(cmd_list, m_render_targets[RenderTarget_Composition_Hdr_2], true);
+
+                    // Alpha blend the transparent composition on top of opaque one
+                    Pass_AlphaBlend(cmd_list, m_render_targets[RenderTarget_Composition_Hdr_2].get(), m_render_targets[RenderTarget_Composition_Hdr].get(), true);
+                });
             }
         }
 
         // Post-processing
-        {  
-            Pass_PostProcess(cmd_list);
+        m_render_graph->AddPass("PostProcess", {}, targets_bloom, [this, cmd_list]() { Pass_PostProcess(cmd_list); });
+
+        // Editor and debug
+        vector<uint32_t> targets_debug;
+        if (m_debug_buffer == Renderer_Buffer_Diffuse)                                          targets_debug = { RenderTarget_Light_Diffuse };
+        if (m_debug_buffer == Renderer_Buffer_Specular)                                         targets_debug = { RenderTarget_Light_Specular };
+        if (m_debug_buffer == Renderer_Buffer_VolumetricLighting)                               targets_debug = { RenderTarget_Light_Volumetric };
+        if (m_debug_buffer == Renderer_Buffer_SSAO && !targets_ssao.empty())                    targets_debug = { RenderTarget_Ssao };
+        if (m_debug_buffer == Renderer_Buffer_SSR && !targets_ssr.empty())                      targets_debug = { RenderTarget_Ssr };
+        if (m_debug_buffer == Renderer_Buffer_Bloom && !targets_bloom.empty())                  targets_debug = { RenderTarget_Bloom };
+        m_render_graph->AddPass("Editor", targets_debug, {}, [this, cmd_list]()
+        {
             Pass_Outline(cmd_list, m_render_targets[RenderTarget_Composition_Ldr]);
             Pass_Lines(cmd_list, m_render_targets[RenderTarget_Composition_Ldr]);
             Pass_TransformHandle(cmd_list, m_render_targets[RenderTarget_Composition_Ldr].get());
             Pass_Icons(cmd_list, m_render_targets[RenderTarget_Composition_Ldr].get());      
             Pass_DebugBuffer(cmd_list, m_render_targets[RenderTarget_Composition_Ldr]);
             Pass_Text(cmd_list, m_render_targets[RenderTarget_Composition_Ldr].get());
+        });
+
+        // Assign the transient render targets and run the passes
+        m_render_graph->Compile();
+        if (AcquireTransientRenderTargets())
+        {
+            // The frame's prewarm ran before the render targets were registered, so pipelines
+            // from previous runs which render to them get their attempt before the passes need them
+            m_pipeline_cache->Prewarm(m_descriptor_cache.get());
         }
+        m_render_graph->Execute(cmd_list);
 	}
 
 	void Renderer::Pass_LightDepth(RHI_CommandList* cmd_list, const Renderer_Object_Type object_type)
@@ -133,6 +190,10 @@ namespace Spartan
         // All opaque objects are rendered from the lights point of view.
         // Opaque objects write their depth information to a depth buffer, using just a vertex shader.
         // Transparent objects, read the opaque depth but don't write their own, instead, they write their color information using a pixel shader.
+        // With shadow caching, the opaque objects which haven't moved for a while are rendered into a cache per slice, and only when the
+        // slice's signature (its view projection and the static objects in it) changes. Every frame, the cached depth is copied into the
+        // slice and the dynamic objects are rendered on top of it.
+        // Directional lights render into their own cascade arrays, point and spot lights into their tiles of the shared shadow atlas.
 
 		// Acquire shader
 		RHI_Shader* shader_v = m_shaders[Shader_Depth_V].get();
@@ -140,6 +201,10 @@ namespace Spartan
 		if (!shader_v->IsCompiled() || !shader_p->IsCompiled())
 			return;
 
+        // Identical draws are instanced, once the instanced variation has compiled
+        RHI_Shader* shader_v_instanced  = m_shaders[Shader_Depth_Instanced_V].get();
+        const uint32_t batch_size_max   = shader_v_instanced->IsCompiled() ? instance_batch_size : 1;
+
         // Get entities
         const auto& entities = m_entities[object_type];
         if (entities.empty())
@@ -147,14 +212,131 @@ namespace Spartan
 
         const bool transparent_pass = object_type == Renderer_Object_Transparent;
 
+        // Shadow caching (opaque only, the transparent shadows are cheap to re-render)
+        RHI_Shader* shader_v_quad   = m_shaders[Shader_Quad_V].get();
+        RHI_Shader* shader_p_cache  = m_shaders[Shader_Depth_Cache_P].get();
+        const bool shadow_caching   = !transparent_pass && GetOption(Render_ShadowCaching) && shader_v_quad->IsCompiled() && shader_p_cache->IsCompiled();
+        if (shadow_caching)
+        {
+            UpdateShadowCasterMotion();
+        }
+
+        // Groups identical draws, streams their cascade transforms and records them, single draws first (the first begin also clears), then the instanced ones.
+        // If the pipeline state has no viewport, the given one (an atlas tile) is set dynamically. Returns false if nothing could be recorded.
+        const auto draw_list_record = [this, cmd_list, transparent_pass, batch_size_max, shader_v, shader_v_instanced](DrawList& draw_list, RHI_PipelineState& pipeline_state, const RHI_Viewport& viewport)
+        {
+            draw_list.Batch(batch_size_max);
+            StreamDrawList(draw_list, [](const DrawCall& draw_call, BufferObject& buffer)
+            {
+                buffer.object = draw_call.wvp;
+            });
+
+            bool recorded = false;
+            for (RHI_Shader* shader : { shader_v, shader_v_instanced })
+            {
+                const bool is_instanced = shader == shader_v_instanced;
+                if (is_instanced && !draw_list.HasInstances())
+                    continue;
+
+                pipeline_state.shader_vertex = shader;
+
+                if (cmd_list->Begin(pipeline_state))
+                {
+                    recorded = true;
+
+                    if (!pipeline_state.viewport.IsDefined())
+                    {
+                        cmd_list->SetViewport(viewport);
+                    }
+
+                    // Useful to avoid constant buffer updates
+                    uint32_t m_set_material_id = 0;
+
+                    for (const DrawBatch& batch : draw_list.GetBatches())
+                    {
+                        if ((batch.count > 1) != is_instanced)
+                            continue;
+
+                        const DrawCall& draw_call   = draw_list.GetDrawCalls()[batch.first];
+                        Material* material          = draw_call.material;
+
+                        // Bind material
+                        if (transparent_pass && m_set_material_id != material->GetId())
+                        {
+                            // Bind material textures
+                            RHI_Texture* tex_albedo = material->GetTexture_Ptr(Texture_Albedo);
+                            cmd_list->SetTexture(28, tex_albedo ? tex_albedo : m_tex_white.get());
+
+                            // Update uber buffer with material properties
+                            m_buffer_uber_cpu.mat_albedo    = material->GetColorAlbedo();
+                            m_buffer_uber_cpu.mat_tiling_uv = material->GetTiling();
+                            m_buffer_uber_cpu.mat_offset_uv = material->GetOffset();
+
+                            // Update constant buffer
+                            UpdateUberBuffer();
+
+                            m_set_material_id = material->GetId();
+                        }
+
+                        // Bind geometry
+                        cmd_list->SetBufferIndex(draw_call.index_buffer);
+                        cmd_list->SetBufferVertex(draw_call.vertex_buffer);
+
+                        // Bind cascade transforms and draw
+                        if (is_instanced)
+                        {
+                            if (!BindInstanceBuffer(cmd_list, batch.instance_index))
+                                continue;
+
+                            cmd_list->DrawIndexedInstanced(draw_call.index_count, batch.count, draw_call.index_offset, draw_call.vertex_offset);
+                        }
+                        else
+                        {
+                            if (!BindObjectBuffer(cmd_list, draw_call.object_index))
+                                continue;
+
+                            cmd_list->DrawIndexed(draw_call.index_count, draw_call.index_offset, draw_call.vertex_offset);
+                        }
+                    }
+                    cmd_list->End(); // end of array
+                    cmd_list->Submit();
+                }
+            }
+
+            return recorded;
+        };
+
+        // The atlas tiles are never cleared individually, so the whole atlas is cleared once, before the opaque casters are rendered
+        if (!transparent_pass && m_shadow_atlas_depth && m_shadow_atlas->GetOccupancy() > 0.0f)
+        {
+            static RHI_PipelineState pipeline_state_atlas;
+            pipeline_state_atlas.shader_vertex                      = shader_v;
+            pipeline_state_atlas.rasterizer_state                   = m_rasterizer_cull_back_solid.get();
+            pipeline_state_atlas.blend_state                        = m_blend_disabled.get();
+            pipeline_state_atlas.depth_stencil_state                = m_depth_stencil_enabled_disabled_write.get();
+            pipeline_state_atlas.render_target_color_textures[0]    = m_shadow_atlas_color.get();
+            pipeline_state_atlas.render_target_depth_texture        = m_shadow_atlas_depth.get();
+            pipeline_state_atlas.viewport                           = m_shadow_atlas_depth->GetViewport();
+            pipeline_state_atlas.primitive_topology                 = RHI_PrimitiveTopology_TriangleList;
+            pipeline_state_atlas.clear_color[0]                     = Vector4::One;
+            pipeline_state_atlas.clear_depth                        = GetClearDepth();
+            pipeline_state_atlas.pass_name                          = "Pass_LightShadowAtlasClear";
+
+            if (cmd_list->Begin(pipeline_state_atlas))
+            {
+                cmd_list->End();
+                cmd_list->Submit();
+            }
+        }
+
         // Go through all of the lights
 		const auto& entities_light = m_entities[Renderer_Object_Light];
         for (uint32_t light_index = 0; light_index < entities_light.size(); light_index++)
         {
-            const Light* light = entities_light[light_index]->GetComponent<Light>();
+            Light* light = entities_light[light_index]->GetComponent<Light>();
 
-            // Skip some obvious cases
-            if (!light || !light->GetShadowsEnabled())
+            // Skip some obvious cases (including the lights which didn't get an atlas tile)
+            if (!light || !light->HasShadowMap())
                 continue;
 
             // Skip lights that don't cast transparent shadows (if this is a transparent pass)
@@ -162,8 +344,9 @@ namespace Spartan
                 continue;
 
             // Acquire light's shadow maps
-            RHI_Texture* tex_depth = light->GetDepthTexture();
-            RHI_Texture* tex_color = light->GetColorTexture();
+            const bool is_atlas     = light->GetLightType() != LightType_Directional;
+            RHI_Texture* tex_depth  = is_atlas ? m_shadow_atlas_depth.get() : light->GetDepthTexture();
+            RHI_Texture* tex_color  = is_atlas ? m_shadow_atlas_color.get() : light->GetColorTexture();
             if (!tex_depth)
                 continue;
 
@@ -175,19 +358,26 @@ namespace Spartan
             pipeline_state.depth_stencil_state              = transparent_pass ? m_depth_stencil_enabled_disabled_read.get() : m_depth_stencil_enabled_disabled_write.get();
             pipeline_state.render_target_color_textures[0]  = tex_color; // always bind so we can clear to white (in case there are now transparent objects)
             pipeline_state.render_target_depth_texture      = tex_depth;
-            pipeline_state.viewport                         = tex_depth->GetViewport();
+            pipeline_state.viewport                         = is_atlas ? RHI_Viewport::Undefined : tex_depth->GetViewport(); // atlas tiles are set dynamically
             pipeline_state.primitive_topology               = RHI_PrimitiveTopology_TriangleList;
             pipeline_state.pass_name                        = transparent_pass ? "Pass_LightShadowTransparent" : "Pass_LightShadow";
 
-            for (uint32_t array_index = 0; array_index < tex_depth->GetArraySize(); array_index++)
+            for (uint32_t array_index = 0; array_index < light->GetShadowArraySize(); array_index++)
             {
+                // The cached static casters of this slice, if any
+                RHI_Texture* tex_static = shadow_caching ? light->GetShadowCacheTexture(array_index) : nullptr;
+
+                // The slice's atlas tile
+                const Vector4& tile             = light->GetShadowAtlasTile(array_index);
+                const RHI_Viewport viewport     = is_atlas ? RHI_Viewport(tile.x, tile.y, tile.z, tile.w) : RHI_Viewport::Undefined;
+
                 // Set render target texture array index
-                pipeline_state.render_target_color_texture_array_index          = array_index;
-                pipeline_state.render_target_depth_stencil_texture_array_index  = array_index;
+                pipeline_state.render_target_color_texture_array_index          = is_atlas ? 0 : array_index;
+                pipeline_state.render_target_depth_stencil_texture_array_index  = is_atlas ? 0 : array_index;
 
-                // Set clear values
-                pipeline_state.clear_color[0] = Vector4::One;
-                pipeline_state.clear_depth    = transparent_pass ? state_dont_clear_depth : GetClearDepth();
+                // Set clear values (with a cache, the depth is cleared when the cache is copied in, the atlas is cleared as a whole)
+                pipeline_state.clear_color[0] = is_atlas ? state_dont_clear_color : Vector4::One;
+                pipeline_state.clear_depth    = (transparent_pass || tex_static || is_atlas) ? state_dont_clear_depth : GetClearDepth();
 
                 const Matrix& view_projection = light->GetViewMatrix(array_index) * light->GetProjectionMatrix(array_index);
 
@@ -204,74 +394,152 @@ namespace Spartan
                     pipeline_state.rasterizer_state = m_rasterizer_cull_back_solid.get();
                 }
 
-                if (cmd_list->Begin(pipeline_state))
+                const DrawList::cull_function cull = [light, array_index, &view_projection](DrawCall& draw_call)
                 {
-                    // Useful to avoid constant buffer updates
-                    uint32_t m_set_material_id = 0;
+                    Renderable* renderable = draw_call.renderable;
 
-                    for (uint32_t entity_index = 0; entity_index < static_cast<uint32_t>(entities.size()); entity_index++)
-                    {
-                        Entity* entity = entities[entity_index];
+                    // Skip meshes that don't cast shadows
+                    if (!renderable->GetCastShadows())
+                        return false;
 
-                        // Acquire renderable component
-                        const auto& renderable = entity->GetRenderable();
-                        if (!renderable)
-                            continue;
+                    // Acquire material
+                    draw_call.material = renderable->GetMaterial().get();
+                    if (!draw_call.material)
+                        return false;
 
-                        // Skip meshes that don't cast shadows
-                        if (!renderable->GetCastShadows())
-                            continue;
+                    // Skip objects outside of the view frustum
+                    if (!light->IsInViewFrustrum(*draw_call.aabb, array_index))
+                        return false;
 
-                        // Acquire geometry
-                        const auto& model = renderable->GeometryModel();
-                        if (!model || !model->GetVertexBuffer() || !model->GetIndexBuffer())
-                            continue;
+                    // Cascade transform
+                    draw_call.wvp = draw_call.transform->GetMatrixInterpolated() * view_projection;
 
-                        // Acquire material
-                        const auto& material = renderable->GetMaterial();
-                        if (!material)
-                            continue;
+                    return true;
+                };
 
-                        // Skip objects outside of the view frustum
-                        if (!light->IsInViewFrustrum(renderable, array_index))
-                            continue;
+                if (tex_static)
+                {
+                    // Cull the static casters in parallel, and re-render them only if they (or the slice) changed since they were cached
+                    m_draw_list_light_static.Build(m_threading, entities, [this, &cull](DrawCall& draw_call)
+                    {
+                        return m_shadow_caster_static[draw_call.entity_index] && cull(draw_call);
+                    });
 
-                        // Bind material
-                        if (transparent_pass && m_set_material_id != material->GetId())
+                    const uint64_t signature = ComputeShadowCacheSignature(m_draw_list_light_static, view_projection);
+                    if (!light->IsShadowCacheValid(array_index, signature))
+                    {
+                        static RHI_PipelineState pipeline_state_static;
+                        pipeline_state_static.shader_vertex                 = shader_v;
+                        pipeline_state_static.rasterizer_state              = pipeline_state.rasterizer_state;
+                        pipeline_state_static.blend_state                   = m_blend_disabled.get();
+                        pipeline_state_static.depth_stencil_state           = m_depth_stencil_enabled_disabled_write.get();
+                        pipeline_state_static.render_target_depth_texture   = tex_static;
+                        pipeline_state_static.viewport                      = tex_static->GetViewport();
+                        pipeline_state_static.primitive_topology            = RHI_PrimitiveTopology_TriangleList;
+                        pipeline_state_static.clear_depth                   = GetClearDepth();
+                        pipeline_state_static.pass_name                     = "Pass_LightShadowStatic";
+
+                        if (draw_list_record(m_draw_list_light_static, pipeline_state_static, viewport))
                         {
-                            // Bind material textures
-                            RHI_Texture* tex_albedo = material->GetTexture_Ptr(Texture_Albedo);
-                            cmd_list->SetTexture(28, tex_albedo ? tex_albedo : m_tex_white.get());
+                            light->SetShadowCacheSignature(array_index, signature);
+                        }
+                    }
 
-                            // Update uber buffer with material properties
-                            m_buffer_uber_cpu.mat_albedo    = material->GetColorAlbedo();
-                            m_buffer_uber_cpu.mat_tiling_uv = material->GetTiling();
-                            m_buffer_uber_cpu.mat_offset_uv = material->GetOffset();
+                    // Copy the cached depth into the slice
+                    static RHI_PipelineState pipeline_state_cache;
+                    pipeline_state_cache.shader_vertex                                      = shader_v_quad;
+                    pipeline_state_cache.shader_pixel                                       = shader_p_cache;
+                    pipeline_state_cache.rasterizer_state                                   = m_rasterizer_cull_back_solid.get();
+                    pipeline_state_cache.blend_state                                        = m_blend_disabled.get();
+                    pipeline_state_cache.depth_stencil_state                                = m_depth_stencil_enabled_disabled_write.get();
+                    pipeline_state_cache.vertex_buffer_stride                               = m_quad.GetVertexBuffer()->GetStride();
+                    pipeline_state_cache.render_target_depth_texture                        = tex_depth;
+                    pipeline_state_cache.render_target_depth_stencil_texture_array_index    = is_atlas ? 0 : array_index;
+                    pipeline_state_cache.viewport                                           = pipeline_state.viewport;
+                    pipeline_state_cache.primitive_topology                                 = RHI_PrimitiveTopology_TriangleList;
+                    pipeline_state_cache.clear_depth                                        = is_atlas ? state_dont_clear_depth : GetClearDepth();
+                    pipeline_state_cache.pass_name                                          = "Pass_LightShadowCache";
+
+                    if (cmd_list->Begin(pipeline_state_cache))
+                    {
+                        if (is_atlas)
+                        {
+                            cmd_list->SetViewport(viewport);
+                        }
 
-                            // Update constant buffer
-                            UpdateUberBuffer();
+                        cmd_list->SetTexture(28, tex_static);
+                        cmd_list->SetBufferVertex(m_quad.GetVertexBuffer());
+                        cmd_list->SetBufferIndex(m_quad.GetIndexBuffer());
+                        cmd_list->DrawIndexed(Rectangle::GetIndexCount());
+                        cmd_list->End();
+                        cmd_list->Submit();
+                    }
 
-                            m_set_material_id = material->GetId();
-                        }
+                    // Cull the dynamic casters in parallel
+                    m_draw_list_light.Build(m_threading, entities, [this, &cull](DrawCall& draw_call)
+                    {
+                        return !m_shadow_caster_static[draw_call.entity_index] && cull(draw_call);
+                    });
+                }
+                else
+                {
+                    // Cull in parallel
+                    m_draw_list_light.Build(m_threading, entities, cull);
+                }
 
-                        // Bind geometry
-                        cmd_list->SetBufferIndex(model->GetIndexBuffer());
-                        cmd_list->SetBufferVertex(model->GetVertexBuffer());
+                draw_list_record(m_draw_list_light, pipeline_state, viewport);
+            }
+        }
+	}
 
-                        // Update uber buffer with cascade transform
-                        m_buffer_object_cpu.object = entity->GetTransform()->GetMatrix() * view_projection;
-                        if (!UpdateObjectBuffer(cmd_list, array_index))
-                            continue;
+    void Renderer::UpdateShadowCasterMotion()
+    {
+        const auto& entities = m_entities[Renderer_Object_Opaque];
+        m_shadow_caster_static.resize(entities.size());
 
-                        cmd_list->DrawIndexed(renderable->GeometryIndexCount(), renderable->GeometryIndexOffset(), renderable->GeometryVertexOffset());
+        for (uint32_t i = 0; i < static_cast<uint32_t>(entities.size()); i++)
+        {
+            Entity* entity      = entities[i];
+            const Matrix& world = entity->GetTransform()->GetMatrixInterpolated();
 
-                    }
-                    cmd_list->End(); // end of array
-                    cmd_list->Submit();
-                }
+            // A frame of 0 means the caster never moved since it was acquired
+            auto it = m_shadow_caster_motion.find(entity->GetId());
+            if (it == m_shadow_caster_motion.end())
+            {
+                it = m_shadow_caster_motion.emplace(entity->GetId(), ShadowCasterMotion{ world, 0 }).first;
+            }
+            else if (it->second.world != world)
+            {
+                it->second.world        = world;
+                it->second.frame_moved  = Helper::Max<uint64_t>(m_frame_num, 1);
             }
+
+            const uint64_t frame_moved  = it->second.frame_moved;
+            m_shadow_caster_static[i]   = frame_moved == 0 || m_frame_num - frame_moved >= shadow_caster_static_frames;
         }
-	}
+    }
+
+    uint64_t Renderer::ComputeShadowCacheSignature(const DrawList& draw_list, const Matrix& view_projection) const
+    {
+        // The casters are summed, so that the signature doesn't depend on the order they were culled in
+        uint64_t casters = draw_list.GetDrawCalls().size();
+        for (const DrawCall& draw_call : draw_list.GetDrawCalls())
+        {
+            const uint64_t caster[] =
+            {
+                draw_call.entity->GetId(),
+                static_cast<uint64_t>(reinterpret_cast<uintptr_t>(draw_call.vertex_buffer)),
+                static_cast<uint64_t>(reinterpret_cast<uintptr_t>(draw_call.index_buffer)),
+                (static_cast<uint64_t>(draw_call.index_offset) << 32) | draw_call.index_count,
+                draw_call.vertex_offset
+            };
+            casters += Utility::Hash::hash_64(caster, sizeof(caster));
+        }
+
+        // 0 is what an empty cache has
+        const uint64_t signature = Utility::Hash::hash_64(&view_projection, sizeof(Matrix), casters);
+        return signature != 0 ? signature : 1;
+    }
 
     void Renderer::Pass_DepthPrePass(RHI_CommandList* cmd_list)
     {
@@ -300,50 +568,41 @@ namespace Spartan
         pipeline_state.primitive_topology           = RHI_PrimitiveTopology_TriangleList;
         pipeline_state.pass_name                    = "Pass_DepthPrePass";
 
+        // Cull in parallel
+        const Matrix& view_projection = m_buffer_frame_cpu.view_projection;
+        m_draw_list_depth.Build(m_threading, entities, [this, &view_projection](DrawCall& draw_call)
+        {
+            // Skip objects outside of the view frustum
+            if (!m_camera->IsInViewFrustrum(draw_call.aabb->GetCenter(), draw_call.aabb->GetExtents()))
+                return false;
+
+            if (draw_call.transform)
+            {
+                draw_call.wvp = draw_call.transform->GetMatrixInterpolated() * view_projection;
+            }
+
+            return true;
+        });
+
         // Submit commands
         if (cmd_list->Begin(pipeline_state))
         { 
-            if (!entities.empty())
+            // Draw opaque
+            for (const DrawCall& draw_call : m_draw_list_depth.GetDrawCalls())
             {
-                // Variables that help reduce state changes
-                uint32_t currently_bound_geometry = 0;
+                // Bind geometry (will only happen if not already set)
+                cmd_list->SetBufferIndex(draw_call.index_buffer);
+                cmd_list->SetBufferVertex(draw_call.vertex_buffer);
 
-                // Draw opaque
-                for (const auto& entity : entities)
+                // Update uber buffer with entity transform
+                if (draw_call.transform)
                 {
-                    // Get renderable
-                    const auto& renderable = entity->GetRenderable();
-                    if (!renderable)
-                        continue;
-
-                    // Get geometry
-                    const auto& model = renderable->GeometryModel();
-                    if (!model || !model->GetVertexBuffer() || !model->GetIndexBuffer())
-                        continue;
-
-                    // Skip objects outside of the view frustum
-                    if (!m_camera->IsInViewFrustrum(renderable))
-                        continue;
-
-                    // Bind geometry
-                    if (currently_bound_geometry != model->GetId())
-                    {
-                        cmd_list->SetBufferIndex(model->GetIndexBuffer());
-                        cmd_list->SetBufferVertex(model->GetVertexBuffer());
-                        currently_bound_geometry = model->GetId();
-                    }
-
-                    // Update uber buffer with entity transform
-                    if (Transform* transform = entity->GetTransform())
-                    {
-                        // Update uber buffer with cascade transform
-                        m_buffer_uber_cpu.transform = transform->GetMatrix() * m_buffer_frame_cpu.view_projection;
-                        UpdateUberBuffer(); // only updates if needed
-                    }
-
-                    // Draw	
-                    cmd_list->DrawIndexed(renderable->GeometryIndexCount(), renderable->GeometryIndexOffset(), renderable->GeometryVertexOffset());
+                    m_buffer_uber_cpu.transform = draw_call.wvp;
+                    UpdateUberBuffer(); // only updates if needed
                 }
+
+                // Draw	
+                cmd_list->DrawIndexed(draw_call.index_count, draw_call.index_offset, draw_call.vertex_offset);
             }
             cmd_list->End();
             cmd_list->Submit();
@@ -364,6 +623,10 @@ namespace Spartan
         if (!shader_v->IsCompiled())
             return;
 
+        // Identical draws are instanced, once the instanced variation has compiled
+        RHI_Shader* shader_v_instanced  = m_shaders[Shader_Gbuffer_Instanced_V].get();
+        const uint32_t batch_size_max   = shader_v_instanced->IsCompiled() ? instance_batch_size : 1;
+
         // Clear values that depend on the objects being opaque or transparent
         const bool is_transparent = object_type == Renderer_Object_Transparent;
 
@@ -391,13 +654,63 @@ namespace Spartan
         // Clear
         cmd_list->Clear(pso);
 
-        // Only useful to minimize D3D11 state changes (Vulkan backend is smarter)
-        uint32_t m_set_material_id = 0;
-        
+        // Cull in parallel, once for all the shader variations
+        const Matrix& view_projection = m_buffer_frame_cpu.view_projection;
+        m_draw_list_gbuffer.Build(m_threading, m_entities[object_type], [this, is_transparent, &view_projection](DrawCall& draw_call)
+        {
+            Renderable* renderable = draw_call.renderable;
+
+            // Get material
+            draw_call.material = renderable->GetMaterial().get();
+            if (!draw_call.material)
+                return false;
+
+            // Skip transparent objects that won't contribute
+            if (draw_call.material->GetColorAlbedo().w == 0 && is_transparent)
+                return false;
+
+            // Get shader (the material's variation, or a fallback while it compiles)
+            if (!draw_call.material->GetShader())
+                return false;
+
+            // Skip objects outside of the view frustum
+            if (!m_camera->IsInViewFrustrum(draw_call.aabb->GetCenter(), draw_call.aabb->GetExtents()))
+                return false;
+
+            if (draw_call.transform)
+            {
+                draw_call.world = draw_call.transform->GetMatrixInterpolated();
+                draw_call.wvp   = draw_call.world * view_projection;
+            }
+
+            return true;
+        });
+
+        // Give every material a slot in the material table, draws index it instead of rebinding material properties
+        UpdateMaterialBuffer(m_draw_list_gbuffer);
+
+        // Group identical draws and stream the transforms of all of them, once for all the shader variations
+        m_draw_list_gbuffer.Batch(batch_size_max);
+        StreamDrawList(m_draw_list_gbuffer, [](const DrawCall& draw_call, BufferObject& buffer)
+        {
+            if (Transform* transform = draw_call.transform)
+            {
+                buffer.object       = draw_call.world;
+                buffer.wvp_current  = draw_call.wvp;
+                buffer.wvp_previous = transform->GetWvpLastFrame();
+
+                // Save matrix for velocity computation
+                transform->SetWvpLastFrame(draw_call.wvp);
+            }
+        });
+
         // Iterate through all the G-Buffer shader variations
+        const vector<DrawCall>& draw_calls  = m_draw_list_gbuffer.GetDrawCalls();
+        const vector<DrawBatch>& batches    = m_draw_list_gbuffer.GetBatches();
+        vector<uint32_t> batches_to_draw;
         for (const shared_ptr<ShaderVariation>& resource : ShaderVariation::GetVariations())
         {
-            if (!resource->IsCompiled())
+            if (!resource || !resource->IsCompiled())
                 continue;
 
             // Set pixel shader
@@ -406,100 +719,96 @@ namespace Spartan
             // Set pass name
             pso.pass_name = pso.shader_pixel->GetName().c_str();
 
-            auto& entities = m_entities[object_type];
-
-            // Submit command list
-            if (cmd_list->Begin(pso))
+            // Single draws first, then the instanced ones
+            for (RHI_Shader* shader : { shader_v, shader_v_instanced })
             {
-                for (uint32_t i = 0; i < static_cast<uint32_t>(entities.size()); i++)
+                const bool is_instanced = shader == shader_v_instanced;
+                if (is_instanced && !m_draw_list_gbuffer.HasInstances())
+                    continue;
+
+                pso.shader_vertex = shader;
+
+                // Gather the batches of this variation, so that they can be split into chunks of equal size
+                batches_to_draw.clear();
+                for (uint32_t i = 0; i < static_cast<uint32_t>(batches.size()); i++)
                 {
-                    Entity* entity = entities[i];
+                    const DrawBatch& batch      = batches[i];
+                    const DrawCall& draw_call   = draw_calls[batch.first];
 
-                    // Get renderable
-                    const auto& renderable = entity->GetRenderable();
-                    if (!renderable)
+                    if ((batch.count > 1) != is_instanced)
                         continue;
 
-                    // Get material
-                    Material* material = renderable->GetMaterial().get();
-                    if (!material)
+                    // Draw matching shader entities
+                    if (pso.shader_pixel->GetId() != draw_call.material->GetShader()->GetId())
                         continue;
 
-                    // Skip transparent objects that won't contribute
-                    if (material->GetColorAlbedo().w == 0 && is_transparent)
+                    // Skip draws whose material didn't fit in the material table
+                    if (draw_call.material_index >= material_table_size)
                         continue;
 
-                    // Get shader
-                    const auto& shader = material->GetShader();
-                    if (!shader || !shader->IsCompiled())
-                        continue;
+                    batches_to_draw.emplace_back(i);
+                    m_profiler->m_renderer_meshes_rendered += batch.count;
+                }
 
-                    // Get geometry
-                    const auto& model = renderable->GeometryModel();
-                    if (!model || !model->GetVertexBuffer() || !model->GetIndexBuffer())
-                        continue;
+                if (batches_to_draw.empty())
+                    continue;
 
-                    // Draw matching shader entities
-                    if (pso.shader_pixel->GetId() == shader->GetId())
-                    {
-                        // Skip objects outside of the view frustum
-                        if (!m_camera->IsInViewFrustrum(renderable))
-                            continue;
+                // Submit command list
+                if (cmd_list->Begin(pso))
+                {
+                    // Without bindless textures, the material's textures are bound per material
+                    const bool bind_textures = !m_rhi_device->GetContextRhi()->bindless_textures;
 
-                        // Set geometry (will only happen if not already set)
-                        cmd_list->SetBufferIndex(model->GetIndexBuffer());
-                        cmd_list->SetBufferVertex(model->GetVertexBuffer());
+                    // Large variations are recorded by several threads, each chunk into its own secondary command list
+                    RecordChunked(cmd_list, static_cast<uint32_t>(batches_to_draw.size()), [this, &draw_calls, &batches, &batches_to_draw, is_instanced, bind_textures](RHI_CommandList* cmd_list, uint32_t start, uint32_t end)
+                    {
+                        uint32_t m_set_material_id = 0;
 
-                        // Bind material
-                        if (m_set_material_id != material->GetId())
+                        for (uint32_t i = start; i < end; i++)
                         {
-                            // Bind material textures		
-                            cmd_list->SetTexture(0, material->GetTexture_Ptr(Texture_Albedo));
-                            cmd_list->SetTexture(1, material->GetTexture_Ptr(Texture_Roughness));
-                            cmd_list->SetTexture(2, material->GetTexture_Ptr(Texture_Metallic));
-                            cmd_list->SetTexture(3, material->GetTexture_Ptr(Texture_Normal));
-                            cmd_list->SetTexture(4, material->GetTexture_Ptr(Texture_Height));
-                            cmd_list->SetTexture(5, material->GetTexture_Ptr(Texture_Occlusion));
-                            cmd_list->SetTexture(6, material->GetTexture_Ptr(Texture_Emission));
-                            cmd_list->SetTexture(7, material->GetTexture_Ptr(Texture_Mask));
-                        
-                            // Update uber buffer with material properties
-                            m_buffer_uber_cpu.mat_albedo        = material->GetColorAlbedo();
-                            m_buffer_uber_cpu.mat_tiling_uv     = material->GetTiling();
-                            m_buffer_uber_cpu.mat_offset_uv     = material->GetOffset();
-                            m_buffer_uber_cpu.mat_roughness_mul = material->GetMultiplier(Texture_Roughness);
-                            m_buffer_uber_cpu.mat_metallic_mul  = material->GetMultiplier(Texture_Metallic);
-                            m_buffer_uber_cpu.mat_normal_mul    = material->GetMultiplier(Texture_Normal);
-                            m_buffer_uber_cpu.mat_height_mul    = material->GetMultiplier(Texture_Height);
+                            const DrawBatch& batch      = batches[batches_to_draw[i]];
+                            const DrawCall& draw_call   = draw_calls[batch.first];
+                            Material* material          = draw_call.material;
 
-                            // Update constant buffer
-                            UpdateUberBuffer();
+                            // Set geometry (will only happen if not already set)
+                            cmd_list->SetBufferIndex(draw_call.index_buffer);
+                            cmd_list->SetBufferVertex(draw_call.vertex_buffer);
 
-                            m_set_material_id = material->GetId();
-                        }
-                        
-                        // Update uber buffer with entity transform
-                        if (Transform* transform = entity->GetTransform())
-                        {
-                            m_buffer_object_cpu.object          = transform->GetMatrix();
-                            m_buffer_object_cpu.wvp_current     = transform->GetMatrix() * m_buffer_frame_cpu.view_projection;
-                            m_buffer_object_cpu.wvp_previous    = transform->GetWvpLastFrame();
+                            // Bind material textures
+                            if (bind_textures && m_set_material_id != material->GetId())
+                            {
+                                cmd_list->SetTexture(0, material->GetTexture_Ptr(Texture_Albedo));
+                                cmd_list->SetTexture(1, material->GetTexture_Ptr(Texture_Roughness));
+                                cmd_list->SetTexture(2, material->GetTexture_Ptr(Texture_Metallic));
+                                cmd_list->SetTexture(3, material->GetTexture_Ptr(Texture_Normal));
+                                cmd_list->SetTexture(4, material->GetTexture_Ptr(Texture_Height));
+                                cmd_list->SetTexture(5, material->GetTexture_Ptr(Texture_Occlusion));
+                                cmd_list->SetTexture(6, material->GetTexture_Ptr(Texture_Emission));
+                                cmd_list->SetTexture(7, material->GetTexture_Ptr(Texture_Mask));
+
+                                m_set_material_id = material->GetId();
+                            }
 
-                            // Save matrix for velocity computation
-                            transform->SetWvpLastFrame(m_buffer_object_cpu.wvp_current);
+                            // Bind entity transforms and render
+                            if (is_instanced)
+                            {
+                                if (!BindInstanceBuffer(cmd_list, batch.instance_index))
+                                    continue;
 
-                            // Update object buffer
-                            if (!UpdateObjectBuffer(cmd_list, i))
-                                continue;
+                                cmd_list->DrawIndexedInstanced(draw_call.index_count, batch.count, draw_call.index_offset, draw_call.vertex_offset);
+                            }
+                            else
+                            {
+                                if (draw_call.transform && !BindObjectBuffer(cmd_list, draw_call.object_index))
+                                    continue;
+
+                                cmd_list->DrawIndexed(draw_call.index_count, draw_call.index_offset, draw_call.vertex_offset);
+                            }
                         }
-                        
-                        // Render	
-                        cmd_list->DrawIndexed(renderable->GeometryIndexCount(), renderable->GeometryIndexOffset(), renderable->GeometryVertexOffset());
-                        m_profiler->m_renderer_meshes_rendered++;
-                    }
+                    });
+                    cmd_list->End();
+                    cmd_list->Submit();
                 }
-                cmd_list->End();
-                cmd_list->Submit();
             }
         }
 	}
@@ -683,7 +992,12 @@ namespace Spartan
         pipeline_state.primitive_topology                       = RHI_PrimitiveTopology_TriangleList;
         pipeline_state.pass_name                                = "Pass_Light";
 
-        auto draw_lights = [this, &cmd_list, &shader_p_directional, &shader_p_point, &shader_p_spot](Renderer_Object_Type type)
+        // Unshadowed point and spot lights are shaded by the clustered pass, once its shader is ready (until then, and
+        // for lights that didn't fit in the light grid, they get their own passes like the lights with shadow maps)
+        const auto& shader_p_clustered  = m_shaders[Shader_LightClustered_P];
+        const bool draw_clustered       = m_light_grid->GetClusteredCount() != 0 && shader_p_clustered->IsCompiled();
+
+        auto draw_lights = [this, &cmd_list, &shader_p_directional, &shader_p_point, &shader_p_spot, draw_clustered](Renderer_Object_Type type)
         {
             const vector<Entity*>& entities = m_entities[type];
             if (entities.empty())
@@ -715,29 +1029,25 @@ namespace Spartan
                 {
                     if (Light* light = entity->GetComponent<Light>())
                     {
+                        // Unshadowed point and spot lights (and those which didn't fit in the shadow atlas) are shaded by the clustered pass
+                        if (draw_clustered && light->GetLightType() != LightType_Directional && !light->HasShadowMap() && m_light_grid_overflow.find(light) == m_light_grid_overflow.end())
+                            continue;
+
                         // Update light buffer
                         UpdateLightBuffer(light);
 
                         // Set shadow map
-                        if (light->GetShadowsEnabled())
+                        if (light->HasShadowMap())
                         {
-                            RHI_Texture* tex_depth = light->GetDepthTexture();
-                            RHI_Texture* tex_color = light->GetShadowsTransparentEnabled() ? light->GetColorTexture() : m_tex_white.get();
-
                             if (light->GetLightType() == LightType_Directional)
                             {
-                                cmd_list->SetTexture(13, tex_depth);
-                                cmd_list->SetTexture(14, tex_color);
+                                cmd_list->SetTexture(13, light->GetDepthTexture());
+                                cmd_list->SetTexture(14, light->GetShadowsTransparentEnabled() ? light->GetColorTexture() : m_tex_white.get());
                             }
-                            else if (light->GetLightType() == LightType_Point)
+                            else
                             {
-                                cmd_list->SetTexture(15, tex_depth);
-                                cmd_list->SetTexture(16, tex_color);
-                            }
-                            else if (light->GetLightType() == LightType_Spot)
-                            {
-                                cmd_list->SetTexture(17, tex_depth);
-                                cmd_list->SetTexture(18, tex_color);
+                                cmd_list->SetTexture(15, m_shadow_atlas_depth);
+                                cmd_list->SetTexture(16, light->GetShadowsTransparentEnabled() ? m_shadow_atlas_color : m_tex_white);
                             }
                         }
 
@@ -755,6 +1065,29 @@ namespace Spartan
         draw_lights(Renderer_Object_LightDirectional);
         draw_lights(Renderer_Object_LightPoint);
         draw_lights(Renderer_Object_LightSpot);
+
+        // Draw the unshadowed point and spot lights, all of them in a single pass
+        if (draw_clustered)
+        {
+            pipeline_state.shader_pixel = shader_p_clustered.get();
+
+            if (cmd_list->Begin(pipeline_state))
+            {
+                cmd_list->SetBufferVertex(m_quad.GetVertexBuffer());
+                cmd_list->SetBufferIndex(m_quad.GetIndexBuffer());
+                cmd_list->SetConstantBuffer(5, RHI_Shader_Pixel, m_buffer_light_grid_lights_gpu);
+                cmd_list->SetConstantBuffer(6, RHI_Shader_Pixel, m_buffer_light_grid_clusters_gpu);
+                cmd_list->SetConstantBuffer(7, RHI_Shader_Pixel, m_buffer_light_grid_indices_gpu);
+                cmd_list->SetTexture(8, m_render_targets[RenderTarget_Gbuffer_Albedo]);
+                cmd_list->SetTexture(9, m_render_targets[RenderTarget_Gbuffer_Normal]);
+                cmd_list->SetTexture(10, m_render_targets[RenderTarget_Gbuffer_Material]);
+                cmd_list->SetTexture(12, m_render_targets[RenderTarget_Gbuffer_Depth]);
+                cmd_list->SetTexture(22, (m_options & Render_ScreenSpaceAmbientOcclusion) ? m_render_targets[RenderTarget_Ssao] : m_tex_white);
+                cmd_list->DrawIndexed(Rectangle::GetIndexCount());
+                cmd_list->End();
+                cmd_list->Submit();
+            }
+        }
     }
 
 	void Renderer::Pass_Composition(RHI_CommandList* cmd_list, shared_ptr<RHI_Texture>& tex_out, const bool use_stencil)
@@ -1710,8 +2043,8 @@ namespace Spartan
 
                     if (light->GetLightType() == LightType_Spot)
                     {
-                        Vector3 start = light->GetTransform()->GetPosition();
-                        Vector3 end = light->GetTransform()->GetForward() * light->GetRange();
+                        Vector3 start = light->GetTransform()->GetPositionInterpolated();
+                        Vector3 end = light->GetTransform()->GetForwardInterpolated() * light->GetRange();
                         DrawLine(start, start + end, Vector4(0, 1, 0, 1));
                     }
                 }
@@ -1887,10 +2220,10 @@ namespace Spartan
                 // Light can be null if it just got removed and our buffer doesn't update till the next frame
                 if (Light* light = entity->GetComponent<Light>())
                 {
-                    auto position_light_world       = entity->GetTransform()->GetPosition();
-                    auto position_camera_world      = m_camera->GetTransform()->GetPosition();
+                    auto position_light_world       = entity->GetTransform()->GetPositionInterpolated();
+                    auto position_camera_world      = m_camera->GetTransform()->GetPositionInterpolated();
                     auto direction_camera_to_light  = (position_light_world - position_camera_world).Normalized();
-                    const auto v_dot_l                    = Vector3::Dot(m_camera->GetTransform()->GetForward(), direction_camera_to_light);
+                    const auto v_dot_l                    = Vector3::Dot(m_camera->GetTransform()->GetForwardInterpolated(), direction_camera_to_light);
         
                     // Only draw if it's inside our view
                     if (v_dot_l > 0.5f)
@@ -2084,7 +2417,7 @@ namespace Spartan
                  // Update uber buffer with entity transform
                 if (Transform* transform = entity->GetTransform())
                 {
-                    m_buffer_uber_cpu.transform     = transform->GetMatrix();
+                    m_buffer_uber_cpu.transform     = transform->GetMatrixInterpolated();
                     m_buffer_uber_cpu.resolution    = Vector2(tex_out->GetWidth(), tex_out->GetHeight());
                     UpdateUberBuffer();
                 }
@@ -2102,12 +2435,21 @@ namespace Spartan
 
 	void Renderer::Pass_Text(RHI_CommandList* cmd_list, RHI_Texture* tex_out)
 	{
+        // Performance metrics, along with any strings that were drawn this frame
+        const bool draw_metrics = (m_options & Render_Debug_PerformanceMetrics) && !m_profiler->GetMetrics().empty();
+        if (draw_metrics)
+        {
+            const auto text_pos = Vector2(-m_viewport.width * 0.5f + 5.0f, m_viewport.height * 0.5f - m_font->GetSize() - 2.0f);
+            m_font->AddText(m_profiler->GetMetrics(), text_pos);
+        }
+
+        // All the text goes into a single vertex buffer (the queue is emptied at the end of the frame)
+        m_font->UpdateVertexBuffer();
+
         // Early exit cases
-        const bool draw         = m_options & Render_Debug_PerformanceMetrics;
-        const bool empty        = m_profiler->GetMetrics().empty();
         const auto& shader_v    = m_shaders[Shader_Font_V];
         const auto& shader_p    = m_shaders[Shader_Font_P];
-        if (!draw || empty || !shader_v->IsCompiled() || !shader_p->IsCompiled())
+        if (m_font->GetIndexCount() == 0 || !shader_v->IsCompiled() || !shader_p->IsCompiled())
             return;
 
         // Set render state
@@ -2123,10 +2465,6 @@ namespace Spartan
         pipeline_state.viewport                         = tex_out->GetViewport();
         pipeline_state.pass_name                        = "Pass_Text";
 
-        // Update text
-        const auto text_pos = Vector2(-m_viewport.width * 0.5f + 5.0f, m_viewport.height * 0.5f - m_font->GetSize() - 2.0f);
-        m_font->SetText(m_profiler->GetMetrics(), text_pos);
-
         // Draw outline
         if (m_font->GetOutline() != Font_Outline_None && m_font->GetOutlineSize() != 0)
         { 
@@ -2221,13 +2559,13 @@ namespace Spartan
 
         if (m_debug_buffer == Renderer_Buffer_SSR)
         {
-            texture     = m_render_targets[RenderTarget_Ssr];
+            texture     = m_options & Render_ScreenSpaceReflections ? m_render_targets[RenderTarget_Ssr] : m_tex_black;
             shader_type = Shader_DebugChannelRgbGammaCorrect_P;
         }
 
         if (m_debug_buffer == Renderer_Buffer_Bloom)
         {
-            texture     = m_render_tex_bloom.front();
+            texture     = m_options & Render_Bloom ? m_render_tex_bloom.front() : m_tex_black;
             shader_type = Shader_DebugChannelRgbGammaCorrect_P;
         }
 
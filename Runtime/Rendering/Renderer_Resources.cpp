@@ -30,6 +30,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI/RHI_ConstantBuffer.h"
 #include "../RHI/RHI_RasterizerState.h"
 #include "../RHI/RHI_DepthStencilState.h"
+#include "../RHI/RHI_PipelineCache.h"
+#include "../RHI/RHI_SwapChain.h"
+#include "ShaderVariation.h"
+#include "RenderGraph.h"
+#include "../Profiling/Profiler.h"
 //=======================================
 
 //= NAMESPACES ===============
@@ -39,6 +44,11 @@ using namespace Spartan::Math;
 
 namespace Spartan
 {
+    static const uint32_t object_buffer_elements_per_frame     = 256;  // grows to the next power of two when a frame doesn't fit
+    static const uint32_t instance_buffer_elements_per_frame   = 16;   // batches of instance_batch_size instances, grows the same way
+    static const float shader_reload_interval_sec               = 1.0f; // how often shader sources are checked for modifications
+    static const uint64_t shader_release_frames                 = 3;    // replaced shaders (and their pipelines) outlive the frames which might still draw with them
+
     void Renderer::CreateConstantBuffers()
     {
         m_buffer_frame_gpu = make_shared<RHI_ConstantBuffer>(m_rhi_device);
@@ -50,9 +60,26 @@ namespace Spartan
         bool is_dynamic = true;
         m_buffer_object_gpu = make_shared<RHI_ConstantBuffer>(m_rhi_device, is_dynamic);
         m_buffer_object_gpu->Create<BufferObject>();
+        CreateObjectBuffer(object_buffer_elements_per_frame);
+
+        m_buffer_instances_gpu = make_shared<RHI_ConstantBuffer>(m_rhi_device, is_dynamic);
+        m_buffer_instances_gpu->Create<BufferInstances>();
+        CreateInstanceBuffer(instance_buffer_elements_per_frame);
 
         m_buffer_light_gpu = make_shared<RHI_ConstantBuffer>(m_rhi_device);
         m_buffer_light_gpu->Create<BufferLight>();
+
+        m_buffer_materials_gpu = make_shared<RHI_ConstantBuffer>(m_rhi_device);
+        m_buffer_materials_gpu->Create<BufferMaterials>();
+
+        m_buffer_light_grid_lights_gpu = make_shared<RHI_ConstantBuffer>(m_rhi_device);
+        m_buffer_light_grid_lights_gpu->Create<BufferLightGridLights>();
+
+        m_buffer_light_grid_clusters_gpu = make_shared<RHI_ConstantBuffer>(m_rhi_device);
+        m_buffer_light_grid_clusters_gpu->Create<BufferLightGridClusters>();
+
+        m_buffer_light_grid_indices_gpu = make_shared<RHI_ConstantBuffer>(m_rhi_device);
+        m_buffer_light_grid_indices_gpu->Create<BufferLightGridIndices>();
     }
 
     void Renderer::CreateDepthStencilStates()
@@ -118,11 +145,6 @@ namespace Spartan
         m_render_targets[RenderTarget_Gbuffer_Velocity] = make_shared<RHI_Texture2D>(m_context, width, height, RHI_Format_R16G16_Float);
         m_render_targets[RenderTarget_Gbuffer_Depth]    = make_shared<RHI_Texture2D>(m_context, width, height, RHI_Format_D32_Float_S8X24_Uint, 1, RHI_Texture_DepthStencilViewReadOnly);
 
-        // Light
-        m_render_targets[RenderTarget_Light_Diffuse]    = make_unique<RHI_Texture2D>(m_context, width, height, RHI_Format_R11G11B10_Float);
-        m_render_targets[RenderTarget_Light_Specular]   = make_unique<RHI_Texture2D>(m_context, width, height, RHI_Format_R11G11B10_Float);
-        m_render_targets[RenderTarget_Light_Volumetric] = make_unique<RHI_Texture2D>(m_context, width, height, RHI_Format_R11G11B10_Float);
-
         // BRDF Specular Lut
         m_render_targets[RenderTarget_Brdf_Specular_Lut] = make_unique<RHI_Texture2D>(m_context, 400, 400, RHI_Format_R8G8_Unorm);
         m_brdf_specular_lut_rendered = false;
@@ -138,29 +160,46 @@ namespace Spartan
             m_render_targets[RenderTarget_TaaHistory] = make_unique<RHI_Texture2D>(m_context, width, height, m_render_targets[RenderTarget_Composition_Hdr]->GetFormat()); // Used for TAA accumulation
         }
 
-        // SSAO
-        m_render_targets[RenderTarget_Ssao_Noisy]   = make_unique<RHI_Texture2D>(m_context, static_cast<uint32_t>(width), static_cast<uint32_t>(height), RHI_Format_R8_Unorm);
-        m_render_targets[RenderTarget_Ssao]         = make_unique<RHI_Texture2D>(m_context, static_cast<uint32_t>(width), static_cast<uint32_t>(height), RHI_Format_R8_Unorm);
+        // Transient render targets, the render graph allocates them when a pass uses them and shares them between passes which don't overlap
+        {
+            m_render_graph->Clear();
+
+            // Light
+            m_render_graph->DeclareTexture(RenderTarget_Light_Diffuse,      { width, height, RHI_Format_R11G11B10_Float });
+            m_render_graph->DeclareTexture(RenderTarget_Light_Specular,     { width, height, RHI_Format_R11G11B10_Float });
+            m_render_graph->DeclareTexture(RenderTarget_Light_Volumetric,   { width, height, RHI_Format_R11G11B10_Float });
+
+            // SSAO
+            m_render_graph->DeclareTexture(RenderTarget_Ssao_Noisy, { width, height, RHI_Format_R8_Unorm });
+            m_render_graph->DeclareTexture(RenderTarget_Ssao,       { width, height, RHI_Format_R8_Unorm });
+
+            // SSR
+            m_render_graph->DeclareTexture(RenderTarget_Ssr, { width, height, RHI_Format_R16G16_Float, RHI_Texture_UnorderedAccessView });
+
+            // Bloom
+            // Declare as many bloom textures as required to scale down to or below 16px (in any dimension)
+            uint32_t bloom_count    = 0;
+            uint32_t bloom_width    = width / 2;
+            uint32_t bloom_height   = height / 2;
+            while (true)
+            {
+                m_render_graph->DeclareTexture(RenderTarget_Bloom + bloom_count++, { bloom_width, bloom_height, RHI_Format_R11G11B10_Float });
+                if (bloom_width <= 16 || bloom_height <= 16)
+                    break;
 
-        // SSR
-        m_render_targets[RenderTarget_Ssr] = make_shared<RHI_Texture2D>(m_context, width, height, RHI_Format_R16G16_Float, 1, RHI_Texture_UnorderedAccessView);
+                bloom_width     /= 2;
+                bloom_height    /= 2;
+            }
 
-        // Bloom
-        {
-            // Create as many bloom textures as required to scale down to or below 16px (in any dimension)
-            m_render_tex_bloom.clear();
-            m_render_tex_bloom.emplace_back(make_unique<RHI_Texture2D>(m_context, width / 2, height / 2, RHI_Format_R11G11B10_Float));
-            while (m_render_tex_bloom.back()->GetWidth() > 16 && m_render_tex_bloom.back()->GetHeight() > 16)
+            // Until a frame assigns them, the transient render targets are null
+            for (const uint32_t id : m_render_graph->GetDeclaredIds())
             {
-                m_render_tex_bloom.emplace_back(
-                    make_unique<RHI_Texture2D>(
-                        m_context,
-                        m_render_tex_bloom.back()->GetWidth() / 2,
-                        m_render_tex_bloom.back()->GetHeight() / 2,
-                        RHI_Format_R11G11B10_Float
-                        )
-                );
+                if (id < RenderTarget_Bloom)
+                {
+                    m_render_targets.erase(static_cast<Renderer_RenderTarget_Type>(id));
+                }
             }
+            m_render_tex_bloom.assign(bloom_count, nullptr);
         }
     }
 
@@ -176,12 +215,25 @@ namespace Spartan
         // Depth Vertex
         m_shaders[Shader_Depth_V] = make_shared<RHI_Shader>(m_rhi_device);
         m_shaders[Shader_Depth_V]->CompileAsync<RHI_Vertex_PosTex>(m_context, RHI_Shader_Vertex, dir_shaders + "Depth.hlsl");
+        m_shaders[Shader_Depth_Instanced_V] = make_shared<RHI_Shader>(m_rhi_device);
+        m_shaders[Shader_Depth_Instanced_V]->AddDefine("INSTANCED");
+        m_shaders[Shader_Depth_Instanced_V]->AddDefine("INSTANCE_BATCH_SIZE", to_string(instance_batch_size));
+        m_shaders[Shader_Depth_Instanced_V]->CompileAsync<RHI_Vertex_PosTex>(m_context, RHI_Shader_Vertex, dir_shaders + "Depth.hlsl");
         m_shaders[Shader_Depth_P] = make_shared<RHI_Shader>(m_rhi_device);
         m_shaders[Shader_Depth_P]->CompileAsync(m_context, RHI_Shader_Pixel, dir_shaders + "Depth.hlsl");
+        m_shaders[Shader_Depth_Cache_P] = make_shared<RHI_Shader>(m_rhi_device);
+        m_shaders[Shader_Depth_Cache_P]->AddDefine("PASS_CACHE");
+        m_shaders[Shader_Depth_Cache_P]->CompileAsync(m_context, RHI_Shader_Pixel, dir_shaders + "Depth.hlsl");
 
         // G-Buffer
         m_shaders[Shader_Gbuffer_V] = make_shared<RHI_Shader>(m_rhi_device);
+        m_shaders[Shader_Gbuffer_V]->AddDefine("MATERIAL_TABLE_SIZE", to_string(material_table_size));
         m_shaders[Shader_Gbuffer_V]->CompileAsync<RHI_Vertex_PosTexNorTan>(m_context, RHI_Shader_Vertex, dir_shaders + "GBuffer.hlsl");
+        m_shaders[Shader_Gbuffer_Instanced_V] = make_shared<RHI_Shader>(m_rhi_device);
+        m_shaders[Shader_Gbuffer_Instanced_V]->AddDefine("INSTANCED");
+        m_shaders[Shader_Gbuffer_Instanced_V]->AddDefine("INSTANCE_BATCH_SIZE", to_string(instance_batch_size));
+        m_shaders[Shader_Gbuffer_Instanced_V]->AddDefine("MATERIAL_TABLE_SIZE", to_string(material_table_size));
+        m_shaders[Shader_Gbuffer_Instanced_V]->CompileAsync<RHI_Vertex_PosTexNorTan>(m_context, RHI_Shader_Vertex, dir_shaders + "GBuffer.hlsl");
 
         // BRDF - Specular Lut
         m_shaders[Shader_BrdfSpecularLut] = make_shared<RHI_Shader>(m_rhi_device);
@@ -203,6 +255,16 @@ namespace Spartan
         m_shaders[Shader_LightSpot_P]->AddDefine("SPOT");
         m_shaders[Shader_LightSpot_P]->CompileAsync(m_context, RHI_Shader_Pixel, dir_shaders + "Light.hlsl");
 
+        // Light - Clustered (unshadowed point and spot lights)
+        m_shaders[Shader_LightClustered_P] = make_shared<RHI_Shader>(m_rhi_device);
+        m_shaders[Shader_LightClustered_P]->AddDefine("CLUSTERED");
+        m_shaders[Shader_LightClustered_P]->AddDefine("LIGHT_GRID_X",       to_string(light_grid_x));
+        m_shaders[Shader_LightClustered_P]->AddDefine("LIGHT_GRID_Y",       to_string(light_grid_y));
+        m_shaders[Shader_LightClustered_P]->AddDefine("LIGHT_GRID_Z",       to_string(light_grid_z));
+        m_shaders[Shader_LightClustered_P]->AddDefine("LIGHT_GRID_LIGHTS",  to_string(light_grid_lights));
+        m_shaders[Shader_LightClustered_P]->AddDefine("LIGHT_GRID_INDICES", to_string(light_grid_indices));
+        m_shaders[Shader_LightClustered_P]->CompileAsync(m_context, RHI_Shader_Pixel, dir_shaders + "Light.hlsl");
+
         // Texture
         m_shaders[Shader_Texture_P] = make_shared<RHI_Shader>(m_rhi_device);
         m_shaders[Shader_Texture_P]->AddDefine("PASS_TEXTURE");
@@ -397,4 +459,193 @@ namespace Spartan
         m_gizmo_tex_light_spot = make_shared<RHI_Texture2D>(m_context, generate_mipmaps);
         m_gizmo_tex_light_spot->LoadFromFile(dir_texture + "flashlight.png");
     }
+
+    void Renderer::RegisterPipelineObjects()
+    {
+        if (!m_pipeline_cache)
+            return;
+
+        // Names have to be stable across runs, they are what the pipeline cache saves
+        m_pipeline_cache->RegisterObject(m_swap_chain.get(), "swap_chain");
+
+        for (const auto& it : m_shaders)
+        {
+            m_pipeline_cache->RegisterObject(it.second.get(), "shader_" + to_string(it.first));
+        }
+
+        // Transient render targets are null until the render graph assigns them, they are registered then
+        for (const auto& it : m_render_targets)
+        {
+            if (it.second)
+            {
+                m_pipeline_cache->RegisterObject(it.second.get(), "render_target_" + to_string(it.first));
+            }
+        }
+
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_render_tex_bloom.size()); i++)
+        {
+            if (m_render_tex_bloom[i])
+            {
+                m_pipeline_cache->RegisterObject(m_render_tex_bloom[i].get(), "render_target_bloom_" + to_string(i));
+            }
+        }
+
+        m_pipeline_cache->RegisterObject(m_depth_stencil_disabled.get(),                "depth_stencil_disabled");
+        m_pipeline_cache->RegisterObject(m_depth_stencil_disabled_enabled_read.get(),   "depth_stencil_disabled_enabled_read");
+        m_pipeline_cache->RegisterObject(m_depth_stencil_enabled_disabled_write.get(),  "depth_stencil_enabled_disabled_write");
+        m_pipeline_cache->RegisterObject(m_depth_stencil_enabled_disabled_read.get(),   "depth_stencil_enabled_disabled_read");
+        m_pipeline_cache->RegisterObject(m_depth_stencil_enabled_enabled_write.get(),   "depth_stencil_enabled_enabled_write");
+
+        m_pipeline_cache->RegisterObject(m_blend_disabled.get(),    "blend_disabled");
+        m_pipeline_cache->RegisterObject(m_blend_alpha.get(),       "blend_alpha");
+        m_pipeline_cache->RegisterObject(m_blend_additive.get(),    "blend_additive");
+
+        m_pipeline_cache->RegisterObject(m_rasterizer_cull_back_solid.get(),            "rasterizer_cull_back_solid");
+        m_pipeline_cache->RegisterObject(m_rasterizer_cull_back_solid_no_clip.get(),    "rasterizer_cull_back_solid_no_clip");
+        m_pipeline_cache->RegisterObject(m_rasterizer_cull_front_solid.get(),           "rasterizer_cull_front_solid");
+        m_pipeline_cache->RegisterObject(m_rasterizer_cull_none_solid.get(),            "rasterizer_cull_none_solid");
+        m_pipeline_cache->RegisterObject(m_rasterizer_cull_back_wireframe.get(),        "rasterizer_cull_back_wireframe");
+        m_pipeline_cache->RegisterObject(m_rasterizer_cull_front_wireframe.get(),       "rasterizer_cull_front_wireframe");
+        m_pipeline_cache->RegisterObject(m_rasterizer_cull_none_wireframe.get(),        "rasterizer_cull_none_wireframe");
+
+        RegisterPipelineShaderVariations();
+    }
+
+    void Renderer::RegisterPipelineShaderVariations()
+    {
+        // Variations are created on demand by materials (and replaced when reloaded), so they are registered as they show up
+        if (!m_pipeline_cache || ShaderVariation::GetVersion() == m_pipeline_variation_version)
+            return;
+
+        for (const shared_ptr<ShaderVariation>& variation : ShaderVariation::GetVariations())
+        {
+            if (variation)
+            {
+                m_pipeline_cache->RegisterObject(variation.get(), "shader_variation_" + to_string(variation->GetFlags()));
+            }
+        }
+
+        m_pipeline_variation_version = ShaderVariation::GetVersion();
+    }
+
+    bool Renderer::AcquireTransientRenderTargets()
+    {
+        bool registered = false;
+        for (const uint32_t id : m_render_graph->GetDeclaredIds())
+        {
+            const shared_ptr<RHI_Texture>& texture = m_render_graph->GetTexture(id);
+            const bool is_bloom = id >= RenderTarget_Bloom;
+            shared_ptr<RHI_Texture>& target = is_bloom ? m_render_tex_bloom[id - RenderTarget_Bloom] : m_render_targets[static_cast<Renderer_RenderTarget_Type>(id)];
+
+            // Render targets which no pass uses this frame become null, so that the pool can release their texture
+            if (target == texture)
+                continue;
+
+            target = texture;
+
+            // Pool textures are shared, the pipeline cache saves them under the name of the latest render target they were assigned to
+            if (target && m_pipeline_cache)
+            {
+                const string name = is_bloom ? "render_target_bloom_" + to_string(id - RenderTarget_Bloom) : "render_target_" + to_string(id);
+                m_pipeline_cache->RegisterObject(target.get(), name);
+                registered = true;
+            }
+        }
+
+        const float bytes_to_mb = 1.0f / (1024.0f * 1024.0f);
+        m_profiler->m_renderer_transient_peak_mb        = static_cast<float>(m_render_graph->GetMemoryPeak()) * bytes_to_mb;
+        m_profiler->m_renderer_transient_pool_mb        = static_cast<float>(m_render_graph->GetMemoryPool()) * bytes_to_mb;
+        m_profiler->m_renderer_transient_declared_mb    = static_cast<float>(m_render_graph->GetMemoryDeclared()) * bytes_to_mb;
+
+        return registered;
+    }
+
+    void Renderer::UpdateShaders(const float delta_time)
+    {
+        // Checking the sources means touching the disk, so it only happens every now and then
+        m_shader_reload_timer += delta_time;
+        const bool check_sources = m_shader_reload_timer >= shader_reload_interval_sec;
+        if (check_sources)
+        {
+            m_shader_reload_timer = 0.0f;
+        }
+
+        // Release replaced shaders, along with the pipelines which use them, once no frame in flight can be drawing with them
+        for (auto it = m_shaders_retired.begin(); it != m_shaders_retired.end();)
+        {
+            if (m_frame_num < it->second)
+            {
+                ++it;
+                continue;
+            }
+
+            if (m_pipeline_cache)
+            {
+                m_pipeline_cache->Evict(it->first.get());
+            }
+            it = m_shaders_retired.erase(it);
+        }
+
+        const auto dir_shaders = m_resource_cache->GetDataDirectory(Asset_Shaders) + "/";
+        vector<shared_ptr<RHI_Shader>> replaced;
+        ShaderVariation::Update(m_context, m_rhi_device, dir_shaders + "GBuffer.hlsl", check_sources, replaced);
+        for (shared_ptr<RHI_Shader>& shader : replaced)
+        {
+            m_shaders_retired.emplace_back(move(shader), m_frame_num + shader_release_frames);
+        }
+
+        // Swap in shaders which finished recompiling, failed ones are dropped and the previous ones keep being used
+        for (auto it = m_shaders_reloading.begin(); it != m_shaders_reloading.end();)
+        {
+            const Shader_Compilation_State state = it->second->GetCompilationState();
+            if (state == Shader_Compilation_Succeeded)
+            {
+                m_shaders_retired.emplace_back(m_shaders[it->first], m_frame_num + shader_release_frames);
+                m_shaders[it->first] = it->second;
+
+                if (m_pipeline_cache)
+                {
+                    m_pipeline_cache->RegisterObject(it->second.get(), "shader_" + to_string(it->first));
+                }
+
+                LOG_INFO("Reloaded \"%s\"", it->second->GetName().c_str());
+            }
+
+            if (state == Shader_Compilation_Succeeded || state == Shader_Compilation_Failed)
+            {
+                it = m_shaders_reloading.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        if (!check_sources)
+            return;
+
+        // Recompile modified shaders into new shaders, so that the current ones can keep drawing meanwhile
+        for (const auto& it : m_shaders)
+        {
+            const RHI_Shader* shader = it.second.get();
+            if (m_shaders_reloading.count(it.first) != 0 || shader->GetFilePath().empty())
+                continue;
+
+            const Shader_Compilation_State state = shader->GetCompilationState();
+            if (state != Shader_Compilation_Succeeded && state != Shader_Compilation_Failed)
+                continue;
+
+            if (!shader->IsSourceModified())
+                continue;
+
+            auto shader_new = make_shared<RHI_Shader>(m_rhi_device);
+            for (const auto& define : shader->GetDefines())
+            {
+                shader_new->AddDefine(define.first, define.second);
+            }
+            shader_new->CompileAsync(m_context, shader->GetShaderStage(), shader->GetFilePath(), shader->GetVertexType());
+
+            m_shaders_reloading[it.first] = shader_new;
+        }
+    }
 }
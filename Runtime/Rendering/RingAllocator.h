@@ -0,0 +1,91 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==============
+#include <cstdint>
+#include "../Core/EngineDefs.h"
+//=========================
+
+namespace Spartan
+{
+    // Hands out element indices of a buffer that is split into one region per frame in flight.
+    // Allocation is a cursor increment within the current frame's region and a region is only
+    // reused once its frame comes around again, so the GPU never reads memory the CPU is writing.
+    // It's CPU only, the caller decides what the indices point to.
+    class SPARTAN_CLASS RingAllocator
+    {
+    public:
+        RingAllocator() = default;
+        ~RingAllocator() = default;
+
+        void Reset(const uint32_t elements_per_frame, const uint32_t frame_count)
+        {
+            m_elements_per_frame    = elements_per_frame;
+            m_frame_count           = frame_count;
+            m_frame_index           = 0;
+            m_cursor                = 0;
+            m_peak                  = 0;
+            m_overflow              = false;
+        }
+
+        // Moves on to the next frame's region
+        void BeginFrame()
+        {
+            m_frame_index   = m_frame_count != 0 ? (m_frame_index + 1) % m_frame_count : 0;
+            m_cursor        = 0;
+            m_overflow      = false;
+        }
+
+        // Allocates count contiguous elements, returns false if the frame's region is exhausted
+        bool Allocate(const uint32_t count, uint32_t& index)
+        {
+            if (m_cursor + count > m_elements_per_frame)
+            {
+                m_overflow = true;
+                return false;
+            }
+
+            index       = m_frame_index * m_elements_per_frame + m_cursor;
+            m_cursor    += count;
+            m_peak      = m_cursor > m_peak ? m_cursor : m_peak;
+
+            return true;
+        }
+
+        uint32_t GetElementsPerFrame()  const { return m_elements_per_frame; }
+        uint32_t GetElementCount()      const { return m_elements_per_frame * m_frame_count; }
+        uint32_t GetFrameCount()        const { return m_frame_count; }
+        uint32_t GetFrameIndex()        const { return m_frame_index; }
+        uint32_t GetUsed()              const { return m_cursor; }
+        uint32_t GetPeak()              const { return m_peak; }
+        bool HasOverflown()             const { return m_overflow; }
+
+    private:
+        uint32_t m_elements_per_frame   = 0;
+        uint32_t m_frame_count          = 0;
+        uint32_t m_frame_index          = 0;
+        uint32_t m_cursor               = 0;
+        uint32_t m_peak                 = 0;
+        bool m_overflow                 = false;
+    };
+}
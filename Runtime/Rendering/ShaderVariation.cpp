@@ -19,9 +19,13 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
-//= INCLUDES ===============
+//= INCLUDES ========================
 #include "ShaderVariation.h"
-//==========================
+#include "Renderer_ConstantBuffers.h"
+#include "../Logging/Log.h"
+#include "../RHI/RHI_Device.h"
+#include "../RHI/RHI_Implementation.h"
+//===================================
 
 //= NAMESPACES =====
 using namespace std;
@@ -29,19 +33,11 @@ using namespace std;
 
 namespace Spartan
 {
-	vector<shared_ptr<ShaderVariation>> ShaderVariation::m_variations;
-
-	const shared_ptr<ShaderVariation>& ShaderVariation::GetMatchingShader(const uint8_t flags)
-	{
-		for (const auto& shader : m_variations)
-		{
-			if (shader->GetFlags() == flags)
-				return shader;
-		}
-
-		static shared_ptr<ShaderVariation> empty;
-		return empty;
-	}
+	array<shared_ptr<ShaderVariation>, 256> ShaderVariation::m_variations;
+    array<shared_ptr<ShaderVariation>, 256> ShaderVariation::m_variations_reloading;
+    uint32_t ShaderVariation::m_version = 0;
+    bitset<256> ShaderVariation::m_requests;
+    mutex ShaderVariation::m_requests_mutex;
 
 	ShaderVariation::ShaderVariation(const shared_ptr<RHI_Device>& rhi_device, Context* context) : RHI_Shader(rhi_device)
 	{
@@ -56,10 +52,107 @@ namespace Spartan
 		// Load and compile the pixel shader
 		AddDefinesBasedOnMaterial();
 		CompileAsync(m_context, RHI_Shader_Pixel, file_path);
-
-		m_variations.emplace_back(shared_from_this());
 	}
 
+    void ShaderVariation::Request(const uint8_t flags)
+    {
+        lock_guard<mutex> lock(m_requests_mutex);
+        m_requests.set(flags);
+    }
+
+    void ShaderVariation::Update(Context* context, const shared_ptr<RHI_Device>& rhi_device, const string& file_path, const bool check_sources, vector<shared_ptr<RHI_Shader>>& replaced)
+    {
+        // Swap in variations which finished recompiling, failed ones are dropped and the previous ones keep being used
+        for (uint32_t flags = 0; flags < m_variations_reloading.size(); flags++)
+        {
+            shared_ptr<ShaderVariation>& variation_new = m_variations_reloading[flags];
+            if (!variation_new)
+                continue;
+
+            const Shader_Compilation_State state = variation_new->GetCompilationState();
+            if (state == Shader_Compilation_Succeeded)
+            {
+                replaced.emplace_back(m_variations[flags]);
+                m_variations[flags] = variation_new;
+                m_version++;
+                LOG_INFO("Reloaded shader variation %d", flags);
+            }
+
+            if (state == Shader_Compilation_Succeeded || state == Shader_Compilation_Failed)
+            {
+                variation_new = nullptr;
+            }
+        }
+
+        // Compile requested variations in the background, until they are ready, materials draw with a fallback
+        bitset<256> requests;
+        {
+            lock_guard<mutex> lock(m_requests_mutex);
+            requests = m_requests;
+            m_requests.reset();
+        }
+
+        for (uint32_t flags = 0; flags < m_variations.size(); flags++)
+        {
+            if (!requests.test(flags) || m_variations[flags])
+                continue;
+
+            m_variations[flags] = make_shared<ShaderVariation>(rhi_device, context);
+            m_variations[flags]->Compile(file_path, static_cast<uint8_t>(flags));
+            m_version++;
+        }
+
+        // Recompile variations whose source was modified, into new variations so that the current ones can keep drawing
+        if (!check_sources)
+            return;
+
+        for (uint32_t flags = 0; flags < m_variations.size(); flags++)
+        {
+            const shared_ptr<ShaderVariation>& variation = m_variations[flags];
+            if (!variation || m_variations_reloading[flags])
+                continue;
+
+            const Shader_Compilation_State state = variation->GetCompilationState();
+            if (state != Shader_Compilation_Succeeded && state != Shader_Compilation_Failed)
+                continue;
+
+            if (!variation->IsSourceModified())
+                continue;
+
+            m_variations_reloading[flags] = make_shared<ShaderVariation>(rhi_device, context);
+            m_variations_reloading[flags]->Compile(file_path, static_cast<uint8_t>(flags));
+        }
+    }
+
+    ShaderVariation* ShaderVariation::GetCompiledShader(const uint8_t flags)
+    {
+        ShaderVariation* variation = m_variations[flags].get();
+        if (variation && variation->IsCompiled())
+            return variation;
+
+        // Fall back to the compiled variation which shares most of the flags, without expecting textures that aren't there
+        ShaderVariation* fallback   = nullptr;
+        size_t fallback_flag_count  = 0;
+        for (uint32_t subset = flags; ; subset = (subset - 1) & flags)
+        {
+            ShaderVariation* candidate = m_variations[subset].get();
+            if (candidate && candidate->IsCompiled())
+            {
+                const size_t flag_count = bitset<8>(subset).count();
+                if (!fallback || flag_count > fallback_flag_count)
+                {
+                    fallback            = candidate;
+                    fallback_flag_count = flag_count;
+                }
+            }
+
+            if (subset == 0)
+                break;
+        }
+
+        return fallback;
+    }
+
 	void ShaderVariation::AddDefinesBasedOnMaterial()
 	{
 		// Define in the shader what kind of textures it should expect
@@ -71,5 +164,9 @@ namespace Spartan
 		AddDefine("OCCLUSION_MAP",  (m_flags & Texture_Occlusion)   ? "1" : "0");
 		AddDefine("EMISSION_MAP",   (m_flags & Texture_Emission)    ? "1" : "0");
 		AddDefine("MASK_MAP",       (m_flags & Texture_Mask)        ? "1" : "0");
+
+		// Material properties come from the material table, textures from the bindless array (if supported)
+		AddDefine("MATERIAL_TABLE_SIZE", to_string(material_table_size));
+		AddDefine("BINDLESS", m_rhi_device->GetContextRhi()->bindless_textures ? "1" : "0");
 	}
 }
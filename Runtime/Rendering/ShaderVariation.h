@@ -22,7 +22,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 //= INCLUDES =====================
+#include <array>
+#include <bitset>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include "../RHI/RHI_Definition.h"
 #include "../RHI/RHI_Shader.h"
@@ -30,7 +33,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 namespace Spartan
 {
-	class ShaderVariation : public RHI_Shader, public std::enable_shared_from_this<ShaderVariation>
+	class ShaderVariation : public RHI_Shader
 	{
 	public:
 		ShaderVariation(const std::shared_ptr<RHI_Device>& rhi_device, Context* context);
@@ -38,13 +41,32 @@ namespace Spartan
 
 		void Compile(const std::string& file_path, const uint8_t shader_flags);
         uint8_t GetFlags() const { return m_flags; }
-		static const std::shared_ptr<ShaderVariation>& GetMatchingShader(const uint8_t flags);
+
+        // Variations are compiled on demand, requesting one which doesn't exist yet queues it up (can be called from any thread)
+        static void Request(const uint8_t flags);
+        // Starts compiling requested variations and swaps in recompiled ones, sources are checked for modifications only when asked to.
+        // Swapped out variations are appended to replaced, pipelines from previous frames may still use them.
+        static void Update(Context* context, const std::shared_ptr<RHI_Device>& rhi_device, const std::string& file_path, const bool check_sources, std::vector<std::shared_ptr<RHI_Shader>>& replaced);
+
+        // The variation for these exact flags, compiled or not
+        static ShaderVariation* GetMatchingShader(const uint8_t flags) { return m_variations[flags].get(); }
+        // The variation for these flags if it's compiled, otherwise the compiled variation which supports most of them
+        static ShaderVariation* GetCompiledShader(const uint8_t flags);
         static const auto& GetVariations() { return m_variations; }
+        static uint32_t GetVersion() { return m_version; } // changes whenever a variation is added or replaced
 
 	private:
 		void AddDefinesBasedOnMaterial();
 
         uint8_t m_flags = 0;
-		static std::vector<std::shared_ptr<ShaderVariation>> m_variations;
+
+        // Indexed by flags, only touched by Update() (the render thread)
+		static std::array<std::shared_ptr<ShaderVariation>, 256> m_variations;
+        static std::array<std::shared_ptr<ShaderVariation>, 256> m_variations_reloading;
+        static uint32_t m_version;
+
+        // Requests can come from any thread (e.g. materials loading in the background)
+        static std::bitset<256> m_requests;
+        static std::mutex m_requests_mutex;
 	};
 }
@@ -0,0 +1,149 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ====================
+#include "ShadowAtlas.h"
+#include "../Math/MathHelper.h"
+#include <algorithm>
+#include <numeric>
+//===============================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+namespace Spartan
+{
+    static const uint32_t tiles_per_side_min    = 4;        // the largest tile is a quarter of the atlas's side, so a point light's six faces fit at any size
+    static const float tile_size_keep_min       = 0.75f;    // the previous tile size is kept while the ideal size stays within these multiples of it
+    static const float tile_size_keep_max       = 2.5f;
+
+    // Z-order index (in units of the smallest tile) to position
+    static uint32_t morton_compact(uint64_t value)
+    {
+        value &= 0x5555555555555555ULL;
+        value = (value | (value >> 1))  & 0x3333333333333333ULL;
+        value = (value | (value >> 2))  & 0x0F0F0F0F0F0F0F0FULL;
+        value = (value | (value >> 4))  & 0x00FF00FF00FF00FFULL;
+        value = (value | (value >> 8))  & 0x0000FFFF0000FFFFULL;
+        value = (value | (value >> 16)) & 0x00000000FFFFFFFFULL;
+        return static_cast<uint32_t>(value);
+    }
+
+    ShadowAtlas::ShadowAtlas(const uint32_t size, const uint32_t tile_size_min)
+    {
+        m_size          = FloorPowerOfTwo(Helper::Max(size, 1u));
+        m_tile_size_max = Helper::Max(m_size / tiles_per_side_min, 1u);
+        m_tile_size_min = Helper::Min(FloorPowerOfTwo(Helper::Max(tile_size_min, 1u)), m_tile_size_max);
+    }
+
+    uint32_t ShadowAtlas::Pack(vector<ShadowAtlasRequest>& requests)
+    {
+        const uint32_t request_count = static_cast<uint32_t>(requests.size());
+
+        // Serve the requests in priority order (ties are broken by id, so the result doesn't depend on the order of the requests)
+        m_order.resize(request_count);
+        iota(m_order.begin(), m_order.end(), 0);
+        sort(m_order.begin(), m_order.end(), [&requests](const uint32_t a, const uint32_t b)
+        {
+            if (requests[a].priority != requests[b].priority)
+                return requests[a].priority > requests[b].priority;
+
+            return requests[a].id < requests[b].id;
+        });
+
+        // Size, every request is halved until it fits in the area that's left
+        const uint64_t area     = static_cast<uint64_t>(m_size) * m_size;
+        uint64_t area_free      = area;
+        uint32_t packed_count   = 0;
+        m_sizes.assign(request_count, 0);
+        for (const uint32_t i : m_order)
+        {
+            ShadowAtlasRequest& request = requests[i];
+            request.tile_count          = Helper::Clamp(request.tile_count, 1u, static_cast<uint32_t>(request.tiles.size()));
+            request.tiles.fill(ShadowAtlasTile());
+
+            uint32_t size = Helper::Clamp(FloorPowerOfTwo(request.size), m_tile_size_min, m_tile_size_max);
+            while (size >= m_tile_size_min && static_cast<uint64_t>(size) * size * request.tile_count > area_free)
+            {
+                size /= 2;
+            }
+
+            if (size < m_tile_size_min)
+                continue;
+
+            area_free   -= static_cast<uint64_t>(size) * size * request.tile_count;
+            m_sizes[i]  = size;
+            packed_count++;
+        }
+
+        // Place, in decreasing size order (stable, so equal sizes keep their priority order).
+        // Every tile's Z-order offset is then a multiple of its own area, which puts it on a quadtree node of its size.
+        stable_sort(m_order.begin(), m_order.end(), [this](const uint32_t a, const uint32_t b) { return m_sizes[a] > m_sizes[b]; });
+        uint64_t offset = 0;
+        for (const uint32_t i : m_order)
+        {
+            const uint32_t size = m_sizes[i];
+            if (size == 0)
+                break;
+
+            const uint32_t size_in_tiles = size / m_tile_size_min;
+            for (uint32_t j = 0; j < requests[i].tile_count; j++)
+            {
+                ShadowAtlasTile& tile   = requests[i].tiles[j];
+                tile.x                  = morton_compact(offset) * m_tile_size_min;
+                tile.y                  = morton_compact(offset >> 1) * m_tile_size_min;
+                tile.size               = size;
+                offset                  += static_cast<uint64_t>(size_in_tiles) * size_in_tiles;
+            }
+        }
+
+        m_occupancy = static_cast<float>(static_cast<double>(area - area_free) / static_cast<double>(area));
+        return packed_count;
+    }
+
+    uint32_t ShadowAtlas::ComputeTileSize(const float screen_coverage, const uint32_t size_previous) const
+    {
+        const float size_ideal = Helper::Saturate(screen_coverage) * static_cast<float>(m_tile_size_max);
+
+        // The upper bound can't exceed the largest tile, or a light could never grow into it
+        if (size_previous != 0 && size_ideal >= size_previous * tile_size_keep_min && size_ideal < Helper::Min(size_previous * tile_size_keep_max, static_cast<float>(m_tile_size_max)))
+            return Helper::Clamp(size_previous, m_tile_size_min, m_tile_size_max);
+
+        return Helper::Clamp(FloorPowerOfTwo(static_cast<uint32_t>(size_ideal)), m_tile_size_min, m_tile_size_max);
+    }
+
+    uint32_t ShadowAtlas::FloorPowerOfTwo(uint32_t value) const
+    {
+        if (value == 0)
+            return 0;
+
+        uint32_t power = 1;
+        while (value >>= 1)
+        {
+            power <<= 1;
+        }
+
+        return power;
+    }
+}
@@ -0,0 +1,82 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+//= INCLUDES ==============
+#include <array>
+#include <vector>
+#include "../Core/EngineDefs.h"
+//=========================
+
+namespace Spartan
+{
+    // A square region of the atlas, in texels
+    struct ShadowAtlasTile
+    {
+        uint32_t x      = 0;
+        uint32_t y      = 0;
+        uint32_t size   = 0;
+    };
+
+    // The tiles a light asks for, all of the same size (one per cube face for point lights, one for spot lights)
+    struct ShadowAtlasRequest
+    {
+        uint64_t id                             = 0;    // identifies the light
+        uint32_t tile_count                     = 1;
+        uint32_t size                           = 0;    // desired tile size
+        float priority                          = 0.0f; // requests with a higher priority are served first
+        std::array<ShadowAtlasTile, 6> tiles;           // the packed tiles, their size is 0 if the request didn't fit
+    };
+
+    // Packs the shadow maps of point and spot lights into a single square texture.
+    // Tile sizes are powers of two, so placing them in decreasing size order along the atlas's quadtree (Z-order) lands
+    // every tile on a node of its own size and the atlas fills up without gaps. Requests which don't fit at their desired
+    // size are halved, in priority order, down to the minimum tile size, below which they get no tiles at all.
+    class SPARTAN_CLASS ShadowAtlas
+    {
+    public:
+        ShadowAtlas(uint32_t size, uint32_t tile_size_min);
+        ~ShadowAtlas() = default;
+
+        // Sizes and places the tiles of all the requests, returns how many of them got tiles
+        uint32_t Pack(std::vector<ShadowAtlasRequest>& requests);
+
+        // Desired tile size of a light which covers the given fraction of the screen (0 to 1), it sticks to the previous size until the coverage has clearly changed
+        uint32_t ComputeTileSize(float screen_coverage, uint32_t size_previous) const;
+
+        uint32_t GetSize()          const { return m_size; }
+        uint32_t GetTileSizeMin()   const { return m_tile_size_min; }
+        uint32_t GetTileSizeMax()   const { return m_tile_size_max; }
+        float GetOccupancy()        const { return m_occupancy; } // fraction of the atlas the last pack used
+
+    private:
+        uint32_t FloorPowerOfTwo(uint32_t value) const;
+
+        uint32_t m_size             = 0;
+        uint32_t m_tile_size_min    = 0;
+        uint32_t m_tile_size_max    = 0;
+        float m_occupancy           = 0.0f;
+        std::vector<uint32_t> m_order;
+        std::vector<uint32_t> m_sizes;
+    };
+}
@@ -0,0 +1,696 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ========================
+#include "SkeletalAnimation.h"
+#include "Animation.h"
+#include "../Threading/Threading.h"
+#include "../Logging/Log.h"
+#include <algorithm>
+#include <cmath>
+//===================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+namespace Spartan
+{
+    static const float rotation_range           = 0.70710678f;  // the three smallest components of a unit quaternion are within +-1/sqrt(2)
+    static const float rotation_quantization    = 32767.0f;     // 15 bits per component
+    static const float track_epsilon            = 0.00001f;     // tracks which never change more than this are stored once
+    static const uint32_t parallel_threshold    = 16;           // fewer instances than this are evaluated on the calling thread
+
+    template <typename Key, typename Value, typename Lerp>
+    static Value sample_keys(const vector<Key>& keys, const double time, Lerp lerp)
+    {
+        if (keys.size() == 1 || time <= keys.front().time)
+            return keys.front().value;
+
+        if (time >= keys.back().time)
+            return keys.back().value;
+
+        const auto next     = upper_bound(keys.begin(), keys.end(), time, [](const double t, const Key& key) { return t < key.time; });
+        const auto previous = next - 1;
+        const double span   = next->time - previous->time;
+        const float t       = span > 0.0 ? static_cast<float>((time - previous->time) / span) : 0.0f;
+
+        return lerp(previous->value, next->value, t);
+    }
+
+    static bool nearly_equal(const Vector3& a, const Vector3& b)
+    {
+        return abs(a.x - b.x) <= track_epsilon && abs(a.y - b.y) <= track_epsilon && abs(a.z - b.z) <= track_epsilon;
+    }
+
+    static bool nearly_equal(const Quaternion& a, const Quaternion& b)
+    {
+        // q and -q are the same rotation
+        const float dot = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+        return abs(dot) >= 1.0f - track_epsilon;
+    }
+
+    void AnimationPose::Resize(const uint32_t bone_count)
+    {
+        const uint32_t stride = (bone_count + 3) & ~3u;
+
+        // Unused bones (and padding) are identity transforms
+        vector<float> data(stride * Pose_Stream_Count, 0.0f);
+        fill_n(data.begin() + Pose_Rotation_W * stride, stride, 1.0f);
+        fill_n(data.begin() + Pose_Scale_X * stride, stride * 3, 1.0f);
+
+        const uint32_t kept = min(bone_count, m_bone_count);
+        for (uint32_t stream = 0; stream < Pose_Stream_Count; stream++)
+        {
+            copy_n(m_data.begin() + stream * m_stride, kept, data.begin() + stream * stride);
+        }
+
+        m_data          = move(data);
+        m_bone_count    = bone_count;
+        m_stride        = stride;
+    }
+
+    void AnimationPose::SetBone(const uint32_t index, const Vector3& position, const Quaternion& rotation, const Vector3& scale)
+    {
+        GetStream(Pose_Translation_X)[index]    = position.x;
+        GetStream(Pose_Translation_Y)[index]    = position.y;
+        GetStream(Pose_Translation_Z)[index]    = position.z;
+        GetStream(Pose_Rotation_X)[index]       = rotation.x;
+        GetStream(Pose_Rotation_Y)[index]       = rotation.y;
+        GetStream(Pose_Rotation_Z)[index]       = rotation.z;
+        GetStream(Pose_Rotation_W)[index]       = rotation.w;
+        GetStream(Pose_Scale_X)[index]          = scale.x;
+        GetStream(Pose_Scale_Y)[index]          = scale.y;
+        GetStream(Pose_Scale_Z)[index]          = scale.z;
+    }
+
+    Vector3 AnimationPose::GetPosition(const uint32_t index) const
+    {
+        return Vector3(GetStream(Pose_Translation_X)[index], GetStream(Pose_Translation_Y)[index], GetStream(Pose_Translation_Z)[index]);
+    }
+
+    Quaternion AnimationPose::GetRotation(const uint32_t index) const
+    {
+        return Quaternion(GetStream(Pose_Rotation_X)[index], GetStream(Pose_Rotation_Y)[index], GetStream(Pose_Rotation_Z)[index], GetStream(Pose_Rotation_W)[index]);
+    }
+
+    Vector3 AnimationPose::GetScale(const uint32_t index) const
+    {
+        return Vector3(GetStream(Pose_Scale_X)[index], GetStream(Pose_Scale_Y)[index], GetStream(Pose_Scale_Z)[index]);
+    }
+
+    void AnimationPose::Blend(const AnimationPose& a, const AnimationPose& b, const float weight, AnimationPose* out)
+    {
+        if (!out || a.m_bone_count != b.m_bone_count)
+        {
+            LOG_ERROR_INVALID_PARAMETER();
+            return;
+        }
+
+        if (out->m_bone_count != a.m_bone_count)
+        {
+            out->Resize(a.m_bone_count);
+        }
+
+        const uint32_t stride   = a.m_stride;
+        const float weight_inv  = 1.0f - weight;
+
+        // Translation and scale, linear
+        for (const AnimationPose_Stream stream : { Pose_Translation_X, Pose_Translation_Y, Pose_Translation_Z, Pose_Scale_X, Pose_Scale_Y, Pose_Scale_Z })
+        {
+            const float* stream_a   = a.GetStream(stream);
+            const float* stream_b   = b.GetStream(stream);
+            float* stream_out       = out->GetStream(stream);
+            for (uint32_t i = 0; i < stride; i++)
+            {
+                stream_out[i] = stream_a[i] * weight_inv + stream_b[i] * weight;
+            }
+        }
+
+        // Rotation, normalized linear along the shortest path
+        const float* ax = a.GetStream(Pose_Rotation_X); const float* bx = b.GetStream(Pose_Rotation_X); float* ox = out->GetStream(Pose_Rotation_X);
+        const float* ay = a.GetStream(Pose_Rotation_Y); const float* by = b.GetStream(Pose_Rotation_Y); float* oy = out->GetStream(Pose_Rotation_Y);
+        const float* az = a.GetStream(Pose_Rotation_Z); const float* bz = b.GetStream(Pose_Rotation_Z); float* oz = out->GetStream(Pose_Rotation_Z);
+        const float* aw = a.GetStream(Pose_Rotation_W); const float* bw = b.GetStream(Pose_Rotation_W); float* ow = out->GetStream(Pose_Rotation_W);
+        for (uint32_t i = 0; i < stride; i++)
+        {
+            const float dot         = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i] + aw[i] * bw[i];
+            const float weight_b    = dot < 0.0f ? -weight : weight;
+            const float x           = ax[i] * weight_inv + bx[i] * weight_b;
+            const float y           = ay[i] * weight_inv + by[i] * weight_b;
+            const float z           = az[i] * weight_inv + bz[i] * weight_b;
+            const float w           = aw[i] * weight_inv + bw[i] * weight_b;
+            const float length_inv  = 1.0f / sqrt(x * x + y * y + z * z + w * w);
+            ox[i] = x * length_inv;
+            oy[i] = y * length_inv;
+            oz[i] = z * length_inv;
+            ow[i] = w * length_inv;
+        }
+    }
+
+    uint32_t Skeleton::AddBone(const string& name, const int32_t parent, const Matrix& inverse_bind, const Vector3& position, const Quaternion& rotation, const Vector3& scale)
+    {
+        const uint32_t index = GetBoneCount();
+        if (parent >= static_cast<int32_t>(index))
+        {
+            LOG_ERROR("Bone \"%s\" was added before its parent", name.c_str());
+        }
+
+        m_names.emplace_back(name);
+        m_lookup[name] = index;
+        m_parents.emplace_back(parent < static_cast<int32_t>(index) ? parent : -1);
+        m_inverse_bind.emplace_back(inverse_bind);
+        m_bind_pose.Resize(index + 1);
+        m_bind_pose.SetBone(index, position, rotation, scale);
+
+        return index;
+    }
+
+    int32_t Skeleton::GetBoneIndex(const string& name) const
+    {
+        const auto it = m_lookup.find(name);
+        return it != m_lookup.end() ? static_cast<int32_t>(it->second) : -1;
+    }
+
+    void Skeleton::Clear()
+    {
+        m_names.clear();
+        m_lookup.clear();
+        m_parents.clear();
+        m_inverse_bind.clear();
+        m_bind_pose = AnimationPose();
+    }
+
+    bool AnimationClip::Build(const Animation& animation, const Skeleton& skeleton, const float sample_rate)
+    {
+        const uint32_t bone_count = skeleton.GetBoneCount();
+        if (bone_count == 0 || sample_rate <= 0.0f)
+        {
+            LOG_ERROR_INVALID_PARAMETER();
+            return false;
+        }
+
+        const double ticks_per_second = animation.GetTicksPerSec() > 0.0 ? animation.GetTicksPerSec() : 25.0;
+
+        m_name          = animation.GetName();
+        m_duration      = static_cast<float>(animation.GetDuration() / ticks_per_second);
+        m_sample_rate   = sample_rate;
+        m_frame_count   = static_cast<uint32_t>(ceil(m_duration * sample_rate)) + 1;
+        m_constant      = skeleton.GetBindPose();
+        m_rotation_bones.clear();
+        m_translation_bones.clear();
+        m_scale_bones.clear();
+
+        // Resample every channel, tracks which change are kept aside until they are laid out per frame
+        vector<vector<Quaternion>> rotation_tracks;
+        vector<vector<Vector3>> translation_tracks;
+        vector<vector<Vector3>> scale_tracks;
+        uint32_t unmatched = 0;
+
+        const auto frame_time = [this, ticks_per_second](const uint32_t frame)
+        {
+            return min(static_cast<double>(frame) / m_sample_rate, static_cast<double>(m_duration)) * ticks_per_second;
+        };
+
+        const auto lerp_vector = [](const Vector3& a, const Vector3& b, const float t) { return a + (b - a) * t; };
+
+        for (const AnimationNode& channel : animation.GetChannels())
+        {
+            const int32_t bone = skeleton.GetBoneIndex(channel.name);
+            if (bone < 0)
+            {
+                unmatched++;
+                continue;
+            }
+
+            if (!channel.rotationFrames.empty())
+            {
+                vector<Quaternion> track(m_frame_count);
+                for (uint32_t frame = 0; frame < m_frame_count; frame++)
+                {
+                    track[frame] = sample_keys<KeyQuaternion, Quaternion>(channel.rotationFrames, frame_time(frame), Quaternion::Lerp).Normalized();
+                }
+
+                const bool constant = all_of(track.begin(), track.end(), [&track](const Quaternion& value) { return nearly_equal(value, track.front()); });
+                if (constant)
+                {
+                    m_constant.SetBone(bone, m_constant.GetPosition(bone), track.front(), m_constant.GetScale(bone));
+                }
+                else
+                {
+                    m_rotation_bones.emplace_back(bone);
+                    rotation_tracks.emplace_back(move(track));
+                }
+            }
+
+            if (!channel.positionFrames.empty())
+            {
+                vector<Vector3> track(m_frame_count);
+                for (uint32_t frame = 0; frame < m_frame_count; frame++)
+                {
+                    track[frame] = sample_keys<KeyVector, Vector3>(channel.positionFrames, frame_time(frame), lerp_vector);
+                }
+
+                const bool constant = all_of(track.begin(), track.end(), [&track](const Vector3& value) { return nearly_equal(value, track.front()); });
+                if (constant)
+                {
+                    m_constant.SetBone(bone, track.front(), m_constant.GetRotation(bone), m_constant.GetScale(bone));
+                }
+                else
+                {
+                    m_translation_bones.emplace_back(bone);
+                    translation_tracks.emplace_back(move(track));
+                }
+            }
+
+            if (!channel.scaleFrames.empty())
+            {
+                vector<Vector3> track(m_frame_count);
+                for (uint32_t frame = 0; frame < m_frame_count; frame++)
+                {
+                    track[frame] = sample_keys<KeyVector, Vector3>(channel.scaleFrames, frame_time(frame), lerp_vector);
+                }
+
+                const bool constant = all_of(track.begin(), track.end(), [&track](const Vector3& value) { return nearly_equal(value, track.front()); });
+                if (constant)
+                {
+                    m_constant.SetBone(bone, m_constant.GetPosition(bone), m_constant.GetRotation(bone), track.front());
+                }
+                else
+                {
+                    m_scale_bones.emplace_back(bone);
+                    scale_tracks.emplace_back(move(track));
+                }
+            }
+        }
+
+        if (unmatched != 0)
+        {
+            LOG_WARNING("%d channels of \"%s\" don't match any bone", unmatched, m_name.c_str());
+        }
+
+        // Lay the animated tracks out per frame, so that sampling touches two contiguous blocks
+        const uint32_t rotation_count = static_cast<uint32_t>(m_rotation_bones.size());
+        m_rotations.resize(static_cast<size_t>(m_frame_count) * rotation_count * 3);
+        for (uint32_t frame = 0; frame < m_frame_count; frame++)
+        {
+            for (uint32_t i = 0; i < rotation_count; i++)
+            {
+                EncodeRotation(rotation_tracks[i][frame], &m_rotations[(static_cast<size_t>(frame) * rotation_count + i) * 3]);
+            }
+        }
+
+        const auto lay_out = [this](const vector<vector<Vector3>>& tracks, vector<float>& frames)
+        {
+            const size_t count = tracks.size();
+            frames.resize(m_frame_count * count * 3);
+            for (uint32_t frame = 0; frame < m_frame_count; frame++)
+            {
+                float* block = &frames[frame * count * 3];
+                for (size_t i = 0; i < count; i++)
+                {
+                    block[i]                = tracks[i][frame].x;
+                    block[count + i]        = tracks[i][frame].y;
+                    block[count * 2 + i]    = tracks[i][frame].z;
+                }
+            }
+        };
+        lay_out(translation_tracks, m_translations);
+        lay_out(scale_tracks, m_scales);
+
+        return true;
+    }
+
+    void AnimationClip::Sample(float time, const bool loop, AnimationPose* pose) const
+    {
+        if (!pose || m_frame_count == 0)
+        {
+            LOG_ERROR_INVALID_PARAMETER();
+            return;
+        }
+
+        // Start from the tracks which never change
+        *pose = m_constant;
+
+        // Find the two frames around the time
+        if (loop && m_duration > 0.0f)
+        {
+            time = fmod(time, m_duration);
+            time = time < 0.0f ? time + m_duration : time;
+        }
+        time = Helper::Clamp(time, 0.0f, m_duration);
+
+        const float frame       = time * m_sample_rate;
+        const uint32_t frame_a  = min(static_cast<uint32_t>(frame), m_frame_count - 1);
+        const uint32_t frame_b  = min(frame_a + 1, m_frame_count - 1);
+        const float t           = Helper::Saturate(frame - static_cast<float>(frame_a));
+        const float t_inv       = 1.0f - t;
+
+        // Scratch space, per thread since instances are evaluated in parallel
+        thread_local vector<float> scratch;
+
+        // Translations and scales, interpolated in one loop over contiguous floats and then scattered to their bones
+        const auto sample_vectors = [pose, frame_a, frame_b, t, t_inv](const vector<uint32_t>& bones, const vector<float>& frames, const AnimationPose_Stream stream_x)
+        {
+            const size_t count = bones.size();
+            if (count == 0)
+                return;
+
+            const float* a = &frames[frame_a * count * 3];
+            const float* b = &frames[frame_b * count * 3];
+            scratch.resize(count * 3);
+            float* blended = scratch.data();
+            for (size_t i = 0; i < count * 3; i++)
+            {
+                blended[i] = a[i] * t_inv + b[i] * t;
+            }
+
+            float* x = pose->GetStream(stream_x);
+            float* y = pose->GetStream(static_cast<AnimationPose_Stream>(stream_x + 1));
+            float* z = pose->GetStream(static_cast<AnimationPose_Stream>(stream_x + 2));
+            for (size_t i = 0; i < count; i++)
+            {
+                const uint32_t bone = bones[i];
+                x[bone] = blended[i];
+                y[bone] = blended[count + i];
+                z[bone] = blended[count * 2 + i];
+            }
+        };
+        sample_vectors(m_translation_bones, m_translations, Pose_Translation_X);
+        sample_vectors(m_scale_bones, m_scales, Pose_Scale_X);
+
+        // Rotations, decoded into two blocks of components, interpolated, and then scattered to their bones
+        const size_t count = m_rotation_bones.size();
+        if (count != 0)
+        {
+            scratch.resize(count * 8);
+            float* a = scratch.data();
+            float* b = scratch.data() + count * 4;
+            const uint16_t* encoded_a = &m_rotations[frame_a * count * 3];
+            const uint16_t* encoded_b = &m_rotations[frame_b * count * 3];
+            for (size_t i = 0; i < count; i++)
+            {
+                float rotation[4];
+
+                DecodeRotation(&encoded_a[i * 3], rotation);
+                a[i] = rotation[0]; a[count + i] = rotation[1]; a[count * 2 + i] = rotation[2]; a[count * 3 + i] = rotation[3];
+
+                DecodeRotation(&encoded_b[i * 3], rotation);
+                b[i] = rotation[0]; b[count + i] = rotation[1]; b[count * 2 + i] = rotation[2]; b[count * 3 + i] = rotation[3];
+            }
+
+            for (size_t i = 0; i < count; i++)
+            {
+                const float dot     = a[i] * b[i] + a[count + i] * b[count + i] + a[count * 2 + i] * b[count * 2 + i] + a[count * 3 + i] * b[count * 3 + i];
+                const float t_b     = dot < 0.0f ? -t : t;
+                const float x       = a[i] * t_inv + b[i] * t_b;
+                const float y       = a[count + i] * t_inv + b[count + i] * t_b;
+                const float z       = a[count * 2 + i] * t_inv + b[count * 2 + i] * t_b;
+                const float w       = a[count * 3 + i] * t_inv + b[count * 3 + i] * t_b;
+                const float inv     = 1.0f / sqrt(x * x + y * y + z * z + w * w);
+                a[i]                = x * inv;
+                a[count + i]        = y * inv;
+                a[count * 2 + i]    = z * inv;
+                a[count * 3 + i]    = w * inv;
+            }
+
+            float* x = pose->GetStream(Pose_Rotation_X);
+            float* y = pose->GetStream(Pose_Rotation_Y);
+            float* z = pose->GetStream(Pose_Rotation_Z);
+            float* w = pose->GetStream(Pose_Rotation_W);
+            for (size_t i = 0; i < count; i++)
+            {
+                const uint32_t bone = m_rotation_bones[i];
+                x[bone] = a[i];
+                y[bone] = a[count + i];
+                z[bone] = a[count * 2 + i];
+                w[bone] = a[count * 3 + i];
+            }
+        }
+    }
+
+    uint64_t AnimationClip::GetSizeBytes() const
+    {
+        return
+            m_constant.GetStride() * Pose_Stream_Count * sizeof(float) +
+            (m_rotation_bones.size() + m_translation_bones.size() + m_scale_bones.size()) * sizeof(uint32_t) +
+            m_rotations.size() * sizeof(uint16_t) +
+            (m_translations.size() + m_scales.size()) * sizeof(float);
+    }
+
+    void AnimationClip::EncodeRotation(const Quaternion& rotation, uint16_t* encoded)
+    {
+        const Quaternion normalized = rotation.Normalized();
+        const float components[4]   = { normalized.x, normalized.y, normalized.z, normalized.w };
+
+        // The largest component is dropped and rebuilt from the other three, its sign is folded into theirs (q == -q)
+        uint32_t largest = 0;
+        for (uint32_t i = 1; i < 4; i++)
+        {
+            largest = abs(components[i]) > abs(components[largest]) ? i : largest;
+        }
+        const float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+
+        uint16_t quantized[3];
+        for (uint32_t i = 0, j = 0; i < 4; i++)
+        {
+            if (i == largest)
+                continue;
+
+            const float value   = Helper::Clamp(components[i] * sign / rotation_range, -1.0f, 1.0f);
+            quantized[j++]      = static_cast<uint16_t>(lround((value * 0.5f + 0.5f) * rotation_quantization));
+        }
+
+        encoded[0] = quantized[0] | static_cast<uint16_t>((largest >> 1) << 15);
+        encoded[1] = quantized[1] | static_cast<uint16_t>((largest & 1) << 15);
+        encoded[2] = quantized[2];
+    }
+
+    void AnimationClip::DecodeRotation(const uint16_t* encoded, float* rotation)
+    {
+        const uint32_t largest  = ((encoded[0] >> 15) << 1) | (encoded[1] >> 15);
+        const float values[3]   =
+        {
+            ((encoded[0] & 0x7fff) / rotation_quantization * 2.0f - 1.0f) * rotation_range,
+            ((encoded[1] & 0x7fff) / rotation_quantization * 2.0f - 1.0f) * rotation_range,
+            ((encoded[2] & 0x7fff) / rotation_quantization * 2.0f - 1.0f) * rotation_range
+        };
+
+        for (uint32_t i = 0, j = 0; i < 4; i++)
+        {
+            rotation[i] = i == largest ? 0.0f : values[j++];
+        }
+        rotation[largest] = sqrt(max(0.0f, 1.0f - values[0] * values[0] - values[1] * values[1] - values[2] * values[2]));
+    }
+
+    SkeletonInstance::SkeletonInstance(const Skeleton* skeleton)
+    {
+        m_skeleton  = skeleton;
+        m_pose      = skeleton ? skeleton->GetBindPose() : AnimationPose();
+    }
+
+    void SkeletonInstance::Play(const AnimationClip* clip, const bool loop)
+    {
+        if (clip && m_skeleton && clip->GetBoneCount() != m_skeleton->GetBoneCount())
+        {
+            LOG_ERROR("Clip \"%s\" was built for a different skeleton", clip->GetName().c_str());
+            return;
+        }
+
+        m_clip      = clip;
+        m_clip_next = nullptr;
+        m_time      = 0.0f;
+        m_loop      = loop;
+    }
+
+    void SkeletonInstance::CrossFade(const AnimationClip* clip, const float duration, const bool loop)
+    {
+        if (!m_clip || duration <= 0.0f)
+        {
+            Play(clip, loop);
+            return;
+        }
+
+        if (clip && m_skeleton && clip->GetBoneCount() != m_skeleton->GetBoneCount())
+        {
+            LOG_ERROR("Clip \"%s\" was built for a different skeleton", clip->GetName().c_str());
+            return;
+        }
+
+        m_clip_next     = clip;
+        m_time_next     = 0.0f;
+        m_loop_next     = loop;
+        m_fade_time     = 0.0f;
+        m_fade_duration = duration;
+    }
+
+    void SkeletonInstance::Tick(const float delta_time)
+    {
+        m_time += delta_time;
+
+        if (m_clip_next)
+        {
+            m_time_next += delta_time;
+            m_fade_time += delta_time;
+
+            // Fade complete
+            if (m_fade_time >= m_fade_duration)
+            {
+                m_clip      = m_clip_next;
+                m_time      = m_time_next;
+                m_loop      = m_loop_next;
+                m_clip_next = nullptr;
+            }
+        }
+    }
+
+    void SkeletonInstance::Evaluate()
+    {
+        if (!m_skeleton || m_skeleton->GetBoneCount() == 0)
+            return;
+
+        if (m_clip)
+        {
+            m_clip->Sample(m_time, m_loop, &m_pose);
+        }
+        else
+        {
+            m_pose = m_skeleton->GetBindPose();
+        }
+
+        if (m_clip && m_clip_next)
+        {
+            m_clip_next->Sample(m_time_next, m_loop_next, &m_pose_next);
+            AnimationPose::Blend(m_pose, m_pose_next, Helper::Saturate(m_fade_time / m_fade_duration), &m_pose);
+        }
+
+        ComputePalette();
+    }
+
+    void SkeletonInstance::Evaluate(Threading* threading, vector<SkeletonInstance>& instances)
+    {
+        const uint32_t instance_count = static_cast<uint32_t>(instances.size());
+
+        if (!threading || instance_count < parallel_threshold)
+        {
+            for (SkeletonInstance& instance : instances)
+            {
+                instance.Evaluate();
+            }
+
+            return;
+        }
+
+        threading->AddTaskLoop([&instances](const uint32_t start, const uint32_t end)
+        {
+            for (uint32_t i = start; i < end; i++)
+            {
+                instances[i].Evaluate();
+            }
+        }, instance_count);
+    }
+
+    void SkeletonInstance::ComputePalette()
+    {
+        const uint32_t bone_count   = m_skeleton->GetBoneCount();
+        const uint32_t stride       = m_pose.GetStride();
+
+        // Local transforms, one loop over every bone (3x3 rotation and scale, then translation, row vectors like Matrix)
+        m_local.resize(stride * 12);
+        {
+            const float* qx = m_pose.GetStream(Pose_Rotation_X);
+            const float* qy = m_pose.GetStream(Pose_Rotation_Y);
+            const float* qz = m_pose.GetStream(Pose_Rotation_Z);
+            const float* qw = m_pose.GetStream(Pose_Rotation_W);
+            const float* sx = m_pose.GetStream(Pose_Scale_X);
+            const float* sy = m_pose.GetStream(Pose_Scale_Y);
+            const float* sz = m_pose.GetStream(Pose_Scale_Z);
+            const float* tx = m_pose.GetStream(Pose_Translation_X);
+            const float* ty = m_pose.GetStream(Pose_Translation_Y);
+            const float* tz = m_pose.GetStream(Pose_Translation_Z);
+            float* local    = m_local.data();
+
+            for (uint32_t i = 0; i < stride; i++)
+            {
+                const float xx = qx[i] * qx[i], yy = qy[i] * qy[i], zz = qz[i] * qz[i];
+                const float xy = qx[i] * qy[i], xz = qx[i] * qz[i], yz = qy[i] * qz[i];
+                const float xw = qx[i] * qw[i], yw = qy[i] * qw[i], zw = qz[i] * qw[i];
+
+                local[stride * 0 + i]   = (1.0f - 2.0f * (yy + zz)) * sx[i];
+                local[stride * 1 + i]   = 2.0f * (xy + zw) * sx[i];
+                local[stride * 2 + i]   = 2.0f * (xz - yw) * sx[i];
+                local[stride * 3 + i]   = 2.0f * (xy - zw) * sy[i];
+                local[stride * 4 + i]   = (1.0f - 2.0f * (zz + xx)) * sy[i];
+                local[stride * 5 + i]   = 2.0f * (yz + xw) * sy[i];
+                local[stride * 6 + i]   = 2.0f * (xz + yw) * sz[i];
+                local[stride * 7 + i]   = 2.0f * (yz - xw) * sz[i];
+                local[stride * 8 + i]   = (1.0f - 2.0f * (yy + xx)) * sz[i];
+                local[stride * 9 + i]   = tx[i];
+                local[stride * 10 + i]  = ty[i];
+                local[stride * 11 + i]  = tz[i];
+            }
+        }
+
+        // Model space, parents come first so a single pass is enough (model = local * parent model)
+        m_model.resize(bone_count * 12);
+        m_palette.resize(bone_count);
+        const auto& parents         = m_skeleton->GetParents();
+        const auto& inverse_bind    = m_skeleton->GetInverseBind();
+        for (uint32_t i = 0; i < bone_count; i++)
+        {
+            float l[12];
+            for (uint32_t e = 0; e < 12; e++)
+            {
+                l[e] = m_local[stride * e + i];
+            }
+
+            float* m = &m_model[i * 12];
+            if (parents[i] < 0)
+            {
+                copy_n(l, 12, m);
+            }
+            else
+            {
+                const float* p = &m_model[parents[i] * 12];
+                for (uint32_t row = 0; row < 4; row++)
+                {
+                    const float* r  = &l[row * 3];
+                    const float add = row == 3 ? 1.0f : 0.0f; // translation row picks up the parent's translation
+                    for (uint32_t column = 0; column < 3; column++)
+                    {
+                        m[row * 3 + column] = r[0] * p[column] + r[1] * p[3 + column] + r[2] * p[6 + column] + add * p[9 + column];
+                    }
+                }
+            }
+
+            // Palette, bind space to model space
+            const Matrix& b = inverse_bind[i];
+            m_palette[i] = Matrix(
+                b.m00 * m[0] + b.m01 * m[3] + b.m02 * m[6] + b.m03 * m[9],  b.m00 * m[1] + b.m01 * m[4] + b.m02 * m[7] + b.m03 * m[10],  b.m00 * m[2] + b.m01 * m[5] + b.m02 * m[8] + b.m03 * m[11],  b.m03,
+                b.m10 * m[0] + b.m11 * m[3] + b.m12 * m[6] + b.m13 * m[9],  b.m10 * m[1] + b.m11 * m[4] + b.m12 * m[7] + b.m13 * m[10],  b.m10 * m[2] + b.m11 * m[5] + b.m12 * m[8] + b.m13 * m[11],  b.m13,
+                b.m20 * m[0] + b.m21 * m[3] + b.m22 * m[6] + b.m23 * m[9],  b.m20 * m[1] + b.m21 * m[4] + b.m22 * m[7] + b.m23 * m[10],  b.m20 * m[2] + b.m21 * m[5] + b.m22 * m[8] + b.m23 * m[11],  b.m23,
+                b.m30 * m[0] + b.m31 * m[3] + b.m32 * m[6] + b.m33 * m[9],  b.m30 * m[1] + b.m31 * m[4] + b.m32 * m[7] + b.m33 * m[10],  b.m30 * m[2] + b.m31 * m[5] + b.m32 * m[8] + b.m33 * m[11],  b.m33
+            );
+        }
+    }
+}
@@ -0,0 +1,182 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+//= INCLUDES ==================
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include "../Core/EngineDefs.h"
+#include "../Math/Matrix.h"
+//=============================
+
+namespace Spartan
+{
+    class Animation;
+    class Threading;
+
+    enum AnimationPose_Stream : uint32_t
+    {
+        Pose_Translation_X,
+        Pose_Translation_Y,
+        Pose_Translation_Z,
+        Pose_Rotation_X,
+        Pose_Rotation_Y,
+        Pose_Rotation_Z,
+        Pose_Rotation_W,
+        Pose_Scale_X,
+        Pose_Scale_Y,
+        Pose_Scale_Z,
+        Pose_Stream_Count
+    };
+
+    // The local transform of every bone of a skeleton, stored as one array per component (structure of arrays) so that
+    // sampling and blending are straight loops over contiguous floats. Streams are padded to a multiple of four bones.
+    class SPARTAN_CLASS AnimationPose
+    {
+    public:
+        AnimationPose() = default;
+        ~AnimationPose() = default;
+
+        void Resize(uint32_t bone_count);
+        void SetBone(uint32_t index, const Math::Vector3& position, const Math::Quaternion& rotation, const Math::Vector3& scale);
+        Math::Vector3 GetPosition(uint32_t index)       const;
+        Math::Quaternion GetRotation(uint32_t index)    const;
+        Math::Vector3 GetScale(uint32_t index)          const;
+
+        // out = a * (1 - weight) + b * weight, rotations take the shortest path, out can be a or b
+        static void Blend(const AnimationPose& a, const AnimationPose& b, float weight, AnimationPose* out);
+
+        float* GetStream(const AnimationPose_Stream stream)               { return m_data.data() + stream * m_stride; }
+        const float* GetStream(const AnimationPose_Stream stream) const   { return m_data.data() + stream * m_stride; }
+        uint32_t GetBoneCount()                                     const { return m_bone_count; }
+        uint32_t GetStride()                                        const { return m_stride; }
+
+    private:
+        std::vector<float> m_data;
+        uint32_t m_bone_count   = 0;
+        uint32_t m_stride       = 0;
+    };
+
+    // Bones are stored parents first, so model space transforms can be computed in a single pass
+    class SPARTAN_CLASS Skeleton
+    {
+    public:
+        Skeleton() = default;
+        ~Skeleton() = default;
+
+        // Returns the index of the bone, parent must be an existing bone or -1 for a root
+        uint32_t AddBone(const std::string& name, int32_t parent, const Math::Matrix& inverse_bind, const Math::Vector3& position, const Math::Quaternion& rotation, const Math::Vector3& scale);
+        int32_t GetBoneIndex(const std::string& name) const;
+        void Clear();
+
+        uint32_t GetBoneCount()         const { return static_cast<uint32_t>(m_parents.size()); }
+        const auto& GetBoneName(uint32_t index) const { return m_names[index]; }
+        const auto& GetParents()        const { return m_parents; }
+        const auto& GetInverseBind()    const { return m_inverse_bind; }
+        const auto& GetBindPose()       const { return m_bind_pose; }
+
+    private:
+        std::vector<std::string> m_names;
+        std::unordered_map<std::string, uint32_t> m_lookup;
+        std::vector<int32_t> m_parents;
+        std::vector<Math::Matrix> m_inverse_bind;
+        AnimationPose m_bind_pose;
+    };
+
+    // An animation resampled at a fixed rate for a specific skeleton. Sampling is two frame lookups and a blend, with no key
+    // searching. Tracks which never change are stored once, as part of a constant pose, and only the animated ones are kept
+    // per frame: translations and scales as floats, rotations quantized to 48 bits (the three smallest components at 15 bits each).
+    class SPARTAN_CLASS AnimationClip
+    {
+    public:
+        AnimationClip() = default;
+        ~AnimationClip() = default;
+
+        bool Build(const Animation& animation, const Skeleton& skeleton, float sample_rate = 30.0f);
+        void Sample(float time, bool loop, AnimationPose* pose) const;
+
+        const auto& GetName()       const { return m_name; }
+        float GetDuration()         const { return m_duration; }
+        uint32_t GetFrameCount()    const { return m_frame_count; }
+        uint32_t GetBoneCount()     const { return m_constant.GetBoneCount(); }
+        uint64_t GetSizeBytes()     const;
+
+    private:
+        static void EncodeRotation(const Math::Quaternion& rotation, uint16_t* encoded);
+        static void DecodeRotation(const uint16_t* encoded, float* rotation);
+
+        std::string m_name;
+        float m_duration            = 0.0f;
+        float m_sample_rate         = 30.0f;
+        uint32_t m_frame_count      = 0;
+        AnimationPose m_constant;                   // every track at its first value, animated tracks are overwritten while sampling
+        std::vector<uint32_t> m_rotation_bones;     // bones with animated rotations
+        std::vector<uint32_t> m_translation_bones;  // bones with animated translations
+        std::vector<uint32_t> m_scale_bones;        // bones with animated scales
+        std::vector<uint16_t> m_rotations;          // per frame, per animated rotation, three words
+        std::vector<float> m_translations;          // per frame, x of every animated translation, then y, then z
+        std::vector<float> m_scales;                // per frame, x of every animated scale, then y, then z
+    };
+
+    // A skeleton playing up to two clips, crossfaded, and the matrix palette that skinning reads
+    class SPARTAN_CLASS SkeletonInstance
+    {
+    public:
+        SkeletonInstance() = default;
+        SkeletonInstance(const Skeleton* skeleton);
+        ~SkeletonInstance() = default;
+
+        void Play(const AnimationClip* clip, bool loop = true);
+        void CrossFade(const AnimationClip* clip, float duration, bool loop = true);
+        void Tick(float delta_time);
+
+        // Samples the clips and computes the palette (bone model space to skinned model space, per bone)
+        void Evaluate();
+
+        // Evaluates many instances in parallel, each one is independent, so they are split across the job system
+        static void Evaluate(Threading* threading, std::vector<SkeletonInstance>& instances);
+
+        const Skeleton* GetSkeleton()   const { return m_skeleton; }
+        const auto& GetPose()           const { return m_pose; }
+        const auto& GetPalette()        const { return m_palette; }
+
+    private:
+        void ComputePalette();
+
+        const Skeleton* m_skeleton          = nullptr;
+        const AnimationClip* m_clip         = nullptr;
+        const AnimationClip* m_clip_next    = nullptr; // being faded in
+        float m_time                        = 0.0f;
+        float m_time_next                   = 0.0f;
+        float m_fade_time                   = 0.0f;
+        float m_fade_duration               = 0.0f;
+        bool m_loop                         = true;
+        bool m_loop_next                    = true;
+        AnimationPose m_pose;
+        AnimationPose m_pose_next;
+        std::vector<float> m_local;                 // local transforms as 3x4 matrices, one array per element
+        std::vector<float> m_model;                 // model space transforms as 3x4 matrices, twelve floats per bone
+        std::vector<Math::Matrix> m_palette;
+    };
+}
@@ -0,0 +1,729 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ==========================
+#include "TerrainQuadtree.h"
+#include "../Math/MathHelper.h"
+#include "../Math/Matrix.h"
+#include "../RHI/RHI_Vertex.h"
+#include "../RHI/RHI_VertexBuffer.h"
+#include "../RHI/RHI_IndexBuffer.h"
+#include "../Threading/Threading.h"
+#include "../Logging/Log.h"
+#include <algorithm>
+#include <cstring>
+//=====================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+namespace Spartan
+{
+    static const uint32_t patch_vertices        = TerrainQuadtree::patch_quads + 1;
+    static const float split_distance           = 2.0f;     // a node splits once the camera is closer than this many node sizes
+    static const float prefetch_distance        = 2.5f;     // and its children are requested from a bit further away
+    static const float morph_start              = 3.0f;     // a node morphs towards its parent from here, the parent stops splitting at twice the split distance
+    static const uint32_t morph_steps           = 8;        // every step regenerates the chunk, so the morph is quantized
+    static const uint32_t chunk_jobs_max        = 8;        // chunks generated at the same time
+    static const uint64_t chunk_evict_frames    = 300;      // chunks unused for this long are evicted
+    static const uint64_t chunk_release_frames  = 3;        // retired vertex buffers outlive the frames which might still draw them
+
+    // Edges of a patch
+    static const uint32_t edge_neg_x = 1 << 0;
+    static const uint32_t edge_pos_x = 1 << 1;
+    static const uint32_t edge_neg_y = 1 << 2;
+    static const uint32_t edge_pos_y = 1 << 3;
+
+    static const uint8_t level_grid_empty = 0xFF;
+
+    TerrainQuadtree::TerrainQuadtree(Threading* threading, const shared_ptr<RHI_Device>& rhi_device)
+    {
+        m_threading     = threading;
+        m_rhi_device    = rhi_device;
+    }
+
+    TerrainQuadtree::~TerrainQuadtree()
+    {
+        // Chunk tasks reference the height map, wait for them
+        while (m_jobs_in_flight.load() != 0)
+        {
+            this_thread::yield();
+        }
+    }
+
+    bool TerrainQuadtree::Initialize(vector<uint8_t>&& heights, const uint32_t width, const uint32_t height, const float min_y, const float max_y)
+    {
+        if (!SetHeights(move(heights), width, height, min_y, max_y))
+            return false;
+
+        GenerateIndexVariants();
+        if (!m_index_buffer)
+            return false;
+
+        // The root is always resident, every other node splits from it once its children are generated
+        Node root;
+        vector<RHI_Vertex_PosTexNorTan> vertices;
+        Chunk& chunk = m_chunks[root.GetKey()];
+        GenerateChunk(root, 0, vertices, chunk.aabb);
+        chunk.vertex_buffer = make_shared<RHI_VertexBuffer>(m_rhi_device);
+        if (!chunk.vertex_buffer->Create(vertices))
+        {
+            LOG_ERROR("Failed to create the vertex buffer of the root chunk");
+            m_chunks.clear();
+            return false;
+        }
+
+        return true;
+    }
+
+    void TerrainQuadtree::Update(const Vector3& camera_position, const Matrix& transform, const uint64_t frame)
+    {
+        if (!IsInitialized())
+            return;
+
+        m_frame = frame;
+
+        // Swap in the chunks which finished generating
+        {
+            lock_guard<mutex> lock(m_mutex_results);
+            for (ChunkResult& result : m_chunk_results)
+            {
+                Chunk& chunk        = m_chunks[result.key];
+                chunk.is_building   = false;
+                chunk.frame_used    = m_frame;
+
+                if (!result.vertex_buffer)
+                    continue;
+
+                if (chunk.vertex_buffer)
+                {
+                    m_chunks_retired.emplace_back(m_frame, move(chunk.vertex_buffer));
+                }
+
+                chunk.vertex_buffer = move(result.vertex_buffer);
+                chunk.aabb          = result.aabb;
+                chunk.morph_step    = result.morph_step;
+            }
+            m_chunk_results.clear();
+        }
+
+        // Select, then coarsen nodes which are two or more levels finer than a neighbour until there are none
+        m_forced_leaves.clear();
+        for (uint32_t i = 0; i < m_level_count; i++)
+        {
+            SelectLod(camera_position, true);
+            if (!Balance())
+                break;
+        }
+        ComputeEdgeMasks();
+
+        // Keep the selected chunks and their ancestors (which they merge into) resident, and regenerate the ones whose morph changed
+        for (const Node& node : m_nodes)
+        {
+            for (uint32_t level = 0; level <= node.level; level++)
+            {
+                const uint32_t shift = node.level - level;
+                auto it = m_chunks.find(Node{ level, node.x >> shift, node.y >> shift }.GetKey());
+                if (it != m_chunks.end())
+                {
+                    it->second.frame_used = m_frame;
+                }
+            }
+
+            const Chunk& chunk = m_chunks[node.GetKey()];
+            if (!chunk.is_building && chunk.morph_step != GetMorphStep(node))
+            {
+                m_requests.emplace_back(node);
+            }
+        }
+
+        // Generate the closest chunks first, missing ones before out of date ones
+        sort(m_requests.begin(), m_requests.end(), [this](const Node& a, const Node& b)
+        {
+            const bool a_missing = !IsResident(a.level, a.x, a.y);
+            const bool b_missing = !IsResident(b.level, b.x, b.y);
+            return a_missing != b_missing ? a_missing : a.distance < b.distance;
+        });
+        for (const Node& node : m_requests)
+        {
+            if (m_jobs_in_flight.load() >= chunk_jobs_max)
+                break;
+
+            // A node can be requested more than once per selection
+            auto it = m_chunks.find(node.GetKey());
+            if (it != m_chunks.end() && it->second.is_building)
+                continue;
+
+            RequestChunk(node);
+        }
+
+        // Evict chunks which went unused for a while (the root never is)
+        for (auto it = m_chunks.begin(); it != m_chunks.end();)
+        {
+            Chunk& chunk = it->second;
+            if (it->first != 0 && !chunk.is_building && m_frame - chunk.frame_used > chunk_evict_frames)
+            {
+                if (chunk.vertex_buffer)
+                {
+                    m_chunks_retired.emplace_back(m_frame, move(chunk.vertex_buffer));
+                }
+                it = m_chunks.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        // Release the retired vertex buffers which no frame in flight can reference anymore, on a worker
+        {
+            vector<shared_ptr<RHI_VertexBuffer>> releasable;
+            for (auto it = m_chunks_retired.begin(); it != m_chunks_retired.end();)
+            {
+                if (m_frame - it->first > chunk_release_frames)
+                {
+                    releasable.emplace_back(move(it->second));
+                    it = m_chunks_retired.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+
+            if (!releasable.empty())
+            {
+                m_threading->AddTask([releasable = move(releasable)]() mutable { releasable.clear(); });
+            }
+        }
+
+        // Patches to draw, with the index variant which stitches them to their coarser neighbours
+        m_patches.clear();
+        for (const Node& node : m_nodes)
+        {
+            const Chunk& chunk = m_chunks[node.GetKey()];
+            if (!chunk.vertex_buffer)
+                continue;
+
+            TerrainPatch& patch = m_patches.emplace_back();
+            patch.vertex_buffer = chunk.vertex_buffer.get();
+            patch.index_buffer  = m_index_buffer.get();
+            patch.index_offset  = m_index_offsets[node.edge_mask];
+            patch.index_count   = m_index_counts[node.edge_mask];
+            patch.aabb          = chunk.aabb.Transform(transform);
+        }
+    }
+
+    uint64_t TerrainQuadtree::GetMemoryUsage() const
+    {
+        uint64_t size = static_cast<uint64_t>(m_heights.size());
+        size += m_index_buffer ? m_index_buffer->GetSizeGpu() : 0;
+
+        for (const auto& it : m_chunks)
+        {
+            size += it.second.vertex_buffer ? it.second.vertex_buffer->GetSizeGpu() : 0;
+        }
+
+        return size;
+    }
+
+    BoundingBox TerrainQuadtree::GetBounds() const
+    {
+        return IsInitialized() ? GetNodeBounds(0, 0, 0) : BoundingBox();
+    }
+
+    void TerrainQuadtree::GenerateLowLodMesh(uint32_t level, vector<uint32_t>& indices, vector<RHI_Vertex_PosTexNorTan>& vertices) const
+    {
+        indices.clear();
+        vertices.clear();
+        if (!IsInitialized())
+            return;
+
+        level = Helper::Min(level, m_level_count - 1);
+        const uint32_t node_count   = 1 << level;
+        const uint32_t node_size    = patch_quads << (m_level_count - 1 - level);
+
+        vector<RHI_Vertex_PosTexNorTan> chunk_vertices;
+        BoundingBox aabb;
+        for (uint32_t y = 0; y < node_count; y++)
+        {
+            for (uint32_t x = 0; x < node_count; x++)
+            {
+                // Nodes past the height map (of a non power of two height map) have nothing to add
+                if (x * node_size >= m_width - 1 || y * node_size >= m_height - 1)
+                    continue;
+
+                GenerateChunk(Node{ level, x, y }, 0, chunk_vertices, aabb);
+
+                // Same winding and diagonal as the patches
+                const uint32_t vertex_offset = static_cast<uint32_t>(vertices.size());
+                for (uint32_t i = 0; i < patch_quads; i++)
+                {
+                    for (uint32_t j = 0; j < patch_quads; j++)
+                    {
+                        const uint32_t bottom_left  = vertex_offset + i * patch_vertices + j;
+                        const uint32_t bottom_right = bottom_left + 1;
+                        const uint32_t top_left     = bottom_left + patch_vertices;
+                        const uint32_t top_right    = top_left + 1;
+
+                        indices.insert(indices.end(), { bottom_right, bottom_left, top_left, bottom_right, top_left, top_right });
+                    }
+                }
+                vertices.insert(vertices.end(), chunk_vertices.begin(), chunk_vertices.end());
+            }
+        }
+    }
+
+    void TerrainQuadtree::GeneratePatch(uint32_t level, const uint32_t x, const uint32_t y, vector<RHI_Vertex_PosTexNorTan>& vertices, BoundingBox& aabb) const
+    {
+        vertices.clear();
+        if (!IsInitialized())
+            return;
+
+        level = Helper::Min(level, m_level_count - 1);
+        GenerateChunk(Node{ level, x, y }, 0, vertices, aabb);
+    }
+
+    void TerrainQuadtree::SelectLod(const Vector3& camera_position, const bool require_resident)
+    {
+        m_nodes.clear();
+        m_requests.clear();
+        SelectNode(0, 0, 0, camera_position, require_resident);
+    }
+
+    void TerrainQuadtree::SelectNode(const uint32_t level, const uint32_t x, const uint32_t y, const Vector3& camera_position, const bool require_resident)
+    {
+        // Skip nodes which are entirely outside of the height map (the quadtree is a power of two patches wide)
+        const uint32_t size = patch_quads << (m_level_count - 1 - level);
+        if (x * size >= m_width - 1 || y * size >= m_height - 1)
+            return;
+
+        // Distance to the node's bounding box
+        const BoundingBox bounds    = GetNodeBounds(level, x, y);
+        const Vector3 offset        = Vector3
+        (
+            Helper::Max(Helper::Max(bounds.GetMin().x - camera_position.x, camera_position.x - bounds.GetMax().x), 0.0f),
+            Helper::Max(Helper::Max(bounds.GetMin().y - camera_position.y, camera_position.y - bounds.GetMax().y), 0.0f),
+            Helper::Max(Helper::Max(bounds.GetMin().z - camera_position.z, camera_position.z - bounds.GetMax().z), 0.0f)
+        );
+        const float distance = offset.Length();
+
+        const bool can_split = level + 1 < m_level_count && m_forced_leaves.find(Node{ level, x, y }.GetKey()) == m_forced_leaves.end();
+        bool split = can_split && distance < split_distance * size;
+
+        // A node only splits once all of its children can be drawn, until then it's drawn itself and the children are requested
+        if (can_split && require_resident && distance < prefetch_distance * size)
+        {
+            for (uint32_t i = 0; i < 4; i++)
+            {
+                const uint32_t child_x = x * 2 + (i & 1);
+                const uint32_t child_y = y * 2 + (i >> 1);
+                const uint32_t child_size = size / 2;
+                if (child_x * child_size >= m_width - 1 || child_y * child_size >= m_height - 1)
+                    continue;
+
+                if (!IsResident(level + 1, child_x, child_y))
+                {
+                    split = false;
+
+                    // Requested with the distance of the parent, so that they are ordered (and morphed) by it
+                    auto it = m_chunks.find(Node{ level + 1, child_x, child_y }.GetKey());
+                    if (it == m_chunks.end() || !it->second.is_building)
+                    {
+                        m_requests.emplace_back(Node{ level + 1, child_x, child_y, 0, distance });
+                    }
+                }
+            }
+        }
+
+        if (split)
+        {
+            SelectNode(level + 1, x * 2,     y * 2,     camera_position, require_resident);
+            SelectNode(level + 1, x * 2 + 1, y * 2,     camera_position, require_resident);
+            SelectNode(level + 1, x * 2,     y * 2 + 1, camera_position, require_resident);
+            SelectNode(level + 1, x * 2 + 1, y * 2 + 1, camera_position, require_resident);
+        }
+        else
+        {
+            m_nodes.emplace_back(Node{ level, x, y, 0, distance });
+        }
+    }
+
+    bool TerrainQuadtree::Balance()
+    {
+        // Rasterize the selection into a grid of the finest level's cells
+        const uint32_t cells = 1 << (m_level_count - 1);
+        m_level_grid.assign(static_cast<size_t>(cells) * cells, level_grid_empty);
+        for (const Node& node : m_nodes)
+        {
+            const uint32_t node_cells = cells >> node.level;
+            for (uint32_t y = node.y * node_cells; y < (node.y + 1) * node_cells; y++)
+            {
+                memset(&m_level_grid[static_cast<size_t>(y) * cells + node.x * node_cells], static_cast<int>(node.level), node_cells);
+            }
+        }
+
+        // Along every edge, the coarsest neighbour is the one that counts
+        auto coarsest_neighbour = [this, cells](const Node& node, const uint32_t edge)
+        {
+            const uint32_t node_cells   = cells >> node.level;
+            const uint32_t x_start      = node.x * node_cells;
+            const uint32_t y_start      = node.y * node_cells;
+            uint8_t level               = level_grid_empty;
+
+            for (uint32_t i = 0; i < node_cells; i++)
+            {
+                uint32_t x = 0;
+                uint32_t y = 0;
+                if (edge == edge_neg_x)      { if (x_start == 0) break;                   x = x_start - 1;          y = y_start + i; }
+                else if (edge == edge_pos_x) { if (x_start + node_cells == cells) break;  x = x_start + node_cells; y = y_start + i; }
+                else if (edge == edge_neg_y) { if (y_start == 0) break;                   x = x_start + i;          y = y_start - 1; }
+                else                         { if (y_start + node_cells == cells) break;  x = x_start + i;          y = y_start + node_cells; }
+
+                level = Helper::Min(level, m_level_grid[static_cast<size_t>(y) * cells + x]);
+            }
+
+            return level;
+        };
+
+        // Nodes which are two or more levels finer than a neighbour are replaced by the ancestor one level finer than it.
+        // That ancestor has been resident since it split, as long as the node is selected.
+        bool changed = false;
+        for (Node& node : m_nodes)
+        {
+            for (const uint32_t edge : { edge_neg_x, edge_pos_x, edge_neg_y, edge_pos_y })
+            {
+                const uint8_t level = coarsest_neighbour(node, edge);
+                if (level == level_grid_empty || node.level <= static_cast<uint32_t>(level) + 1)
+                    continue;
+
+                const uint32_t ancestor_level   = level + 1;
+                const uint32_t shift            = node.level - ancestor_level;
+                changed |= m_forced_leaves.emplace(Node{ ancestor_level, node.x >> shift, node.y >> shift }.GetKey()).second;
+            }
+        }
+
+        return changed;
+    }
+
+    void TerrainQuadtree::ComputeEdgeMasks()
+    {
+        // The grid matches the selection, as the last balancing pass didn't change anything
+        const uint32_t cells = 1 << (m_level_count - 1);
+        for (Node& node : m_nodes)
+        {
+            const uint32_t node_cells   = cells >> node.level;
+            const uint32_t x_start      = node.x * node_cells;
+            const uint32_t y_start      = node.y * node_cells;
+
+            // A coarser neighbour covers the whole edge, so one cell tells
+            auto is_coarser = [this, &node, cells](const uint32_t x, const uint32_t y)
+            {
+                const uint8_t level = m_level_grid[static_cast<size_t>(y) * cells + x];
+                return level != level_grid_empty && level < node.level;
+            };
+
+            node.edge_mask = 0;
+            if (x_start != 0                    && is_coarser(x_start - 1, y_start))            node.edge_mask |= edge_neg_x;
+            if (x_start + node_cells != cells   && is_coarser(x_start + node_cells, y_start))   node.edge_mask |= edge_pos_x;
+            if (y_start != 0                    && is_coarser(x_start, y_start - 1))            node.edge_mask |= edge_neg_y;
+            if (y_start + node_cells != cells   && is_coarser(x_start, y_start + node_cells))   node.edge_mask |= edge_pos_y;
+        }
+    }
+
+    BoundingBox TerrainQuadtree::GetNodeBounds(const uint32_t level, const uint32_t x, const uint32_t y) const
+    {
+        const uint32_t size                         = patch_quads << (m_level_count - 1 - level);
+        const pair<uint8_t, uint8_t>& height_bounds = m_height_bounds[level][static_cast<size_t>(y) * (1 << level) + x];
+
+        const float x_min = static_cast<float>(x * size) - m_width * 0.5f;
+        const float y_min = static_cast<float>(y * size) - m_height * 0.5f;
+        const float x_max = static_cast<float>(Helper::Min((x + 1) * size, m_width - 1)) - m_width * 0.5f;
+        const float y_max = static_cast<float>(Helper::Min((y + 1) * size, m_height - 1)) - m_height * 0.5f;
+
+        return BoundingBox
+        (
+            Vector3(x_min, Helper::Lerp(m_min_y, m_max_y, height_bounds.first / 255.0f), y_min),
+            Vector3(x_max, Helper::Lerp(m_min_y, m_max_y, height_bounds.second / 255.0f), y_max)
+        );
+    }
+
+    uint32_t TerrainQuadtree::GetMorphStep(const Node& node) const
+    {
+        // The root has nothing to morph into
+        if (node.level == 0)
+            return 0;
+
+        // The parent stops splitting when the camera is twice the split distance away from it, by then the morph is complete
+        const float size    = static_cast<float>(patch_quads << (m_level_count - 1 - node.level));
+        const float morph   = Helper::Saturate((node.distance - morph_start * size) / ((2.0f * split_distance - morph_start) * size));
+
+        return static_cast<uint32_t>(morph * morph_steps + 0.5f);
+    }
+
+    bool TerrainQuadtree::IsResident(const uint32_t level, const uint32_t x, const uint32_t y) const
+    {
+        auto it = m_chunks.find(Node{ level, x, y }.GetKey());
+        return it != m_chunks.end() && it->second.vertex_buffer;
+    }
+
+    bool TerrainQuadtree::SetHeights(vector<uint8_t>&& heights, const uint32_t width, const uint32_t height, const float min_y, const float max_y)
+    {
+        if (width < 2 || height < 2 || heights.size() < static_cast<size_t>(width) * height)
+        {
+            LOG_ERROR_INVALID_PARAMETER();
+            return false;
+        }
+
+        m_heights   = move(heights);
+        m_width     = width;
+        m_height    = height;
+        m_min_y     = min_y;
+        m_max_y     = max_y;
+
+        // Enough levels for the root to cover the height map, the finest level samples every texel
+        m_level_count = 1;
+        for (uint32_t size = patch_quads; size < Helper::Max(m_width, m_height) - 1; size *= 2)
+        {
+            m_level_count++;
+        }
+
+        GenerateHeightBounds();
+
+        return true;
+    }
+
+    void TerrainQuadtree::GenerateHeightBounds()
+    {
+        m_height_bounds.resize(m_level_count);
+
+        // Finest level, from the samples of every patch (nodes outside of the height map get empty bounds)
+        const uint32_t finest   = m_level_count - 1;
+        const uint32_t cells    = 1 << finest;
+        m_height_bounds[finest].assign(static_cast<size_t>(cells) * cells, make_pair<uint8_t, uint8_t>(255, 0));
+        auto compute_rows = [this, finest, cells](const uint32_t row_start, const uint32_t row_end)
+        {
+            for (uint32_t node_y = row_start; node_y < row_end; node_y++)
+            {
+                const uint32_t y_start = node_y * patch_quads;
+                if (y_start >= m_height - 1)
+                    continue;
+
+                for (uint32_t node_x = 0; node_x < cells; node_x++)
+                {
+                    const uint32_t x_start = node_x * patch_quads;
+                    if (x_start >= m_width - 1)
+                        continue;
+
+                    pair<uint8_t, uint8_t>& bounds = m_height_bounds[finest][static_cast<size_t>(node_y) * cells + node_x];
+                    for (uint32_t y = y_start; y <= Helper::Min(y_start + patch_quads, m_height - 1); y++)
+                    {
+                        for (uint32_t x = x_start; x <= Helper::Min(x_start + patch_quads, m_width - 1); x++)
+                        {
+                            const uint8_t sample    = m_heights[static_cast<size_t>(y) * m_width + x];
+                            bounds.first            = Helper::Min(bounds.first, sample);
+                            bounds.second           = Helper::Max(bounds.second, sample);
+                        }
+                    }
+                }
+            }
+        };
+        m_threading->AddTaskLoop(compute_rows, cells);
+
+        // Every coarser level bounds its four children
+        for (uint32_t level = finest; level-- > 0;)
+        {
+            const uint32_t nodes = 1 << level;
+            m_height_bounds[level].assign(static_cast<size_t>(nodes) * nodes, make_pair<uint8_t, uint8_t>(255, 0));
+
+            for (uint32_t y = 0; y < nodes; y++)
+            {
+                for (uint32_t x = 0; x < nodes; x++)
+                {
+                    pair<uint8_t, uint8_t>& bounds = m_height_bounds[level][static_cast<size_t>(y) * nodes + x];
+                    for (uint32_t i = 0; i < 4; i++)
+                    {
+                        const pair<uint8_t, uint8_t>& child = m_height_bounds[level + 1][static_cast<size_t>(y * 2 + (i >> 1)) * nodes * 2 + x * 2 + (i & 1)];
+                        bounds.first    = Helper::Min(bounds.first, child.first);
+                        bounds.second   = Helper::Max(bounds.second, child.second);
+                    }
+                }
+            }
+        }
+    }
+
+    void TerrainQuadtree::GenerateIndexVariants()
+    {
+        // One index variant per combination of edges facing a coarser neighbour. On such an edge, every odd vertex collapses
+        // onto the previous (even) one, so the edge matches the neighbour's and the triangles touching both become degenerate.
+        vector<uint16_t> indices;
+        for (uint32_t mask = 0; mask < 16; mask++)
+        {
+            auto index = [mask](uint32_t x, uint32_t y)
+            {
+                if ((mask & edge_neg_x) && x == 0 && (y & 1))                 y--;
+                else if ((mask & edge_pos_x) && x == patch_quads && (y & 1))  y--;
+                else if ((mask & edge_neg_y) && y == 0 && (x & 1))            x--;
+                else if ((mask & edge_pos_y) && y == patch_quads && (x & 1))  x--;
+
+                return static_cast<uint16_t>(y * patch_vertices + x);
+            };
+
+            auto add_triangle = [&indices](const uint16_t a, const uint16_t b, const uint16_t c)
+            {
+                if (a == b || b == c || a == c)
+                    return;
+
+                indices.emplace_back(a);
+                indices.emplace_back(b);
+                indices.emplace_back(c);
+            };
+
+            m_index_offsets[mask] = static_cast<uint32_t>(indices.size());
+            for (uint32_t y = 0; y < patch_quads; y++)
+            {
+                for (uint32_t x = 0; x < patch_quads; x++)
+                {
+                    const uint16_t bottom_left  = index(x, y);
+                    const uint16_t bottom_right = index(x + 1, y);
+                    const uint16_t top_left     = index(x, y + 1);
+                    const uint16_t top_right    = index(x + 1, y + 1);
+
+                    // Same winding and diagonal as the rest of the terrain (the morph depends on the diagonal)
+                    add_triangle(bottom_right, bottom_left, top_left);
+                    add_triangle(bottom_right, top_left, top_right);
+                }
+            }
+            m_index_counts[mask] = static_cast<uint32_t>(indices.size()) - m_index_offsets[mask];
+        }
+
+        m_index_buffer = make_shared<RHI_IndexBuffer>(m_rhi_device);
+        if (!m_index_buffer->Create(indices))
+        {
+            LOG_ERROR("Failed to create the terrain's index buffer");
+            m_index_buffer.reset();
+        }
+    }
+
+    void TerrainQuadtree::GenerateChunk(const Node& node, const uint32_t morph_step, vector<RHI_Vertex_PosTexNorTan>& vertices, BoundingBox& aabb) const
+    {
+        const int32_t stride    = 1 << (m_level_count - 1 - node.level);
+        const int32_t x_start   = static_cast<int32_t>(node.x * patch_quads) * stride;
+        const int32_t y_start   = static_cast<int32_t>(node.y * patch_quads) * stride;
+        const float morph       = static_cast<float>(morph_step) / static_cast<float>(morph_steps);
+
+        auto height = [this, x_start, y_start, stride](const int32_t x, const int32_t y)
+        {
+            return GetHeight(x_start + x * stride, y_start + y * stride);
+        };
+
+        vertices.resize(patch_vertices * patch_vertices);
+        for (int32_t y = 0; y < static_cast<int32_t>(patch_vertices); y++)
+        {
+            for (int32_t x = 0; x < static_cast<int32_t>(patch_vertices); x++)
+            {
+                // Samples past the height map (the last patches of a non power of two height map) collapse onto its edge
+                const int32_t sample_x  = Helper::Min(x_start + x * stride, static_cast<int32_t>(m_width) - 1);
+                const int32_t sample_y  = Helper::Min(y_start + y * stride, static_cast<int32_t>(m_height) - 1);
+                float sample_height     = GetHeight(sample_x, sample_y);
+
+                // Vertices the parent doesn't have move towards the parent's surface. Edge vertices are excluded, as
+                // the neighbour might have been generated with a different morph (or they are stitched to a coarser one).
+                const bool is_edge = x == 0 || y == 0 || x == patch_quads || y == patch_quads;
+                if (morph > 0.0f && !is_edge && ((x & 1) || (y & 1)))
+                {
+                    float parent_height = 0.0f;
+                    if ((x & 1) && (y & 1)) parent_height = (height(x + 1, y - 1) + height(x - 1, y + 1)) * 0.5f; // on the parent's diagonal
+                    else if (x & 1)         parent_height = (height(x - 1, y) + height(x + 1, y)) * 0.5f;
+                    else                    parent_height = (height(x, y - 1) + height(x, y + 1)) * 0.5f;
+
+                    sample_height = Helper::Lerp(sample_height, parent_height, morph);
+                }
+
+                // Normals and tangents come from the full resolution neighbours, so they don't change with the level
+                const int32_t x_left    = Helper::Max(sample_x - 1, 0);
+                const int32_t x_right   = Helper::Min(sample_x + 1, static_cast<int32_t>(m_width) - 1);
+                const int32_t y_down    = Helper::Max(sample_y - 1, 0);
+                const int32_t y_up      = Helper::Min(sample_y + 1, static_cast<int32_t>(m_height) - 1);
+                // A height map one sample wide (or tall) has no neighbours along that axis, it's flat there
+                const float slope_x     = (GetHeight(x_right, sample_y) - GetHeight(x_left, sample_y)) / static_cast<float>(Helper::Max(x_right - x_left, 1));
+                const float slope_z     = (GetHeight(sample_x, y_up) - GetHeight(sample_x, y_down)) / static_cast<float>(Helper::Max(y_up - y_down, 1));
+                const float normal_length   = 1.0f / sqrt(slope_x * slope_x + 1.0f + slope_z * slope_z);
+                const float tangent_length  = 1.0f / sqrt(1.0f + slope_x * slope_x);
+
+                vertices[y * patch_vertices + x] = RHI_Vertex_PosTexNorTan
+                (
+                    Vector3(static_cast<float>(sample_x) - m_width * 0.5f, sample_height, static_cast<float>(sample_y) - m_height * 0.5f),
+                    Vector2(static_cast<float>(sample_x), static_cast<float>(sample_y)),
+                    Vector3(-slope_x * normal_length, normal_length, -slope_z * normal_length),
+                    Vector3(tangent_length, slope_x * tangent_length, 0.0f)
+                );
+            }
+        }
+
+        aabb = BoundingBox(vertices.data(), static_cast<uint32_t>(vertices.size()));
+    }
+
+    void TerrainQuadtree::RequestChunk(const Node& node)
+    {
+        const uint64_t key  = node.GetKey();
+        Chunk& chunk        = m_chunks[key];
+        chunk.is_building   = true;
+        chunk.frame_used    = m_frame;
+
+        const uint32_t morph_step = GetMorphStep(node);
+        m_jobs_in_flight++;
+        m_threading->AddTask([this, node, key, morph_step]()
+        {
+            ChunkResult result;
+            result.key          = key;
+            result.morph_step   = morph_step;
+
+            vector<RHI_Vertex_PosTexNorTan> vertices;
+            GenerateChunk(node, morph_step, vertices, result.aabb);
+
+            result.vertex_buffer = make_shared<RHI_VertexBuffer>(m_rhi_device);
+            if (!result.vertex_buffer->Create(vertices))
+            {
+                LOG_ERROR("Failed to create the vertex buffer of a terrain chunk");
+                result.vertex_buffer.reset();
+            }
+
+            {
+                lock_guard<mutex> lock(m_mutex_results);
+                m_chunk_results.emplace_back(move(result));
+            }
+
+            m_jobs_in_flight--;
+        });
+    }
+
+    float TerrainQuadtree::GetHeight(const int32_t x, const int32_t y) const
+    {
+        const int32_t sample_x = Helper::Clamp(x, 0, static_cast<int32_t>(m_width) - 1);
+        const int32_t sample_y = Helper::Clamp(y, 0, static_cast<int32_t>(m_height) - 1);
+
+        return Helper::Lerp(m_min_y, m_max_y, m_heights[static_cast<size_t>(sample_y) * m_width + sample_x] / 255.0f);
+    }
+}
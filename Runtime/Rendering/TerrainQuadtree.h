@@ -0,0 +1,165 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+//= INCLUDES ======================
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+#include <unordered_set>
+#include "../Math/BoundingBox.h"
+#include "../RHI/RHI_Definition.h"
+#include "../Core/EngineDefs.h"
+//==================================
+
+namespace Spartan
+{
+    // Forward declarations
+    class Threading;
+
+    // A patch the quadtree selected for drawing this frame
+    struct TerrainPatch
+    {
+        const RHI_VertexBuffer* vertex_buffer   = nullptr;
+        const RHI_IndexBuffer* index_buffer     = nullptr;
+        uint32_t index_offset                   = 0;
+        uint32_t index_count                    = 0;
+        Math::BoundingBox aabb;                 // world space
+    };
+
+    // Splits a height map into fixed size patches, organised as a quadtree where every level halves the sample spacing.
+    // The patches are selected by distance to the camera, generated and evicted on background tasks, morphed towards
+    // their parent's shape before they merge into it and stitched to coarser neighbours, so no single mesh ever holds the whole terrain.
+    class SPARTAN_CLASS TerrainQuadtree
+    {
+    public:
+        TerrainQuadtree(Threading* threading, const std::shared_ptr<RHI_Device>& rhi_device);
+        ~TerrainQuadtree();
+
+        // Takes one height sample (0 to 255) per texel, row major, and generates the root patch
+        bool Initialize(std::vector<uint8_t>&& heights, uint32_t width, uint32_t height, float min_y, float max_y);
+
+        // Selects the patches around the camera (in the terrain's space), requests missing ones and evicts the ones which went unused for a while
+        void Update(const Math::Vector3& camera_position, const Math::Matrix& transform, uint64_t frame);
+
+        const auto& GetPatches()            const { return m_patches; }
+        uint32_t GetChunkCount()            const { return static_cast<uint32_t>(m_chunks.size()); }
+        uint32_t GetChunkJobCount()         const { return m_jobs_in_flight.load(); }
+        uint32_t GetLevelCount()            const { return m_level_count; }
+        uint64_t GetMemoryUsage()           const;
+        bool IsInitialized()                const { return m_level_count != 0; }
+
+        // Bounds of the whole height map, in the terrain's space
+        Math::BoundingBox GetBounds() const;
+
+        // The unmorphed patches of every node of a coarse level, as a single mesh. The selected patches only cover the terrain
+        // around the camera, so this stands in for them wherever the geometry is needed on the CPU (colliders and picking).
+        void GenerateLowLodMesh(uint32_t level, std::vector<uint32_t>& indices, std::vector<RHI_Vertex_PosTexNorTan>& vertices) const;
+        // The unmorphed vertices of a single node, the same as the patch which is streamed in for it
+        void GeneratePatch(uint32_t level, uint32_t x, uint32_t y, std::vector<RHI_Vertex_PosTexNorTan>& vertices, Math::BoundingBox& aabb) const;
+
+        // Quads along the side of a patch, the same at every level
+        static const uint32_t patch_quads = 32;
+
+    private:
+        // A node of the quadtree, level 0 is the root and covers the whole height map
+        struct Node
+        {
+            uint32_t level      = 0;
+            uint32_t x          = 0;
+            uint32_t y          = 0;
+            uint32_t edge_mask  = 0; // edges which face a coarser neighbour (-x, +x, -y, +y)
+            float distance      = 0.0f;
+
+            uint64_t GetKey() const { return (static_cast<uint64_t>(level) << 48) | (static_cast<uint64_t>(y) << 24) | static_cast<uint64_t>(x); }
+        };
+
+        // The generated geometry of a node
+        struct Chunk
+        {
+            std::shared_ptr<RHI_VertexBuffer> vertex_buffer;
+            Math::BoundingBox aabb;         // terrain space
+            uint32_t morph_step = 0;        // the morph the vertices were generated with
+            uint64_t frame_used = 0;
+            bool is_building    = false;
+        };
+
+        struct ChunkResult
+        {
+            uint64_t key = 0;
+            std::shared_ptr<RHI_VertexBuffer> vertex_buffer;
+            Math::BoundingBox aabb;
+            uint32_t morph_step = 0;
+        };
+
+        // Selection
+        void SelectLod(const Math::Vector3& camera_position, bool require_resident);
+        void SelectNode(uint32_t level, uint32_t x, uint32_t y, const Math::Vector3& camera_position, bool require_resident);
+        bool Balance();
+        void ComputeEdgeMasks();
+        Math::BoundingBox GetNodeBounds(uint32_t level, uint32_t x, uint32_t y) const;
+        uint32_t GetMorphStep(const Node& node) const;
+        bool IsResident(uint32_t level, uint32_t x, uint32_t y) const;
+
+        // Generation
+        bool SetHeights(std::vector<uint8_t>&& heights, uint32_t width, uint32_t height, float min_y, float max_y);
+        void GenerateHeightBounds();
+        void GenerateIndexVariants();
+        void GenerateChunk(const Node& node, uint32_t morph_step, std::vector<RHI_Vertex_PosTexNorTan>& vertices, Math::BoundingBox& aabb) const;
+        void RequestChunk(const Node& node);
+        float GetHeight(int32_t x, int32_t y) const;
+
+        // Height map
+        std::vector<uint8_t> m_heights;
+        uint32_t m_width    = 0;
+        uint32_t m_height   = 0;
+        float m_min_y       = 0.0f;
+        float m_max_y       = 0.0f;
+
+        // Quadtree
+        uint32_t m_level_count = 0;
+        std::vector<std::vector<std::pair<uint8_t, uint8_t>>> m_height_bounds;  // min and max height sample of every node, per level
+        std::vector<Node> m_nodes;                                              // the selection
+        std::vector<uint8_t> m_level_grid;                                      // level of the selected node which covers each finest level cell
+        std::vector<Node> m_requests;                                           // nodes whose chunk is missing or out of date
+        std::unordered_set<uint64_t> m_forced_leaves;                           // nodes which mustn't split, so that neighbours differ by one level at most
+        std::vector<TerrainPatch> m_patches;
+
+        // Chunks
+        std::unordered_map<uint64_t, Chunk> m_chunks;
+        std::vector<ChunkResult> m_chunk_results;
+        std::vector<std::pair<uint64_t, std::shared_ptr<RHI_VertexBuffer>>> m_chunks_retired; // frame of retirement, buffer
+        std::shared_ptr<RHI_IndexBuffer> m_index_buffer;
+        uint32_t m_index_offsets[16]            = {};
+        uint32_t m_index_counts[16]             = {};
+        std::atomic<uint32_t> m_jobs_in_flight  = 0;
+        std::mutex m_mutex_results;
+        uint64_t m_frame                        = 0;
+
+        // Dependencies
+        Threading* m_threading = nullptr;
+        std::shared_ptr<RHI_Device> m_rhi_device;
+    };
+}
@@ -0,0 +1,651 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ======================
+#include "AssetIndex.h"
+#include <filesystem>
+#include <algorithm>
+#include <unordered_set>
+#include "../Logging/Log.h"
+#include "../Threading/Threading.h"
+#include <Windows.h>
+//=================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    static const float poll_interval_ms = 1000.0f; // how often directory write times are checked, when the root can't be watched
+
+    // The contents of a single directory, as found on disk
+    struct DirectoryListing
+    {
+        vector<string> files;
+        vector<string> directories;
+        uint64_t write_time = 0;
+    };
+
+    static void list_directory(const string& path, DirectoryListing& listing)
+    {
+        error_code error;
+        for (filesystem::directory_iterator it(path, error), it_end; !error && it != it_end; it.increment(error))
+        {
+            string name;
+
+            // A system_error is possible if the characters are
+            // something that can't be converted, like Russian.
+            try
+            {
+                name = it->path().filename().string();
+            }
+            catch (system_error& e)
+            {
+                LOG_WARNING("Failed to read a path. %s", e.what());
+                continue;
+            }
+
+            error_code error_type;
+            if (it->is_directory(error_type))
+            {
+                listing.directories.emplace_back(path + "/" + name);
+            }
+            else if (it->is_regular_file(error_type))
+            {
+                listing.files.emplace_back(path + "/" + name);
+            }
+        }
+
+        listing.write_time = FileSystem::GetLastWriteTime(path);
+    }
+
+    struct AssetIndex::Watcher
+    {
+        HANDLE directory        = INVALID_HANDLE_VALUE;
+        OVERLAPPED overlapped   = {};
+        bool reading            = false;
+        DWORD buffer[16 * 1024]; // 64 KB (the most network shares accept), DWORD aligned as ReadDirectoryChangesW requires
+    };
+
+    AssetIndex::AssetIndex(Threading* threading)
+    {
+        m_threading = threading;
+    }
+
+    AssetIndex::~AssetIndex()
+    {
+        Clear();
+    }
+
+    bool AssetIndex::Scan(const string& root)
+    {
+        Clear();
+        m_root = Normalize(root);
+        if (!FileSystem::IsDirectory(m_root))
+        {
+            LOG_ERROR("\"%s\" is not a directory", m_root.c_str());
+            return false;
+        }
+
+        // Changes made while scanning are applied afterwards, they are either already in the index or not seen by the scan
+        if (!StartWatching())
+        {
+            LOG_WARNING("Failed to watch \"%s\", changes will be picked up by polling", m_root.c_str());
+        }
+
+        // Directories are listed a level at a time, each level split across the job system's threads.
+        // Listing is what touches the disk, so it's the only part that runs in parallel.
+        unordered_map<string, DirectoryListing> listings;
+        vector<string> level = { m_root };
+        while (!level.empty())
+        {
+            vector<DirectoryListing> level_listings(level.size());
+            const auto list = [&level, &level_listings](const uint32_t start, const uint32_t end)
+            {
+                for (uint32_t i = start; i < end; i++)
+                {
+                    list_directory(level[i], level_listings[i]);
+                }
+            };
+
+            if (m_threading)
+            {
+                m_threading->AddTaskLoop(list, static_cast<uint32_t>(level.size()));
+            }
+            else
+            {
+                list(0, static_cast<uint32_t>(level.size()));
+            }
+
+            vector<string> level_next;
+            for (uint32_t i = 0; i < static_cast<uint32_t>(level.size()); i++)
+            {
+                level_next.insert(level_next.end(), level_listings[i].directories.begin(), level_listings[i].directories.end());
+                listings[level[i]] = move(level_listings[i]);
+            }
+            level = move(level_next);
+        }
+
+        // Build the index from the root down, sorted, so that it doesn't depend on which worker listed what
+        vector<string> stack = { m_root };
+        while (!stack.empty())
+        {
+            const string path = move(stack.back());
+            stack.pop_back();
+
+            auto it = listings.find(path);
+            if (it == listings.end())
+                continue;
+
+            DirectoryListing& listing = it->second;
+            sort(listing.files.begin(), listing.files.end());
+            sort(listing.directories.rbegin(), listing.directories.rend());
+
+            AddDirectory(path, listing.write_time);
+            for (const string& file : listing.files)
+            {
+                AddFile(file);
+            }
+            stack.insert(stack.end(), listing.directories.begin(), listing.directories.end());
+        }
+
+        return true;
+    }
+
+    void AssetIndex::Poll()
+    {
+        if (m_root.empty())
+            return;
+
+        if (m_watcher)
+        {
+            ApplyChanges();
+        }
+        else
+        {
+            PollWriteTimes();
+        }
+    }
+
+    bool AssetIndex::IsIndexed(const string& directory) const
+    {
+        return m_directory_lookup.count(Normalize(directory)) != 0;
+    }
+
+    bool AssetIndex::Contains(const string& file_path) const
+    {
+        return m_file_lookup.count(Normalize(file_path)) != 0;
+    }
+
+    File_Type AssetIndex::GetFileType(const string& file_path) const
+    {
+        const auto it = m_file_lookup.find(Normalize(file_path));
+        return it != m_file_lookup.end() ? m_files[it->second].type : File_Unknown;
+    }
+
+    vector<string> AssetIndex::GetFiles(const File_Type type) const
+    {
+        vector<string> paths;
+        paths.reserve(m_files_by_type[type].size());
+        for (const uint32_t index : m_files_by_type[type])
+        {
+            paths.emplace_back(m_files[index].path);
+        }
+
+        return paths;
+    }
+
+    vector<string> AssetIndex::GetFilesInDirectory(const string& directory) const
+    {
+        vector<string> paths;
+        const auto it = m_directory_lookup.find(Normalize(directory));
+        if (it == m_directory_lookup.end())
+            return paths;
+
+        const Directory& dir = m_directories[it->second];
+        paths.reserve(dir.files.size());
+        for (const uint32_t index : dir.files)
+        {
+            paths.emplace_back(m_files[index].path);
+        }
+
+        return paths;
+    }
+
+    vector<string> AssetIndex::GetFilesInDirectory(const string& directory, const File_Type type) const
+    {
+        vector<string> paths;
+        const auto it = m_directory_lookup.find(Normalize(directory));
+        if (it == m_directory_lookup.end())
+            return paths;
+
+        for (const uint32_t index : m_directories[it->second].files)
+        {
+            if (m_files[index].type == type)
+            {
+                paths.emplace_back(m_files[index].path);
+            }
+        }
+
+        return paths;
+    }
+
+    vector<string> AssetIndex::GetDirectoriesInDirectory(const string& directory) const
+    {
+        vector<string> paths;
+        const auto it = m_directory_lookup.find(Normalize(directory));
+        if (it == m_directory_lookup.end())
+            return paths;
+
+        const Directory& dir = m_directories[it->second];
+        paths.reserve(dir.directories.size());
+        for (const uint32_t index : dir.directories)
+        {
+            paths.emplace_back(m_directories[index].path);
+        }
+
+        return paths;
+    }
+
+    void AssetIndex::Clear()
+    {
+        StopWatching();
+
+        m_files.clear();
+        m_files_free.clear();
+        m_directories.clear();
+        m_directories_free.clear();
+        m_file_lookup.clear();
+        m_directory_lookup.clear();
+        for (auto& files : m_files_by_type)
+        {
+            files.clear();
+        }
+    }
+
+    string AssetIndex::Normalize(const string& path)
+    {
+        string normalized = path;
+        replace(normalized.begin(), normalized.end(), '\\', '/');
+        while (normalized.size() > 1 && normalized.back() == '/')
+        {
+            normalized.pop_back();
+        }
+
+        return normalized;
+    }
+
+    uint32_t AssetIndex::AddDirectory(const string& path, const uint64_t write_time)
+    {
+        const auto it = m_directory_lookup.find(path);
+        if (it != m_directory_lookup.end())
+            return it->second;
+
+        // Directories outside of the root, or whose parent isn't indexed yet, are ignored
+        const size_t separator      = path.find_last_of('/');
+        const auto it_parent        = separator != string::npos ? m_directory_lookup.find(path.substr(0, separator)) : m_directory_lookup.end();
+        const bool is_root          = path == m_root;
+        if (!is_root && it_parent == m_directory_lookup.end())
+            return 0;
+
+        uint32_t index = static_cast<uint32_t>(m_directories.size());
+        if (!m_directories_free.empty())
+        {
+            index = m_directories_free.back();
+            m_directories_free.pop_back();
+        }
+        else
+        {
+            m_directories.emplace_back();
+        }
+
+        Directory& directory    = m_directories[index];
+        directory               = Directory();
+        directory.path          = path;
+        directory.write_time    = write_time;
+        directory.parent        = is_root ? index : it_parent->second;
+        if (!is_root)
+        {
+            Directory& parent       = m_directories[directory.parent];
+            directory.slot_parent   = static_cast<uint32_t>(parent.directories.size());
+            parent.directories.emplace_back(index);
+        }
+
+        m_directory_lookup[path] = index;
+
+        return index;
+    }
+
+    void AssetIndex::AddFile(const string& path)
+    {
+        if (m_file_lookup.count(path))
+            return;
+
+        const size_t separator  = path.find_last_of('/');
+        const auto it_directory = separator != string::npos ? m_directory_lookup.find(path.substr(0, separator)) : m_directory_lookup.end();
+        if (it_directory == m_directory_lookup.end())
+            return;
+
+        uint32_t index = static_cast<uint32_t>(m_files.size());
+        if (!m_files_free.empty())
+        {
+            index = m_files_free.back();
+            m_files_free.pop_back();
+        }
+        else
+        {
+            m_files.emplace_back();
+        }
+
+        File& file              = m_files[index];
+        Directory& directory    = m_directories[it_directory->second];
+        file.path               = path;
+        file.type               = FileSystem::GetFileType(path);
+        file.directory          = it_directory->second;
+        file.slot_directory     = static_cast<uint32_t>(directory.files.size());
+        file.slot_type          = static_cast<uint32_t>(m_files_by_type[file.type].size());
+        directory.files.emplace_back(index);
+        m_files_by_type[file.type].emplace_back(index);
+
+        m_file_lookup[path] = index;
+    }
+
+    void AssetIndex::RemoveFile(const string& path)
+    {
+        const auto it = m_file_lookup.find(path);
+        if (it == m_file_lookup.end())
+            return;
+
+        const uint32_t index    = it->second;
+        File& file              = m_files[index];
+
+        // Swap with the last entry of each list, and let the moved file know where it went
+        vector<uint32_t>& in_directory      = m_directories[file.directory].files;
+        in_directory[file.slot_directory]   = in_directory.back();
+        m_files[in_directory.back()].slot_directory = file.slot_directory;
+        in_directory.pop_back();
+
+        vector<uint32_t>& of_type           = m_files_by_type[file.type];
+        of_type[file.slot_type]             = of_type.back();
+        m_files[of_type.back()].slot_type   = file.slot_type;
+        of_type.pop_back();
+
+        file.path.clear();
+        m_file_lookup.erase(it);
+        m_files_free.emplace_back(index);
+    }
+
+    void AssetIndex::RemoveDirectoryRecursive(const string& path)
+    {
+        const auto it = m_directory_lookup.find(path);
+        if (it == m_directory_lookup.end())
+            return;
+
+        const uint32_t index = it->second;
+
+        // Contents first, the lists change while removing so they are copied
+        const vector<uint32_t> files        = m_directories[index].files;
+        const vector<uint32_t> directories  = m_directories[index].directories;
+        for (const uint32_t file : files)
+        {
+            RemoveFile(m_files[file].path);
+        }
+        for (const uint32_t directory : directories)
+        {
+            RemoveDirectoryRecursive(m_directories[directory].path);
+        }
+
+        Directory& directory = m_directories[index];
+        if (directory.parent != index)
+        {
+            vector<uint32_t>& siblings                      = m_directories[directory.parent].directories;
+            siblings[directory.slot_parent]                 = siblings.back();
+            m_directories[siblings.back()].slot_parent      = directory.slot_parent;
+            siblings.pop_back();
+        }
+
+        m_directory_lookup.erase(directory.path);
+        directory = Directory();
+        m_directories_free.emplace_back(index);
+    }
+
+    void AssetIndex::ScanDirectory(const string& path)
+    {
+        DirectoryListing listing;
+        list_directory(path, listing);
+        sort(listing.files.begin(), listing.files.end());
+        sort(listing.directories.begin(), listing.directories.end());
+
+        AddDirectory(path, listing.write_time);
+        for (const string& file : listing.files)
+        {
+            AddFile(file);
+        }
+
+        for (const string& directory : listing.directories)
+        {
+            ScanDirectory(directory);
+        }
+    }
+
+    void AssetIndex::RefreshDirectory(const uint32_t index)
+    {
+        // Copied, since adding directories can move the entries around
+        const string path = m_directories[index].path;
+
+        DirectoryListing listing;
+        list_directory(path, listing);
+        m_directories[index].write_time = listing.write_time;
+
+        // Gone from disk
+        const unordered_set<string> files_on_disk(listing.files.begin(), listing.files.end());
+        const unordered_set<string> directories_on_disk(listing.directories.begin(), listing.directories.end());
+        for (const string& file : GetFilesInDirectory(path))
+        {
+            if (!files_on_disk.count(file))
+            {
+                RemoveFile(file);
+            }
+        }
+        for (const string& directory : GetDirectoriesInDirectory(path))
+        {
+            if (!directories_on_disk.count(directory))
+            {
+                RemoveDirectoryRecursive(directory);
+            }
+        }
+
+        // New on disk
+        sort(listing.files.begin(), listing.files.end());
+        for (const string& file : listing.files)
+        {
+            AddFile(file);
+        }
+        for (const string& directory : listing.directories)
+        {
+            if (!m_directory_lookup.count(directory))
+            {
+                ScanDirectory(directory);
+            }
+        }
+    }
+
+    void AssetIndex::PollWriteTimes()
+    {
+        if (m_poll_timer.GetElapsedTimeMs() < poll_interval_ms)
+            return;
+        m_poll_timer.Start();
+
+        // A directory's write time changes when entries are added, removed or renamed in it
+        vector<uint32_t> changed;
+        for (const auto& it : m_directory_lookup)
+        {
+            if (FileSystem::GetLastWriteTime(it.first) != m_directories[it.second].write_time)
+            {
+                changed.emplace_back(it.second);
+            }
+        }
+
+        for (const uint32_t index : changed)
+        {
+            // It might have been removed along with a parent that changed too
+            if (!m_directories[index].path.empty())
+            {
+                RefreshDirectory(index);
+            }
+        }
+    }
+
+    bool AssetIndex::StartWatching()
+    {
+        m_watcher               = make_unique<Watcher>();
+        m_watcher->directory    = CreateFileW
+        (
+            FileSystem::StringToWstring(m_root).c_str(),
+            FILE_LIST_DIRECTORY,
+            FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, // don't get in the way of whoever changes the files
+            nullptr,
+            OPEN_EXISTING,
+            FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,      // required for directories, and for asynchronous reads
+            nullptr
+        );
+        m_watcher->overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+
+        if (m_watcher->directory == INVALID_HANDLE_VALUE || !m_watcher->overlapped.hEvent || !ReadChanges())
+        {
+            StopWatching();
+            return false;
+        }
+
+        return true;
+    }
+
+    void AssetIndex::StopWatching()
+    {
+        if (!m_watcher)
+            return;
+
+        // A pending read writes into the buffer, so it has to be cancelled (and finished) before the buffer goes away
+        if (m_watcher->reading)
+        {
+            DWORD size = 0;
+            CancelIoEx(m_watcher->directory, &m_watcher->overlapped);
+            GetOverlappedResult(m_watcher->directory, &m_watcher->overlapped, &size, TRUE);
+        }
+
+        if (m_watcher->overlapped.hEvent)
+        {
+            CloseHandle(m_watcher->overlapped.hEvent);
+        }
+
+        if (m_watcher->directory != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(m_watcher->directory);
+        }
+
+        m_watcher.reset();
+    }
+
+    bool AssetIndex::ReadChanges()
+    {
+        // Names only, contents changing doesn't affect the index. While no read is pending, the changes are queued up by the system.
+        const DWORD filter  = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME;
+        m_watcher->reading  = ReadDirectoryChangesW(m_watcher->directory, m_watcher->buffer, sizeof(m_watcher->buffer), TRUE, filter, nullptr, &m_watcher->overlapped, nullptr) != 0;
+
+        return m_watcher->reading;
+    }
+
+    void AssetIndex::ApplyChanges()
+    {
+        while (m_watcher)
+        {
+            DWORD size = 0;
+            if (!GetOverlappedResult(m_watcher->directory, &m_watcher->overlapped, &size, FALSE))
+            {
+                // Nothing changed since the last poll
+                if (GetLastError() == ERROR_IO_INCOMPLETE)
+                    return;
+
+                LOG_WARNING("Stopped watching \"%s\", changes will be picked up by polling", m_root.c_str());
+                m_watcher->reading = false;
+                StopWatching();
+                return;
+            }
+            m_watcher->reading = false;
+
+            // A rescan starts watching anew
+            if (!ApplyNotifications(m_watcher->buffer, static_cast<uint32_t>(size)))
+                return;
+
+            if (!ReadChanges())
+            {
+                LOG_WARNING("Stopped watching \"%s\", changes will be picked up by polling", m_root.c_str());
+                StopWatching();
+            }
+        }
+    }
+
+    bool AssetIndex::ApplyNotifications(const void* buffer, const uint32_t size)
+    {
+        // The changes didn't fit in the buffer and were dropped, so the index can't be trusted anymore
+        if (size == 0)
+        {
+            LOG_WARNING("Too many file system changes at once, rescanning \"%s\"", m_root.c_str());
+            Scan(m_root);
+            return false;
+        }
+
+        const uint8_t* buffer_end = static_cast<const uint8_t*>(buffer) + size;
+        for (const uint8_t* entry = static_cast<const uint8_t*>(buffer); entry && entry + sizeof(FILE_NOTIFY_INFORMATION) <= buffer_end;)
+        {
+            const FILE_NOTIFY_INFORMATION* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(entry);
+            entry = info->NextEntryOffset != 0 ? entry + info->NextEntryOffset : nullptr;
+
+            // Relative to the root, in UTF-16 and not null terminated. Converted with the same code page as StringToWstring().
+            const int name_length_wide  = static_cast<int>(info->FileNameLength / sizeof(WCHAR));
+            const int name_length       = WideCharToMultiByte(CP_ACP, 0, info->FileName, name_length_wide, nullptr, 0, nullptr, nullptr);
+            string name(name_length, '\0');
+            WideCharToMultiByte(CP_ACP, 0, info->FileName, name_length_wide, &name[0], name_length, nullptr, nullptr);
+            const string path = m_root + "/" + Normalize(name);
+
+            // A renamed directory is reported once, as its old and new name, so its contents move with it
+            switch (info->Action)
+            {
+                case FILE_ACTION_ADDED:
+                case FILE_ACTION_RENAMED_NEW_NAME:
+                    FileSystem::IsDirectory(path) ? ScanDirectory(path) : AddFile(path);
+                    break;
+
+                case FILE_ACTION_REMOVED:
+                case FILE_ACTION_RENAMED_OLD_NAME:
+                    m_directory_lookup.count(path) ? RemoveDirectoryRecursive(path) : RemoveFile(path);
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,120 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+//= INCLUDES ====================
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "../Core/EngineDefs.h"
+#include "../Core/FileSystem.h"
+#include "../Core/Stopwatch.h"
+//===============================
+
+namespace Spartan
+{
+    class Threading;
+
+    // A persistent index of every file and directory under a root directory, so that browsing and filtering assets
+    // doesn't hit the disk or re-derive extensions. The initial scan runs on the job system. Afterwards the index is
+    // kept up to date incrementally, from the changes ReadDirectoryChangesW reports for the whole tree (or by polling
+    // directory write times, if the root can't be watched). Paths use forward slashes and no trailing slash.
+    // It's meant to be used from the main thread.
+    class SPARTAN_CLASS AssetIndex
+    {
+    public:
+        AssetIndex(Threading* threading);
+        ~AssetIndex();
+
+        // Replaces the index with a fresh scan of the given directory
+        bool Scan(const std::string& root);
+        // Applies the changes made on disk since the last poll
+        void Poll();
+        // Applies a buffer of FILE_NOTIFY_INFORMATION records, as ReadDirectoryChangesW fills it (names relative to the root).
+        // A size of 0 means that the changes overflowed the buffer, so the root is rescanned and false is returned.
+        bool ApplyNotifications(const void* buffer, uint32_t size);
+
+        // Queries, O(1) lookups and O(k) results
+        bool IsIndexed(const std::string& directory) const;
+        bool Contains(const std::string& file_path) const;
+        File_Type GetFileType(const std::string& file_path) const;
+        std::vector<std::string> GetFiles(File_Type type) const;
+        std::vector<std::string> GetFilesInDirectory(const std::string& directory) const;
+        std::vector<std::string> GetFilesInDirectory(const std::string& directory, File_Type type) const;
+        std::vector<std::string> GetDirectoriesInDirectory(const std::string& directory) const;
+        uint32_t GetFileCount()         const { return static_cast<uint32_t>(m_file_lookup.size()); }
+        uint32_t GetDirectoryCount()    const { return static_cast<uint32_t>(m_directory_lookup.size()); }
+        const std::string& GetRoot()    const { return m_root; }
+
+    private:
+        struct File
+        {
+            std::string path;
+            uint32_t directory      = 0;
+            uint32_t slot_type      = 0; // position in the list of its type
+            uint32_t slot_directory = 0; // position in its directory's list of files
+            File_Type type          = File_Unknown;
+        };
+
+        struct Directory
+        {
+            std::string path;
+            uint32_t parent         = 0;
+            uint32_t slot_parent    = 0; // position in its parent's list of directories
+            uint64_t write_time     = 0;
+            std::vector<uint32_t> files;
+            std::vector<uint32_t> directories;
+        };
+
+        void Clear();
+        static std::string Normalize(const std::string& path);
+        uint32_t AddDirectory(const std::string& path, uint64_t write_time);
+        void AddFile(const std::string& path);
+        void RemoveFile(const std::string& path);
+        void RemoveDirectoryRecursive(const std::string& path);
+        void ScanDirectory(const std::string& path); // serially, for directories which show up after the initial scan
+        void RefreshDirectory(uint32_t index);       // reconciles a single directory (not its children) with the disk
+        void PollWriteTimes();
+
+        // Change notifications for the whole tree under the root
+        struct Watcher;
+        bool StartWatching();
+        void StopWatching();
+        bool ReadChanges();                         // issues the next asynchronous read
+        void ApplyChanges();                        // applies the reads which have completed
+
+        std::string m_root;
+        std::vector<File> m_files;
+        std::vector<uint32_t> m_files_free;
+        std::vector<Directory> m_directories;
+        std::vector<uint32_t> m_directories_free;
+        std::unordered_map<std::string, uint32_t> m_file_lookup;
+        std::unordered_map<std::string, uint32_t> m_directory_lookup;
+        std::array<std::vector<uint32_t>, File_Type_Count> m_files_by_type;
+        std::unique_ptr<Watcher> m_watcher;
+        Stopwatch m_poll_timer;
+        Threading* m_threading      = nullptr;
+    };
+}
@@ -34,9 +34,9 @@ using namespace Spartan::Math;
 
 namespace Spartan
 {
-	// Properties of the texture font atlas which holds all visible ASCII characters
+	// Properties of the texture font atlas which holds all visible ASCII and Latin-1 characters
 	static const uint32_t GLYPH_START	= 32;
-	static const uint32_t GLYPH_END		= 127;
+	static const uint32_t GLYPH_END		= 256; // code points the font doesn't map are skipped
 	static const uint32_t ATLAS_WIDTH	= 512;
 
     static FT_UInt32 g_glyph_load_flags = 0;
@@ -211,7 +211,7 @@ namespace Spartan
 
             for (uint32_t char_code = GLYPH_START; char_code < GLYPH_END; char_code++)
             {
-                if (!load_glyph(face, char_code))
+                if (FT_Get_Char_Index(face, char_code) == 0 || !load_glyph(face, char_code))
                     continue;
 
                 FT_Bitmap* bitmap   = &face->glyph->bitmap;
@@ -455,6 +455,10 @@ namespace Spartan
         bool writting_started = false;
         for (uint32_t char_code = GLYPH_START; char_code < GLYPH_END; char_code++)
         {
+            // The font doesn't have it, the text will fall back to another glyph
+            if (FT_Get_Char_Index(ft_font, char_code) == 0)
+                continue;
+
             // Load text bitmap
             ft_helper::ft_bitmap bitmap_text;
             ft_helper::get_bitmap(&bitmap_text, font, nullptr, ft_font, char_code);
@@ -30,10 +30,13 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../../Core/Settings.h"
 #include "../../Rendering/Model.h"
 #include "../../Rendering/Animation.h"
+#include "../../Rendering/SkeletalAnimation.h"
 #include "../../Rendering/Material.h"
 #include "../../World/World.h"
 #include "../../World/Components/Renderable.h"
 #include "../../RHI/RHI_Vertex.h"
+#include <functional>
+#include <unordered_map>
 //============================================
 
 //= NAMESPACES ================
@@ -135,6 +138,8 @@ namespace Spartan
             AssimpHelper::compute_node_count(scene->mRootNode, &job_count);
             ProgressReport::Get().SetJobCount(g_progress_model_importer, job_count);
 
+            // Parse the skeleton first, so that meshes can map their bones to it
+            ParseSkeleton(params);
             // Parse all nodes, starting from the root node and continuing recursively
 			ParseNode(scene->mRootNode, params, nullptr, new_entity.get());
             // Parse animations
@@ -211,6 +216,62 @@ namespace Spartan
         }
     }
 
+    void ModelImporter::ParseSkeleton(const ModelParams& params)
+    {
+        // Bones referenced by any mesh
+        unordered_map<string, const aiBone*> bones;
+        for (uint32_t i = 0; i < params.scene->mNumMeshes; i++)
+        {
+            const aiMesh* assimp_mesh = params.scene->mMeshes[i];
+            for (uint32_t j = 0; j < assimp_mesh->mNumBones; j++)
+            {
+                bones.emplace(assimp_mesh->mBones[j]->mName.C_Str(), assimp_mesh->mBones[j]);
+            }
+        }
+
+        if (bones.empty())
+            return;
+
+        // The skeleton is every bone node plus the nodes between them and the root, added parents first
+        const function<bool(const aiNode*)> has_bone = [&](const aiNode* node)
+        {
+            if (bones.count(node->mName.C_Str()))
+                return true;
+
+            for (uint32_t i = 0; i < node->mNumChildren; i++)
+            {
+                if (has_bone(node->mChildren[i]))
+                    return true;
+            }
+
+            return false;
+        };
+
+        Skeleton* skeleton = params.model->GetSkeleton();
+        const function<void(const aiNode*, int32_t)> add_node = [&](const aiNode* node, const int32_t parent)
+        {
+            if (!has_bone(node))
+                return;
+
+            const auto bone         = bones.find(node->mName.C_Str());
+            const Matrix local      = AssimpHelper::ai_matrix4_x4_to_matrix(node->mTransformation);
+            const Matrix offset     = bone != bones.end() ? AssimpHelper::ai_matrix4_x4_to_matrix(bone->second->mOffsetMatrix) : Matrix::Identity;
+            const uint32_t index    = skeleton->AddBone(node->mName.C_Str(), parent, offset, local.GetTranslation(), local.GetRotation(), local.GetScale());
+
+            for (uint32_t i = 0; i < node->mNumChildren; i++)
+            {
+                add_node(node->mChildren[i], static_cast<int32_t>(index));
+            }
+        };
+        add_node(params.scene->mRootNode, -1);
+
+        // Bone indices are stored in 8 bits per vertex
+        if (skeleton->GetBoneCount() > 256)
+        {
+            LOG_WARNING("\"%s\" has %d bones, only the first 256 can influence vertices", params.name.c_str(), skeleton->GetBoneCount());
+        }
+    }
+
     void ModelImporter::ParseAnimations(const ModelParams& params)
 	{
 		for (uint32_t i = 0; i < params.scene->mNumAnimations; i++)
@@ -243,7 +304,7 @@ namespace Spartan
 				// Rotation keys
 				for (uint32_t k = 0; k < static_cast<uint32_t>(assimp_node_anim->mNumRotationKeys); k++)
 				{
-					const auto time = assimp_node_anim->mPositionKeys[k].mTime;
+					const auto time = assimp_node_anim->mRotationKeys[k].mTime;
 					const auto value = AssimpHelper::to_quaternion(assimp_node_anim->mRotationKeys[k].mValue);
 
 					animation_node.rotationFrames.emplace_back(KeyQuaternion{ time, value });
@@ -252,12 +313,17 @@ namespace Spartan
 				// Scaling keys
 				for (uint32_t k = 0; k < static_cast<uint32_t>(assimp_node_anim->mNumScalingKeys); k++)
 				{
-					const auto time = assimp_node_anim->mPositionKeys[k].mTime;
+					const auto time = assimp_node_anim->mScalingKeys[k].mTime;
 					const auto value = AssimpHelper::to_vector3(assimp_node_anim->mScalingKeys[k].mValue);
 
 					animation_node.scaleFrames.emplace_back(KeyVector{ time, value });
 				}
+
+				animation->AddChannel(move(animation_node));
 			}
+
+			// Resample it into a compact clip for the model's skeleton
+			params.model->AddAnimation(*animation);
 		}
 	}
 
@@ -362,47 +428,76 @@ namespace Spartan
 		}
 
 		// Bones
-        LoadBones(assimp_mesh, params);
+        LoadBones(assimp_mesh, params, vertices, vertex_offset);
 	}
 
-    void ModelImporter::LoadBones(const aiMesh* assimp_mesh, const ModelParams& params)
+    void ModelImporter::LoadBones(const aiMesh* assimp_mesh, const ModelParams& params, const vector<RHI_Vertex_PosTexNorTan>& vertices, const uint32_t vertex_offset)
     {
-        // Maximum number of bones per mesh
-        // Must not be higher than same const in skinning shader
-        constexpr uint8_t MAX_BONES = 64;
-        // Maximum number of bones per vertex
-        constexpr uint8_t MAX_BONES_PER_VERTEX = 4;
-
-        //for (uint32_t i = 0; i < assimp_mesh->mNumBones; i++)
-        //{
-        //    uint32_t index = 0;
-
-        //    assert(assimp_mesh->mNumBones <= MAX_BONES);
-
-        //    string name = assimp_mesh->mBones[i]->mName.data;
-
-        //    if (boneMapping.find(name) == boneMapping.end())
-        //    {
-        //        // Bone not present, add new one
-        //        index = numBones;
-        //        numBones++;
-        //        BoneInfo bone;
-        //        boneInfo.push_back(bone);
-        //        boneInfo[index].offset = pMesh->mBones[i]->mOffsetMatrix;
-        //        boneMapping[name] = index;
-        //    }
-        //    else
-        //    {
-        //        index = boneMapping[name];
-        //    }
-
-        //    for (uint32_t j = 0; j < assimp_mesh->mBones[i]->mNumWeights; j++)
-        //    {
-        //        uint32_t vertexID = vertexOffset + pMesh->mBones[i]->mWeights[j].mVertexId;
-        //        Bones[vertexID].add(index, pMesh->mBones[i]->mWeights[j].mWeight);
-        //    }
-        //}
-        //boneTransforms.resize(numBones);
+        if (!assimp_mesh->HasBones())
+            return;
+
+        // Maximum number of bones per vertex, aiProcess_LimitBoneWeights already keeps the strongest four
+        constexpr uint32_t MAX_BONES_PER_VERTEX = 4;
+        // Bone indices are stored in 8 bits
+        constexpr uint32_t MAX_BONES = 256;
+
+        const Skeleton* skeleton    = params.model->GetSkeleton();
+        const uint32_t vertex_count = static_cast<uint32_t>(vertices.size());
+        vector<uint32_t> indices(vertex_count * MAX_BONES_PER_VERTEX, 0);
+        vector<float> weights(vertex_count * MAX_BONES_PER_VERTEX, 0.0f);
+
+        for (uint32_t i = 0; i < assimp_mesh->mNumBones; i++)
+        {
+            const aiBone* assimp_bone   = assimp_mesh->mBones[i];
+            const int32_t bone          = skeleton->GetBoneIndex(assimp_bone->mName.C_Str());
+            if (bone < 0 || bone >= static_cast<int32_t>(MAX_BONES))
+                continue;
+
+            for (uint32_t j = 0; j < assimp_bone->mNumWeights; j++)
+            {
+                const aiVertexWeight& assimp_weight = assimp_bone->mWeights[j];
+                if (assimp_weight.mVertexId >= vertex_count)
+                    continue;
+
+                // Take the place of the weakest influence, if this one is stronger
+                float* vertex_weights   = &weights[assimp_weight.mVertexId * MAX_BONES_PER_VERTEX];
+                const auto weakest      = min_element(vertex_weights, vertex_weights + MAX_BONES_PER_VERTEX);
+                if (assimp_weight.mWeight > *weakest)
+                {
+                    *weakest = assimp_weight.mWeight;
+                    indices[assimp_weight.mVertexId * MAX_BONES_PER_VERTEX + (weakest - vertex_weights)] = static_cast<uint32_t>(bone);
+                }
+            }
+        }
+
+        // Quantize the weights to 8 bits, adding up to exactly 255
+        vector<RHI_Vertex_PosTexNorTanBone> skinned_vertices(vertices.begin(), vertices.end());
+        for (uint32_t i = 0; i < vertex_count; i++)
+        {
+            const float* vertex_weights = &weights[i * MAX_BONES_PER_VERTEX];
+            float weight_sum = 0.0f;
+            for (uint32_t j = 0; j < MAX_BONES_PER_VERTEX; j++)
+            {
+                weight_sum += vertex_weights[j];
+            }
+
+            if (weight_sum <= 0.0f)
+                continue;
+
+            auto& vertex        = skinned_vertices[i];
+            uint32_t total      = 0;
+            uint32_t strongest  = 0;
+            for (uint32_t j = 0; j < MAX_BONES_PER_VERTEX; j++)
+            {
+                vertex.bone_index[j]    = static_cast<uint8_t>(indices[i * MAX_BONES_PER_VERTEX + j]);
+                vertex.bone_weight[j]   = static_cast<uint8_t>(lround(vertex_weights[j] / weight_sum * 255.0f));
+                total                   += vertex.bone_weight[j];
+                strongest               = vertex_weights[j] > vertex_weights[strongest] ? j : strongest;
+            }
+            vertex.bone_weight[strongest] = static_cast<uint8_t>(static_cast<int32_t>(vertex.bone_weight[strongest]) + 255 - static_cast<int32_t>(total));
+        }
+
+        params.model->AppendSkinnedVertices(vertex_offset, skinned_vertices);
     }
 
     shared_ptr<Material> ModelImporter::LoadMaterial(aiMaterial* assimp_material, const ModelParams& params)
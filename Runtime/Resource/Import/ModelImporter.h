@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../../Core/EngineDefs.h"
 #include <memory>
 #include <string>
+#include <vector>
 //================================
 
 struct aiNode;
@@ -39,6 +40,7 @@ namespace Spartan
 	class Entity;
 	class Model;
 	class World;
+	struct RHI_Vertex_PosTexNorTan;
 
     struct ModelParams
     {
@@ -65,11 +67,12 @@ namespace Spartan
         // Parsing
 		void ParseNode(const aiNode* assimp_node, const ModelParams& params, Entity* parent_node = nullptr, Entity* new_entity = nullptr);
         void ParseNodeMeshes(const aiNode* assimp_node, Entity* new_entity, const ModelParams& params);
+        void ParseSkeleton(const ModelParams& params);
         void ParseAnimations(const ModelParams& params);
 
         // Loading
 		void LoadMesh(aiMesh* assimp_mesh, Entity* entity_parent, const ModelParams& params);
-        void LoadBones(const aiMesh* assimp_mesh, const ModelParams& params);
+        void LoadBones(const aiMesh* assimp_mesh, const ModelParams& params, const std::vector<RHI_Vertex_PosTexNorTan>& vertices, uint32_t vertex_offset);
 		std::shared_ptr<Material> LoadMaterial(aiMaterial* assimp_material, const ModelParams& params);
 
         // Dependencies
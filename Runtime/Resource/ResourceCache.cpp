@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Import/ImageImporter.h"
 #include "Import/ModelImporter.h"
 #include "Import/FontImporter.h"
+#include "AssetIndex.h"
 #include "../World/World.h"
 #include "../World/Entity.h"
 #include "../IO/FileStream.h"
@@ -32,6 +33,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI/RHI_TextureCube.h"
 #include "../Audio/AudioClip.h"
 #include "../Rendering/Model.h"
+#include "../Threading/Threading.h"
 //=================================
 
 //= NAMESPACES ================
@@ -76,9 +78,22 @@ namespace Spartan
 		m_importer_image	= make_shared<ImageImporter>(m_context);
 		m_importer_model	= make_shared<ModelImporter>(m_context);
 		m_importer_font		= make_shared<FontImporter>(m_context);
+
+		// Asset index
+		m_asset_index = make_shared<AssetIndex>(m_context->GetSubsystem<Threading>());
+		m_asset_index->Scan(m_project_directory);
+
 		return true;
 	}
 
+	void ResourceCache::Tick(float delta_time)
+	{
+		if (m_asset_index)
+		{
+			m_asset_index->Poll();
+		}
+	}
+
 	bool ResourceCache::IsCached(const string& resource_name, const Resource_Type resource_type /*= Resource_Unknown*/)
 	{
 		if (resource_name.empty())
@@ -291,6 +306,11 @@ namespace Spartan
 		}
 
 		m_project_directory = directory;
+
+		if (m_asset_index)
+		{
+			m_asset_index->Scan(m_project_directory);
+		}
 	}
 
 	string ResourceCache::GetProjectDirectoryAbsolute() const
@@ -33,6 +33,7 @@ namespace Spartan
     class FontImporter;
     class ImageImporter;
     class ModelImporter;
+    class AssetIndex;
 
 	enum Asset_Type
 	{
@@ -51,9 +52,10 @@ namespace Spartan
 		ResourceCache(Context* context);
 		~ResourceCache();
 
-		//= Subsystem =============
+		//= Subsystem ========================
 		bool Initialize() override;
-		//=========================
+		void Tick(float delta_time) override;
+		//====================================
 
         // Get by name
 		std::shared_ptr<IResource>& GetByName(const std::string& name, Resource_Type type);
@@ -197,6 +199,9 @@ namespace Spartan
 		auto GetImageImporter() const { return m_importer_image.get(); }
 		auto GetFontImporter()  const { return m_importer_font.get(); }
 
+		// Every file in the project directory, kept up to date as files change on disk
+		auto GetAssetIndex()    const { return m_asset_index.get(); }
+
 	private:
 		// Cache
 		std::unordered_map<Resource_Type, std::vector<std::shared_ptr<IResource>>> m_resource_groups;
@@ -210,5 +215,8 @@ namespace Spartan
 		std::shared_ptr<ModelImporter> m_importer_model;
 		std::shared_ptr<ImageImporter> m_importer_image;
 		std::shared_ptr<FontImporter> m_importer_font;
+
+		// Asset index
+		std::shared_ptr<AssetIndex> m_asset_index;
 	};
 }
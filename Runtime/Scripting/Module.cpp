@@ -21,10 +21,14 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES =============================
 #include "Module.h"
+#include <fstream>
+#include <sstream>
 #include <scriptbuilder/scriptbuilder.cpp>
 #include "Scripting.h"
 #include "../Logging/Log.h"
 #include "../Core/FileSystem.h"
+#include "../IO/FileStream.h"
+#include "../Utilities/Hash.h"
 //========================================
 
 //= NAMESPACES =====
@@ -33,6 +37,58 @@ using namespace std;
 
 namespace Spartan
 {
+    // Compiled scripts on disk, addressed by a hash of their source. Bump the version when the script interface changes.
+    static const char* script_cache_directory   = "script_cache/";
+    static const uint32_t script_cache_version  = 1;
+
+    // Hashes a script file and the scripts it includes (the builder resolves them the same way the file system does)
+    static uint64_t hash_script(const string& file_path, uint64_t hash)
+    {
+        vector<string> file_paths = FileSystem::GetIncludedFiles(file_path);
+        file_paths.insert(file_paths.begin(), file_path);
+
+        for (const string& path : file_paths)
+        {
+            ifstream in(path);
+            stringstream buffer;
+            buffer << in.rdbuf();
+            const string source = buffer.str();
+
+            hash = Utility::Hash::hash_64(path.data(), path.size(), hash);
+            hash = Utility::Hash::hash_64(source.data(), source.size(), hash);
+        }
+
+        return hash;
+    }
+
+    // AngelScript reads and writes bytecode in small pieces, so it goes through memory
+    class ByteCodeStream : public asIBinaryStream
+    {
+    public:
+        ByteCodeStream(vector<std::byte>& bytes) : m_bytes(bytes) {}
+
+        int Write(const void* ptr, asUINT size) override
+        {
+            const std::byte* data = static_cast<const std::byte*>(ptr);
+            m_bytes.insert(m_bytes.end(), data, data + size);
+            return 0;
+        }
+
+        int Read(void* ptr, asUINT size) override
+        {
+            if (m_position + size > m_bytes.size())
+                return -1;
+
+            memcpy(ptr, m_bytes.data() + m_position, size);
+            m_position += size;
+            return 0;
+        }
+
+    private:
+        vector<std::byte>& m_bytes;
+        size_t m_position = 0;
+    };
+
 	Module::Module(const string& moduleName, Scripting* scriptEngine)
 	{
 		m_moduleName	= moduleName;
@@ -55,6 +111,19 @@ namespace Spartan
 			return false;
 		}
 
+        // The cached bytecode is only valid for the same source, cache version and AngelScript version
+        uint64_t key = Utility::Hash::hash_64(&script_cache_version, sizeof(script_cache_version));
+        key = Utility::Hash::hash_64(ANGELSCRIPT_VERSION_STRING, strlen(ANGELSCRIPT_VERSION_STRING), key);
+        key = hash_script(filePath, key);
+
+        char file_name[32];
+        snprintf(file_name, sizeof(file_name), "%016llx.bin", static_cast<unsigned long long>(key));
+        const string cache_path = string(script_cache_directory) + file_name;
+
+        m_from_cache = LoadByteCode(cache_path);
+        if (m_from_cache)
+            return true;
+
 		// start new module
 		m_scriptBuilder = make_unique<CScriptBuilder>();
 		int result = m_scriptBuilder->StartNewModule(m_scripting->GetAsIScriptEngine(), m_moduleName.c_str());
@@ -80,17 +149,70 @@ namespace Spartan
 			return false;
 		}
 
+        m_module = m_scriptBuilder->GetModule();
+        SaveByteCode(cache_path);
+
 		return true;
 	}
 
 	asIScriptModule* Module::GetAsIScriptModule() const
     {
-		if (!m_scriptBuilder)
+		if (!m_module)
 		{
 			LOG_ERROR_INVALID_INTERNALS();
 			return nullptr;
 		}
 
-		return m_scriptBuilder->GetModule();
+		return m_module;
 	}
+
+    bool Module::LoadByteCode(const string& cache_path)
+    {
+        if (!FileSystem::Exists(cache_path))
+            return false;
+
+        vector<std::byte> bytes;
+        {
+            auto file = make_unique<FileStream>(cache_path, FileStream_Read);
+            if (!file->IsOpen())
+                return false;
+
+            file->Read(&bytes);
+        }
+
+        // Bytecode which no longer matches the registered script interface fails to load, and the script is compiled instead
+        asIScriptModule* module = m_scripting->GetAsIScriptEngine()->GetModule(m_moduleName.c_str(), asGM_ALWAYS_CREATE);
+        ByteCodeStream stream(bytes);
+        if (!module || module->LoadByteCode(&stream) < 0)
+        {
+            m_scripting->DiscardModule(m_moduleName);
+            return false;
+        }
+
+        m_module = module;
+        return true;
+    }
+
+    bool Module::SaveByteCode(const string& cache_path) const
+    {
+        vector<std::byte> bytes;
+        ByteCodeStream stream(bytes);
+        if (m_module->SaveByteCode(&stream) < 0) // debug info is kept, exceptions report their line
+            return false;
+
+        if (!FileSystem::Exists(script_cache_directory))
+        {
+            FileSystem::CreateDirectory_(script_cache_directory);
+        }
+
+        auto file = make_unique<FileStream>(cache_path, FileStream_Write);
+        if (!file->IsOpen())
+        {
+            LOG_ERROR("Failed to open \"%s\" for writing", cache_path.c_str());
+            return false;
+        }
+
+        file->Write(bytes);
+        return true;
+    }
 }
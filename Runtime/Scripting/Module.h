@@ -40,12 +40,19 @@ namespace Spartan
 		Module(const std::string& moduleName, Scripting* scriptEngine);
 		~Module();
 
+        // Loads the bytecode of a previous compilation if the script (and what it includes) hasn't changed since, compiles it otherwise
 		bool LoadScript(const std::string& filePath);
 		asIScriptModule* GetAsIScriptModule() const;
+        bool IsFromCache() const { return m_from_cache; }
 
 	private:
+        bool LoadByteCode(const std::string& cache_path);
+        bool SaveByteCode(const std::string& cache_path) const;
+
 		std::string m_moduleName;
 		std::unique_ptr<CScriptBuilder> m_scriptBuilder;
-        Scripting* m_scripting;
+        asIScriptModule* m_module   = nullptr;
+        Scripting* m_scripting      = nullptr;
+        bool m_from_cache           = false;
 	};
 }
@@ -0,0 +1,111 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES =======================
+#include "ScriptCommandBuffer.h"
+#include "../World/World.h"
+#include "../World/Entity.h"
+#include "../World/Components/Transform.h"
+//==================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+//============================
+
+namespace Spartan
+{
+    static thread_local ScriptCommandBuffer* current_buffer = nullptr;
+    static thread_local bool is_deferred                    = false;
+
+    void ScriptCommandBuffer::SetPosition(const uint32_t entity_id, const Vector3& position)
+    {
+        m_commands.push_back({ ScriptCommand_SetPosition, entity_id, Vector4(position.x, position.y, position.z, 0.0f) });
+    }
+
+    void ScriptCommandBuffer::SetRotation(const uint32_t entity_id, const Quaternion& rotation)
+    {
+        m_commands.push_back({ ScriptCommand_SetRotation, entity_id, Vector4(rotation.x, rotation.y, rotation.z, rotation.w) });
+    }
+
+    void ScriptCommandBuffer::SetScale(const uint32_t entity_id, const Vector3& scale)
+    {
+        m_commands.push_back({ ScriptCommand_SetScale, entity_id, Vector4(scale.x, scale.y, scale.z, 0.0f) });
+    }
+
+    void ScriptCommandBuffer::SetActive(const uint32_t entity_id, const bool active)
+    {
+        m_commands.push_back({ ScriptCommand_SetActive, entity_id, Vector4(active ? 1.0f : 0.0f, 0.0f, 0.0f, 0.0f) });
+    }
+
+    void ScriptCommandBuffer::Append(const ScriptCommandBuffer& other)
+    {
+        m_commands.insert(m_commands.end(), other.m_commands.begin(), other.m_commands.end());
+    }
+
+    uint32_t ScriptCommandBuffer::Apply(World* world) const
+    {
+        if (!world)
+            return 0;
+
+        uint32_t applied = 0;
+        for (const ScriptCommand& command : m_commands)
+        {
+            const shared_ptr<Entity>& entity = world->EntityGetById(command.entity_id);
+            if (!entity)
+                continue;
+
+            const Vector4& value = command.value;
+            switch (command.type)
+            {
+                case ScriptCommand_SetPosition: entity->GetTransform()->SetPosition(Vector3(value.x, value.y, value.z));               break;
+                case ScriptCommand_SetRotation: entity->GetTransform()->SetRotation(Quaternion(value.x, value.y, value.z, value.w));   break;
+                case ScriptCommand_SetScale:    entity->GetTransform()->SetScale(Vector3(value.x, value.y, value.z));                  break;
+                case ScriptCommand_SetActive:   entity->SetActive(value.x != 0.0f);                                                    break;
+            }
+
+            applied++;
+        }
+
+        return applied;
+    }
+
+    ScriptCommandBuffer* ScriptCommandBuffer::GetCurrent()
+    {
+        return current_buffer;
+    }
+
+    void ScriptCommandBuffer::SetCurrent(ScriptCommandBuffer* buffer)
+    {
+        current_buffer = buffer;
+    }
+
+    bool ScriptCommandBuffer::IsDeferred()
+    {
+        return is_deferred;
+    }
+
+    void ScriptCommandBuffer::SetDeferred(const bool deferred)
+    {
+        is_deferred = deferred;
+    }
+}
@@ -0,0 +1,83 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+//= INCLUDES ==================
+#include <vector>
+#include "../Math/Vector4.h"
+#include "../Math/Vector3.h"
+#include "../Math/Quaternion.h"
+//=============================
+
+namespace Spartan
+{
+    class World;
+
+    enum ScriptCommand_Type : uint32_t
+    {
+        ScriptCommand_SetPosition,
+        ScriptCommand_SetRotation,
+        ScriptCommand_SetScale,
+        ScriptCommand_SetActive
+    };
+
+    struct ScriptCommand
+    {
+        ScriptCommand_Type type = ScriptCommand_SetPosition;
+        uint32_t entity_id      = 0;
+        Math::Vector4 value;
+
+        bool operator==(const ScriptCommand& rhs) const { return type == rhs.type && entity_id == rhs.entity_id && value == rhs.value; }
+    };
+
+    // Writes which scripts make to other entities. Scripts which run in parallel can't touch anything but their own entity,
+    // so they record these instead, one buffer per worker, and the buffers are applied on the main thread (in update order)
+    // once all the scripts have run. Entities are addressed by id, so commands for entities which are gone are skipped.
+    class ScriptCommandBuffer
+    {
+    public:
+        ScriptCommandBuffer() = default;
+        ~ScriptCommandBuffer() = default;
+
+        void SetPosition(uint32_t entity_id, const Math::Vector3& position);
+        void SetRotation(uint32_t entity_id, const Math::Quaternion& rotation);
+        void SetScale(uint32_t entity_id, const Math::Vector3& scale);
+        void SetActive(uint32_t entity_id, bool active);
+
+        void Append(const ScriptCommandBuffer& other);
+        uint32_t Apply(World* world) const; // returns how many commands found their entity
+        void Clear() { m_commands.clear(); }
+        const auto& GetCommands() const { return m_commands; }
+
+        // The buffer that the scripts running on the calling thread record into
+        static ScriptCommandBuffer* GetCurrent();
+        static void SetCurrent(ScriptCommandBuffer* buffer);
+
+        // Set while thread safe scripts run on the calling thread, their transform writes are recorded and other writes are rejected
+        static bool IsDeferred();
+        static void SetDeferred(bool deferred);
+
+    private:
+        std::vector<ScriptCommand> m_commands;
+    };
+}
@@ -60,7 +60,6 @@ namespace Spartan
 		m_scriptPath				= path;
 		m_entity					= entity;
 		m_className					= FileSystem::GetFileNameNoExtensionFromFilePath(m_scriptPath);
-		m_moduleName				= m_className + to_string(m_entity.lock()->GetId());
 		m_constructorDeclaration	= m_className + " @" + m_className + "(Entity @)";
 
 		// Instantiate the script
@@ -88,7 +87,7 @@ namespace Spartan
 			return;
 		}
 
-		m_scripting->ExecuteCall(m_updateFunction, m_scriptObject, delta_time);
+		m_scripting->QueueUpdate(m_updateFunction, m_scriptObject, delta_time);
 	}
 
 	bool ScriptInstance::CreateScriptObject()
@@ -99,10 +98,9 @@ namespace Spartan
 			return false;
 		}
 
-		// Create module
-		m_module	= make_shared<Module>(m_moduleName, m_scripting);
-        const bool result = m_module->LoadScript(m_scriptPath);
-		if (!result)
+		// Acquire module, it's compiled (or loaded from bytecode) once and shared by all the instances of the script, unless it has global variables
+		m_module = m_scripting->GetModule(m_scriptPath);
+		if (!m_module)
 			return false;
 
 		// Get type
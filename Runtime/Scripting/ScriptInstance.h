@@ -45,7 +45,7 @@ namespace Spartan
 		const auto& GetScriptPath() const { return m_scriptPath; }
 
 		void ExecuteStart() const;
-		void ExecuteUpdate(float delta_time) const;
+		void ExecuteUpdate(float delta_time) const; // queued, all instances of a script are updated together once the world has ticked every script
 
 	private:
 		bool CreateScriptObject();
@@ -53,7 +53,6 @@ namespace Spartan
 		std::string m_scriptPath;
 		std::string m_className;
 		std::string m_constructorDeclaration;
-		std::string m_moduleName;
 		std::weak_ptr<Entity> m_entity;
 		std::shared_ptr<Module> m_module;
 		asIScriptObject* m_scriptObject				= nullptr;
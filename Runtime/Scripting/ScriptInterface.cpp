@@ -29,6 +29,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../World/Components/Camera.h"
 #include "../World/Components/Transform.h"
 #include "../World/Components/Renderable.h"
+#include "../Physics/Physics.h"
+#include "../Physics/PhysicsQuery.h"
+#include "ScriptCommandBuffer.h"
 //=========================================
 
 //= NAMESPACES ===============
@@ -53,7 +56,9 @@ namespace Spartan
 		RegisterTransform();
 		RegisterMaterial();
 		RegisterRigidBody();
+		RegisterPhysics();
 		RegisterEntity();
+		RegisterCommands();
 		RegisterLog();
 	}
 
@@ -130,9 +135,14 @@ namespace Spartan
 		m_scriptEngine->RegisterObjectType("Camera", 0, asOBJ_REF | asOBJ_NOCOUNT);
 		m_scriptEngine->RegisterObjectType("RigidBody", 0, asOBJ_REF | asOBJ_NOCOUNT);
 		m_scriptEngine->RegisterObjectType("MathHelper", 0, asOBJ_REF | asOBJ_NOCOUNT);
+		m_scriptEngine->RegisterObjectType("PhysicsQueryBatch", sizeof(PhysicsQueryBatch), asOBJ_VALUE | asOBJ_APP_CLASS_CDAK);
 		m_scriptEngine->RegisterObjectType("Vector2", sizeof(Vector2), asOBJ_VALUE | asOBJ_APP_CLASS | asOBJ_APP_CLASS_CONSTRUCTOR | asOBJ_APP_CLASS_COPY_CONSTRUCTOR | asOBJ_APP_CLASS_DESTRUCTOR);
 		m_scriptEngine->RegisterObjectType("Vector3", sizeof(Vector3), asOBJ_VALUE | asOBJ_APP_CLASS | asOBJ_APP_CLASS_CONSTRUCTOR | asOBJ_APP_CLASS_COPY_CONSTRUCTOR | asOBJ_APP_CLASS_DESTRUCTOR);
 		m_scriptEngine->RegisterObjectType("Quaternion", sizeof(Quaternion), asOBJ_VALUE | asOBJ_APP_CLASS | asOBJ_APP_CLASS_CONSTRUCTOR | asOBJ_APP_CLASS_COPY_CONSTRUCTOR | asOBJ_APP_CLASS_DESTRUCTOR);
+
+		// Script classes which implement this can be updated in parallel. Their transform setters and SetActive() are recorded as
+		// commands, their other writes (local transforms, rigid bodies, materials, physics queries) throw, see ScriptCommandBuffer::IsDeferred()
+		m_scriptEngine->RegisterInterface("ThreadSafe");
 	}
 
 	/*------------------------------------------------------------------------------
@@ -148,42 +158,187 @@ namespace Spartan
 		m_scriptEngine->RegisterObjectMethod("Input", "bool GetKeyUp(KeyCode key)", asMETHOD(Input, GetKeyUp), asCALL_THISCALL);
 	}
 
+	// Thread safe scripts can't write to components directly, what can't be recorded as a command throws instead
+	static bool RejectDeferred(const char* function)
+	{
+		if (!ScriptCommandBuffer::IsDeferred())
+			return false;
+
+		if (asIScriptContext* ctx = asGetActiveContext())
+		{
+			ctx->SetException((string(function) + "() can't be called from a ThreadSafe script").c_str());
+		}
+
+		return true;
+	}
+
 	/*------------------------------------------------------------------------------
 										[Entity]
 	------------------------------------------------------------------------------*/
+	// Entity's id lives in a base class, so it's exposed through a function rather than a method pointer
+	static uint32_t EntityGetId(Entity* self)
+	{
+		return self->GetId();
+	}
+
+	static void EntitySetActive(const bool active, Entity* self)
+	{
+		if (ScriptCommandBuffer::IsDeferred())
+		{
+			if (ScriptCommandBuffer* commands = ScriptCommandBuffer::GetCurrent())
+			{
+				commands->SetActive(self->GetId(), active);
+			}
+			return;
+		}
+
+		self->SetActive(active);
+	}
+
 	void ScriptInterface::RegisterEntity()
 	{
 		m_scriptEngine->RegisterObjectMethod("Entity", "Entity &opAssign(const Entity &in)", asMETHODPR(Entity, operator =, (const Entity&), Entity&), asCALL_THISCALL);
 		m_scriptEngine->RegisterObjectMethod("Entity", "string GetName()", asMETHOD(Entity, GetName), asCALL_THISCALL);
 		m_scriptEngine->RegisterObjectMethod("Entity", "void SetName(string)", asMETHOD(Entity, SetName), asCALL_THISCALL);
 		m_scriptEngine->RegisterObjectMethod("Entity", "bool IsActive()", asMETHOD(Entity, IsActive), asCALL_THISCALL);
-		m_scriptEngine->RegisterObjectMethod("Entity", "void SetActive(bool)", asMETHOD(Entity, SetActive), asCALL_THISCALL);
+		m_scriptEngine->RegisterObjectMethod("Entity", "void SetActive(bool)", asFUNCTION(EntitySetActive), asCALL_CDECL_OBJLAST);
 		m_scriptEngine->RegisterObjectMethod("Entity", "Transform &GetTransform()", asMETHOD(Entity, GetTransform), asCALL_THISCALL);	
 		m_scriptEngine->RegisterObjectMethod("Entity", "Camera &GetCamera()", asMETHOD(Entity, GetComponent<Camera>), asCALL_THISCALL);
 		m_scriptEngine->RegisterObjectMethod("Entity", "RigidBody &GetRigidBody()", asMETHOD(Entity, GetComponent<RigidBody>), asCALL_THISCALL);
 		m_scriptEngine->RegisterObjectMethod("Entity", "Renderable &GetRenderable()", asMETHOD(Entity, GetComponent<Renderable>), asCALL_THISCALL);
+		m_scriptEngine->RegisterObjectMethod("Entity", "uint GetId()", asFUNCTION(EntityGetId), asCALL_CDECL_OBJLAST);
+	}
+
+	/*------------------------------------------------------------------------------
+										[COMMANDS]
+	------------------------------------------------------------------------------*/
+	// Writes to other entities are recorded into the calling thread's command buffer and applied after the scripts have updated
+	static void QueueSetPosition(uint32_t entity_id, const Vector3& position)
+	{
+		if (ScriptCommandBuffer* commands = ScriptCommandBuffer::GetCurrent())
+		{
+			commands->SetPosition(entity_id, position);
+		}
+	}
+
+	static void QueueSetRotation(uint32_t entity_id, const Quaternion& rotation)
+	{
+		if (ScriptCommandBuffer* commands = ScriptCommandBuffer::GetCurrent())
+		{
+			commands->SetRotation(entity_id, rotation);
+		}
+	}
+
+	static void QueueSetScale(uint32_t entity_id, const Vector3& scale)
+	{
+		if (ScriptCommandBuffer* commands = ScriptCommandBuffer::GetCurrent())
+		{
+			commands->SetScale(entity_id, scale);
+		}
+	}
+
+	static void QueueSetActive(uint32_t entity_id, bool active)
+	{
+		if (ScriptCommandBuffer* commands = ScriptCommandBuffer::GetCurrent())
+		{
+			commands->SetActive(entity_id, active);
+		}
+	}
+
+	void ScriptInterface::RegisterCommands() const
+	{
+		auto r = 0;
+
+		r = m_scriptEngine->RegisterGlobalFunction("void QueueSetPosition(uint, const Vector3& in)",		asFUNCTION(QueueSetPosition),	asCALL_CDECL); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterGlobalFunction("void QueueSetRotation(uint, const Quaternion& in)",	asFUNCTION(QueueSetRotation),	asCALL_CDECL); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterGlobalFunction("void QueueSetScale(uint, const Vector3& in)",		asFUNCTION(QueueSetScale),		asCALL_CDECL); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterGlobalFunction("void QueueSetActive(uint, bool)",					asFUNCTION(QueueSetActive),		asCALL_CDECL); SPARTAN_ASSERT(r >= 0);
 	}
 
 	/*------------------------------------------------------------------------------
 										[TRANSFORM]
 	------------------------------------------------------------------------------*/
+	static Transform& TransformAssign(const Transform& other, Transform* self)
+	{
+		if (!RejectDeferred("Transform::opAssign")) *self = other;
+		return *self;
+	}
+
+	static void TransformSetPosition(const Vector3& position, Transform* self)
+	{
+		if (ScriptCommandBuffer::IsDeferred())
+		{
+			QueueSetPosition(self->GetEntity()->GetId(), position);
+			return;
+		}
+
+		self->SetPosition(position);
+	}
+
+	static void TransformSetRotation(const Quaternion& rotation, Transform* self)
+	{
+		if (ScriptCommandBuffer::IsDeferred())
+		{
+			QueueSetRotation(self->GetEntity()->GetId(), rotation);
+			return;
+		}
+
+		self->SetRotation(rotation);
+	}
+
+	static void TransformSetScale(const Vector3& scale, Transform* self)
+	{
+		if (ScriptCommandBuffer::IsDeferred())
+		{
+			QueueSetScale(self->GetEntity()->GetId(), scale);
+			return;
+		}
+
+		self->SetScale(scale);
+	}
+
+	static void TransformSetPositionLocal(const Vector3& position, Transform* self)
+	{
+		if (!RejectDeferred("Transform::SetPositionLocal")) self->SetPositionLocal(position);
+	}
+
+	static void TransformSetRotationLocal(const Quaternion& rotation, Transform* self)
+	{
+		if (!RejectDeferred("Transform::SetRotationLocal")) self->SetRotationLocal(rotation);
+	}
+
+	static void TransformSetScaleLocal(const Vector3& scale, Transform* self)
+	{
+		if (!RejectDeferred("Transform::SetScaleLocal")) self->SetScaleLocal(scale);
+	}
+
+	static void TransformTranslate(const Vector3& delta, Transform* self)
+	{
+		if (!RejectDeferred("Transform::Translate")) self->Translate(delta);
+	}
+
+	static void TransformRotate(const Quaternion& delta, Transform* self)
+	{
+		if (!RejectDeferred("Transform::Rotate")) self->Rotate(delta);
+	}
+
 	void ScriptInterface::RegisterTransform() const
     {
 		auto r = 0;
 
-		r = m_scriptEngine->RegisterObjectMethod("Transform", "Transform &opAssign(const Transform &in)",	asMETHODPR(Transform, operator =, (const Transform&), Transform&),	asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("Transform", "Transform &opAssign(const Transform &in)",	asFUNCTION(TransformAssign),										asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
 		r = m_scriptEngine->RegisterObjectMethod("Transform", "Vector3 GetPosition()",						asMETHOD(Transform, GetPosition),									asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
-		r = m_scriptEngine->RegisterObjectMethod("Transform", "void SetPosition(Vector3)",					asMETHOD(Transform, SetPosition),									asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("Transform", "void SetPosition(Vector3)",					asFUNCTION(TransformSetPosition),									asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
 		r = m_scriptEngine->RegisterObjectMethod("Transform", "Vector3 GetPositionLocal()",					asMETHOD(Transform, GetPositionLocal),								asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
-		r = m_scriptEngine->RegisterObjectMethod("Transform", "void SetPositionLocal(Vector3)",				asMETHOD(Transform, SetPositionLocal),								asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("Transform", "void SetPositionLocal(Vector3)",				asFUNCTION(TransformSetPositionLocal),								asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
 		r = m_scriptEngine->RegisterObjectMethod("Transform", "Vector3 GetScale()",							asMETHOD(Transform, GetScale),										asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
-		r = m_scriptEngine->RegisterObjectMethod("Transform", "void SetScale(Vector3)",						asMETHOD(Transform, SetScale),										asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("Transform", "void SetScale(Vector3)",						asFUNCTION(TransformSetScale),										asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
 		r = m_scriptEngine->RegisterObjectMethod("Transform", "Vector3 GetScaleLocal()",					asMETHOD(Transform, GetScaleLocal),									asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
-		r = m_scriptEngine->RegisterObjectMethod("Transform", "void SetScaleLocal(Vector3)",				asMETHOD(Transform, SetScaleLocal),									asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("Transform", "void SetScaleLocal(Vector3)",				asFUNCTION(TransformSetScaleLocal),									asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
 		r = m_scriptEngine->RegisterObjectMethod("Transform", "Quaternion GetRotation()",					asMETHOD(Transform, GetRotation),									asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
-		r = m_scriptEngine->RegisterObjectMethod("Transform", "void SetRotation(Quaternion)",				asMETHOD(Transform, SetRotation),									asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("Transform", "void SetRotation(Quaternion)",				asFUNCTION(TransformSetRotation),									asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
 		r = m_scriptEngine->RegisterObjectMethod("Transform", "Quaternion GetRotationLocal()",				asMETHOD(Transform, GetRotationLocal),								asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
-		r = m_scriptEngine->RegisterObjectMethod("Transform", "void SetRotationLocal(Quaternion)",			asMETHOD(Transform, SetRotationLocal),								asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("Transform", "void SetRotationLocal(Quaternion)",			asFUNCTION(TransformSetRotationLocal),								asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
 		r = m_scriptEngine->RegisterObjectMethod("Transform", "Vector3 GetUp()",							asMETHOD(Transform, GetUp),											asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
 		r = m_scriptEngine->RegisterObjectMethod("Transform", "Vector3 GetForward()",						asMETHOD(Transform, GetForward),									asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
 		r = m_scriptEngine->RegisterObjectMethod("Transform", "Vector3 GetRight()",							asMETHOD(Transform, GetRight),										asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
@@ -192,28 +347,115 @@ namespace Spartan
 		r = m_scriptEngine->RegisterObjectMethod("Transform", "Transform &GetChildByIndex(int)",			asMETHOD(Transform, GetChildByIndex),								asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
 		r = m_scriptEngine->RegisterObjectMethod("Transform", "Transform &GetChildByName(string)",			asMETHOD(Transform, GetChildByName),								asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
 		r = m_scriptEngine->RegisterObjectMethod("Transform", "Entity &GetEntity()",						asMETHOD(Transform, GetEntity),								        asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
-		r = m_scriptEngine->RegisterObjectMethod("Transform", "void Translate(const Vector3& in)",			asMETHOD(Transform, Translate),										asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
-		r = m_scriptEngine->RegisterObjectMethod("Transform", "void Rotate(const Quaternion& in)",			asMETHOD(Transform, Rotate),										asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("Transform", "void Translate(const Vector3& in)",			asFUNCTION(TransformTranslate),										asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("Transform", "void Rotate(const Quaternion& in)",			asFUNCTION(TransformRotate),										asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
 	}
 
 	/*------------------------------------------------------------------------------
 								[MATERIAL]
 	------------------------------------------------------------------------------*/
+	// Materials are shared between entities
+	static void MaterialSetOffset(const Vector2& offset, Material* self)
+	{
+		if (!RejectDeferred("Material::SetOffsetUV")) self->SetOffset(offset);
+	}
+
 	void ScriptInterface::RegisterMaterial() const
     {
-		m_scriptEngine->RegisterObjectMethod("Material", "void SetOffsetUV(Vector2)", asMETHOD(Material, SetOffset), asCALL_THISCALL);
+		m_scriptEngine->RegisterObjectMethod("Material", "void SetOffsetUV(Vector2)", asFUNCTION(MaterialSetOffset), asCALL_CDECL_OBJLAST);
 	}
 
 	/*------------------------------------------------------------------------------
 									[RIGIDBODY]
 	------------------------------------------------------------------------------*/
+	static RigidBody& RigidBodyAssign(const RigidBody& other, RigidBody* self)
+	{
+		if (!RejectDeferred("RigidBody::opAssign")) *self = other;
+		return *self;
+	}
+
+	static void RigidBodyApplyForce(const Vector3& force, const ForceMode mode, RigidBody* self)
+	{
+		if (!RejectDeferred("RigidBody::ApplyForce")) self->ApplyForce(force, mode);
+	}
+
+	static void RigidBodyApplyForceAtPosition(const Vector3& force, const Vector3& position, const ForceMode mode, RigidBody* self)
+	{
+		if (!RejectDeferred("RigidBody::ApplyForceAtPosition")) self->ApplyForceAtPosition(force, position, mode);
+	}
+
+	static void RigidBodyApplyTorque(const Vector3& torque, const ForceMode mode, RigidBody* self)
+	{
+		if (!RejectDeferred("RigidBody::ApplyTorque")) self->ApplyTorque(torque, mode);
+	}
+
+	static void RigidBodySetRotation(const Quaternion& rotation, RigidBody* self)
+	{
+		if (!RejectDeferred("RigidBody::SetRotation")) self->SetRotation(rotation);
+	}
+
 	void ScriptInterface::RegisterRigidBody() const
     {
-		m_scriptEngine->RegisterObjectMethod("RigidBody", "RigidBody &opAssign(const RigidBody &in)", asMETHODPR(RigidBody, operator =, (const RigidBody&), RigidBody&), asCALL_THISCALL);
-		m_scriptEngine->RegisterObjectMethod("RigidBody", "void ApplyForce(Vector3, ForceMode)", asMETHOD(RigidBody, ApplyForce), asCALL_THISCALL);
-		m_scriptEngine->RegisterObjectMethod("RigidBody", "void ApplyForceAtPosition(Vector3, Vector3, ForceMode)", asMETHOD(RigidBody, ApplyForceAtPosition), asCALL_THISCALL);
-		m_scriptEngine->RegisterObjectMethod("RigidBody", "void ApplyTorque(Vector3, ForceMode)", asMETHOD(RigidBody, ApplyTorque), asCALL_THISCALL);
-		m_scriptEngine->RegisterObjectMethod("RigidBody", "void SetRotation(Quaternion)", asMETHOD(RigidBody, SetRotation), asCALL_THISCALL);
+		m_scriptEngine->RegisterObjectMethod("RigidBody", "RigidBody &opAssign(const RigidBody &in)", asFUNCTION(RigidBodyAssign), asCALL_CDECL_OBJLAST);
+		m_scriptEngine->RegisterObjectMethod("RigidBody", "void ApplyForce(Vector3, ForceMode)", asFUNCTION(RigidBodyApplyForce), asCALL_CDECL_OBJLAST);
+		m_scriptEngine->RegisterObjectMethod("RigidBody", "void ApplyForceAtPosition(Vector3, Vector3, ForceMode)", asFUNCTION(RigidBodyApplyForceAtPosition), asCALL_CDECL_OBJLAST);
+		m_scriptEngine->RegisterObjectMethod("RigidBody", "void ApplyTorque(Vector3, ForceMode)", asFUNCTION(RigidBodyApplyTorque), asCALL_CDECL_OBJLAST);
+		m_scriptEngine->RegisterObjectMethod("RigidBody", "void SetRotation(Quaternion)", asFUNCTION(RigidBodySetRotation), asCALL_CDECL_OBJLAST);
+	}
+
+	/*------------------------------------------------------------------------------
+										[PHYSICS]
+	------------------------------------------------------------------------------*/
+	static Physics* physics = nullptr;
+
+	void ConstructorPhysicsQueryBatch(PhysicsQueryBatch* self)
+	{
+		new(self) PhysicsQueryBatch();
+	}
+
+	void CopyConstructorPhysicsQueryBatch(const PhysicsQueryBatch& other, PhysicsQueryBatch* self)
+	{
+		new(self) PhysicsQueryBatch(other);
+	}
+
+	void DestructPhysicsQueryBatch(PhysicsQueryBatch* self)
+	{
+		self->~PhysicsQueryBatch();
+	}
+
+	// Value types can't be passed as &inout, so the batch executes itself. Bullet's queries aren't thread safe.
+	bool PhysicsQueryBatchExecute(PhysicsQueryBatch* self)
+	{
+		if (RejectDeferred("PhysicsQueryBatch::Execute"))
+			return false;
+
+		return physics ? physics->Query(*self) : false;
+	}
+
+	void ScriptInterface::RegisterPhysics() const
+    {
+		physics = m_context->GetSubsystem<Physics>();
+
+		auto r = 0;
+		r = m_scriptEngine->RegisterObjectBehaviour("PhysicsQueryBatch", asBEHAVE_CONSTRUCT, "void f()",							asFUNCTION(ConstructorPhysicsQueryBatch),		asCALL_CDECL_OBJLAST);	SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectBehaviour("PhysicsQueryBatch", asBEHAVE_CONSTRUCT, "void f(const PhysicsQueryBatch &in)",	asFUNCTION(CopyConstructorPhysicsQueryBatch),	asCALL_CDECL_OBJLAST);	SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectBehaviour("PhysicsQueryBatch", asBEHAVE_DESTRUCT, "void f()",							asFUNCTION(DestructPhysicsQueryBatch),			asCALL_CDECL_OBJLAST);	SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("PhysicsQueryBatch", "PhysicsQueryBatch &opAssign(const PhysicsQueryBatch &in)",	asMETHODPR(PhysicsQueryBatch, operator =, (const PhysicsQueryBatch&), PhysicsQueryBatch&), asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("PhysicsQueryBatch", "uint AddRay(const Vector3 &in, const Vector3 &in)",					asMETHOD(PhysicsQueryBatch, AddRay),			asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("PhysicsQueryBatch", "uint AddSweepSphere(const Vector3 &in, const Vector3 &in, float)",	asMETHOD(PhysicsQueryBatch, AddSweepSphere),	asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("PhysicsQueryBatch", "uint AddSweepBox(const Vector3 &in, const Vector3 &in, const Vector3 &in)", asMETHOD(PhysicsQueryBatch, AddSweepBox), asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("PhysicsQueryBatch", "uint AddOverlapSphere(const Vector3 &in, float)",					asMETHOD(PhysicsQueryBatch, AddOverlapSphere),	asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("PhysicsQueryBatch", "uint AddOverlapBox(const Vector3 &in, const Vector3 &in)",			asMETHOD(PhysicsQueryBatch, AddOverlapBox),		asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("PhysicsQueryBatch", "uint GetQueryCount()",												asMETHOD(PhysicsQueryBatch, GetQueryCount),		asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("PhysicsQueryBatch", "void Clear()",														asMETHOD(PhysicsQueryBatch, Clear),				asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("PhysicsQueryBatch", "bool Execute()",													asFUNCTION(PhysicsQueryBatchExecute),			asCALL_CDECL_OBJLAST); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("PhysicsQueryBatch", "bool IsHit(uint)",													asMETHOD(PhysicsQueryBatch, IsHit),				asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("PhysicsQueryBatch", "float GetHitFraction(uint)",										asMETHOD(PhysicsQueryBatch, GetHitFraction),	asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("PhysicsQueryBatch", "const Vector3 &GetHitPosition(uint)",								asMETHOD(PhysicsQueryBatch, GetHitPosition),	asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("PhysicsQueryBatch", "const Vector3 &GetHitNormal(uint)",									asMETHOD(PhysicsQueryBatch, GetHitNormal),		asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("PhysicsQueryBatch", "Entity @GetHitEntity(uint)",										asMETHOD(PhysicsQueryBatch, GetHitEntity),		asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("PhysicsQueryBatch", "uint GetOverlapCount(uint)",										asMETHOD(PhysicsQueryBatch, GetOverlapCount),	asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
+		r = m_scriptEngine->RegisterObjectMethod("PhysicsQueryBatch", "Entity @GetOverlap(uint, uint)",									asMETHOD(PhysicsQueryBatch, GetOverlap),		asCALL_THISCALL); SPARTAN_ASSERT(r >= 0);
 	}
 
 	/*------------------------------------------------------------------------------
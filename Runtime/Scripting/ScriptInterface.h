@@ -37,9 +37,11 @@ namespace Spartan
 		void RegisterTypes() const;
 		void RegisterInput() const;
 		void RegisterEntity();
+		void RegisterCommands() const;
 		void RegisterTransform() const;
 		void RegisterMaterial() const;
 		void RegisterRigidBody() const;
+		void RegisterPhysics() const;
 		void RegisterVector2() const;
 		void RegisterVector3() const;
 		void RegisterQuaternion() const;
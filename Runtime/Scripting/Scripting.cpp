@@ -23,19 +23,32 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Scripting.h"
 #include <scriptstdstring/scriptstdstring.cpp>
 #include "ScriptInterface.h"
+#include "Module.h"
 #include "../Logging/Log.h"
 #include "../Core/FileSystem.h"
 #include "../Core/EventSystem.h"
 #include "../Core/Settings.h"
 #include "../Core/Context.h"
+#include "../Core/Stopwatch.h"
+#include "../Profiling/Profiler.h"
+#include "../Threading/Threading.h"
+#include "../World/World.h"
 //===========================================
 
+//= NAMESPACES ========
+using namespace std;
+//=====================
+
 namespace Spartan
 {
+    // Below this, waking up the job system costs more than running the batch on the main thread
+    static const uint32_t parallel_update_threshold = 64;
+
 	Scripting::Scripting(Context* context) : ISubsystem(context)
 	{
 		// Subscribe to events
 		SUBSCRIBE_TO_EVENT(Event_World_Unload, EVENT_HANDLER(Clear));
+		SUBSCRIBE_TO_EVENT(Event_World_Scripts_Ticked, EVENT_HANDLER(ExecuteUpdates));
 	}
 
 	Scripting::~Scripting()
@@ -51,6 +64,9 @@ namespace Spartan
 
     bool Scripting::Initialize()
     {
+        // Thread safe scripts are executed from the job system threads
+        asPrepareMultithread();
+
         m_scriptEngine = asCreateScriptEngine(ANGELSCRIPT_VERSION);
         if (!m_scriptEngine)
         {
@@ -70,6 +86,12 @@ namespace Spartan
 
         m_scriptEngine->SetEngineProperty(asEP_BUILD_WITHOUT_LINE_CUES, true);
 
+        m_profiler  = m_context->GetSubsystem<Profiler>();
+        m_threading = m_context->GetSubsystem<Threading>();
+
+        // Scripts on the main thread record into the main buffer
+        ScriptCommandBuffer::SetCurrent(&m_commands);
+
         // Get version
         const string major = to_string(ANGELSCRIPT_VERSION).erase(1, 4);
         const string minor = to_string(ANGELSCRIPT_VERSION).erase(0, 1).erase(2, 2);
@@ -81,6 +103,18 @@ namespace Spartan
 
     void Scripting::Clear()
 	{
+        // Updates which were queued but never executed
+        for (auto& batch : m_update_batches)
+        {
+            for (asIScriptObject* obj : batch.second.objects)
+            {
+                obj->Release();
+            }
+        }
+        m_update_batches.clear();
+        m_update_order.clear();
+        m_commands.Clear();
+
 		for (auto& context : m_contexts)
 		{
 			context->Release();
@@ -88,6 +122,16 @@ namespace Spartan
 
 		m_contexts.clear();
 		m_contexts.shrink_to_fit();
+
+        for (auto& context : m_worker_contexts)
+        {
+            context->Release();
+        }
+        m_worker_contexts.clear();
+        m_worker_commands.clear();
+
+        // Instances keep their module alive, so only modules that nothing uses are discarded
+        m_modules.clear();
 	}
 
 	asIScriptEngine* Scripting::GetAsIScriptEngine() const
@@ -156,9 +200,212 @@ namespace Spartan
 		return true;
 	}
 
+    void Scripting::QueueUpdate(asIScriptFunction* function, asIScriptObject* obj, float delta_time)
+    {
+        if (!function || !obj)
+            return;
+
+        UpdateBatch& batch = m_update_batches[function];
+        if (!batch.name)
+        {
+            const asITypeInfo* type = function->GetObjectType();
+            batch.name              = m_update_batch_names.emplace(type ? type->GetName() : function->GetName()).first->c_str();
+            batch.thread_safe       = type && type->Implements(m_scriptEngine->GetTypeInfoByName("ThreadSafe"));
+        }
+
+        if (batch.objects.empty())
+        {
+            m_update_order.emplace_back(function);
+        }
+
+        // Keep the object alive until it has been updated, in case the script gets replaced in the meantime
+        obj->AddRef();
+        batch.objects.emplace_back(obj);
+        m_update_delta_time = delta_time;
+    }
+
+    void Scripting::ExecuteUpdates()
+    {
+        Stopwatch timer;
+        uint32_t update_count           = 0;
+        uint32_t update_count_parallel  = 0;
+
+        // Batches execute in the order they were queued, so the commands are always applied in the same order
+        for (asIScriptFunction* function : m_update_order)
+        {
+            UpdateBatch& batch = m_update_batches[function];
+
+            if (m_profiler) m_profiler->TimeBlockStart(batch.name, TimeBlock_Cpu);
+            if (batch.thread_safe && batch.objects.size() >= parallel_update_threshold)
+            {
+                ExecuteBatchParallel(function, batch.objects, m_update_delta_time, m_commands);
+                update_count_parallel += static_cast<uint32_t>(batch.objects.size());
+            }
+            else
+            {
+                ExecuteBatch(function, batch.objects, m_update_delta_time, m_commands, batch.thread_safe);
+            }
+            if (m_profiler) m_profiler->TimeBlockEnd();
+
+            for (asIScriptObject* obj : batch.objects)
+            {
+                obj->Release();
+            }
+
+            update_count += static_cast<uint32_t>(batch.objects.size());
+            batch.objects.clear();
+        }
+        m_update_order.clear();
+
+        // Apply what the scripts wrote to other entities
+        const uint32_t command_count = static_cast<uint32_t>(m_commands.GetCommands().size());
+        m_commands.Apply(m_context->GetSubsystem<World>());
+        m_commands.Clear();
+
+        if (m_profiler)
+        {
+            m_profiler->m_scripting_updates             = update_count;
+            m_profiler->m_scripting_updates_parallel    = update_count_parallel;
+            m_profiler->m_scripting_commands            = command_count;
+            m_profiler->m_scripting_update_ms           = timer.GetElapsedTimeMs();
+        }
+    }
+
+    // Thread safe scripts are held to the same rules whether their batch runs in parallel or not (deferred), so that they behave the same at any count
+    bool Scripting::ExecuteBatch(asIScriptFunction* function, const vector<asIScriptObject*>& objects, float delta_time, ScriptCommandBuffer& commands, const bool deferred)
+    {
+        ScriptCommandBuffer* previous = ScriptCommandBuffer::GetCurrent();
+        ScriptCommandBuffer::SetCurrent(&commands);
+        ScriptCommandBuffer::SetDeferred(deferred);
+
+        asIScriptContext* ctx   = RequestContext();
+        const bool result       = ExecuteObjects(ctx, function, objects, 0, static_cast<uint32_t>(objects.size()), delta_time);
+        ReturnContext(ctx);
+
+        ScriptCommandBuffer::SetDeferred(false);
+        ScriptCommandBuffer::SetCurrent(previous);
+
+        return result;
+    }
+
+    // The objects are split into one fixed range per worker slot, each with its own context and command buffer. The split
+    // doesn't depend on which thread picks up which slot, so appending the buffers in slot order gives the same commands,
+    // in the same order, as executing the batch serially would.
+    bool Scripting::ExecuteBatchParallel(asIScriptFunction* function, const vector<asIScriptObject*>& objects, float delta_time, ScriptCommandBuffer& commands)
+    {
+        if (!m_threading)
+            return ExecuteBatch(function, objects, delta_time, commands, true);
+
+        // Contexts are created on the main thread, the first time they are needed
+        const uint32_t slot_count = m_threading->GetThreadCount() + 1;
+        while (m_worker_contexts.size() < slot_count)
+        {
+            m_worker_contexts.emplace_back(m_scriptEngine->CreateContext());
+        }
+        m_worker_commands.resize(slot_count);
+
+        const uint32_t object_count = static_cast<uint32_t>(objects.size());
+        atomic<bool> result         = true;
+
+        m_threading->AddTaskLoop([this, function, &objects, object_count, slot_count, delta_time, &result](uint32_t slot_start, uint32_t slot_end)
+        {
+            // The last range runs on the calling thread, so its buffer is restored afterwards
+            ScriptCommandBuffer* previous = ScriptCommandBuffer::GetCurrent();
+            ScriptCommandBuffer::SetDeferred(true);
+
+            for (uint32_t slot = slot_start; slot < slot_end; slot++)
+            {
+                const uint32_t start    = static_cast<uint32_t>((static_cast<uint64_t>(object_count) * slot) / slot_count);
+                const uint32_t end      = static_cast<uint32_t>((static_cast<uint64_t>(object_count) * (slot + 1)) / slot_count);
+
+                ScriptCommandBuffer::SetCurrent(&m_worker_commands[slot]);
+                if (!ExecuteObjects(m_worker_contexts[slot], function, objects, start, end, delta_time))
+                {
+                    result = false;
+                }
+                m_worker_contexts[slot]->Unprepare();
+            }
+
+            ScriptCommandBuffer::SetDeferred(false);
+            ScriptCommandBuffer::SetCurrent(previous);
+        }, slot_count);
+
+        for (ScriptCommandBuffer& worker_commands : m_worker_commands)
+        {
+            commands.Append(worker_commands);
+            worker_commands.Clear();
+        }
+
+        return result;
+    }
+
+    // A single context is prepared for all the objects, since preparing it for the function it's already
+    // prepared for only resets its stack.
+    bool Scripting::ExecuteObjects(asIScriptContext* ctx, asIScriptFunction* function, const vector<asIScriptObject*>& objects, const uint32_t start, const uint32_t end, const float delta_time)
+    {
+        bool result = true;
+        for (uint32_t i = start; i < end; i++)
+        {
+            if (ctx->Prepare(function) < 0)
+                return false;
+
+            ctx->SetObject(objects[i]);
+            ctx->SetArgFloat(0, delta_time);
+
+            // Output any exceptions, an object that throws doesn't stop the rest of the batch
+            if (ctx->Execute() == asEXECUTION_EXCEPTION)
+            {
+                LogExceptionInfo(ctx);
+                result = false;
+            }
+        }
+
+        return result;
+    }
+
 	/*------------------------------------------------------------------------------
 										[MODULE]
 	------------------------------------------------------------------------------*/
+    shared_ptr<Module> Scripting::GetModule(const string& script_path)
+    {
+        shared_ptr<Module> module;
+        auto it = m_modules.find(script_path);
+        if (it != m_modules.end())
+        {
+            module = it->second;
+        }
+        else
+        {
+            module = LoadModule(script_path, script_path);
+            if (!module)
+                return nullptr;
+
+            m_modules[script_path] = module;
+        }
+
+        if (module->GetAsIScriptModule()->GetGlobalVarCount() == 0)
+            return module;
+
+        // The script has global variables, so the instance gets its own copy of them (loaded from the bytecode the shared module just cached)
+        return LoadModule(script_path, script_path + "_" + to_string(m_module_instance_count++));
+    }
+
+    shared_ptr<Module> Scripting::LoadModule(const string& script_path, const string& module_name)
+    {
+        auto module = make_shared<Module>(module_name, this);
+        if (!module->LoadScript(script_path))
+            return nullptr;
+
+        module->IsFromCache() ? m_cache_hits++ : m_cache_misses++;
+        if (m_profiler)
+        {
+            m_profiler->m_scripting_cache_hits      = m_cache_hits;
+            m_profiler->m_scripting_cache_misses    = m_cache_misses;
+        }
+
+        return module;
+    }
+
 	void Scripting::DiscardModule(const string& moduleName) const
     {
 		m_scriptEngine->DiscardModule(moduleName.c_str());
@@ -24,7 +24,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ==================
 #include <vector>
 #include <string>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include "../Core/ISubsystem.h"
+#include "ScriptCommandBuffer.h"
 //=============================
 
 //= FORWARD DECLARATIONS =
@@ -41,8 +45,10 @@ struct asSMessageInfo;
 namespace Spartan
 {
 	class Module;
+	class Profiler;
+	class Threading;
 
-	class Scripting : public ISubsystem
+	class SPARTAN_CLASS Scripting : public ISubsystem
 	{
 	public:
 		Scripting(Context* context);
@@ -62,12 +68,46 @@ namespace Spartan
 		// Calls
 		bool ExecuteCall(asIScriptFunction* scriptFunc, asIScriptObject* obj, float delta_time = -1.0f);
 
-		// Modules
+        // Updates are batched per script class and executed once the world has ticked the scripts of all of its entities, before
+        // it ticks their other components. Classes which implement the ThreadSafe interface are updated in parallel, and their
+        // writes to other entities are deferred.
+        void QueueUpdate(asIScriptFunction* function, asIScriptObject* obj, float delta_time);
+        void ExecuteUpdates();
+
+		// Modules, one per script and shared by all of its instances (so that they share their update batch). Global variables
+		// belong to the module though, so every instance of a script which declares any gets a module of its own.
+        std::shared_ptr<Module> GetModule(const std::string& script_path);
 		void DiscardModule(const std::string& moduleName) const;
 
 	private:
+        // The queued updates of one script class
+        struct UpdateBatch
+        {
+            const char* name    = nullptr; // class name, for the profiler
+            bool thread_safe    = false;
+            std::vector<asIScriptObject*> objects;
+        };
+
+        std::shared_ptr<Module> LoadModule(const std::string& script_path, const std::string& module_name);
+        bool ExecuteBatch(asIScriptFunction* function, const std::vector<asIScriptObject*>& objects, float delta_time, ScriptCommandBuffer& commands, bool deferred);
+        bool ExecuteBatchParallel(asIScriptFunction* function, const std::vector<asIScriptObject*>& objects, float delta_time, ScriptCommandBuffer& commands);
+        bool ExecuteObjects(asIScriptContext* ctx, asIScriptFunction* function, const std::vector<asIScriptObject*>& objects, uint32_t start, uint32_t end, float delta_time);
+
         asIScriptEngine* m_scriptEngine = nullptr;
 		std::vector<asIScriptContext*> m_contexts;
+        std::unordered_map<std::string, std::shared_ptr<Module>> m_modules; // script path -> shared module
+        uint32_t m_module_instance_count = 0; // names the modules of scripts with global variables
+        std::unordered_map<asIScriptFunction*, UpdateBatch> m_update_batches;
+        std::vector<asIScriptFunction*> m_update_order; // batches in the order they were first queued this tick, which follows the world's entity order
+        std::vector<asIScriptContext*> m_worker_contexts; // one per job system thread, plus one for the main thread
+        std::vector<ScriptCommandBuffer> m_worker_commands;
+        ScriptCommandBuffer m_commands; // applied once the updates have executed
+        std::unordered_set<std::string> m_update_batch_names; // outlive the batches, the profiler keeps their names around
+        float m_update_delta_time   = 0.0f;
+        uint32_t m_cache_hits       = 0;
+        uint32_t m_cache_misses     = 0;
+        Profiler* m_profiler        = nullptr;
+        Threading* m_threading      = nullptr;
 
 		void LogExceptionInfo(asIScriptContext* ctx) const;
 		void message_callback(const asSMessageInfo& msg) const;
@@ -25,7 +25,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <vector>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
 #include <deque>
+#include <atomic>
 #include <unordered_map>
 #include <functional>
 #include "../Logging/Log.h"
@@ -48,6 +50,33 @@ namespace Spartan
 		function_type m_function;
 	};
 
+    // Tracks the chunks of a loop added with Threading::AddTaskLoop()
+    struct TaskLoop
+    {
+        TaskLoop(uint32_t chunk_count) { this->chunk_count = chunk_count; }
+
+        void ChunkDone()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (++chunks_done == chunk_count)
+            {
+                condition.notify_all();
+            }
+        }
+
+        void Wait()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this] { return chunks_done == chunk_count; });
+        }
+
+        std::atomic<uint32_t> chunk_next    = 0;
+        uint32_t chunk_count                = 0;
+        uint32_t chunks_done                = 0;
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+
 	class Threading : public ISubsystem
 	{
 	public:
@@ -78,38 +107,46 @@ namespace Spartan
 			m_condition_var.notify_one();
 		}
 
-        // Adds a task which is a loop and executes chunks of it in parallel
+        // Adds a task which is a loop and executes chunks of it in parallel. The range is split in chunk_count chunks
+        // (one per thread if zero) of range / chunk_count rounded up. The calling thread works on chunks too, so the loop
+        // completes even when the pool is busy, and then sleeps until the chunks which workers picked up are done.
         template <typename Function>
-        void AddTaskLoop(Function&& function, uint32_t range)
+        void AddTaskLoop(Function&& function, uint32_t range, uint32_t chunk_count = 0)
         {
-            uint32_t available_threads  = GetThreadsAvailable();
-            vector<bool> tasks_done     = vector<bool>(available_threads, false);
-            const uint32_t task_count   = available_threads + 1; // plus one for the current thread
-
-            uint32_t start  = 0;
-            uint32_t end    = 0;
-            for (uint32_t i = 0; i < available_threads; i++)
-            {
-                start   = (range / task_count) * i;
-                end     = start + (range / task_count);
-
-                // Kick off task
-                AddTask([&function, &tasks_done, i, start, end] { function(start, end); tasks_done[i] = true; });
-            }
+            if (range == 0)
+                return;
 
-            // Do last task in the current thread
-            function(end, range);
+            chunk_count                 = chunk_count == 0 ? m_thread_count + 1 : chunk_count; // plus one for the current thread
+            chunk_count                 = chunk_count < range ? chunk_count : range;
+            const uint32_t chunk_size   = (range + chunk_count - 1) / chunk_count;
 
-            // Wait till the threads are done
-            uint32_t tasks = 0;
-            while (tasks != tasks_done.size())
+            // Queued tasks which find no chunks left return without touching the function, so it can be captured by reference
+            auto loop = std::make_shared<TaskLoop>(chunk_count);
+            auto execute_chunks = [loop, &function, range, chunk_size]()
             {
-                tasks = 0;
-                for (const bool job_done : tasks_done)
+                for (uint32_t chunk = loop->chunk_next++; chunk < loop->chunk_count; chunk = loop->chunk_next++)
                 {
-                    tasks += job_done ? 1 : 0;
+                    const uint32_t start = chunk * chunk_size;
+                    if (start < range)
+                    {
+                        function(start, start + chunk_size < range ? start + chunk_size : range);
+                    }
+                    loop->ChunkDone();
                 }
+            };
+
+            // Kick off tasks, no more than there are threads to pick them up
+            const uint32_t task_count = chunk_count - 1 < m_thread_count ? chunk_count - 1 : m_thread_count;
+            for (uint32_t i = 0; i < task_count; i++)
+            {
+                AddTask(execute_chunks);
             }
+
+            // Work in the current thread
+            execute_chunks();
+
+            // Wait for chunks which are still executing in other threads
+            loop->Wait();
         }
 
         // Get the number of threads used
@@ -21,6 +21,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #pragma once
 
+//= INCLUDES ======
+#include <cstdint>
+#include <cstring>
+//=================
+
 namespace Spartan::Utility::Hash
 {
     template <class T>
@@ -29,4 +34,52 @@ namespace Spartan::Utility::Hash
         std::hash<T> hasher;
         seed ^= hasher(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
     }
+
+    // XXH64's short input path (used for any size, so it only matches XXH64 below 32 bytes), for hashing plain data as a whole
+    inline uint64_t hash_64(const void* data, const size_t size, const uint64_t seed = 0)
+    {
+        constexpr uint64_t prime_1 = 11400714785074694791ULL;
+        constexpr uint64_t prime_2 = 14029467366897019727ULL;
+        constexpr uint64_t prime_3 = 1609587929392839161ULL;
+        constexpr uint64_t prime_4 = 9650029242287828579ULL;
+        constexpr uint64_t prime_5 = 2870177450012600261ULL;
+
+        const auto rotl = [](const uint64_t x, const int r) { return (x << r) | (x >> (64 - r)); };
+
+        const uint8_t* bytes    = static_cast<const uint8_t*>(data);
+        const uint8_t* end      = bytes + size;
+        uint64_t hash           = seed + prime_5 + static_cast<uint64_t>(size);
+
+        for (; bytes + 8 <= end; bytes += 8)
+        {
+            uint64_t word;
+            memcpy(&word, bytes, sizeof(word));
+            hash ^= rotl(word * prime_2, 31) * prime_1;
+            hash  = rotl(hash, 27) * prime_1 + prime_4;
+        }
+
+        if (bytes + 4 <= end)
+        {
+            uint32_t word;
+            memcpy(&word, bytes, sizeof(word));
+            hash ^= static_cast<uint64_t>(word) * prime_1;
+            hash  = rotl(hash, 23) * prime_2 + prime_3;
+            bytes += 4;
+        }
+
+        for (; bytes < end; bytes++)
+        {
+            hash ^= static_cast<uint64_t>(*bytes) * prime_5;
+            hash  = rotl(hash, 11) * prime_1;
+        }
+
+        // Avalanche
+        hash ^= hash >> 33;
+        hash *= prime_2;
+        hash ^= hash >> 29;
+        hash *= prime_3;
+        hash ^= hash >> 32;
+
+        return hash;
+    }
 }
@@ -42,6 +42,6 @@ namespace Spartan
 		if (!m_audio)
 			return;
 
-		m_audio->SetListenerTransform(GetTransform());
+		m_audio->SetListenerTransform(GetTransform(), delta_time);
 	}
 }
@@ -80,7 +80,7 @@ namespace Spartan
 		if (!m_audio_clip)
 			return;
 	
-		m_audio_clip->Update();
+		m_audio_clip->Update(delta_time);
 	}
 	
 	void AudioSource::Serialize(FileStream* stream)
@@ -62,16 +62,26 @@ namespace Spartan
 			m_isDirty			    = true;
 		}
 
+        FpsControl(delta_time);
+        UpdateMatrices();
+	}
+
+    void Camera::Interpolate(const float alpha)
+    {
+        GetTransform()->Interpolate(alpha);
+        UpdateMatrices();
+    }
+
+    void Camera::UpdateMatrices()
+    {
 		// DIRTY CHECK
-		if (m_position != GetTransform()->GetPosition() || m_rotation != GetTransform()->GetRotation())
+		if (m_position != GetTransform()->GetPositionInterpolated() || m_rotation != GetTransform()->GetRotationInterpolated())
 		{
-			m_position = GetTransform()->GetPosition();
-			m_rotation = GetTransform()->GetRotation();
+			m_position = GetTransform()->GetPositionInterpolated();
+			m_rotation = GetTransform()->GetRotationInterpolated();
 			m_isDirty = true;
 		}
 
-        FpsControl(delta_time);
-       
 		if (!m_isDirty)
 			return;
 
@@ -355,9 +365,9 @@ namespace Spartan
 
     Matrix Camera::ComputeViewMatrix() const
     {
-		const auto position	= GetTransform()->GetPosition();
-		auto look_at		= GetTransform()->GetRotation() * Vector3::Forward;
-		const auto up		= GetTransform()->GetRotation() * Vector3::Up;
+		const auto position	= GetTransform()->GetPositionInterpolated();
+		auto look_at		= GetTransform()->GetRotationInterpolated() * Vector3::Forward;
+		const auto up		= GetTransform()->GetRotationInterpolated() * Vector3::Up;
 
 		// offset look_at by current position
 		look_at += position;
@@ -64,6 +64,7 @@ namespace Spartan
 		const Math::Matrix& GetViewMatrix()             const { return m_view; }
         const Math::Matrix& GetProjectionMatrix()       const { return m_projection; }
         const Math::Matrix& GetViewProjectionMatrix()   const { return m_view_projection; }
+        void Interpolate(float alpha); // Fixed timestep - view from the interpolated transform
 		//=================================================================================
 
 		//= RAYCASTING =================================================================
@@ -112,6 +113,7 @@ namespace Spartan
 
 	private:
         void FpsControl(float delta_time);
+        void UpdateMatrices();
 
         float m_fov_horizontal_rad          = Math::Helper::DegreesToRadians(90.0f);
         float m_near_plane                  = 0.3f;
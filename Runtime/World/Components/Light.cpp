@@ -27,8 +27,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../World.h"
 #include "../../IO/FileStream.h"
 #include "../../Rendering/Renderer.h"
+#include "../../Rendering/ShadowAtlas.h"
 #include "../../RHI/RHI_Texture2D.h"
-#include "../../RHI/RHI_TextureCube.h"
 //====================================
 
 //= NAMESPACES ===============
@@ -81,11 +81,26 @@ namespace Spartan
             m_initialized = true;
         }
 
+        UpdateMatrices();
+    }
+
+    void Light::Interpolate(const float alpha)
+    {
+        GetTransform()->Interpolate(alpha);
+
+        if (m_renderer && m_initialized)
+        {
+            UpdateMatrices();
+        }
+    }
+
+    void Light::UpdateMatrices()
+    {
 		// Position and rotation dirty check
-		if (m_previous_pos != GetTransform()->GetPosition() || m_previous_rot != GetTransform()->GetRotation())
+		if (m_previous_pos != GetTransform()->GetPositionInterpolated() || m_previous_rot != GetTransform()->GetRotationInterpolated())
 		{
-			m_previous_pos = GetTransform()->GetPosition();
-			m_previous_rot = GetTransform()->GetRotation();
+			m_previous_pos = GetTransform()->GetPositionInterpolated();
+			m_previous_rot = GetTransform()->GetRotationInterpolated();
 
 			m_is_dirty = true;
 		}
@@ -116,12 +131,9 @@ namespace Spartan
 
             ComputeViewMatrix();
 
-            if (m_shadow_map.texture_depth)
+            for (uint32_t i = 0; i < static_cast<uint32_t>(m_shadow_map.slices.size()); i++)
             {
-                for (uint32_t i = 0; i < m_shadow_map.texture_depth->GetArraySize(); i++)
-                {
-                    ComputeProjectionMatrix(i);
-                }
+                ComputeProjectionMatrix(i);
             }
         }
 
@@ -216,7 +228,7 @@ namespace Spartan
 
 	Vector3 Light::GetDirection() const
     {
-		return GetTransform()->GetForward();
+		return GetTransform()->GetForwardInterpolated();
 	}
 
 	void Light::ComputeViewMatrix()
@@ -237,16 +249,16 @@ namespace Spartan
 		}
 		else if (m_light_type == LightType_Spot)
 		{   
-            const Vector3 position  = GetTransform()->GetPosition();
-            const Vector3 forward	= GetTransform()->GetForward();
-            const Vector3 up		= GetTransform()->GetUp();
+            const Vector3 position  = GetTransform()->GetPositionInterpolated();
+            const Vector3 forward	= GetTransform()->GetForwardInterpolated();
+            const Vector3 up		= GetTransform()->GetUpInterpolated();
 
 			// Compute
 			m_matrix_view[0] = Matrix::CreateLookAtLH(position, position + forward, up);
 		}
 		else if (m_light_type == LightType_Point)
 		{
-            const Vector3 position = GetTransform()->GetPosition();
+            const Vector3 position = GetTransform()->GetPositionInterpolated();
 
 			// Compute view for each side of the cube map
 			m_matrix_view[0] = Matrix::CreateLookAtLH(position, position + Vector3::Right,		Vector3::Up);		// x+
@@ -260,7 +272,7 @@ namespace Spartan
 
 	bool Light::ComputeProjectionMatrix(uint32_t index /*= 0*/)
 	{
-		if (index >= m_shadow_map.texture_depth->GetArraySize())
+		if (index >= static_cast<uint32_t>(m_shadow_map.slices.size()))
         {
             LOG_ERROR_INVALID_PARAMETER();
             return false;
@@ -279,9 +291,7 @@ namespace Spartan
 		}
 		else
 		{
-			const float width			= static_cast<float>(m_shadow_map.texture_depth->GetWidth());
-			const float height			= static_cast<float>(m_shadow_map.texture_depth->GetHeight());
-			const auto aspect_ratio		= width / height;
+			const auto aspect_ratio		= 1.0f; // atlas tiles are square
 			const float fov				= 1.57079633f; // 1.57079633 = 90 deg
 			const float near_plane		= reverse_z ? m_range : 0.1f;
 			const float far_plane		= reverse_z ? 0.1f : m_range;
@@ -316,7 +326,7 @@ namespace Spartan
 
     void Light::ComputeCascadeSplits()
     {
-        if (m_shadow_map.slices.empty())
+        if (m_shadow_map.slices.empty() || !m_shadow_map.texture_depth)
             return;
 
         // Can happen during the first frame, don't log error
@@ -326,7 +336,8 @@ namespace Spartan
         Camera* camera                        = m_renderer->GetCamera().get();
         const float clip_near                 = camera->GetNearPlane();
         const float clip_far                  = camera->GetFarPlane();
-        const Matrix view_projection_inverted = Matrix::Invert(camera->GetViewMatrix() * camera->ComputeProjection(false));
+        const Matrix view_inverted            = Matrix::Invert(camera->GetViewMatrix());
+        const Matrix projection_inverted      = Matrix::Invert(camera->ComputeProjection(false));
 
         // Calculate split depths based on view camera frustum
         // Based on method presented in https://developer.nvidia.com/gpugems/GPUGems3/gpugems3_ch10.html
@@ -361,10 +372,11 @@ namespace Spartan
                 Vector3(-1.0f, -1.0f,  1.0f)
             };
 
-            // Project frustum corners into world space
+            // Project frustum corners into view space, so that the bounds (unlike world space ones, which lose precision
+            // far from the origin) are exactly the same wherever the camera is and whichever way it's facing
             for (Vector3& frustum_corner : frustum_corners)
             {
-                Vector4 inverted_corner = Vector4(frustum_corner, 1.0f) * view_projection_inverted;
+                Vector4 inverted_corner = Vector4(frustum_corner, 1.0f) * projection_inverted;
                 frustum_corner = inverted_corner / inverted_corner.w;
             }
 
@@ -407,7 +419,29 @@ namespace Spartan
                     const float distance = Vector3::Distance(frustum_corner, shadow_slice.center);
                     radius = Helper::Max(radius, distance);
                 }
-                radius = Helper::Ceil(radius * 16.0f) / 16.0f;
+                radius = Helper::Ceil(radius * 1.125f * 16.0f) / 16.0f; // the extra room covers the snapping below
+
+                // Move the center into world space
+                shadow_slice.center = Vector4(shadow_slice.center, 1.0f) * view_inverted;
+
+                // Snap the center to a grid in light space, so the cascade only moves once the camera has travelled a tenth of it,
+                // instead of every frame, which is what allows the static casters to stay cached. The grid step is a whole number
+                // of texels, so the shadow edges don't shimmer either. The center moves by at most 0.87 steps, well within the extra room.
+                {
+                    const Vector3 forward   = GetDirection();
+                    Vector3 right           = Vector3::Cross(Vector3::Up, forward);
+                    right                   = right.Length() > 0.001f ? right.Normalized() : Vector3::Right;
+                    const Vector3 up        = Vector3::Cross(forward, right);
+
+                    const float texel_size  = 2.0f * radius / static_cast<float>(m_shadow_map.texture_depth->GetWidth());
+                    const float step        = Helper::Max(Helper::Round(radius * 0.1f / texel_size), 1.0f) * texel_size;
+                    const auto snap         = [step](const float value) { return Helper::Floor(value / step + 0.5f) * step; };
+
+                    shadow_slice.center =
+                        right   * snap(Vector3::Dot(shadow_slice.center, right)) +
+                        up      * snap(Vector3::Dot(shadow_slice.center, up)) +
+                        forward * snap(Vector3::Dot(shadow_slice.center, forward));
+                }
 
                 // Compute min and max
                 shadow_slice.max = radius;
@@ -418,7 +452,7 @@ namespace Spartan
 
     uint32_t Light::GetShadowArraySize() const
     {
-        return m_shadow_map.texture_depth ? m_shadow_map.texture_depth->GetArraySize() : 0;
+        return HasShadowMap() ? static_cast<uint32_t>(m_shadow_map.slices.size()) : 0;
     }
 
     void Light::CreateShadowMap()
@@ -456,33 +490,110 @@ namespace Spartan
 
             m_shadow_map.slices = vector<ShadowSlice>(m_cascade_count);
 		}
-		else if (GetLightType() == LightType_Point)
+		else
 		{
-            m_shadow_map.texture_depth = make_unique<RHI_TextureCube>(m_context, resolution, resolution, RHI_Format_D32_Float);
+            // Point and spot lights render into the renderer's shadow atlas, one tile per cube face or a single tile
+            m_shadow_map.texture_depth.reset();
+            m_shadow_map.texture_color.reset();
+            m_shadow_map.slices = vector<ShadowSlice>(GetLightType() == LightType_Point ? 6 : 1);
+		}
 
-            if (m_shadows_transparent_enabled)
-            {
-                m_shadow_map.texture_color = make_unique<RHI_TextureCube>(m_context, resolution, resolution, RHI_Format_R8G8B8A8_Unorm);
-            }
+        CreateShadowCache();
+	}
 
-            m_shadow_map.slices = vector<ShadowSlice>(6);
-		}
-		else if (GetLightType() == LightType_Spot)
-		{
-            m_shadow_map.texture_depth  = make_unique<RHI_Texture2D>(m_context, resolution, resolution, RHI_Format_D32_Float, 1);
+    void Light::CreateShadowCache()
+    {
+        if (!m_renderer)
+            return;
 
-            if (m_shadows_transparent_enabled)
+        // The cache of a slice has the size of the slice, which for point and spot lights is their atlas tile
+        const bool enabled          = m_renderer->GetOption(Render_ShadowCaching);
+        const uint32_t resolution   = m_light_type == LightType_Directional ? (m_shadow_map.texture_depth ? m_shadow_map.texture_depth->GetWidth() : 0) : m_shadow_atlas_tile_size;
+
+        for (ShadowSlice& slice : m_shadow_map.slices)
+        {
+            if (enabled && resolution != 0 && (!slice.texture_static || slice.texture_static->GetWidth() != resolution))
+            {
+                slice.texture_static = make_shared<RHI_Texture2D>(m_context, resolution, resolution, RHI_Format_D32_Float);
+            }
+            else if (!enabled || resolution == 0)
             {
-                m_shadow_map.texture_color = make_unique<RHI_Texture2D>(m_context, resolution, resolution, RHI_Format_R8G8B8A8_Unorm, 1);
+                slice.texture_static.reset();
             }
 
-            m_shadow_map.slices = vector<ShadowSlice>(1);
-		}
-	}
+            // Whatever was cached, it has to be rendered again
+            slice.static_signature = 0;
+        }
+    }
+
+    void Light::SetShadowAtlasTiles(const ShadowAtlasRequest& request)
+    {
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_shadow_atlas_tiles.size()); i++)
+        {
+            const ShadowAtlasTile& tile = request.tiles[i];
+            m_shadow_atlas_tiles[i]     = Vector4(static_cast<float>(tile.x), static_cast<float>(tile.y), static_cast<float>(tile.size), static_cast<float>(tile.size));
+        }
+
+        if (m_shadow_atlas_tile_size != request.tiles[0].size)
+        {
+            m_shadow_atlas_tile_size = request.tiles[0].size;
+            CreateShadowCache();
+        }
+    }
+
+    const Vector4& Light::GetShadowAtlasTile(const uint32_t index) const
+    {
+        if (index >= static_cast<uint32_t>(m_shadow_atlas_tiles.size()))
+        {
+            LOG_ERROR_INVALID_PARAMETER();
+            return Vector4::Zero;
+        }
+
+        return m_shadow_atlas_tiles[index];
+    }
+
+    bool Light::HasShadowMap() const
+    {
+        if (!m_shadows_enabled)
+            return false;
+
+        return m_light_type == LightType_Directional ? m_shadow_map.texture_depth != nullptr : m_shadow_atlas_tile_size != 0;
+    }
+
+    RHI_Texture* Light::GetShadowCacheTexture(const uint32_t index) const
+    {
+        return index < m_shadow_map.slices.size() ? m_shadow_map.slices[index].texture_static.get() : nullptr;
+    }
+
+    bool Light::IsShadowCacheValid(const uint32_t index, const uint64_t signature) const
+    {
+        return index < m_shadow_map.slices.size() && m_shadow_map.slices[index].static_signature == signature;
+    }
+
+    void Light::SetShadowCacheSignature(const uint32_t index, const uint64_t signature)
+    {
+        if (index >= m_shadow_map.slices.size())
+        {
+            LOG_ERROR_INVALID_PARAMETER();
+            return;
+        }
+
+        m_shadow_map.slices[index].static_signature = signature;
+        m_shadow_map.slices[index].redraw_count++;
+    }
+
+    uint32_t Light::GetShadowCacheRedrawCount(const uint32_t index) const
+    {
+        return index < m_shadow_map.slices.size() ? m_shadow_map.slices[index].redraw_count : 0;
+    }
 
     bool Light::IsInViewFrustrum(Renderable* renderable, uint32_t index) const
     {
-        const auto box          = renderable->GetAabb();
+        return IsInViewFrustrum(renderable->GetAabb(), index);
+    }
+
+    bool Light::IsInViewFrustrum(const BoundingBox& box, uint32_t index) const
+    {
         const auto center       = box.GetCenter();
         const auto extents      = box.GetExtents();
 
@@ -37,6 +37,8 @@ namespace Spartan
 	class Camera;
 	class Renderable;
 	class Renderer;
+    struct ShadowAtlasRequest;
+    namespace Math { class BoundingBox; }
 
 	enum LightType
 	{
@@ -51,6 +53,9 @@ namespace Spartan
         Math::Vector3 max       = Math::Vector3::Zero;
         Math::Vector3 center    = Math::Vector3::Zero;
         Math::Frustum frustum;
+        std::shared_ptr<RHI_Texture> texture_static;    // depth of the static casters, the dynamic ones are drawn on top of it every frame
+        uint64_t static_signature   = 0;                // view projection and static casters the cached depth was rendered with
+        uint32_t redraw_count       = 0;                // times the static casters were re-rendered
     };
 
     struct ShadowMap
@@ -118,9 +123,27 @@ namespace Spartan
         uint32_t GetShadowArraySize() const;
         void CreateShadowMap();
 
+        // Shadow atlas (point and spot lights), the renderer assigns the tiles every frame
+        void SetShadowAtlasTiles(const ShadowAtlasRequest& request);
+        uint32_t GetShadowAtlasTileSize() const { return m_shadow_atlas_tile_size; }
+        const Math::Vector4& GetShadowAtlasTile(uint32_t index) const; // x, y, width and height in texels
+        bool HasShadowMap() const; // false for point and spot lights which didn't fit in the atlas
+
+        // Shadow caching, the renderer re-renders the static casters of a slice only when its signature changes
+        void CreateShadowCache();
+        RHI_Texture* GetShadowCacheTexture(uint32_t index) const;
+        bool IsShadowCacheValid(uint32_t index, uint64_t signature) const;
+        void SetShadowCacheSignature(uint32_t index, uint64_t signature); // counts as a redraw
+        uint32_t GetShadowCacheRedrawCount(uint32_t index) const;
+
         bool IsInViewFrustrum(Renderable* renderable, uint32_t index) const;
+        bool IsInViewFrustrum(const Math::BoundingBox& box, uint32_t index) const;
+
+        // Fixed timestep - shadow matrices from the interpolated transform
+        void Interpolate(float alpha);
 
 	private:
+        void UpdateMatrices();
 		void ComputeViewMatrix();
 		bool ComputeProjectionMatrix(uint32_t index = 0);
         void ComputeCascadeSplits();
@@ -145,6 +168,8 @@ namespace Spartan
         Math::Vector3 m_previous_pos        = Math::Vector3::Infinity;
         Math::Matrix m_previous_camera_view = Math::Matrix::Identity;    	
         ShadowMap m_shadow_map;
+        std::array<Math::Vector4, 6> m_shadow_atlas_tiles;
+        uint32_t m_shadow_atlas_tile_size   = 0;
 
 		Renderer* m_renderer;
 	};
@@ -30,6 +30,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../../Physics/Physics.h"
 #include "../../Physics/BulletPhysicsHelper.h"
 #include "../../IO/FileStream.h"
+#include "../../Profiling/Profiler.h"
 #pragma warning(push, 0) // Hide warnings which belong to Bullet
 #include "BulletDynamics/Dynamics/btRigidBody.h"
 #include <BulletCollision/CollisionShapes/btCollisionShape.h>
@@ -52,7 +53,12 @@ namespace Spartan
 	class MotionState : public btMotionState
 	{
 	public:
-		MotionState(RigidBody* rigidBody) { m_rigidBody = rigidBody; }
+		MotionState(RigidBody* rigidBody, Physics* physics)
+		{
+			m_rigidBody = rigidBody;
+			m_physics   = physics;
+			m_world_transform.setIdentity();
+		}
 
 		// Update from engine, ENGINE -> BULLET
 		void getWorldTransform(btTransform& worldTrans) const override
@@ -64,22 +70,33 @@ namespace Spartan
 			worldTrans.setRotation(ToBtQuaternion(lastRot));
 		}
 
-		// Update from bullet, BULLET -> ENGINE
+		// Update from bullet, BULLET -> ENGINE (deferred, Bullet calls this for every active body after every sub-step)
 		void setWorldTransform(const btTransform& worldTrans) override
 		{
-            const Quaternion newWorldRot	= ToQuaternion(worldTrans.getRotation());
-            const Vector3 newWorldPos		= ToVector3(worldTrans.getOrigin()) - newWorldRot * m_rigidBody->GetCenterOfMass();
+			m_world_transform = worldTrans;
 
-			m_rigidBody->GetTransform()->SetPosition(newWorldPos);
-			m_rigidBody->GetTransform()->SetRotation(newWorldRot);
+			// Queue once, until synced only the latest transform matters
+			if (!m_sync_pending)
+			{
+				m_sync_pending = true;
+				m_physics->QueueTransformSync(m_rigidBody);
+			}
 		}
+
+		const btTransform& GetWorldTransform() const { return m_world_transform; }
+		void OnSynced() { m_sync_pending = false; }
+
     private:
         RigidBody* m_rigidBody;
+		Physics* m_physics;
+		btTransform m_world_transform;
+		bool m_sync_pending = false;
 	};
 
 	RigidBody::RigidBody(Context* context, Entity* entity, uint32_t id /*= 0*/) : IComponent(context, entity, id)
 	{
-        m_physics = GetContext()->GetSubsystem<Physics>();
+        m_physics   = GetContext()->GetSubsystem<Physics>();
+        m_profiler  = GetContext()->GetSubsystem<Profiler>();
 
 		m_in_world			= false;
 		m_mass				= DEFAULT_MASS;
@@ -132,6 +149,13 @@ namespace Spartan
 		// When the rigid body is inactive or we are in editor mode, allow the user to move/rotate it
 		if (!IsActivated() || !m_context->m_engine->EngineMode_IsSet(Engine_Game))
 		{
+            // Nothing to push unless the transform changed since the last sync
+            if (GetTransform()->GetMatrix() == m_matrix_synced)
+                return;
+
+            m_matrix_synced = GetTransform()->GetMatrix();
+            m_profiler->m_physics_bodies_pushed++;
+
             if (GetPosition() != GetTransform()->GetPosition())
             {
                 SetPosition(GetTransform()->GetPosition(), false);
@@ -497,6 +521,21 @@ namespace Spartan
 		}
 	}
 
+	void RigidBody::SyncTransform()
+	{
+		if (!m_rigidBody)
+			return;
+
+		MotionState* motion_state           = static_cast<MotionState*>(m_rigidBody->getMotionState());
+		const btTransform& world_transform  = motion_state->GetWorldTransform();
+		motion_state->OnSynced();
+		const Quaternion rotation           = ToQuaternion(world_transform.getRotation());
+		const Vector3 position              = ToVector3(world_transform.getOrigin()) - rotation * m_center_of_mass;
+
+		GetTransform()->SetPositionAndRotation(position, rotation);
+		m_matrix_synced = GetTransform()->GetMatrix();
+	}
+
 	void RigidBody::Body_AddToWorld()
 	{
 		if (m_mass < 0.0f)
@@ -517,7 +556,7 @@ namespace Spartan
 		// CONSTRUCTION
 		{
 			// Create a motion state (memory will be freed by the RigidBody)
-            const auto motion_state = new MotionState(this);
+            const auto motion_state = new MotionState(this, m_physics);
 			
 			// Info
 			btRigidBody::btRigidBodyConstructionInfo constructionInfo(m_mass, motion_state, m_collision_shape, local_intertia);
@@ -545,6 +584,7 @@ namespace Spartan
 		// Transform
 		SetPosition(GetTransform()->GetPosition());
 		SetRotation(GetTransform()->GetRotation());
+		m_matrix_synced = GetTransform()->GetMatrix();
 
 		// Constraints
 		SetPositionLock(m_position_lock);
@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "IComponent.h"
 #include <vector>
 #include "../../Math/Vector3.h"
+#include "../../Math/Matrix.h"
 //=============================
 
 class btRigidBody;
@@ -35,7 +36,7 @@ namespace Spartan
 	class Entity;
 	class Constraint;
 	class Physics;
-	namespace Math { class Quaternion; }
+	class Profiler;
 
 	enum ForceMode
 	{
@@ -138,6 +139,9 @@ namespace Spartan
 		void RemoveConstraint(Constraint* constraint);
 		void SetShape(btCollisionShape* shape);
 
+		// Writes the pose that Bullet reported during the last step into the transform
+		void SyncTransform();
+
 	private:
 		void Body_AddToWorld();
 		void Body_Release();
@@ -162,6 +166,8 @@ namespace Spartan
 		btCollisionShape* m_collision_shape = nullptr;
         bool m_in_world                     = false;
 		Physics* m_physics                  = nullptr;
+		Profiler* m_profiler                = nullptr;
+		Math::Matrix m_matrix_synced; // the transform as of the last sync with Bullet, in either direction
         std::vector<Constraint*> m_constraints;
 	};
 }
@@ -19,21 +19,24 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
-//= INCLUDES ============================
+//= INCLUDES ===================================
 #include "Terrain.h"
 #include "Renderable.h"
+#include "Transform.h"
+#include "Camera.h"
 #include "..\Entity.h"
 #include "..\..\RHI\RHI_Texture2D.h"
 #include "..\..\Logging\Log.h"
-#include "..\..\Math\Vector3.h"
-#include "..\..\Math\MathHelper.h"
-#include "..\..\RHI\RHI_Vertex.h"
-#include "..\..\Rendering\Model.h"
 #include "..\..\IO\FileStream.h"
 #include "..\..\Resource\ResourceCache.h"
+#include "..\..\Rendering\Renderer.h"
+#include "..\..\Rendering\TerrainQuadtree.h"
+#include "..\..\Rendering\Model.h"
 #include "..\..\Rendering\Mesh.h"
+#include "..\..\RHI\RHI_Vertex.h"
 #include "..\..\Threading\Threading.h"
-//=======================================
+#include "..\..\Core\Stopwatch.h"
+//==============================================
 
 //= NAMESPACES ===============
 using namespace std;
@@ -42,6 +45,8 @@ using namespace Spartan::Math;
 
 namespace Spartan
 {
+    static const uint32_t low_lod_level = 1; // the quadtree level of the low LOD mesh, 64x64 quads
+
     Terrain::Terrain(Context* context, Entity* entity, uint32_t id /*= 0*/) : IComponent(context, entity, id)
     {
         
@@ -52,12 +57,58 @@ namespace Spartan
         
     }
 
+    void Terrain::OnTick(float delta_time)
+    {
+        // Swap in a freshly generated quadtree
+        {
+            lock_guard<mutex> lock(m_mutex_quadtree);
+            if (m_quadtree_generated)
+            {
+                m_quadtree  = move(m_quadtree_generated);
+                m_model     = move(m_model_generated);
+
+                // The renderable provides the material and carries the low LOD mesh (with the bounds of the whole height map),
+                // the renderer draws the quadtree's patches instead
+                if (Renderable* renderable = m_entity->AddComponent<Renderable>())
+                {
+                    renderable->GeometrySet(
+                        "Terrain",
+                        0,                                      // index offset
+                        m_model->GetMesh()->Indices_Count(),    // index count
+                        0,                                      // vertex offset
+                        m_model->GetMesh()->Vertices_Count(),   // vertex count
+                        m_quadtree->GetBounds(),
+                        m_model.get()
+                    );
+
+                    if (!renderable->HasMaterial())
+                    {
+                        renderable->UseDefaultMaterial();
+                    }
+                }
+            }
+        }
+
+        if (!m_quadtree)
+            return;
+
+        Renderer* renderer = m_context->GetSubsystem<Renderer>();
+        const shared_ptr<Camera>& camera = renderer->GetCamera();
+        if (!camera)
+            return;
+
+        // Select the patches around the camera, in the terrain's space
+        const Matrix& transform         = GetTransform()->GetMatrix();
+        const Vector3 camera_position   = camera->GetTransform()->GetPosition() * transform.Inverted();
+        m_quadtree->Update(camera_position, transform, renderer->GetFrameNum());
+    }
+
     void Terrain::Serialize(FileStream* stream)
     {
         const string no_path;
 
         stream->Write(m_height_map ? m_height_map->GetResourceFilePathNative() : no_path);
-        stream->Write(m_model ? m_model->GetResourceName() : no_path);
+        stream->Write(no_path); // used to be the generated model, kept so that saved worlds still load
         stream->Write(m_min_y);
         stream->Write(m_max_y);
     }
@@ -65,12 +116,16 @@ namespace Spartan
     void Terrain::Deserialize(FileStream* stream)
     {
         ResourceCache* resource_cache = m_context->GetSubsystem<ResourceCache>();
-        m_height_map    = resource_cache->GetByPath<RHI_Texture2D>(stream->ReadAs<string>());
-        m_model         = resource_cache->GetByName<Model>(stream->ReadAs<string>());
+        m_height_map = resource_cache->GetByPath<RHI_Texture2D>(stream->ReadAs<string>());
+        stream->ReadAs<string>(); // used to be the generated model, it's generated from the height map now
         stream->Read(&m_min_y);
         stream->Read(&m_max_y);
 
-        UpdateFromModel(m_model);
+        // Everything is generated from the height map, so only the height map is saved
+        if (m_height_map)
+        {
+            GenerateAsync();
+        }
     }
 
     void Terrain::SetHeightMap(const shared_ptr<RHI_Texture2D>& height_map)
@@ -79,6 +134,12 @@ namespace Spartan
         m_height_map = m_context->GetSubsystem<ResourceCache>()->Cache<RHI_Texture2D>(height_map);
     }
 
+    const vector<TerrainPatch>& Terrain::GetPatches() const
+    {
+        static const vector<TerrainPatch> empty;
+        return m_quadtree ? m_quadtree->GetPatches() : empty;
+    }
+
     void Terrain::GenerateAsync()
     {
         if (m_is_generating)
@@ -91,7 +152,7 @@ namespace Spartan
         {
             LOG_WARNING("You need to assign a height map before trying to generate a terrain.");
 
-            m_context->GetSubsystem<ResourceCache>()->Remove(m_model);
+            m_quadtree.reset();
             m_model.reset();
             if (Renderable* renderable = m_entity->AddComponent<Renderable>())
             {
@@ -101,336 +162,68 @@ namespace Spartan
             return;
         }
 
+        m_is_generating = true;
         m_context->GetSubsystem<Threading>()->AddTask([this]()
         {
-            m_is_generating = true;
+            Stopwatch stopwatch;
 
             // Get height map data
             const vector<std::byte> height_map_data = m_height_map->GetMipmap(0);
-            if (height_map_data.empty())
+            const uint32_t width                    = m_height_map->GetWidth();
+            const uint32_t height                   = m_height_map->GetHeight();
+            if (height_map_data.size() < static_cast<size_t>(width) * height * 4)
             {
                 LOG_ERROR("Height map has no data");
+                m_is_generating = false;
+                return;
             }
 
-            // Deduce some stuff
-            m_height                            = m_height_map->GetHeight();
-            m_width                             = m_height_map->GetWidth();
-            m_vertex_count                      = m_height * m_width;
-            m_face_count                        = (m_height - 1) * (m_width - 1) * 2;
-            m_progress_jobs_done                = 0;
-            m_progress_job_count                = m_vertex_count * 2 + m_face_count + m_vertex_count * m_face_count;
-
-            // Pre-allocate memory for the calculations that follow
-            vector<Vector3> positions                 = vector<Vector3>(m_height * m_width);
-            vector<RHI_Vertex_PosTexNorTan> vertices  = vector<RHI_Vertex_PosTexNorTan>(m_vertex_count);
-            vector<uint32_t> indices                  = vector<uint32_t>(m_face_count * 3);
-
-            // Read height map and construct positions
-            m_progress_desc = "Generating positions...";
-            if (GeneratePositions(positions, height_map_data))
-            {
-                // Compute the vertices (without the normals) and the indices
-                m_progress_desc = "Generating terrain vertices and indices...";
-                if (GenerateVerticesIndices(positions, indices, vertices))
-                {
-                    m_progress_desc = "Generating normals and tangents...";
-                    positions.clear();
-                    positions.shrink_to_fit();
-
-                    // Compute the normals by doing normal averaging (very expensive)
-                    if (GenerateNormalTangents(indices, vertices))
-                    {
-                        // Create a model and set it to the renderable component
-                        UpdateFromVertices(indices, vertices);
-                    }
-                }
-            }
-
-            // Clear progress stats
             m_progress_jobs_done = 0;
-            m_progress_job_count = 1;
-            m_progress_desc.clear();
-
-            m_is_generating = false;
-        });
-    }
-
-    bool Terrain::GeneratePositions(vector<Vector3>& positions, const vector<std::byte>& height_map)
-    {
-        if (height_map.empty())
-        {
-            LOG_ERROR("Height map is empty");
-            return false;
-        }
-
-        uint32_t index  = 0;
-        uint32_t k      = 0;
-
-        for (uint32_t y = 0; y < m_height; y++)
-        {
-            for (uint32_t x = 0; x < m_width; x++)
-            {
-                // Read height and scale it to a [0, 1] range
-                const float height = (static_cast<float>(height_map[k]) / 255.0f);
-
-                // Construct position
-                const uint32_t index  = y * m_width + x;
-                positions[index].x    = static_cast<float>(x) - m_width * 0.5f;     // center on the X axis
-                positions[index].z    = static_cast<float>(y) - m_height * 0.5f;    // center on the Z axis
-                positions[index].y    = Helper::Lerp(m_min_y, m_max_y, height);
-
-                k += 4;
-
-                // track progress
-                m_progress_jobs_done++;
-            }
-        }
-
-        return true;
-    }
-
-    bool Terrain::GenerateVerticesIndices(const vector<Vector3>& positions, vector<uint32_t>& indices, vector<RHI_Vertex_PosTexNorTan>& vertices)
-    {
-        if (positions.empty())
-        {
-            LOG_ERROR("Positions are empty");
-            return false;
-        }
-
-        uint32_t index      = 0;
-        uint32_t k          = 0;
-        uint32_t u_index    = 0;
-        uint32_t v_index    = 0;
-
-        for (uint32_t y = 0; y < m_height - 1; y++)
-        {
-            for (uint32_t x = 0; x < m_width - 1; x++)
-            {
-                const uint32_t index_bottom_left  = y * m_width + x;
-                const uint32_t index_bottom_right = y * m_width + x + 1;
-                const uint32_t index_top_left     = (y + 1) * m_width + x;
-                const uint32_t index_top_right    = (y + 1) * m_width + x + 1;
-
-                // Bottom right of quad
-                index           = index_bottom_right;
-                indices[k]      = index;
-                vertices[index] = RHI_Vertex_PosTexNorTan(positions[index], Vector2(u_index + 1.0f, v_index + 1.0f));
-
-                // Bottom left of quad
-                index           = index_bottom_left;
-                indices[k + 1]  = index;
-                vertices[index] = RHI_Vertex_PosTexNorTan(positions[index], Vector2(u_index + 0.0f, v_index + 1.0f));
+            m_progress_job_count = static_cast<uint64_t>(width) * height;
 
-                // Top left of quad
-                index           = index_top_left;
-                indices[k + 2]  = index;
-                vertices[index] = RHI_Vertex_PosTexNorTan(positions[index], Vector2(u_index + 0.0f, v_index + 0.0f));
-
-                // Bottom right of quad
-                index           = index_bottom_right;
-                indices[k + 3]  = index;
-                vertices[index] = RHI_Vertex_PosTexNorTan(positions[index], Vector2(u_index + 1.0f, v_index + 1.0f));
-
-                // Top left of quad
-                index           = index_top_left;
-                indices[k + 4]  = index;
-                vertices[index] = RHI_Vertex_PosTexNorTan(positions[index], Vector2(u_index + 0.0f, v_index + 0.0f));
-
-                // Top right of quad
-                index           = index_top_right;
-                indices[k + 5]  = index;
-                vertices[index] = RHI_Vertex_PosTexNorTan(positions[index], Vector2(u_index + 1.0f, v_index + 0.0f));
-
-                k += 6; // next quad
-
-                u_index++;
-
-                // track progress
-                m_progress_jobs_done++;
-            }
-            u_index = 0;
-            v_index++;
-        }
-
-        return true;
-    }
-
-    bool Terrain::GenerateNormalTangents(const vector<uint32_t>& indices, vector<RHI_Vertex_PosTexNorTan>& vertices)
-    {
-        if (indices.empty())
-        {
-            LOG_ERROR("Indices are empty");
-            return false;
-        }
-
-        if (vertices.empty())
-        {
-            LOG_ERROR("Vertices are empty");
-            return false;
-        }
-
-        // Normals are computed by normal averaging, which can be crazy slow
-        uint32_t face_count     = static_cast<uint32_t>(indices.size()) / 3;
-        uint32_t vertex_count   = static_cast<uint32_t>(vertices.size());
-
-        // Compute face normals and tangents
-        vector<Vector3> face_normals(face_count);
-        vector<Vector3> face_tangents(face_count);
-        {
-            for (uint32_t i = 0; i < face_count; ++i)
+            // Keep the red channel only, the quadtree samples it for as long as the terrain exists
+            m_progress_desc = "Reading height map...";
+            vector<uint8_t> heights(static_cast<size_t>(width) * height);
+            for (uint32_t y = 0; y < height; y++)
             {
-                Vector3 edge_a;
-                Vector3 edge_b;
-
-                // Normal
+                for (uint32_t x = 0; x < width; x++)
                 {
-                    // Get the vector describing one edge of our triangle (edge 0, 1)
-                    edge_a = Vector3(
-                        vertices[indices[(i * 3)]].pos[0] - vertices[indices[(i * 3) + 1]].pos[0],
-                        vertices[indices[(i * 3)]].pos[1] - vertices[indices[(i * 3) + 1]].pos[1],
-                        vertices[indices[(i * 3)]].pos[2] - vertices[indices[(i * 3) + 1]].pos[2]
-                    );
-
-                    // Get the vector describing another edge of our triangle (edge 2,1)
-                    edge_b = Vector3(
-                        vertices[indices[(i * 3) + 1]].pos[0] - vertices[indices[(i * 3) + 2]].pos[0],
-                        vertices[indices[(i * 3) + 1]].pos[1] - vertices[indices[(i * 3) + 2]].pos[1],
-                        vertices[indices[(i * 3) + 1]].pos[2] - vertices[indices[(i * 3) + 2]].pos[2]
-                    );
-
-                    // Cross multiply the two edge vectors to get the unnormalized face normal
-                    face_normals[i] = Vector3::Cross(edge_a, edge_b);
-                }
-
-                // Tangent
-                {
-                    // find first texture coordinate edge 2d vector
-                    const float tcU1 = vertices[indices[(i * 3)]].tex[0] - vertices[indices[(i * 3) + 1]].tex[0];
-                    const float tcV1 = vertices[indices[(i * 3)]].tex[1] - vertices[indices[(i * 3) + 1]].tex[1];
-
-                    // find second texture coordinate edge 2d vector
-                    const float tcU2 = vertices[indices[(i * 3) + 1]].tex[0] - vertices[indices[(i * 3) + 2]].tex[0];
-                    const float tcV2 = vertices[indices[(i * 3) + 1]].tex[1] - vertices[indices[(i * 3) + 2]].tex[1];
-
-                    // find tangent using both tex coord edges and position edges
-                    face_tangents[i].x = (tcV1 * edge_a.x - tcV2 * edge_b.x * (1.0f / (tcU1 * tcV2 - tcU2 * tcV1)));
-                    face_tangents[i].y = (tcV1 * edge_a.y - tcV2 * edge_b.y * (1.0f / (tcU1 * tcV2 - tcU2 * tcV1)));
-                    face_tangents[i].z = (tcV1 * edge_a.z - tcV2 * edge_b.z * (1.0f / (tcU1 * tcV2 - tcU2 * tcV1)));
+                    const size_t index  = static_cast<size_t>(y) * width + x;
+                    heights[index]      = static_cast<uint8_t>(height_map_data[index * 4]);
                 }
 
                 // track progress
-                m_progress_jobs_done++;
+                m_progress_jobs_done += width;
             }
-        }
-
-        
-        // Compute vertex normals and tangents (normals averaging) - This is very expensive show we split it into multiple threads below
-        const auto compute_vertex_normals_tangents = [this, &face_normals , &face_tangents, &vertices, &indices, &vertex_count, &face_count](uint32_t i_start, uint32_t i_end)
-        {
-            Vector3 normal_sum  = Vector3::Zero;
-            Vector3 tangent_sum = Vector3::Zero;
-            float faces_using   = 0;
 
-            for (uint32_t i = i_start; i < i_end; ++i)
+            // Bound every node of the quadtree and generate the root patch, the rest is generated around the camera
+            m_progress_desc = "Generating quadtree...";
+            Renderer* renderer = m_context->GetSubsystem<Renderer>();
+            auto quadtree = make_shared<TerrainQuadtree>(m_context->GetSubsystem<Threading>(), renderer->GetRhiDevice());
+            if (quadtree->Initialize(move(heights), width, height, m_min_y, m_max_y))
             {
-                // Check which triangles use this vertex
-                for (uint32_t j = 0; j < face_count; ++j)
-                {
-                    if (indices[j * 3] == i || indices[(j * 3) + 1] == i || indices[(j * 3) + 2] == i)
-                    {
-                        // If a face is using the vertex, accumulate the face normal/tangent
-                        normal_sum  += face_normals[j];
-                        tangent_sum += face_tangents[j];
-                        faces_using++;
-                    }
-
-                    // Track progress but only every time the inner loop (face_count) finished.
-                    // This is because different threads increment the progress tracker which is also an atomic so it locks and unlocks.
-                    if (j == face_count < 1)
-                    {
-                        m_progress_jobs_done += face_count;
-                    }
-                }
-
-                // Compute actual normal
-                normal_sum /= faces_using;
-                normal_sum.Normalize();
-
-                // Compute actual tangent
-                tangent_sum /= faces_using;
-                tangent_sum.Normalize();
-
-                // Write normal to vertex
-                vertices[i].nor[0] = normal_sum.x;
-                vertices[i].nor[1] = normal_sum.y;
-                vertices[i].nor[2] = normal_sum.z;
-
-                // Write tangent to vertex
-                vertices[i].tan[0] = tangent_sum.x;
-                vertices[i].tan[1] = tangent_sum.y;
-                vertices[i].tan[2] = tangent_sum.z;
-
-                // Reset
-                normal_sum  = Vector3::Zero;
-                tangent_sum = Vector3::Zero;
-                faces_using = 0;
+                // Generate the low LOD mesh
+                m_progress_desc = "Generating low LOD mesh...";
+                vector<uint32_t> indices;
+                vector<RHI_Vertex_PosTexNorTan> vertices;
+                quadtree->GenerateLowLodMesh(low_lod_level, indices, vertices);
+                auto model = make_shared<Model>(m_context);
+                model->AppendGeometry(indices, vertices);
+                model->UpdateGeometry();
+
+                LOG_INFO("Generated a quadtree of %d levels for a %dx%d height map in %.2f ms", quadtree->GetLevelCount(), width, height, stopwatch.GetElapsedTimeMs());
+
+                lock_guard<mutex> lock(m_mutex_quadtree);
+                m_quadtree_generated    = quadtree;
+                m_model_generated       = model;
             }
-        };
-
-        m_context->GetSubsystem<Threading>()->AddTaskLoop(compute_vertex_normals_tangents, vertex_count);
-
-        return true;
-    }
-
-    void Terrain::UpdateFromModel(const shared_ptr<Model>& model) const
-    {
-        if (!model)
-        {
-            LOG_ERROR_INVALID_PARAMETER();
-            return;
-        }
 
-        if (Renderable* renderable = m_entity->AddComponent<Renderable>())
-        {
-            renderable->GeometrySet(
-                "Terrain",
-                0,                                  // index offset
-                model->GetMesh()->Indices_Count(),  // index count
-                0,                                  // vertex offset
-                model->GetMesh()->Vertices_Count(), // vertex count
-                model->GetAabb(),
-                model.get()
-            );
-
-            renderable->UseDefaultMaterial();
-        }
-    }
-
-    void Terrain::UpdateFromVertices(const vector<uint32_t>& indices, vector<RHI_Vertex_PosTexNorTan>& vertices)
-    {
-        // Add vertices and indices into a model struct (and cache that)
-        if (!m_model)
-        {
-            // Create new model
-            m_model = make_shared<Model>(m_context);
-
-            // Set geometry
-            m_model->AppendGeometry(indices, vertices);
-            m_model->UpdateGeometry();
-
-            // Set a file path so the model can be used by the resource cache
-            ResourceCache* resource_cache = m_context->GetSubsystem<ResourceCache>();
-            m_model->SetResourceFilePath(resource_cache->GetProjectDirectory() + m_entity->GetName() + "_terrain_" + to_string(m_id) + string(EXTENSION_MODEL));
-            m_model = resource_cache->Cache(m_model);
-        }
-        else
-        {
-            // Update with new geometry
-            m_model->Clear();
-            m_model->AppendGeometry(indices, vertices);
-            m_model->UpdateGeometry();
-        }
+            // Clear progress stats
+            m_progress_jobs_done = 0;
+            m_progress_job_count = 1;
+            m_progress_desc.clear();
 
-        UpdateFromModel(m_model);
+            m_is_generating = false;
+        });
     }
 }
@@ -24,16 +24,15 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ========================
 #include "IComponent.h"
 #include <atomic>
+#include <mutex>
 #include "../../RHI/RHI_Definition.h"
 //===================================
 
 namespace Spartan
 {
+    class TerrainQuadtree;
+    struct TerrainPatch;
     class Model;
-    namespace Math
-    {
-        class Vector3;
-    }
 
     class SPARTAN_CLASS Terrain : public IComponent
     {
@@ -43,6 +42,7 @@ namespace Spartan
 
         //= IComponent ===============================
         void OnInitialize() override;
+        void OnTick(float delta_time) override;
         void Serialize(FileStream* stream) override;
         void Deserialize(FileStream* stream) override;
         //============================================
@@ -59,27 +59,24 @@ namespace Spartan
         float GetProgress() const { return static_cast<float>(static_cast<double>(m_progress_jobs_done) / static_cast<double>(m_progress_job_count)); }
         const auto& GetProgressDescription() const { return m_progress_desc; }
 
+        // The patches to draw this frame, selected around the camera
+        const std::vector<TerrainPatch>& GetPatches() const;
+        const auto& GetQuadtree() const { return m_quadtree; }
+
         void GenerateAsync();
 
     private:
-        bool GeneratePositions(std::vector<Math::Vector3>& positions, const std::vector<std::byte>& height_map);
-        bool GenerateVerticesIndices(const std::vector<Math::Vector3>& positions, std::vector<uint32_t>& indices, std::vector<RHI_Vertex_PosTexNorTan>& vertices);
-        bool GenerateNormalTangents(const std::vector<uint32_t>& indices, std::vector<RHI_Vertex_PosTexNorTan>& vertices);
-        void UpdateFromModel(const std::shared_ptr<Model>& model) const;
-        void UpdateFromVertices(const std::vector<uint32_t>& indices, std::vector<RHI_Vertex_PosTexNorTan>& vertices);
-
-        uint32_t m_width                            = 0;
-        uint32_t m_height                           = 0;
         float m_min_y                               = 0.0f;
         float m_max_y                               = 30.0f;
-        float m_vertex_density                      = 1.0f;
         bool m_is_generating                        = false;
-        uint64_t m_vertex_count                     = 0;
-        uint64_t m_face_count                       = 0;
         std::atomic<uint64_t> m_progress_jobs_done  = 0;
         uint64_t m_progress_job_count               = 1; // avoid devision by zero in GetProgress()
         std::string m_progress_desc;
         std::shared_ptr<RHI_Texture2D> m_height_map;
-        std::shared_ptr<Model> m_model;
+        std::shared_ptr<TerrainQuadtree> m_quadtree;
+        std::shared_ptr<TerrainQuadtree> m_quadtree_generated; // swapped in on the next tick
+        std::shared_ptr<Model> m_model;                         // low LOD mesh for colliders and picking, the patches are what's drawn
+        std::shared_ptr<Model> m_model_generated;
+        std::mutex m_mutex_quadtree;
     };
 }
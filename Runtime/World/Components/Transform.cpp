@@ -41,6 +41,8 @@ namespace Spartan
 		m_scaleLocal		= Vector3::One;
 		m_matrix			= Matrix::Identity;
 		m_matrixLocal		= Matrix::Identity;
+		m_matrix_previous	= Matrix::Identity;
+		m_matrix_interpolated	= Matrix::Identity;
 		m_wvp_previous		= Matrix::Identity;
 		m_parent			= nullptr;
 
@@ -101,6 +103,9 @@ namespace Spartan
 		{
 			m_matrix = m_matrixLocal * GetParentTransformMatrix();
 		}
+
+		// Until interpolated, render with the latest matrix
+		m_matrix_interpolated = m_matrix;
 		
 		// Update children
 		for (const auto& child : m_children)
@@ -109,6 +114,30 @@ namespace Spartan
 		}
 	}
 
+	void Transform::Interpolate(const float alpha)
+	{
+		if (alpha >= 1.0f || m_matrix_previous == m_matrix)
+		{
+			m_matrix_interpolated = m_matrix;
+			return;
+		}
+
+		Vector3 scale_previous, position_previous;
+		Quaternion rotation_previous;
+		m_matrix_previous.Decompose(scale_previous, rotation_previous, position_previous);
+
+		Vector3 scale, position;
+		Quaternion rotation;
+		m_matrix.Decompose(scale, rotation, position);
+
+		m_matrix_interpolated = Matrix
+		(
+			Helper::Lerp(position_previous, position, alpha),
+			Quaternion::Lerp(rotation_previous, rotation, alpha),
+			Helper::Lerp(scale_previous, scale, alpha)
+		);
+	}
+
 	//= TRANSLATION ==================================================================================
 	void Transform::SetPosition(const Vector3& position)
 	{
@@ -198,6 +227,14 @@ namespace Spartan
 		}	
 	}
 
+	void Transform::SetPositionAndRotation(const Vector3& position, const Quaternion& rotation)
+	{
+		// Same as SetPosition() followed by SetRotation(), but the hierarchy is updated once
+		m_positionLocal = !HasParent() ? position : position * GetParent()->GetMatrix().Inverted();
+		m_rotationLocal = !HasParent() ? rotation : rotation * GetParent()->GetRotation().Inverse();
+		UpdateTransform();
+	}
+
 	Vector3 Transform::GetUp() const
 	{
 		return GetRotationLocal() * Vector3::Up;
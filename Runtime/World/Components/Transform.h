@@ -48,6 +48,15 @@ namespace Spartan
 
 		void UpdateTransform();
 
+		//= INTERPOLATION ==================================================================================================
+		void SaveMatrixPrevious() { m_matrix_previous = m_matrix; } // Call before a simulation step
+		void Interpolate(float alpha);                              // Blend from the previous matrix
+		auto GetPositionInterpolated()              const { return m_matrix_interpolated.GetTranslation(); }
+		Math::Quaternion GetRotationInterpolated()  const { return m_matrix_interpolated.GetRotation(); }
+		Math::Vector3 GetForwardInterpolated()      const { return GetRotationInterpolated() * Math::Vector3::Forward; }
+		Math::Vector3 GetUpInterpolated()           const { return GetRotationInterpolated() * Math::Vector3::Up; }
+		//==================================================================================================================
+
 		//= POSITION ==============================================================
 		auto GetPosition()              const { return m_matrix.GetTranslation(); }
 		const auto& GetPositionLocal()  const { return m_positionLocal; }
@@ -69,10 +78,11 @@ namespace Spartan
 		void SetScaleLocal(const Math::Vector3& scale);
 		//===============================================================
 
-		//= TRANSLATION/ROTATION ==================
+		//= TRANSLATION/ROTATION ==========================================================
 		void Translate(const Math::Vector3& delta);
 		void Rotate(const Math::Quaternion& delta);
-		//=========================================
+		void SetPositionAndRotation(const Math::Vector3& position, const Math::Quaternion& rotation); // single update
+		//=================================================================================
 
 		//= DIRECTIONS ===================
 		Math::Vector3 GetUp()       const;
@@ -105,6 +115,7 @@ namespace Spartan
 		void LookAt(const Math::Vector3& v)                       { m_lookAt = v; }
 		const Math::Matrix& GetMatrix()                     const { return m_matrix; }     
 		const Math::Matrix& GetLocalMatrix()                const { return m_matrixLocal; }
+        const Math::Matrix& GetMatrixInterpolated()         const { return m_matrix_interpolated; }
         const Math::Matrix& GetWvpLastFrame()               const { return m_wvp_previous; }
         void SetWvpLastFrame(const Math::Matrix& matrix)          { m_wvp_previous = matrix;}
 
@@ -118,6 +129,8 @@ namespace Spartan
 
 		Math::Matrix m_matrix;
 		Math::Matrix m_matrixLocal;
+		Math::Matrix m_matrix_previous;
+		Math::Matrix m_matrix_interpolated;
 		Math::Vector3 m_lookAt;
 
 		Transform* m_parent; // the parent of this transform
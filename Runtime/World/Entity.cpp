@@ -144,10 +144,27 @@ namespace Spartan
 		if (!m_is_active)
 			return;
 
-		// call component Update()
+		// call component Update(), scripts already ticked in TickScripts()
 		for (const auto& component : m_components)
 		{
-			component->OnTick(delta_time);
+			if (component->GetType() != ComponentType_Script)
+			{
+				component->OnTick(delta_time);
+			}
+		}
+	}
+
+	void Entity::TickScripts(float delta_time)
+	{
+		if (!m_is_active || !HasComponent(ComponentType_Script))
+			return;
+
+		for (const auto& component : m_components)
+		{
+			if (component->GetType() == ComponentType_Script)
+			{
+				component->OnTick(delta_time);
+			}
 		}
 	}
 
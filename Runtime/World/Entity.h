@@ -43,6 +43,7 @@ namespace Spartan
 		void Start();
 		void Stop();
 		void Tick(float delta_time);
+		void TickScripts(float delta_time);
 		void Serialize(FileStream* stream);
 		void Deserialize(FileStream* stream, Transform* parent);
 
@@ -50,6 +50,8 @@ namespace Spartan
 		SUBSCRIBE_TO_EVENT(Event_World_Resolve_Pending, [this](Variant) { m_is_dirty = true; });
 		SUBSCRIBE_TO_EVENT(Event_World_Stop,	        [this](Variant)	{ m_state = Idle; });
 		SUBSCRIBE_TO_EVENT(Event_World_Start,	        [this](Variant)	{ m_state = Ticking; });
+        SUBSCRIBE_TO_EVENT(Event_Frame_Fixed_Step,      [this](Variant) { SaveTransformsPrevious(); });
+        SUBSCRIBE_TO_EVENT(Event_Frame_Start,           [this](Variant) { Update(); });
 	}
 
 	World::~World()
@@ -71,8 +73,8 @@ namespace Spartan
 		return true;
 	}
 
-	void World::Tick(float delta_time)
-	{	
+	void World::Update()
+	{
 		if (m_state == Request_Loading)
 		{
 			m_state = Loading;
@@ -82,39 +84,28 @@ namespace Spartan
 		if (m_state != Ticking)
 			return;
 
-        SCOPED_TIME_BLOCK(m_profiler);
-
-        // Tick entities
-		{
-            // Detect game toggling
-            const auto started      = m_context->m_engine->EngineMode_IsSet(Engine_Game) && m_was_in_editor_mode;
-            const auto stopped      = !m_context->m_engine->EngineMode_IsSet(Engine_Game) && !m_was_in_editor_mode;
-            m_was_in_editor_mode    = !m_context->m_engine->EngineMode_IsSet(Engine_Game);
-
-            // Start
-            if (started)
-            {
-                for (const auto& entity : m_entities)
-                {
-                    entity->Start();
-                }
-            }
+        // Detect game toggling
+        const auto started      = m_context->m_engine->EngineMode_IsSet(Engine_Game) && m_was_in_editor_mode;
+        const auto stopped      = !m_context->m_engine->EngineMode_IsSet(Engine_Game) && !m_was_in_editor_mode;
+        m_was_in_editor_mode    = !m_context->m_engine->EngineMode_IsSet(Engine_Game);
 
-            // Stop
-            if (stopped)
+        // Start
+        if (started)
+        {
+            for (const auto& entity : m_entities)
             {
-                for (const auto& entity : m_entities)
-                {
-                    entity->Stop();
-                }
+                entity->Start();
             }
+        }
 
-            // Tick
+        // Stop
+        if (stopped)
+        {
             for (const auto& entity : m_entities)
             {
-                entity->Tick(delta_time);
+                entity->Stop();
             }
-		}
+        }
 
         if (m_is_dirty)
         {
@@ -138,6 +129,37 @@ namespace Spartan
         }
 	}
 
+	void World::Tick(float delta_time)
+	{	
+		if (m_state != Ticking)
+			return;
+
+        SCOPED_TIME_BLOCK(m_profiler);
+
+        // Tick scripts first, their updates are batched per script class and executed once all of them are queued.
+        // The other components tick afterwards, so they see everything the scripts did this tick.
+        for (const auto& entity : m_entities)
+        {
+            entity->TickScripts(delta_time);
+        }
+        FIRE_EVENT(Event_World_Scripts_Ticked);
+
+        // Tick entities
+        for (const auto& entity : m_entities)
+        {
+            entity->Tick(delta_time);
+        }
+	}
+
+    void World::SaveTransformsPrevious()
+    {
+        // Keep the pre-step state so the renderer can interpolate towards the post-step one
+        for (const auto& entity : m_entities)
+        {
+            entity->GetTransform()->SaveMatrixPrevious();
+        }
+    }
+
 	void World::Unload()
 	{
         // Notify any systems that the entities are about to be cleared
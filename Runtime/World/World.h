@@ -74,7 +74,9 @@ namespace Spartan
 		//======================================================================================
 
 	private:
+        void Update(); // once per frame, loading, game start/stop and resolving can't depend on the fixed step count
         void _EntityRemove(const std::shared_ptr<Entity>& entity);
+        void SaveTransformsPrevious();
 
 		//= COMMON ENTITY CREATION ========================
 		std::shared_ptr<Entity>& CreateEnvironment();
@@ -21,11 +21,15 @@
 SOLUTION_NAME		= "Spartan"
 EDITOR_NAME			= "Editor"
 RUNTIME_NAME		= "Runtime"
+TESTS_NAME			= "Tests"
 TARGET_NAME			= "Spartan" -- Name of executable
 DEBUG_FORMAT		= "c7"
 EDITOR_DIR			= "../" .. EDITOR_NAME
 RUNTIME_DIR			= "../" .. RUNTIME_NAME
+TESTS_DIR			= "../" .. TESTS_NAME
 LIBRARY_DIR			= "../ThirdParty/libraries"
+BULLET_DIR			= "../ThirdParty/Bullet_2.89"
+BULLET_LIBS			= { "BulletSoftBody", "BulletDynamics", "BulletCollision", "LinearMath" } -- Built from source, see below
 INTERMEDIATE_DIR	= "../Binaries/Intermediate"
 TARGET_DIR_RELEASE  = "../Binaries/Release"
 TARGET_DIR_DEBUG    = "../Binaries/Debug"
@@ -41,6 +45,11 @@ elseif API_GRAPHICS == "d3d12" then
 elseif API_GRAPHICS == "vulkan" then
 	API_GRAPHICS	= "API_GRAPHICS_VULKAN"
 	TARGET_NAME		= "Spartan_vk"
+elseif API_GRAPHICS == "null" then
+	-- Headless, no GPU is required. This is still a Windows build (the prebuilt libraries and parts
+	-- of the runtime are Windows only), non-Windows platforms would need their own project generation.
+	API_GRAPHICS	= "API_GRAPHICS_NULL"
+	TARGET_NAME		= "Spartan_null"
 end
 
 -- Solution
@@ -56,7 +65,8 @@ solution (SOLUTION_NAME)
 	defines
 	{
 		"SPARTAN_RUNTIME_STATIC=1",
-		"SPARTAN_RUNTIME_SHARED=0"
+		"SPARTAN_RUNTIME_SHARED=0",
+		"BT_THREADSAFE=1" -- Multi-threaded physics, Bullet and everything including it must agree on it
 	}
 	
 	filter { "platforms:x64" }
@@ -99,7 +109,7 @@ project (RUNTIME_NAME)
 	includedirs { "../ThirdParty/Vulkan_1.2.135.0" }
 	includedirs { "../ThirdParty/AngelScript_2.33.0" }
 	includedirs { "../ThirdParty/Assimp_5.0.0" }
-	includedirs { "../ThirdParty/Bullet_2.89" }
+	includedirs { BULLET_DIR }
 	includedirs { "../ThirdParty/FMOD_1.10.10" }
 	includedirs { "../ThirdParty/FreeImage_3.18.0" }
 	includedirs { "../ThirdParty/FreeType_2.10.1" }
@@ -107,6 +117,8 @@ project (RUNTIME_NAME)
 	
 	-- Libraries
 	libdirs (LIBRARY_DIR)
+	links (BULLET_LIBS)
+	dependson (BULLET_LIBS)
 
 	--	"Debug"
 	filter "configurations:Debug"
@@ -119,7 +131,6 @@ project (RUNTIME_NAME)
 		links { "fmodL64_vc" }
 		links { "FreeImageLib_debug" }
 		links { "freetype_debug" }
-		links { "BulletCollision_debug", "BulletDynamics_debug", "BulletSoftBody_debug", "LinearMath_debug" }
 		links { "pugixml_debug" }
 		links { "IrrXML_debug" }
 			
@@ -133,7 +144,6 @@ project (RUNTIME_NAME)
 		links { "fmod64_vc" }
 		links { "FreeImageLib" }
 		links { "freetype" }
-		links { "BulletCollision", "BulletDynamics", "BulletSoftBody", "LinearMath" }
 		links { "pugixml" }
 		links { "IrrXML" }
 
@@ -163,6 +173,7 @@ project (EDITOR_NAME)
 	
 	-- Libraries
 	libdirs (LIBRARY_DIR)
+	links (BULLET_LIBS) -- The runtime library doesn't contain the Bullet projects it links
 
 	-- "Debug"
 	filter "configurations:Debug"
@@ -173,4 +184,72 @@ project (EDITOR_NAME)
 	-- "Release"
 	filter "configurations:Release"
 		targetdir (TARGET_DIR_RELEASE)
-		debugdir (TARGET_DIR_RELEASE)
\ No newline at end of file
+		debugdir (TARGET_DIR_RELEASE)
+
+-- Tests ---------------------------------------------------------------------------------------------------
+project (TESTS_NAME)
+	location (TESTS_DIR)
+	links { RUNTIME_NAME }
+	dependson { RUNTIME_NAME }
+	targetname ( TARGET_NAME .. "_tests" )
+	objdir (INTERMEDIATE_DIR)
+	kind "ConsoleApp"
+	staticruntime "On"
+	defines{ "SPARTAN_TESTS", API_GRAPHICS }
+	
+	-- Files
+	files 
+	{ 
+		TESTS_DIR .. "/**.h",
+		TESTS_DIR .. "/**.cpp"
+	}
+	
+	-- Includes
+	includedirs { "../" .. RUNTIME_NAME }
+	includedirs { BULLET_DIR }
+	includedirs { "../ThirdParty/AngelScript_2.33.0" }
+	
+	-- Libraries
+	libdirs (LIBRARY_DIR)
+	links (BULLET_LIBS) -- The runtime library doesn't contain the Bullet projects it links
+
+	-- "Debug"
+	filter "configurations:Debug"
+		targetdir (TARGET_DIR_DEBUG)	
+		debugdir (TARGET_DIR_DEBUG)
+		debugformat (DEBUG_FORMAT)		
+				
+	-- "Release"
+	filter "configurations:Release"
+		targetdir (TARGET_DIR_RELEASE)
+		debugdir (TARGET_DIR_RELEASE)
+
+-- Bullet --------------------------------------------------------------------------------------------------
+-- Built from the vendored source so that it's built with BT_THREADSAFE=1 (see the solution's defines)
+for _, BULLET_LIB in ipairs(BULLET_LIBS) do
+project (BULLET_LIB)
+	location (BULLET_DIR .. "/" .. BULLET_LIB)
+	objdir (INTERMEDIATE_DIR)
+	kind "StaticLib"
+	staticruntime "On"
+	warnings "Off"
+	
+	-- Files
+	files 
+	{ 
+		BULLET_DIR .. "/" .. BULLET_LIB .. "/**.h",
+		BULLET_DIR .. "/" .. BULLET_LIB .. "/**.cpp"
+	}
+	
+	-- Includes
+	includedirs { BULLET_DIR }
+
+	-- "Debug"
+	filter "configurations:Debug"
+		targetdir (TARGET_DIR_DEBUG)
+		debugformat (DEBUG_FORMAT)
+				
+	-- "Release"
+	filter "configurations:Release"
+		targetdir (TARGET_DIR_RELEASE)
+end
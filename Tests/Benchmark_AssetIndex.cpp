@@ -0,0 +1,101 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ==================
+#include "Test.h"
+#include "Resource/AssetIndex.h"
+#include "Threading/Threading.h"
+#include <chrono>
+#include <fstream>
+//=============================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+//============================
+
+// Every image under a 20k file tree (100 files per directory, 100 directories per top level directory, a mix of types),
+// found by walking the directories on disk versus scanning once and querying the index
+BENCHMARK(asset_index_images)
+{
+    static const char* extensions[] = { ".png", ".fbx", ".wav", ".txt", ".material", ".jpg" };
+    const uint32_t file_count   = 20000;
+    const string root           = Spartan::Tests::GetTempDirectory("asset_index_images");
+    for (uint32_t i = 0; i < file_count; i++)
+    {
+        const string directory = root + "/" + to_string(i / 10000) + "/" + to_string(i / 100);
+        if (i % 100 == 0)
+        {
+            FileSystem::CreateDirectory_(directory);
+        }
+
+        ofstream(directory + "/file_" + to_string(i) + extensions[i % 6]);
+    }
+
+    // By walking the directories
+    auto start = chrono::high_resolution_clock::now();
+    vector<string> images;
+    vector<string> pending = { root };
+    while (!pending.empty())
+    {
+        const string directory = move(pending.back());
+        pending.pop_back();
+
+        for (const string& child : FileSystem::GetDirectoriesInDirectory(directory))
+        {
+            pending.emplace_back(child);
+        }
+
+        for (const string& file : FileSystem::GetFilesInDirectory(directory))
+        {
+            if (FileSystem::IsSupportedImageFile(file))
+            {
+                images.emplace_back(file);
+            }
+        }
+    }
+    const chrono::duration<double, milli> duration_walk = chrono::high_resolution_clock::now() - start;
+    const size_t image_count = images.size();
+    CHECK(image_count > 0);
+
+    // From the index
+    Threading threading(nullptr);
+    AssetIndex index(&threading);
+    start = chrono::high_resolution_clock::now();
+    CHECK(index.Scan(root));
+    const chrono::duration<double, milli> duration_scan = chrono::high_resolution_clock::now() - start;
+
+    const uint32_t iteration_count = 10;
+    start = chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < iteration_count; i++)
+    {
+        images = index.GetFiles(File_Image);
+    }
+    const chrono::duration<double, milli> duration_query = chrono::high_resolution_clock::now() - start;
+    CHECK(images.size() == image_count);
+
+    FileSystem::Delete(root);
+
+    Spartan::Tests::ReportResult("asset_index_walk_20k", duration_walk.count(), "ms");
+    Spartan::Tests::ReportResult("asset_index_scan_20k", duration_scan.count(), "ms");
+    Spartan::Tests::ReportResult("asset_index_query_20k", duration_query.count() / iteration_count, "ms");
+}
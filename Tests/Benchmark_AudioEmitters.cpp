@@ -0,0 +1,71 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==================
+#include "Test.h"
+#include "Audio/AudioEmitters.h"
+#include <chrono>
+#include <random>
+//=============================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+// 1k emitters scattered around the listener and competing for 32 voices, a tenth of them moving every update
+BENCHMARK(audio_emitters_update)
+{
+    const uint32_t emitter_count    = 1000;
+    const uint32_t voice_count      = 32;
+    const uint32_t iteration_count  = 100;
+    const float delta_time          = 1.0f / 60.0f;
+
+    AudioEmitters emitters;
+    mt19937 generator(7);
+    uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+    for (uint32_t i = 0; i < emitter_count; i++)
+    {
+        const uint32_t id = emitters.Add(nullptr, 50.0f, static_cast<int>(i % 256));
+        emitters.SetPosition(id, Vector3(distribution(generator), distribution(generator), distribution(generator)), delta_time);
+    }
+
+    double elapsed_ms   = 0.0;
+    uint32_t push_count = 0;
+    for (uint32_t i = 0; i < iteration_count; i++)
+    {
+        const auto start = chrono::high_resolution_clock::now();
+        for (uint32_t j = i % 10; j < emitter_count; j += 10)
+        {
+            const Vector3 offset = Vector3(distribution(generator), 0.0f, distribution(generator)) * 0.01f;
+            emitters.SetPosition(j, emitters.Get(j).position + offset, delta_time);
+        }
+        emitters.Update(Vector3::Zero, voice_count, delta_time);
+        const chrono::duration<double, milli> duration = chrono::high_resolution_clock::now() - start;
+
+        elapsed_ms += duration.count();
+        push_count += static_cast<uint32_t>(emitters.GetMoved().size() + emitters.GetBecameReal().size());
+    }
+
+    Spartan::Tests::ReportResult("audio_emitters_update_1k", elapsed_ms / iteration_count, "ms");
+    Spartan::Tests::ReportResult("audio_emitters_attributes_pushed_1k", static_cast<double>(push_count) / iteration_count, "per update");
+}
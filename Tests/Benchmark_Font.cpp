@@ -0,0 +1,84 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// The font belongs to the renderer, so only solutions generated with Generate_VS2019_Null.bat build this benchmark
+#ifdef API_GRAPHICS_NULL
+
+//= INCLUDES ==================
+#include "Test.h"
+#include "Core/Engine.h"
+#include "Core/Context.h"
+#include "Rendering/Renderer.h"
+#include "Rendering/Font/Font.h"
+#include <chrono>
+#include <string>
+#include <vector>
+//=============================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+// 1k strings like the ones a debug overlay would draw, every one of them different. The first frame lays them out,
+// the following ones batch them from the cached layouts (at new positions, so that the batch is rebuilt every time).
+BENCHMARK(font_text_layout)
+{
+    WindowData window_data;
+    window_data.width   = 64;
+    window_data.height  = 64;
+    Engine engine(window_data);
+    Font* font = engine.GetContext()->GetSubsystem<Renderer>()->GetFont();
+    CHECK(font != nullptr);
+
+    const uint32_t string_count = 1000;
+    vector<string> strings(string_count);
+    for (uint32_t i = 0; i < string_count; i++)
+    {
+        strings[i] = "Entity " + to_string(i) + ":\tposition (" + to_string(i * 0.25f) + ", 0.0, " + to_string(i * 0.5f) + ")";
+    }
+
+    const auto draw = [&](const float offset)
+    {
+        const auto start = chrono::high_resolution_clock::now();
+        for (uint32_t i = 0; i < string_count; i++)
+        {
+            font->AddText(strings[i], Vector2(offset, static_cast<float>(i)));
+        }
+        font->UpdateVertexBuffer();
+        font->ClearText();
+        const chrono::duration<double, milli> duration = chrono::high_resolution_clock::now() - start;
+        return duration.count();
+    };
+
+    Spartan::Tests::ReportResult("font_text_layout_uncached_1k", draw(0.0f), "ms");
+
+    const uint32_t iteration_count  = 10;
+    double elapsed_ms               = 0.0;
+    for (uint32_t i = 0; i < iteration_count; i++)
+    {
+        elapsed_ms += draw(static_cast<float>(i + 1));
+    }
+    Spartan::Tests::ReportResult("font_text_layout_cached_1k", elapsed_ms / iteration_count, "ms");
+}
+
+#endif
@@ -0,0 +1,80 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "Test.h"
+#include "Rendering/LightGrid.h"
+#include "Threading/Threading.h"
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cstdio>
+//================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+// Cluster assignment of randomly placed lights in front of a camera at the origin, each depth slice is binned on the job system
+BENCHMARK(light_grid_build)
+{
+    const float near_plane          = 0.3f;
+    const float far_plane           = 1000.0f;
+    const Matrix projection         = Matrix::CreatePerspectiveFieldOfViewLH(1.5708f, 16.0f / 9.0f, near_plane, far_plane);
+    const uint32_t iteration_count  = 10;
+
+    Threading threading(nullptr);
+
+    for (const uint32_t light_count : { 1000u, 10000u })
+    {
+        mt19937 generator(0);
+        uniform_real_distribution<float> distribution_xy(-100.0f, 100.0f);
+        uniform_real_distribution<float> distribution_z(0.0f, 300.0f);
+        uniform_real_distribution<float> distribution_range(1.0f, 15.0f);
+
+        vector<BufferLightGridLight> lights(light_count);
+        for (BufferLightGridLight& light : lights)
+        {
+            light.position_range    = Vector4(distribution_xy(generator), distribution_xy(generator) * 0.5f, distribution_z(generator), distribution_range(generator));
+            light.color_intensity   = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+            light.direction_angle   = Vector4::Zero;
+        }
+
+        // The first build allocates, so it's not timed
+        LightGrid grid(&threading);
+        grid.Build(lights, Matrix::Identity, projection, near_plane, far_plane);
+
+        const auto start = chrono::high_resolution_clock::now();
+        for (uint32_t i = 0; i < iteration_count; i++)
+        {
+            grid.Build(lights, Matrix::Identity, projection, near_plane, far_plane);
+        }
+        const chrono::duration<double, milli> duration = chrono::high_resolution_clock::now() - start;
+
+        char name[64];
+        snprintf(name, sizeof(name), "light_grid_build_%u_lights", light_count);
+        Spartan::Tests::ReportResult(name, duration.count() / iteration_count, "ms");
+        snprintf(name, sizeof(name), "light_grid_overflow_%u_lights", light_count);
+        Spartan::Tests::ReportResult(name, static_cast<double>(grid.GetOverflow().size()), "lights");
+    }
+}
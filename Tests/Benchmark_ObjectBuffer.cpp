@@ -0,0 +1,104 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+// The null backend's constant buffers are host memory which stays mapped, like Vulkan's
+#ifdef API_GRAPHICS_NULL
+
+//= INCLUDES =====================================
+#include "Test.h"
+#include "RHI/RHI_Device.h"
+#include "RHI/RHI_ConstantBuffer.h"
+#include "Rendering/RingAllocator.h"
+#include "Rendering/Renderer_ConstantBuffers.h"
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <cstdio>
+//================================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+// Streams per draw object data the way the renderer does: a ring region per frame in flight, allocated in one go per pass
+// and written straight into the mapped buffer. It starts from the renderer's initial size, so the first frame grows it.
+BENCHMARK(object_buffer_stream_draws_per_second)
+{
+    const uint32_t frame_count          = 100;
+    const uint32_t frames_in_flight     = 2;
+    const uint32_t pass_count           = 4;
+
+    auto device = make_shared<RHI_Device>(nullptr);
+
+    for (const uint32_t draw_count : { 1000u, 10000u, 100000u })
+    {
+        RingAllocator ring;
+        ring.Reset(256, frames_in_flight);
+        auto buffer = make_shared<RHI_ConstantBuffer>(device, true);
+        CHECK(buffer->Create<BufferObject>(ring.GetElementCount()));
+        CHECK(buffer->IsPersistentlyMapped());
+
+        vector<shared_ptr<RHI_ConstantBuffer>> retired;
+        const Matrix wvp = Matrix::CreateScale(2.0f);
+
+        const auto start = chrono::high_resolution_clock::now();
+        for (uint32_t frame = 0; frame < frame_count; frame++)
+        {
+            ring.BeginFrame();
+            retired.clear(); // stands in for waiting on the frames in flight
+
+            for (uint32_t pass = 0; pass < pass_count; pass++)
+            {
+                const uint32_t count = draw_count / pass_count;
+
+                uint32_t index = 0;
+                if (!ring.Allocate(count, index))
+                {
+                    // Grow into a new buffer, the current one is kept until the gpu is done with it
+                    ring.Reset(Helper::NextPowerOfTwo(ring.GetUsed() + count), frames_in_flight);
+                    retired.emplace_back(buffer);
+                    buffer = make_shared<RHI_ConstantBuffer>(device, true);
+                    CHECK(buffer->Create<BufferObject>(ring.GetElementCount()));
+                    CHECK(ring.Allocate(count, index));
+                }
+
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    BufferObject* object    = static_cast<BufferObject*>(buffer->Map(index + i));
+                    object->object          = wvp;
+                    object->wvp_current     = wvp;
+                    object->wvp_previous    = wvp;
+                    object->material_index  = i;
+                }
+            }
+        }
+        const double seconds = chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+
+        char name[128];
+        snprintf(name, sizeof(name), "object_buffer_stream_%u_draws", draw_count);
+        Spartan::Tests::ReportResult(name, static_cast<double>(draw_count) * frame_count / seconds, "draws/s");
+    }
+}
+
+#endif
@@ -0,0 +1,167 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ==============================================================================
+#include "Test.h"
+#include "Threading/Threading.h"
+#include "Physics/PhysicsTaskScheduler.h"
+#ifdef API_GRAPHICS_NULL
+#include "Core/Engine.h"
+#include "Core/Context.h"
+#include "Core/Timer.h"
+#include "Profiling/Profiler.h"
+#include "World/World.h"
+#include "World/Entity.h"
+#include "World/Components/Transform.h"
+#include "World/Components/Collider.h"
+#include "World/Components/RigidBody.h"
+#endif
+#include "btBulletDynamicsCommon.h"
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
+#include <chrono>
+#include <memory>
+#include <cstdio>
+//=========================================================================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+// Steps a world of 10k boxes piling onto a ground plane, with the same world setup as Physics
+BENCHMARK(physics_10k_bodies_steps_per_second)
+{
+    const int body_count    = 10000;
+    const int step_count    = 120;
+    const float delta_time  = 1.0f / 60.0f;
+
+    Threading threading(nullptr);
+    PhysicsTaskScheduler scheduler(&threading);
+    btSetTaskScheduler(&scheduler);
+
+    for (int thread_count = 1; thread_count <= scheduler.getMaxNumThreads(); thread_count *= 2)
+    {
+        scheduler.setNumThreads(thread_count);
+
+        btDbvtBroadphase broadphase;
+        btDefaultCollisionConfiguration configuration;
+        btCollisionDispatcherMt dispatcher(&configuration);
+        btConstraintSolverPoolMt solver_pool(scheduler.getMaxNumThreads());
+        btSequentialImpulseConstraintSolverMt solver;
+        btDiscreteDynamicsWorldMt world(&dispatcher, &broadphase, &solver_pool, &solver, &configuration);
+        world.setGravity(btVector3(0.0f, -9.81f, 0.0f));
+
+        // Ground
+        btStaticPlaneShape shape_ground(btVector3(0.0f, 1.0f, 0.0f), 0.0f);
+        btRigidBody ground(btRigidBody::btRigidBodyConstructionInfo(0.0f, nullptr, &shape_ground));
+        world.addRigidBody(&ground);
+
+        // Boxes in loose columns so that they collide, stack and form islands
+        btBoxShape shape_box(btVector3(0.5f, 0.5f, 0.5f));
+        btVector3 inertia;
+        shape_box.calculateLocalInertia(1.0f, inertia);
+        vector<unique_ptr<btRigidBody>> bodies;
+        bodies.reserve(body_count);
+        for (int i = 0; i < body_count; i++)
+        {
+            btTransform transform;
+            transform.setIdentity();
+            transform.setOrigin(btVector3(static_cast<float>(i % 50) * 1.5f, 0.5f + static_cast<float>(i / 2500) * 1.1f, static_cast<float>((i / 50) % 50) * 1.5f));
+
+            bodies.emplace_back(make_unique<btRigidBody>(btRigidBody::btRigidBodyConstructionInfo(1.0f, nullptr, &shape_box, inertia)));
+            bodies.back()->setWorldTransform(transform);
+            world.addRigidBody(bodies.back().get());
+        }
+
+        const auto time_start = chrono::high_resolution_clock::now();
+        for (int i = 0; i < step_count; i++)
+        {
+            world.stepSimulation(delta_time, 0, delta_time); // one step, like Physics in fixed mode
+        }
+        const chrono::duration<double> duration = chrono::high_resolution_clock::now() - time_start;
+
+        for (const auto& body : bodies)
+        {
+            world.removeRigidBody(body.get());
+        }
+        world.removeRigidBody(&ground);
+
+        char name[64];
+        snprintf(name, sizeof(name), "%d thread(s)", thread_count);
+        Tests::ReportResult(name, step_count / duration.count(), "steps/sec");
+    }
+
+    btSetTaskScheduler(btGetSequentialTaskScheduler());
+}
+
+// The bodies go through the engine (RigidBody, its MotionState and Physics::SyncTransforms()), which the null backend can host
+#ifdef API_GRAPHICS_NULL
+// 10k bodies of which 5% are awake, two fixed steps per frame
+BENCHMARK(physics_mostly_sleeping_bodies_sync)
+{
+    const int body_count    = 10000;
+    const int awake_every   = 20;
+    const int warmup_frames = 150; // past Bullet's deactivation time, so that the bodies without gravity fall asleep
+    const int frame_count   = 120;
+
+    WindowData window_data;
+    window_data.width   = 64;
+    window_data.height  = 64;
+    Engine engine(window_data);
+
+    Context* context    = engine.GetContext();
+    World* world        = context->GetSubsystem<World>();
+    Profiler* profiler  = context->GetSubsystem<Profiler>();
+    context->GetSubsystem<Timer>()->SetFrameTimeOverrideMs(1000.0 / 30.0);
+
+    // Spread out so that they don't touch, the ones without gravity float in place until they fall asleep
+    for (int i = 0; i < body_count; i++)
+    {
+        auto& entity = world->EntityCreate();
+        entity->GetTransform()->SetPosition(Vector3(static_cast<float>(i % 100) * 2.0f, 100.0f, static_cast<float>(i / 100) * 2.0f));
+        entity->AddComponent<Collider>();
+        RigidBody* body = entity->AddComponent<RigidBody>();
+        body->SetMass(1.0f);
+        body->SetUseGravity(i % awake_every == 0);
+    }
+
+    for (int i = 0; i < warmup_frames; i++)
+    {
+        engine.Tick();
+    }
+
+    uint32_t synced = 0;
+    const auto time_start = chrono::high_resolution_clock::now();
+    for (int i = 0; i < frame_count; i++)
+    {
+        engine.Tick();
+        synced += profiler->m_physics_bodies_synced;
+    }
+    const chrono::duration<double, milli> duration = chrono::high_resolution_clock::now() - time_start;
+
+    Tests::ReportResult("frame (engine tick)", duration.count() / frame_count, "ms");
+    Tests::ReportResult("bodies synced per frame", static_cast<double>(synced) / frame_count, ""); // the awake bodies, once per step
+}
+#endif
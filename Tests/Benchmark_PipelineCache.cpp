@@ -0,0 +1,85 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+// Pipeline states without shaders need no GPU objects, so the null backend can create pipelines for them
+#ifdef API_GRAPHICS_NULL
+
+//= INCLUDES =====================
+#include "Test.h"
+#include "RHI/RHI_Device.h"
+#include "RHI/RHI_PipelineCache.h"
+#include "RHI/RHI_PipelineState.h"
+#include <chrono>
+#include <memory>
+#include <cstdio>
+//================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+//============================
+
+// Lookups go through GetPipeline(), so they include re-checking the state's key, hashing it (when changed) and probing the table
+BENCHMARK(pipeline_cache_lookups_per_second)
+{
+    const uint32_t lookup_count = 1000000;
+
+    for (const uint32_t state_count : { 64u, 1024u, 16384u })
+    {
+        RHI_Device device(nullptr);
+        RHI_PipelineCache cache(&device);
+
+        vector<unique_ptr<RHI_PipelineState>> states(state_count);
+        for (uint32_t i = 0; i < state_count; i++)
+        {
+            states[i] = make_unique<RHI_PipelineState>();
+            states[i]->vertex_buffer_stride = i;
+        }
+
+        // Misses, which create (null) pipelines and insert them
+        auto start = chrono::high_resolution_clock::now();
+        for (uint32_t i = 0; i < state_count; i++)
+        {
+            cache.GetPipeline(nullptr, *states[i], nullptr);
+        }
+        const double insert_sec = chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+
+        // Hits, in a scattered order so that the table isn't walked sequentially
+        uintptr_t checksum = 0;
+        start = chrono::high_resolution_clock::now();
+        for (uint32_t i = 0; i < lookup_count; i++)
+        {
+            const uint32_t index = (i * 2654435761u) % state_count;
+            checksum += reinterpret_cast<uintptr_t>(cache.GetPipeline(nullptr, *states[index], nullptr));
+        }
+        const double lookup_sec = chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+        CHECK(checksum != 0);
+
+        char name[128];
+        snprintf(name, sizeof(name), "pipeline_cache_inserts_%u_states", state_count);
+        Spartan::Tests::ReportResult(name, state_count / insert_sec, "inserts/s");
+        snprintf(name, sizeof(name), "pipeline_cache_lookups_%u_states", state_count);
+        Spartan::Tests::ReportResult(name, lookup_count / lookup_sec, "lookups/s");
+    }
+}
+
+#endif
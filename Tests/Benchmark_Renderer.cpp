@@ -0,0 +1,96 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+// The renderer's CPU frame cost (culling, sorting, buffer updates, pipeline and descriptor caches, command recording)
+// measured through the null backend, so only solutions generated with Generate_VS2019_Null.bat build this benchmark.
+#ifdef API_GRAPHICS_NULL
+
+//= INCLUDES ==============================
+#include "Test.h"
+#include "Core/Engine.h"
+#include "Core/Context.h"
+#include "Rendering/Renderer.h"
+#include "RHI/RHI_SwapChain.h"
+#include "World/World.h"
+#include "World/Entity.h"
+#include "World/Components/Transform.h"
+#include "World/Components/Renderable.h"
+#include <chrono>
+#include <cstdio>
+//=========================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+BENCHMARK(renderer_null_backend_frame_cost)
+{
+    WindowData window_data;
+    window_data.width   = 1920;
+    window_data.height  = 1080;
+    Engine engine(window_data);
+
+    Context* context    = engine.GetContext();
+    Renderer* renderer  = context->GetSubsystem<Renderer>();
+    World* world        = context->GetSubsystem<World>();
+    CHECK(renderer->IsInitialized());
+
+    const uint32_t frame_count = 100;
+    for (const uint32_t cube_count : { 1000u, 10000u })
+    {
+        // Synthetic scene, a grid of cubes in front of the default camera
+        for (uint32_t i = 0; i < cube_count; i++)
+        {
+            auto& entity = world->EntityCreate();
+            entity->GetTransform()->SetPosition(Vector3(static_cast<float>(i % 100) * 2.0f - 100.0f, static_cast<float>(i / 1000) * 2.0f, static_cast<float>((i / 100) % 10) * 2.0f + 10.0f));
+            Renderable* renderable = entity->AddComponent<Renderable>();
+            renderable->GeometrySet(Geometry_Default_Cube);
+            renderable->UseDefaultMaterial();
+        }
+
+        // Resolve the world and let shaders and pipelines settle
+        for (uint32_t i = 0; i < 10; i++)
+        {
+            engine.Tick();
+            renderer->GetSwapChain()->Present();
+        }
+
+        // Only the renderer is timed, Engine::Tick() also paces the frame rate
+        const auto time_start = chrono::high_resolution_clock::now();
+        for (uint32_t i = 0; i < frame_count; i++)
+        {
+            renderer->Tick(1.0f / 60.0f);
+            renderer->GetSwapChain()->Present();
+        }
+        const chrono::duration<double, milli> duration = chrono::high_resolution_clock::now() - time_start;
+
+        char name[64];
+        snprintf(name, sizeof(name), "%u cubes", cube_count);
+        Tests::ReportResult(name, duration.count() / frame_count, "ms/frame");
+
+        world->Unload();
+    }
+}
+
+#endif
@@ -0,0 +1,161 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// Scripts run on the engine's scripting subsystem, so only solutions generated with Generate_VS2019_Null.bat build this benchmark
+#ifdef API_GRAPHICS_NULL
+
+//= INCLUDES ==================
+#include "Test.h"
+#include "Core/Engine.h"
+#include "Core/Context.h"
+#include "Scripting/Scripting.h"
+#include <angelscript.h>
+#include <chrono>
+#include <utility>
+#include <vector>
+//=============================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+//============================
+
+// Updating 10k instances of a trivial script, one call at a time (the way scripts were updated before batching) and batched
+BENCHMARK(scripting_update)
+{
+    WindowData window_data;
+    window_data.width   = 64;
+    window_data.height  = 64;
+    Engine engine(window_data);
+    Scripting* scripting            = engine.GetContext()->GetSubsystem<Scripting>();
+    asIScriptEngine* script_engine  = scripting->GetAsIScriptEngine();
+
+    static const char* source =
+        "class Benchmark"
+        "{"
+        "    float time = 0.0f;"
+        "    void Update(float delta_time) { time += delta_time; }"
+        "}";
+
+    // A module which doesn't depend on the world, so that it can be instantiated as many times as needed
+    asIScriptModule* module = script_engine->GetModule("Benchmark", asGM_ALWAYS_CREATE);
+    CHECK(module->AddScriptSection("Benchmark", source) >= 0 && module->Build() >= 0);
+
+    asITypeInfo* type           = module->GetTypeInfoByDecl("Benchmark");
+    asIScriptFunction* update   = type->GetMethodByDecl("void Update(float delta_time)");
+    vector<asIScriptObject*> objects(10000);
+    for (asIScriptObject*& obj : objects)
+    {
+        obj = static_cast<asIScriptObject*>(script_engine->CreateScriptObject(type));
+    }
+
+    const uint32_t iteration_count  = 10;
+    const float delta_time          = 1.0f / 60.0f;
+
+    auto start = chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < iteration_count; i++)
+    {
+        for (asIScriptObject* obj : objects)
+        {
+            scripting->ExecuteCall(update, obj, delta_time);
+        }
+    }
+    chrono::duration<double, milli> duration = chrono::high_resolution_clock::now() - start;
+    Spartan::Tests::ReportResult("scripting_update_individual_10k", duration.count() / iteration_count, "ms");
+
+    start = chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < iteration_count; i++)
+    {
+        for (asIScriptObject* obj : objects)
+        {
+            scripting->QueueUpdate(update, obj, delta_time);
+        }
+        scripting->ExecuteUpdates();
+    }
+    duration = chrono::high_resolution_clock::now() - start;
+    Spartan::Tests::ReportResult("scripting_update_batched_10k", duration.count() / iteration_count, "ms");
+
+    for (asIScriptObject* obj : objects)
+    {
+        obj->Release();
+    }
+    script_engine->DiscardModule("Benchmark");
+}
+
+// Updating 10k instances of a script with some work in it, as a regular script (on the main thread) and as a thread safe one (on the job system)
+BENCHMARK(scripting_update_parallel)
+{
+    WindowData window_data;
+    window_data.width   = 64;
+    window_data.height  = 64;
+    Engine engine(window_data);
+    Scripting* scripting            = engine.GetContext()->GetSubsystem<Scripting>();
+    asIScriptEngine* script_engine  = scripting->GetAsIScriptEngine();
+
+    static const char* source =
+        "class Serial"
+        "{"
+        "    float state = 0.0f;"
+        "    void Update(float delta_time) { for (int i = 0; i < 64; i++) { state = state * 0.99f + delta_time * float(i); } }"
+        "}"
+        "class Parallel : ThreadSafe"
+        "{"
+        "    float state = 0.0f;"
+        "    void Update(float delta_time) { for (int i = 0; i < 64; i++) { state = state * 0.99f + delta_time * float(i); } }"
+        "}";
+
+    asIScriptModule* module = script_engine->GetModule("BenchmarkParallel", asGM_ALWAYS_CREATE);
+    CHECK(module->AddScriptSection("BenchmarkParallel", source) >= 0 && module->Build() >= 0);
+
+    const uint32_t iteration_count  = 10;
+    const float delta_time          = 1.0f / 60.0f;
+    const pair<const char*, const char*> runs[] = { { "Serial", "scripting_update_serial_10k" }, { "Parallel", "scripting_update_parallel_10k" } };
+    for (const auto& run : runs)
+    {
+        asITypeInfo* type           = module->GetTypeInfoByDecl(run.first);
+        asIScriptFunction* update   = type->GetMethodByDecl("void Update(float delta_time)");
+        vector<asIScriptObject*> objects(10000);
+        for (asIScriptObject*& obj : objects)
+        {
+            obj = static_cast<asIScriptObject*>(script_engine->CreateScriptObject(type));
+        }
+
+        const auto start = chrono::high_resolution_clock::now();
+        for (uint32_t i = 0; i < iteration_count; i++)
+        {
+            for (asIScriptObject* obj : objects)
+            {
+                scripting->QueueUpdate(update, obj, delta_time);
+            }
+            scripting->ExecuteUpdates();
+        }
+        const chrono::duration<double, milli> duration = chrono::high_resolution_clock::now() - start;
+        Spartan::Tests::ReportResult(run.second, duration.count() / iteration_count, "ms");
+
+        for (asIScriptObject* obj : objects)
+        {
+            obj->Release();
+        }
+    }
+    script_engine->DiscardModule("BenchmarkParallel");
+}
+
+#endif
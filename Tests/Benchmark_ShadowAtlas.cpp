@@ -0,0 +1,75 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==================
+#include "Test.h"
+#include "Rendering/ShadowAtlas.h"
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cstdio>
+//=============================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+//============================
+
+// Packing random point and spot lights (a third of them are point lights) into a 4K atlas with 128 texel tiles
+BENCHMARK(shadow_atlas_pack)
+{
+    const uint32_t iteration_count = 100;
+
+    for (const uint32_t request_count : { 64u, 1024u })
+    {
+        ShadowAtlas atlas(4096, 128);
+        mt19937 generator(7);
+        uniform_real_distribution<float> distribution(0.0f, 1.0f);
+
+        vector<ShadowAtlasRequest> requests(request_count);
+        double occupancy_sum    = 0.0;
+        double elapsed_ms       = 0.0;
+        for (uint32_t i = 0; i < iteration_count; i++)
+        {
+            for (uint32_t j = 0; j < request_count; j++)
+            {
+                const float coverage    = distribution(generator);
+                requests[j].id          = j;
+                requests[j].tile_count  = (j % 3 == 0) ? 6 : 1;
+                requests[j].size        = atlas.ComputeTileSize(coverage, requests[j].tiles[0].size);
+                requests[j].priority    = coverage;
+            }
+
+            const auto start = chrono::high_resolution_clock::now();
+            atlas.Pack(requests);
+            const chrono::duration<double, milli> duration = chrono::high_resolution_clock::now() - start;
+
+            elapsed_ms      += duration.count();
+            occupancy_sum   += atlas.GetOccupancy();
+        }
+
+        char name[64];
+        snprintf(name, sizeof(name), "shadow_atlas_pack_%u_lights", request_count);
+        Spartan::Tests::ReportResult(name, elapsed_ms / iteration_count, "ms");
+        snprintf(name, sizeof(name), "shadow_atlas_occupancy_%u_lights", request_count);
+        Spartan::Tests::ReportResult(name, occupancy_sum / iteration_count * 100.0, "%");
+    }
+}
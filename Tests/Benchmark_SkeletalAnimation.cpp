@@ -0,0 +1,133 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ==================
+#include "Test.h"
+#include "Rendering/Animation.h"
+#include "Rendering/SkeletalAnimation.h"
+#include "Threading/Threading.h"
+#include <chrono>
+#include <cmath>
+//=============================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+// 1k characters with a 64 bone skeleton (a wide tree rather than a chain), at different points of a walk and half of them
+// crossfading into a run, evaluated one at a time and split across the job system
+BENCHMARK(skeletal_animation_evaluate)
+{
+    const uint32_t character_count  = 1000;
+    const uint32_t bone_count       = 64;
+    const uint32_t iteration_count  = 10;
+    const float delta_time          = 1.0f / 60.0f;
+
+    Skeleton skeleton;
+    for (uint32_t i = 0; i < bone_count; i++)
+    {
+        const int32_t parent = i == 0 ? -1 : static_cast<int32_t>((i - 1) / 3);
+        skeleton.AddBone("bone_" + to_string(i), parent, Matrix::Identity, Vector3(0.0f, 0.1f, 0.0f), Quaternion::Identity, Vector3::One);
+    }
+
+    // Keyed every tick, like most imported animations
+    const auto create_animation = [bone_count](const char* name, const double duration, const float speed)
+    {
+        Animation animation(nullptr);
+        animation.SetName(name);
+        animation.SetDuration(duration);
+        animation.SetTicksPerSec(30.0);
+
+        for (uint32_t i = 0; i < bone_count; i++)
+        {
+            AnimationNode channel;
+            channel.name = "bone_" + to_string(i);
+            for (uint32_t tick = 0; tick <= static_cast<uint32_t>(duration); tick++)
+            {
+                const float angle = sin(static_cast<float>(tick) * speed + static_cast<float>(i)) * 0.5f;
+                channel.rotationFrames.emplace_back(KeyQuaternion{ static_cast<double>(tick), Quaternion::FromEulerAngles(angle * Helper::RAD_TO_DEG, 0.0f, 0.0f) });
+                channel.positionFrames.emplace_back(KeyVector{ static_cast<double>(tick), Vector3(0.0f, 0.1f, i == 0 ? static_cast<float>(tick) * 0.05f : 0.0f) });
+                channel.scaleFrames.emplace_back(KeyVector{ static_cast<double>(tick), Vector3::One });
+            }
+            animation.AddChannel(move(channel));
+        }
+
+        return animation;
+    };
+    const Animation walk = create_animation("walk", 30.0, 0.2f);
+    const Animation run  = create_animation("run", 20.0, 0.35f);
+
+    AnimationClip clip_walk;
+    AnimationClip clip_run;
+    CHECK(clip_walk.Build(walk, skeleton));
+    CHECK(clip_run.Build(run, skeleton));
+
+    uint64_t source_size = 0;
+    for (const Animation* animation : { &walk, &run })
+    {
+        for (const AnimationNode& channel : animation->GetChannels())
+        {
+            source_size += channel.rotationFrames.size() * sizeof(KeyQuaternion) + (channel.positionFrames.size() + channel.scaleFrames.size()) * sizeof(KeyVector);
+        }
+    }
+
+    vector<SkeletonInstance> instances(character_count, SkeletonInstance(&skeleton));
+    for (uint32_t i = 0; i < character_count; i++)
+    {
+        instances[i].Play(&clip_walk);
+        instances[i].Tick(static_cast<float>(i) * 0.013f);
+        if (i % 2 == 0)
+        {
+            instances[i].CrossFade(&clip_run, 1000.0f);
+        }
+    }
+
+    Threading threading(nullptr);
+    double serial_ms    = 0.0;
+    double parallel_ms  = 0.0;
+    for (uint32_t i = 0; i < iteration_count; i++)
+    {
+        auto start = chrono::high_resolution_clock::now();
+        for (SkeletonInstance& instance : instances)
+        {
+            instance.Tick(delta_time);
+            instance.Evaluate();
+        }
+        const chrono::duration<double, milli> duration_serial = chrono::high_resolution_clock::now() - start;
+        serial_ms += duration_serial.count();
+
+        start = chrono::high_resolution_clock::now();
+        for (SkeletonInstance& instance : instances)
+        {
+            instance.Tick(delta_time);
+        }
+        SkeletonInstance::Evaluate(&threading, instances);
+        const chrono::duration<double, milli> duration_parallel = chrono::high_resolution_clock::now() - start;
+        parallel_ms += duration_parallel.count();
+    }
+
+    Spartan::Tests::ReportResult("skeletal_animation_serial_1k", serial_ms / iteration_count, "ms");
+    Spartan::Tests::ReportResult("skeletal_animation_parallel_1k", parallel_ms / iteration_count, "ms");
+    Spartan::Tests::ReportResult("skeletal_animation_clip_compression", static_cast<double>(source_size) / static_cast<double>(clip_walk.GetSizeBytes() + clip_run.GetSizeBytes()), "x");
+}
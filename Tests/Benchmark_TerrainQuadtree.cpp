@@ -0,0 +1,156 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// The quadtree creates its buffers through the renderer's device, so only solutions generated with Generate_VS2019_Null.bat build this benchmark
+#ifdef API_GRAPHICS_NULL
+
+//= INCLUDES ==========================
+#include "Test.h"
+#include "Core/Engine.h"
+#include "Core/Context.h"
+#include "Rendering/Renderer.h"
+#include "Rendering/TerrainQuadtree.h"
+#include "Math/MathHelper.h"
+#include "Math/Matrix.h"
+#include "Threading/Threading.h"
+#include "RHI/RHI_Vertex.h"
+#include <chrono>
+#include <cmath>
+//=====================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+namespace
+{
+    // Rolling hills, the same for every run
+    vector<uint8_t> generate_heights(const uint32_t size)
+    {
+        vector<uint8_t> heights(static_cast<size_t>(size) * size);
+        for (uint32_t y = 0; y < size; y++)
+        {
+            for (uint32_t x = 0; x < size; x++)
+            {
+                const float h = 0.5f + 0.25f * sin(x * 0.01f) * cos(y * 0.013f) + 0.2f * sin((x + y) * 0.05f);
+                heights[static_cast<size_t>(y) * size + x] = static_cast<uint8_t>(Helper::Saturate(h) * 255.0f);
+            }
+        }
+
+        return heights;
+    }
+}
+
+// Streaming the patches around a camera over a 4k height map (generated on the job system), then the per frame
+// cost of the selection (with balancing and stitching) once they are resident
+BENCHMARK(terrain_quadtree)
+{
+    WindowData window_data;
+    window_data.width   = 64;
+    window_data.height  = 64;
+    Engine engine(window_data);
+    Context* context = engine.GetContext();
+
+    const uint32_t size = 4097;
+    TerrainQuadtree quadtree(context->GetSubsystem<Threading>(), context->GetSubsystem<Renderer>()->GetRhiDevice());
+    CHECK(quadtree.Initialize(generate_heights(size), size, size, 0.0f, 100.0f));
+
+    // Stream until nothing is in flight and nothing else is requested
+    const Vector3 camera_position   = Vector3(500.0f, 120.0f, -300.0f);
+    uint64_t frame                  = 0;
+    {
+        const uint32_t chunk_count  = quadtree.GetChunkCount();
+        const auto start            = chrono::high_resolution_clock::now();
+        bool is_streaming           = true;
+        while (is_streaming)
+        {
+            // Results are swapped in by the update, so it's done once an update which started with nothing in flight requests nothing
+            const bool was_idle                 = quadtree.GetChunkJobCount() == 0;
+            const uint32_t chunk_count_previous = quadtree.GetChunkCount();
+            quadtree.Update(camera_position, Matrix::Identity, ++frame);
+            is_streaming = !was_idle || quadtree.GetChunkCount() != chunk_count_previous;
+        }
+        const chrono::duration<double> duration = chrono::high_resolution_clock::now() - start;
+
+        Spartan::Tests::ReportResult("terrain_chunks_generated", static_cast<double>(quadtree.GetChunkCount() - chunk_count), "chunks");
+        Spartan::Tests::ReportResult("terrain_chunk_generation", (quadtree.GetChunkCount() - chunk_count) / Helper::Max(duration.count(), 0.000001), "chunks/s");
+    }
+
+    // Selection, with every patch resident
+    {
+        const uint32_t iteration_count = 100;
+        const auto start = chrono::high_resolution_clock::now();
+        for (uint32_t i = 0; i < iteration_count; i++)
+        {
+            quadtree.Update(camera_position, Matrix::Identity, ++frame);
+        }
+        const chrono::duration<double, milli> duration = chrono::high_resolution_clock::now() - start;
+
+        Spartan::Tests::ReportResult("terrain_lod_selection", duration.count() / iteration_count, "ms");
+        Spartan::Tests::ReportResult("terrain_patches", static_cast<double>(quadtree.GetPatches().size()), "patches");
+    }
+}
+
+// Generating every full resolution patch (positions, and the normals and tangents from the neighbouring samples) of 1k, 4k and 8k height maps,
+// one patch at a time on a single thread, which is how the streaming jobs generate them
+BENCHMARK(terrain_patch_generation)
+{
+    WindowData window_data;
+    window_data.width   = 64;
+    window_data.height  = 64;
+    Engine engine(window_data);
+    Context* context = engine.GetContext();
+
+    vector<RHI_Vertex_PosTexNorTan> vertices;
+    BoundingBox aabb;
+    for (const uint32_t size : { 1025u, 4097u, 8193u })
+    {
+        TerrainQuadtree quadtree(context->GetSubsystem<Threading>(), context->GetSubsystem<Renderer>()->GetRhiDevice());
+        CHECK(quadtree.Initialize(generate_heights(size), size, size, 0.0f, 100.0f));
+
+        const uint32_t level        = quadtree.GetLevelCount() - 1;
+        const uint32_t node_count   = (size - 1) / TerrainQuadtree::patch_quads;
+        uint64_t vertex_count       = 0;
+        float checksum              = 0.0f; // keeps the work from being optimised away
+
+        const auto start = chrono::high_resolution_clock::now();
+        for (uint32_t y = 0; y < node_count; y++)
+        {
+            for (uint32_t x = 0; x < node_count; x++)
+            {
+                quadtree.GeneratePatch(level, x, y, vertices, aabb);
+                vertex_count    += vertices.size();
+                checksum        += vertices.back().nor[1];
+            }
+        }
+        const chrono::duration<double, milli> duration = chrono::high_resolution_clock::now() - start;
+        CHECK(vertex_count == static_cast<uint64_t>(node_count) * node_count * (TerrainQuadtree::patch_quads + 1) * (TerrainQuadtree::patch_quads + 1));
+        CHECK(checksum > 0.0f);
+
+        const string name = "terrain_patch_generation_" + to_string((size - 1) / 1024) + "k";
+        Spartan::Tests::ReportResult(name.c_str(), duration.count(), "ms");
+        Spartan::Tests::ReportResult((name + "_throughput").c_str(), vertex_count / Helper::Max(duration.count() * 1000.0, 0.001), "Mvertices/s");
+    }
+}
+
+#endif
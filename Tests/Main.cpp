@@ -0,0 +1,106 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES =====
+#include "Test.h"
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+//================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+    namespace Tests
+    {
+        static uint32_t g_failure_count = 0;
+
+        vector<Test_Case>& GetTestCases()
+        {
+            static vector<Test_Case> test_cases;
+            return test_cases;
+        }
+
+        void ReportFailure(const char* file, const int line, const char* expression)
+        {
+            printf("    FAILED: %s (%s:%d)\n", expression, file, line);
+            g_failure_count++;
+        }
+
+        void ReportResult(const char* name, const double value, const char* unit)
+        {
+            printf("    %-40s %12.3f %s\n", name, value, unit);
+        }
+
+        string GetTempDirectory(const char* name)
+        {
+            const filesystem::path path = filesystem::temp_directory_path() / "spartan_tests" / name;
+            error_code error;
+            filesystem::remove_all(path, error);
+            filesystem::create_directories(path, error);
+            return path.generic_string();
+        }
+    }
+}
+
+// Usage: Tests [--benchmark] [filter]
+int main(int argc, char* argv[])
+{
+    using namespace Spartan::Tests;
+
+    bool run_benchmarks = false;
+    const char* filter  = nullptr;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--benchmark") == 0)
+        {
+            run_benchmarks = true;
+        }
+        else
+        {
+            filter = argv[i];
+        }
+    }
+
+    uint32_t run_count = 0;
+    for (const Test_Case& test_case : GetTestCases())
+    {
+        if (test_case.is_benchmark != run_benchmarks)
+            continue;
+
+        if (filter && !strstr(test_case.name, filter))
+            continue;
+
+        const uint32_t failures_before = g_failure_count;
+        printf("%s %s\n", test_case.is_benchmark ? "[benchmark]" : "[test]", test_case.name);
+        test_case.function();
+        printf("    %s\n", g_failure_count == failures_before ? "ok" : "failed");
+        run_count++;
+    }
+
+    printf("%u ran, %u failure(s)\n", run_count, g_failure_count);
+    return g_failure_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,75 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+//= INCLUDES ======
+#include <vector>
+#include <string>
+//=================
+
+// A minimal test runner, tests and benchmarks register themselves and Main.cpp runs them.
+// Tests run by default, benchmarks only when the executable is started with --benchmark.
+
+namespace Spartan
+{
+    namespace Tests
+    {
+        struct Test_Case
+        {
+            const char* name;
+            void (*function)();
+            bool is_benchmark;
+        };
+
+        std::vector<Test_Case>& GetTestCases();
+        void ReportFailure(const char* file, int line, const char* expression);
+        void ReportResult(const char* name, double value, const char* unit);
+        std::string GetTempDirectory(const char* name); // Creates an empty directory under the system's temp directory
+
+        struct Test_Registrar
+        {
+            Test_Registrar(const char* name, void (*function)(), bool is_benchmark) { GetTestCases().push_back({ name, function, is_benchmark }); }
+        };
+    }
+}
+
+#define TEST(name)                                                                                      \
+    static void test_##name();                                                                          \
+    static Spartan::Tests::Test_Registrar test_registrar_##name(#name, test_##name, false);            \
+    static void test_##name()
+
+#define BENCHMARK(name)                                                                                 \
+    static void benchmark_##name();                                                                     \
+    static Spartan::Tests::Test_Registrar benchmark_registrar_##name(#name, benchmark_##name, true);   \
+    static void benchmark_##name()
+
+// Stops the current test on failure
+#define CHECK(expression)                                                               \
+    do                                                                                  \
+    {                                                                                   \
+        if (!(expression))                                                              \
+        {                                                                               \
+            Spartan::Tests::ReportFailure(__FILE__, __LINE__, #expression);            \
+            return;                                                                     \
+        }                                                                               \
+    } while (false)
@@ -0,0 +1,238 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ==================
+#include "Test.h"
+#include "Resource/AssetIndex.h"
+#include "Threading/Threading.h"
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <Windows.h>
+//=============================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+//============================
+
+TEST(asset_index_scan_matches_disk_with_and_without_threads)
+{
+    const string root = Spartan::Tests::GetTempDirectory("asset_index_scan");
+    static const char* extensions[] = { ".png", ".fbx", ".wav", ".txt" };
+    for (uint32_t i = 0; i < 400; i++)
+    {
+        const string directory = root + "/" + to_string(i / 100) + "/" + to_string(i / 10);
+        if (i % 10 == 0)
+        {
+            FileSystem::CreateDirectory_(directory);
+        }
+
+        ofstream(directory + "/file_" + to_string(i) + extensions[i % 4]);
+    }
+
+    Threading threading(nullptr);
+    AssetIndex index_serial(nullptr);
+    AssetIndex index_parallel(&threading);
+    CHECK(index_serial.Scan(root));
+    CHECK(index_parallel.Scan(root));
+
+    // The root, 4 top level directories and 40 below them
+    CHECK(index_serial.GetFileCount() == 400);
+    CHECK(index_serial.GetDirectoryCount() == 45);
+    CHECK(index_serial.GetFiles(File_Image).size() == 100);
+    CHECK(index_serial.GetFiles(File_Model).size() == 100);
+    CHECK(index_serial.GetFiles(File_Audio).size() == 100);
+    CHECK(index_serial.GetFileType(root + "/0/0/file_0.png") == File_Image);
+    CHECK(index_serial.GetFilesInDirectory(root + "/1/12").size() == 10);
+    CHECK(index_serial.GetDirectoriesInDirectory(root).size() == 4);
+
+    // Same contents, in the same order, no matter which thread listed which directory
+    CHECK(index_parallel.GetFileCount() == index_serial.GetFileCount());
+    CHECK(index_parallel.GetDirectoryCount() == index_serial.GetDirectoryCount());
+    for (uint32_t type = 0; type < File_Type_Count; type++)
+    {
+        CHECK(index_parallel.GetFiles(static_cast<File_Type>(type)) == index_serial.GetFiles(static_cast<File_Type>(type)));
+    }
+
+    FileSystem::Delete(root);
+}
+
+TEST(asset_index_picks_up_changes_on_poll)
+{
+    const string root = Spartan::Tests::GetTempDirectory("asset_index_changes");
+    FileSystem::CreateDirectory_(root + "/textures");
+    ofstream(root + "/textures/old.png");
+
+    AssetIndex index(nullptr);
+    CHECK(index.Scan(root));
+    CHECK(index.Contains(root + "/textures/old.png"));
+
+    FileSystem::Delete(root + "/textures/old.png");
+    FileSystem::CreateDirectory_(root + "/models");
+    ofstream(root + "/models/new.fbx");
+
+    // Change notifications arrive asynchronously and polling only checks every so often, so give it a few seconds
+    const auto poll_until = [&index](const function<bool()>& condition)
+    {
+        for (uint32_t i = 0; i < 100 && !condition(); i++)
+        {
+            this_thread::sleep_for(chrono::milliseconds(50));
+            index.Poll();
+        }
+        return condition();
+    };
+
+    CHECK(poll_until([&] { return index.Contains(root + "/models/new.fbx") && !index.Contains(root + "/textures/old.png"); }));
+    CHECK(index.IsIndexed(root + "/models"));
+    CHECK(index.GetFiles(File_Model).size() == 1);
+    CHECK(index.GetFiles(File_Image).empty());
+
+    FileSystem::Delete(root + "/models");
+    CHECK(poll_until([&] { return !index.IsIndexed(root + "/models"); }));
+    CHECK(index.GetFileCount() == 0);
+
+    FileSystem::Delete(root);
+}
+
+namespace
+{
+    // Lays out FILE_NOTIFY_INFORMATION records the way ReadDirectoryChangesW does (DWORD aligned, names not null terminated)
+    vector<DWORD> make_notifications(const vector<pair<DWORD, string>>& changes, uint32_t* size)
+    {
+        vector<DWORD> buffer;
+        for (uint32_t i = 0; i < changes.size(); i++)
+        {
+            const string& name          = changes[i].second;
+            const size_t name_size      = name.size() * sizeof(WCHAR);
+            const size_t record_size    = offsetof(FILE_NOTIFY_INFORMATION, FileName) + name_size;
+            const size_t record_dwords  = (record_size + sizeof(DWORD) - 1) / sizeof(DWORD);
+
+            const size_t offset = buffer.size();
+            buffer.resize(offset + record_dwords, 0);
+
+            FILE_NOTIFY_INFORMATION* info   = reinterpret_cast<FILE_NOTIFY_INFORMATION*>(&buffer[offset]);
+            info->NextEntryOffset           = i + 1 < changes.size() ? static_cast<DWORD>(record_dwords * sizeof(DWORD)) : 0;
+            info->Action                    = changes[i].first;
+            info->FileNameLength            = static_cast<DWORD>(name_size);
+            for (size_t c = 0; c < name.size(); c++)
+            {
+                info->FileName[c] = static_cast<WCHAR>(name[c]);
+            }
+        }
+
+        *size = static_cast<uint32_t>(buffer.size() * sizeof(DWORD));
+        return buffer;
+    }
+}
+
+TEST(asset_index_applies_renames_from_notifications)
+{
+    const string root = Spartan::Tests::GetTempDirectory("asset_index_notifications");
+    FileSystem::CreateDirectory_(root + "/textures/ui");
+    ofstream(root + "/textures/stone.png");
+    ofstream(root + "/textures/ui/button.png");
+    ofstream(root + "/readme.txt");
+
+    AssetIndex index(nullptr);
+    CHECK(index.Scan(root));
+    CHECK(index.GetFileCount() == 3);
+    CHECK(index.GetDirectoryCount() == 3);
+
+    // A directory rename is reported as its old and new name only, not as changes to what's inside it
+    filesystem::rename(root + "/textures", root + "/images");
+    {
+        uint32_t size = 0;
+        const vector<DWORD> buffer = make_notifications({ { FILE_ACTION_RENAMED_OLD_NAME, "textures" }, { FILE_ACTION_RENAMED_NEW_NAME, "images" } }, &size);
+        CHECK(index.ApplyNotifications(buffer.data(), size));
+    }
+    CHECK(!index.IsIndexed(root + "/textures"));
+    CHECK(!index.IsIndexed(root + "/textures/ui"));
+    CHECK(!index.Contains(root + "/textures/stone.png"));
+    CHECK(index.IsIndexed(root + "/images"));
+    CHECK(index.IsIndexed(root + "/images/ui"));
+    CHECK(index.Contains(root + "/images/stone.png"));
+    CHECK(index.Contains(root + "/images/ui/button.png"));
+    CHECK(index.GetFiles(File_Image).size() == 2);
+    CHECK(index.GetDirectoriesInDirectory(root) == vector<string>{ root + "/images" });
+    CHECK(index.GetFileCount() == 3);
+    CHECK(index.GetDirectoryCount() == 3);
+
+    // File renames (which change the type) and nested names, which use backslashes, in a single buffer
+    filesystem::rename(root + "/readme.txt", root + "/readme.png");
+    ofstream(root + "/images/ui/cursor.png");
+    {
+        uint32_t size = 0;
+        const vector<DWORD> buffer = make_notifications(
+        {
+            { FILE_ACTION_RENAMED_OLD_NAME, "readme.txt" },
+            { FILE_ACTION_RENAMED_NEW_NAME, "readme.png" },
+            { FILE_ACTION_ADDED,            "images\\ui\\cursor.png" }
+        }, &size);
+        CHECK(index.ApplyNotifications(buffer.data(), size));
+    }
+    CHECK(!index.Contains(root + "/readme.txt"));
+    CHECK(index.GetFileType(root + "/readme.png") == File_Image);
+    CHECK(index.Contains(root + "/images/ui/cursor.png"));
+    CHECK(index.GetFiles(File_Image).size() == 4);
+
+    // Removing a directory removes everything below it
+    FileSystem::Delete(root + "/images");
+    {
+        uint32_t size = 0;
+        const vector<DWORD> buffer = make_notifications({ { FILE_ACTION_REMOVED, "images" } }, &size);
+        CHECK(index.ApplyNotifications(buffer.data(), size));
+    }
+    CHECK(!index.IsIndexed(root + "/images/ui"));
+    CHECK(index.GetFileCount() == 1);
+    CHECK(index.GetDirectoryCount() == 1);
+
+    FileSystem::Delete(root);
+}
+
+TEST(asset_index_rescans_when_notifications_overflow)
+{
+    const string root = Spartan::Tests::GetTempDirectory("asset_index_overflow");
+    ofstream(root + "/old.png");
+
+    AssetIndex index(nullptr);
+    CHECK(index.Scan(root));
+
+    // Changes the notifications dropped
+    FileSystem::Delete(root + "/old.png");
+    FileSystem::CreateDirectory_(root + "/models");
+    ofstream(root + "/models/new.fbx");
+
+    // An empty read means the buffer overflowed, so the index is rebuilt from the disk
+    DWORD buffer[16] = {};
+    CHECK(!index.ApplyNotifications(buffer, 0));
+    CHECK(!index.Contains(root + "/old.png"));
+    CHECK(index.Contains(root + "/models/new.fbx"));
+    CHECK(index.IsIndexed(root + "/models"));
+    CHECK(index.GetFileCount() == 1);
+    CHECK(index.GetDirectoryCount() == 2);
+
+    FileSystem::Delete(root);
+}
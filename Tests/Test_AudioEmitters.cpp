@@ -0,0 +1,114 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==================
+#include "Test.h"
+#include "Audio/AudioEmitters.h"
+#include "Core/Timer.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+//=============================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+// An emitter moving at a constant speed, driven by the engine's fixed step loop. Positions are set every step (as World does) and the
+// emitters update every frame (as Audio does), so frames which run no step, or several of them, mustn't affect the velocity.
+TEST(audio_emitter_velocity_is_independent_of_the_frame_rate)
+{
+    const float speed = 6.0f;
+    const vector<vector<double>> frame_rates =
+    {
+        { 1000.0 / 60.0 },
+        { 1000.0 / 144.0 },
+        { 1000.0 / 30.0 },
+        { 7.0, 33.0, 12.5, 21.0, 4.0, 40.0 } // jittery
+    };
+
+    for (const vector<double>& frame_times_ms : frame_rates)
+    {
+        Timer timer(nullptr);
+        AudioEmitters emitters;
+        const uint32_t id   = emitters.Add(nullptr, 1000.0f, 128);
+        float x             = 0.0f;
+        emitters.SetPosition(id, Vector3(x, 0.0f, 0.0f), 0.0f);
+
+        float error_max = 0.0f;
+        for (uint32_t frame = 0; frame < 120; frame++)
+        {
+            const double frame_time_ms = frame_times_ms[frame % frame_times_ms.size()];
+            timer.StepFixed(frame_time_ms);
+            for (uint32_t i = 0; i < timer.GetFixedStepCount(); i++)
+            {
+                x += speed * timer.GetFixedDeltaTimeSec();
+                emitters.SetPosition(id, Vector3(x, 0.0f, 0.0f), timer.GetFixedDeltaTimeSec());
+            }
+            emitters.Update(Vector3::Zero, 32, static_cast<float>(frame_time_ms / 1000.0));
+
+            // Attributes are only pushed when the simulation moved the emitter
+            const bool moved = find(emitters.GetMoved().begin(), emitters.GetMoved().end(), id) != emitters.GetMoved().end();
+            CHECK(timer.GetFixedStepCount() == 0 ? !moved : (moved || frame == 0));
+
+            if (timer.GetFixedStepCount() != 0)
+            {
+                error_max = max(error_max, abs(emitters.Get(id).velocity.x - speed));
+            }
+        }
+
+        CHECK(error_max < 0.01f);
+    }
+}
+
+TEST(audio_emitters_voices_go_by_priority_then_distance)
+{
+    AudioEmitters emitters;
+    const uint32_t far_important    = emitters.Add(nullptr, 100.0f, 0);
+    const uint32_t near             = emitters.Add(nullptr, 100.0f, 128);
+    const uint32_t far              = emitters.Add(nullptr, 100.0f, 128);
+    const uint32_t out_of_range     = emitters.Add(nullptr, 10.0f, 0);
+    const uint32_t unplaced         = emitters.Add(nullptr, 100.0f, 0);
+    emitters.SetPosition(far_important, Vector3(90.0f, 0.0f, 0.0f), 0.0f);
+    emitters.SetPosition(near,          Vector3(5.0f, 0.0f, 0.0f), 0.0f);
+    emitters.SetPosition(far,           Vector3(50.0f, 0.0f, 0.0f), 0.0f);
+    emitters.SetPosition(out_of_range,  Vector3(20.0f, 0.0f, 0.0f), 0.0f);
+
+    emitters.Update(Vector3::Zero, 2, 1.0f / 60.0f);
+    CHECK(emitters.GetRealCount() == 2);
+    CHECK(emitters.GetCulledCount() == 2);
+    CHECK(emitters.Get(far_important).real);
+    CHECK(emitters.Get(near).real);
+    CHECK(!emitters.Get(far).real);
+    CHECK(!emitters.Get(out_of_range).real);
+    CHECK(!emitters.Get(unplaced).real);
+    CHECK(emitters.GetBecameReal().size() == 2);
+
+    // Virtual emitters keep track of how long they have been silent, so that they resume where they would have been
+    emitters.SetPosition(near, Vector3(200.0f, 0.0f, 0.0f), 1.0f / 60.0f);
+    emitters.Update(Vector3::Zero, 2, 0.5f);
+    CHECK(emitters.Get(far).real);
+    CHECK(!emitters.Get(near).real);
+    CHECK(emitters.GetBecameVirtual().size() == 1 && emitters.GetBecameVirtual()[0] == near);
+    CHECK(emitters.Get(near).virtual_time == 0.5f);
+}
@@ -0,0 +1,351 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+// Secondary command lists and chunked recording, on the null backend so that the merged command stream can be inspected
+#ifdef API_GRAPHICS_NULL
+
+//= INCLUDES ===========================
+#include "Test.h"
+#include "Core/Engine.h"
+#include "Core/Context.h"
+#include "Profiling/Profiler.h"
+#include "Rendering/Renderer.h"
+#include "Rendering/DrawList.h"
+#include "RHI/RHI_Implementation.h"
+#include "RHI/RHI_Device.h"
+#include "RHI/RHI_SwapChain.h"
+#include "RHI/RHI_CommandList.h"
+#include "RHI/RHI_PipelineState.h"
+#include "RHI/RHI_Shader.h"
+#include "RHI/RHI_Texture2D.h"
+#include "RHI/RHI_VertexBuffer.h"
+#include "RHI/RHI_IndexBuffer.h"
+#include "RHI/RHI_ConstantBuffer.h"
+#include "RHI/RHI_BlendState.h"
+#include "RHI/RHI_RasterizerState.h"
+#include "RHI/RHI_DepthStencilState.h"
+#include "RHI/RHI_DescriptorSetLayout.h"
+#include <memory>
+//======================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+//============================
+
+namespace
+{
+    // A pass with a few vertex buffers and one index buffer, so that bindings are redundant across draws
+    struct TestPass
+    {
+        TestPass(Context* context, const shared_ptr<RHI_Device>& rhi_device)
+        {
+            shader_v = make_shared<RHI_Shader>(rhi_device);
+            shader_v->Compile(RHI_Shader_Vertex, "void main() {}");
+            shader_p = make_shared<RHI_Shader>(rhi_device);
+            shader_p->Compile(RHI_Shader_Pixel, "void main() {}");
+
+            render_target   = make_shared<RHI_Texture2D>(context, 64, 64, RHI_Format_R8G8B8A8_Unorm);
+            blend           = make_shared<RHI_BlendState>(rhi_device, false);
+            rasterizer      = make_shared<RHI_RasterizerState>(rhi_device, RHI_Cull_Back, RHI_Fill_Solid, true, false, false, false);
+            depth_stencil   = make_shared<RHI_DepthStencilState>(rhi_device, false, false, RHI_Comparison_Always, false, false);
+
+            for (uint32_t i = 0; i < 3; i++)
+            {
+                vertex_buffers.emplace_back(make_shared<RHI_VertexBuffer>(rhi_device));
+                vertex_buffers.back()->Create(vector<float>(12, 0.0f));
+            }
+            index_buffer = make_shared<RHI_IndexBuffer>(rhi_device);
+            index_buffer->Create(vector<uint32_t>(36, 0));
+
+            pso.shader_vertex                   = shader_v.get();
+            pso.shader_pixel                    = shader_p.get();
+            pso.vertex_buffer_stride            = sizeof(float);
+            pso.blend_state                     = blend.get();
+            pso.rasterizer_state                = rasterizer.get();
+            pso.depth_stencil_state             = depth_stencil.get();
+            pso.render_target_color_textures[0] = render_target.get();
+            pso.viewport                        = render_target->GetViewport();
+            pso.primitive_topology              = RHI_PrimitiveTopology_TriangleList;
+        }
+
+        // Records draw_count draws (every fifth instanced), returns a copy of what the command list recorded
+        null_common::command_buffer Record(Renderer* renderer, RHI_CommandList* cmd_list, const uint32_t draw_count, const uint32_t chunk_count)
+        {
+            if (cmd_list->Begin(pso))
+            {
+                renderer->RecordChunked(cmd_list, draw_count, [this](RHI_CommandList* cmd_list, uint32_t start, uint32_t end)
+                {
+                    for (uint32_t i = start; i < end; i++)
+                    {
+                        cmd_list->SetBufferVertex(vertex_buffers[(i / 3) % vertex_buffers.size()]);
+                        cmd_list->SetBufferIndex(index_buffer);
+
+                        if (i % 5 == 0)
+                        {
+                            cmd_list->DrawIndexedInstanced(36, i % 4 + 2, i, 0);
+                        }
+                        else
+                        {
+                            cmd_list->DrawIndexed(36, i, i % 7);
+                        }
+                    }
+                }, chunk_count);
+                cmd_list->End();
+                cmd_list->Submit();
+            }
+
+            return *static_cast<null_common::command_buffer*>(cmd_list->GetResource_CommandBuffer());
+        }
+
+        shared_ptr<RHI_Shader> shader_v;
+        shared_ptr<RHI_Shader> shader_p;
+        shared_ptr<RHI_Texture2D> render_target;
+        shared_ptr<RHI_BlendState> blend;
+        shared_ptr<RHI_RasterizerState> rasterizer;
+        shared_ptr<RHI_DepthStencilState> depth_stencil;
+        vector<shared_ptr<RHI_VertexBuffer>> vertex_buffers;
+        shared_ptr<RHI_IndexBuffer> index_buffer;
+        RHI_PipelineState pso;
+    };
+
+    // What a draw executes with, redundant bindings don't matter but the order of the draws and the buffers they read do
+    struct ResolvedDraw
+    {
+        null_common::command_type type;
+        const void* vertex_buffer;
+        const void* index_buffer;
+        uint32_t args[4];
+
+        bool operator==(const ResolvedDraw& other) const
+        {
+            return type == other.type && vertex_buffer == other.vertex_buffer && index_buffer == other.index_buffer &&
+                args[0] == other.args[0] && args[1] == other.args[1] && args[2] == other.args[2] && args[3] == other.args[3];
+        }
+    };
+
+    vector<ResolvedDraw> resolve_draws(const null_common::command_buffer& cmd_buffer)
+    {
+        vector<ResolvedDraw> draws;
+        const void* vertex_buffer   = nullptr;
+        const void* index_buffer    = nullptr;
+
+        for (const null_common::command& cmd : cmd_buffer.commands)
+        {
+            if (cmd.type == null_common::command_execute_secondary)
+            {
+                // Nothing is inherited from what was recorded before
+                vertex_buffer   = nullptr;
+                index_buffer    = nullptr;
+            }
+            else if (cmd.type == null_common::command_bind_vertex_buffer)
+            {
+                vertex_buffer = cmd.resource;
+            }
+            else if (cmd.type == null_common::command_bind_index_buffer)
+            {
+                index_buffer = cmd.resource;
+            }
+            else if (cmd.type == null_common::command_draw_indexed || cmd.type == null_common::command_draw_indexed_instanced)
+            {
+                draws.push_back({ cmd.type, vertex_buffer, index_buffer, { cmd.args[0], cmd.args[1], cmd.args[2], cmd.args[3] } });
+            }
+        }
+
+        return draws;
+    }
+}
+
+// Whatever the chunk count, the draws execute in the order (and with the buffers) of a single threaded recording
+TEST(command_list_chunked_recording_matches_serial_recording)
+{
+    WindowData window_data;
+    window_data.width   = 64;
+    window_data.height  = 64;
+    Engine engine(window_data);
+    Context* context        = engine.GetContext();
+    Renderer* renderer      = context->GetSubsystem<Renderer>();
+    Profiler* profiler      = context->GetSubsystem<Profiler>();
+    RHI_Context* rhi_context = renderer->GetRhiDevice()->GetContextRhi();
+    RHI_CommandList* cmd_list = renderer->GetSwapChain()->GetCmdList();
+    CHECK(rhi_context->parallel_recording);
+
+    TestPass pass(context, renderer->GetRhiDevice());
+    CHECK(pass.shader_v->IsCompiled() && pass.shader_p->IsCompiled());
+
+    vector<pair<uint32_t, uint32_t>> ranges;
+    for (const uint32_t draw_count : { 1u, 10u, 100u, 1000u })
+    {
+        // Reference, recorded straight into the primary
+        rhi_context->parallel_recording = false;
+        const uint32_t draw_calls_before            = profiler->m_rhi_draw_calls;
+        const null_common::command_buffer serial    = pass.Record(renderer, cmd_list, draw_count, 8);
+        const vector<ResolvedDraw> draws_serial     = resolve_draws(serial);
+        CHECK(draws_serial.size() == draw_count);
+        CHECK(serial.count(null_common::command_execute_secondary) == 0);
+        CHECK(profiler->m_rhi_draw_calls - draw_calls_before == draw_count);
+        rhi_context->parallel_recording = true;
+
+        for (const uint32_t chunk_count : { 2u, 3u, 7u, 16u })
+        {
+            const uint32_t draw_calls_before_chunked    = profiler->m_rhi_draw_calls;
+            const null_common::command_buffer chunked   = pass.Record(renderer, cmd_list, draw_count, chunk_count);
+            CHECK(resolve_draws(chunked) == draws_serial);
+
+            // The secondaries' counters reach the profiler through the primary
+            CHECK(profiler->m_rhi_draw_calls - draw_calls_before_chunked == draw_count);
+
+            // A secondary per range of the partition, executed in order, each drawing its range
+            DrawList::Partition(draw_count, chunk_count, ranges);
+            CHECK(chunked.count(null_common::command_execute_secondary) == ranges.size());
+
+            uint32_t secondary_index    = 0;
+            uint32_t draws_in_secondary = 0;
+            uint32_t draws_total        = 0;
+            for (uint32_t i = 0; i < static_cast<uint32_t>(chunked.commands.size()); i++)
+            {
+                const null_common::command& cmd = chunked.commands[i];
+
+                if (cmd.type == null_common::command_begin_render_pass)
+                {
+                    CHECK(cmd.args[2] == 1); // the render pass contents are secondaries
+                }
+
+                if (cmd.type == null_common::command_execute_secondary)
+                {
+                    if (secondary_index > 0)
+                    {
+                        CHECK(draws_in_secondary == ranges[secondary_index - 1].second - ranges[secondary_index - 1].first);
+                    }
+
+                    // The command count covers everything up to the next secondary (or the end of the render pass)
+                    const uint32_t end = i + 1 + cmd.args[0];
+                    CHECK(end < chunked.commands.size());
+                    CHECK(chunked.commands[end].type == null_common::command_execute_secondary || chunked.commands[end].type == null_common::command_end_render_pass);
+
+                    secondary_index++;
+                    draws_in_secondary = 0;
+                }
+
+                if (cmd.type == null_common::command_draw_indexed || cmd.type == null_common::command_draw_indexed_instanced)
+                {
+                    draws_in_secondary++;
+                    draws_total++;
+                }
+            }
+            CHECK(draws_in_secondary == ranges.back().second - ranges.back().first);
+            CHECK(draws_total == draw_count);
+        }
+    }
+}
+
+// Every secondary binds descriptor sets from its own descriptor cache, and starts from a clean state
+TEST(command_list_secondaries_have_their_own_descriptor_state)
+{
+    WindowData window_data;
+    window_data.width   = 64;
+    window_data.height  = 64;
+    Engine engine(window_data);
+    Context* context            = engine.GetContext();
+    Renderer* renderer          = context->GetSubsystem<Renderer>();
+    RHI_CommandList* cmd_list   = renderer->GetSwapChain()->GetCmdList();
+
+    TestPass pass(context, renderer->GetRhiDevice());
+
+    // Recorded twice, the second recording reuses the secondaries (and their caches)
+    for (uint32_t recording = 0; recording < 2; recording++)
+    {
+        const null_common::command_buffer chunked = pass.Record(renderer, cmd_list, 64, 4);
+        CHECK(chunked.count(null_common::command_execute_secondary) == 4);
+
+        // Within each secondary: pipeline, descriptor set and buffers are bound before the first draw
+        vector<const void*> descriptor_sets;
+        bool bound_pipeline = false;
+        bool bound_set      = false;
+        bool bound_vertex   = false;
+        for (const null_common::command& cmd : chunked.commands)
+        {
+            switch (cmd.type)
+            {
+                case null_common::command_execute_secondary:
+                    bound_pipeline  = false;
+                    bound_set       = false;
+                    bound_vertex    = false;
+                    break;
+                case null_common::command_bind_pipeline:
+                    bound_pipeline = true;
+                    break;
+                case null_common::command_bind_descriptor_set:
+                    bound_set = true;
+                    if (descriptor_sets.empty() || descriptor_sets.back() != cmd.resource)
+                    {
+                        descriptor_sets.emplace_back(cmd.resource);
+                    }
+                    break;
+                case null_common::command_bind_vertex_buffer:
+                    bound_vertex = true;
+                    break;
+                case null_common::command_draw_indexed:
+                case null_common::command_draw_indexed_instanced:
+                    CHECK(bound_pipeline && bound_set && bound_vertex);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        // One descriptor set per secondary, none shared
+        CHECK(descriptor_sets.size() == 4);
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            for (uint32_t j = i + 1; j < 4; j++)
+            {
+                CHECK(descriptor_sets[i] != descriptor_sets[j]);
+            }
+        }
+    }
+}
+
+// Secondaries point to their element of a dynamic buffer without moving the buffer's own offset, which other threads read
+TEST(command_list_explicit_dynamic_offsets_leave_the_buffer_alone)
+{
+    auto rhi_device = make_shared<RHI_Device>(nullptr);
+    const uint32_t shift = rhi_device->GetContextRhi()->shader_shift_buffer;
+
+    RHI_DescriptorSetLayout layout(rhi_device.get(), { RHI_Descriptor(RHI_Descriptor_ConstantBufferDynamic, 2 + shift, RHI_Shader_Vertex) });
+
+    auto buffer = make_shared<RHI_ConstantBuffer>(rhi_device, true);
+    CHECK(buffer->Create<Math::Matrix>(16));
+    buffer->SetOffsetIndexDynamic(5);
+
+    layout.SetConstantBuffer(2, buffer.get(), 9);
+    CHECK(layout.GetDynamicOffsets().size() == 1);
+    CHECK(layout.GetDynamicOffsets()[0] == 9 * buffer->GetStride());
+    CHECK(buffer->GetOffsetIndexDynamic() == 5);
+
+    // Without an explicit offset, the buffer's is used
+    layout.SetConstantBuffer(2, buffer.get());
+    CHECK(layout.GetDynamicOffsets()[0] == 5 * buffer->GetStride());
+}
+
+#endif
@@ -0,0 +1,263 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+//= INCLUDES ===========================
+#include "Test.h"
+#include "Rendering/DrawList.h"
+#include "Rendering/Renderer_ConstantBuffers.h"
+//======================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+//============================
+
+TEST(draw_list_partition_covers_range_in_order)
+{
+    vector<pair<uint32_t, uint32_t>> ranges;
+
+    for (uint32_t count = 0; count < 100; count++)
+    {
+        for (uint32_t chunk_count = 1; chunk_count < 12; chunk_count++)
+        {
+            DrawList::Partition(count, chunk_count, ranges);
+
+            // Contiguous, non-empty and no more chunks than asked for
+            CHECK(ranges.size() == (count < chunk_count ? count : chunk_count));
+            uint32_t next = 0;
+            for (const auto& range : ranges)
+            {
+                CHECK(range.first == next);
+                CHECK(range.second > range.first);
+                next = range.second;
+            }
+            CHECK(next == count);
+
+            // Sizes differ by one at most
+            if (!ranges.empty())
+            {
+                const uint32_t size_first   = ranges.front().second - ranges.front().first;
+                const uint32_t size_last    = ranges.back().second - ranges.back().first;
+                CHECK(size_first - size_last <= 1);
+            }
+        }
+    }
+
+    DrawList::Partition(10, 0, ranges);
+    CHECK(ranges.empty());
+}
+
+TEST(draw_list_build_without_threading)
+{
+    DrawList draw_list;
+    draw_list.Build(nullptr, {}, [](DrawCall&) { return true; });
+
+    CHECK(draw_list.IsEmpty());
+    CHECK(draw_list.GetBatches().empty());
+    CHECK(draw_list.GetChunkCount() == 0);
+}
+
+TEST(draw_list_batch_is_deterministic)
+{
+    // Two materials and two meshes interleaved, the pointers only serve as keys
+    const auto vertex_buffer = [](uint32_t i) { return reinterpret_cast<const RHI_VertexBuffer*>(static_cast<uintptr_t>(0x1000 + i * 0x10)); };
+    const auto material      = [](uint32_t i) { return reinterpret_cast<Material*>(static_cast<uintptr_t>(0x2000 + i * 0x10)); };
+
+    const uint32_t draw_call_count = 103;
+    DrawList draw_list;
+    for (uint32_t i = 0; i < draw_call_count; i++)
+    {
+        DrawCall draw_call;
+        draw_call.vertex_buffer = vertex_buffer(i % 2);
+        draw_call.material      = material((i / 2) % 2);
+        draw_call.index_count   = 36;
+        draw_call.entity_index  = i;
+        draw_list.GetDrawCalls().emplace_back(draw_call);
+    }
+    draw_list.GetBatches().resize(draw_call_count);
+
+    const uint32_t batch_size_max = 8;
+    draw_list.Batch(batch_size_max);
+
+    const auto& draw_calls  = draw_list.GetDrawCalls();
+    const auto& batches     = draw_list.GetBatches();
+    CHECK(draw_calls.size() == draw_call_count);
+    CHECK(draw_list.HasInstances());
+
+    uint32_t covered = 0;
+    uint32_t first_index_previous = 0;
+    for (uint32_t i = 0; i < batches.size(); i++)
+    {
+        const DrawBatch& batch = batches[i];
+        CHECK(batch.count >= 1 && batch.count <= batch_size_max);
+        covered += batch.count;
+
+        // Every instance shares the batch's geometry and material, and keeps its built order
+        for (uint32_t j = batch.first + 1; j < batch.first + batch.count; j++)
+        {
+            CHECK(draw_calls[j].vertex_buffer == draw_calls[batch.first].vertex_buffer);
+            CHECK(draw_calls[j].material == draw_calls[batch.first].material);
+            CHECK(draw_calls[j].entity_index > draw_calls[j - 1].entity_index);
+        }
+
+        // Batches are ordered by where their first draw call was built
+        CHECK(i == 0 || draw_calls[batch.first].entity_index > first_index_previous);
+        first_index_previous = draw_calls[batch.first].entity_index;
+    }
+    CHECK(covered == draw_call_count);
+}
+
+namespace
+{
+    // The pointers only serve as keys
+    const RHI_VertexBuffer* vertex_buffer_key(uint32_t i)   { return reinterpret_cast<const RHI_VertexBuffer*>(static_cast<uintptr_t>(0x1000 + i * 0x10)); }
+    const RHI_IndexBuffer* index_buffer_key(uint32_t i)     { return reinterpret_cast<const RHI_IndexBuffer*>(static_cast<uintptr_t>(0x2000 + i * 0x10)); }
+    Material* material_key(uint32_t i)                      { return reinterpret_cast<Material*>(static_cast<uintptr_t>(0x3000 + i * 0x10)); }
+
+    DrawCall make_draw_call(const uint32_t entity_index)
+    {
+        DrawCall draw_call;
+        draw_call.vertex_buffer = vertex_buffer_key(0);
+        draw_call.index_buffer  = index_buffer_key(0);
+        draw_call.material      = material_key(0);
+        draw_call.index_count   = 36;
+        draw_call.entity_index  = entity_index;
+        return draw_call;
+    }
+
+    void batch(DrawList& draw_list, const uint32_t batch_size_max)
+    {
+        draw_list.GetBatches().resize(draw_list.GetDrawCalls().size());
+        draw_list.Batch(batch_size_max);
+    }
+}
+
+TEST(draw_list_batch_groups_by_geometry_material_and_range)
+{
+    // A pair of draws per variation, each pair differs from the reference in one field only
+    const vector<function<void(DrawCall&)>> variations =
+    {
+        [](DrawCall&) { },
+        [](DrawCall& draw_call) { draw_call.vertex_buffer = vertex_buffer_key(1); },
+        [](DrawCall& draw_call) { draw_call.index_buffer  = index_buffer_key(1); },
+        [](DrawCall& draw_call) { draw_call.material      = material_key(1); },
+        [](DrawCall& draw_call) { draw_call.index_offset  = 36; },
+        [](DrawCall& draw_call) { draw_call.index_count   = 72; },
+        [](DrawCall& draw_call) { draw_call.vertex_offset = 24; },
+    };
+
+    DrawList draw_list;
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        for (uint32_t v = 0; v < static_cast<uint32_t>(variations.size()); v++)
+        {
+            DrawCall draw_call = make_draw_call(i * static_cast<uint32_t>(variations.size()) + v);
+            variations[v](draw_call);
+            draw_list.GetDrawCalls().emplace_back(draw_call);
+        }
+    }
+    batch(draw_list, instance_batch_size);
+
+    // Every variation is its own batch of two, in the order the variations were built
+    const auto& draw_calls  = draw_list.GetDrawCalls();
+    const auto& batches     = draw_list.GetBatches();
+    CHECK(batches.size() == variations.size());
+    for (uint32_t v = 0; v < static_cast<uint32_t>(batches.size()); v++)
+    {
+        const DrawBatch& batch = batches[v];
+        CHECK(batch.count == 2);
+        CHECK(draw_calls[batch.first].entity_index == v);
+        CHECK(draw_calls[batch.first + 1].entity_index == v + variations.size());
+    }
+
+    // Not batching leaves the draws alone
+    DrawList draw_list_unbatched;
+    draw_list_unbatched.GetDrawCalls() = draw_calls;
+    batch(draw_list_unbatched, 1);
+    CHECK(!draw_list_unbatched.HasInstances());
+}
+
+TEST(draw_list_batch_splits_at_instance_batch_size)
+{
+    // An instanced draw can't address more transforms than the instance buffer holds
+    for (const uint32_t draw_call_count : { instance_batch_size - 1, instance_batch_size, instance_batch_size + 1, 3 * instance_batch_size + 5 })
+    {
+        DrawList draw_list;
+        for (uint32_t i = 0; i < draw_call_count; i++)
+        {
+            draw_list.GetDrawCalls().emplace_back(make_draw_call(i));
+        }
+        batch(draw_list, instance_batch_size);
+
+        // Full batches first, the remainder last, and the draws never leave their built order
+        const auto& draw_calls  = draw_list.GetDrawCalls();
+        const auto& batches     = draw_list.GetBatches();
+        CHECK(batches.size() == (draw_call_count + instance_batch_size - 1) / instance_batch_size);
+        for (uint32_t i = 0; i < static_cast<uint32_t>(batches.size()); i++)
+        {
+            const uint32_t count_expected = min(instance_batch_size, draw_call_count - i * instance_batch_size);
+            CHECK(batches[i].first == i * instance_batch_size);
+            CHECK(batches[i].count == count_expected);
+        }
+
+        for (uint32_t i = 0; i < draw_call_count; i++)
+        {
+            CHECK(draw_calls[i].entity_index == i);
+        }
+    }
+}
+
+TEST(draw_list_batch_keeps_front_to_back_order)
+{
+    // Built front to back (the entity index is the depth order), with three materials interleaved
+    const uint32_t material_pattern[]   = { 0, 1, 0, 2, 1, 0, 0, 2, 1, 1, 0, 2 };
+    const uint32_t draw_call_count      = sizeof(material_pattern) / sizeof(material_pattern[0]);
+
+    DrawList draw_list;
+    for (uint32_t i = 0; i < draw_call_count; i++)
+    {
+        DrawCall draw_call  = make_draw_call(i);
+        draw_call.material  = material_key(material_pattern[i]);
+        draw_list.GetDrawCalls().emplace_back(draw_call);
+    }
+    batch(draw_list, 3);
+
+    // Batches start with their nearest draw and follow each other by it, so the nearest draw of all is drawn first
+    const auto& draw_calls  = draw_list.GetDrawCalls();
+    const auto& batches     = draw_list.GetBatches();
+    CHECK(draw_calls[batches.front().first].entity_index == 0);
+
+    const uint32_t nearest_expected[] = { 0, 1, 3, 6, 9 }; // material 0: 0 2 5 | 6 10, material 1: 1 4 8 | 9, material 2: 3 7 11
+    CHECK(batches.size() == sizeof(nearest_expected) / sizeof(nearest_expected[0]));
+    for (uint32_t i = 0; i < static_cast<uint32_t>(batches.size()); i++)
+    {
+        const DrawBatch& batch = batches[i];
+        CHECK(draw_calls[batch.first].entity_index == nearest_expected[i]);
+
+        // Within a batch, instances stay front to back
+        for (uint32_t j = batch.first + 1; j < batch.first + batch.count; j++)
+        {
+            CHECK(draw_calls[j].entity_index > draw_calls[j - 1].entity_index);
+        }
+    }
+}
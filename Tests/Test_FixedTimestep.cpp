@@ -0,0 +1,161 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ===================================
+#include "Test.h"
+#include "Core/Timer.h"
+#ifdef API_GRAPHICS_NULL
+#include "Core/Engine.h"
+#include "Core/Context.h"
+#include "World/World.h"
+#include "World/Entity.h"
+#include "World/Components/Transform.h"
+#include "World/Components/Collider.h"
+#include "World/Components/RigidBody.h"
+#include <cstring>
+#endif
+//==============================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+// The simulation runs through the engine (Timer, the fixed step loop, World and Physics), which the null backend can host
+#ifdef API_GRAPHICS_NULL
+namespace
+{
+    // A ground box with a stack of boxes and a sphere thrown at it, enough contacts to expose any frame rate dependence.
+    // Frames are fed to the timer as overrides, so Engine::Tick() runs exactly as it does with a real clock.
+    vector<float> Simulate(const vector<double>& frame_times_ms, const uint32_t step_count, uint32_t* frame_count)
+    {
+        WindowData window_data;
+        window_data.width   = 64;
+        window_data.height  = 64;
+        Engine engine(window_data);
+        CHECK(engine.EngineMode_IsSet(Engine_Fixed));
+
+        Context* context    = engine.GetContext();
+        Timer* timer        = context->GetSubsystem<Timer>();
+        World* world        = context->GetSubsystem<World>();
+
+        vector<RigidBody*> bodies;
+        const auto add_body = [world, &bodies](const ColliderShape shape, const Vector3& size, const float mass, const Vector3& position)
+        {
+            auto& entity = world->EntityCreate();
+            entity->GetTransform()->SetPosition(position);
+            Collider* collider = entity->AddComponent<Collider>();
+            collider->SetShapeType(shape);
+            collider->SetBoundingBox(size);
+            RigidBody* body = entity->AddComponent<RigidBody>();
+            body->SetMass(mass);
+            bodies.emplace_back(body);
+            return body;
+        };
+
+        add_body(ColliderShape_Box, Vector3(100.0f, 1.0f, 100.0f), 0.0f, Vector3(0.0f, -0.5f, 0.0f));
+        for (uint32_t i = 0; i < 8; i++)
+        {
+            add_body(ColliderShape_Box, Vector3::One, 1.0f, Vector3(0.05f * i, 0.5f + 1.01f * i, 0.0f));
+        }
+        add_body(ColliderShape_Sphere, Vector3::One, 4.0f, Vector3(-10.0f, 3.0f, 0.0f))->SetLinearVelocity(Vector3(12.0f, 2.0f, 0.0f));
+
+        // The last frames are shortened so that every frame rate stops after exactly step_count steps (the extra microsecond
+        // makes up for the alpha's precision, it's far too little to ever complete another step)
+        uint32_t steps = 0;
+        *frame_count   = 0;
+        while (steps < step_count)
+        {
+            const double frame_time_ms  = frame_times_ms[*frame_count % frame_times_ms.size()];
+            const double remaining_ms   = (static_cast<double>(step_count - steps) - timer->GetFixedAlpha()) * timer->GetFixedDeltaTimeMs() + 0.001;
+            timer->SetFrameTimeOverrideMs(frame_time_ms < remaining_ms ? frame_time_ms : remaining_ms);
+
+            engine.Tick();
+            steps += timer->GetFixedStepCount();
+            (*frame_count)++;
+        }
+        CHECK(steps == step_count);
+
+        // The state the test compares, bit for bit, as the bodies report it back to their transforms
+        vector<float> state;
+        for (const RigidBody* body : bodies)
+        {
+            const Vector3 position      = body->GetTransform()->GetPosition();
+            const Quaternion rotation   = body->GetTransform()->GetRotation();
+            state.insert(state.end(), { position.x, position.y, position.z, rotation.x, rotation.y, rotation.z, rotation.w });
+        }
+        return state;
+    }
+}
+
+TEST(fixed_timestep_identical_across_frame_rates)
+{
+    const uint32_t step_count = 600; // 10 seconds at the default 60 Hz
+
+    uint32_t frames_reference = 0;
+    const vector<float> reference = Simulate({ 1000.0 / 60.0 }, step_count, &frames_reference);
+
+    // Something has to have moved for the comparison to mean anything
+    uint32_t frames_one_step = 0;
+    CHECK(Simulate({ 1000.0 / 60.0 }, 1, &frames_one_step) != reference);
+
+    const vector<vector<double>> frame_rates =
+    {
+        { 1000.0 / 30.0 },
+        { 1000.0 / 144.0 },
+        { 1000.0 / 240.0 },
+        { 7.0, 33.0, 12.5, 21.0, 4.0, 40.0 } // jittery
+    };
+
+    for (const vector<double>& frame_times_ms : frame_rates)
+    {
+        uint32_t frames = 0;
+        const vector<float> state = Simulate(frame_times_ms, step_count, &frames);
+        CHECK(frames != frames_reference);
+        CHECK(state.size() == reference.size());
+        CHECK(memcmp(state.data(), reference.data(), state.size() * sizeof(float)) == 0);
+    }
+}
+#endif
+
+TEST(fixed_timestep_alpha_and_step_cap)
+{
+    Timer timer(nullptr);
+
+    // Half a step accumulates without stepping
+    timer.StepFixed(timer.GetFixedDeltaTimeMs() * 0.5);
+    CHECK(timer.GetFixedStepCount() == 0);
+    CHECK(timer.GetFixedAlpha() > 0.49f && timer.GetFixedAlpha() < 0.51f);
+
+    // The other half completes it
+    timer.StepFixed(timer.GetFixedDeltaTimeMs() * 0.5);
+    CHECK(timer.GetFixedStepCount() == 1);
+    CHECK(timer.GetFixedAlpha() < 0.01f);
+
+    // A long stall is capped and the excess time is dropped instead of being caught up with
+    timer.StepFixed(timer.GetFixedDeltaTimeMs() * 100.0);
+    CHECK(timer.GetFixedStepCount() == 8);
+    CHECK(timer.GetFixedAlpha() < 1.0f);
+    timer.StepFixed(0.0);
+    CHECK(timer.GetFixedStepCount() == 0);
+}
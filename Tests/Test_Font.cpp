@@ -0,0 +1,86 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// The font belongs to the renderer, so these tests run on the null backend
+#ifdef API_GRAPHICS_NULL
+
+//= INCLUDES ==================
+#include "Test.h"
+#include "Core/Engine.h"
+#include "Core/Context.h"
+#include "Rendering/Renderer.h"
+#include "Rendering/Font/Font.h"
+//=============================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+// Without a camera the renderer returns before the text pass, the strings drawn that frame mustn't pile up
+TEST(font_text_is_cleared_when_a_frame_ends_early)
+{
+    WindowData window_data;
+    window_data.width   = 64;
+    window_data.height  = 64;
+    Engine engine(window_data);
+    Renderer* renderer  = engine.GetContext()->GetSubsystem<Renderer>();
+    Font* font          = renderer->GetFont();
+    CHECK(font != nullptr);
+
+    for (uint32_t frame = 0; frame < 10; frame++)
+    {
+        for (uint32_t i = 0; i < 100; i++)
+        {
+            renderer->DrawString("Entity " + to_string(i), Vector2::Zero);
+        }
+        renderer->Tick(1.0f / 60.0f);
+    }
+
+    font->UpdateVertexBuffer();
+    CHECK(font->GetIndexCount() == 0);
+}
+
+// Every string gets its own layout, a quad per character which isn't a space
+TEST(font_text_layouts_are_per_string)
+{
+    WindowData window_data;
+    window_data.width   = 64;
+    window_data.height  = 64;
+    Engine engine(window_data);
+    Font* font = engine.GetContext()->GetSubsystem<Renderer>()->GetFont();
+    CHECK(font != nullptr);
+
+    font->AddText("ab", Vector2::Zero);
+    font->AddText("a b c", Vector2(0.0f, 20.0f));
+    font->AddText("ab", Vector2(0.0f, 40.0f));
+    font->UpdateVertexBuffer();
+    CHECK(font->GetIndexCount() == (2 + 3 + 2) * 6);
+    font->ClearText();
+
+    font->AddText("abcd", Vector2::Zero);
+    font->UpdateVertexBuffer();
+    CHECK(font->GetIndexCount() == 4 * 6);
+    font->ClearText();
+}
+
+#endif
@@ -0,0 +1,139 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+// Instancing of identical draws, through the G-Buffer pass of the null backend
+#ifdef API_GRAPHICS_NULL
+
+//= INCLUDES ======================================
+#include "Test.h"
+#include "Core/Engine.h"
+#include "Core/Context.h"
+#include "Core/FileSystem.h"
+#include "Profiling/Profiler.h"
+#include "Rendering/Renderer.h"
+#include "Rendering/Renderer_ConstantBuffers.h"
+#include "Rendering/Model.h"
+#include "Rendering/Material.h"
+#include "Resource/ResourceCache.h"
+#include "Utilities/Geometry.h"
+#include "World/World.h"
+#include "World/Entity.h"
+#include "World/Components/Transform.h"
+#include "World/Components/Renderable.h"
+#include "World/Components/Light.h"
+#include <cstring>
+#include <cstdio>
+//=================================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+TEST(instancing_gbuffer_batches_identical_draws_and_counts_the_saved_draw_calls)
+{
+    WindowData window_data;
+    window_data.width   = 64;
+    window_data.height  = 64;
+    Engine engine(window_data);
+
+    Context* context                = engine.GetContext();
+    Renderer* renderer              = context->GetSubsystem<Renderer>();
+    Profiler* profiler              = context->GetSubsystem<Profiler>();
+    World* world                    = context->GetSubsystem<World>();
+    ResourceCache* resource_cache   = context->GetSubsystem<ResourceCache>();
+    CHECK(renderer->IsInitialized());
+
+    // Only the G-Buffer pass should draw instances
+    world->EntityGetByName("DirectionalLight")->GetComponent<Light>()->SetShadowsEnabled(false);
+
+    // One model holding a cube twice, i.e. two ranges of the same buffers
+    vector<RHI_Vertex_PosTexNorTan> vertices;
+    vector<uint32_t> indices;
+    Utility::Geometry::CreateCube(&vertices, &indices);
+    auto model = make_shared<Model>(context);
+    uint32_t index_offset[2]    = { 0, 0 };
+    uint32_t vertex_offset[2]   = { 0, 0 };
+    model->AppendGeometry(indices, vertices, &index_offset[0], &vertex_offset[0]);
+    model->AppendGeometry(indices, vertices, &index_offset[1], &vertex_offset[1]);
+    model->UpdateGeometry();
+    const BoundingBox aabb(vertices.data(), static_cast<uint32_t>(vertices.size()));
+
+    shared_ptr<Material> materials[2];
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        materials[i] = make_shared<Material>(context);
+        materials[i]->SetResourceFilePath(resource_cache->GetProjectDirectory() + "instancing_" + to_string(i) + EXTENSION_MATERIAL);
+    }
+
+    // Grouped by range and material: 64 + 64 + 5 (split at the batch size), 10, 2, and a single draw which isn't instanced
+    struct Group { uint32_t range; uint32_t material; uint32_t count; };
+    const Group groups[] = { { 0, 0, 2 * instance_batch_size + 5 }, { 0, 1, 10 }, { 1, 0, 2 }, { 1, 1, 1 } };
+    const uint32_t draw_calls_instanced_expected    = 3 + 1 + 1;
+    const uint32_t instances_expected               = 2 * instance_batch_size + 5 + 10 + 2;
+    const uint32_t meshes_expected                  = instances_expected + 1;
+
+    // Interleaved, in a grid in front of the default camera
+    uint32_t entity_count = 0;
+    for (uint32_t i = 0; i < 2 * instance_batch_size + 5; i++)
+    {
+        for (const Group& group : groups)
+        {
+            if (i >= group.count)
+                continue;
+
+            auto& entity = world->EntityCreate();
+            entity->GetTransform()->SetPosition(Vector3(static_cast<float>(entity_count % 12) - 6.0f, static_cast<float>((entity_count / 12) % 12) - 5.0f, 20.0f + static_cast<float>(entity_count / 144) * 2.0f));
+            Renderable* renderable = entity->AddComponent<Renderable>();
+            renderable->GeometrySet("cube", index_offset[group.range], static_cast<uint32_t>(indices.size()), vertex_offset[group.range], static_cast<uint32_t>(vertices.size()), aabb, model.get());
+            renderable->SetMaterial(materials[group.material]);
+            entity_count++;
+        }
+    }
+
+    // Report every frame
+    renderer->SetOption(Render_Debug_PerformanceMetrics, true);
+    profiler->SetUpdateInterval(0.0f);
+
+    // Resolve the world and let the frame settle
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        engine.Tick();
+    }
+
+    // The counters of the last frame
+    CHECK(profiler->m_renderer_meshes_rendered == meshes_expected);
+    CHECK(profiler->m_rhi_draw_calls_instanced == draw_calls_instanced_expected);
+    CHECK(profiler->m_rhi_instances == instances_expected);
+
+    // The metrics (of the previous frame, which drew the same) report the draw calls instancing saved
+    const char* label = "RHI Draw calls saved:";
+    const char* line  = strstr(profiler->GetMetrics().c_str(), label);
+    CHECK(line != nullptr);
+    int saved = -1;
+    CHECK(sscanf(line + strlen(label), "%d", &saved) == 1);
+    CHECK(saved == static_cast<int>(instances_expected - draw_calls_instanced_expected));
+}
+
+#endif
@@ -0,0 +1,136 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "Test.h"
+#include "Rendering/LightGrid.h"
+#include <algorithm>
+#include <vector>
+//================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+namespace
+{
+    const float near_plane = 0.3f;
+    const float far_plane  = 1000.0f;
+
+    Matrix GetProjection()
+    {
+        return Matrix::CreatePerspectiveFieldOfViewLH(1.5708f, 16.0f / 9.0f, near_plane, far_plane);
+    }
+
+    BufferLightGridLight CreateLight(const Vector3& position, const float range)
+    {
+        BufferLightGridLight light;
+        light.position_range    = Vector4(position.x, position.y, position.z, range);
+        light.color_intensity   = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+        light.direction_angle   = Vector4::Zero;
+        return light;
+    }
+
+    // Every light the clusters reference is one the grid kept, and it's in every cluster it was binned to
+    bool ClustersReferenceOnly(const LightGrid& grid, const vector<bool>& clustered)
+    {
+        const uint8_t* indices = reinterpret_cast<const uint8_t*>(grid.GetIndices().indices);
+        for (const uint32_t cluster : grid.GetClusters().clusters)
+        {
+            const uint32_t offset   = cluster & 0xFFFF;
+            const uint32_t count    = cluster >> 16;
+            for (uint32_t i = offset; i < offset + count; i++)
+            {
+                if (i >= light_grid_indices || indices[i] >= clustered.size() || !clustered[indices[i]])
+                    return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+TEST(light_grid_overflows_past_the_light_limit)
+{
+    // Small lights in front of the camera, more than the buffers can hold
+    const uint32_t light_count = light_grid_lights + 44;
+    vector<BufferLightGridLight> lights;
+    for (uint32_t i = 0; i < light_count; i++)
+    {
+        lights.emplace_back(CreateLight(Vector3(static_cast<float>(i % 20) - 10.0f, static_cast<float>((i / 20) % 10) - 5.0f, 20.0f + static_cast<float>(i / 200) * 10.0f), 1.0f));
+    }
+
+    LightGrid grid(nullptr);
+    grid.Build(lights, Matrix::Identity, GetProjection(), near_plane, far_plane);
+
+    // The first lights fill the buffers, the rest are handed back
+    CHECK(grid.GetClusteredCount() == light_grid_lights);
+    CHECK(grid.GetOverflow().size() == light_count - light_grid_lights);
+    for (uint32_t i = 0; i < static_cast<uint32_t>(grid.GetOverflow().size()); i++)
+    {
+        CHECK(grid.GetOverflow()[i] == light_grid_lights + i);
+    }
+
+    CHECK(ClustersReferenceOnly(grid, vector<bool>(light_grid_lights, true)));
+}
+
+TEST(light_grid_overflows_past_the_index_limit)
+{
+    // Lights which enclose the whole view frustum touch every cluster, so only a few fit in the index buffer
+    const uint32_t light_count  = 10;
+    const uint32_t fit_count    = light_grid_indices / light_grid_clusters;
+    vector<BufferLightGridLight> lights(light_count, CreateLight(Vector3(0.0f, 0.0f, 50.0f), 2000.0f));
+
+    LightGrid grid(nullptr);
+    grid.Build(lights, Matrix::Identity, GetProjection(), near_plane, far_plane);
+
+    CHECK(grid.GetClusteredCount() == fit_count);
+    CHECK(grid.GetIndexCount() == fit_count * light_grid_clusters);
+    CHECK(grid.GetOverflow().size() == light_count - fit_count);
+
+    // No light is left in some of its clusters but not others
+    for (const uint32_t cluster : grid.GetClusters().clusters)
+    {
+        CHECK((cluster >> 16) == fit_count);
+    }
+
+    vector<bool> clustered(light_count, false);
+    fill(clustered.begin(), clustered.begin() + fit_count, true);
+    CHECK(ClustersReferenceOnly(grid, clustered));
+}
+
+TEST(light_grid_ignores_lights_out_of_view)
+{
+    vector<BufferLightGridLight> lights =
+    {
+        CreateLight(Vector3(0.0f, 0.0f, -50.0f), 5.0f),     // behind the camera
+        CreateLight(Vector3(0.0f, 0.0f, 50.0f), 5.0f)       // in front of it
+    };
+
+    LightGrid grid(nullptr);
+    grid.Build(lights, Matrix::Identity, GetProjection(), near_plane, far_plane);
+
+    CHECK(grid.GetClusteredCount() == 1);
+    CHECK(grid.GetOverflow().empty());
+    CHECK(grid.GetIndexCount() != 0);
+}
@@ -0,0 +1,126 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+//= INCLUDES ===================================
+#include "Test.h"
+#ifdef API_GRAPHICS_NULL
+#include "Core/Engine.h"
+#include "Core/Context.h"
+#include "Core/Timer.h"
+#include "Physics/Physics.h"
+#include "Physics/PhysicsQuery.h"
+#include "World/World.h"
+#include "World/Entity.h"
+#include "World/Components/Transform.h"
+#include "World/Components/Collider.h"
+#include "World/Components/RigidBody.h"
+#include <BulletSoftBody/btSoftBodyHelpers.h>
+#endif
+//==============================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+// Bodies are added through the engine's components, which the null backend can host
+#ifdef API_GRAPHICS_NULL
+namespace
+{
+    void TickFrames(Engine& engine, const uint32_t frame_count)
+    {
+        engine.GetContext()->GetSubsystem<Timer>()->SetFrameTimeOverrideMs(1000.0 / 60.0);
+        for (uint32_t i = 0; i < frame_count; i++)
+        {
+            engine.Tick();
+        }
+    }
+
+    // A ray straight down onto the body, the broadphase has to know about it for this to hit
+    Entity* RayDown(const Physics* physics, const Vector3& position)
+    {
+        PhysicsQueryBatch batch;
+        batch.AddRay(position + Vector3(0.0f, 10.0f, 0.0f), position - Vector3(0.0f, 10.0f, 0.0f));
+        CHECK(physics->Query(batch));
+        return batch.GetHitEntity(0);
+    }
+}
+
+TEST(physics_soft_bodies_switch_worlds_and_keep_rigid_bodies)
+{
+    WindowData window_data;
+    window_data.width   = 64;
+    window_data.height  = 64;
+    Engine engine(window_data);
+
+    Context* context    = engine.GetContext();
+    Physics* physics    = context->GetSubsystem<Physics>();
+    World* world        = context->GetSubsystem<World>();
+
+    // Without soft bodies the world is the multi-threaded one
+    CHECK(!physics->SupportsSoftBodies());
+
+    const auto add_body = [world](const Vector3& size, const float mass, const Vector3& position)
+    {
+        auto& entity = world->EntityCreate();
+        entity->GetTransform()->SetPosition(position);
+        entity->AddComponent<Collider>()->SetBoundingBox(size);
+        entity->AddComponent<RigidBody>()->SetMass(mass);
+        return entity.get();
+    };
+    Entity* ground  = add_body(Vector3(100.0f, 1.0f, 100.0f), 0.0f, Vector3(0.0f, -0.5f, 0.0f));
+    Entity* box     = add_body(Vector3::One, 1.0f, Vector3(0.0f, 5.0f, 0.0f));
+
+    // Mid-fall
+    TickFrames(engine, 30);
+    const float height_falling = box->GetTransform()->GetPosition().y;
+    CHECK(height_falling < 5.0f && height_falling > 1.0f);
+
+    // The first soft body moves everything into a soft body world
+    const btVector3 vertices[] =
+    {
+        btVector3(49, 9, -1), btVector3(51, 9, -1), btVector3(49, 11, -1), btVector3(51, 11, -1),
+        btVector3(49, 9, +1), btVector3(51, 9, +1), btVector3(49, 11, +1), btVector3(51, 11, +1)
+    };
+    btSoftBody* soft_body = btSoftBodyHelpers::CreateFromConvexHull(physics->GetSoftWorldInfo(), vertices, 8);
+    physics->AddBody(soft_body);
+    CHECK(physics->SupportsSoftBodies());
+    CHECK(RayDown(physics, Vector3(0.0f, height_falling, 0.0f)) == box);
+
+    // The box keeps falling where it was and lands on the ground
+    TickFrames(engine, 90);
+    CHECK(box->GetTransform()->GetPosition().y < height_falling);
+    CHECK(Helper::Abs(box->GetTransform()->GetPosition().y - 0.5f) < 0.05f);
+
+    // Removing the last soft body goes back to the multi-threaded world, with the bodies still resting on each other
+    physics->RemoveBody(soft_body);
+    CHECK(soft_body == nullptr);
+    CHECK(!physics->SupportsSoftBodies());
+    CHECK(RayDown(physics, Vector3(0.0f, 0.5f, 0.0f)) == box);
+    CHECK(RayDown(physics, Vector3(20.0f, -0.5f, 20.0f)) == ground);
+
+    TickFrames(engine, 30);
+    CHECK(Helper::Abs(box->GetTransform()->GetPosition().y - 0.5f) < 0.05f);
+}
+#endif
@@ -0,0 +1,143 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ===================================
+#include "Test.h"
+#include "Physics/PhysicsQuery.h"
+#ifdef API_GRAPHICS_NULL
+#include "Core/Engine.h"
+#include "Core/Context.h"
+#include "Physics/Physics.h"
+#include "World/World.h"
+#include "World/Entity.h"
+#include "World/Components/Transform.h"
+#include "World/Components/Collider.h"
+#include "World/Components/RigidBody.h"
+#endif
+//==============================================
+
+//= NAMESPACES ===============
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+TEST(physics_query_invalid_index_returns_miss)
+{
+    PhysicsQueryBatch batch;
+    const uint32_t index = batch.AddRay(Vector3::Zero, Vector3::Forward);
+
+    // Not queried yet
+    CHECK(!batch.IsHit(index));
+    CHECK(batch.GetHitFraction(index) == 1.0f);
+    CHECK(batch.GetHitPosition(index) == Vector3::Zero);
+    CHECK(batch.GetHitNormal(index) == Vector3::Zero);
+    CHECK(batch.GetHitEntity(index) == nullptr);
+    CHECK(batch.GetOverlapCount(index) == 0);
+    CHECK(batch.GetOverlap(index, 0) == nullptr);
+
+    // Out of range, as a script could ask for
+    CHECK(!batch.IsHit(1000));
+    CHECK(batch.GetHitEntity(0xFFFFFFFF) == nullptr);
+    CHECK(batch.GetOverlap(0xFFFFFFFF, 0xFFFFFFFF) == nullptr);
+}
+
+// The bodies are added through the engine's components, which the null backend can host
+#ifdef API_GRAPHICS_NULL
+TEST(physics_query_hits_misses_and_overlaps_real_bodies)
+{
+    WindowData window_data;
+    window_data.width   = 64;
+    window_data.height  = 64;
+    Engine engine(window_data);
+
+    Context* context    = engine.GetContext();
+    Physics* physics    = context->GetSubsystem<Physics>();
+    World* world        = context->GetSubsystem<World>();
+
+    // Static, so that nothing moves between the queries
+    const auto add_box = [world](const Vector3& size, const Vector3& position)
+    {
+        auto& entity = world->EntityCreate();
+        entity->GetTransform()->SetPosition(position);
+        entity->AddComponent<Collider>()->SetBoundingBox(size);
+        entity->AddComponent<RigidBody>()->SetMass(0.0f);
+        return entity.get();
+    };
+    Entity* ground  = add_box(Vector3(100.0f, 1.0f, 100.0f), Vector3(0.0f, -0.5f, 0.0f));
+    Entity* box_a   = add_box(Vector3::One, Vector3(5.0f, 0.5f, 0.0f));
+    Entity* box_b   = add_box(Vector3::One, Vector3(6.5f, 0.5f, 0.0f));
+
+    PhysicsQueryBatch batch;
+    const uint32_t hit      = batch.AddRay(Vector3(5.0f, 10.0f, 0.0f), Vector3(5.0f, -10.0f, 0.0f));
+    const uint32_t miss     = batch.AddRay(Vector3(200.0f, 10.0f, 200.0f), Vector3(200.0f, -10.0f, 200.0f));
+    const uint32_t sweep    = batch.AddSweepSphere(Vector3(-20.0f, 0.5f, 0.0f), Vector3(20.0f, 0.5f, 0.0f), 0.25f);
+    const uint32_t overlap  = batch.AddOverlapSphere(Vector3(5.75f, 0.5f, 0.0f), 1.5f);
+    CHECK(physics->Query(batch));
+
+    // The ray stops on top of the first box
+    CHECK(batch.IsHit(hit));
+    CHECK(batch.GetHitEntity(hit) == box_a);
+    CHECK(Helper::Abs(batch.GetHitFraction(hit) - 0.45f) < 0.01f);
+    CHECK(Helper::Abs(batch.GetHitPosition(hit).y - 1.0f) < 0.01f);
+    CHECK(batch.GetHitNormal(hit).y > 0.99f);
+
+    // Nothing out there, past the ground's edge
+    CHECK(!batch.IsHit(miss));
+    CHECK(batch.GetHitEntity(miss) == nullptr);
+    CHECK(batch.GetHitFraction(miss) == 1.0f);
+
+    // The sphere slides along the ground (starting inside it doesn't count) and runs into the first box's side
+    CHECK(batch.IsHit(sweep));
+    CHECK(batch.GetHitEntity(sweep) == box_a);
+    CHECK(Helper::Abs(batch.GetHitPosition(sweep).x - 4.5f) < 0.01f);
+
+    // Both boxes and the ground, each reported once
+    CHECK(batch.IsHit(overlap));
+    CHECK(batch.GetOverlapCount(overlap) == 3);
+    uint32_t found = 0;
+    for (uint32_t i = 0; i < batch.GetOverlapCount(overlap); i++)
+    {
+        const Entity* entity = batch.GetOverlap(overlap, i);
+        found |= (entity == ground ? 1 : 0) | (entity == box_a ? 2 : 0) | (entity == box_b ? 4 : 0);
+    }
+    CHECK(found == 7);
+
+    // After clearing, the new queries don't see the old results, not even before they are answered
+    batch.Clear();
+    const uint32_t miss_reused = batch.AddRay(Vector3(200.0f, 10.0f, 200.0f), Vector3(200.0f, -10.0f, 200.0f));
+    CHECK(miss_reused == hit);
+    CHECK(!batch.IsHit(miss_reused));
+    CHECK(batch.GetHitEntity(miss_reused) == nullptr);
+    CHECK(batch.GetHitFractions().empty());
+
+    const uint32_t overlap_reused = batch.AddOverlapSphere(Vector3(20.0f, 0.5f, 20.0f), 1.0f);
+    CHECK(overlap_reused == miss);
+    CHECK(batch.GetOverlapCount(overlap_reused) == 0);
+
+    CHECK(physics->Query(batch));
+    CHECK(!batch.IsHit(miss_reused));
+    CHECK(batch.GetHitEntity(miss_reused) == nullptr);
+    CHECK(batch.GetOverlapCount(overlap_reused) == 1);
+    CHECK(batch.GetOverlap(overlap_reused, 0) == ground);
+    CHECK(batch.GetHitFractions().size() == 2);
+}
+#endif
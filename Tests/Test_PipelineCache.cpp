@@ -0,0 +1,117 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+// Pipeline states without shaders need no GPU objects, so the null backend can create pipelines for them
+#ifdef API_GRAPHICS_NULL
+
+//= INCLUDES =====================
+#include "Test.h"
+#include "RHI/RHI_Device.h"
+#include "RHI/RHI_Pipeline.h"
+#include "RHI/RHI_PipelineCache.h"
+#include "RHI/RHI_PipelineState.h"
+#include "RHI/RHI_RasterizerState.h"
+#include <memory>
+//================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+//============================
+
+TEST(pipeline_cache_hits_only_on_identical_keys)
+{
+    RHI_Device device(nullptr);
+    RHI_PipelineCache cache(&device);
+
+    // Enough states to make the table grow a few times
+    const uint32_t state_count = 1000;
+    vector<unique_ptr<RHI_PipelineState>> states(state_count);
+    vector<RHI_Pipeline*> pipelines(state_count);
+    for (uint32_t i = 0; i < state_count; i++)
+    {
+        states[i] = make_unique<RHI_PipelineState>();
+        states[i]->vertex_buffer_stride = i;
+        pipelines[i] = cache.GetPipeline(nullptr, *states[i], nullptr);
+        CHECK(pipelines[i] != nullptr);
+    }
+
+    // Every state got its own pipeline and finds it again, no matter how the hashes collide in the table
+    for (uint32_t i = 0; i < state_count; i++)
+    {
+        CHECK(cache.GetPipeline(nullptr, *states[i], nullptr) == pipelines[i]);
+        CHECK(pipelines[i]->GetPipelineState()->GetKey() == states[i]->GetKey());
+    }
+
+    // A different state object with an identical key shares the pipeline
+    RHI_PipelineState state;
+    state.vertex_buffer_stride = 7;
+    CHECK(cache.GetPipeline(nullptr, state, nullptr) == pipelines[7]);
+
+    // Changing a field gives a different pipeline
+    state.scissor = Math::Rectangle(0.0f, 0.0f, 1.0f, 1.0f);
+    CHECK(cache.GetPipeline(nullptr, state, nullptr) != pipelines[7]);
+}
+
+TEST(pipeline_cache_evict_keeps_other_pipelines)
+{
+    auto device = make_shared<RHI_Device>(nullptr);
+    RHI_PipelineCache cache(device.get());
+
+    // Half of the states point to a rasterizer state which is about to be destroyed
+    auto rasterizer_evicted = make_shared<RHI_RasterizerState>(device, RHI_Cull_Back, RHI_Fill_Solid, true, false, false, false);
+    auto rasterizer_kept    = make_shared<RHI_RasterizerState>(device, RHI_Cull_None, RHI_Fill_Solid, true, false, false, false);
+    cache.RegisterObject(rasterizer_evicted.get(), "rasterizer_evicted");
+    cache.RegisterObject(rasterizer_kept.get(), "rasterizer_kept");
+
+    const uint32_t state_count = 600;
+    vector<unique_ptr<RHI_PipelineState>> states(state_count);
+    vector<RHI_Pipeline*> pipelines(state_count);
+    for (uint32_t i = 0; i < state_count; i++)
+    {
+        states[i] = make_unique<RHI_PipelineState>();
+        states[i]->vertex_buffer_stride = i / 2;
+        states[i]->rasterizer_state     = i % 2 == 0 ? rasterizer_evicted.get() : rasterizer_kept.get();
+        pipelines[i] = cache.GetPipeline(nullptr, *states[i], nullptr);
+        CHECK(pipelines[i] != nullptr);
+    }
+
+    cache.Evict(rasterizer_evicted.get());
+
+    // The rest are still found, the table's probe sequences survived the removal
+    for (uint32_t i = 1; i < state_count; i += 2)
+    {
+        CHECK(cache.GetPipeline(nullptr, *states[i], nullptr) == pipelines[i]);
+    }
+
+    // The evicted ones are gone, asking for them creates new pipelines which point to the new object
+    auto rasterizer_new = make_shared<RHI_RasterizerState>(device, RHI_Cull_Back, RHI_Fill_Solid, true, false, false, false);
+    for (uint32_t i = 0; i < state_count; i += 2)
+    {
+        states[i]->rasterizer_state = rasterizer_new.get();
+        RHI_Pipeline* pipeline = cache.GetPipeline(nullptr, *states[i], nullptr);
+        CHECK(pipeline != nullptr);
+        CHECK(pipeline->GetPipelineState()->rasterizer_state == rasterizer_new.get());
+    }
+}
+
+#endif
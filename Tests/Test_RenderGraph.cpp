@@ -0,0 +1,125 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// Pool textures are created through the renderer's device, so these tests run on the null backend
+#ifdef API_GRAPHICS_NULL
+
+//= INCLUDES ===================
+#include "Test.h"
+#include "Core/Engine.h"
+#include "Core/Context.h"
+#include "Rendering/RenderGraph.h"
+#include "RHI/RHI_Texture.h"
+#include <algorithm>
+//==============================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+//============================
+
+namespace
+{
+    WindowData GetWindowData()
+    {
+        WindowData window_data;
+        window_data.width   = 64;
+        window_data.height  = 64;
+        return window_data;
+    }
+}
+
+TEST(render_graph_aliases_and_releases_pool_textures)
+{
+    Engine engine(GetWindowData());
+    RenderGraph graph(engine.GetContext());
+
+    vector<RHI_Texture*> released;
+    graph.OnRelease([&released](RHI_Texture* texture) { released.emplace_back(texture); });
+
+    const RenderGraphTextureDesc desc = { 64, 64, RHI_Format_R8_Unorm };
+    graph.DeclareTexture(0, desc);
+    graph.DeclareTexture(1, desc);
+    graph.DeclareTexture(2, desc);
+
+    // 0 and 1 don't overlap and share a texture, 2 is never used and gets nothing
+    graph.AddPass("write_0", {}, { 0 }, []() {});
+    graph.AddPass("read_0", { 0 }, {}, []() {});
+    graph.AddPass("write_1", {}, { 1 }, []() {});
+    graph.AddPass("read_1", { 1 }, {}, []() {});
+    graph.Compile();
+    CHECK(graph.GetTexture(0) != nullptr);
+    CHECK(graph.GetTexture(0) == graph.GetTexture(1));
+    CHECK(graph.GetTexture(2) == nullptr);
+    CHECK(graph.GetMemoryPool() == desc.GetSize());
+    CHECK(graph.GetMemoryDeclared() == desc.GetSize() * 3);
+    RHI_Texture* texture = graph.GetTexture(0).get();
+    graph.Execute(nullptr);
+
+    // Once no pass uses it, the pool keeps the texture for a while and then reports it before releasing it
+    for (uint32_t i = 0; i < RenderGraph::pool_release_frames; i++)
+    {
+        CHECK(released.empty());
+        graph.Compile();
+        graph.Execute(nullptr);
+    }
+    graph.Compile();
+    CHECK(released.size() == 1 && released[0] == texture);
+    CHECK(graph.GetMemoryPool() == 0);
+
+    // Clearing reports the whole pool
+    released.clear();
+    graph.AddPass("write_2", {}, { 2 }, []() {});
+    graph.Compile();
+    texture = graph.GetTexture(2).get();
+    graph.Execute(nullptr);
+    graph.Clear();
+    CHECK(released.size() == 1 && released[0] == texture);
+}
+
+TEST(render_graph_transitions_declared_textures)
+{
+    Engine engine(GetWindowData());
+    RenderGraph graph(engine.GetContext());
+
+    graph.DeclareTexture(0, { 64, 64, RHI_Format_D32_Float });
+    graph.DeclareTexture(1, { 64, 64, RHI_Format_R8_Unorm });
+
+    // Each pass sees its textures in the layout it declared them for
+    RHI_Image_Layout layout_depth_write = RHI_Image_Undefined;
+    RHI_Image_Layout layout_depth_read  = RHI_Image_Undefined;
+    RHI_Image_Layout layout_color_read  = RHI_Image_Undefined;
+    graph.AddPass("depth_write", {}, { 0 }, [&]() { layout_depth_write = graph.GetTexture(0)->GetLayout(); });
+    graph.AddPass("depth_read", { 0 }, { 1 }, [&]() { layout_depth_read = graph.GetTexture(0)->GetLayout(); });
+    graph.AddPass("color_read", { 1 }, {}, [&]() { layout_color_read = graph.GetTexture(1)->GetLayout(); });
+    graph.Compile();
+
+    // Start both from a layout no pass asks for
+    graph.GetTexture(0)->SetLayout(RHI_Image_General);
+    graph.GetTexture(1)->SetLayout(RHI_Image_General);
+    graph.Execute(nullptr);
+
+    CHECK(layout_depth_write    == RHI_Image_Depth_Stencil_Attachment_Optimal);
+    CHECK(layout_depth_read     == RHI_Image_Depth_Stencil_Read_Only_Optimal);
+    CHECK(layout_color_read     == RHI_Image_Shader_Read_Only_Optimal);
+}
+
+#endif
@@ -0,0 +1,92 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES =========================
+#include "Test.h"
+#include "Rendering/RingAllocator.h"
+//====================================
+
+//= NAMESPACES ===============
+using namespace Spartan;
+//============================
+
+TEST(ring_allocator_keeps_frames_apart)
+{
+    const uint32_t elements_per_frame   = 100;
+    const uint32_t frame_count          = 2;
+
+    RingAllocator ring;
+    ring.Reset(elements_per_frame, frame_count);
+    CHECK(ring.GetElementCount() == elements_per_frame * frame_count);
+
+    for (uint32_t frame = 0; frame < 6; frame++)
+    {
+        ring.BeginFrame();
+        CHECK(ring.GetUsed() == 0);
+        CHECK(!ring.HasOverflown());
+
+        // Every allocation lands inside the frame's own region, contiguous with the previous one
+        const uint32_t region_start = ring.GetFrameIndex() * elements_per_frame;
+        uint32_t expected = region_start;
+        for (const uint32_t count : { 1u, 10u, 39u, 50u })
+        {
+            uint32_t index = 0;
+            CHECK(ring.Allocate(count, index));
+            CHECK(index == expected);
+            expected += count;
+        }
+        CHECK(expected == region_start + elements_per_frame);
+
+        // A full region refuses more, without touching the cursor
+        uint32_t index = 0;
+        CHECK(!ring.Allocate(1, index));
+        CHECK(ring.HasOverflown());
+        CHECK(ring.GetUsed() == elements_per_frame);
+        CHECK(ring.GetPeak() == elements_per_frame);
+    }
+}
+
+TEST(ring_allocator_reset_starts_over)
+{
+    RingAllocator ring;
+    ring.Reset(8, 2);
+    ring.BeginFrame();
+
+    uint32_t index = 0;
+    CHECK(ring.Allocate(8, index));
+    CHECK(!ring.Allocate(1, index));
+
+    // What growing does, a bigger region and a fresh cursor (on a new buffer)
+    ring.Reset(16, 2);
+    CHECK(!ring.HasOverflown());
+    CHECK(ring.GetUsed() == 0);
+    CHECK(ring.Allocate(9, index));
+    CHECK(index == 0);
+    CHECK(ring.Allocate(7, index));
+    CHECK(index == 9);
+    CHECK(!ring.Allocate(1, index));
+
+    // Zero sized rings never hand anything out
+    ring.Reset(0, 0);
+    ring.BeginFrame();
+    CHECK(!ring.Allocate(1, index));
+}
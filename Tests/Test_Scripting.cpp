@@ -0,0 +1,208 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// Scripts are compiled by the engine's scripting subsystem, so these tests run on the null backend
+#ifdef API_GRAPHICS_NULL
+
+//= INCLUDES ==================
+#include "Test.h"
+#include "Core/Engine.h"
+#include "Core/Context.h"
+#include "Scripting/Scripting.h"
+#include "World/World.h"
+#include "World/Entity.h"
+#include "World/Components/Transform.h"
+#include <angelscript.h>
+#include <fstream>
+#include <cstring>
+//=============================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+TEST(scripting_modules_are_shared_unless_they_have_global_variables)
+{
+    WindowData window_data;
+    window_data.width   = 64;
+    window_data.height  = 64;
+    Engine engine(window_data);
+    Scripting* scripting = engine.GetContext()->GetSubsystem<Scripting>();
+
+    const string directory = Spartan::Tests::GetTempDirectory("scripting_modules") + "/";
+    ofstream(directory + "Shared.as") << "class Shared { float time = 0.0f; void Update(float delta_time) { time += delta_time; } }";
+    ofstream(directory + "Global.as") << "int counter = 0; class Global { void Update(float delta_time) { counter++; } }";
+
+    // Instances of a script without global variables share its module, and so its update batch
+    const shared_ptr<Module> shared_a = scripting->GetModule(directory + "Shared.as");
+    const shared_ptr<Module> shared_b = scripting->GetModule(directory + "Shared.as");
+    CHECK(shared_a != nullptr);
+    CHECK(shared_a == shared_b);
+
+    // Every instance of a script with global variables gets its own module, and so its own globals
+    const shared_ptr<Module> global_a = scripting->GetModule(directory + "Global.as");
+    const shared_ptr<Module> global_b = scripting->GetModule(directory + "Global.as");
+    CHECK(global_a != nullptr && global_b != nullptr);
+    CHECK(global_a != global_b);
+}
+
+// Two identical scripts, one of them thread safe. Several objects write to the same entity, so the last
+// write only survives if the commands are applied in the same order as when the scripts update serially.
+TEST(scripting_parallel_updates_match_serial_updates)
+{
+    WindowData window_data;
+    window_data.width   = 64;
+    window_data.height  = 64;
+    Engine engine(window_data);
+    Scripting* scripting            = engine.GetContext()->GetSubsystem<Scripting>();
+    World* world                    = engine.GetContext()->GetSubsystem<World>();
+    asIScriptEngine* script_engine  = scripting->GetAsIScriptEngine();
+
+    static const char* source =
+        "class Serial"
+        "{"
+        "    uint target = 0; uint seed = 0; float state = 0.0f;"
+        "    void Update(float delta_time)"
+        "    {"
+        "        for (int i = 0; i < 16; i++) { state = state * 0.99f + delta_time * (float(seed % 7) + float(i)); }"
+        "        QueueSetPosition(target, Vector3(state, float(seed), 0.0f));"
+        "    }"
+        "}"
+        "class Parallel : ThreadSafe"
+        "{"
+        "    uint target = 0; uint seed = 0; float state = 0.0f;"
+        "    void Update(float delta_time)"
+        "    {"
+        "        for (int i = 0; i < 16; i++) { state = state * 0.99f + delta_time * (float(seed % 7) + float(i)); }"
+        "        QueueSetPosition(target, Vector3(state, float(seed), 0.0f));"
+        "    }"
+        "}";
+
+    asIScriptModule* module = script_engine->GetModule("Determinism", asGM_ALWAYS_CREATE);
+    CHECK(module->AddScriptSection("Determinism", source) >= 0 && module->Build() >= 0);
+
+    const uint32_t entity_count = 1000;
+    const uint32_t object_count = 10000;
+    vector<shared_ptr<Entity>> entities(entity_count);
+    for (shared_ptr<Entity>& entity : entities)
+    {
+        entity = world->EntityCreate();
+    }
+
+    // Updates both sets of objects a few times and returns where the entities ended up
+    auto run = [&](const char* class_name, vector<asIScriptObject*>& objects)
+    {
+        asITypeInfo* type           = module->GetTypeInfoByDecl(class_name);
+        asIScriptFunction* update   = type->GetMethodByDecl("void Update(float delta_time)");
+        objects.resize(object_count);
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            objects[i] = static_cast<asIScriptObject*>(script_engine->CreateScriptObject(type));
+            *static_cast<uint32_t*>(objects[i]->GetAddressOfProperty(0)) = entities[i % entity_count]->GetId();
+            *static_cast<uint32_t*>(objects[i]->GetAddressOfProperty(1)) = i;
+        }
+
+        for (const shared_ptr<Entity>& entity : entities)
+        {
+            entity->GetTransform()->SetPosition(Vector3::Zero);
+        }
+
+        for (uint32_t iteration = 0; iteration < 4; iteration++)
+        {
+            for (asIScriptObject* obj : objects)
+            {
+                scripting->QueueUpdate(update, obj, 1.0f / 60.0f);
+            }
+            scripting->ExecuteUpdates();
+        }
+
+        vector<Vector3> positions;
+        for (const shared_ptr<Entity>& entity : entities)
+        {
+            positions.emplace_back(entity->GetTransform()->GetPosition());
+        }
+        return positions;
+    };
+
+    vector<asIScriptObject*> objects_serial;
+    vector<asIScriptObject*> objects_parallel;
+    const vector<Vector3> positions_serial      = run("Serial", objects_serial);
+    const vector<Vector3> positions_parallel    = run("Parallel", objects_parallel);
+
+    CHECK(memcmp(positions_serial.data(), positions_parallel.data(), sizeof(Vector3) * entity_count) == 0);
+    for (uint32_t i = 0; i < object_count; i++)
+    {
+        CHECK(memcmp(objects_serial[i]->GetAddressOfProperty(2), objects_parallel[i]->GetAddressOfProperty(2), sizeof(float)) == 0);
+        objects_serial[i]->Release();
+        objects_parallel[i]->Release();
+    }
+    script_engine->DiscardModule("Determinism");
+}
+
+// Thread safe scripts can't write to their entity directly, whether their batch is big enough to run in parallel or not
+TEST(scripting_thread_safe_scripts_defer_or_reject_writes)
+{
+    WindowData window_data;
+    window_data.width   = 64;
+    window_data.height  = 64;
+    Engine engine(window_data);
+    Scripting* scripting            = engine.GetContext()->GetSubsystem<Scripting>();
+    World* world                    = engine.GetContext()->GetSubsystem<World>();
+    asIScriptEngine* script_engine  = scripting->GetAsIScriptEngine();
+
+    // Translate() throws, so the update stops there, after SetPosition() has been recorded
+    static const char* source =
+        "class Mover : ThreadSafe"
+        "{"
+        "    Entity@ entity;"
+        "    void Update(float delta_time)"
+        "    {"
+        "        entity.GetTransform().SetPosition(Vector3(1.0f, 2.0f, 3.0f));"
+        "        if (entity.GetTransform().GetPosition().x != 0.0f) entity.SetActive(false);"
+        "        entity.GetTransform().Translate(Vector3(10.0f, 0.0f, 0.0f));"
+        "        entity.SetActive(false);"
+        "    }"
+        "}";
+
+    asIScriptModule* module = script_engine->GetModule("Enforcement", asGM_ALWAYS_CREATE);
+    CHECK(module->AddScriptSection("Enforcement", source) >= 0 && module->Build() >= 0);
+
+    asITypeInfo* type           = module->GetTypeInfoByDecl("Mover");
+    asIScriptFunction* update   = type->GetMethodByDecl("void Update(float delta_time)");
+    const shared_ptr<Entity> entity = world->EntityCreate();
+    entity->GetTransform()->SetPosition(Vector3::Zero);
+
+    asIScriptObject* obj = static_cast<asIScriptObject*>(script_engine->CreateScriptObject(type));
+    *static_cast<Entity**>(obj->GetAddressOfProperty(0)) = entity.get();
+
+    // The position is only written once the updates have executed, and the rejected translation never is
+    scripting->QueueUpdate(update, obj, 1.0f / 60.0f);
+    scripting->ExecuteUpdates();
+    CHECK(entity->GetTransform()->GetPosition() == Vector3(1.0f, 2.0f, 3.0f));
+    CHECK(entity->IsActive());
+
+    obj->Release();
+    script_engine->DiscardModule("Enforcement");
+}
+
+#endif
@@ -0,0 +1,133 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+// The cache's files are written by the null backend's device like any other's, so this runs without a GPU
+#ifdef API_GRAPHICS_NULL
+
+//= INCLUDES ========================
+#include "Test.h"
+#include "RHI/RHI_Device.h"
+#include "RHI/RHI_ShaderCache.h"
+#include <thread>
+#include <memory>
+#include <vector>
+//===================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+//============================
+
+static vector<std::byte> make_bytecode(const uint32_t size, const uint8_t seed)
+{
+    vector<std::byte> bytecode(size);
+    for (uint32_t i = 0; i < size; i++)
+    {
+        bytecode[i] = static_cast<std::byte>((i * 31 + seed) & 0xFF);
+    }
+    return bytecode;
+}
+
+TEST(shader_cache_round_trip)
+{
+    const string directory = Spartan::Tests::GetTempDirectory("shader_cache_round_trip") + "/";
+    RHI_Device device(nullptr);
+
+    const uint64_t key                          = 0x0123456789abcdef;
+    const vector<std::byte> bytecode            = make_bytecode(4096, 7);
+    const vector<RHI_Descriptor> descriptors    = { RHI_Descriptor(RHI_Descriptor_ConstantBuffer, 2, 1), RHI_Descriptor(RHI_Descriptor_Texture, 5, 2) };
+
+    {
+        RHI_ShaderCache cache(&device, directory);
+
+        vector<std::byte> bytecode_loaded;
+        vector<RHI_Descriptor> descriptors_loaded;
+        CHECK(!cache.Load(key, bytecode_loaded, descriptors_loaded));
+        CHECK(cache.GetMissCount() == 1);
+
+        CHECK(cache.Save(key, bytecode, descriptors, 10.0f));
+        CHECK(cache.Load(key, bytecode_loaded, descriptors_loaded));
+        CHECK(cache.GetHitCount() == 1);
+        CHECK(bytecode_loaded == bytecode);
+    }
+
+    // A new run indexes what's on disk
+    RHI_ShaderCache cache(&device, directory);
+    vector<std::byte> bytecode_loaded;
+    vector<RHI_Descriptor> descriptors_loaded;
+    CHECK(cache.Load(key, bytecode_loaded, descriptors_loaded));
+    CHECK(bytecode_loaded == bytecode);
+    CHECK(descriptors_loaded.size() == descriptors.size());
+    for (uint32_t i = 0; i < descriptors.size(); i++)
+    {
+        CHECK(descriptors_loaded[i].type == descriptors[i].type);
+        CHECK(descriptors_loaded[i].slot == descriptors[i].slot);
+        CHECK(descriptors_loaded[i].stage == descriptors[i].stage);
+    }
+}
+
+TEST(shader_cache_concurrent_saves_and_loads)
+{
+    const string directory = Spartan::Tests::GetTempDirectory("shader_cache_concurrent") + "/";
+    RHI_Device device(nullptr);
+    RHI_ShaderCache cache(&device, directory);
+
+    // Threads compiling the same shader save identical bytecode, a load must see all of it or none of it
+    const uint64_t key                  = 42;
+    const vector<std::byte> bytecode    = make_bytecode(256 * 1024, 3);
+    const vector<RHI_Descriptor> descriptors;
+
+    const uint32_t thread_count     = 4;
+    const uint32_t iteration_count  = 50;
+    vector<uint32_t> torn_loads(thread_count, 0);
+    vector<thread> threads;
+    for (uint32_t t = 0; t < thread_count; t++)
+    {
+        threads.emplace_back([&, t]()
+        {
+            for (uint32_t i = 0; i < iteration_count; i++)
+            {
+                vector<std::byte> bytecode_loaded;
+                vector<RHI_Descriptor> descriptors_loaded;
+                if (cache.Load(key, bytecode_loaded, descriptors_loaded) && bytecode_loaded != bytecode)
+                {
+                    torn_loads[t]++;
+                }
+
+                cache.Save(key, bytecode, descriptors, 1.0f);
+            }
+        });
+    }
+
+    for (thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const uint32_t count : torn_loads)
+    {
+        CHECK(count == 0);
+    }
+    CHECK(cache.GetHitCount() + cache.GetMissCount() == thread_count * iteration_count);
+}
+
+#endif
@@ -0,0 +1,163 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==================
+#include "Test.h"
+#include "Rendering/ShadowAtlas.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+//=============================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+//============================
+
+namespace
+{
+    vector<ShadowAtlasRequest> CreateRequests(const uint32_t count, const uint32_t seed)
+    {
+        mt19937 generator(seed);
+        uniform_real_distribution<float> distribution(0.0f, 1.0f);
+
+        vector<ShadowAtlasRequest> requests(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            requests[i].id          = i;
+            requests[i].tile_count  = (i % 3 == 0) ? 6 : 1;
+            requests[i].size        = 1u << (7 + i % 4);
+            requests[i].priority    = static_cast<float>(static_cast<uint32_t>(distribution(generator) * 8.0f)); // with ties
+        }
+
+        return requests;
+    }
+}
+
+TEST(shadow_atlas_tiles_are_aligned_inside_and_disjoint)
+{
+    ShadowAtlas atlas(4096, 128);
+    vector<ShadowAtlasRequest> requests = CreateRequests(64, 0);
+    const uint32_t packed_count = atlas.Pack(requests);
+
+    vector<ShadowAtlasTile> tiles;
+    uint32_t with_tiles = 0;
+    uint64_t area       = 0;
+    for (const ShadowAtlasRequest& request : requests)
+    {
+        if (request.tiles[0].size == 0)
+            continue;
+
+        with_tiles++;
+        for (uint32_t i = 0; i < request.tile_count; i++)
+        {
+            const ShadowAtlasTile& tile = request.tiles[i];
+            CHECK(tile.size == request.tiles[0].size);
+            CHECK(tile.size >= atlas.GetTileSizeMin() && tile.size <= atlas.GetTileSizeMax());
+            CHECK(tile.x % tile.size == 0 && tile.y % tile.size == 0);
+            CHECK(tile.x + tile.size <= atlas.GetSize() && tile.y + tile.size <= atlas.GetSize());
+            tiles.emplace_back(tile);
+            area += static_cast<uint64_t>(tile.size) * tile.size;
+        }
+    }
+    CHECK(with_tiles == packed_count);
+    CHECK(atlas.GetOccupancy() == static_cast<float>(static_cast<double>(area) / (4096.0 * 4096.0)));
+
+    for (size_t i = 0; i < tiles.size(); i++)
+    {
+        for (size_t j = i + 1; j < tiles.size(); j++)
+        {
+            const ShadowAtlasTile& a = tiles[i];
+            const ShadowAtlasTile& b = tiles[j];
+            CHECK(a.x + a.size <= b.x || b.x + b.size <= a.x || a.y + a.size <= b.y || b.y + b.size <= a.y);
+        }
+    }
+}
+
+TEST(shadow_atlas_halves_lower_priorities_first)
+{
+    // Tiles of 64 to 256 texels, a full size point light takes 6/16 of the atlas
+    ShadowAtlas atlas(1024, 64);
+    vector<ShadowAtlasRequest> requests(4);
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        requests[i].id          = i;
+        requests[i].tile_count  = i < 3 ? 6 : 1;
+        requests[i].size        = 256;
+        requests[i].priority    = static_cast<float>(4 - i);
+    }
+
+    CHECK(atlas.Pack(requests) == 4);
+    CHECK(requests[0].tiles[5].size == 256);
+    CHECK(requests[1].tiles[5].size == 256);
+    CHECK(requests[2].tiles[5].size == 128); // only 4/16 were left
+    CHECK(requests[3].tiles[0].size == 256); // and a single tile still fits afterwards
+}
+
+TEST(shadow_atlas_drops_requests_below_the_minimum_tile_size)
+{
+    ShadowAtlas atlas(1024, 256);
+    vector<ShadowAtlasRequest> requests(17);
+    for (uint32_t i = 0; i < 17; i++)
+    {
+        requests[i].id      = i;
+        requests[i].size    = 256;
+    }
+
+    // Equal priorities are served by id
+    CHECK(atlas.Pack(requests) == 16);
+    CHECK(requests[16].tiles[0].size == 0);
+    CHECK(atlas.GetOccupancy() == 1.0f);
+}
+
+TEST(shadow_atlas_packing_ignores_request_order)
+{
+    ShadowAtlas atlas(4096, 128);
+    vector<ShadowAtlasRequest> requests = CreateRequests(200, 1);
+    atlas.Pack(requests);
+
+    vector<ShadowAtlasRequest> shuffled = requests;
+    shuffle(shuffled.begin(), shuffled.end(), mt19937(2));
+    atlas.Pack(shuffled);
+
+    for (const ShadowAtlasRequest& request : shuffled)
+    {
+        const ShadowAtlasRequest& expected = requests[request.id];
+        for (uint32_t i = 0; i < request.tile_count; i++)
+        {
+            CHECK(request.tiles[i].x == expected.tiles[i].x);
+            CHECK(request.tiles[i].y == expected.tiles[i].y);
+            CHECK(request.tiles[i].size == expected.tiles[i].size);
+        }
+    }
+}
+
+TEST(shadow_atlas_tile_size_sticks_until_the_coverage_clearly_changes)
+{
+    // Tiles of 128 to 1024 texels
+    ShadowAtlas atlas(4096, 128);
+    CHECK(atlas.ComputeTileSize(0.5f, 0) == 512);
+    CHECK(atlas.ComputeTileSize(0.45f, 512) == 512);
+    CHECK(atlas.ComputeTileSize(0.3f, 512) == 256);
+    CHECK(atlas.ComputeTileSize(0.9f, 512) == 512);
+    CHECK(atlas.ComputeTileSize(1.0f, 512) == 1024);
+    CHECK(atlas.ComputeTileSize(0.0f, 0) == 128);
+}
@@ -0,0 +1,196 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+// Caching of the static shadow casters, through the light depth pass of the null backend
+#ifdef API_GRAPHICS_NULL
+
+//= INCLUDES ===================================
+#include "Test.h"
+#include "Core/Engine.h"
+#include "Core/Context.h"
+#include "Rendering/Renderer.h"
+#include "World/World.h"
+#include "World/Entity.h"
+#include "World/Components/Transform.h"
+#include "World/Components/Renderable.h"
+#include "World/Components/Light.h"
+//==============================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+namespace
+{
+    // Must match the renderer, a caster which stopped moving rejoins the cache after this many frames
+    const uint32_t shadow_caster_static_frames = 60;
+
+    // The default world (camera and directional light) with a row of cubes in front of the camera
+    struct ShadowScene
+    {
+        ShadowScene() : engine(make_window_data())
+        {
+            World* world    = engine.GetContext()->GetSubsystem<World>();
+            renderer        = engine.GetContext()->GetSubsystem<Renderer>();
+            light           = world->EntityGetByName("DirectionalLight")->GetComponent<Light>();
+            camera          = world->EntityGetByName("Camera")->GetTransform();
+
+            for (uint32_t i = 0; i < 8; i++)
+            {
+                auto& entity = world->EntityCreate();
+                entity->GetTransform()->SetPosition(Vector3(static_cast<float>(i) * 2.0f - 7.0f, 0.0f, 0.0f));
+                Renderable* renderable = entity->AddComponent<Renderable>();
+                renderable->GeometrySet(Geometry_Default_Cube);
+                renderable->UseDefaultMaterial();
+                cubes.emplace_back(entity->GetTransform());
+            }
+        }
+
+        static WindowData make_window_data()
+        {
+            WindowData window_data;
+            window_data.width   = 64;
+            window_data.height  = 64;
+            return window_data;
+        }
+
+        void Tick(const uint32_t frame_count)
+        {
+            for (uint32_t i = 0; i < frame_count; i++)
+            {
+                engine.Tick();
+            }
+        }
+
+        vector<uint32_t> GetRedrawCounts() const
+        {
+            vector<uint32_t> counts;
+            for (uint32_t i = 0; i < light->GetShadowArraySize(); i++)
+            {
+                counts.emplace_back(light->GetShadowCacheRedrawCount(i));
+            }
+            return counts;
+        }
+
+        vector<Matrix> GetViewProjections() const
+        {
+            vector<Matrix> view_projections;
+            for (uint32_t i = 0; i < light->GetShadowArraySize(); i++)
+            {
+                view_projections.emplace_back(light->GetViewMatrix(i) * light->GetProjectionMatrix(i));
+            }
+            return view_projections;
+        }
+
+        Engine engine;
+        Renderer* renderer  = nullptr;
+        Light* light        = nullptr;
+        Transform* camera   = nullptr;
+        vector<Transform*> cubes;
+    };
+}
+
+TEST(shadow_cache_redraws_a_slice_only_when_its_static_casters_change)
+{
+    ShadowScene scene;
+    CHECK(scene.renderer->GetOption(Render_ShadowCaching));
+
+    // Every slice is drawn into its cache once
+    scene.Tick(5);
+    const vector<uint32_t> counts_settled = scene.GetRedrawCounts();
+    CHECK(!counts_settled.empty());
+    CHECK(scene.light->GetShadowCacheTexture(0) != nullptr);
+    for (const uint32_t count : counts_settled)
+    {
+        CHECK(count >= 1);
+    }
+
+    // Nothing moves, nothing is redrawn
+    scene.Tick(10);
+    CHECK(scene.GetRedrawCounts() == counts_settled);
+
+    // A static caster which moves leaves the cache of the slices it's in, once, however many frames it keeps moving for
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        scene.cubes[4]->SetPosition(Vector3(1.0f, 0.5f * static_cast<float>(i + 1), 0.0f));
+        scene.Tick(1);
+    }
+    scene.Tick(5);
+    const vector<uint32_t> counts_moved = scene.GetRedrawCounts();
+    CHECK(counts_moved[0] == counts_settled[0] + 1); // the nearest cascade contains the whole row
+    for (uint32_t i = 0; i < counts_moved.size(); i++)
+    {
+        CHECK(counts_moved[i] <= counts_settled[i] + 1);
+    }
+
+    // While it's dynamic, it's drawn on top of the cache every frame, but the cache itself stays
+    scene.Tick(shadow_caster_static_frames / 2);
+    CHECK(scene.GetRedrawCounts() == counts_moved);
+
+    // Once it has been still for long enough, it rejoins the cache of the slices it left
+    scene.Tick(shadow_caster_static_frames / 2 + 5);
+    const vector<uint32_t> counts_static = scene.GetRedrawCounts();
+    for (uint32_t i = 0; i < counts_static.size(); i++)
+    {
+        CHECK(counts_static[i] == counts_moved[i] + (counts_moved[i] - counts_settled[i]));
+    }
+
+    scene.Tick(10);
+    CHECK(scene.GetRedrawCounts() == counts_static);
+}
+
+TEST(shadow_cache_cascade_snapping_keeps_the_cache_under_camera_motion)
+{
+    ShadowScene scene;
+    scene.Tick(5);
+    const vector<uint32_t> counts_settled       = scene.GetRedrawCounts();
+    const vector<Matrix> view_projections       = scene.GetViewProjections();
+    const Vector3 camera_position               = scene.camera->GetPosition();
+    CHECK(!counts_settled.empty());
+
+    // The camera sways by a few centimeters, which moves the cascades every frame without snapping
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        const float offset = (i & 1) ? 0.02f : -0.02f;
+        scene.camera->SetPosition(camera_position + Vector3(offset, offset * 0.5f, offset));
+        scene.Tick(1);
+
+        CHECK(scene.GetViewProjections() == view_projections);
+    }
+    CHECK(scene.GetRedrawCounts() == counts_settled);
+
+    // Travelling far enough moves the cascades to another cell of their grid, which redraws their caches
+    scene.camera->SetPosition(camera_position + Vector3(0.0f, 0.0f, -30.0f));
+    scene.Tick(5);
+    CHECK(scene.GetViewProjections()[0] != view_projections[0]);
+    CHECK(scene.GetRedrawCounts()[0] > counts_settled[0]);
+
+    // And once there, the caches stay
+    const vector<uint32_t> counts_moved = scene.GetRedrawCounts();
+    scene.Tick(10);
+    CHECK(scene.GetRedrawCounts() == counts_moved);
+}
+
+#endif
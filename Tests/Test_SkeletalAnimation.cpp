@@ -0,0 +1,126 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ==================
+#include "Test.h"
+#include "Rendering/Animation.h"
+#include "Rendering/SkeletalAnimation.h"
+#include "Threading/Threading.h"
+#include <algorithm>
+#include <cmath>
+//=============================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+namespace
+{
+    float max_difference(const Matrix& a, const Matrix& b)
+    {
+        const float* values_a   = &a.m00;
+        const float* values_b   = &b.m00;
+        float difference        = 0.0f;
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            difference = max(difference, abs(values_a[i] - values_b[i]));
+        }
+        return difference;
+    }
+
+    // A root and a child whose rotation turns a bit every tick, over ten ticks
+    void create_skeleton_and_clip(Skeleton* skeleton, AnimationClip* clip)
+    {
+        skeleton->AddBone("root", -1, Matrix::Identity, Vector3(1.0f, 2.0f, 3.0f), Quaternion::FromEulerAngles(10.0f, 20.0f, 30.0f), Vector3(1.0f, 2.0f, 1.0f));
+        skeleton->AddBone("child", 0, Matrix::Identity, Vector3(0.0f, 1.0f, 0.0f), Quaternion::FromEulerAngles(40.0f, 0.0f, 5.0f), Vector3::One);
+
+        Animation animation(nullptr);
+        animation.SetDuration(10.0);
+        animation.SetTicksPerSec(10.0);
+
+        AnimationNode channel;
+        channel.name = "child";
+        for (uint32_t tick = 0; tick <= 10; tick++)
+        {
+            channel.rotationFrames.emplace_back(KeyQuaternion{ static_cast<double>(tick), Quaternion::FromEulerAngles(tick * 9.0f, tick * 3.0f, 0.0f) });
+            channel.positionFrames.emplace_back(KeyVector{ static_cast<double>(tick), Vector3(0.0f, 1.0f, 0.0f) });
+        }
+        animation.AddChannel(move(channel));
+
+        clip->Build(animation, *skeleton);
+    }
+}
+
+TEST(skeletal_animation_samples_and_builds_the_palette)
+{
+    Skeleton skeleton;
+    AnimationClip clip;
+    create_skeleton_and_clip(&skeleton, &clip);
+    CHECK(clip.GetBoneCount() == 2);
+
+    // Halfway between the fifth and sixth tick
+    SkeletonInstance instance(&skeleton);
+    instance.Play(&clip);
+    instance.Tick(0.55f);
+    instance.Evaluate();
+
+    // Within what 15 bits per quantized component allow
+    const Quaternion expected   = Quaternion::Lerp(Quaternion::FromEulerAngles(45.0f, 15.0f, 0.0f), Quaternion::FromEulerAngles(54.0f, 18.0f, 0.0f), 0.5f);
+    const Quaternion sampled    = instance.GetPose().GetRotation(1);
+    CHECK(abs(expected.x * sampled.x + expected.y * sampled.y + expected.z * sampled.z + expected.w * sampled.w) > 0.9999f);
+
+    // The child's palette entry is its local transform on top of the root's, the inverse bind matrices are identity
+    const Matrix root   = Matrix(Vector3(1.0f, 2.0f, 3.0f), Quaternion::FromEulerAngles(10.0f, 20.0f, 30.0f), Vector3(1.0f, 2.0f, 1.0f));
+    const Matrix child  = Matrix(Vector3(0.0f, 1.0f, 0.0f), sampled, Vector3::One) * root;
+    CHECK(max_difference(instance.GetPalette()[0], root) < 0.0001f);
+    CHECK(max_difference(instance.GetPalette()[1], child) < 0.0001f);
+}
+
+TEST(skeletal_animation_parallel_evaluation_matches_serial)
+{
+    Skeleton skeleton;
+    AnimationClip clip;
+    create_skeleton_and_clip(&skeleton, &clip);
+
+    // Enough instances to be split across threads
+    vector<SkeletonInstance> serial(100, SkeletonInstance(&skeleton));
+    for (uint32_t i = 0; i < static_cast<uint32_t>(serial.size()); i++)
+    {
+        serial[i].Play(&clip);
+        serial[i].Tick(static_cast<float>(i) * 0.01f);
+    }
+    vector<SkeletonInstance> parallel = serial;
+
+    Threading threading(nullptr);
+    for (SkeletonInstance& instance : serial)
+    {
+        instance.Evaluate();
+    }
+    SkeletonInstance::Evaluate(&threading, parallel);
+
+    for (uint32_t i = 0; i < static_cast<uint32_t>(serial.size()); i++)
+    {
+        CHECK(max_difference(serial[i].GetPalette()[1], parallel[i].GetPalette()[1]) == 0.0f);
+    }
+}
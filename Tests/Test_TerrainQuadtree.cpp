@@ -0,0 +1,134 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// The quadtree creates its buffers through the renderer's device, so these tests run on the null backend
+#ifdef API_GRAPHICS_NULL
+
+//= INCLUDES ==========================
+#include "Test.h"
+#include "Core/Engine.h"
+#include "Core/Context.h"
+#include "Rendering/Renderer.h"
+#include "Rendering/TerrainQuadtree.h"
+#include "RHI/RHI_Vertex.h"
+#include "Threading/Threading.h"
+#include <cmath>
+//=====================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+using namespace Spartan::Math;
+//============================
+
+TEST(terrain_low_lod_mesh_covers_the_height_map)
+{
+    WindowData window_data;
+    window_data.width   = 64;
+    window_data.height  = 64;
+    Engine engine(window_data);
+    Context* context = engine.GetContext();
+
+    // A flat height map with a single peak, which a coarse level doesn't sample
+    const uint32_t size = 257;
+    vector<uint8_t> heights(static_cast<size_t>(size) * size, 0);
+    heights[static_cast<size_t>(129) * size + 129] = 255;
+
+    TerrainQuadtree quadtree(context->GetSubsystem<Threading>(), context->GetSubsystem<Renderer>()->GetRhiDevice());
+    CHECK(quadtree.Initialize(move(heights), size, size, 0.0f, 10.0f));
+
+    // One patch per node of the level, with the quadtree's winding
+    vector<uint32_t> indices;
+    vector<RHI_Vertex_PosTexNorTan> vertices;
+    quadtree.GenerateLowLodMesh(1, indices, vertices);
+    const uint32_t patch_vertices = TerrainQuadtree::patch_quads + 1;
+    CHECK(vertices.size() == 4 * patch_vertices * patch_vertices);
+    CHECK(indices.size() == 4 * TerrainQuadtree::patch_quads * TerrainQuadtree::patch_quads * 6);
+    for (const uint32_t index : indices)
+    {
+        CHECK(index < vertices.size());
+    }
+
+    // The mesh spans the height map but misses the peak, the bounds don't
+    const BoundingBox mesh_bounds(vertices.data(), static_cast<uint32_t>(vertices.size()));
+    const BoundingBox bounds = quadtree.GetBounds();
+    CHECK(mesh_bounds.GetMin().x == bounds.GetMin().x && mesh_bounds.GetMax().x == bounds.GetMax().x);
+    CHECK(mesh_bounds.GetMin().z == bounds.GetMin().z && mesh_bounds.GetMax().z == bounds.GetMax().z);
+    CHECK(mesh_bounds.GetMax().y < 10.0f);
+    CHECK(bounds.GetMax().y == 10.0f);
+}
+
+TEST(terrain_normals_are_unit_length_on_thin_height_maps)
+{
+    WindowData window_data;
+    window_data.width   = 64;
+    window_data.height  = 64;
+    Engine engine(window_data);
+    Context* context = engine.GetContext();
+
+    // A single row or column has no quads
+    for (const pair<uint32_t, uint32_t>& size : { make_pair(1u, 65u), make_pair(65u, 1u) })
+    {
+        TerrainQuadtree quadtree(context->GetSubsystem<Threading>(), context->GetSubsystem<Renderer>()->GetRhiDevice());
+        CHECK(!quadtree.Initialize(vector<uint8_t>(static_cast<size_t>(size.first) * size.second, 0), size.first, size.second, 0.0f, 255.0f));
+    }
+
+    // Ramps two samples wide, one sided differences everywhere across them, rising by 2 per sample along them
+    for (const pair<uint32_t, uint32_t>& size : { make_pair(2u, 2u), make_pair(2u, 65u), make_pair(65u, 2u) })
+    {
+        const uint32_t width    = size.first;
+        const uint32_t height   = size.second;
+        const bool is_along_x   = width > height;
+        vector<uint8_t> heights(static_cast<size_t>(width) * height);
+        for (uint32_t y = 0; y < height; y++)
+        {
+            for (uint32_t x = 0; x < width; x++)
+            {
+                heights[static_cast<size_t>(y) * width + x] = static_cast<uint8_t>((is_along_x ? x : y) * 2);
+            }
+        }
+
+        TerrainQuadtree quadtree(context->GetSubsystem<Threading>(), context->GetSubsystem<Renderer>()->GetRhiDevice());
+        CHECK(quadtree.Initialize(move(heights), width, height, 0.0f, 255.0f));
+
+        vector<RHI_Vertex_PosTexNorTan> vertices;
+        BoundingBox aabb;
+        quadtree.GeneratePatch(quadtree.GetLevelCount() - 1, 0, 0, vertices, aabb);
+        CHECK(!vertices.empty());
+
+        const float normal_length = 1.0f / sqrt(5.0f);
+        for (const RHI_Vertex_PosTexNorTan& vertex : vertices)
+        {
+            const Vector3 normal(vertex.nor[0], vertex.nor[1], vertex.nor[2]);
+            const Vector3 tangent(vertex.tan[0], vertex.tan[1], vertex.tan[2]);
+            CHECK(isfinite(normal.x) && isfinite(normal.y) && isfinite(normal.z));
+            CHECK(isfinite(tangent.x) && isfinite(tangent.y) && isfinite(tangent.z));
+            CHECK(abs(normal.Length() - 1.0f) < 0.001f);
+            CHECK(abs(tangent.Length() - 1.0f) < 0.001f);
+
+            // Flat across the ramp, a 2:1 slope along it
+            const Vector3 normal_expected = is_along_x ? Vector3(-2.0f, 1.0f, 0.0f) * normal_length : Vector3(0.0f, 1.0f, -2.0f) * normal_length;
+            CHECK((normal - normal_expected).Length() < 0.001f);
+        }
+    }
+}
+
+#endif
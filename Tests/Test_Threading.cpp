@@ -0,0 +1,75 @@
+/*
+Copyright(c) 2016-2020 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ==================
+#include "Test.h"
+#include "Threading/Threading.h"
+#include <atomic>
+#include <vector>
+//=============================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan;
+//============================
+
+TEST(threading_task_loop_covers_range_once)
+{
+    Threading threading(nullptr);
+
+    for (const uint32_t range : { 1u, 7u, 64u, 1000u })
+    {
+        for (const uint32_t chunk_count : { 0u, 1u, 3u, 16u, 5000u })
+        {
+            vector<atomic<uint32_t>> visits(range);
+            threading.AddTaskLoop([&visits](const uint32_t start, const uint32_t end)
+            {
+                for (uint32_t i = start; i < end; i++)
+                {
+                    visits[i]++;
+                }
+            }, range, chunk_count);
+
+            for (const atomic<uint32_t>& visit_count : visits)
+            {
+                CHECK(visit_count.load() == 1);
+            }
+        }
+    }
+}
+
+TEST(threading_task_loop_nested)
+{
+    Threading threading(nullptr);
+
+    // Loops started from inside a loop must complete even though the pool is busy with the outer one
+    atomic<uint32_t> count = 0;
+    threading.AddTaskLoop([&threading, &count](const uint32_t start, const uint32_t end)
+    {
+        for (uint32_t i = start; i < end; i++)
+        {
+            threading.AddTaskLoop([&count](const uint32_t start, const uint32_t end) { count += end - start; }, 100);
+        }
+    }, 32);
+
+    CHECK(count.load() == 32 * 100);
+}